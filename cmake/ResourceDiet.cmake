@@ -0,0 +1,41 @@
+# 资源瘦身检查：配置阶段扫描 qrc 清单
+# - 内容完全相同的文件重复打包 -> 报错（请改用 alias 指向同一份文件）
+# - 超过阈值的位图 -> 警告（请用 scripts/optimize_images.sh 生成尺寸合适的变体）
+
+set(AI_RESOURCE_RASTER_LIMIT 1572864 CACHE STRING "qrc 中单个位图的体积上限（字节）")
+
+function(ai_check_qrc_assets qrc_file)
+    get_filename_component(_qrc_dir "${qrc_file}" DIRECTORY)
+    file(READ "${qrc_file}" _qrc_content)
+    string(REGEX MATCHALL "<file[^>]*>[^<]+</file>" _entries "${_qrc_content}")
+
+    set(_seen_hashes "")
+    set(_total_bytes 0)
+    foreach(_entry IN LISTS _entries)
+        string(REGEX REPLACE "<file[^>]*>([^<]+)</file>" "\\1" _path "${_entry}")
+        set(_abs "${_qrc_dir}/${_path}")
+        if(NOT EXISTS "${_abs}")
+            message(WARNING "[ResourceDiet] qrc 引用的文件不存在: ${_path}")
+            continue()
+        endif()
+
+        file(SIZE "${_abs}" _size)
+        math(EXPR _total_bytes "${_total_bytes} + ${_size}")
+
+        file(SHA256 "${_abs}" _hash)
+        list(FIND _seen_hashes "${_hash}" _dup_index)
+        if(_dup_index GREATER -1)
+            math(EXPR _path_index "${_dup_index} + 1")
+            list(GET _seen_hashes ${_path_index} _first_path)
+            message(FATAL_ERROR "[ResourceDiet] 重复资源: ${_path} 与 ${_first_path} 内容相同，请用 alias 复用同一文件")
+        endif()
+        list(APPEND _seen_hashes "${_hash}" "${_path}")
+
+        if(_path MATCHES "\\.(png|jpg|jpeg|bmp)$" AND _size GREATER AI_RESOURCE_RASTER_LIMIT)
+            message(WARNING "[ResourceDiet] 位图过大 (${_size} 字节): ${_path}，请生成尺寸合适的变体")
+        endif()
+    endforeach()
+
+    math(EXPR _total_kb "${_total_bytes} / 1024")
+    message(STATUS "[ResourceDiet] ${qrc_file}: ${_total_kb} KB")
+endfunction()
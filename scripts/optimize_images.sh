@@ -0,0 +1,43 @@
+#!/bin/bash
+# 图片变体生成脚本 - 将大尺寸原图缩放为打包用的变体
+# 原图保留在 resources/images/，变体输出到 resources/images/variants/，
+# resources.qrc 只引用变体（通过 alias 保持 :/images/... 路径不变）。
+# 用法:
+#   ./scripts/optimize_images.sh
+# 依赖: ImageMagick (magick/convert) 或 macOS 自带 sips
+
+set -euo pipefail
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+REPO_ROOT="$(cd "$SCRIPT_DIR/.." && pwd)"
+IMAGES_DIR="$REPO_ROOT/resources/images"
+VARIANTS_DIR="$IMAGES_DIR/variants"
+
+# 原图 -> 目标宽度（登录/注册页左栏最宽约 750 逻辑像素，按 2x 屏输出）
+VARIANTS=(
+    "tiananmen.png:1500"
+)
+
+resize_image() {
+    local src="$1" dst="$2" width="$3"
+    if command -v magick >/dev/null 2>&1; then
+        magick "$src" -resize "${width}x" -strip -define png:compression-level=9 "$dst"
+    elif command -v convert >/dev/null 2>&1; then
+        convert "$src" -resize "${width}x" -strip -define png:compression-level=9 "$dst"
+    elif command -v sips >/dev/null 2>&1; then
+        sips --resampleWidth "$width" "$src" --out "$dst" >/dev/null
+    else
+        echo "[ERROR] 未找到 ImageMagick 或 sips" >&2
+        exit 1
+    fi
+}
+
+mkdir -p "$VARIANTS_DIR"
+for entry in "${VARIANTS[@]}"; do
+    name="${entry%%:*}"
+    width="${entry##*:}"
+    src="$IMAGES_DIR/$name"
+    dst="$VARIANTS_DIR/${name%.*}_${width}.${name##*.}"
+    resize_image "$src" "$dst" "$width"
+    echo "[INFO] $name -> $(basename "$dst") ($(wc -c < "$src") -> $(wc -c < "$dst") bytes)"
+done
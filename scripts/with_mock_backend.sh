@@ -0,0 +1,72 @@
+#!/bin/bash
+# 在本地 MockBackend 上运行命令 - 供 bench / CI 使用，不依赖真实 Supabase / Dify
+# 启动 MockBackend（随机端口），把 SUPABASE_URL、DIFY_API_BASE_URL 等环境变量指向它，
+# 运行 -- 之后的命令，命令结束后关闭 MockBackend 并返回命令的退出码。
+# 用法:
+#   ./scripts/with_mock_backend.sh <MockBackend 路径> [MockBackend 参数...] -- <命令> [参数...]
+# 例:
+#   ./scripts/with_mock_backend.sh build/MockBackend --latency-ms 20 -- build/NetworkBench -n 50
+
+set -euo pipefail
+
+if [ $# -lt 3 ]; then
+    echo "用法: $0 <MockBackend 路径> [MockBackend 参数...] -- <命令> [参数...]" >&2
+    exit 2
+fi
+
+MOCK_BIN="$1"
+shift
+MOCK_ARGS=()
+while [ $# -gt 0 ] && [ "$1" != "--" ]; do
+    MOCK_ARGS+=("$1")
+    shift
+done
+if [ $# -lt 2 ]; then
+    echo "[ERROR] 缺少 -- 之后的命令" >&2
+    exit 2
+fi
+shift
+
+MOCK_LOG="$(mktemp)"
+"$MOCK_BIN" --port 0 --quiet "${MOCK_ARGS[@]+"${MOCK_ARGS[@]}"}" >"$MOCK_LOG" 2>&1 &
+MOCK_PID=$!
+
+cleanup() {
+    kill "$MOCK_PID" 2>/dev/null || true
+    wait "$MOCK_PID" 2>/dev/null || true
+    rm -f "$MOCK_LOG"
+}
+trap cleanup EXIT
+
+# 首行是实际监听地址，最多等 10 秒
+BASE_URL=""
+for _ in $(seq 1 100); do
+    if ! kill -0 "$MOCK_PID" 2>/dev/null; then
+        echo "[ERROR] MockBackend 启动失败:" >&2
+        cat "$MOCK_LOG" >&2
+        exit 1
+    fi
+    BASE_URL="$(head -n 1 "$MOCK_LOG" | tr -d '\r')"
+    case "$BASE_URL" in
+        http://*) break ;;
+        *) BASE_URL="" ;;
+    esac
+    sleep 0.1
+done
+if [ -z "$BASE_URL" ]; then
+    echo "[ERROR] 等待 MockBackend 监听超时" >&2
+    exit 1
+fi
+
+echo "[INFO] MockBackend: $BASE_URL"
+export SUPABASE_URL="$BASE_URL"
+export SUPABASE_ANON_KEY="mock"
+export DIFY_API_BASE_URL="$BASE_URL/v1"
+export ZHIPU_BASE_URL="$BASE_URL/v1"
+export MINIMAX_API_BASE_URL="$BASE_URL/v1"
+
+set +e
+"$@"
+STATUS=$?
+set -e
+exit $STATUS
@@ -1,6 +1,7 @@
 #include "AdminManager.h"
 #include "../auth/supabase/supabaseconfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QJsonDocument>
 #include <QUrlQuery>
 #include <QRandomGenerator>
@@ -29,7 +30,7 @@ AdminManager* AdminManager::instance()
 
 AdminManager::AdminManager(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
 {
 }
 
@@ -9,7 +9,8 @@
 /**
  * @brief 教学数据分析服务
  *
- * 提供模拟的教学统计数据，后续可对接真实数据库
+ * 默认提供模拟的教学统计数据；SupabaseAnalyticsDataSource 同步到服务端汇总后
+ * 通过 setLiveData() 换成真实数据，之后 refreshData() 不再生成随机数据
  * 老王说：先用假数据把 UI 搞漂亮，真数据以后再说
  */
 class AnalyticsDataService : public QObject
@@ -53,9 +54,18 @@ public:
     QVector<TrendPoint> getParticipationTrend();
     QVector<TrendPoint> getCompletionTrend();
 
-    // 刷新数据 (重新生成随机数据)
+    // 刷新数据 (未接入真实数据时重新生成随机数据)
     void refreshData();
 
+    // 接入服务端汇总的真实数据
+    void setLiveData(const MetricData &participation,
+                     const MetricData &completion,
+                     const MetricData &achievement,
+                     const GradeDistribution &distribution,
+                     const QVector<TrendPoint> &participationTrend,
+                     const QVector<TrendPoint> &completionTrend);
+    bool hasLiveData() const { return m_hasLiveData; }
+
     // 获取摘要文本 (用于 AI 分析)
     QString getDataSummary();
 
@@ -76,6 +86,7 @@ private:
     GradeDistribution m_gradeDistribution;
     QVector<TrendPoint> m_participationTrend;
     QVector<TrendPoint> m_completionTrend;
+    bool m_hasLiveData = false;
 
     static AnalyticsDataService* s_instance;
 };
@@ -6,8 +6,10 @@
 #include "ui/KnowledgeGraphWidget.h"
 #include "models/KnowledgeGraph.h"
 #include "datasources/MockDataSource.h"
+#include "datasources/SupabaseAnalyticsDataSource.h"
 #include "../services/DifyService.h"
 #include "../shared/StyleConfig.h"
+#include "../settings/UserSettingsManager.h"
 #include <QDebug>
 #include <QGraphicsDropShadowEffect>
 #include <QSvgWidget>
@@ -29,7 +31,8 @@ DataAnalyticsWidget::DataAnalyticsWidget(QWidget *parent)
     : QWidget(parent)
     , m_difyService(nullptr)
     , m_dataService(AnalyticsDataService::instance())
-    , m_mockDataSource(new MockDataSource())
+    , m_dataSource(nullptr)
+    , m_liveDataSource(nullptr)
     , m_isGeneratingReport(false)
     , m_barChartView(nullptr)
     , m_lineChartView(nullptr)
@@ -42,9 +45,28 @@ DataAnalyticsWidget::DataAnalyticsWidget(QWidget *parent)
     , m_personalPage(nullptr)
     , m_classPage(nullptr)
 {
+    // 已登录时读取真实成绩，否则用模拟数据
+    const QString email = UserSettingsManager::instance()->email();
+    if (!email.isEmpty()) {
+        m_liveDataSource = new SupabaseAnalyticsDataSource();
+        m_dataSource = m_liveDataSource;
+    } else {
+        m_dataSource = new MockDataSource();
+    }
+
     setupUI();
     setupStyles();
 
+    if (m_liveDataSource) {
+        connect(m_liveDataSource, &SupabaseAnalyticsDataSource::classesChanged,
+                this, &DataAnalyticsWidget::onLiveClassesChanged);
+        connect(m_liveDataSource, &SupabaseAnalyticsDataSource::dataChanged, this, [this]() {
+            m_personalPage->refresh();
+            m_classPage->refresh();
+        });
+        m_liveDataSource->setTeacherEmail(email);
+    }
+
     // 连接数据刷新信号
     connect(m_dataService, &AnalyticsDataService::dataRefreshed,
             this, &DataAnalyticsWidget::onDataRefreshed);
@@ -52,6 +74,7 @@ DataAnalyticsWidget::DataAnalyticsWidget(QWidget *parent)
 
 DataAnalyticsWidget::~DataAnalyticsWidget()
 {
+    delete m_dataSource;
 }
 
 void DataAnalyticsWidget::setDifyService(DifyService *service)
@@ -85,6 +108,9 @@ void DataAnalyticsWidget::refresh()
 {
     qDebug() << "[DataAnalyticsWidget] Refreshing data...";
     m_dataService->refreshData();
+    if (m_liveDataSource) {
+        m_liveDataSource->sync();   // 增量同步，完成后经 dataChanged 再刷新页面
+    }
 
     // 刷新子页面
     if (m_personalPage) {
@@ -126,6 +152,13 @@ void DataAnalyticsWidget::onDataRefreshed()
     updateCharts();
 }
 
+void DataAnalyticsWidget::onLiveClassesChanged()
+{
+    // 班级或花名册变化：重新填充下拉框
+    m_personalPage->setDataSource(m_dataSource);
+    m_classPage->setDataSource(m_dataSource);
+}
+
 void DataAnalyticsWidget::setupUI()
 {
     m_mainLayout = new QVBoxLayout(this);
@@ -143,10 +176,10 @@ void DataAnalyticsWidget::setupUI()
     createOverviewPage();
 
     m_personalPage = new PersonalAnalyticsPage();
-    m_personalPage->setDataSource(m_mockDataSource);
+    m_personalPage->setDataSource(m_dataSource);
 
     m_classPage = new ClassAnalyticsPage();
-    m_classPage->setDataSource(m_mockDataSource);
+    m_classPage->setDataSource(m_dataSource);
 
     m_knowledgeGraphPage = new KnowledgeGraphWidget();
     m_knowledgeGraphPage->loadGraph(KnowledgeGraph::instance());
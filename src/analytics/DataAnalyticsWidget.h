@@ -23,7 +23,8 @@
 
 class DifyService;
 class AnalyticsDataService;
-class MockDataSource;
+class IAnalyticsDataSource;
+class SupabaseAnalyticsDataSource;
 class AnalyticsNavigationBar;
 class PersonalAnalyticsPage;
 class ClassAnalyticsPage;
@@ -60,6 +61,7 @@ private slots:
     void onAIResponseReceived(const QString &response);
     void onAIStreamChunk(const QString &chunk);
     void onDataRefreshed();
+    void onLiveClassesChanged();
     void onViewChanged(int viewType);
 
 private:
@@ -120,7 +122,8 @@ private:
     // 服务
     DifyService *m_difyService;
     AnalyticsDataService *m_dataService;
-    MockDataSource *m_mockDataSource;
+    IAnalyticsDataSource *m_dataSource;                  // 个人 / 班级分析页的数据源（本对象持有）
+    SupabaseAnalyticsDataSource *m_liveDataSource;       // 登录后为真实数据源，否则为空、使用模拟数据
     QString m_currentAIResponse;
     bool m_isGeneratingReport;
 };
@@ -0,0 +1,419 @@
+#include "AnalyticsColumnStore.h"
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+
+namespace {
+double rateOf(double score, double fullScore) { return fullScore > 0 ? score / fullScore * 100.0 : 0.0; }
+
+constexpr qint64 OPEN_FROM = std::numeric_limits<qint32>::min();
+constexpr qint64 OPEN_TO = std::numeric_limits<qint32>::max();
+
+qint64 fromDayOf(const QDate &date) { return date.isValid() ? date.toJulianDay() : OPEN_FROM; }
+qint64 toDayOf(const QDate &date) { return date.isValid() ? date.toJulianDay() : OPEN_TO; }
+}
+
+// ===== 写入 =====
+
+void AnalyticsColumnStore::setClasses(const QVector<CourseClass> &classes)
+{
+    m_classes = classes;
+}
+
+void AnalyticsColumnStore::setStudents(const QVector<Student> &students)
+{
+    m_students = students;
+    m_studentIndex.clear();
+    m_classRoster.clear();
+    m_rosterPosition.resize(students.size());
+    for (int i = 0; i < students.size(); ++i) {
+        m_studentIndex.insert(students[i].id(), i);
+        QVector<int> &roster = m_classRoster[students[i].classId()];
+        m_rosterPosition[i] = roster.size();
+        roster.append(i);
+    }
+
+    // 成绩列里存的是学生下标，花名册变了只能重新导入成绩
+    m_recordId.clear();
+    m_day.clear();
+    m_score.clear();
+    m_fullScore.clear();
+    m_rate.clear();
+    m_student.clear();
+    m_rosterSlot.clear();
+    m_knowledge.clear();
+    m_subject.clear();
+    m_examType.clear();
+    m_class.clear();
+    m_classRanges.clear();
+    m_rowById.clear();
+    m_cache.clear();
+}
+
+void AnalyticsColumnStore::appendScores(const QVector<ScoreRecord> &records)
+{
+    QSet<int> touchedClasses;
+    bool needsLayout = false;
+    int skipped = 0;
+
+    for (const ScoreRecord &record : records) {
+        const int studentIndex = m_studentIndex.value(record.studentId(), -1);
+        if (studentIndex < 0) {
+            ++skipped;
+            continue;
+        }
+        const int classId = m_students[studentIndex].classId();
+        const qint32 day = static_cast<qint32>(record.date().toJulianDay());
+        const qint16 knowledge = record.knowledgePoint().isEmpty()
+            ? qint16(-1) : static_cast<qint16>(internKnowledgePoint(record.knowledgePoint()));
+        const qint16 subject = static_cast<qint16>(internSubject(record.subject()));
+        touchedClasses.insert(classId);
+
+        const int existing = record.id() > 0 ? m_rowById.value(record.id(), -1) : -1;
+        if (existing >= 0) {
+            if (m_day[existing] != day) needsLayout = true;
+            m_day[existing] = day;
+            m_score[existing] = record.score();
+            m_fullScore[existing] = record.fullScore();
+            m_rate[existing] = rateOf(record.score(), record.fullScore());
+            m_knowledge[existing] = knowledge;
+            m_subject[existing] = subject;
+            m_examType[existing] = static_cast<quint8>(record.examType());
+            continue;
+        }
+
+        if (record.id() > 0) {
+            m_rowById.insert(record.id(), m_day.size());
+        }
+        m_recordId.append(record.id());
+        m_day.append(day);
+        m_score.append(record.score());
+        m_fullScore.append(record.fullScore());
+        m_rate.append(rateOf(record.score(), record.fullScore()));
+        m_student.append(studentIndex);
+        m_rosterSlot.append(m_rosterPosition[studentIndex]);
+        m_knowledge.append(knowledge);
+        m_subject.append(subject);
+        m_examType.append(static_cast<quint8>(record.examType()));
+        m_class.append(classId);
+        needsLayout = true;
+    }
+
+    if (skipped > 0) {
+        qWarning() << "[AnalyticsColumnStore] 忽略未知学生的成绩:" << skipped;
+    }
+    if (needsLayout) {
+        rebuildLayout();
+    }
+    invalidateClasses(touchedClasses);
+}
+
+void AnalyticsColumnStore::clear()
+{
+    m_classes.clear();
+    setStudents({});
+    m_knowledgeNames.clear();
+    m_knowledgeIndex.clear();
+    m_subjectNames.clear();
+    m_subjectIndex.clear();
+}
+
+int AnalyticsColumnStore::internKnowledgePoint(const QString &name)
+{
+    auto it = m_knowledgeIndex.constFind(name);
+    if (it != m_knowledgeIndex.constEnd()) return it.value();
+    m_knowledgeNames.append(name);
+    m_knowledgeIndex.insert(name, m_knowledgeNames.size() - 1);
+    return m_knowledgeNames.size() - 1;
+}
+
+int AnalyticsColumnStore::internSubject(const QString &name)
+{
+    auto it = m_subjectIndex.constFind(name);
+    if (it != m_subjectIndex.constEnd()) return it.value();
+    m_subjectNames.append(name);
+    m_subjectIndex.insert(name, m_subjectNames.size() - 1);
+    return m_subjectNames.size() - 1;
+}
+
+void AnalyticsColumnStore::rebuildLayout()
+{
+    const int rows = m_day.size();
+    QVector<int> order(rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        if (m_class[a] != m_class[b]) return m_class[a] < m_class[b];
+        return m_day[a] < m_day[b];
+    });
+
+    auto permute = [&order](auto &column) {
+        std::remove_reference_t<decltype(column)> sorted;
+        sorted.reserve(column.size());
+        for (int i : order) sorted.append(column[i]);
+        column = std::move(sorted);
+    };
+    permute(m_recordId);
+    permute(m_day);
+    permute(m_score);
+    permute(m_fullScore);
+    permute(m_rate);
+    permute(m_student);
+    permute(m_rosterSlot);
+    permute(m_knowledge);
+    permute(m_subject);
+    permute(m_examType);
+    permute(m_class);
+
+    m_rowById.clear();
+    m_classRanges.clear();
+    for (int i = 0; i < rows; ++i) {
+        if (m_recordId[i] > 0) m_rowById.insert(m_recordId[i], i);
+        if (i == 0 || m_class[i] != m_class[i - 1]) {
+            m_classRanges.insert(m_class[i], Range{i, i});
+        }
+        m_classRanges[m_class[i]].end = i + 1;
+    }
+}
+
+void AnalyticsColumnStore::invalidateClasses(const QSet<int> &classIds)
+{
+    if (classIds.isEmpty()) return;
+    for (auto it = m_cache.begin(); it != m_cache.end();) {
+        if (classIds.contains(it.key().classId)) {
+            it = m_cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+// ===== 基础数据 =====
+
+CourseClass AnalyticsColumnStore::courseClass(int classId) const
+{
+    for (const CourseClass &cls : m_classes) {
+        if (cls.id() == classId) return cls;
+    }
+    return CourseClass();
+}
+
+QVector<Student> AnalyticsColumnStore::students(int classId) const
+{
+    if (classId < 0) return m_students;
+
+    QVector<Student> result;
+    const QVector<int> roster = m_classRoster.value(classId);
+    result.reserve(roster.size());
+    for (int index : roster) {
+        result.append(m_students[index]);
+    }
+    return result;
+}
+
+Student AnalyticsColumnStore::student(int studentId) const
+{
+    const int index = m_studentIndex.value(studentId, -1);
+    return index >= 0 ? m_students[index] : Student();
+}
+
+QDate AnalyticsColumnStore::latestDate() const
+{
+    qint64 latest = OPEN_FROM;
+    for (const Range &range : m_classRanges) {
+        if (range.end > range.begin) latest = qMax<qint64>(latest, m_day[range.end - 1]);
+    }
+    return latest == OPEN_FROM ? QDate() : QDate::fromJulianDay(latest);
+}
+
+// ===== 查询 =====
+
+AnalyticsColumnStore::Range AnalyticsColumnStore::rowsFor(int classId, const QDate &from, const QDate &to) const
+{
+    const Range whole = m_classRanges.value(classId);
+    if (whole.begin == whole.end) return whole;
+
+    const auto first = m_day.cbegin() + whole.begin;
+    const auto last = m_day.cbegin() + whole.end;
+    const auto lo = from.isValid() ? std::lower_bound(first, last, fromDayOf(from)) : first;
+    const auto hi = to.isValid() ? std::upper_bound(lo, last, toDayOf(to)) : last;
+    return Range{static_cast<int>(lo - m_day.cbegin()), static_cast<int>(hi - m_day.cbegin())};
+}
+
+AnalyticsColumnStore::ClassAggregate &AnalyticsColumnStore::aggregateFor(int classId, const QDate &from, const QDate &to) const
+{
+    return m_cache[CacheKey{classId, fromDayOf(from), toDayOf(to)}];
+}
+
+ScoreRecord AnalyticsColumnStore::recordAt(int row) const
+{
+    ScoreRecord record;
+    record.setId(m_recordId[row]);
+    record.setStudentId(m_students[m_student[row]].id());
+    record.setSubject(m_subjectNames.value(m_subject[row]));
+    record.setScore(m_score[row]);
+    record.setFullScore(m_fullScore[row]);
+    record.setDate(QDate::fromJulianDay(m_day[row]));
+    if (m_knowledge[row] >= 0) {
+        record.setKnowledgePoint(m_knowledgeNames[m_knowledge[row]]);
+    }
+    record.setExamType(static_cast<ScoreRecord::ExamType>(m_examType[row]));
+    return record;
+}
+
+QVector<ScoreRecord> AnalyticsColumnStore::studentScores(int studentId, const QDate &from, const QDate &to) const
+{
+    QVector<ScoreRecord> result;
+    const int index = m_studentIndex.value(studentId, -1);
+    if (index < 0) return result;
+
+    // 班级区间已按日期排序，过滤出的结果天然有序
+    const Range range = rowsFor(m_students[index].classId(), from, to);
+    const qint32 *student = m_student.constData();
+    for (int i = range.begin; i < range.end; ++i) {
+        if (student[i] == index) result.append(recordAt(i));
+    }
+    return result;
+}
+
+QVector<ScoreRecord> AnalyticsColumnStore::classScores(int classId, const QDate &from, const QDate &to) const
+{
+    const Range range = rowsFor(classId, from, to);
+    QVector<ScoreRecord> result;
+    result.reserve(range.end - range.begin);
+    for (int i = range.begin; i < range.end; ++i) {
+        result.append(recordAt(i));
+    }
+    return result;
+}
+
+ClassStatistics AnalyticsColumnStore::classStatistics(int classId, const QDate &from, const QDate &to) const
+{
+    ClassAggregate &aggregate = aggregateFor(classId, from, to);
+    if (aggregate.hasStatistics) return aggregate.statistics;
+
+    ClassStatistics stats;
+    stats.setClassId(classId);
+
+    const Range range = rowsFor(classId, from, to);
+    if (range.begin < range.end) {
+        // 区间按日期排序：最近一次考试就是末尾那一段
+        const qint32 latest = m_day[range.end - 1];
+        const int first = static_cast<int>(std::lower_bound(m_day.cbegin() + range.begin,
+                                                            m_day.cbegin() + range.end, latest)
+                                           - m_day.cbegin());
+
+        const double *rate = m_rate.constData();
+        double sum = 0;
+        double highest = rate[first];
+        double lowest = rate[first];
+        int buckets[4] = {0, 0, 0, 0};   // 不及格 / 及格 / 良好 / 优秀
+        for (int i = first; i < range.end; ++i) {
+            const double s = rate[i];
+            sum += s;
+            highest = qMax(highest, s);
+            lowest = qMin(lowest, s);
+            ++buckets[(s >= 60) + (s >= 80) + (s >= 90)];
+        }
+
+        const int count = range.end - first;
+        stats.setTotalStudents(count);
+        stats.setAverageScore(sum / count);
+        stats.setHighestScore(highest);
+        stats.setLowestScore(lowest);
+        stats.setFailCount(buckets[0]);
+        stats.setPassCount(buckets[1]);
+        stats.setGoodCount(buckets[2]);
+        stats.setExcellentCount(buckets[3]);
+    }
+
+    aggregate.statistics = stats;
+    aggregate.hasStatistics = true;
+    return stats;
+}
+
+QVector<QPair<Student, double>> AnalyticsColumnStore::classRanking(int classId, const QDate &from, const QDate &to) const
+{
+    ClassAggregate &aggregate = aggregateFor(classId, from, to);
+    if (aggregate.hasRanking) return aggregate.ranking;
+
+    const QVector<int> roster = m_classRoster.value(classId);
+    QVector<double> sums(roster.size(), 0.0);
+    QVector<int> counts(roster.size(), 0);
+
+    const Range range = rowsFor(classId, from, to);
+    const double *rate = m_rate.constData();
+    const qint32 *slot = m_rosterSlot.constData();
+    for (int i = range.begin; i < range.end; ++i) {
+        sums[slot[i]] += rate[i];
+        ++counts[slot[i]];
+    }
+
+    QVector<QPair<Student, double>> ranking;
+    ranking.reserve(roster.size());
+    for (int p = 0; p < roster.size(); ++p) {
+        ranking.append(qMakePair(m_students[roster[p]], counts[p] > 0 ? sums[p] / counts[p] : 0.0));
+    }
+    std::stable_sort(ranking.begin(), ranking.end(),
+                     [](const QPair<Student, double> &a, const QPair<Student, double> &b) {
+                         return a.second > b.second;
+                     });
+
+    aggregate.ranking = ranking;
+    aggregate.hasRanking = true;
+    return ranking;
+}
+
+QVector<KnowledgePoint> AnalyticsColumnStore::knowledgePoints(const Range &range, int studentIndex) const
+{
+    const int kpCount = m_knowledgeNames.size();
+    QVector<double> rateSum(kpCount, 0.0);
+    QVector<int> counts(kpCount, 0);
+    QVector<qint16> subjects(kpCount, -1);
+
+    const double *rate = m_rate.constData();
+    const qint16 *knowledge = m_knowledge.constData();
+    const qint32 *student = m_student.constData();
+    for (int i = range.begin; i < range.end; ++i) {
+        const int kp = knowledge[i];
+        if (kp < 0 || (studentIndex >= 0 && student[i] != studentIndex)) continue;
+        rateSum[kp] += rate[i];
+        ++counts[kp];
+        subjects[kp] = m_subject[i];
+    }
+
+    QVector<KnowledgePoint> result;
+    for (int kp = 0; kp < kpCount; ++kp) {
+        if (counts[kp] == 0) continue;
+        KnowledgePoint point(m_knowledgeNames[kp], rateSum[kp] / counts[kp]);
+        point.setId(kp + 1);
+        point.setQuestionCount(counts[kp]);
+        point.setCategory(m_subjectNames.value(subjects[kp]));
+        result.append(point);
+    }
+    return result;
+}
+
+QVector<KnowledgePoint> AnalyticsColumnStore::classKnowledgePoints(int classId, const QDate &from, const QDate &to) const
+{
+    ClassAggregate &aggregate = aggregateFor(classId, from, to);
+    if (aggregate.hasKnowledge) return aggregate.knowledge;
+
+    QVector<KnowledgePoint> result = knowledgePoints(rowsFor(classId, from, to), -1);
+    // 从低到高，便于显示薄弱知识点
+    std::sort(result.begin(), result.end(), [](const KnowledgePoint &a, const KnowledgePoint &b) {
+        return a.masteryRate() < b.masteryRate();
+    });
+
+    aggregate.knowledge = result;
+    aggregate.hasKnowledge = true;
+    return result;
+}
+
+QVector<KnowledgePoint> AnalyticsColumnStore::studentKnowledgePoints(int studentId, const QDate &from, const QDate &to) const
+{
+    const int index = m_studentIndex.value(studentId, -1);
+    if (index < 0) return {};
+    return knowledgePoints(rowsFor(m_students[index].classId(), from, to), index);
+}
@@ -0,0 +1,124 @@
+#ifndef ANALYTICSCOLUMNSTORE_H
+#define ANALYTICSCOLUMNSTORE_H
+
+#include <QDate>
+#include <QHash>
+#include <QPair>
+#include <QSet>
+#include <QStringList>
+#include <QVector>
+#include "../models/Student.h"
+#include "../models/CourseClass.h"
+#include "../models/ScoreRecord.h"
+#include "../models/KnowledgePoint.h"
+#include "../models/ClassStatistics.h"
+
+/**
+ * @brief 学情分析的列式内存存储
+ *
+ * 成绩按列存放（分数、日期、学生、知识点各一个数组），整体按 (班级, 日期) 排序，
+ * 每个班级占一段连续区间，m_classRanges 记录各班的起止下标。
+ * 按日期范围查询时在班级区间内二分定位，再对连续的列做单趟扫描：
+ * 统计、排名、知识点掌握度都不需要再按学生过滤或重复排序。
+ *
+ * 汇总结果按 (班级, 日期范围) 缓存，直到该班有新成绩写入。
+ * 知识点、科目名按字典编码成小整数，列里只存编号。
+ */
+class AnalyticsColumnStore
+{
+public:
+    // ===== 写入 =====
+    void setClasses(const QVector<CourseClass> &classes);
+    void setStudents(const QVector<Student> &students);        // 同时清空成绩
+    void appendScores(const QVector<ScoreRecord> &records);    // 按 id 去重，已存在的记录原地更新
+    void clear();
+
+    // ===== 基础数据 =====
+    QVector<CourseClass> classes() const { return m_classes; }
+    CourseClass courseClass(int classId) const;
+    QVector<Student> students(int classId = -1) const;
+    Student student(int studentId) const;
+    int scoreCount() const { return m_day.size(); }
+    QDate latestDate() const;
+
+    // ===== 查询（日期无效表示不限，区间含两端）=====
+    QVector<ScoreRecord> studentScores(int studentId, const QDate &from = QDate(), const QDate &to = QDate()) const;
+    QVector<ScoreRecord> classScores(int classId, const QDate &from = QDate(), const QDate &to = QDate()) const;
+
+    // 以下统计都按得分率（分数 / 满分 × 100）计算，满分不同的作业可以直接比较
+    // 区间内最近一次考试的统计
+    ClassStatistics classStatistics(int classId, const QDate &from = QDate(), const QDate &to = QDate()) const;
+    // 区间内平均得分率排名，降序
+    QVector<QPair<Student, double>> classRanking(int classId, const QDate &from = QDate(), const QDate &to = QDate()) const;
+    // 知识点掌握度 = 该知识点得分率均值；班级按掌握率升序，学生按知识点字典顺序
+    QVector<KnowledgePoint> classKnowledgePoints(int classId, const QDate &from = QDate(), const QDate &to = QDate()) const;
+    QVector<KnowledgePoint> studentKnowledgePoints(int studentId, const QDate &from = QDate(), const QDate &to = QDate()) const;
+
+private:
+    struct Range {
+        int begin = 0;
+        int end = 0;
+    };
+
+    struct CacheKey {
+        int classId;
+        qint64 fromDay;
+        qint64 toDay;
+        bool operator==(const CacheKey &other) const {
+            return classId == other.classId && fromDay == other.fromDay && toDay == other.toDay;
+        }
+    };
+    friend size_t qHash(const CacheKey &key, size_t seed) {
+        return qHashMulti(seed, key.classId, key.fromDay, key.toDay);
+    }
+
+    struct ClassAggregate {
+        bool hasStatistics = false;
+        bool hasRanking = false;
+        bool hasKnowledge = false;
+        ClassStatistics statistics;
+        QVector<QPair<Student, double>> ranking;
+        QVector<KnowledgePoint> knowledge;
+    };
+
+    int internKnowledgePoint(const QString &name);
+    int internSubject(const QString &name);
+    void rebuildLayout();
+    void invalidateClasses(const QSet<int> &classIds);
+
+    Range rowsFor(int classId, const QDate &from, const QDate &to) const;
+    ClassAggregate &aggregateFor(int classId, const QDate &from, const QDate &to) const;
+    QVector<KnowledgePoint> knowledgePoints(const Range &range, int studentIndex) const;
+    ScoreRecord recordAt(int row) const;
+
+    // 基础数据
+    QVector<CourseClass> m_classes;
+    QVector<Student> m_students;
+    QHash<int, int> m_studentIndex;              // 学生 ID -> m_students 下标
+    QHash<int, QVector<int>> m_classRoster;      // 班级 ID -> 学生下标（花名册顺序）
+    QVector<int> m_rosterPosition;               // 学生下标 -> 在本班花名册中的位置
+    QStringList m_knowledgeNames;
+    QHash<QString, int> m_knowledgeIndex;
+    QStringList m_subjectNames;
+    QHash<QString, int> m_subjectIndex;
+
+    // 成绩列（按班级、日期排序）
+    QVector<int> m_recordId;
+    QVector<qint32> m_day;                       // QDate::toJulianDay()
+    QVector<double> m_score;
+    QVector<double> m_fullScore;
+    QVector<double> m_rate;                      // 得分率（百分制），统计 / 排名 / 知识点都按它算
+    QVector<qint32> m_student;                   // m_students 下标
+    QVector<qint32> m_rosterSlot;                // 本班花名册位置，排名时直接作累加下标
+    QVector<qint16> m_knowledge;                 // 知识点编号，-1 为未标注
+    QVector<qint16> m_subject;
+    QVector<quint8> m_examType;
+    QVector<qint32> m_class;
+
+    QHash<int, Range> m_classRanges;             // 班级 ID -> 成绩行区间
+    QHash<int, int> m_rowById;                   // 成绩 ID -> 行号
+
+    mutable QHash<CacheKey, ClassAggregate> m_cache;
+};
+
+#endif // ANALYTICSCOLUMNSTORE_H
@@ -0,0 +1,63 @@
+#include "ColumnarDataSource.h"
+
+QVector<Student> ColumnarDataSource::getStudentList(int classId)
+{
+    return m_store.students(classId);
+}
+
+Student ColumnarDataSource::getStudent(int studentId)
+{
+    return m_store.student(studentId);
+}
+
+QVector<CourseClass> ColumnarDataSource::getClassList()
+{
+    return m_store.classes();
+}
+
+CourseClass ColumnarDataSource::getClass(int classId)
+{
+    return m_store.courseClass(classId);
+}
+
+QVector<ScoreRecord> ColumnarDataSource::getStudentScores(int studentId,
+                                                          const QDate &startDate,
+                                                          const QDate &endDate)
+{
+    return m_store.studentScores(studentId, startDate, endDate);
+}
+
+QVector<ScoreRecord> ColumnarDataSource::getClassScores(int classId,
+                                                        const QDate &startDate,
+                                                        const QDate &endDate)
+{
+    return m_store.classScores(classId, startDate, endDate);
+}
+
+QVector<KnowledgePoint> ColumnarDataSource::getStudentKnowledgePoints(int studentId,
+                                                                     const QDate &startDate,
+                                                                     const QDate &endDate)
+{
+    return m_store.studentKnowledgePoints(studentId, startDate, endDate);
+}
+
+QVector<KnowledgePoint> ColumnarDataSource::getClassKnowledgePoints(int classId,
+                                                                   const QDate &startDate,
+                                                                   const QDate &endDate)
+{
+    return m_store.classKnowledgePoints(classId, startDate, endDate);
+}
+
+ClassStatistics ColumnarDataSource::getClassStatistics(int classId,
+                                                       const QDate &startDate,
+                                                       const QDate &endDate)
+{
+    return m_store.classStatistics(classId, startDate, endDate);
+}
+
+QVector<QPair<Student, double>> ColumnarDataSource::getClassRanking(int classId,
+                                                                    const QDate &startDate,
+                                                                    const QDate &endDate)
+{
+    return m_store.classRanking(classId, startDate, endDate);
+}
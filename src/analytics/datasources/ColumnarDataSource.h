@@ -0,0 +1,52 @@
+#ifndef COLUMNARDATASOURCE_H
+#define COLUMNARDATASOURCE_H
+
+#include "../interfaces/IAnalyticsDataSource.h"
+#include "AnalyticsColumnStore.h"
+
+/**
+ * @brief 基于列式存储的数据源
+ *
+ * 查询全部落到 AnalyticsColumnStore 上，子类只负责把班级、学生、成绩灌进来。
+ * 统计、排名、知识点按 (班级, 日期范围) 缓存，appendScores() 写入新成绩时失效。
+ */
+class ColumnarDataSource : public IAnalyticsDataSource
+{
+public:
+    QVector<Student> getStudentList(int classId = -1) override;
+    Student getStudent(int studentId) override;
+
+    QVector<CourseClass> getClassList() override;
+    CourseClass getClass(int classId) override;
+
+    QVector<ScoreRecord> getStudentScores(int studentId,
+                                           const QDate &startDate = QDate(),
+                                           const QDate &endDate = QDate()) override;
+    QVector<ScoreRecord> getClassScores(int classId,
+                                         const QDate &startDate = QDate(),
+                                         const QDate &endDate = QDate()) override;
+
+    QVector<KnowledgePoint> getStudentKnowledgePoints(int studentId,
+                                                      const QDate &startDate = QDate(),
+                                                      const QDate &endDate = QDate()) override;
+    QVector<KnowledgePoint> getClassKnowledgePoints(int classId,
+                                                    const QDate &startDate = QDate(),
+                                                    const QDate &endDate = QDate()) override;
+
+    ClassStatistics getClassStatistics(int classId,
+                                       const QDate &startDate = QDate(),
+                                       const QDate &endDate = QDate()) override;
+
+    QVector<QPair<Student, double>> getClassRanking(int classId,
+                                                    const QDate &startDate = QDate(),
+                                                    const QDate &endDate = QDate()) override;
+
+protected:
+    AnalyticsColumnStore &store() { return m_store; }
+    const AnalyticsColumnStore &store() const { return m_store; }
+
+private:
+    AnalyticsColumnStore m_store;
+};
+
+#endif // COLUMNARDATASOURCE_H
@@ -19,9 +19,9 @@ MockDataSource::MockDataSource()
 
 void MockDataSource::generateMockData()
 {
-    m_students.clear();
-    m_classes.clear();
-    m_scores.clear();
+    QVector<CourseClass> classes;
+    QVector<Student> students;
+    QVector<ScoreRecord> scores;
 
     // 生成3个班级
     QStringList classNames = {"初二1班", "初二2班", "初二3班"};
@@ -32,7 +32,7 @@ void MockDataSource::generateMockData()
         cls.setGrade("初二");
         cls.setTeacherId("teacher_001");
         cls.setStudentCount(30);
-        m_classes.append(cls);
+        classes.append(cls);
     }
 
     // 为每个班级生成30个学生
@@ -51,24 +51,30 @@ void MockDataSource::generateMockData()
             student.setClassId(classIdx + 1);
             student.setStudentNo(QString("2024%1%2").arg(classIdx + 1, 2, 10, QChar('0'))
                                                      .arg(i + 1, 2, 10, QChar('0')));
-            m_students.append(student);
+            students.append(student);
 
             // 为每个学生生成10次考试成绩
             for (int examIdx = 0; examIdx < 10; ++examIdx) {
                 ScoreRecord record;
-                record.setId(m_scores.size() + 1);
+                record.setId(scores.size() + 1);
                 record.setStudentId(studentId);
                 record.setSubject("思想政治");
                 record.setScore(randomScore());
                 record.setDate(QDate::currentDate().addDays(-examIdx * 7));
-                record.setKnowledgePoint(m_knowledgePointNames[QRandomGenerator::global()->bounded(m_knowledgePointNames.size())]);
+                // 轮流覆盖每个知识点，掌握度由成绩算出
+                record.setKnowledgePoint(m_knowledgePointNames[(examIdx + studentId) % m_knowledgePointNames.size()]);
                 record.setExamType(static_cast<ScoreRecord::ExamType>(QRandomGenerator::global()->bounded(4)));
-                m_scores.append(record);
+                scores.append(record);
             }
 
             studentId++;
         }
     }
+
+    store().clear();
+    store().setClasses(classes);
+    store().setStudents(students);
+    store().appendScores(scores);
 }
 
 double MockDataSource::randomScore()
@@ -81,202 +87,6 @@ double MockDataSource::randomScore()
     return qBound(30.0, score, 100.0);
 }
 
-double MockDataSource::randomMasteryRate()
-{
-    return 40.0 + QRandomGenerator::global()->generateDouble() * 55.0;
-}
-
-QVector<Student> MockDataSource::getStudentList(int classId)
-{
-    if (classId < 0) {
-        return m_students;
-    }
-    QVector<Student> result;
-    for (const auto &student : m_students) {
-        if (student.classId() == classId) {
-            result.append(student);
-        }
-    }
-    return result;
-}
-
-Student MockDataSource::getStudent(int studentId)
-{
-    for (const auto &student : m_students) {
-        if (student.id() == studentId) {
-            return student;
-        }
-    }
-    return Student();
-}
-
-QVector<CourseClass> MockDataSource::getClassList()
-{
-    return m_classes;
-}
-
-CourseClass MockDataSource::getClass(int classId)
-{
-    for (const auto &cls : m_classes) {
-        if (cls.id() == classId) {
-            return cls;
-        }
-    }
-    return CourseClass();
-}
-
-QVector<ScoreRecord> MockDataSource::getStudentScores(int studentId,
-                                                       const QDate &startDate,
-                                                       const QDate &endDate)
-{
-    QVector<ScoreRecord> result;
-    for (const auto &record : m_scores) {
-        if (record.studentId() != studentId) continue;
-        if (startDate.isValid() && record.date() < startDate) continue;
-        if (endDate.isValid() && record.date() > endDate) continue;
-        result.append(record);
-    }
-    // 按日期排序
-    std::sort(result.begin(), result.end(), [](const ScoreRecord &a, const ScoreRecord &b) {
-        return a.date() < b.date();
-    });
-    return result;
-}
-
-QVector<ScoreRecord> MockDataSource::getClassScores(int classId,
-                                                     const QDate &startDate,
-                                                     const QDate &endDate)
-{
-    QVector<ScoreRecord> result;
-    QSet<int> classStudentIds;
-    for (const auto &student : m_students) {
-        if (student.classId() == classId) {
-            classStudentIds.insert(student.id());
-        }
-    }
-
-    for (const auto &record : m_scores) {
-        if (!classStudentIds.contains(record.studentId())) continue;
-        if (startDate.isValid() && record.date() < startDate) continue;
-        if (endDate.isValid() && record.date() > endDate) continue;
-        result.append(record);
-    }
-    return result;
-}
-
-QVector<KnowledgePoint> MockDataSource::getStudentKnowledgePoints(int studentId)
-{
-    Q_UNUSED(studentId)
-    QVector<KnowledgePoint> result;
-    for (const QString &name : m_knowledgePointNames) {
-        KnowledgePoint kp(name, randomMasteryRate());
-        kp.setQuestionCount(QRandomGenerator::global()->bounded(5, 20));
-        kp.setCategory("思想政治");
-        result.append(kp);
-    }
-    return result;
-}
-
-QVector<KnowledgePoint> MockDataSource::getClassKnowledgePoints(int classId)
-{
-    Q_UNUSED(classId)
-    QVector<KnowledgePoint> result;
-    for (const QString &name : m_knowledgePointNames) {
-        KnowledgePoint kp(name, randomMasteryRate());
-        kp.setQuestionCount(QRandomGenerator::global()->bounded(20, 100));
-        kp.setCategory("思想政治");
-        result.append(kp);
-    }
-    // 按掌握率排序（从低到高，便于显示薄弱知识点）
-    std::sort(result.begin(), result.end(), [](const KnowledgePoint &a, const KnowledgePoint &b) {
-        return a.masteryRate() < b.masteryRate();
-    });
-    return result;
-}
-
-ClassStatistics MockDataSource::getClassStatistics(int classId)
-{
-    auto scores = getClassScores(classId);
-    ClassStatistics stats;
-    stats.setClassId(classId);
-
-    if (scores.isEmpty()) {
-        return stats;
-    }
-
-    // 计算最近一次考试的统计数据
-    QDate latestDate;
-    for (const auto &record : scores) {
-        if (!latestDate.isValid() || record.date() > latestDate) {
-            latestDate = record.date();
-        }
-    }
-
-    QVector<double> latestScores;
-    for (const auto &record : scores) {
-        if (record.date() == latestDate) {
-            latestScores.append(record.score());
-        }
-    }
-
-    if (latestScores.isEmpty()) {
-        return stats;
-    }
-
-    stats.setTotalStudents(latestScores.size());
-
-    double sum = 0, highest = 0, lowest = 100;
-    int excellent = 0, good = 0, pass = 0, fail = 0;
-
-    for (double score : latestScores) {
-        sum += score;
-        highest = qMax(highest, score);
-        lowest = qMin(lowest, score);
-
-        if (score >= 90) excellent++;
-        else if (score >= 80) good++;
-        else if (score >= 60) pass++;
-        else fail++;
-    }
-
-    stats.setAverageScore(sum / latestScores.size());
-    stats.setHighestScore(highest);
-    stats.setLowestScore(lowest);
-    stats.setExcellentCount(excellent);
-    stats.setGoodCount(good);
-    stats.setPassCount(pass);
-    stats.setFailCount(fail);
-
-    return stats;
-}
-
-QVector<QPair<Student, double>> MockDataSource::getClassRanking(int classId)
-{
-    QVector<QPair<Student, double>> result;
-    auto students = getStudentList(classId);
-
-    for (const auto &student : students) {
-        auto scores = getStudentScores(student.id());
-        double avgScore = 0;
-        if (!scores.isEmpty()) {
-            double sum = 0;
-            for (const auto &record : scores) {
-                sum += record.score();
-            }
-            avgScore = sum / scores.size();
-        }
-        result.append(qMakePair(student, avgScore));
-    }
-
-    // 按成绩降序排序
-    std::sort(result.begin(), result.end(),
-              [](const QPair<Student, double> &a, const QPair<Student, double> &b) {
-                  return a.second > b.second;
-              });
-
-    return result;
-}
-
 void MockDataSource::refreshData()
 {
     generateMockData();
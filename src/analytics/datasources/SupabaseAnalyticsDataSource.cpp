@@ -0,0 +1,694 @@
+#include "SupabaseAnalyticsDataSource.h"
+#include "../AnalyticsDataService.h"
+#include "../../auth/supabase/supabaseconfig.h"
+#include "../../utils/NetworkRequestFactory.h"
+#include "../../utils/SessionNetworkManager.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QMap>
+#include <QNetworkReply>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QUrlQuery>
+
+namespace {
+constexpr quint32 CACHE_MAGIC = 0x414E4C59;   // "ANLY"
+constexpr quint32 CACHE_VERSION = 2;   // 2: 增加上次全量同步时间
+
+QJsonArray replyArray(QNetworkReply *reply)
+{
+    return QJsonDocument::fromJson(reply->readAll()).array();
+}
+
+QDate dateOf(const QJsonValue &value)
+{
+    return QDateTime::fromString(value.toString(), Qt::ISODateWithMs).toLocalTime().date();
+}
+
+QDateTime timestampOf(const QString &value)
+{
+    return QDateTime::fromString(value, Qt::ISODateWithMs);
+}
+}
+
+SupabaseAnalyticsDataSource::SupabaseAnalyticsDataSource(QObject *parent)
+    : QObject(parent)
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
+{
+}
+
+void SupabaseAnalyticsDataSource::setTeacherEmail(const QString &email)
+{
+    if (m_teacherEmail == email) return;
+    m_teacherEmail = email;
+
+    store().clear();
+    m_classRefs.clear();
+    m_classIds.clear();
+    m_studentIds.clear();
+    m_recordIds.clear();
+    m_watermark.clear();
+    m_watermarkId.clear();
+    m_lastFullSync = QDateTime();
+    m_serverStatistics.clear();
+    m_serverKnowledge.clear();
+
+    // 先用本地缓存渲染，再后台增量同步
+    if (loadCache()) {
+        emit classesChanged();
+        emit dataChanged();
+    }
+    sync();
+}
+
+// ===== 查询 =====
+
+QVector<KnowledgePoint> SupabaseAnalyticsDataSource::getClassKnowledgePoints(int classId,
+                                                                            const QDate &startDate,
+                                                                            const QDate &endDate)
+{
+    if (!startDate.isValid() && !endDate.isValid()) {
+        auto it = m_serverKnowledge.constFind(classId);
+        if (it != m_serverKnowledge.constEnd()) return it.value();
+    }
+    return ColumnarDataSource::getClassKnowledgePoints(classId, startDate, endDate);
+}
+
+ClassStatistics SupabaseAnalyticsDataSource::getClassStatistics(int classId,
+                                                                const QDate &startDate,
+                                                                const QDate &endDate)
+{
+    if (!startDate.isValid() && !endDate.isValid()) {
+        auto it = m_serverStatistics.constFind(classId);
+        if (it != m_serverStatistics.constEnd()) return it.value();
+    }
+    return ColumnarDataSource::getClassStatistics(classId, startDate, endDate);
+}
+
+// ===== 同步 =====
+
+void SupabaseAnalyticsDataSource::sync()
+{
+    if (m_teacherEmail.isEmpty() || m_syncing) return;
+    m_syncing = true;
+    qDebug() << "[SupabaseAnalyticsDataSource] 开始同步，水位:" << (m_watermark.isEmpty() ? "无" : m_watermark);
+    fetchClasses();
+}
+
+void SupabaseAnalyticsDataSource::fetchClasses()
+{
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/classes");
+    QUrlQuery query;
+    query.addQueryItem("select", "id,name,student_count");
+    query.addQueryItem("teacher_email", "eq." + m_teacherEmail);
+    query.addQueryItem("order", "created_at.asc");
+    url.setQuery(query);
+
+    QNetworkReply *reply = m_networkManager->get(NetworkRequestFactory::createAuthRequest(url));
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            failSync("classes", reply);
+            return;
+        }
+        onClassesReceived(replyArray(reply));
+    });
+}
+
+void SupabaseAnalyticsDataSource::onClassesReceived(const QJsonArray &rows)
+{
+    QVector<CourseClass> classes;
+    QVector<ClassRef> refs;
+    for (const QJsonValue &value : rows) {
+        const QJsonObject row = value.toObject();
+        const QString uuid = row["id"].toString();
+        CourseClass cls;
+        cls.setId(localId(m_classIds, uuid));
+        cls.setName(row["name"].toString());
+        cls.setTeacherId(m_teacherEmail);
+        cls.setStudentCount(row["student_count"].toInt());
+        classes.append(cls);
+        refs.append(ClassRef{uuid, cls.id()});
+    }
+
+    const QVector<CourseClass> previous = store().classes();
+    bool changed = previous.size() != classes.size();
+    for (int i = 0; !changed && i < classes.size(); ++i) {
+        changed = previous[i].id() != classes[i].id() || previous[i].name() != classes[i].name();
+    }
+    m_classRefs = refs;
+    store().setClasses(classes);
+    if (changed) {
+        m_cacheDirty = true;
+        emit classesChanged();
+    }
+
+    if (m_classRefs.isEmpty()) {
+        qDebug() << "[SupabaseAnalyticsDataSource] 没有班级";
+        finishSync();
+        return;
+    }
+    m_pendingMembers = QJsonArray();
+    fetchMembers();
+}
+
+void SupabaseAnalyticsDataSource::fetchMembers(int offset)
+{
+    QStringList uuids;
+    for (const ClassRef &ref : m_classRefs) uuids.append(ref.uuid);
+
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/class_members");
+    QUrlQuery query;
+    query.addQueryItem("select", "class_id,student_email,student_name,student_number");
+    query.addQueryItem("class_id", "in.(" + uuids.join(',') + ")");
+    query.addQueryItem("order", "class_id.asc,joined_at.asc,student_email.asc");
+    query.addQueryItem("limit", QString::number(MEMBER_PAGE_SIZE));
+    query.addQueryItem("offset", QString::number(offset));
+    url.setQuery(query);
+
+    QNetworkReply *reply = m_networkManager->get(NetworkRequestFactory::createAuthRequest(url));
+    connect(reply, &QNetworkReply::finished, this, [this, reply, offset]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            failSync("class_members", reply);
+            return;
+        }
+        const QJsonArray page = replyArray(reply);
+        for (const QJsonValue &value : page) m_pendingMembers.append(value);
+        if (page.size() == MEMBER_PAGE_SIZE) {
+            fetchMembers(offset + MEMBER_PAGE_SIZE);
+            return;
+        }
+        const QJsonArray members = m_pendingMembers;
+        m_pendingMembers = QJsonArray();
+        onMembersReceived(members);
+    });
+}
+
+void SupabaseAnalyticsDataSource::onMembersReceived(const QJsonArray &rows)
+{
+    QVector<Student> students;
+    students.reserve(rows.size());
+    for (const QJsonValue &value : rows) {
+        const QJsonObject row = value.toObject();
+        const QString classUuid = row["class_id"].toString();
+        const QString email = row["student_email"].toString();
+        const QString name = row["student_name"].toString();
+        Student student;
+        student.setId(localId(m_studentIds, classUuid + '|' + email));
+        student.setClassId(m_classIds.value(classUuid));
+        student.setName(name.isEmpty() ? email : name);
+        student.setStudentNo(row["student_number"].toString());
+        students.append(student);
+    }
+
+    const QVector<Student> previous = store().students();
+    QSet<int> previousIds;
+    for (const Student &student : previous) previousIds.insert(student.id());
+
+    bool changed = previous.size() != students.size();
+    bool joined = false;
+    for (int i = 0; i < students.size(); ++i) {
+        if (!previousIds.contains(students[i].id())) joined = true;
+        if (!changed) {
+            changed = previous[i].id() != students[i].id()
+                      || previous[i].name() != students[i].name()
+                      || previous[i].classId() != students[i].classId()
+                      || previous[i].studentNo() != students[i].studentNo();
+        }
+    }
+
+    if (changed) {
+        // 花名册变了要重建列式存储，已缓存的成绩原样放回（退出班级的学生成绩被丢弃）
+        QVector<ScoreRecord> existing;
+        if (!joined) {
+            for (const CourseClass &cls : store().classes()) {
+                existing += store().classScores(cls.id());
+            }
+        } else {
+            // 新加入的学生可能有水位之前的成绩，整体重新拉取一次
+            qDebug() << "[SupabaseAnalyticsDataSource] 有新成员加入，重新全量同步成绩";
+            m_watermark.clear();
+            m_watermarkId.clear();
+        }
+        store().setStudents(students);
+        store().appendScores(existing);
+        m_cacheDirty = true;
+        emit classesChanged();
+    }
+
+    fetchOverview();
+}
+
+void SupabaseAnalyticsDataSource::fetchOverview()
+{
+    QJsonObject body;
+    body["p_class_ids"] = classUuidArray();
+    body["p_activity_days"] = ACTIVITY_DAYS;
+
+    QNetworkReply *reply = postRpc("analytics_class_overview", body);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            // 汇总拿不到不影响成绩同步，统计改由本地列式存储计算
+            qWarning() << "[SupabaseAnalyticsDataSource] 获取服务端汇总失败，改用本地计算:" << reply->errorString();
+            m_serverStatistics.clear();
+            m_serverKnowledge.clear();
+        } else {
+            onOverviewReceived(QJsonDocument::fromJson(reply->readAll()).object());
+        }
+        startScoreSync();
+    });
+}
+
+void SupabaseAnalyticsDataSource::onOverviewReceived(const QJsonObject &overview)
+{
+    const QJsonArray exams = overview["exams"].toArray();
+    const QJsonArray knowledge = overview["knowledge"].toArray();
+
+    // exams 按 (班级, 日期) 升序，每个班级最后一条就是最近一次作业
+    m_serverStatistics.clear();
+    for (const QJsonValue &value : exams) {
+        const QJsonObject row = value.toObject();
+        const int classId = m_classIds.value(row["class_id"].toString(), -1);
+        if (classId < 0) continue;
+
+        ClassStatistics stats;
+        stats.setClassId(classId);
+        stats.setTotalStudents(row["graded_count"].toInt());
+        stats.setAverageScore(row["average_rate"].toDouble());
+        stats.setHighestScore(row["highest_rate"].toDouble());
+        stats.setLowestScore(row["lowest_rate"].toDouble());
+        stats.setExcellentCount(row["excellent_count"].toInt());
+        stats.setGoodCount(row["good_count"].toInt());
+        stats.setPassCount(row["pass_count"].toInt());
+        stats.setFailCount(row["fail_count"].toInt());
+        m_serverStatistics.insert(classId, stats);
+    }
+
+    // knowledge 按 (班级, 掌握率) 升序
+    m_serverKnowledge.clear();
+    for (const QJsonValue &value : knowledge) {
+        const QJsonObject row = value.toObject();
+        const int classId = m_classIds.value(row["class_id"].toString(), -1);
+        if (classId < 0) continue;
+
+        QVector<KnowledgePoint> &points = m_serverKnowledge[classId];
+        KnowledgePoint point(row["knowledge_point"].toString(), row["mastery_rate"].toDouble());
+        point.setId(points.size() + 1);
+        point.setQuestionCount(row["question_count"].toInt());
+        points.append(point);
+    }
+
+    applyOverviewMetrics(exams, overview["activity"].toArray());
+    qDebug() << "[SupabaseAnalyticsDataSource] 服务端汇总已更新，快照时间:" << overview["refreshed_at"].toString();
+    emit dataChanged();
+}
+
+void SupabaseAnalyticsDataSource::applyOverviewMetrics(const QJsonArray &exams, const QJsonArray &activity)
+{
+    struct DayTotals {
+        qint64 attendancePresent = 0;
+        qint64 attendanceExpected = 0;
+        qint64 homeworkSubmitted = 0;
+        qint64 homeworkExpected = 0;
+    };
+    QMap<QDate, DayTotals> days;
+    for (const QJsonValue &value : activity) {
+        const QJsonObject row = value.toObject();
+        DayTotals &totals = days[QDate::fromString(row["day"].toString(), Qt::ISODate)];
+        totals.attendancePresent += row["attendance_present"].toInteger();
+        totals.attendanceExpected += row["attendance_expected"].toInteger();
+        totals.homeworkSubmitted += row["homework_submitted"].toInteger();
+        totals.homeworkExpected += row["homework_expected"].toInteger();
+    }
+
+    const QDate today = QDate::currentDate();
+    // [from, to] 内的比率（百分比），没有应到 / 应交时为 0
+    auto rateBetween = [&days](const QDate &from, const QDate &to, bool attendance) {
+        qint64 done = 0, expected = 0;
+        for (auto it = days.lowerBound(from); it != days.end() && it.key() <= to; ++it) {
+            done += attendance ? it->attendancePresent : it->homeworkSubmitted;
+            expected += attendance ? it->attendanceExpected : it->homeworkExpected;
+        }
+        return expected > 0 ? done * 100.0 / expected : 0.0;
+    };
+    auto metric = [](double current, double previous) {
+        AnalyticsDataService::MetricData data;
+        data.value = current;
+        data.change = current - previous;
+        data.isPositive = data.change >= 0;
+        return data;
+    };
+
+    // 本周 vs 上周
+    const AnalyticsDataService::MetricData participation = metric(
+        rateBetween(today.addDays(-6), today, true), rateBetween(today.addDays(-13), today.addDays(-7), true));
+    const AnalyticsDataService::MetricData completion = metric(
+        rateBetween(today.addDays(-6), today, false), rateBetween(today.addDays(-13), today.addDays(-7), false));
+
+    QVector<AnalyticsDataService::TrendPoint> participationTrend;
+    QVector<AnalyticsDataService::TrendPoint> completionTrend;
+    for (auto it = days.lowerBound(today.addDays(-29)); it != days.end() && it.key() <= today; ++it) {
+        if (it->attendanceExpected > 0) {
+            participationTrend.append({it.key(), it->attendancePresent * 100.0 / it->attendanceExpected});
+        }
+        if (it->homeworkExpected > 0) {
+            completionTrend.append({it.key(), it->homeworkSubmitted * 100.0 / it->homeworkExpected});
+        }
+    }
+
+    // 近 30 天作业的成绩分布和达标率（及格及以上），与再往前 30 天比较
+    AnalyticsDataService::GradeDistribution distribution{0, 0, 0, 0};
+    int previousTotal = 0, previousPassed = 0;
+    for (const QJsonValue &value : exams) {
+        const QJsonObject row = value.toObject();
+        const QDate date = dateOf(row["exam_date"]);
+        if (date > today || date < today.addDays(-59)) continue;
+        if (date >= today.addDays(-29)) {
+            distribution.excellent += row["excellent_count"].toInt();
+            distribution.good += row["good_count"].toInt();
+            distribution.pass += row["pass_count"].toInt();
+            distribution.fail += row["fail_count"].toInt();
+        } else {
+            previousTotal += row["graded_count"].toInt();
+            previousPassed += row["graded_count"].toInt() - row["fail_count"].toInt();
+        }
+    }
+    const int total = distribution.excellent + distribution.good + distribution.pass + distribution.fail;
+    const double achievementRate = total > 0 ? (total - distribution.fail) * 100.0 / total : 0.0;
+    const double previousAchievement = previousTotal > 0 ? previousPassed * 100.0 / previousTotal : achievementRate;
+
+    AnalyticsDataService::instance()->setLiveData(participation, completion,
+                                                  metric(achievementRate, previousAchievement),
+                                                  distribution, participationTrend, completionTrend);
+}
+
+void SupabaseAnalyticsDataSource::startScoreSync()
+{
+    const QDateTime now = QDateTime::currentDateTimeUtc();
+    m_fullResync = m_watermark.isEmpty() || !m_lastFullSync.isValid()
+                   || m_lastFullSync.secsTo(now) >= FULL_RESYNC_INTERVAL_SECS;
+    m_resyncScores.clear();
+    m_pageAfterId.clear();
+
+    if (m_fullResync) {
+        // 全量重建：删除的提交、撤销的分数不会出现在增量里，只能靠定期重拉清掉
+        qDebug() << "[SupabaseAnalyticsDataSource] 全量同步成绩";
+        m_pageSince.clear();
+    } else {
+        // updated_at 是事务开始时间，慢事务可能在水位推过之后才提交更早的行，
+        // 从水位往前回退一个安全窗口重读，重复的行按 id 原地更新
+        m_pageSince = timestampOf(m_watermark).addSecs(-WATERMARK_SAFETY_SECS).toString(Qt::ISODateWithMs);
+    }
+    fetchScoreChanges();
+}
+
+void SupabaseAnalyticsDataSource::fetchScoreChanges()
+{
+    QJsonObject body;
+    body["p_class_ids"] = classUuidArray();
+    body["p_since"] = m_pageSince.isEmpty() ? QJsonValue() : QJsonValue(m_pageSince);
+    body["p_after_id"] = m_pageAfterId.isEmpty() ? QJsonValue() : QJsonValue(m_pageAfterId);
+    body["p_limit"] = SCORE_PAGE_SIZE;
+
+    QNetworkReply *reply = postRpc("analytics_score_changes", body);
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            failSync("analytics_score_changes", reply);
+            return;
+        }
+        onScoreChangesReceived(replyArray(reply));
+    });
+}
+
+void SupabaseAnalyticsDataSource::onScoreChangesReceived(const QJsonArray &rows)
+{
+    // 只同步已批改的成绩；删除提交或撤销分数不会出现在增量里，等下次定期全量重建时消失
+    QVector<ScoreRecord> records;
+    records.reserve(rows.size());
+    for (const QJsonValue &value : rows) {
+        const QJsonObject row = value.toObject();
+        const QString classUuid = row["class_id"].toString();
+        const int studentId = m_studentIds.value(classUuid + '|' + row["student_email"].toString(), -1);
+        if (studentId < 0) continue;   // 已退出班级
+
+        ScoreRecord record;
+        record.setId(localId(m_recordIds, row["id"].toString()));
+        record.setStudentId(studentId);
+        record.setSubject(row["title"].toString());
+        record.setKnowledgePoint(row["knowledge_point"].toString());
+        record.setScore(row["score"].toDouble());
+        record.setFullScore(row["total_score"].toDouble(100.0));
+        record.setDate(dateOf(row["exam_date"]));
+        record.setExamType(ScoreRecord::Daily);
+        records.append(record);
+    }
+
+    if (!rows.isEmpty()) {
+        const QJsonObject last = rows.last().toObject();
+        m_pageSince = last["updated_at"].toString();
+        m_pageAfterId = last["id"].toString();
+    }
+
+    if (m_fullResync) {
+        // 全部拉完再替换，中途失败时保留原有成绩和水位
+        m_resyncScores += records;
+        if (rows.size() == SCORE_PAGE_SIZE) {
+            fetchScoreChanges();
+            return;
+        }
+        store().setStudents(store().students());
+        store().appendScores(m_resyncScores);
+        qDebug() << "[SupabaseAnalyticsDataSource] 全量同步成绩" << m_resyncScores.size() << "条";
+        m_resyncScores.clear();
+        m_watermark = m_pageSince;
+        m_watermarkId = m_pageAfterId;
+        m_lastFullSync = QDateTime::currentDateTimeUtc();
+        m_cacheDirty = true;
+        emit dataChanged();
+        finishSync();
+        return;
+    }
+
+    // 安全窗口内重读的行可能早于水位，水位只前进不后退
+    if (!rows.isEmpty() && timestampOf(m_pageSince) >= timestampOf(m_watermark)) {
+        m_watermark = m_pageSince;
+        m_watermarkId = m_pageAfterId;
+        m_cacheDirty = true;
+    }
+    if (!records.isEmpty()) {
+        store().appendScores(records);
+        qDebug() << "[SupabaseAnalyticsDataSource] 合并成绩" << records.size() << "条，共" << store().scoreCount() << "条";
+        emit dataChanged();
+    }
+
+    if (rows.size() == SCORE_PAGE_SIZE) {
+        fetchScoreChanges();
+    } else {
+        finishSync();
+    }
+}
+
+void SupabaseAnalyticsDataSource::finishSync()
+{
+    m_syncing = false;
+    if (m_cacheDirty) {
+        saveCache();
+        m_cacheDirty = false;
+    }
+    qDebug() << "[SupabaseAnalyticsDataSource] 同步完成";
+    emit syncFinished();
+}
+
+void SupabaseAnalyticsDataSource::failSync(const QString &stage, QNetworkReply *reply)
+{
+    m_syncing = false;
+    m_resyncScores.clear();
+    // 已合并的部分照样落盘，下次从新水位继续
+    if (m_cacheDirty) {
+        saveCache();
+        m_cacheDirty = false;
+    }
+    const QString message = QString("同步学情数据失败（%1）：%2").arg(stage, reply->errorString());
+    qWarning() << "[SupabaseAnalyticsDataSource]" << message;
+    emit syncFailed(message);
+}
+
+// ===== 工具 =====
+
+QJsonArray SupabaseAnalyticsDataSource::classUuidArray() const
+{
+    QJsonArray uuids;
+    for (const ClassRef &ref : m_classRefs) uuids.append(ref.uuid);
+    return uuids;
+}
+
+QNetworkReply *SupabaseAnalyticsDataSource::postRpc(const QString &function, const QJsonObject &body)
+{
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/rpc/" + function);
+    QNetworkRequest request = NetworkRequestFactory::createAuthRequest(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    return m_networkManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+}
+
+int SupabaseAnalyticsDataSource::localId(QHash<QString, int> &ids, const QString &key)
+{
+    auto it = ids.constFind(key);
+    if (it != ids.constEnd()) return it.value();
+    const int id = ids.size() + 1;
+    ids.insert(key, id);
+    return id;
+}
+
+// ===== 本地缓存 =====
+
+QString SupabaseAnalyticsDataSource::cachePath() const
+{
+    QString name = m_teacherEmail;
+    name.replace(QRegularExpression("[^A-Za-z0-9_.@-]"), "_");
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + "/analytics/" + name + ".bin";
+}
+
+bool SupabaseAnalyticsDataSource::loadCache()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(cachePath());
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    // 成绩可达十万行量级，用 QDataStream 而不是 JSON，读写都快一个数量级
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0, version = 0;
+    in >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        qWarning() << "[SupabaseAnalyticsDataSource] 缓存版本不匹配，忽略:" << cachePath();
+        return false;
+    }
+
+    QHash<QString, int> classIds, studentIds, recordIds;
+    QString watermark, watermarkId;
+    QDateTime lastFullSync;
+    in >> watermark >> watermarkId >> lastFullSync >> classIds >> studentIds >> recordIds;
+
+    qint32 classCount = 0;
+    in >> classCount;
+    QVector<CourseClass> classes;
+    for (qint32 i = 0; i < classCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 id = 0, studentCount = 0;
+        QString name;
+        in >> id >> name >> studentCount;
+        CourseClass cls;
+        cls.setId(id);
+        cls.setName(name);
+        cls.setTeacherId(m_teacherEmail);
+        cls.setStudentCount(studentCount);
+        classes.append(cls);
+    }
+
+    qint32 studentCount = 0;
+    in >> studentCount;
+    QVector<Student> students;
+    for (qint32 i = 0; i < studentCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 id = 0, classId = 0;
+        QString name, studentNo;
+        in >> id >> name >> classId >> studentNo;
+        students.append(Student(id, name, classId, studentNo));
+    }
+
+    qint32 scoreCount = 0;
+    in >> scoreCount;
+    QVector<ScoreRecord> scores;
+    for (qint32 i = 0; i < scoreCount && in.status() == QDataStream::Ok; ++i) {
+        qint32 id = 0, studentId = 0, examType = 0;
+        QString subject, knowledgePoint;
+        double score = 0, fullScore = 0;
+        QDate date;
+        in >> id >> studentId >> subject >> knowledgePoint >> score >> fullScore >> date >> examType;
+        ScoreRecord record(studentId, subject, score, date);
+        record.setId(id);
+        record.setKnowledgePoint(knowledgePoint);
+        record.setFullScore(fullScore);
+        record.setExamType(static_cast<ScoreRecord::ExamType>(examType));
+        scores.append(record);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "[SupabaseAnalyticsDataSource] 缓存损坏，忽略:" << cachePath();
+        return false;
+    }
+
+    m_classIds = classIds;
+    m_studentIds = studentIds;
+    m_recordIds = recordIds;
+    m_watermark = watermark;
+    m_watermarkId = watermarkId;
+    m_lastFullSync = lastFullSync;
+    m_classRefs.clear();
+    for (auto it = m_classIds.constBegin(); it != m_classIds.constEnd(); ++it) {
+        for (const CourseClass &cls : classes) {
+            if (cls.id() == it.value()) m_classRefs.append(ClassRef{it.key(), cls.id()});
+        }
+    }
+
+    store().setClasses(classes);
+    store().setStudents(students);
+    store().appendScores(scores);
+    qDebug() << "[SupabaseAnalyticsDataSource] 从本地缓存加载" << classes.size() << "个班级,"
+             << students.size() << "名学生," << scores.size() << "条成绩，耗时" << timer.elapsed() << "ms";
+    return true;
+}
+
+void SupabaseAnalyticsDataSource::saveCache() const
+{
+    const QString path = cachePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[SupabaseAnalyticsDataSource] 无法写入缓存:" << path;
+        return;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << CACHE_MAGIC << CACHE_VERSION;
+    out << m_watermark << m_watermarkId << m_lastFullSync << m_classIds << m_studentIds << m_recordIds;
+
+    const QVector<CourseClass> classes = store().classes();
+    out << qint32(classes.size());
+    for (const CourseClass &cls : classes) {
+        out << qint32(cls.id()) << cls.name() << qint32(cls.studentCount());
+    }
+
+    const QVector<Student> students = store().students();
+    out << qint32(students.size());
+    for (const Student &student : students) {
+        out << qint32(student.id()) << student.name() << qint32(student.classId()) << student.studentNo();
+    }
+
+    QVector<ScoreRecord> scores;
+    scores.reserve(store().scoreCount());
+    for (const CourseClass &cls : classes) {
+        scores += store().classScores(cls.id());
+    }
+    out << qint32(scores.size());
+    for (const ScoreRecord &record : scores) {
+        out << qint32(record.id()) << qint32(record.studentId()) << record.subject()
+            << record.knowledgePoint() << record.score() << record.fullScore()
+            << record.date() << qint32(record.examType());
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        qWarning() << "[SupabaseAnalyticsDataSource] 写入缓存失败:" << path;
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef SUPABASEANALYTICSDATASOURCE_H
+#define SUPABASEANALYTICSDATASOURCE_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QStringList>
+#include "ColumnarDataSource.h"
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+/**
+ * @brief 读取 Supabase 真实成绩、作业提交和考勤的学情数据源
+ *
+ * 同步分三步，每步完成都会发 dataChanged()：
+ * 1. 班级（classes）与花名册（class_members）
+ * 2. analytics_class_overview：服务端物化视图里的每次作业成绩分布、知识点掌握度、
+ *    每日考勤 / 作业提交，一次往返。整段历史的班级统计和薄弱知识点直接用它，
+ *    概览页的指标和趋势写入 AnalyticsDataService
+ * 3. analytics_score_changes：按 updated_at 水位增量拉取成绩明细，合并进列式存储，
+ *    供排名、个人成绩趋势和按日期范围的查询使用。每次从水位前 WATERMARK_SAFETY_SECS
+ *    开始重读，兜住晚提交的慢事务；每隔 FULL_RESYNC_INTERVAL_SECS 全量重建一次，
+ *    清掉已删除或撤销分数的提交
+ *
+ * 班级、学生、成绩和水位用二进制格式缓存在本地，打开页面先从缓存渲染，
+ * 之后只拉取水位附近及之后变化的成绩。服务端的 UUID 在本地映射成稳定的整数 ID。
+ */
+class SupabaseAnalyticsDataSource : public QObject, public ColumnarDataSource
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MEMBER_PAGE_SIZE = 1000;
+    static constexpr int SCORE_PAGE_SIZE = 2000;
+    static constexpr int ACTIVITY_DAYS = 60;     // 概览趋势取近 60 天，够算 30 天趋势和环比
+    static constexpr int WATERMARK_SAFETY_SECS = 5 * 60;
+    static constexpr int FULL_RESYNC_INTERVAL_SECS = 6 * 60 * 60;
+
+    explicit SupabaseAnalyticsDataSource(QObject *parent = nullptr);
+
+    void setTeacherEmail(const QString &email);   // 加载本地缓存并开始同步
+    QString teacherEmail() const { return m_teacherEmail; }
+    bool isSyncing() const { return m_syncing; }
+    QString watermark() const { return m_watermark; }
+
+    // 无日期范围时优先用服务端汇总
+    QVector<KnowledgePoint> getClassKnowledgePoints(int classId,
+                                                    const QDate &startDate = QDate(),
+                                                    const QDate &endDate = QDate()) override;
+    ClassStatistics getClassStatistics(int classId,
+                                       const QDate &startDate = QDate(),
+                                       const QDate &endDate = QDate()) override;
+
+public slots:
+    void sync();
+
+signals:
+    void classesChanged();         // 班级列表或花名册变化，页面需要重新填充下拉框
+    void dataChanged();            // 成绩或汇总变化
+    void syncFinished();
+    void syncFailed(const QString &error);
+
+private:
+    struct ClassRef {
+        QString uuid;
+        int id;
+    };
+
+    void fetchClasses();
+    void onClassesReceived(const QJsonArray &rows);
+    void fetchMembers(int offset = 0);
+    void onMembersReceived(const QJsonArray &rows);
+    void fetchOverview();
+    void onOverviewReceived(const QJsonObject &overview);
+    void startScoreSync();           // 决定增量还是全量，设置分页游标
+    void fetchScoreChanges();
+    void onScoreChangesReceived(const QJsonArray &rows);
+    void finishSync();
+    void failSync(const QString &stage, QNetworkReply *reply);
+
+    void applyOverviewMetrics(const QJsonArray &exams, const QJsonArray &activity);
+    QJsonArray classUuidArray() const;
+    QNetworkReply *postRpc(const QString &function, const QJsonObject &body);
+
+    int localId(QHash<QString, int> &ids, const QString &key);
+    QString cachePath() const;
+    bool loadCache();
+    void saveCache() const;
+
+    QNetworkAccessManager *m_networkManager;
+    QString m_teacherEmail;
+    bool m_syncing = false;
+    bool m_cacheDirty = false;
+
+    QVector<ClassRef> m_classRefs;
+    QJsonArray m_pendingMembers;         // 分页拉取中的花名册
+    QHash<QString, int> m_classIds;      // 班级 UUID -> 本地 ID
+    QHash<QString, int> m_studentIds;    // "班级 UUID|学生邮箱" -> 本地 ID
+    QHash<QString, int> m_recordIds;     // 提交 UUID -> 本地 ID
+
+    // 增量水位：最后一行的 updated_at 原始字符串（保留微秒）和 ID
+    QString m_watermark;
+    QString m_watermarkId;
+    QDateTime m_lastFullSync;
+
+    // 本轮同步的分页游标和全量重建的暂存
+    QString m_pageSince;
+    QString m_pageAfterId;
+    bool m_fullResync = false;
+    QVector<ScoreRecord> m_resyncScores;
+
+    // 服务端汇总（整段历史）
+    QHash<int, ClassStatistics> m_serverStatistics;
+    QHash<int, QVector<KnowledgePoint>> m_serverKnowledge;
+};
+
+#endif // SUPABASEANALYTICSDATASOURCE_H
@@ -36,15 +36,23 @@ public:
                                                  const QDate &startDate = QDate(),
                                                  const QDate &endDate = QDate()) = 0;
 
-    // 知识点掌握度
-    virtual QVector<KnowledgePoint> getStudentKnowledgePoints(int studentId) = 0;
-    virtual QVector<KnowledgePoint> getClassKnowledgePoints(int classId) = 0;
-
-    // 统计数据
-    virtual ClassStatistics getClassStatistics(int classId) = 0;
+    // 知识点掌握度（日期无效表示不限）
+    virtual QVector<KnowledgePoint> getStudentKnowledgePoints(int studentId,
+                                                              const QDate &startDate = QDate(),
+                                                              const QDate &endDate = QDate()) = 0;
+    virtual QVector<KnowledgePoint> getClassKnowledgePoints(int classId,
+                                                            const QDate &startDate = QDate(),
+                                                            const QDate &endDate = QDate()) = 0;
+
+    // 统计数据（区间内最近一次考试）
+    virtual ClassStatistics getClassStatistics(int classId,
+                                               const QDate &startDate = QDate(),
+                                               const QDate &endDate = QDate()) = 0;
 
     // 排名数据 (返回按成绩排序的学生列表)
-    virtual QVector<QPair<Student, double>> getClassRanking(int classId) = 0;
+    virtual QVector<QPair<Student, double>> getClassRanking(int classId,
+                                                            const QDate &startDate = QDate(),
+                                                            const QDate &endDate = QDate()) = 0;
 };
 
 #endif // IANALYTICSDATASOURCE_H
@@ -1,10 +1,11 @@
 #include "ClassAnalyticsPage.h"
-#include "../datasources/MockDataSource.h"
+#include "../interfaces/IAnalyticsDataSource.h"
 #include "../models/Student.h"
 #include "../models/ClassStatistics.h"
 #include "../models/KnowledgePoint.h"
 #include "../../services/DifyService.h"
 #include "../../shared/StyleConfig.h"
+#include "../../utils/MarkdownRenderer.h"
 
 #include <QDebug>
 #include <QHeaderView>
@@ -25,14 +26,15 @@
 
 ClassAnalyticsPage::ClassAnalyticsPage(QWidget *parent)
     : QWidget(parent)
-    , m_dataSource(nullptr)
-    , m_difyService(nullptr)
-    , m_currentClassId(-1)
-    , m_isGenerating(false)
     , m_distributionChartView(nullptr)
     , m_gradeBarSet(nullptr)
     , m_rankingTable(nullptr)
     , m_weakPointsChartView(nullptr)
+    , m_markdownRenderer(new MarkdownRenderer())
+    , m_isGenerating(false)
+    , m_dataSource(nullptr)
+    , m_difyService(nullptr)
+    , m_currentClassId(-1)
 {
     setupUI();
     setupStyles();
@@ -40,9 +42,10 @@ ClassAnalyticsPage::ClassAnalyticsPage(QWidget *parent)
 
 ClassAnalyticsPage::~ClassAnalyticsPage()
 {
+    delete m_markdownRenderer;
 }
 
-void ClassAnalyticsPage::setDataSource(MockDataSource *dataSource)
+void ClassAnalyticsPage::setDataSource(IAnalyticsDataSource *dataSource)
 {
     m_dataSource = dataSource;
     if (m_dataSource) {
@@ -99,7 +102,7 @@ void ClassAnalyticsPage::setAdviceContent(const QString &content)
 {
     m_currentAdvice = content;
     if (m_adviceContent) {
-        m_adviceContent->setText(content);
+        m_adviceContent->setText(m_markdownRenderer->renderToHtml(content));
     }
     if (m_generateAdviceBtn) {
         m_generateAdviceBtn->setEnabled(true);
@@ -529,6 +532,7 @@ void ClassAnalyticsPage::createAIAdviceArea()
 
     m_adviceContent = new QLabel("点击「开启智能诊断」，AI 将为您生成针对性的班级学情改进方案。");
     m_adviceContent->setWordWrap(true);
+    m_adviceContent->setTextFormat(Qt::RichText);
     m_adviceContent->setAlignment(Qt::AlignTop | Qt::AlignLeft);
     m_adviceContent->setStyleSheet(QString(
         "color: #475569; font-size: 15px; line-height: 1.6; "
@@ -670,6 +674,8 @@ void ClassAnalyticsPage::onGenerateAdviceClicked()
 
     m_isGenerating = true;
     m_currentAdvice.clear();
+    m_renderedAdviceHtml.clear();
+    m_streamSplitter.reset();
     m_generateAdviceBtn->setEnabled(false);
     m_generateAdviceBtn->setText("诊断中...");
     m_adviceContent->setText("正在利用 AI 深度分析班级数据，请稍候...");
@@ -702,12 +708,32 @@ void ClassAnalyticsPage::onGenerateAdviceClicked()
 
 void ClassAnalyticsPage::onAIStreamChunk(const QString &chunk)
 {
+    if (!m_isGenerating) return;
     m_currentAdvice += chunk;
-    m_adviceContent->setText(m_currentAdvice);
+
+    // 只渲染新写完整的块，已渲染的 HTML 直接复用；未完成部分先按纯文本显示
+    m_streamSplitter.append(chunk);
+    const QString completed = m_streamSplitter.takeCompleted();
+    if (!completed.trimmed().isEmpty()) {
+        m_renderedAdviceHtml += m_markdownRenderer->renderToHtml(completed);
+    }
+    QString pendingHtml;
+    const QString pending = m_streamSplitter.pendingText();
+    if (!pending.trimmed().isEmpty()) {
+        pendingHtml = "<p>" + pending.toHtmlEscaped().replace('\n', "<br>") + "</p>";
+    }
+    m_adviceContent->setText(m_renderedAdviceHtml + pendingHtml);
 }
 
 void ClassAnalyticsPage::onAIRequestFinished()
 {
+    if (!m_isGenerating) return;
+    const QString remaining = m_streamSplitter.takeRemaining();
+    if (!remaining.trimmed().isEmpty()) {
+        m_renderedAdviceHtml += m_markdownRenderer->renderToHtml(remaining);
+    }
+    m_adviceContent->setText(m_renderedAdviceHtml);
+
     m_isGenerating = false;
     m_generateAdviceBtn->setEnabled(true);
     m_generateAdviceBtn->setText("重新诊断");
@@ -894,7 +920,7 @@ void ClassAnalyticsPage::onExportClicked()
         QTextDocument doc;
         doc.setDefaultFont(contentFont);
         doc.setTextWidth(contentWidth - 20);
-        doc.setPlainText(m_currentAdvice);
+        doc.setHtml(m_markdownRenderer->renderToHtml(m_currentAdvice));
 
         painter.save();
         painter.translate(margin + 20, yPos);
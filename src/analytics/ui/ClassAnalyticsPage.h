@@ -12,9 +12,11 @@
 #include <QtCharts/QChartView>
 #include <QtCharts/QBarSeries>
 #include <QtCharts/QBarSet>
+#include "../../utils/MarkdownStreamSplitter.h"
 
 class DifyService;
-class MockDataSource;
+class IAnalyticsDataSource;
+class MarkdownRenderer;
 
 /**
  * @brief 班级整体分析页面
@@ -30,7 +32,7 @@ public:
     explicit ClassAnalyticsPage(QWidget *parent = nullptr);
     ~ClassAnalyticsPage();
 
-    void setDataSource(MockDataSource *dataSource);
+    void setDataSource(IAnalyticsDataSource *dataSource);
     void setDifyService(DifyService *service);
     void refresh();
     void selectClass(int classId);
@@ -79,10 +81,13 @@ private:
     QPushButton *m_generateAdviceBtn;
     QPushButton *m_exportBtn;
     QString m_currentAdvice;
+    MarkdownRenderer *m_markdownRenderer;
+    MarkdownStreamSplitter m_streamSplitter;   // 流式建议按块切分，已完成的块只渲染一次
+    QString m_renderedAdviceHtml;
     bool m_isGenerating;
 
     // 数据
-    MockDataSource *m_dataSource;
+    IAnalyticsDataSource *m_dataSource;
     DifyService *m_difyService;
     int m_currentClassId;
 };
@@ -1,5 +1,5 @@
 #include "PersonalAnalyticsPage.h"
-#include "../datasources/MockDataSource.h"
+#include "../interfaces/IAnalyticsDataSource.h"
 #include "../models/Student.h"
 #include "../models/ScoreRecord.h"
 #include "../models/KnowledgePoint.h"
@@ -33,7 +33,7 @@ PersonalAnalyticsPage::~PersonalAnalyticsPage()
 {
 }
 
-void PersonalAnalyticsPage::setDataSource(MockDataSource *dataSource)
+void PersonalAnalyticsPage::setDataSource(IAnalyticsDataSource *dataSource)
 {
     m_dataSource = dataSource;
     if (m_dataSource) {
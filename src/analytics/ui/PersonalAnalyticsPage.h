@@ -13,7 +13,7 @@
 #include <QtCharts/QValueAxis>
 
 class DifyService;
-class MockDataSource;
+class IAnalyticsDataSource;
 class Student;
 
 /**
@@ -30,7 +30,7 @@ public:
     explicit PersonalAnalyticsPage(QWidget *parent = nullptr);
     ~PersonalAnalyticsPage();
 
-    void setDataSource(MockDataSource *dataSource);
+    void setDataSource(IAnalyticsDataSource *dataSource);
     void setDifyService(DifyService *service);
     void refresh();
     void selectStudent(int studentId);
@@ -79,7 +79,7 @@ private:
     bool m_isGenerating;
 
     // 数据
-    MockDataSource *m_dataSource;
+    IAnalyticsDataSource *m_dataSource;
     DifyService *m_difyService;
     int m_currentStudentId;
     int m_currentClassId;
@@ -41,7 +41,7 @@ public:
         if (str == "present")     return AttendanceStatus::Present;
         if (str == "absent")      return AttendanceStatus::Absent;
         if (str == "late")        return AttendanceStatus::Late;
-        if (str == "leave")       return AttendanceStatus::Leave;
+        if (str == "leave" || str == "excused") return AttendanceStatus::Leave;  // 教师端记为 excused
         if (str == "early_leave") return AttendanceStatus::EarlyLeave;
         return AttendanceStatus::Present;  // 默认出勤
     }
@@ -1,15 +1,17 @@
 #include "AttendanceService.h"
 #include "../../utils/NetworkRequestFactory.h"
+#include "../../utils/SessionNetworkManager.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QUrlQuery>
 #include <QTimer>
 #include <QRandomGenerator>
+#include <functional>
 
 AttendanceService::AttendanceService(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
 {
 }
 
@@ -224,24 +226,44 @@ void AttendanceService::onDeleteAttendanceFinished()
 
 // ============ 统计相关 ============
 
-void AttendanceService::fetchClassStatistics(int classId, const QDate &startDate, const QDate &endDate)
+// 本模块的课次考勤仍是示例数据（整数班级/学生 ID），统计直接在已加载的记录上汇总；
+// 签到系统（attendance_sessions）的统计见 AttendanceManager::loadClassAttendanceStats
+static bool inDateRange(const QDate &date, const QDate &startDate, const QDate &endDate)
 {
-    Q_UNUSED(classId)
-    Q_UNUSED(startDate)
-    Q_UNUSED(endDate)
+    return (!startDate.isValid() || date >= startDate) && (!endDate.isValid() || date <= endDate);
+}
+
+static AttendanceSummary summarize(const QList<AttendanceRecord> &records,
+                                   const std::function<bool(const AttendanceRecord &)> &accept)
+{
+    AttendanceSummary summary;
+    for (const AttendanceRecord &record : records) {
+        if (!accept(record)) continue;
+        switch (record.status()) {
+        case AttendanceStatus::Present:   summary.addPresent(); break;
+        case AttendanceStatus::Absent:    summary.addAbsent(); break;
+        case AttendanceStatus::Late:      summary.addLate(); break;
+        case AttendanceStatus::Leave:     summary.addLeave(); break;
+        case AttendanceStatus::EarlyLeave: summary.addEarlyLeave(); break;
+        }
+    }
+    summary.calculateRate();
+    return summary;
+}
 
-    // TODO: 实现班级统计API
+void AttendanceService::fetchClassStatistics(int classId, const QDate &startDate, const QDate &endDate)
+{
+    m_currentSummary = summarize(m_attendanceRecords, [&](const AttendanceRecord &r) {
+        return r.classId() == classId && inDateRange(r.date(), startDate, endDate);
+    });
     emit statisticsReceived(m_currentSummary);
 }
 
 void AttendanceService::fetchStudentStatistics(int studentId, const QDate &startDate, const QDate &endDate)
 {
-    Q_UNUSED(studentId)
-    Q_UNUSED(startDate)
-    Q_UNUSED(endDate)
-
-    // TODO: 实现学生统计API
-    AttendanceSummary summary;
+    const AttendanceSummary summary = summarize(m_attendanceRecords, [&](const AttendanceRecord &r) {
+        return r.studentId() == studentId && inDateRange(r.date(), startDate, endDate);
+    });
     emit statisticsReceived(summary);
 }
 
@@ -0,0 +1,212 @@
+#include "AttendanceStatsStore.h"
+#include "../models/AttendanceStatus.h"
+#include <algorithm>
+#include <numeric>
+
+// ===== 行解析 =====
+
+AttendanceStatsStore::SessionRow AttendanceStatsStore::SessionRow::fromJson(const QJsonObject &json)
+{
+    SessionRow row;
+    row.sessionId = json["session_id"].toString();
+    row.name = json["name"].toString();
+    row.code = json["code"].toString();
+    row.sessionStatus = json["session_status"].toString();
+    row.createdAt = QDateTime::fromString(json["created_at"].toString(), Qt::ISODateWithMs);
+    row.endedAt = QDateTime::fromString(json["ended_at"].toString(), Qt::ISODateWithMs);
+    row.recordStatus = json["record_status"].toString();
+    return row;
+}
+
+double AttendanceStatsStore::Rollup::attendanceRate() const
+{
+    if (totalCount <= 0) return 0.0;
+    return static_cast<double>(presentCount + lateCount) / totalCount * 100.0;
+}
+
+AttendanceStatsStore::Rollup AttendanceStatsStore::Rollup::fromJson(const QJsonObject &json)
+{
+    Rollup r;
+    r.studentEmail = json["student_email"].toString();
+    r.studentName = json["student_name"].toString();
+    r.totalCount = json["total_count"].toInt();
+    r.presentCount = json["present_count"].toInt();
+    r.lateCount = json["late_count"].toInt();
+    r.absentCount = json["absent_count"].toInt();
+    r.leaveCount = json["leave_count"].toInt();
+    r.earlyLeaveCount = json["early_leave_count"].toInt();
+    r.unrecordedCount = json["unrecorded_count"].toInt();
+    r.currentStreak = json["current_streak"].toInt();
+    r.longestStreak = json["longest_streak"].toInt();
+    r.lastAttendedAt = QDateTime::fromString(json["last_attended_at"].toString(), Qt::ISODateWithMs);
+    return r;
+}
+
+// ===== 状态编码 =====
+
+quint8 AttendanceStatsStore::encodeStatus(const QString &status)
+{
+    // 与 class_attendance_rollup 保持一致：教师端的 excused 算请假，不认识的状态算未记录，
+    // 不能走 AttendanceStatusHelper::fromString 的"默认出勤"
+    AttendanceStatus value;
+    if (status == "present") value = AttendanceStatus::Present;
+    else if (status == "late") value = AttendanceStatus::Late;
+    else if (status == "absent") value = AttendanceStatus::Absent;
+    else if (status == "leave" || status == "excused") value = AttendanceStatus::Leave;
+    else if (status == "early_leave") value = AttendanceStatus::EarlyLeave;
+    else return UNRECORDED;
+    return static_cast<quint8>(AttendanceStatusHelper::toInt(value));
+}
+
+QString AttendanceStatsStore::decodeStatus(quint8 code)
+{
+    if (code == UNRECORDED) return QString();
+    return AttendanceStatusHelper::toString(AttendanceStatusHelper::fromInt(code));
+}
+
+// ===== 合并 =====
+
+void AttendanceStatsStore::upsert(const QList<SessionRow> &rows)
+{
+    bool needsSort = false;
+    for (const SessionRow &row : rows) {
+        const qint64 createdMs = row.createdAt.isValid() ? row.createdAt.toMSecsSinceEpoch() : 0;
+        const qint64 endedMs = row.endedAt.isValid() ? row.endedAt.toMSecsSinceEpoch() : 0;
+
+        auto it = m_index.constFind(row.sessionId);
+        if (it != m_index.constEnd()) {
+            const int i = it.value();
+            m_status[i] = encodeStatus(row.recordStatus);
+            m_endedMs[i] = endedMs;
+            m_names[i] = row.name;
+            m_sessionStatus[i] = row.sessionStatus;
+            continue;
+        }
+
+        if (!m_createdMs.isEmpty() && createdMs < m_createdMs.constLast()) {
+            needsSort = true;
+        }
+        m_index.insert(row.sessionId, m_sessionIds.size());
+        m_sessionIds.append(row.sessionId);
+        m_createdMs.append(createdMs);
+        m_endedMs.append(endedMs);
+        m_status.append(encodeStatus(row.recordStatus));
+        m_names.append(row.name);
+        m_codes.append(row.code);
+        m_sessionStatus.append(row.sessionStatus);
+    }
+
+    if (needsSort) {
+        sortByCreatedAt();
+    }
+}
+
+void AttendanceStatsStore::sortByCreatedAt()
+{
+    QVector<int> order(m_sessionIds.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_createdMs[a] < m_createdMs[b];
+    });
+
+    auto permute = [&order](auto &column) {
+        std::remove_reference_t<decltype(column)> sorted;
+        sorted.reserve(column.size());
+        for (int i : order) sorted.append(column[i]);
+        column = std::move(sorted);
+    };
+    permute(m_sessionIds);
+    permute(m_createdMs);
+    permute(m_endedMs);
+    permute(m_status);
+    permute(m_names);
+    permute(m_codes);
+    permute(m_sessionStatus);
+
+    m_index.clear();
+    for (int i = 0; i < m_sessionIds.size(); ++i) {
+        m_index.insert(m_sessionIds[i], i);
+    }
+}
+
+void AttendanceStatsStore::clear()
+{
+    m_index.clear();
+    m_sessionIds.clear();
+    m_createdMs.clear();
+    m_endedMs.clear();
+    m_status.clear();
+    m_names.clear();
+    m_codes.clear();
+    m_sessionStatus.clear();
+}
+
+QDateTime AttendanceStatsStore::latestCreatedAt() const
+{
+    if (m_createdMs.isEmpty()) return QDateTime();
+    return QDateTime::fromMSecsSinceEpoch(m_createdMs.constLast(), Qt::UTC);
+}
+
+// ===== 汇总 =====
+
+AttendanceStatsStore::Rollup AttendanceStatsStore::rollup(const QDateTime &from, const QDateTime &to) const
+{
+    const auto begin = from.isValid()
+        ? std::lower_bound(m_createdMs.cbegin(), m_createdMs.cend(), from.toMSecsSinceEpoch())
+        : m_createdMs.cbegin();
+    const auto end = to.isValid()
+        ? std::lower_bound(begin, m_createdMs.cend(), to.toMSecsSinceEpoch())
+        : m_createdMs.cend();
+    const int first = static_cast<int>(begin - m_createdMs.cbegin());
+    const int last = static_cast<int>(end - m_createdMs.cbegin());
+
+    Rollup r;
+    int streak = 0;
+    for (int i = first; i < last; ++i) {
+        ++r.totalCount;
+        bool attended = false;
+        switch (m_status[i]) {
+        case UNRECORDED:
+            ++r.unrecordedCount;
+            break;
+        default:
+            switch (AttendanceStatusHelper::fromInt(m_status[i])) {
+            case AttendanceStatus::Present:    ++r.presentCount; attended = true; break;
+            case AttendanceStatus::Late:       ++r.lateCount; attended = true; break;
+            case AttendanceStatus::Absent:     ++r.absentCount; break;
+            case AttendanceStatus::Leave:      ++r.leaveCount; break;
+            case AttendanceStatus::EarlyLeave: ++r.earlyLeaveCount; break;
+            }
+        }
+
+        if (attended) {
+            ++streak;
+            r.longestStreak = qMax(r.longestStreak, streak);
+            r.lastAttendedAt = QDateTime::fromMSecsSinceEpoch(m_createdMs[i], Qt::UTC);
+        } else {
+            streak = 0;
+        }
+    }
+    r.currentStreak = streak;
+    return r;
+}
+
+QList<AttendanceStatsStore::SessionRow> AttendanceStatsStore::rowsNewestFirst() const
+{
+    QList<SessionRow> rows;
+    rows.reserve(m_sessionIds.size());
+    for (int i = m_sessionIds.size() - 1; i >= 0; --i) {
+        SessionRow row;
+        row.sessionId = m_sessionIds[i];
+        row.name = m_names[i];
+        row.code = m_codes[i];
+        row.sessionStatus = m_sessionStatus[i];
+        row.createdAt = QDateTime::fromMSecsSinceEpoch(m_createdMs[i], Qt::UTC).toLocalTime();
+        if (m_endedMs[i] > 0) {
+            row.endedAt = QDateTime::fromMSecsSinceEpoch(m_endedMs[i], Qt::UTC).toLocalTime();
+        }
+        row.recordStatus = decodeStatus(m_status[i]);
+        rows.append(row);
+    }
+    return rows;
+}
@@ -0,0 +1,81 @@
+#ifndef ATTENDANCESTATSSTORE_H
+#define ATTENDANCESTATSSTORE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 考勤统计的本地列式缓存（一个班级里一名学生的全部考勤）
+ *
+ * 每个签到场次一行，按列存放（时间、状态各一个数组），以场次 ID 为键去重，
+ * 整体按场次创建时间升序排列。按日期范围汇总时先二分定位区间，
+ * 再顺序扫描状态列统计各状态人次和连续出勤，几百个场次也是微秒级。
+ *
+ * 服务端增量拉取的结果用 upsert() 合并：已有场次原地更新状态，新场次追加。
+ */
+class AttendanceStatsStore
+{
+public:
+    static constexpr quint8 UNRECORDED = 0xFF;   // 没有该学生的考勤记录
+
+    struct SessionRow {
+        QString sessionId;
+        QString name;
+        QString code;
+        QString sessionStatus;
+        QDateTime createdAt;
+        QDateTime endedAt;
+        QString recordStatus;     // present / late / absent / leave / early_leave，空为未记录
+        static SessionRow fromJson(const QJsonObject &json);
+    };
+
+    // 考勤汇总（本地计算或服务端 class_attendance_rollup 返回）
+    struct Rollup {
+        QString studentEmail;
+        QString studentName;
+        int totalCount = 0;
+        int presentCount = 0;
+        int lateCount = 0;
+        int absentCount = 0;
+        int leaveCount = 0;
+        int earlyLeaveCount = 0;
+        int unrecordedCount = 0;
+        int currentStreak = 0;        // 最近连续出勤（出勤或迟到）的场次数
+        int longestStreak = 0;
+        QDateTime lastAttendedAt;
+
+        double attendanceRate() const;   // 百分比，出勤 + 迟到算到场
+        static Rollup fromJson(const QJsonObject &json);
+    };
+
+    void upsert(const QList<SessionRow> &rows);
+    void clear();
+
+    int size() const { return m_sessionIds.size(); }
+    bool isEmpty() const { return m_sessionIds.isEmpty(); }
+    QDateTime latestCreatedAt() const;
+
+    // from / to 无效时表示不限，区间为 [from, to)
+    Rollup rollup(const QDateTime &from = QDateTime(), const QDateTime &to = QDateTime()) const;
+    QList<SessionRow> rowsNewestFirst() const;
+
+private:
+    static quint8 encodeStatus(const QString &status);
+    static QString decodeStatus(quint8 code);
+    void sortByCreatedAt();
+
+    QHash<QString, int> m_index;          // 场次 ID -> 列下标
+    QVector<QString> m_sessionIds;
+    QVector<qint64> m_createdMs;
+    QVector<qint64> m_endedMs;
+    QVector<quint8> m_status;
+    QVector<QString> m_names;
+    QVector<QString> m_codes;
+    QVector<QString> m_sessionStatus;
+};
+
+#endif // ATTENDANCESTATSSTORE_H
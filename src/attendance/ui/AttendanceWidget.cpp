@@ -17,6 +17,7 @@
 #include <QPainter>
 #include <QPixmap>
 #include <QInputDialog>
+#include <algorithm>
 
 // ============ 高级 UI 设计规范 ============
 static const QString COL_BG = "#F3F4F6";
@@ -80,6 +81,13 @@ AttendanceWidget::AttendanceWidget(QWidget *parent)
         m_sessionCombo->blockSignals(false);
     });
 
+    // 班级考勤统计（服务端按学生聚合）
+    connect(AttendanceManager::instance(), &AttendanceManager::classAttendanceStatsLoaded, this,
+            [this](const QString &classId, const QList<AttendanceStatsStore::Rollup> &rollups) {
+        if (classId != m_statsClassId) return;
+        updateClassStats(rollups);
+    });
+
     // 连接 ClassManager 获取学号
     connect(ClassManager::instance(), &ClassManager::membersLoaded, this,
             [this](const QString &classId, const QList<ClassManager::MemberInfo> &members) {
@@ -333,6 +341,12 @@ void AttendanceWidget::createSummaryCard()
     layout->addStretch();
 
     m_mainLayout->addWidget(dashboard);
+
+    m_classStatsLabel = new QLabel();
+    m_classStatsLabel->setWordWrap(true);
+    m_classStatsLabel->setStyleSheet(QString("font-size: 13px; color: %1;").arg(COL_TEXT_SUB));
+    m_classStatsLabel->hide();
+    m_mainLayout->addWidget(m_classStatsLabel);
 }
 
 QWidget* AttendanceWidget::createStatCard(const QString &label, QLabel* &countLabel, const QString &color, const QString &iconPath)
@@ -555,6 +569,7 @@ void AttendanceWidget::loadAttendanceForCurrentSelection()
     m_currentClassId = classId;
     QDate selectedDate = m_dateEdit->date();
     AttendanceManager::instance()->loadSessionsByClassAndDate(classId, selectedDate);
+    loadClassStats();
 }
 
 void AttendanceWidget::loadSessionResults(const QString &sessionId, const QString &classId)
@@ -587,6 +602,7 @@ void AttendanceWidget::loadSessionResults(const QString &sessionId, const QStrin
 
         // 后台加载 session 列表填充选择器
         AttendanceManager::instance()->loadSessionsByClassAndDate(classId, QDate::currentDate());
+        loadClassStats();
     }
 }
 
@@ -621,7 +637,9 @@ void AttendanceWidget::onRefreshClicked()
 {
     if (!m_currentSessionId.isEmpty()) {
         AttendanceManager::instance()->loadSessionRecords(m_currentSessionId);
+        loadClassStats(true);
     } else {
+        m_statsClassId.clear();
         loadAttendanceForCurrentSelection();
     }
 }
@@ -663,6 +681,7 @@ void AttendanceWidget::onSaveChanges()
             m_originalStatuses.append(r.status());
         }
         m_saveChangesBtn->setText("✓ 已保存");
+        loadClassStats(true);
         QTimer::singleShot(1500, this, [this]() {
             m_saveChangesBtn->setText("保存修改");
             updateSaveButtonState();
@@ -722,6 +741,58 @@ void AttendanceWidget::updateStatistics()
     if(m_earlyCountLabel) m_earlyCountLabel->setText(QString::number(e));
 }
 
+void AttendanceWidget::loadClassStats(bool force)
+{
+    if (m_currentClassId.isEmpty()) return;
+    if (!force && m_statsClassId == m_currentClassId) return;
+    m_statsClassId = m_currentClassId;
+
+    const QDateTime now = QDateTime::currentDateTime();
+    AttendanceManager::instance()->loadClassAttendanceStats(
+        m_currentClassId, now.addDays(-CLASS_STATS_DAYS), QDateTime());
+}
+
+void AttendanceWidget::updateClassStats(const QList<AttendanceStatsStore::Rollup> &rollups)
+{
+    if (!m_classStatsLabel) return;
+
+    int total = 0, attended = 0, absent = 0, late = 0;
+    QList<AttendanceStatsStore::Rollup> low;
+    for (const auto &r : rollups) {
+        total += r.totalCount;
+        attended += r.presentCount + r.lateCount;
+        absent += r.absentCount;
+        late += r.lateCount;
+        if (r.totalCount > 0 && r.attendanceRate() < LOW_ATTENDANCE_RATE) {
+            low.append(r);
+        }
+    }
+
+    if (total == 0) {
+        m_classStatsLabel->setText(QString("近 %1 天暂无考勤场次").arg(CLASS_STATS_DAYS));
+        m_classStatsLabel->show();
+        return;
+    }
+
+    QString text = QString("近 %1 天 · 班级出勤率 %2% · 缺勤 %3 人次 · 迟到 %4 人次")
+        .arg(CLASS_STATS_DAYS).arg(attended * 100.0 / total, 0, 'f', 1).arg(absent).arg(late);
+    if (!low.isEmpty()) {
+        std::sort(low.begin(), low.end(), [](const auto &a, const auto &b) {
+            return a.attendanceRate() < b.attendanceRate();
+        });
+        QStringList names;
+        for (int i = 0; i < low.size() && i < LOW_ATTENDANCE_SHOWN; ++i) {
+            names.append(QString("%1(%2%)").arg(low[i].studentName).arg(low[i].attendanceRate(), 0, 'f', 0));
+        }
+        text += QString(" · 出勤率低于 %1%：%2").arg(LOW_ATTENDANCE_RATE, 0, 'f', 0).arg(names.join("、"));
+        if (low.size() > LOW_ATTENDANCE_SHOWN) {
+            text += QString(" 等 %1 人").arg(low.size());
+        }
+    }
+    m_classStatsLabel->setText(text);
+    m_classStatsLabel->show();
+}
+
 QIcon AttendanceWidget::loadSvgIcon(const QString &path, const QString &color) {
     QFile file(path); if(!file.open(QIODevice::ReadOnly)) return QIcon();
     QString svg = QString::fromUtf8(file.readAll()); file.close();
@@ -14,6 +14,7 @@
 #include <QButtonGroup>
 #include <QIcon>
 #include "../models/AttendanceRecord.h"
+#include "../services/AttendanceStatsStore.h"
 #include "../../analytics/models/Student.h"
 
 class AttendanceService;
@@ -64,6 +65,8 @@ private:
     void loadAttendanceForCurrentSelection();
     void loadStudentList();
     void updateStatistics();
+    void loadClassStats(bool force = false);   // 当前班级近 CLASS_STATS_DAYS 天的服务端汇总
+    void updateClassStats(const QList<AttendanceStatsStore::Rollup> &rollups);
     void updateSaveButtonState();
     QWidget* createStudentItem(int index, const QString &name, const QString &studentNo, AttendanceStatus status);
     QWidget* createStatusButtonGroup(int studentIndex, AttendanceStatus currentStatus);
@@ -94,6 +97,7 @@ private:
     QLabel *m_lateCountLabel = nullptr;
     QLabel *m_leaveCountLabel = nullptr;
     QLabel *m_earlyCountLabel = nullptr;
+    QLabel *m_classStatsLabel = nullptr;      // 班级近期出勤率与低出勤学生
 
     // 操作按钮
     QPushButton *m_refreshBtn = nullptr;
@@ -112,6 +116,11 @@ private:
     QMap<QString, QString> m_emailToStudentNo; // email → 学号
     QMap<QString, QString> m_emailToStudentName; // email → 姓名
     QList<Student> m_students;
+    QString m_statsClassId;                    // 已请求班级统计的班级
+
+    static constexpr int CLASS_STATS_DAYS = 30;
+    static constexpr double LOW_ATTENDANCE_RATE = 80.0;
+    static constexpr int LOW_ATTENDANCE_SHOWN = 5;
 
     // 服务
     AttendanceService *m_service = nullptr;
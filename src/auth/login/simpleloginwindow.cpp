@@ -1,8 +1,12 @@
 #include "simpleloginwindow.h"
+#include "../supabase/sessionmanager.h"
 #include "../supabase/supabaseconfig.h"
+#include "../../utils/SessionNetworkManager.h"
 #include "../../dashboard/modernmainwindow.h"
 #include <QMessageBox>
 #include "../../shared/ModernDialogHelper.h"
+#include "../../services/ImageService.h"
+#include "../../utils/StartupProfiler.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QIcon>
@@ -171,21 +175,25 @@ void SimpleLoginWindow::setupUI()
     // 移除QLabel默认边距 - 关键修复
     tiananmenLabel->setContentsMargins(0, 0, 0, 0);
 
-    // 加载天安门图片
-    QPixmap tiananmenPixmap(":/images/天安门.png");
-    if (!tiananmenPixmap.isNull()) {
-        tiananmenLabel->setPixmap(tiananmenPixmap);
-        qDebug() << "天安门图片加载成功，原始尺寸:" << tiananmenPixmap.size();
-        // 零缝隙样式 - 完全贴合背景
-        tiananmenLabel->setStyleSheet(
-            "QLabel {"
-            "  margin: 0px;"          // 外边距=0
-            "  padding: 0px;"         // 内边距=0
-            "  border: none;"         // 无边框
-            "  background-color: transparent;" // 透明背景
-            "}"
-        );
-    } else {
+    // 零缝隙样式 - 完全贴合背景
+    tiananmenLabel->setStyleSheet(
+        "QLabel {"
+        "  margin: 0px;"          // 外边距=0
+        "  padding: 0px;"         // 内边距=0
+        "  border: none;"         // 无边框
+        "  background-color: transparent;" // 透明背景
+        "}"
+    );
+
+    // 异步解码天安门图片，不阻塞登录窗口首帧
+    ImageService::instance()->loadPixmap(":/images/天安门.png", QSize(), tiananmenLabel,
+        [tiananmenLabel](const QPixmap &tiananmenPixmap) {
+        if (!tiananmenPixmap.isNull()) {
+            tiananmenLabel->setPixmap(tiananmenPixmap);
+            qDebug() << "天安门图片加载成功，尺寸:" << tiananmenPixmap.size();
+            return;
+        }
+
         qDebug() << "天安门图片加载失败";
         tiananmenLabel->setText("天安门");
         tiananmenLabel->setStyleSheet(
@@ -197,7 +205,7 @@ void SimpleLoginWindow::setupUI()
             "  border: none;"
             "}"
         );
-    }
+    });
 
     // 确保左侧布局零间距 - 关键修复
     leftLayout->setSpacing(0);          // 布局元素间距=0
@@ -589,6 +597,7 @@ void SimpleLoginWindow::openMainWindow(const QString &username, const QString &r
     QApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
 
     qDebug() << "正在创建主窗口...";
+    StartupProfiler::instance().mark("login.succeeded");
     ModernMainWindow *mainWindow = new ModernMainWindow(role, username, userId);
     qDebug() << "主窗口创建完成，准备显示...";
     mainWindow->show();
@@ -645,8 +654,13 @@ void SimpleLoginWindow::onLoginSuccess(const QString &userId, const QString &ema
 
     qDebug() << "Supabase登录成功! 用户ID:" << userId << "邮箱:" << email;
 
-    // 设置全局 access token，供所有 Supabase REST API 请求使用
-    SupabaseConfig::setAccessToken(m_supabaseClient->currentAccessToken());
+    // 交给会话管理器，供所有 Supabase REST API 请求使用并在过期前自动刷新
+    SessionManager::instance()->setSession(m_supabaseClient->currentAccessToken(),
+                                           m_supabaseClient->currentRefreshToken(),
+                                           m_supabaseClient->currentExpiresAt());
+
+    // 查询角色、构造主界面期间先建好共享连接，进入工作台后的首批请求不再等握手
+    SessionNetworkManager::forCurrentThread()->prewarm(QUrl(SupabaseConfig::supabaseUrl()));
 
     loginButton->setEnabled(false);
     loginButton->setText("正在查询角色...");
@@ -2,6 +2,7 @@
 #include "../login/simpleloginwindow.h"
 #include "../supabase/supabaseconfig.h"
 #include "../../utils/NetworkRequestFactory.h"
+#include "../../services/ImageService.h"
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QJsonDocument>
@@ -217,11 +218,15 @@ void SignUpWindow::buildHeroPanel()
     tiananmenLabel->setScaledContents(true);
     tiananmenLabel->setContentsMargins(0, 0, 0, 0);
 
-    QPixmap tiananmenPixmap(":/images/天安门.png");
-    if (!tiananmenPixmap.isNull()) {
-        tiananmenLabel->setPixmap(tiananmenPixmap);
-        tiananmenLabel->setStyleSheet("margin: 0px; padding: 0px; border: none; background: transparent;");
-    }
+    tiananmenLabel->setStyleSheet("margin: 0px; padding: 0px; border: none; background: transparent;");
+
+    // 与登录页共享解码结果（ImageService 缓存），不阻塞窗口构造
+    ImageService::instance()->loadPixmap(":/images/天安门.png", QSize(), tiananmenLabel,
+        [tiananmenLabel](const QPixmap &tiananmenPixmap) {
+        if (!tiananmenPixmap.isNull()) {
+            tiananmenLabel->setPixmap(tiananmenPixmap);
+        }
+    });
 
     leftLayout->addWidget(tiananmenLabel, 6);
 }
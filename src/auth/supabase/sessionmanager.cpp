@@ -0,0 +1,200 @@
+#include "sessionmanager.h"
+#include "supabaseconfig.h"
+#include "../../utils/NetworkRequestFactory.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QUrl>
+#include <limits>
+
+SessionManager* SessionManager::s_instance = nullptr;
+
+SessionManager* SessionManager::instance()
+{
+    if (!s_instance) {
+        s_instance = new SessionManager();
+    }
+    return s_instance;
+}
+
+SessionManager::SessionManager(QObject *parent)
+    : QObject(parent)
+    , m_networkManager(new QNetworkAccessManager(this))
+    , m_refreshTimer(new QTimer(this))
+{
+    m_refreshTimer->setSingleShot(true);
+    m_refreshTimer->setTimerType(Qt::VeryCoarseTimer);
+    connect(m_refreshTimer, &QTimer::timeout, this, &SessionManager::refreshNow);
+
+    NetworkRequestFactory::setAccessTokenProvider([this]() { return m_accessToken; });
+}
+
+// ===== 会话 =====
+
+void SessionManager::setSession(const QString &accessToken, const QString &refreshToken, qint64 expiresAt)
+{
+    m_accessToken = accessToken;
+    if (!refreshToken.isEmpty()) {
+        m_refreshToken = refreshToken;
+    }
+    m_expiresAt = expiresAt;
+
+    qDebug() << "[SessionManager] 会话已更新，过期时间:"
+             << QDateTime::fromSecsSinceEpoch(m_expiresAt).toString(Qt::ISODate);
+    scheduleRefresh();
+}
+
+void SessionManager::clear()
+{
+    m_refreshTimer->stop();
+    if (m_refreshReply) {
+        QNetworkReply *reply = m_refreshReply;
+        m_refreshReply = nullptr;
+        reply->abort();
+        reply->deleteLater();
+    }
+    m_accessToken.clear();
+    m_refreshToken.clear();
+    m_expiresAt = 0;
+
+    // 排队的请求照常发出（此时以匿名身份），不让调用方一直等待
+    flushPending();
+}
+
+bool SessionManager::isTokenUsable() const
+{
+    if (!hasSession()) return true;
+    if (m_accessToken.isEmpty()) return false;
+    return m_expiresAt - QDateTime::currentSecsSinceEpoch() > EXPIRY_SKEW_SECS;
+}
+
+void SessionManager::scheduleRefresh()
+{
+    m_refreshTimer->stop();
+    if (!hasSession() || m_expiresAt <= 0) return;
+
+    const qint64 delaySecs = m_expiresAt - REFRESH_MARGIN_SECS - QDateTime::currentSecsSinceEpoch();
+    if (delaySecs <= 0) {
+        refreshNow();
+        return;
+    }
+    m_refreshTimer->start(static_cast<int>(qMin<qint64>(delaySecs * 1000, std::numeric_limits<int>::max())));
+}
+
+// ===== 请求排队 =====
+
+void SessionManager::whenReady(QObject *context, std::function<void()> task)
+{
+    if (isTokenUsable() && !isRefreshing()) {
+        task();
+        return;
+    }
+    m_pending.append({context, std::move(task)});
+    refreshNow();
+}
+
+void SessionManager::flushPending()
+{
+    const QList<PendingTask> tasks = std::move(m_pending);
+    m_pending.clear();
+    if (!tasks.isEmpty()) {
+        qDebug() << "[SessionManager] 发出排队的请求:" << tasks.size();
+    }
+    for (const PendingTask &pending : tasks) {
+        if (pending.context) {
+            pending.task();
+        }
+    }
+}
+
+// ===== 请求鉴权 =====
+
+bool SessionManager::isUserRequest(const QNetworkRequest &request)
+{
+    static const QString supabaseHost = QUrl(SupabaseConfig::supabaseUrl()).host();
+    const QUrl url = request.url();
+    if (url.host() != supabaseHost) return false;
+    if (url.path().startsWith("/auth/v1/token")) return false;
+
+    const QString serviceKey = SupabaseConfig::supabaseServiceKey();
+    if (!serviceKey.isEmpty()
+        && request.rawHeader("Authorization") == QString("Bearer %1").arg(serviceKey).toUtf8()) {
+        return false;
+    }
+    return true;
+}
+
+QNetworkRequest SessionManager::authorize(const QNetworkRequest &request) const
+{
+    QNetworkRequest authorized(request);
+    if (!m_accessToken.isEmpty()) {
+        authorized.setRawHeader("Authorization", QString("Bearer %1").arg(m_accessToken).toUtf8());
+    }
+    return authorized;
+}
+
+// ===== 刷新 =====
+
+void SessionManager::refreshNow()
+{
+    if (m_refreshReply || !hasSession()) {
+        if (!hasSession()) flushPending();
+        return;
+    }
+
+    qDebug() << "[SessionManager] 刷新访问令牌";
+    m_refreshTimer->stop();
+
+    const QUrl url(SupabaseConfig::supabaseUrl() + "/auth/v1/token?grant_type=refresh_token");
+    QNetworkRequest request = NetworkRequestFactory::createGeneralRequest(url, NetworkRequestFactory::TIMEOUT_AUTH);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
+    request.setRawHeader("Authorization",
+                         QString("Bearer %1").arg(SupabaseConfig::supabaseAnonKey()).toUtf8());
+
+    const QJsonObject body{{"refresh_token", m_refreshToken}};
+    m_refreshReply = m_networkManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+    connect(m_refreshReply, &QNetworkReply::finished, this, &SessionManager::onRefreshFinished);
+}
+
+void SessionManager::onRefreshFinished()
+{
+    QNetworkReply *reply = m_refreshReply;
+    if (!reply) return;   // clear() 已中止
+    m_refreshReply = nullptr;
+    reply->deleteLater();
+
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    const QJsonObject json = QJsonDocument::fromJson(reply->readAll()).object();
+
+    if (reply->error() == QNetworkReply::NoError && json.contains("access_token")) {
+        const qint64 expiresAt = json.contains("expires_at")
+            ? json["expires_at"].toVariant().toLongLong()
+            : QDateTime::currentSecsSinceEpoch() + json["expires_in"].toVariant().toLongLong();
+        setSession(json["access_token"].toString(), json["refresh_token"].toString(), expiresAt);
+        emit sessionRefreshed();
+        flushPending();
+        return;
+    }
+
+    if (status == 400 || status == 401) {
+        // refresh token 已失效或被撤销，只能重新登录
+        const QString reason = json.value("error_description").toString(
+            json.value("msg").toString(reply->errorString()));
+        qWarning() << "[SessionManager] 会话已失效:" << reason;
+        m_refreshTimer->stop();
+        m_refreshToken.clear();
+        flushPending();
+        emit sessionExpired(reason);
+        return;
+    }
+
+    // 网络问题：稍后重试；排队的请求先发出，避免一直挂起
+    qWarning() << "[SessionManager] 刷新令牌失败，稍后重试:" << reply->errorString();
+    flushPending();
+    m_refreshTimer->start(RETRY_DELAY_MS);
+}
@@ -0,0 +1,93 @@
+#ifndef SESSIONMANAGER_H
+#define SESSIONMANAGER_H
+
+#include <QObject>
+#include <QList>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QString>
+#include <functional>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+class QTimer;
+
+/**
+ * @brief 登录会话管理（单例）
+ *
+ * 统一持有当前用户的 access / refresh token，并作为令牌来源注入 NetworkRequestFactory，
+ * 各服务创建的 Supabase 请求都带上最新的用户令牌。
+ *
+ * 令牌在过期前 REFRESH_MARGIN_SECS 秒由定时器主动刷新，正常情况下请求不会带着过期令牌发出。
+ * 若令牌已经过期（例如系统休眠后定时器来不及触发），通过 whenReady() 或
+ * SessionNetworkManager 发出的请求会排队，等刷新结束后再发送，而不是先失败一次再让用户重试。
+ */
+class SessionManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 REFRESH_MARGIN_SECS = 120;   // 提前刷新的时间
+    static constexpr qint64 EXPIRY_SKEW_SECS = 15;       // 剩余有效期低于此值即视为已过期
+    static constexpr int RETRY_DELAY_MS = 15000;         // 网络原因刷新失败后的重试间隔
+
+    static SessionManager* instance();
+
+    void setSession(const QString &accessToken, const QString &refreshToken, qint64 expiresAt);
+    void clear();
+
+    bool hasSession() const { return !m_refreshToken.isEmpty(); }
+    QString accessToken() const { return m_accessToken; }
+    qint64 expiresAt() const { return m_expiresAt; }
+    bool isRefreshing() const { return m_refreshReply != nullptr; }
+
+    // 没有会话，或令牌仍在有效期内
+    bool isTokenUsable() const;
+
+    /**
+     * @brief 令牌可用时立即执行 task，否则排队并触发刷新
+     *
+     * 刷新结束后无论成败都会执行排队的任务（失败时由请求本身报错）；
+     * context 被销毁的任务直接丢弃。
+     */
+    void whenReady(QObject *context, std::function<void()> task);
+
+    // 是否应携带用户令牌：发往 Supabase、不是登录 / 刷新接口、也不是 service key 请求
+    static bool isUserRequest(const QNetworkRequest &request);
+
+    // 返回换上当前用户令牌的请求副本
+    QNetworkRequest authorize(const QNetworkRequest &request) const;
+
+public slots:
+    void refreshNow();
+
+signals:
+    void sessionRefreshed();
+    void sessionExpired(const QString &reason);   // refresh token 已失效，需要重新登录
+
+private:
+    explicit SessionManager(QObject *parent = nullptr);
+
+    void scheduleRefresh();
+    void onRefreshFinished();
+    void flushPending();
+
+    static SessionManager *s_instance;
+
+    struct PendingTask {
+        QPointer<QObject> context;
+        std::function<void()> task;
+    };
+
+    QNetworkAccessManager *m_networkManager;
+    QTimer *m_refreshTimer;
+    QNetworkReply *m_refreshReply = nullptr;
+
+    QString m_accessToken;
+    QString m_refreshToken;
+    qint64 m_expiresAt = 0;            // Unix 秒
+
+    QList<PendingTask> m_pending;
+};
+
+#endif // SESSIONMANAGER_H
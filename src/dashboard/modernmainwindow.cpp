@@ -5,6 +5,7 @@
 #include "../attendance/ui/AttendanceWidget.h"
 #include "../auth/login/simpleloginwindow.h"
 #include "../auth/supabase/supabaseconfig.h"
+#include "../auth/supabase/sessionmanager.h"
 #include "../config/AppConfig.h"
 #include "../config/embedded_keys.h"
 #include "../hotspot/RealNewsProvider.h"
@@ -32,6 +33,7 @@
 #include "../ui/LessonPlanEditor.h"
 #include "../ui/aipreparationwidget.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/StartupProfiler.h"
 #include <QApplication>
 #include <QComboBox>
 #include <QCursor>
@@ -86,6 +88,16 @@
 #include <QtMath>
 #include <functional>
 
+// 懒加载页面标识
+const QString PAGE_AI_PREPARATION = QStringLiteral("ai_preparation");
+const QString PAGE_QUESTION_BANK = QStringLiteral("question_bank");
+const QString PAGE_HOTSPOT = QStringLiteral("hotspot");
+const QString PAGE_DATA_ANALYTICS = QStringLiteral("data_analytics");
+const QString PAGE_ATTENDANCE = QStringLiteral("attendance");
+const QString PAGE_MY_CLASS = QStringLiteral("my_class");
+const QString PAGE_HELP_CENTER = QStringLiteral("help_center");
+const int PAGE_PREWARM_DELAY_MS = 1500;
+
 // 思政课堂色彩体系
 const QString PATRIOTIC_RED = StyleConfig::PATRIOTIC_RED;
 const QString PATRIOTIC_RED_LIGHT = StyleConfig::PATRIOTIC_RED_LIGHT;
@@ -802,6 +814,7 @@ ModernMainWindow::ModernMainWindow(const QString &userRole,
   UserSettingsManager::instance()->setRole(currentUserRole);
   UserSettingsManager::instance()->save();
 
+  StartupProfiler::instance().begin("main_window.construct");
   qDebug() << "=== ModernMainWindow 构造函数开始 ===";
   qDebug() << "用户角色:" << userRole << "用户名:" << username
            << "用户ID:" << userId;
@@ -813,6 +826,7 @@ ModernMainWindow::ModernMainWindow(const QString &userRole,
   resize(1600, 1000);
 
   // 初始化试题库数据仓库
+  StartupProfiler::instance().begin("main_window.services");
   questionRepository = new QuestionRepository(this);
   questionRepository->loadQuestions("resources/data/questions.json");
 
@@ -1005,23 +1019,38 @@ ModernMainWindow::ModernMainWindow(const QString &userRole,
 
   // 初始化通知服务
   m_notificationService = new NotificationService(this);
-  m_notificationService->setCurrentUserId(
-      currentUserId.isEmpty() ? username : currentUserId);
   connect(m_notificationService, &NotificationService::unreadCountChanged, this,
           &ModernMainWindow::onUnreadCountChanged);
+  // 先连接再设置用户：设置用户时会从本地存储恢复未读数
+  m_notificationService->setCurrentUserId(
+      currentUserId.isEmpty() ? username : currentUserId);
+
+  // refresh token 失效时令牌无法再自动续期，提示用户重新登录
+  connect(SessionManager::instance(), &SessionManager::sessionExpired, this,
+          [this](const QString &) {
+            ModernDialogHelper::warning(this, "登录已过期",
+                                        "登录状态已失效，请退出后重新登录。");
+          });
 
+  StartupProfiler::instance().end("main_window.services");
+
+  StartupProfiler::instance().begin("main_window.setup_ui");
   initUI();
   setupMenuBar();
   setupStatusBar();
   setupCentralWidget();
   setupStyles();
   applyPatrioticRedTheme();
+  StartupProfiler::instance().end("main_window.setup_ui");
 
   // 创建默认页面
+  StartupProfiler::instance().begin("main_window.dashboard");
   createDashboard();
+  StartupProfiler::instance().end("main_window.dashboard");
 
   // 学生默认进入时政新闻，教师进入仪表板，管理员进入管理后台
   if (currentUserRole == "学生") {
+    ensurePage(PAGE_HOTSPOT);
     contentStack->setCurrentWidget(m_hotspotWidget);
     m_hotspotWidget->refresh();
   } else if (currentUserRole == "管理员") {
@@ -1047,7 +1076,17 @@ ModernMainWindow::ModernMainWindow(const QString &userRole,
     });
   }
 
+  StartupProfiler::instance().end("main_window.construct");
   qDebug() << "=== ModernMainWindow 构造函数完成 ===";
+
+  // 首帧之后记录可交互时间点，并在空闲时预热其余页面
+  QTimer::singleShot(0, this, [this]() {
+    StartupProfiler::instance().mark("main_window.interactive");
+    StartupProfiler::instance().dumpIfConfigured();
+    if (currentUserRole != "管理员") {
+      startPagePrewarm();
+    }
+  });
 }
 
 ModernMainWindow::~ModernMainWindow() {}
@@ -1290,53 +1329,8 @@ void ModernMainWindow::setupCentralWidget() {
   dashboardWidget = new QWidget();
   contentStack->addWidget(dashboardWidget);
 
-  // 创建 AI 智能备课页面
-  aiPreparationWidget = new AIPreparationWidget();
-  contentStack->addWidget(aiPreparationWidget);
-
-  // 创建试题库页面
-  questionBankWindow = new QuestionBankWindow(this);
-  contentStack->addWidget(questionBankWindow);
-
-  // 将试题库出题历史侧边栏加入全局侧边栏堆栈（页面3）
-  if (questionBankWindow->questionHistoryWidget()) {
-    m_sidebarStack->addWidget(questionBankWindow->questionHistoryWidget());
-  }
-
-  // 创建时政新闻页面
-  m_hotspotService = new HotspotService(this);
-  RealNewsProvider *newsProvider = new RealNewsProvider(this);
-  // API Key 优先级：环境变量 > 内嵌Key
-  QString tianxingKey = qEnvironmentVariable("TIANXING_API_KEY");
-  if (tianxingKey.isEmpty() && strlen(EmbeddedKeys::TIANXING_API_KEY) > 0) {
-    tianxingKey = QString::fromUtf8(EmbeddedKeys::TIANXING_API_KEY);
-  }
-  if (!tianxingKey.isEmpty()) {
-    newsProvider->setTianXingApiKey(tianxingKey);
-    qDebug() << "[ModernMainWindow] 天行数据 API Key 已配置";
-  } else {
-    qWarning() << "[ModernMainWindow] TIANXING_API_KEY 未设置，将使用 RSS "
-                  "源（可能是旧数据）";
-  }
-  m_hotspotService->setNewsProvider(newsProvider);
-
-  m_hotspotWidget = new HotspotTrackingWidget(this);
-  m_hotspotWidget->setHotspotService(m_hotspotService);
-  m_hotspotWidget->setDifyService(m_difyService);
-  contentStack->addWidget(m_hotspotWidget);
-
-  // 创建数据分析报告页面
-  m_dataAnalyticsWidget = new DataAnalyticsWidget(this);
-  m_dataAnalyticsWidget->setDifyService(m_difyService);
-  contentStack->addWidget(m_dataAnalyticsWidget);
-
-  // 创建考勤管理页面
-  m_attendanceWidget = new AttendanceWidget(this);
-  auto *attendanceService = new AttendanceService(this);
-  attendanceService->setCurrentUserId(currentUserId.isEmpty() ? "teacher_001"
-                                                              : currentUserId);
-  m_attendanceWidget->setAttendanceService(attendanceService);
-  contentStack->addWidget(m_attendanceWidget);
+  // 各功能页面改为首次导航时构造（见 registerPageFactories）
+  registerPageFactories();
 
   // 考勤结束后自动跳转到考勤管理页
   connect(AttendanceManager::instance(), &AttendanceManager::attendanceEnded,
@@ -1344,15 +1338,6 @@ void ModernMainWindow::setupCentralWidget() {
             switchToAttendanceWithSession(sessionId, classId);
           });
 
-  // 创建"我的班级"页面（学生端）
-  m_myClassWidget =
-      new MyClassWidget(currentUserRole == "教师", currentUsername);
-  contentStack->addWidget(m_myClassWidget);
-
-  // 创建帮助中心页面
-  m_helpCenterWidget = new HelpCenterWidget(this);
-  contentStack->addWidget(m_helpCenterWidget);
-
   // 根据角色设置侧边栏可见性和默认页面
   bool isStudent = (currentUserRole == "学生");
   if (isStudent) {
@@ -1363,77 +1348,12 @@ void ModernMainWindow::setupCentralWidget() {
     learningAnalysisBtn->setVisible(false);
     myClassBtn->setVisible(true);
     // 默认选中时政新闻
-    contentStack->setCurrentWidget(m_hotspotWidget);
+    contentStack->setCurrentWidget(ensurePage(PAGE_HOTSPOT));
     setActiveSidebarButton(newsTrackingBtn);
   } else {
     myClassBtn->setVisible(true); // 教师也能看到我的班级
   }
 
-  // 连接时政热点"生成案例"信号 - 自动切换到AI对话页面并发送请求
-  connect(m_hotspotWidget, &HotspotTrackingWidget::teachingContentRequested,
-          this, [this](const NewsItem &news) {
-            qDebug() << "[ModernMainWindow] 收到生成教学案例请求:"
-                     << news.title;
-
-            // 1. 切换到AI对话页面
-            if (contentStack && dashboardWidget) {
-              contentStack->setCurrentWidget(dashboardWidget);
-            }
-            if (m_mainStack && m_chatContainer) {
-              m_mainStack->setCurrentWidget(m_chatContainer);
-              swapToHistorySidebar();
-            }
-
-            // 2. 更新侧边栏按钮状态
-            setActiveSidebarButton(aiPreparationBtn);
-
-            // 3. 构建教学案例生成提示并直接发送（不显示问候语）
-            QString prompt = QString("请根据以下时政新闻，生成一份适合思政课堂"
-                                     "使用的教学案例分析。\n\n"
-                                     "【新闻标题】%1\n"
-                                     "【新闻来源】%2\n"
-                                     "【新闻摘要】%3\n\n"
-                                     "请按以下格式输出：\n"
-                                     "## 案例背景\n"
-                                     "简要介绍新闻背景\n\n"
-                                     "## 思政价值\n"
-                                     "分析该新闻蕴含的思政教育价值\n\n"
-                                     "## 讨论话题\n"
-                                     "设计2-3个适合课堂讨论的话题\n\n"
-                                     "## 延伸思考\n"
-                                     "引导学生进行深入思考的问题")
-                                 .arg(news.title, news.source, news.summary);
-
-            // 4. 在聊天界面显示用户的请求（简化版）
-            if (m_bubbleChatWidget) {
-              QString userMsg =
-                  QString("请根据新闻《%1》生成思政教学案例").arg(news.title);
-              m_bubbleChatWidget->addMessage(userMsg, true);
-            }
-
-            // 5. 发送到Dify（直接发送，不需要问候语）
-            if (m_difyService) {
-              m_difyService->sendMessage(prompt);
-            }
-
-            this->statusBar()->showMessage("AI智能备课 - 正在生成教学案例...");
-          });
-
-  // 连接试题库返回信号
-  connect(questionBankWindow, &QuestionBankWindow::backRequested, this,
-          [this]() {
-            // 返回首页（教师中心）
-            if (contentStack && dashboardWidget) {
-              contentStack->setCurrentWidget(dashboardWidget);
-            }
-            if (m_sidebarStack) {
-              m_sidebarStack->setCurrentIndex(0);
-            }
-            if (teacherCenterBtn) {
-              teacherCenterBtn->setChecked(true);
-            }
-          });
-
   // 添加到可拖拽分隔器，允许用户自行调整侧边栏宽度
   auto *contentSplitter = new QSplitter(Qt::Horizontal, centralWidget);
   contentSplitter->setChildrenCollapsible(false);
@@ -1453,6 +1373,205 @@ void ModernMainWindow::setupCentralWidget() {
   mainLayout->addLayout(contentLayout);
 }
 
+// ===== 懒加载页面 =====
+
+void ModernMainWindow::registerPageFactories() {
+  m_pageFactories.insert(PAGE_AI_PREPARATION, [this]() -> QWidget * {
+    aiPreparationWidget = new AIPreparationWidget();
+    return aiPreparationWidget;
+  });
+
+  m_pageFactories.insert(PAGE_QUESTION_BANK, [this]() -> QWidget * {
+    questionBankWindow = new QuestionBankWindow(this);
+
+    // 将试题库出题历史侧边栏加入全局侧边栏堆栈
+    if (questionBankWindow->questionHistoryWidget()) {
+      m_sidebarStack->addWidget(questionBankWindow->questionHistoryWidget());
+    }
+
+    // 连接试题库返回信号
+    connect(questionBankWindow, &QuestionBankWindow::backRequested, this,
+            [this]() {
+              // 返回首页（教师中心）
+              if (contentStack && dashboardWidget) {
+                contentStack->setCurrentWidget(dashboardWidget);
+              }
+              if (m_sidebarStack) {
+                m_sidebarStack->setCurrentIndex(0);
+              }
+              if (teacherCenterBtn) {
+                teacherCenterBtn->setChecked(true);
+              }
+            });
+    return questionBankWindow;
+  });
+
+  m_pageFactories.insert(PAGE_HOTSPOT, [this]() -> QWidget * {
+    m_hotspotService = new HotspotService(this);
+    RealNewsProvider *newsProvider = new RealNewsProvider(this);
+    // API Key 优先级：环境变量 > 内嵌Key
+    QString tianxingKey = qEnvironmentVariable("TIANXING_API_KEY");
+    if (tianxingKey.isEmpty() && strlen(EmbeddedKeys::TIANXING_API_KEY) > 0) {
+      tianxingKey = QString::fromUtf8(EmbeddedKeys::TIANXING_API_KEY);
+    }
+    if (!tianxingKey.isEmpty()) {
+      newsProvider->setTianXingApiKey(tianxingKey);
+      qDebug() << "[ModernMainWindow] 天行数据 API Key 已配置";
+    } else {
+      qWarning() << "[ModernMainWindow] TIANXING_API_KEY 未设置，将使用 RSS "
+                    "源（可能是旧数据）";
+    }
+    m_hotspotService->setNewsProvider(newsProvider);
+
+    m_hotspotWidget = new HotspotTrackingWidget(this);
+    m_hotspotWidget->setHotspotService(m_hotspotService);
+    m_hotspotWidget->setDifyService(m_difyService);
+
+    // 连接时政热点"生成案例"信号 - 自动切换到AI对话页面并发送请求
+    connect(m_hotspotWidget, &HotspotTrackingWidget::teachingContentRequested,
+            this, [this](const NewsItem &news) {
+              qDebug() << "[ModernMainWindow] 收到生成教学案例请求:"
+                       << news.title;
+
+              // 1. 切换到AI对话页面
+              if (contentStack && dashboardWidget) {
+                contentStack->setCurrentWidget(dashboardWidget);
+              }
+              if (m_mainStack && m_chatContainer) {
+                m_mainStack->setCurrentWidget(m_chatContainer);
+                swapToHistorySidebar();
+              }
+
+              // 2. 更新侧边栏按钮状态
+              setActiveSidebarButton(aiPreparationBtn);
+
+              // 3. 构建教学案例生成提示并直接发送（不显示问候语）
+              QString prompt = QString("请根据以下时政新闻，生成一份适合思政课堂"
+                                       "使用的教学案例分析。\n\n"
+                                       "【新闻标题】%1\n"
+                                       "【新闻来源】%2\n"
+                                       "【新闻摘要】%3\n\n"
+                                       "请按以下格式输出：\n"
+                                       "## 案例背景\n"
+                                       "简要介绍新闻背景\n\n"
+                                       "## 思政价值\n"
+                                       "分析该新闻蕴含的思政教育价值\n\n"
+                                       "## 讨论话题\n"
+                                       "设计2-3个适合课堂讨论的话题\n\n"
+                                       "## 延伸思考\n"
+                                       "引导学生进行深入思考的问题")
+                                   .arg(news.title, news.source, news.summary);
+
+              // 4. 在聊天界面显示用户的请求（简化版）
+              if (m_bubbleChatWidget) {
+                QString userMsg =
+                    QString("请根据新闻《%1》生成思政教学案例").arg(news.title);
+                m_bubbleChatWidget->addMessage(userMsg, true);
+              }
+
+              // 5. 发送到Dify（直接发送，不需要问候语）
+              if (m_difyService) {
+                m_difyService->sendMessage(prompt);
+              }
+
+              this->statusBar()->showMessage("AI智能备课 - 正在生成教学案例...");
+            });
+    return m_hotspotWidget;
+  });
+
+  m_pageFactories.insert(PAGE_DATA_ANALYTICS, [this]() -> QWidget * {
+    m_dataAnalyticsWidget = new DataAnalyticsWidget(this);
+    m_dataAnalyticsWidget->setDifyService(m_difyService);
+    return m_dataAnalyticsWidget;
+  });
+
+  m_pageFactories.insert(PAGE_ATTENDANCE, [this]() -> QWidget * {
+    m_attendanceWidget = new AttendanceWidget(this);
+    auto *attendanceService = new AttendanceService(this);
+    attendanceService->setCurrentUserId(
+        currentUserId.isEmpty() ? "teacher_001" : currentUserId);
+    m_attendanceWidget->setAttendanceService(attendanceService);
+    return m_attendanceWidget;
+  });
+
+  m_pageFactories.insert(PAGE_MY_CLASS, [this]() -> QWidget * {
+    m_myClassWidget =
+        new MyClassWidget(currentUserRole == "教师", currentUsername);
+    return m_myClassWidget;
+  });
+
+  m_pageFactories.insert(PAGE_HELP_CENTER, [this]() -> QWidget * {
+    m_helpCenterWidget = new HelpCenterWidget(this);
+    return m_helpCenterWidget;
+  });
+
+  // 预热顺序：按使用频率排列，帮助中心和旧版备课页不预热
+  m_prewarmQueue = {PAGE_HOTSPOT, PAGE_QUESTION_BANK, PAGE_MY_CLASS,
+                    PAGE_ATTENDANCE, PAGE_DATA_ANALYTICS};
+}
+
+QWidget *ModernMainWindow::ensurePage(const QString &pageKey) {
+  if (QWidget *page = m_pages.value(pageKey)) {
+    return page;
+  }
+
+  auto factory = m_pageFactories.constFind(pageKey);
+  if (factory == m_pageFactories.constEnd()) {
+    qWarning() << "[ModernMainWindow] 未注册的页面:" << pageKey;
+    return nullptr;
+  }
+
+  StartupProfiler::Scope scope(QStringLiteral("page.") + pageKey);
+  QWidget *page = (*factory)();
+  contentStack->addWidget(page);
+  m_pages.insert(pageKey, page);
+  m_prewarmQueue.removeAll(pageKey);
+  return page;
+}
+
+void ModernMainWindow::discardPage(const QString &pageKey) {
+  QWidget *page = m_pages.take(pageKey);
+  if (!page) {
+    return;
+  }
+  contentStack->removeWidget(page);
+  page->deleteLater();
+}
+
+void ModernMainWindow::startPagePrewarm() {
+  const QString setting =
+      AppConfig::get(QStringLiteral("PREWARM_PAGES"), QStringLiteral("1"))
+          .trimmed()
+          .toLower();
+  if (setting == "0" || setting == "false" || setting == "no") {
+    qDebug() << "[ModernMainWindow] 已关闭页面预热";
+    return;
+  }
+
+  // 首帧之后留出空闲时间再预热，避免与首屏交互争抢主线程
+  QTimer::singleShot(PAGE_PREWARM_DELAY_MS, this, [this]() { prewarmNextPage(); });
+}
+
+void ModernMainWindow::prewarmNextPage() {
+  // 学生端没有教师功能入口，不预热对应页面
+  const bool isStudent = (currentUserRole == "学生");
+  while (!m_prewarmQueue.isEmpty()) {
+    const QString pageKey = m_prewarmQueue.takeFirst();
+    if (isStudent && (pageKey == PAGE_QUESTION_BANK ||
+                      pageKey == PAGE_ATTENDANCE ||
+                      pageKey == PAGE_DATA_ANALYTICS)) {
+      continue;
+    }
+    ensurePage(pageKey);
+    break;
+  }
+
+  // 每次事件循环只构造一个页面，保持界面响应
+  if (!m_prewarmQueue.isEmpty()) {
+    QTimer::singleShot(0, this, [this]() { prewarmNextPage(); });
+  }
+}
+
 void ModernMainWindow::applySidebarIcons() {
   auto setIcon = [this](QPushButton *button, const QString &themeName,
                         QStyle::StandardPixmap fallback) {
@@ -1747,7 +1866,7 @@ void ModernMainWindow::createHeaderWidget() {
   m_notificationBadge = new NotificationBadge(notificationBtn);
   // 按钮固定40x40，小红点18x18，放在右上角
   m_notificationBadge->move(24, -4);
-  m_notificationBadge->setCount(0);
+  m_notificationBadge->setCount(m_notificationService ? m_notificationService->unreadCount() : 0);
 
   // 创建通知弹窗
   m_notificationWidget = new NotificationWidget(m_notificationService, this);
@@ -2303,14 +2422,15 @@ void ModernMainWindow::onResourceManagementClicked() {
   setActiveSidebarButton(resourceManagementBtn);
 
   // 切换到试题库页面
+  ensurePage(PAGE_QUESTION_BANK);
   if (questionBankWindow) {
     qDebug() << "切换到试题库页面";
     contentStack->setCurrentWidget(questionBankWindow);
     this->statusBar()->showMessage("试题库");
 
-    // 切换侧边栏为出题历史（页面3），隐藏导航栏
-    if (m_sidebarStack) {
-      m_sidebarStack->setCurrentIndex(3);
+    // 切换侧边栏为出题历史，隐藏导航栏
+    if (m_sidebarStack && questionBankWindow->questionHistoryWidget()) {
+      m_sidebarStack->setCurrentWidget(questionBankWindow->questionHistoryWidget());
     }
   } else {
     qDebug() << "错误：questionBankWindow为空";
@@ -2323,6 +2443,7 @@ void ModernMainWindow::onAttendanceClicked() {
   setActiveSidebarButton(attendanceBtn);
 
   // 切换到考勤管理页面
+  ensurePage(PAGE_ATTENDANCE);
   if (m_attendanceWidget) {
     contentStack->setCurrentWidget(m_attendanceWidget);
     this->statusBar()->showMessage("考勤管理");
@@ -2343,6 +2464,7 @@ void ModernMainWindow::onMyClassClicked() {
 
   setActiveSidebarButton(myClassBtn);
 
+  ensurePage(PAGE_MY_CLASS);
   if (m_myClassWidget) {
     contentStack->setCurrentWidget(m_myClassWidget);
     this->statusBar()->showMessage("我的班级");
@@ -2355,6 +2477,7 @@ void ModernMainWindow::onLearningAnalysisClicked() {
   setActiveSidebarButton(learningAnalysisBtn);
 
   // 切换到数据分析报告页面
+  ensurePage(PAGE_DATA_ANALYTICS);
   if (m_dataAnalyticsWidget) {
     contentStack->setCurrentWidget(m_dataAnalyticsWidget);
     m_dataAnalyticsWidget->refresh(); // 刷新数据
@@ -2368,6 +2491,7 @@ void ModernMainWindow::onNewsTrackingClicked() {
   setActiveSidebarButton(newsTrackingBtn);
 
   // 切换到时政新闻页面
+  ensurePage(PAGE_HOTSPOT);
   if (contentStack && m_hotspotWidget) {
     contentStack->setCurrentWidget(m_hotspotWidget);
     // 首次进入时刷新数据
@@ -2492,13 +2616,9 @@ void ModernMainWindow::onSettingsClicked() {
       m_userNameLabel->setText(UserSettingsManager::instance()->displayName());
     }
 
-    // 重建班级页面，使用教师角色
-    if (m_myClassWidget) {
-      contentStack->removeWidget(m_myClassWidget);
-      m_myClassWidget->deleteLater();
-    }
-    m_myClassWidget = new MyClassWidget(true, currentUsername);
-    contentStack->addWidget(m_myClassWidget);
+    // 丢弃旧的班级页面，下次进入时按教师角色重新构造
+    discardPage(PAGE_MY_CLASS);
+    m_myClassWidget = nullptr;
 
     onTeacherCenterClicked();
   }
@@ -2510,7 +2630,7 @@ void ModernMainWindow::logoutToLogin() {
     return;
   }
 
-  SupabaseConfig::setAccessToken(QString());
+  SessionManager::instance()->clear();
 
   SimpleLoginWindow *loginWindow = new SimpleLoginWindow(nullptr, false);
   loginWindow->setAttribute(Qt::WA_DeleteOnClose);
@@ -2521,6 +2641,7 @@ void ModernMainWindow::logoutToLogin() {
 }
 
 void ModernMainWindow::onHelpClicked() {
+  ensurePage(PAGE_HELP_CENTER);
   if (m_helpCenterWidget) {
     contentStack->setCurrentWidget(m_helpCenterWidget);
     setActiveSidebarButton(helpBtn);
@@ -26,6 +26,9 @@
 #include <QImage>
 #include <QVector>
 #include <QMap>
+#include <QHash>
+#include <QStringList>
+#include <functional>
 
 #include <QTabWidget>
 
@@ -115,6 +118,13 @@ private:
     void applySidebarIcons();
     void setActiveSidebarButton(QPushButton *activeButton);
     QIcon loadSidebarIcon(const QString &themeName, QStyle::StandardPixmap fallback) const;
+
+    // 懒加载页面：页面及其服务在首次导航时构造，首帧后空闲预热
+    void registerPageFactories();
+    QWidget *ensurePage(const QString &pageKey);
+    void discardPage(const QString &pageKey);
+    void startPagePrewarm();
+    void prewarmNextPage();
     
     // 新版 UI 组件创建方法
     void createWelcomeCard();       // 欢迎卡片
@@ -162,6 +172,11 @@ private:
     QPushButton *logoutBtn = nullptr;             // 退出登录
     QPushButton *helpBtn = nullptr;               // 帮助中心
 
+    // 懒加载页面注册表
+    QHash<QString, std::function<QWidget *()>> m_pageFactories;
+    QHash<QString, QWidget *> m_pages;
+    QStringList m_prewarmQueue;
+
     // 主内容区域
     QStackedWidget *contentStack = nullptr;
     QWidget *dashboardWidget = nullptr;
@@ -51,6 +51,9 @@ public:
 signals:
     /**
      * @brief 新闻列表获取成功
+     *
+     * 多源聚合的提供者可能在一次 fetchHotNews 中多次发出（先发缓存/已到达的部分，
+     * 再发完整结果），以 loadingFinished 为一次请求的结束。
      * @param newsList 新闻列表
      */
     void newsListReceived(const QList<NewsItem> &newsList);
@@ -0,0 +1,141 @@
+#include "NewsAggregator.h"
+#include "NewsCategoryUtils.h"
+#include "NewsKeywordClassifier.h"
+#include "../utils/SimHash.h"
+#include <QDebug>
+#include <algorithm>
+
+void NewsAggregator::setSource(const QString &sourceKey, int rank, const QList<NewsItem> &items)
+{
+    Bucket &bucket = m_buckets[sourceKey];
+    bucket.rank = rank;
+    bucket.items = items;
+}
+
+bool NewsAggregator::isEmpty() const
+{
+    for (auto it = m_buckets.constBegin(); it != m_buckets.constEnd(); ++it) {
+        if (!it->items.isEmpty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QList<NewsItem> NewsAggregator::merged(const QString &category, int limit) const
+{
+    // 按计划顺序拼接，再稳定排序：发布时间相同的新闻保持源的先后
+    QList<const Bucket*> buckets;
+    buckets.reserve(m_buckets.size());
+    for (auto it = m_buckets.constBegin(); it != m_buckets.constEnd(); ++it) {
+        buckets.append(&it.value());
+    }
+    std::stable_sort(buckets.begin(), buckets.end(),
+                     [](const Bucket *a, const Bucket *b) { return a->rank < b->rank; });
+
+    QList<NewsItem> all;
+    for (const Bucket *bucket : buckets) {
+        all.append(bucket->items);
+    }
+
+    std::stable_sort(all.begin(), all.end(),
+                     [](const NewsItem &a, const NewsItem &b) {
+                         return a.publishTime > b.publishTime;
+                     });
+
+    QList<NewsItem> result = clusterDuplicates(all);
+    result = NewsCategoryUtils::filterNewsByCategory(result, category);
+
+    if (limit > 0 && result.size() > limit) {
+        result = result.mid(0, limit);
+    }
+    return result;
+}
+
+QList<NewsItem> NewsAggregator::clusterDuplicates(const QList<NewsItem> &sorted)
+{
+    // 完全相同的 URL/标题/标题前缀直接归入已有簇；否则用 SimHash 找改写过标题的同一事件
+    static constexpr int TITLE_PREFIX_LENGTH = 30;
+    static constexpr int MIN_PREFIX_MATCH_LENGTH = 15;
+
+    QVector<QVector<int>> clusters;  // 簇 -> 成员下标（按排序先后）
+    QHash<QString, int> clusterByUrl;
+    QHash<QString, int> clusterByTitle;
+    QHash<QString, int> clusterByPrefix;
+    SimHashIndex simHashIndex;
+
+    for (int i = 0; i < sorted.size(); ++i) {
+        const NewsItem &item = sorted.at(i);
+        const QString normalizedTitle = item.title.simplified().toLower();
+        const QString titlePrefix = normalizedTitle.left(TITLE_PREFIX_LENGTH);
+        const quint64 fingerprint = SimHash::fingerprint(item.title, item.summary);
+
+        int cluster = -1;
+        if (!item.url.isEmpty()) {
+            cluster = clusterByUrl.value(item.url, -1);
+        }
+        if (cluster < 0) {
+            cluster = clusterByTitle.value(normalizedTitle, -1);
+        }
+        if (cluster < 0 && titlePrefix.length() >= MIN_PREFIX_MATCH_LENGTH) {
+            cluster = clusterByPrefix.value(titlePrefix, -1);
+        }
+        if (cluster < 0 && fingerprint != 0) {
+            cluster = simHashIndex.findNearest(fingerprint);
+        }
+
+        if (cluster < 0) {
+            cluster = clusters.size();
+            clusters.append(QVector<int>());
+        }
+        clusters[cluster].append(i);
+
+        if (!item.url.isEmpty()) {
+            clusterByUrl.insert(item.url, cluster);
+        }
+        clusterByTitle.insert(normalizedTitle, cluster);
+        if (normalizedTitle.length() >= TITLE_PREFIX_LENGTH) {
+            clusterByPrefix.insert(titlePrefix, cluster);
+        }
+        if (fingerprint != 0) {
+            simHashIndex.insert(fingerprint, cluster);
+        }
+    }
+
+    // 每簇选一条代表：官媒 > 有图 > 有摘要 > 更新，簇的位置取其最新一条
+    const NewsKeywordClassifier &classifier = NewsKeywordClassifier::instance();
+    auto representativeScore = [&classifier](const NewsItem &item) {
+        int score = 0;
+        if (classifier.classify(item).officialSource) score += 4;
+        if (!item.imageUrl.isEmpty()) score += 2;
+        if (!item.summary.isEmpty()) score += 1;
+        return score;
+    };
+
+    QList<NewsItem> representatives;
+    representatives.reserve(clusters.size());
+    for (const QVector<int> &members : clusters) {
+        int best = members.first();
+        int bestScore = members.size() > 1 ? representativeScore(sorted.at(best)) : 0;
+        for (int m = 1; m < members.size(); ++m) {
+            const int score = representativeScore(sorted.at(members.at(m)));
+            if (score > bestScore) {
+                best = members.at(m);
+                bestScore = score;
+            }
+        }
+
+        NewsItem representative = sorted.at(best);
+        representative.clusterSize = members.size();
+        if (members.size() > 1) {
+            representative.hotScore = qMin(100, representative.hotScore + (members.size() - 1) * CLUSTER_HOT_BONUS);
+        }
+        representatives.append(representative);
+    }
+
+    if (representatives.size() != sorted.size()) {
+        qDebug() << "[NewsAggregator] 聚类去重: 原" << sorted.size()
+                 << "条 → " << representatives.size() << "个事件";
+    }
+    return representatives;
+}
@@ -0,0 +1,48 @@
+#ifndef NEWSAGGREGATOR_H
+#define NEWSAGGREGATOR_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+
+#include "NewsItem.h"
+
+/**
+ * @brief 多数据源新闻聚合
+ *
+ * 每个数据源的结果按来源键单独保存，任意时刻都可以得到
+ * “排序 + 去重 + 分类过滤 + 截断”后的合并结果，因此可以边到达边展示。
+ * 合并结果只取决于各源的内容和计划顺序（rank），与响应到达的先后无关：
+ * 同一发布时间按 rank 排列。
+ *
+ * 去重按事件聚类：URL/标题完全相同或 SimHash 指纹相近的新闻归为一簇，
+ * 每簇只保留一条代表，clusterSize 记录报道条数并折算进 hotScore。
+ */
+class NewsAggregator
+{
+public:
+    static constexpr int CLUSTER_HOT_BONUS = 10;  // 每多一条同事件报道增加的热度
+
+    void clear() { m_buckets.clear(); }
+
+    // 设置（或替换）某个数据源的结果，rank 为该源在请求计划中的顺序
+    void setSource(const QString &sourceKey, int rank, const QList<NewsItem> &items);
+
+    bool isEmpty() const;
+    int sourceCount() const { return m_buckets.size(); }
+
+    // 合并结果（新的在前），category 为空表示不做分类过滤，limit <= 0 表示不截断
+    QList<NewsItem> merged(const QString &category, int limit) const;
+
+private:
+    struct Bucket {
+        int rank = 0;
+        QList<NewsItem> items;
+    };
+
+    static QList<NewsItem> clusterDuplicates(const QList<NewsItem> &sorted);
+
+    QHash<QString, Bucket> m_buckets;
+};
+
+#endif // NEWSAGGREGATOR_H
@@ -0,0 +1,164 @@
+#include "NewsCache.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+
+namespace {
+
+constexpr int kCacheFormatVersion = 1;
+constexpr int kSaveDelayMs = 1000;
+constexpr qint64 kMaxEntryAgeSecs = 3 * 24 * 3600;  // 超过 3 天的源直接丢弃
+
+QJsonObject newsItemToJson(const NewsItem &item)
+{
+    QJsonObject obj;
+    obj["id"] = item.id;
+    obj["title"] = item.title;
+    obj["summary"] = item.summary;
+    obj["content"] = item.content;
+    obj["source"] = item.source;
+    obj["category"] = item.category;
+    obj["imageUrl"] = item.imageUrl;
+    obj["url"] = item.url;
+    obj["publishTime"] = item.publishTime.toString(Qt::ISODateWithMs);
+    obj["hotScore"] = item.hotScore;
+    obj["keywords"] = QJsonArray::fromStringList(item.keywords);
+    return obj;
+}
+
+NewsItem newsItemFromJson(const QJsonObject &obj)
+{
+    NewsItem item;
+    item.id = obj["id"].toString();
+    item.title = obj["title"].toString();
+    item.summary = obj["summary"].toString();
+    item.content = obj["content"].toString();
+    item.source = obj["source"].toString();
+    item.category = obj["category"].toString();
+    item.imageUrl = obj["imageUrl"].toString();
+    item.url = obj["url"].toString();
+    item.publishTime = QDateTime::fromString(obj["publishTime"].toString(), Qt::ISODateWithMs);
+    item.hotScore = obj["hotScore"].toInt();
+    for (const QJsonValue &keyword : obj["keywords"].toArray()) {
+        item.keywords.append(keyword.toString());
+    }
+    return item;
+}
+
+} // namespace
+
+NewsCache::NewsCache(const QString &filePath, QObject *parent)
+    : QObject(parent)
+    , m_filePath(filePath)
+    , m_saveTimer(new QTimer(this))
+    , m_dirty(false)
+{
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(kSaveDelayMs);
+    connect(m_saveTimer, &QTimer::timeout, this, &NewsCache::flush);
+
+    load();
+}
+
+NewsCache::~NewsCache()
+{
+    flush();
+}
+
+QString NewsCache::defaultFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/hotspot_news_cache.json";
+}
+
+void NewsCache::store(const QString &sourceKey, const QList<NewsItem> &items)
+{
+    Entry &entry = m_entries[sourceKey];
+    entry.items = items;
+    entry.fetchedAt = QDateTime::currentDateTimeUtc();
+
+    m_dirty = true;
+    m_saveTimer->start();
+}
+
+void NewsCache::load()
+{
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        qWarning() << "[NewsCache] 缓存文件损坏，忽略:" << parseError.errorString();
+        return;
+    }
+
+    const QJsonObject root = doc.object();
+    if (root["version"].toInt() != kCacheFormatVersion) {
+        return;
+    }
+
+    const QJsonObject sources = root["sources"].toObject();
+    for (auto it = sources.constBegin(); it != sources.constEnd(); ++it) {
+        const QJsonObject source = it.value().toObject();
+
+        Entry entry;
+        entry.fetchedAt = QDateTime::fromString(source["fetchedAt"].toString(), Qt::ISODateWithMs);
+        if (!entry.isValid() || entry.ageSecs() > kMaxEntryAgeSecs) {
+            continue;
+        }
+        for (const QJsonValue &value : source["items"].toArray()) {
+            const NewsItem item = newsItemFromJson(value.toObject());
+            if (item.isValid()) {
+                entry.items.append(item);
+            }
+        }
+        m_entries.insert(it.key(), entry);
+    }
+
+    qDebug() << "[NewsCache] 已加载" << m_entries.size() << "个数据源的缓存";
+}
+
+void NewsCache::flush()
+{
+    m_saveTimer->stop();
+    if (!m_dirty) {
+        return;
+    }
+    m_dirty = false;
+
+    QJsonObject sources;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        QJsonArray items;
+        for (const NewsItem &item : it->items) {
+            items.append(newsItemToJson(item));
+        }
+        QJsonObject source;
+        source["fetchedAt"] = it->fetchedAt.toString(Qt::ISODateWithMs);
+        source["items"] = items;
+        sources.insert(it.key(), source);
+    }
+
+    QJsonObject root;
+    root["version"] = kCacheFormatVersion;
+    root["sources"] = sources;
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[NewsCache] 无法写入缓存:" << file.errorString();
+        return;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!file.commit()) {
+        qWarning() << "[NewsCache] 缓存写入失败:" << file.errorString();
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef NEWSCACHE_H
+#define NEWSCACHE_H
+
+#include <QDateTime>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QString>
+
+#include "NewsItem.h"
+
+class QTimer;
+
+/**
+ * @brief 新闻磁盘缓存（按数据源）
+ *
+ * 每个数据源最近一次成功拉取的结果连同拉取时间持久化到一个 JSON 文件，
+ * 应用启动时即可用上次的数据渲染热点页。是否新鲜由调用方按源的 TTL 判断。
+ * 写盘做了合并延迟，析构时会把未写入的改动落盘。
+ */
+class NewsCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Entry {
+        QList<NewsItem> items;
+        QDateTime fetchedAt;
+
+        bool isValid() const { return fetchedAt.isValid(); }
+        qint64 ageSecs() const { return fetchedAt.secsTo(QDateTime::currentDateTimeUtc()); }
+    };
+
+    explicit NewsCache(const QString &filePath = defaultFilePath(), QObject *parent = nullptr);
+    ~NewsCache() override;
+
+    static QString defaultFilePath();
+
+    Entry entry(const QString &sourceKey) const { return m_entries.value(sourceKey); }
+    void store(const QString &sourceKey, const QList<NewsItem> &items);
+
+    // 立即写盘
+    void flush();
+
+private:
+    void load();
+
+    QString m_filePath;
+    QHash<QString, Entry> m_entries;
+    QTimer *m_saveTimer;
+    bool m_dirty;
+};
+
+#endif // NEWSCACHE_H
@@ -21,8 +21,9 @@ struct NewsItem {
     QDateTime publishTime;   // 发布时间
     int hotScore;            // 热度评分 (0-100)
     QStringList keywords;    // 关键词标签
+    int clusterSize;         // 同一事件被多少条报道合并（聚合去重后 ≥ 1）
     
-    NewsItem() : hotScore(0) {}
+    NewsItem() : hotScore(0), clusterSize(1) {}
     
     bool isValid() const {
         return !id.isEmpty() && !title.isEmpty();
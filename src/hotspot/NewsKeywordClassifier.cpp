@@ -0,0 +1,419 @@
+#include "NewsKeywordClassifier.h"
+#include <QDebug>
+#include <QQueue>
+
+namespace {
+
+enum TextField {
+    FieldTitle    = 1 << 0,
+    FieldSummary  = 1 << 1,
+    FieldContent  = 1 << 2,
+    FieldKeywords = 1 << 3,
+    FieldSource   = 1 << 4
+};
+
+inline char16_t foldChar(QChar c)
+{
+    return c.toCaseFolded().unicode();
+}
+
+// ===== 时政筛选词表 =====
+
+// 领导人
+const QStringList kLeaderKeywords = {
+    "习近平", "李强", "赵乐际", "王沪宁", "蔡奇", "丁薛祥", "李希",
+    "总书记", "国家主席", "总理", "委员长", "政协主席", "国家副主席"
+};
+
+// 机构、会议活动
+const QStringList kInstitutionKeywords = {
+    "中央", "国务院", "全国人大", "全国政协", "中纪委", "中组部",
+    "外交部", "国防部", "发改委", "教育部", "科技部", "工信部",
+    "公安部", "民政部", "司法部", "财政部", "人社部", "自然资源部",
+    "生态环境部", "住建部", "交通运输部", "水利部", "农业农村部",
+    "商务部", "文旅部", "卫健委", "退役军人部", "应急管理部",
+    "中国人民银行", "审计署", "国资委", "海关总署", "税务总局",
+    "市场监管", "广电总局", "体育总局", "统计局", "医保局",
+    "两会", "党代会", "中央全会", "政治局", "常委会", "座谈会",
+    "工作会议", "中央经济", "深改委", "国家安全", "中央财经"
+};
+
+// 政策理论、外交国防及其他时政
+const QStringList kPolicyKeywords = {
+    "改革", "政策", "法治", "依法治国", "从严治党", "党建",
+    "思想政治", "意识形态", "马克思", "社会主义", "新时代",
+    "中国特色", "现代化", "高质量发展", "共同富裕", "乡村振兴",
+    "一带一路", "双循环", "碳达峰", "碳中和", "数字中国",
+    "外交", "国防", "军队", "解放军", "武警", "国际关系",
+    "中美", "中俄", "中欧", "台湾", "港澳", "统一",
+    "省委", "市委", "党委", "人大代表", "政协委员",
+    "纪检", "巡视", "反腐", "廉政", "作风建设",
+    "经济工作", "金融监管", "科技创新", "产业政策", "区域发展"
+};
+
+// 社会新闻排除关键词
+const QStringList kExcludeKeywords = {
+    // 事故灾难类
+    "车祸", "事故", "坠楼", "跳楼", "自杀", "凶杀", "命案", "火灾",
+    "爆炸", "塌方", "坍塌", "伤亡", "遇难", "死亡", "身亡", "溺水",
+    "触电", "中毒", "煤气", "意外", "惨剧",
+    // 犯罪类
+    "骗子", "诈骗", "盗窃", "抢劫", "绑架", "失踪", "贩毒", "贪污",
+    "偷窃", "强奸", "猥亵", "杀人", "杀害", "谋杀", "行凶", "砍人",
+    "报警", "逮捕", "抓捕", "犯罪", "嫌疑人", "作案", "案件", "刑事",
+    // 娱乐八卦类
+    "出轨", "离婚", "小三", "婆媳", "家暴", "吵架", "恋情", "分手",
+    "网红", "明星", "八卦", "绯闻", "整容", "炫富", "豪宅", "豪车",
+    "结婚", "订婚", "热恋", "复合", "前夫", "前妻", "恋爱",
+    // 博彩赌博类
+    "彩票", "赌博", "酒驾", "醉驾", "超速", "违章", "中奖", "博彩",
+    // 生活娱乐类
+    "宠物", "萌宠", "吃播", "减肥", "健身", "美食", "旅游",
+    "直播", "带货", "网购", "团购", "探店", "打卡", "测评",
+    // 社会琐事类
+    "口角", "纠纷", "邻居", "停车", "物业", "业主",
+    "打架", "斗殴", "聚众", "闹事", "争执", "争吵", "冲突",
+    // 奇闻异事类
+    "路人", "围观", "现场", "目击", "爆料", "曝光", "揭秘",
+    "惊现", "惊人", "震惊", "吓人", "离奇", "诡异",
+    "奇葩", "奇怪", "罕见", "匪夷所思", "不可思议",
+    // 医疗健康类（个人案例）
+    "患者", "病人", "手术", "肿瘤", "癌症", "确诊", "治疗", "医院",
+    // 消费维权类（个案）
+    "投诉", "维权", "退款", "赔偿", "索赔", "质量问题", "假冒",
+    // 家庭矛盾类
+    "继母", "继父", "婆婆", "儿媳", "女婿", "岳父", "岳母",
+    // 情感故事类
+    "表白", "求婚", "情侣", "夫妻", "相亲", "约会", "男友", "女友",
+    // 校园社会类（非教育政策）
+    "学生打架", "校园霸凌", "师生冲突", "早恋",
+    // 其他社会八卦
+    "网友热议", "引发热议", "网传", "有人", "某男", "某女",
+    "一男子", "一女子", "男童", "女童", "老人", "老太",
+    // 标题党关键词
+    "太", "竟然", "居然", "竟", "万万没想到", "没想到"
+};
+
+// 官方权威媒体
+const QStringList kOfficialSources = {
+    "人民日报", "新华社", "新华网", "央视", "CCTV", "中国日报",
+    "光明日报", "经济日报", "解放军报", "中国青年报", "中国纪检监察报",
+    "求是", "半月谈", "环球时报", "参考消息", "中国政府网",
+    "人民网", "央广网", "中国网", "中国新闻网", "学习强国",
+    "央视新闻", "人民政协网", "法制日报", "科技日报"
+};
+
+// ===== 分类词表 =====
+
+struct CategoryTable {
+    const char *category;
+    QStringList keywords;
+    QStringList dedicatedSources;  // 该分类的专属频道，来源命中即归入
+};
+
+const QVector<CategoryTable> &categoryTables()
+{
+    static const QVector<CategoryTable> tables = {
+        {"党建", {
+            "党委", "党组", "党建", "党员", "党代会", "党中央",
+            "从严治党", "纪检", "巡视", "反腐", "廉政", "作风建设",
+            "纪律检查", "主题教育", "基层党组织", "党员干部",
+            "民主集中制", "走群众路线", "组织建设",
+            "中纪委", "中组部", "中宣部", "中央统战部", "统战部",
+            "总书记", "政治局", "中央全会", "常委会",
+            "初心使命", "红色基因", "理论学习",
+            "马克思主义", "社会主义", "中国特色", "新时代"
+        }, {}},
+        {"经济", {
+            "经济", "财经", "金融", "产业", "消费", "投资",
+            "外贸", "货币", "税收", "就业", "GDP", "高质量发展",
+            "经济工作", "资本市场", "财政", "央行", "银行",
+            "股市", "债券", "通胀", "CPI", "PPI", "企业",
+            "市场", "制造业", "供应链", "商务"
+        }, {"人民网-财经"}},
+        {"外交", {
+            "外交", "外长", "外事", "使馆", "大使", "领事",
+            "峰会", "会晤", "双边", "多边", "联合国", "国际关系",
+            "命运共同体", "一带一路", "出访", "涉外",
+            "金砖", "上合组织", "东盟", "欧盟", "APEC",
+            "G20", "中美", "中俄", "中欧", "中非"
+        }, {"人民网-国际"}},
+        {"教育", {
+            "教育部", "高考", "职业教育", "学校", "大学", "高校",
+            "思政课", "科教兴国", "义务教育", "学生", "教师",
+            "人才培养", "素质教育", "教学", "课程", "研究生",
+            "学科", "招生", "学位", "考试", "教育改革",
+            "双减", "中小学", "幼儿园", "托育",
+            "产教融合", "学术", "科研", "实验室"
+        }, {"人民网-教育", "中国教育报"}},
+        {"科技", {
+            "科技", "创新", "技术", "人工智能", "AI", "芯片",
+            "半导体", "航天", "卫星", "量子", "算力", "数字经济",
+            "互联网", "5G", "6G", "机器人", "研发", "专利",
+            "实验室", "探月", "深海", "大模型", "智能制造"
+        }, {}},
+        {"军事", {
+            "军事", "国防", "军队", "解放军", "武警", "演习",
+            "战备", "海军", "空军", "陆军", "导弹", "航母",
+            "军工", "国防部", "战机", "舰艇", "边防", "联演",
+            "实战", "战略支援", "无人机", "军演"
+        }, {"人民网-军事", "中国军网"}}
+    };
+    return tables;
+}
+
+// 专属频道命中的权重：远高于单个关键词，保证来源优先
+constexpr int kDedicatedSourceWeight = 100;
+
+} // namespace
+
+// ===== KeywordAutomaton =====
+
+KeywordAutomaton::KeywordAutomaton()
+    : m_built(false)
+{
+    m_nodes.append(Node());  // 根节点
+}
+
+int KeywordAutomaton::addPattern(const QString &pattern)
+{
+    Q_ASSERT(!m_built);
+    if (pattern.isEmpty()) {
+        return -1;
+    }
+
+    int node = 0;
+    for (const QChar ch : pattern) {
+        const char16_t c = foldChar(ch);
+        int next = child(node, c);
+        if (next < 0) {
+            next = m_nodes.size();
+            m_nodes.append(Node());
+            m_edges.insert(edgeKey(node, c), next);
+        }
+        node = next;
+    }
+
+    if (m_nodes[node].output < 0) {
+        m_nodes[node].output = m_patterns.size();
+        m_patterns.append(pattern);
+    }
+    return m_nodes[node].output;
+}
+
+void KeywordAutomaton::build()
+{
+    // 按层（BFS）计算失配指针：子节点的失配指针由父节点的失配链推出
+    QVector<QVector<QPair<char16_t, int>>> children(m_nodes.size());
+    for (auto it = m_edges.constBegin(); it != m_edges.constEnd(); ++it) {
+        const int parent = int(it.key() >> 16);
+        children[parent].append(qMakePair(char16_t(it.key() & 0xFFFF), it.value()));
+    }
+
+    QQueue<int> queue;
+    for (const auto &edge : children[0]) {
+        m_nodes[edge.second].fail = 0;
+        m_nodes[edge.second].outputLink = 0;
+        queue.enqueue(edge.second);
+    }
+
+    while (!queue.isEmpty()) {
+        const int node = queue.dequeue();
+        for (const auto &edge : children[node]) {
+            const char16_t c = edge.first;
+            const int next = edge.second;
+
+            int f = m_nodes[node].fail;
+            int target = child(f, c);
+            while (target < 0 && f != 0) {
+                f = m_nodes[f].fail;
+                target = child(f, c);
+            }
+            const int fail = (target >= 0 && target != next) ? target : 0;
+            m_nodes[next].fail = fail;
+            m_nodes[next].outputLink = m_nodes[fail].output >= 0 ? fail : m_nodes[fail].outputLink;
+            queue.enqueue(next);
+        }
+    }
+
+    m_built = true;
+}
+
+void KeywordAutomaton::scan(const QString &text,
+                            const std::function<void(int patternId, int end)> &onMatch) const
+{
+    Q_ASSERT(m_built);
+    const QChar *s = text.constData();
+    const int n = text.size();
+
+    int state = 0;
+    for (int i = 0; i < n; ++i) {
+        const char16_t c = foldChar(s[i]);
+        int next = child(state, c);
+        while (next < 0 && state != 0) {
+            state = m_nodes[state].fail;
+            next = child(state, c);
+        }
+        state = next < 0 ? 0 : next;
+
+        for (int out = m_nodes[state].output >= 0 ? state : m_nodes[state].outputLink;
+             out != 0; out = m_nodes[out].outputLink) {
+            onMatch(m_nodes[out].output, i + 1);
+        }
+    }
+}
+
+// ===== NewsKeywordClassifier =====
+
+const NewsKeywordClassifier &NewsKeywordClassifier::instance()
+{
+    static const NewsKeywordClassifier classifier;
+    return classifier;
+}
+
+NewsKeywordClassifier::NewsKeywordClassifier()
+{
+    addTable(Group::Exclude, QString(), 1, kExcludeKeywords);
+    addTable(Group::Political, QString(), 3, kLeaderKeywords);
+    addTable(Group::Political, QString(), 2, kInstitutionKeywords);
+    addTable(Group::Political, QString(), 1, kPolicyKeywords);
+    addTable(Group::OfficialSource, QString(), 1, kOfficialSources);
+
+    for (const CategoryTable &table : categoryTables()) {
+        const QString category = QString::fromUtf8(table.category);
+        m_categories.append(category);
+        addTable(Group::Category, category, 1, table.keywords);
+        addTable(Group::DedicatedSource, category, kDedicatedSourceWeight, table.dedicatedSources);
+    }
+
+    m_automaton.build();
+}
+
+void NewsKeywordClassifier::addTable(Group group, const QString &category, int weight,
+                                     const QStringList &keywords)
+{
+    int fieldMask = 0;
+    switch (group) {
+    case Group::Exclude:
+    case Group::Political:
+        fieldMask = FieldTitle | FieldSummary;
+        break;
+    case Group::Category:
+        fieldMask = FieldTitle | FieldSummary | FieldContent | FieldKeywords;
+        break;
+    case Group::OfficialSource:
+    case Group::DedicatedSource:
+        fieldMask = FieldSource;
+        break;
+    }
+
+    for (const QString &keyword : keywords) {
+        const int patternId = m_automaton.addPattern(keyword);
+        if (patternId < 0) {
+            continue;
+        }
+        if (patternId >= m_entriesByPattern.size()) {
+            m_entriesByPattern.resize(patternId + 1);
+        }
+
+        // 同一分组/分类内的重复关键词只保留一条
+        bool duplicate = false;
+        for (int entryIndex : m_entriesByPattern.at(patternId)) {
+            const Entry &existing = m_entries.at(entryIndex);
+            if (existing.group == group && existing.category == category) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (duplicate) {
+            continue;
+        }
+
+        m_entriesByPattern[patternId].append(m_entries.size());
+        m_entries.append({group, category, weight, fieldMask});
+    }
+}
+
+NewsClassification NewsKeywordClassifier::classify(const NewsItem &item) const
+{
+    NewsClassification result;
+    QVector<bool> seen(m_entries.size(), false);
+
+    auto scanField = [&](const QString &text, int field) {
+        if (text.isEmpty()) {
+            return;
+        }
+        m_automaton.scan(text, [&](int patternId, int /*end*/) {
+            for (int entryIndex : m_entriesByPattern.at(patternId)) {
+                const Entry &entry = m_entries.at(entryIndex);
+                if (!(entry.fieldMask & field) || seen.at(entryIndex)) {
+                    continue;
+                }
+                seen[entryIndex] = true;
+
+                const QString &keyword = m_automaton.pattern(patternId);
+                result.matches.append({keyword, entry.group, entry.category, entry.weight});
+
+                switch (entry.group) {
+                case Group::Exclude:
+                    if (result.excludedBy.isEmpty()) {
+                        result.excludedBy = keyword;
+                    }
+                    break;
+                case Group::Political:
+                    if (result.politicalKeyword.isEmpty()) {
+                        result.politicalKeyword = keyword;
+                    }
+                    break;
+                case Group::OfficialSource:
+                    result.officialSource = true;
+                    break;
+                case Group::Category:
+                case Group::DedicatedSource:
+                    result.categoryScores[entry.category] += entry.weight;
+                    break;
+                }
+            }
+        });
+    };
+
+    scanField(item.title, FieldTitle);
+    scanField(item.summary, FieldSummary);
+    scanField(item.content, FieldContent);
+    for (const QString &keyword : item.keywords) {
+        scanField(keyword, FieldKeywords);
+    }
+    scanField(item.source, FieldSource);
+
+    return result;
+}
+
+// 筛选思政类新闻 - 严格过滤社会类新闻
+QList<NewsItem> NewsKeywordClassifier::filterPolitical(const QList<NewsItem> &items) const
+{
+    QList<NewsItem> filtered;
+
+    for (const NewsItem &item : items) {
+        const NewsClassification result = classify(item);
+
+        // 第一步：严格排除社会新闻（优先级最高）
+        if (result.isExcluded()) {
+            qDebug() << "[NewsKeywordClassifier] 排除社会新闻:" << item.title.left(30)
+                     << " (关键词:" << result.excludedBy << ")";
+            continue;
+        }
+
+        // 第二步：时政关键词 OR 官方权威媒体
+        if (result.isPolitical() || result.officialSource) {
+            filtered.append(item);
+            qDebug() << "[NewsKeywordClassifier] 保留时政新闻:" << item.title.left(40)
+                     << " (关键词:" << result.politicalKeyword << " 官媒:" << result.officialSource << ")";
+        } else {
+            qDebug() << "[NewsKeywordClassifier] 过滤非时政:" << item.title.left(40);
+        }
+    }
+
+    qDebug() << "[NewsKeywordClassifier] 时政热点筛选完成: 原" << items.size()
+             << "条 → 筛选后" << filtered.size() << "条";
+    return filtered;
+}
@@ -0,0 +1,128 @@
+#ifndef NEWSKEYWORDCLASSIFIER_H
+#define NEWSKEYWORDCLASSIFIER_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+#include "NewsItem.h"
+
+struct NewsClassification;
+
+/**
+ * @brief 多模式关键词自动机（Aho–Corasick）
+ *
+ * 所有模式按 Unicode 大小写折叠后插入字典树，构建失配指针和输出链接后，
+ * 对任意文本只需从左到右扫描一遍即可找出全部命中的模式。
+ * 构建完成后只读，可在多线程中并发扫描。
+ */
+class KeywordAutomaton
+{
+public:
+    KeywordAutomaton();
+
+    // 添加模式，返回模式编号；折叠后相同的模式返回同一编号
+    int addPattern(const QString &pattern);
+    void build();
+
+    int patternCount() const { return m_patterns.size(); }
+    const QString &pattern(int id) const { return m_patterns.at(id); }
+
+    // 回调参数：模式编号、命中结束位置（不含）
+    void scan(const QString &text, const std::function<void(int patternId, int end)> &onMatch) const;
+
+private:
+    struct Node {
+        int fail = 0;
+        int output = -1;     // 以该节点结尾的模式编号
+        int outputLink = 0;  // 失配链上下一个有输出的节点，0 表示没有
+    };
+
+    static quint64 edgeKey(int node, char16_t c) { return (quint64(node) << 16) | c; }
+    int child(int node, char16_t c) const { return m_edges.value(edgeKey(node, c), -1); }
+
+    QVector<Node> m_nodes;
+    QHash<quint64, int> m_edges;  // (节点, 字符) -> 子节点，所有节点共用一张表
+    QVector<QString> m_patterns;
+    bool m_built;
+};
+
+/**
+ * @brief 新闻关键词分类器
+ *
+ * 将时政筛选用的排除词/时政词/官方媒体，以及各分类（党建、经济……）的关键词表
+ * 编译进同一个自动机。每条新闻的各字段只扫描一遍，得到全部命中的关键词
+ * 及其分组、分类和权重，时政筛选与分类打分共用这一次扫描的结果。
+ *
+ * 用法：
+ *   const NewsClassification c = NewsKeywordClassifier::instance().classify(item);
+ *   if (!c.isExcluded() && (c.isPolitical() || c.officialSource)) { ... }
+ *   if (c.categoryScore("经济") > 0) { ... }
+ */
+class NewsKeywordClassifier
+{
+public:
+    enum class Group {
+        Exclude,          // 社会/娱乐类排除词（标题 + 摘要）
+        Political,        // 时政关键词（标题 + 摘要）
+        OfficialSource,   // 官方媒体（来源）
+        Category,         // 分类关键词（标题 + 摘要 + 正文 + 标签）
+        DedicatedSource   // 分类专属频道（来源），直接归入该分类
+    };
+
+    struct Match {
+        QString keyword;
+        Group group;
+        QString category;  // 仅 Category / DedicatedSource 有值
+        int weight;
+    };
+
+    static const NewsKeywordClassifier &instance();
+
+    // 扫描新闻各字段，返回分类结果
+    NewsClassification classify(const NewsItem &item) const;
+
+    // 时政热点筛选：先排除社会/娱乐新闻，再保留命中时政词或来自官方媒体的
+    QList<NewsItem> filterPolitical(const QList<NewsItem> &items) const;
+
+    // 有关键词表的分类
+    QStringList keywordCategories() const { return m_categories; }
+    bool hasCategory(const QString &category) const { return m_categories.contains(category); }
+
+private:
+    NewsKeywordClassifier();
+
+    struct Entry {
+        Group group;
+        QString category;
+        int weight;
+        int fieldMask;
+    };
+
+    void addTable(Group group, const QString &category, int weight, const QStringList &keywords);
+
+    KeywordAutomaton m_automaton;
+    QVector<QVector<int>> m_entriesByPattern;  // 模式编号 -> 条目下标
+    QVector<Entry> m_entries;
+    QStringList m_categories;
+};
+
+/**
+ * @brief 单条新闻的分类结果
+ */
+struct NewsClassification {
+    QVector<NewsKeywordClassifier::Match> matches;  // 按命中顺序，每个关键词只记一次
+    QString excludedBy;        // 第一个命中的排除词
+    QString politicalKeyword;  // 第一个命中的时政词
+    bool officialSource = false;
+    QHash<QString, int> categoryScores;  // 分类 -> 权重和
+
+    bool isExcluded() const { return !excludedBy.isEmpty(); }
+    bool isPolitical() const { return !politicalKeyword.isEmpty(); }
+    int categoryScore(const QString &category) const { return categoryScores.value(category, 0); }
+};
+
+#endif // NEWSKEYWORDCLASSIFIER_H
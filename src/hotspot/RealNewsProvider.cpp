@@ -1,6 +1,8 @@
 #include "RealNewsProvider.h"
 #include "../config/AppConfig.h"
 #include "NewsCategoryUtils.h"
+#include "NewsKeywordClassifier.h"
+#include "NewsCache.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
@@ -16,6 +18,11 @@
 
 namespace {
 
+// 各数据源的新鲜期：期内直接复用磁盘缓存，过期后先展示旧数据再后台刷新
+constexpr int kTianXingTtlSecs = 15 * 60;  // 天行有调用额度，不宜刷新过勤
+constexpr int kNeteaseTtlSecs = 5 * 60;    // 网易频道更新最快
+constexpr int kRssTtlSecs = 30 * 60;       // 人民网/BBC RSS 更新频率低
+
 QString decodeHtmlEntities(QString value)
 {
     value = value.trimmed();
@@ -131,8 +138,8 @@ RealNewsProvider::RealNewsProvider(QObject *parent)
     : INewsProvider(parent)
     , m_networkManager(new QNetworkAccessManager(this))
     , m_dataSource(DataSource::TianXing)  // 默认使用天行 API（数据最新）
-    , m_pendingRSSCount(0)
-    , m_pendingTianXingCount(0)
+    , m_newsCache(new NewsCache(NewsCache::defaultFilePath(), this))
+    , m_pendingSourceCount(0)
     , m_activeRequestId(0)
     , m_shouldFallbackToRSS(false)
     , m_rssFallbackInProgress(false)
@@ -162,14 +169,12 @@ void RealNewsProvider::fetchHotNews(int limit, const QString &category)
     ++m_activeRequestId;
     m_currentLimit = limit;
     m_currentCategory = NewsCategoryUtils::normalizeCategory(category);
-    m_aggregatedNews.clear();
-    m_pendingRSSCount = 0;
-    m_pendingTianXingCount = 0;
+    m_aggregator.clear();
+    m_lastPublishedIds.clear();
+    m_pendingSourceCount = 0;
     m_shouldFallbackToRSS = false;
     m_rssFallbackInProgress = false;
 
-    emit loadingStarted();
-
     // 根据分类智能选择数据源
     // 国际新闻 → BBC RSS（有图片）
     // 国内新闻 → 天行 API（数据最新，来源为人民日报/新华社/央视等官媒）
@@ -207,7 +212,7 @@ void RealNewsProvider::fetchFromTouTiao()
             QList<NewsItem> items = parseTouTiaoResponse(data);
 
             // 筛选思政类新闻，过滤社会新闻
-            items = filterPoliticalNews(items);
+            items = NewsKeywordClassifier::instance().filterPolitical(items);
 
             if (!items.isEmpty()) {
                 // 限制数量
@@ -232,144 +237,6 @@ void RealNewsProvider::fetchFromTouTiao()
     });
 }
 
-// 筛选思政类新闻 - 严格过滤社会类新闻
-QList<NewsItem> RealNewsProvider::filterPoliticalNews(const QList<NewsItem> &items)
-{
-    // 时政热点关键词 - 党政、理论、政策、领导人、重要会议等
-    static const QStringList politicalKeywords = {
-        // 领导人
-        "习近平", "李强", "赵乐际", "王沪宁", "蔡奇", "丁薛祥", "李希",
-        "总书记", "国家主席", "总理", "委员长", "政协主席", "国家副主席",
-        // 机构
-        "中央", "国务院", "全国人大", "全国政协", "中纪委", "中组部",
-        "外交部", "国防部", "发改委", "教育部", "科技部", "工信部",
-        "公安部", "民政部", "司法部", "财政部", "人社部", "自然资源部",
-        "生态环境部", "住建部", "交通运输部", "水利部", "农业农村部",
-        "商务部", "文旅部", "卫健委", "退役军人部", "应急管理部",
-        "中国人民银行", "审计署", "国资委", "海关总署", "税务总局",
-        "市场监管", "广电总局", "体育总局", "统计局", "医保局",
-        // 会议活动
-        "两会", "党代会", "中央全会", "政治局", "常委会", "座谈会",
-        "工作会议", "中央经济", "深改委", "国家安全", "中央财经",
-        // 政策理论
-        "改革", "政策", "法治", "依法治国", "从严治党", "党建",
-        "思想政治", "意识形态", "马克思", "社会主义", "新时代",
-        "中国特色", "现代化", "高质量发展", "共同富裕", "乡村振兴",
-        "一带一路", "双循环", "碳达峰", "碳中和", "数字中国",
-        // 外交国防
-        "外交", "国防", "军队", "解放军", "武警", "国际关系",
-        "中美", "中俄", "中欧", "台湾", "港澳", "统一",
-        // 其他时政
-        "省委", "市委", "党委", "人大代表", "政协委员",
-        "纪检", "巡视", "反腐", "廉政", "作风建设",
-        // 补充：经济、科技政策相关
-        "经济工作", "金融监管", "科技创新", "产业政策", "区域发展"
-    };
-
-    // 社会新闻排除关键词 - 严格过滤（老王加强版）
-    static const QStringList excludeKeywords = {
-        // 事故灾难类
-        "车祸", "事故", "坠楼", "跳楼", "自杀", "凶杀", "命案", "火灾",
-        "爆炸", "塌方", "坍塌", "伤亡", "遇难", "死亡", "身亡", "溺水",
-        "触电", "中毒", "煤气", "意外", "惨剧",
-        // 犯罪类
-        "骗子", "诈骗", "盗窃", "抢劫", "绑架", "失踪", "贩毒", "贪污",
-        "偷窃", "强奸", "猥亵", "杀人", "杀害", "谋杀", "行凶", "砍人",
-        "报警", "逮捕", "抓捕", "犯罪", "嫌疑人", "作案", "案件", "刑事",
-        // 娱乐八卦类
-        "出轨", "离婚", "小三", "婆媳", "家暴", "吵架", "恋情", "分手",
-        "网红", "明星", "八卦", "绯闻", "整容", "炫富", "豪宅", "豪车",
-        "结婚", "订婚", "热恋", "复合", "前夫", "前妻", "恋爱",
-        // 博彩赌博类
-        "彩票", "赌博", "酒驾", "醉驾", "超速", "违章", "中奖", "博彩",
-        // 生活娱乐类
-        "宠物", "萌宠", "吃播", "减肥", "健身", "美食", "旅游",
-        "直播", "带货", "网购", "团购", "探店", "打卡", "测评",
-        // 社会琐事类
-        "吵架", "口角", "纠纷", "邻居", "停车", "物业", "业主",
-        "打架", "斗殴", "聚众", "闹事", "争执", "争吵", "冲突",
-        // 奇闻异事类
-        "路人", "围观", "现场", "目击", "爆料", "曝光", "揭秘",
-        "惊现", "惊人", "震惊", "吓人", "离奇", "诡异", "诡异",
-        "奇葩", "奇怪", "罕见", "罕见", "匪夷所思", "不可思议",
-        // 医疗健康类（个人案例）
-        "患者", "病人", "手术", "肿瘤", "癌症", "确诊", "治疗", "医院",
-        // 消费维权类（个案）
-        "投诉", "维权", "退款", "赔偿", "索赔", "质量问题", "假冒",
-        // 家庭矛盾类
-        "继母", "继父", "婆婆", "儿媳", "女婿", "岳父", "岳母",
-        // 情感故事类
-        "表白", "求婚", "情侣", "夫妻", "相亲", "约会", "男友", "女友",
-        // 校园社会类（非教育政策）
-        "学生打架", "校园霸凌", "师生冲突", "早恋",
-        // 其他社会八卦
-        "网友热议", "引发热议", "网传", "有人", "某男", "某女",
-        "一男子", "一女子", "男童", "女童", "老人", "老太",
-        // 标题党关键词
-        "太", "竟然", "居然", "竟", "万万没想到", "没想到"
-    };
-
-    QList<NewsItem> filtered;
-
-    // 官方权威媒体列表 - 扩充更多官媒
-    static const QStringList officialSources = {
-        "人民日报", "新华社", "新华网", "央视", "CCTV", "中国日报",
-        "光明日报", "经济日报", "解放军报", "中国青年报", "中国纪检监察报",
-        "求是", "半月谈", "环球时报", "参考消息", "中国政府网",
-        "人民网", "央广网", "中国网", "中国新闻网", "学习强国",
-        "央视新闻", "新华社", "人民政协网", "法制日报", "科技日报"
-    };
-
-    for (const NewsItem &item : items) {
-        QString text = item.title + " " + item.summary;
-
-        // 第一步：严格排除社会新闻（优先级最高）
-        bool excluded = false;
-        for (const QString &keyword : excludeKeywords) {
-            if (text.contains(keyword, Qt::CaseInsensitive)) {
-                excluded = true;
-                qDebug() << "[RealNewsProvider] 排除社会新闻:" << item.title.left(30)
-                         << " (关键词:" << keyword << ")";
-                break;
-            }
-        }
-        if (excluded) continue;
-
-        // 第二步：检查是否包含时政关键词
-        bool isPolitical = false;
-        QString matchedKeyword;
-        for (const QString &keyword : politicalKeywords) {
-            if (text.contains(keyword, Qt::CaseInsensitive)) {
-                isPolitical = true;
-                matchedKeyword = keyword;
-                break;
-            }
-        }
-
-        // 第三步：检查来源是否是官方权威媒体（补充筛选）
-        bool isOfficialSource = false;
-        for (const QString &source : officialSources) {
-            if (item.source.contains(source, Qt::CaseInsensitive)) {
-                isOfficialSource = true;
-                break;
-            }
-        }
-
-        // 通过条件：必须同时满足 (时政关键词 OR 官方媒体) 且不包含排除关键词
-        if (isPolitical || isOfficialSource) {
-            filtered.append(item);
-            qDebug() << "[RealNewsProvider] 保留时政新闻:" << item.title.left(40)
-                     << " (关键词:" << matchedKeyword << " 官媒:" << isOfficialSource << ")";
-        } else {
-            qDebug() << "[RealNewsProvider] 过滤非时政:" << item.title.left(40);
-        }
-    }
-
-    qDebug() << "[RealNewsProvider] 时政热点筛选完成: 原" << items.size()
-             << "条 → 筛选后" << filtered.size() << "条";
-    return filtered;
-}
-
 QList<NewsItem> RealNewsProvider::parseTouTiaoResponse(const QByteArray &data)
 {
     QList<NewsItem> items;
@@ -489,7 +356,7 @@ void RealNewsProvider::fetchFromTouTiaoHotBoard()
             QList<NewsItem> items = parseTouTiaoHotBoardResponse(data);
 
             // 同样需要筛选时政新闻！
-            items = filterPoliticalNews(items);
+            items = NewsKeywordClassifier::instance().filterPolitical(items);
 
             if (!items.isEmpty()) {
                 if (items.size() > m_currentLimit) {
@@ -661,7 +528,7 @@ QList<NewsItem> RealNewsProvider::parseHanXiaoHanResponse(const QByteArray &data
 void RealNewsProvider::fetchFromTianXing(int limit, const QString &category)
 {
     const quint64 requestId = m_activeRequestId;
-    m_aggregatedNews.clear();
+    m_aggregator.clear();
     m_shouldFallbackToRSS = false;
     m_rssFallbackInProgress = false;
 
@@ -758,11 +625,35 @@ void RealNewsProvider::fetchFromTianXing(int limit, const QString &category)
         }
     }
 
-    m_pendingTianXingCount = plans.size();
+    // 先用磁盘缓存预填：新鲜的源不再请求，过期的源先展示旧数据、后台重新验证
+    QList<int> staleRanks;
+    QVector<QString> cacheKeys(plans.size());
+    for (int rank = 0; rank < plans.size(); ++rank) {
+        const FetchPlan &plan = plans.at(rank);
+        QString cacheKey;
+        int ttlSecs = kRssTtlSecs;
+        switch (plan.source) {
+        case TianXingAPI:    cacheKey = "tianxing:" + plan.endpoint; ttlSecs = kTianXingTtlSecs; break;
+        case NeteaseChannel: cacheKey = "netease:" + plan.endpoint;  ttlSecs = kNeteaseTtlSecs;  break;
+        case BBCRSS:         cacheKey = "bbc:" + plan.endpoint; break;
+        case PeopleRSS:      cacheKey = "people:" + plan.rssUrl; break;
+        }
+        cacheKeys[rank] = cacheKey;
+        if (!seedFromCache(cacheKey, rank, ttlSecs, plan.count)) {
+            staleRanks.append(rank);
+        }
+    }
+
+    m_pendingSourceCount = staleRanks.size();
     qDebug() << "[RealNewsProvider] 分类:" << (category.isEmpty() ? "全部" : category)
-             << "共" << plans.size() << "个数据源请求";
+             << "共" << plans.size() << "个数据源，需重新拉取" << staleRanks.size() << "个";
+
+    beginAggregation();
+
+    for (int rank : staleRanks) {
+        const FetchPlan plan = plans.at(rank);
+        const QString cacheKey = cacheKeys.at(rank);
 
-    for (const auto &plan : plans) {
         if (plan.source == BBCRSS) {
             // ---- BBC 中文 RSS ----
             QUrl url("https://feedx.net/rss/bbc.xml");
@@ -772,20 +663,17 @@ void RealNewsProvider::fetchFromTianXing(int limit, const QString &category)
             request.setTransferTimeout(20000);
 
             QNetworkReply *reply = m_networkManager->get(request);
-            connect(reply, &QNetworkReply::finished, this, [this, reply, plan, requestId]() {
-                if (requestId != m_activeRequestId) { reply->deleteLater(); return; }
-                if (reply->error() == QNetworkReply::NoError) {
-                    QByteArray data = reply->readAll();
-                    QList<NewsItem> items = parseRSSResponse(data, "BBC中文-国际");
-                    if (items.size() > plan.count) items = items.mid(0, plan.count);
-                    m_aggregatedNews.append(items);
+            connect(reply, &QNetworkReply::finished, this, [this, reply, plan, cacheKey, rank, requestId]() {
+                QList<NewsItem> items;
+                const bool ok = reply->error() == QNetworkReply::NoError;
+                if (ok) {
+                    items = parseRSSResponse(reply->readAll(), "BBC中文-国际");
                     qDebug() << "[RealNewsProvider] BBC RSS 获取成功，" << items.size() << "条";
                 } else {
                     qWarning() << "[RealNewsProvider] BBC RSS 请求失败:" << reply->errorString();
                 }
                 reply->deleteLater();
-                m_pendingTianXingCount--;
-                finalizeNewsAggregation();
+                acceptSourceResult(requestId, cacheKey, rank, items.mid(0, plan.count), ok);
             });
 
         } else if (plan.source == PeopleRSS) {
@@ -800,24 +688,23 @@ void RealNewsProvider::fetchFromTianXing(int limit, const QString &category)
             QString catLabel = plan.categoryLabel;
             int maxCount = plan.count;
             QNetworkReply *reply = m_networkManager->get(request);
-            connect(reply, &QNetworkReply::finished, this, [this, reply, srcName, catLabel, maxCount, requestId]() {
-                if (requestId != m_activeRequestId) { reply->deleteLater(); return; }
-                if (reply->error() == QNetworkReply::NoError) {
-                    QByteArray data = reply->readAll();
-                    QList<NewsItem> items = parseRSSResponse(data, srcName);
+            connect(reply, &QNetworkReply::finished, this,
+                    [this, reply, srcName, catLabel, maxCount, cacheKey, rank, requestId]() {
+                QList<NewsItem> items;
+                const bool ok = reply->error() == QNetworkReply::NoError;
+                if (ok) {
+                    items = parseRSSResponse(reply->readAll(), srcName);
                     // 设置分类标签
                     for (auto &item : items) {
                         item.category = catLabel;
                     }
                     if (items.size() > maxCount) items = items.mid(0, maxCount);
-                    m_aggregatedNews.append(items);
                     qDebug() << "[RealNewsProvider]" << srcName << "获取成功，" << items.size() << "条新闻";
                 } else {
                     qWarning() << "[RealNewsProvider]" << srcName << "请求失败:" << reply->errorString();
                 }
                 reply->deleteLater();
-                m_pendingTianXingCount--;
-                finalizeNewsAggregation();
+                acceptSourceResult(requestId, cacheKey, rank, items, ok);
             });
 
         } else if (plan.source == NeteaseChannel) {
@@ -834,21 +721,20 @@ void RealNewsProvider::fetchFromTianXing(int limit, const QString &category)
             int maxCount = plan.count;
             QString endpoint = plan.endpoint;
             QNetworkReply *reply = m_networkManager->get(request);
-            connect(reply, &QNetworkReply::finished, this, [this, reply, catLabel, maxCount, endpoint, requestId]() {
-                if (requestId != m_activeRequestId) { reply->deleteLater(); return; }
-                if (reply->error() == QNetworkReply::NoError) {
-                    QByteArray data = reply->readAll();
-                    QList<NewsItem> items = parseTouTiaoResponse(data);
+            connect(reply, &QNetworkReply::finished, this,
+                    [this, reply, catLabel, maxCount, endpoint, cacheKey, rank, requestId]() {
+                QList<NewsItem> items;
+                const bool ok = reply->error() == QNetworkReply::NoError;
+                if (ok) {
+                    items = parseTouTiaoResponse(reply->readAll());
                     for (auto &item : items) { item.category = catLabel; }
                     if (items.size() > maxCount) items = items.mid(0, maxCount);
-                    m_aggregatedNews.append(items);
                     qDebug() << "[RealNewsProvider] 网易" << endpoint << "频道获取成功，" << items.size() << "条";
                 } else {
                     qWarning() << "[RealNewsProvider] 网易" << endpoint << "频道请求失败:" << reply->errorString();
                 }
                 reply->deleteLater();
-                m_pendingTianXingCount--;
-                finalizeNewsAggregation();
+                acceptSourceResult(requestId, cacheKey, rank, items, ok);
             });
 
         } else {
@@ -865,19 +751,17 @@ void RealNewsProvider::fetchFromTianXing(int limit, const QString &category)
 
             QString endpoint = plan.endpoint;
             QNetworkReply *reply = m_networkManager->get(request);
-            connect(reply, &QNetworkReply::finished, this, [this, reply, endpoint, requestId]() {
-                if (requestId != m_activeRequestId) { reply->deleteLater(); return; }
-                if (reply->error() == QNetworkReply::NoError) {
-                    QByteArray data = reply->readAll();
-                    QList<NewsItem> items = parseTianXingResponse(data, endpoint);
-                    m_aggregatedNews.append(items);
+            connect(reply, &QNetworkReply::finished, this, [this, reply, endpoint, cacheKey, rank, requestId]() {
+                QList<NewsItem> items;
+                const bool ok = reply->error() == QNetworkReply::NoError;
+                if (ok) {
+                    items = parseTianXingResponse(reply->readAll(), endpoint);
                     qDebug() << "[RealNewsProvider] 天行" << endpoint << "获取成功，" << items.size() << "条";
                 } else {
                     qWarning() << "[RealNewsProvider] 天行" << endpoint << "请求失败:" << reply->errorString();
                 }
                 reply->deleteLater();
-                m_pendingTianXingCount--;
-                finalizeNewsAggregation();
+                acceptSourceResult(requestId, cacheKey, rank, items, ok);
             });
         }
     }
@@ -892,8 +776,10 @@ void RealNewsProvider::fetchFromRSS()
         return;
     }
 
-    m_aggregatedNews.clear();
-    m_pendingTianXingCount = 0;
+    m_aggregator.clear();
+    m_pendingSourceCount = 0;
+    // RSS 本身就是最后一级，返回空结果时不再兜底
+    m_rssFallbackInProgress = true;
 
     // 根据分类筛选要加载的 RSS 源
     QList<QPair<QString, QString>> sourcesToFetch;
@@ -922,64 +808,47 @@ void RealNewsProvider::fetchFromRSS()
     }
 
     if (sourcesToFetch.isEmpty()) {
+        m_rssFallbackInProgress = false;
         emit errorOccurred("没有适合该分类的 RSS 数据源");
         emit loadingFinished();
         return;
     }
 
-    m_pendingRSSCount = sourcesToFetch.size();
-    qDebug() << "[RealNewsProvider] 加载 RSS 源，分类:" << m_currentCategory << "源数量:" << m_pendingRSSCount;
+    QList<int> staleRanks;
+    for (int rank = 0; rank < sourcesToFetch.size(); ++rank) {
+        if (!seedFromCache("rss:" + sourcesToFetch.at(rank).second, rank, kRssTtlSecs, 0)) {
+            staleRanks.append(rank);
+        }
+    }
+
+    m_pendingSourceCount = staleRanks.size();
+    qDebug() << "[RealNewsProvider] 加载 RSS 源，分类:" << m_currentCategory
+             << "源数量:" << sourcesToFetch.size() << "需重新拉取:" << staleRanks.size();
+
+    beginAggregation();
+
+    for (int rank : staleRanks) {
+        const QString sourceName = sourcesToFetch.at(rank).first;
+        const QString cacheKey = "rss:" + sourcesToFetch.at(rank).second;
 
-    for (const auto &source : sourcesToFetch) {
-        QUrl url(source.second);
+        QUrl url(sourcesToFetch.at(rank).second);
         QNetworkRequest request(url);
         request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
         request.setRawHeader("User-Agent", "Mozilla/5.0 (compatible; AIPoliticalEducation/1.0)");
         request.setTransferTimeout(15000);
 
         QNetworkReply *reply = m_networkManager->get(request);
-        QString sourceName = source.first;
-
-        connect(reply, &QNetworkReply::finished, this, [this, reply, sourceName, requestId]() {
-            if (requestId != m_activeRequestId) {
-                reply->deleteLater();
-                return;
-            }
-
-            if (reply->error() == QNetworkReply::NoError) {
-                QByteArray data = reply->readAll();
-                QList<NewsItem> items = parseRSSResponse(data, sourceName);
-                m_aggregatedNews.append(items);
+        connect(reply, &QNetworkReply::finished, this, [this, reply, sourceName, cacheKey, rank, requestId]() {
+            QList<NewsItem> items;
+            const bool ok = reply->error() == QNetworkReply::NoError;
+            if (ok) {
+                items = parseRSSResponse(reply->readAll(), sourceName);
                 qDebug() << "[RealNewsProvider] RSS 源" << sourceName << "获取成功，" << items.size() << "条新闻";
             } else {
                 qWarning() << "[RealNewsProvider] RSS 获取失败:" << sourceName << reply->errorString();
             }
-
             reply->deleteLater();
-            m_pendingRSSCount--;
-
-            // 所有 RSS 源都处理完毕
-            if (m_pendingRSSCount <= 0) {
-                // 按时间排序
-                std::sort(m_aggregatedNews.begin(), m_aggregatedNews.end(),
-                          [](const NewsItem &a, const NewsItem &b) {
-                              return a.publishTime > b.publishTime;
-                          });
-
-                m_aggregatedNews = NewsCategoryUtils::filterNewsByCategory(m_aggregatedNews, m_currentCategory);
-
-                // 限制数量
-                if (m_aggregatedNews.size() > m_currentLimit) {
-                    m_aggregatedNews = m_aggregatedNews.mid(0, m_currentLimit);
-                }
-
-                m_rssFallbackInProgress = false;
-                m_cachedNews = m_aggregatedNews;
-                emit newsListReceived(m_aggregatedNews);
-                emit loadingFinished();
-
-                qDebug() << "[RealNewsProvider] RSS 新闻聚合完成，共" << m_aggregatedNews.size() << "条";
-            }
+            acceptSourceResult(requestId, cacheKey, rank, items, ok);
         });
     }
 }
@@ -1334,85 +1203,95 @@ void RealNewsProvider::refresh()
     fetchHotNews(m_currentLimit, m_currentCategory);
 }
 
-void RealNewsProvider::finalizeNewsAggregation()
+bool RealNewsProvider::seedFromCache(const QString &sourceKey, int rank, int ttlSecs, int maxCount)
 {
-    // 还有请求没完成，等着
-    if (m_pendingTianXingCount > 0) {
-        return;
+    const NewsCache::Entry cached = m_newsCache->entry(sourceKey);
+    if (!cached.isValid()) {
+        return false;
     }
 
-    const bool canUseLegacyRssFallback =
-        m_currentCategory.isEmpty() || m_currentCategory == "国内" || m_currentCategory == "国际";
+    QList<NewsItem> items = cached.items;
+    if (maxCount > 0 && items.size() > maxCount) {
+        items = items.mid(0, maxCount);
+    }
+    m_aggregator.setSource(sourceKey, rank, items);
 
-    if (m_aggregatedNews.isEmpty() && canUseLegacyRssFallback && !m_rssFallbackInProgress) {
-        qWarning() << "[RealNewsProvider] 天行聚合不完整，切换到 RSS 兜底，分类:" << m_currentCategory;
-        m_rssFallbackInProgress = true;
-        fetchFromRSS();
-        return;
+    const bool fresh = cached.ageSecs() < ttlSecs;
+    qDebug() << "[RealNewsProvider] 缓存" << sourceKey << items.size() << "条，"
+             << cached.ageSecs() << "秒前" << (fresh ? "（新鲜）" : "（过期，后台刷新）");
+    return fresh;
+}
+
+void RealNewsProvider::acceptSourceResult(quint64 requestId, const QString &sourceKey, int rank,
+                                          const QList<NewsItem> &items, bool succeeded)
+{
+    // 成功拿到的数据无论请求是否已被新请求取代都写入缓存，下次可直接复用
+    if (succeeded && !items.isEmpty()) {
+        m_newsCache->store(sourceKey, items);
     }
 
-    // 按发布时间排序（新的在前）
-    std::sort(m_aggregatedNews.begin(), m_aggregatedNews.end(),
-              [](const NewsItem &a, const NewsItem &b) {
-                  return a.publishTime > b.publishTime;
-              });
+    if (requestId != m_activeRequestId) {
+        return;
+    }
 
-    // 去重：基于 URL 和标题去重（避免多个源返回相同新闻）
-    static constexpr int TITLE_PREFIX_LENGTH = 30;
-    static constexpr int MIN_PREFIX_MATCH_LENGTH = 15;
+    // 失败或空结果时保留缓存预填的旧数据
+    if (succeeded && !items.isEmpty()) {
+        m_aggregator.setSource(sourceKey, rank, items);
+    }
 
-    QList<NewsItem> deduplicatedNews;
-    QSet<QString> seenUrls;
-    QSet<QString> seenTitles;
-    QSet<QString> seenPrefixes;
+    m_pendingSourceCount--;
+    finalizeNewsAggregation();
+}
 
-    for (const NewsItem &item : m_aggregatedNews) {
-        bool isDuplicate = false;
+void RealNewsProvider::beginAggregation()
+{
+    if (m_aggregator.isEmpty() && m_pendingSourceCount > 0) {
+        // 没有任何缓存可展示，才进入阻塞式加载状态
+        emit loadingStarted();
+        return;
+    }
+    finalizeNewsAggregation();
+}
 
-        QString normalizedTitle = item.title.simplified().toLower();
-        QString titlePrefix = normalizedTitle.left(TITLE_PREFIX_LENGTH);
+void RealNewsProvider::finalizeNewsAggregation()
+{
+    const QList<NewsItem> merged = m_aggregator.merged(m_currentCategory, m_currentLimit);
 
-        if (!item.url.isEmpty() && seenUrls.contains(item.url)) {
-            isDuplicate = true;
-            qDebug() << "[RealNewsProvider] 去重: URL重复 -" << item.title.left(40);
-        }
-        else if (seenTitles.contains(normalizedTitle)) {
-            isDuplicate = true;
-            qDebug() << "[RealNewsProvider] 去重: 标题重复 -" << item.title.left(40);
-        }
-        else if (titlePrefix.length() >= MIN_PREFIX_MATCH_LENGTH &&
-                 seenPrefixes.contains(titlePrefix)) {
-            isDuplicate = true;
-            qDebug() << "[RealNewsProvider] 去重: 前缀重复 -" << item.title.left(40);
-        }
+    QStringList mergedIds;
+    mergedIds.reserve(merged.size());
+    for (const NewsItem &item : merged) {
+        mergedIds.append(item.id);
+    }
 
-        if (!isDuplicate) {
-            deduplicatedNews.append(item);
-            if (!item.url.isEmpty()) {
-                seenUrls.insert(item.url);
-            }
-            seenTitles.insert(normalizedTitle);
-            if (normalizedTitle.length() >= TITLE_PREFIX_LENGTH) {
-                seenPrefixes.insert(titlePrefix);
-            }
+    // 还有请求没完成：先把已到的结果发出去，列表按 id 增量更新
+    if (m_pendingSourceCount > 0) {
+        if (!merged.isEmpty() && mergedIds != m_lastPublishedIds) {
+            m_lastPublishedIds = mergedIds;
+            m_cachedNews = merged;
+            emit newsListReceived(merged);
+            qDebug() << "[RealNewsProvider] 增量合并，当前" << merged.size()
+                     << "条，剩余" << m_pendingSourceCount << "个数据源";
         }
+        return;
     }
 
-    qDebug() << "[RealNewsProvider] 去重: 原" << m_aggregatedNews.size()
-             << "条 → 去重后" << deduplicatedNews.size() << "条";
-    m_aggregatedNews = deduplicatedNews;
-
-    m_aggregatedNews = NewsCategoryUtils::filterNewsByCategory(m_aggregatedNews, m_currentCategory);
+    const bool canUseLegacyRssFallback =
+        m_currentCategory.isEmpty() || m_currentCategory == "国内" || m_currentCategory == "国际";
 
-    // 限制数量
-    if (m_aggregatedNews.size() > m_currentLimit) {
-        m_aggregatedNews = m_aggregatedNews.mid(0, m_currentLimit);
+    if (merged.isEmpty() && canUseLegacyRssFallback && !m_rssFallbackInProgress) {
+        qWarning() << "[RealNewsProvider] 天行聚合不完整，切换到 RSS 兜底，分类:" << m_currentCategory;
+        m_rssFallbackInProgress = true;
+        fetchFromRSS();
+        return;
     }
 
     m_rssFallbackInProgress = false;
-    m_cachedNews = m_aggregatedNews;
-    emit newsListReceived(m_aggregatedNews);
+    m_cachedNews = merged;
+    if (mergedIds != m_lastPublishedIds || merged.isEmpty()) {
+        m_lastPublishedIds = mergedIds;
+        emit newsListReceived(merged);
+    }
     emit loadingFinished();
 
-    qDebug() << "[RealNewsProvider] 新闻聚合完成，共" << m_aggregatedNews.size() << "条";
+    qDebug() << "[RealNewsProvider] 新闻聚合完成，共" << merged.size() << "条";
 }
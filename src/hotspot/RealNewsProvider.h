@@ -2,10 +2,13 @@
 #define REALNEWSPROVIDER_H
 
 #include "INewsProvider.h"
+#include "NewsAggregator.h"
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 #include <QtGlobal>
 
+class NewsCache;
+
 /**
  * @brief 真实新闻提供者
  *
@@ -14,6 +17,10 @@
  * 2. 韩小韩 API - 免费热点新闻（无需Key）
  * 3. 天行数据 API - 综合新闻（需Key，图文不匹配）
  * 4. RSS 订阅 - 人民网、新华网（备用）
+ *
+ * 各数据源的结果按源写入磁盘缓存（NewsCache）并设有各自的新鲜期：
+ * 新鲜的源直接复用缓存，过期的源先用旧数据渲染，再在后台重新拉取；
+ * 每个源返回后立即合并并发出 newsListReceived，不必等最慢的源。
  */
 class RealNewsProvider : public INewsProvider {
     Q_OBJECT
@@ -64,8 +71,11 @@ private:
     void fetchFromTianXing(int limit, const QString &category);
     void fetchFromNeteaseChannel(const QString &channel, const QString &categoryLabel, int count);  // 网易新闻各频道
     void fetchFromRSS();
-    void finalizeNewsAggregation();  // 聚合完成后统一处理
-    QList<NewsItem> filterPoliticalNews(const QList<NewsItem> &items);  // 筛选思政新闻
+    bool seedFromCache(const QString &sourceKey, int rank, int ttlSecs, int maxCount);  // 缓存新鲜时返回 true
+    void acceptSourceResult(quint64 requestId, const QString &sourceKey, int rank,
+                            const QList<NewsItem> &items, bool succeeded);
+    void beginAggregation();  // 缓存预填完成后：有数据先渲染，否则进入加载状态
+    void finalizeNewsAggregation();  // 每个源返回后合并，全部返回后收尾
     QList<NewsItem> filterByKeywords(const QList<NewsItem> &items, const QStringList &keywords);
     QList<NewsItem> parseTouTiaoResponse(const QByteArray &data);  // 解析网易新闻
     QList<NewsItem> parseTouTiaoHotBoardResponse(const QByteArray &data);  // 解析今日头条热榜
@@ -82,10 +92,10 @@ private:
     // RSS 源列表: <名称, URL>
     QList<QPair<QString, QString>> m_rssSources;
 
-    // 待处理的 RSS 响应计数
-    int m_pendingRSSCount;
-    int m_pendingTianXingCount;  // 天行 API 请求计数
-    QList<NewsItem> m_aggregatedNews;
+    NewsCache *m_newsCache;
+    NewsAggregator m_aggregator;
+    int m_pendingSourceCount;  // 尚未返回的网络请求数
+    QStringList m_lastPublishedIds;  // 上次发出的列表，避免重复发同样的结果
     quint64 m_activeRequestId;
     bool m_shouldFallbackToRSS;
     bool m_rssFallbackInProgress;
@@ -8,8 +8,11 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDateTime>
+#include <QTimer>
 #include <iostream>
 #include "../config/AppConfig.h"
+#include "../utils/Metrics.h"
+#include "../utils/StartupProfiler.h"
 #include "../auth/login/simpleloginwindow.h"
 
 // 日志文件输出
@@ -86,8 +89,14 @@ void configureApplicationProxy()
 }
 }
 
+// 登录窗口首帧时间目标（毫秒），超出时输出警告便于发现启动回退
+static constexpr qint64 kLoginFirstFrameBudgetMs = 400;
+
 int main(int argc, char *argv[])
 {
+    StartupProfiler::instance().start();
+    StartupProfiler::instance().begin("app.init");
+
     QApplication app(argc, argv);
 
     // 设置日志文件（必须在 QApplication 构造之后）
@@ -104,6 +113,9 @@ int main(int argc, char *argv[])
     app.setOrganizationName("智慧教育科技有限公司");
     app.setOrganizationDomain("aiedu.com");
 
+    // 指标导出（按 METRICS_SUMMARY / METRICS_TRACE 配置，未配置时不做任何事）
+    new MetricsExporter(&app);
+
     // 设置应用程序样式
     app.setStyle(QStyleFactory::create("Fusion"));
 
@@ -150,12 +162,15 @@ int main(int argc, char *argv[])
 
     // 配置网络代理（从环境变量读取）
     configureApplicationProxy();
+    StartupProfiler::instance().end("app.init");
 
     qDebug() << "\n=== 应用启动 ===\n";
     std::cout << "应用启动" << std::endl;
 
     // 创建并显示登录窗口
+    StartupProfiler::instance().begin("login_window.construct");
     SimpleLoginWindow *loginWindow = new SimpleLoginWindow();
+    StartupProfiler::instance().end("login_window.construct");
     loginWindow->show();
     loginWindow->raise();
     loginWindow->activateWindow();
@@ -163,6 +178,19 @@ int main(int argc, char *argv[])
     qDebug() << "登录窗口已显示\n";
     std::cout << "登录窗口已显示" << std::endl;
 
+    // 事件循环处理完首个 paint 后记录启动耗时
+    QTimer::singleShot(0, &app, []() {
+        StartupProfiler::instance().mark("login_window.first_frame");
+        const qint64 elapsedMs = StartupProfiler::instance().markTime("login_window.first_frame");
+        if (elapsedMs > kLoginFirstFrameBudgetMs) {
+            qWarning() << "[Startup] 登录窗口首帧耗时" << elapsedMs << "ms，超出目标"
+                       << kLoginFirstFrameBudgetMs << "ms";
+        } else {
+            qDebug() << "[Startup] 登录窗口首帧耗时" << elapsedMs << "ms（目标"
+                     << kLoginFirstFrameBudgetMs << "ms）";
+        }
+    });
+
     // 运行事件循环
     return app.exec();
 }
@@ -1,16 +1,22 @@
 #include "NotificationService.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QDebug>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QUrl>
 #include <QUuid>
 
 NotificationService::NotificationService(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
-    , m_unreadCount(0)
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
+    , m_syncTimer(new QTimer(this))
     , m_isLoading(false)
 {
+    m_syncTimer->setInterval(SYNC_INTERVAL_MS);
+    connect(m_syncTimer, &QTimer::timeout, this, &NotificationService::fetchNotifications);
 }
 
 NotificationService::~NotificationService()
@@ -19,7 +25,50 @@ NotificationService::~NotificationService()
 
 void NotificationService::setCurrentUserId(const QString &userId)
 {
+    if (m_currentUserId == userId) return;
     m_currentUserId = userId;
+
+    // 上一个账号的同步请求作废，否则结果会写进新账号的存储
+    if (m_fetchReply) {
+        disconnect(m_fetchReply, nullptr, this, nullptr);
+        m_fetchReply->abort();
+        m_fetchReply->deleteLater();
+        m_fetchReply = nullptr;
+    }
+    if (m_isLoading) {
+        m_isLoading = false;
+        emit loadingStateChanged(false);
+    }
+
+    // 先展示本地存储的通知，再后台增量同步
+    m_store.load(storePath());
+    if (m_store.size() > 0) {
+        qDebug() << "[NotificationService] 本地通知" << m_store.size() << "条，未读" << m_store.unreadCount() << "条";
+        emit notificationsReceived(m_store.list());
+    }
+    fetchUnreadCount();
+
+    if (m_currentUserId.isEmpty()) {
+        m_syncTimer->stop();
+    } else {
+        m_syncTimer->start();
+    }
+}
+
+QString NotificationService::storePath() const
+{
+    // 用户 ID 可能是邮箱，文件名只保留安全字符
+    QString name = m_currentUserId;
+    name.replace(QRegularExpression("[^A-Za-z0-9_.@-]"), "_");
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + "/notifications/" + name + ".json";
+}
+
+void NotificationService::saveStore() const
+{
+    if (!m_currentUserId.isEmpty()) {
+        m_store.save(storePath());
+    }
 }
 
 QNetworkRequest NotificationService::createRequest(const QString &endpoint) const
@@ -33,15 +82,28 @@ void NotificationService::fetchNotifications()
         qWarning() << "[NotificationService] 用户ID未设置，无法获取通知";
         return;
     }
+    if (m_isLoading) return;
 
     m_isLoading = true;
     emit loadingStateChanged(true);
 
-    QString endpoint = QString("/rest/v1/notifications?receiver_id=eq.%1&order=created_at.desc&limit=50")
-                           .arg(m_currentUserId);
+    // 有游标时只拉取游标之后的通知（gte + 按 ID 去重，不会漏掉同一时刻的通知）
+    QString endpoint;
+    const QString cursor = m_store.syncCursor();
+    if (cursor.isEmpty()) {
+        endpoint = QString("/rest/v1/notifications?receiver_id=eq.%1&order=created_at.desc&limit=%2")
+                       .arg(m_currentUserId).arg(INITIAL_FETCH_LIMIT);
+    } else {
+        endpoint = QString("/rest/v1/notifications?receiver_id=eq.%1&created_at=gte.%2&order=created_at.asc&limit=%3")
+                       .arg(m_currentUserId,
+                            QString::fromLatin1(QUrl::toPercentEncoding(cursor)))
+                       .arg(SYNC_PAGE_LIMIT);
+    }
     QNetworkRequest request = createRequest(endpoint);
 
     QNetworkReply *reply = m_networkManager->get(request);
+    reply->setProperty("userId", m_currentUserId);
+    m_fetchReply = reply;
     connect(reply, &QNetworkReply::finished, this, &NotificationService::onFetchNotificationsFinished);
     connect(reply, &QNetworkReply::errorOccurred, this, &NotificationService::onNetworkError);
 }
@@ -50,14 +112,19 @@ void NotificationService::onFetchNotificationsFinished()
 {
     QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
     if (!reply) return;
+    if (reply->property("userId").toString() != m_currentUserId) {
+        reply->deleteLater();
+        return;
+    }
 
+    m_fetchReply = nullptr;
     m_isLoading = false;
     emit loadingStateChanged(false);
 
     if (reply->error() != QNetworkReply::NoError) {
         qWarning() << "[NotificationService] 获取通知失败:" << reply->errorString();
-        // 网络错误时使用示例数据
-        loadSampleNotifications();
+        // 网络错误且本地没有任何通知时使用示例数据
+        if (m_store.size() == 0) loadSampleNotifications();
         reply->deleteLater();
         return;
     }
@@ -67,39 +134,48 @@ void NotificationService::onFetchNotificationsFinished()
     QJsonDocument doc = QJsonDocument::fromJson(data, &parseError);
     if (parseError.error != QJsonParseError::NoError) {
         qWarning() << "[NotificationService] JSON 解析失败:" << parseError.errorString();
-        loadSampleNotifications();
+        if (m_store.size() == 0) loadSampleNotifications();
         reply->deleteLater();
         return;
     }
-    QJsonArray array = doc.array();
-
-    m_notifications.clear();
-    m_unreadCount = 0;
+    const QJsonArray array = doc.array();
+    const bool firstLoad = m_store.syncCursor().isEmpty();
 
+    int inserted = 0;
     for (const QJsonValue &val : array) {
-        Notification notification = Notification::fromJson(val.toObject());
-        m_notifications.append(notification);
-        if (!notification.isRead()) {
-            m_unreadCount++;
+        const QJsonObject obj = val.toObject();
+        const Notification notification = Notification::fromJson(obj);
+        const NotificationStore::Change change = m_store.upsert(notification, obj["created_at"].toString());
+        if (firstLoad) continue;
+        if (change == NotificationStore::Change::Inserted) {
+            ++inserted;
+            emit notificationInserted(notification);
+        } else if (change == NotificationStore::Change::Updated) {
+            emit notificationUpdated(notification);
         }
     }
 
-    // 如果没有获取到数据，使用示例数据
-    if (m_notifications.isEmpty()) {
-        loadSampleNotifications();
-    } else {
-        qDebug() << "[NotificationService] 获取通知成功，共" << m_notifications.size() << "条，未读" << m_unreadCount << "条";
-        emit notificationsReceived(m_notifications);
-        emit unreadCountChanged(m_unreadCount);
+    if (firstLoad) {
+        if (m_store.size() == 0) {
+            // 如果没有获取到数据，使用示例数据
+            loadSampleNotifications();
+        } else {
+            qDebug() << "[NotificationService] 获取通知成功，共" << m_store.size() << "条，未读" << m_store.unreadCount() << "条";
+            emit notificationsReceived(m_store.list());
+        }
+    } else if (inserted > 0) {
+        qDebug() << "[NotificationService] 增量同步新通知" << inserted << "条";
     }
 
+    if (!array.isEmpty()) saveStore();
+    fetchUnreadCount();
     reply->deleteLater();
 }
 
 void NotificationService::loadSampleNotifications()
 {
-    m_notifications.clear();
-    m_unreadCount = 0;
+    // 示例通知标记为本地通知：不落盘，不推进同步游标
+    QList<Notification> samples;
 
     // 示例通知数据
     Notification n1;
@@ -109,8 +185,7 @@ void NotificationService::loadSampleNotifications()
     n1.setContent("七年级(3)班 张小明 同学提交了《道德与法治》第一单元作业，请及时批改。");
     n1.setCreatedAt(QDateTime::currentDateTime().addSecs(-1800));  // 30分钟前
     n1.setIsRead(false);
-    m_notifications.append(n1);
-    m_unreadCount++;
+    samples.append(n1);
 
     Notification n2;
     n2.setId("sample-2");
@@ -119,8 +194,7 @@ void NotificationService::loadSampleNotifications()
     n2.setContent("AI智慧课堂系统已升级至v2.0版本，新增教案编辑器功能，支持AI一键生成教案。");
     n2.setCreatedAt(QDateTime::currentDateTime().addSecs(-7200));  // 2小时前
     n2.setIsRead(false);
-    m_notifications.append(n2);
-    m_unreadCount++;
+    samples.append(n2);
 
     Notification n3;
     n3.setId("sample-3");
@@ -129,8 +203,7 @@ void NotificationService::loadSampleNotifications()
     n3.setContent("2024-2025学年第一学期期中考试成绩已发布，请登录系统查看班级学情分析报告。");
     n3.setCreatedAt(QDateTime::currentDateTime().addSecs(-86400));  // 1天前
     n3.setIsRead(false);
-    m_notifications.append(n3);
-    m_unreadCount++;
+    samples.append(n3);
 
     Notification n4;
     n4.setId("sample-4");
@@ -139,7 +212,7 @@ void NotificationService::loadSampleNotifications()
     n4.setContent("八年级(1)班 李小红 同学申请病假2天（1月15日-1月16日），请审批。");
     n4.setCreatedAt(QDateTime::currentDateTime().addSecs(-172800));  // 2天前
     n4.setIsRead(true);
-    m_notifications.append(n4);
+    samples.append(n4);
 
     Notification n5;
     n5.setId("sample-5");
@@ -148,49 +221,50 @@ void NotificationService::loadSampleNotifications()
     n5.setContent("七年级(3)班有15名同学提交了《法律在我们身边》课后作业，提交率达到88%。");
     n5.setCreatedAt(QDateTime::currentDateTime().addSecs(-259200));  // 3天前
     n5.setIsRead(true);
-    m_notifications.append(n5);
+    samples.append(n5);
+
+    for (Notification &n : samples) {
+        n.setIsLocal(true);
+        m_store.upsert(n);
+    }
 
-    qDebug() << "[NotificationService] 加载示例通知，共" << m_notifications.size() << "条，未读" << m_unreadCount << "条";
-    emit notificationsReceived(m_notifications);
-    emit unreadCountChanged(m_unreadCount);
+    qDebug() << "[NotificationService] 加载示例通知，共" << m_store.size() << "条，未读" << m_store.unreadCount() << "条";
+    emit notificationsReceived(m_store.list());
+    fetchUnreadCount();
 }
 
 void NotificationService::fetchUnreadCount()
 {
-    if (m_currentUserId.isEmpty()) return;
-
-    QString endpoint = QString("/rest/v1/notifications?receiver_id=eq.%1&is_read=eq.false&select=count")
-                           .arg(m_currentUserId);
-    QNetworkRequest request = createRequest(endpoint);
-    request.setRawHeader("Prefer", "count=exact");
-
-    QNetworkReply *reply = m_networkManager->get(request);
-    connect(reply, &QNetworkReply::finished, this, &NotificationService::onFetchUnreadCountFinished);
+    // 未读数由本地存储维护，不再单独请求；只在变化时通知
+    const int count = m_store.unreadCount();
+    if (count != m_lastUnreadCount) {
+        m_lastUnreadCount = count;
+        emit unreadCountChanged(count);
+    }
 }
 
-void NotificationService::onFetchUnreadCountFinished()
+void NotificationService::applyReadLocally(const QStringList &ids)
 {
-    QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
-    if (!reply) return;
-
-    if (reply->error() == QNetworkReply::NoError) {
-        // Supabase返回的count在header里
-        QString countHeader = reply->rawHeader("content-range");
-        if (!countHeader.isEmpty()) {
-            // 格式: "0-9/42" 或 "*/42"
-            int slashIndex = countHeader.lastIndexOf('/');
-            if (slashIndex >= 0) {
-                m_unreadCount = countHeader.mid(slashIndex + 1).toInt();
-                emit unreadCountChanged(m_unreadCount);
-            }
+    bool changed = false;
+    for (const QString &id : ids) {
+        if (m_store.markRead(id)) {
+            changed = true;
+            emit notificationUpdated(m_store.value(id));
         }
     }
-
-    reply->deleteLater();
+    if (changed) {
+        saveStore();
+        fetchUnreadCount();
+    }
 }
 
 void NotificationService::markAsRead(const QString &notificationId)
 {
+    if (m_store.value(notificationId).isLocal()) {
+        applyReadLocally({notificationId});
+        return;
+    }
+
     QString endpoint = QString("/rest/v1/notifications?id=eq.%1").arg(notificationId);
     QNetworkRequest request = createRequest(endpoint);
 
@@ -210,17 +284,9 @@ void NotificationService::onMarkAsReadFinished()
     if (!reply) return;
 
     if (reply->error() == QNetworkReply::NoError) {
-        // 更新本地缓存
-        for (int i = 0; i < m_notifications.size(); ++i) {
-            if (m_notifications[i].id() == reply->property("notificationId").toString()) {
-                m_notifications[i].setIsRead(true);
-                break;
-            }
-        }
-        if (m_unreadCount > 0) {
-            m_unreadCount--;
-            emit unreadCountChanged(m_unreadCount);
-        }
+        const QString id = reply->property("notificationId").toString();
+        applyReadLocally({id});
+        emit notificationMarkedRead(id);
         qDebug() << "[NotificationService] 标记已读成功";
     }
 
@@ -240,16 +306,16 @@ void NotificationService::markAllAsRead()
     QByteArray data = QJsonDocument(body).toJson();
 
     QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", data);
-    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            // 更新本地缓存
-            for (int i = 0; i < m_notifications.size(); ++i) {
-                m_notifications[i].setIsRead(true);
+    const QString userId = m_currentUserId;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, userId]() {
+        if (reply->error() == QNetworkReply::NoError && userId == m_currentUserId) {
+            const QStringList changed = m_store.markAllRead();
+            for (const QString &id : changed) {
+                emit notificationUpdated(m_store.value(id));
             }
-            m_unreadCount = 0;
-            emit unreadCountChanged(0);
-            emit notificationsReceived(m_notifications);
-            qDebug() << "[NotificationService] 全部标记已读成功";
+            saveStore();
+            fetchUnreadCount();
+            qDebug() << "[NotificationService] 全部标记已读成功:" << changed.size() << "条";
         }
         reply->deleteLater();
     });
@@ -262,19 +328,10 @@ void NotificationService::deleteNotification(const QString &notificationId)
 
     QNetworkReply *reply = m_networkManager->deleteResource(request);
     connect(reply, &QNetworkReply::finished, this, [this, reply, notificationId]() {
-        if (reply->error() == QNetworkReply::NoError) {
-            // 从本地缓存移除
-            for (int i = 0; i < m_notifications.size(); ++i) {
-                if (m_notifications[i].id() == notificationId) {
-                    if (!m_notifications[i].isRead()) {
-                        m_unreadCount--;
-                        emit unreadCountChanged(m_unreadCount);
-                    }
-                    m_notifications.removeAt(i);
-                    break;
-                }
-            }
-            emit notificationsReceived(m_notifications);
+        if (reply->error() == QNetworkReply::NoError && m_store.remove(notificationId)) {
+            saveStore();
+            emit notificationRemoved(notificationId);
+            fetchUnreadCount();
         }
         reply->deleteLater();
     });
@@ -284,6 +341,9 @@ void NotificationService::onNetworkError(QNetworkReply::NetworkError error)
 {
     Q_UNUSED(error)
     QNetworkReply *reply = qobject_cast<QNetworkReply*>(sender());
+    if (reply && reply->property("userId").toString() != m_currentUserId) {
+        return;   // 已切换用户的旧请求
+    }
     if (reply) {
         QString errorMsg = reply->errorString();
         qWarning() << "[NotificationService] 网络错误:" << errorMsg;
@@ -310,17 +370,8 @@ void NotificationService::markBatchAsRead(const QStringList &notificationIds)
     QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", data);
     connect(reply, &QNetworkReply::finished, this, [this, reply, notificationIds]() {
         if (reply->error() == QNetworkReply::NoError) {
-            // 更新本地缓存
-            for (int i = 0; i < m_notifications.size(); ++i) {
-                if (notificationIds.contains(m_notifications[i].id())) {
-                    if (!m_notifications[i].isRead()) {
-                        m_notifications[i].setIsRead(true);
-                        if (m_unreadCount > 0) m_unreadCount--;
-                    }
-                }
-            }
-            emit unreadCountChanged(m_unreadCount);
-            emit notificationsReceived(m_notifications);
+            // 按 ID 直接定位，只更新状态有变化的行
+            applyReadLocally(notificationIds);
         } else {
             qWarning() << "[NotificationService] 批量标记已读失败:" << reply->errorString();
         }
@@ -342,12 +393,10 @@ void NotificationService::createLocalNotification(int type, const QString &title
     notification.setIsRead(false);
     notification.setIsLocal(true);
 
-    // 插入到列表头部
-    m_notifications.prepend(notification);
-    m_unreadCount++;
+    m_store.upsert(notification);
 
     qDebug() << "[NotificationService] 创建本地通知:" << title;
+    emit notificationInserted(notification);
     emit localNotificationCreated();
-    emit notificationsReceived(m_notifications);
-    emit unreadCountChanged(m_unreadCount);
+    fetchUnreadCount();
 }
@@ -4,12 +4,18 @@
 #include <QObject>
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
+#include <QPointer>
 #include <QTimer>
 #include "models/Notification.h"
+#include "NotificationStore.h"
 
 /**
  * @brief 通知服务层
  * 老王说：参考HotspotService模式，Supabase REST API一把梭
+ *
+ * 通知保存在本地 NotificationStore（按用户落盘），启动时先从本地展示，
+ * 之后按 created_at 游标增量同步（created_at=gte.<游标>，按 ID 去重），
+ * 每次变化发出单条的插入 / 更新 / 删除信号，界面只改对应的那一行。
  */
 class NotificationService : public QObject
 {
@@ -34,12 +40,22 @@ public:
     void setCurrentUserId(const QString &userId);
     QString currentUserId() const { return m_currentUserId; }
 
+    // 定时增量同步（设置用户后自动开始）
+    static constexpr int SYNC_INTERVAL_MS = 30 * 1000;
+    static constexpr int INITIAL_FETCH_LIMIT = 50;
+    static constexpr int SYNC_PAGE_LIMIT = 200;
+
     // 获取缓存的通知列表
-    QList<Notification> notifications() const { return m_notifications; }
-    int unreadCount() const { return m_unreadCount; }
+    QList<Notification> notifications() const { return m_store.list(); }
+    Notification notification(const QString &id) const { return m_store.value(id); }
+    int indexOf(const QString &id) const { return m_store.indexOf(id); }
+    int unreadCount() const { return m_store.unreadCount(); }
 
 signals:
-    void notificationsReceived(const QList<Notification> &notifications);
+    void notificationsReceived(const QList<Notification> &notifications);   // 整体替换（首次加载）
+    void notificationInserted(const Notification &notification);
+    void notificationUpdated(const Notification &notification);
+    void notificationRemoved(const QString &id);
     void unreadCountChanged(int count);
     void notificationMarkedRead(const QString &id);
     void batchMarkedAsRead(const QStringList &ids);
@@ -49,19 +65,23 @@ signals:
 
 private slots:
     void onFetchNotificationsFinished();
-    void onFetchUnreadCountFinished();
     void onMarkAsReadFinished();
     void onNetworkError(QNetworkReply::NetworkError error);
 
 private:
     QNetworkRequest createRequest(const QString &endpoint) const;
     void loadSampleNotifications();  // 加载示例通知数据
+    QString storePath() const;
+    void saveStore() const;
+    void applyReadLocally(const QStringList &ids);
 
     QNetworkAccessManager *m_networkManager;
     QString m_currentUserId;
-    QList<Notification> m_notifications;
-    int m_unreadCount = 0;
+    NotificationStore m_store;
+    QTimer *m_syncTimer;
+    int m_lastUnreadCount = -1;
     bool m_isLoading = false;
+    QPointer<QNetworkReply> m_fetchReply;   // 进行中的同步请求，切换用户时中止
 };
 
 #endif // NOTIFICATIONSERVICE_H
@@ -0,0 +1,165 @@
+#include "NotificationStore.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QDebug>
+#include <algorithm>
+
+// ===== 增删改 =====
+
+NotificationStore::Change NotificationStore::upsert(const Notification &notification, const QString &rawCreatedAt)
+{
+    if (!rawCreatedAt.isEmpty() && !notification.isLocal()) {
+        // 游标保留服务端原始字符串，避免解析后丢失微秒精度
+        const QDateTime time = notification.createdAt();
+        if (!m_syncCursorTime.isValid() || time > m_syncCursorTime) {
+            m_syncCursor = rawCreatedAt;
+            m_syncCursorTime = time;
+        }
+    }
+
+    auto it = m_byId.find(notification.id());
+    if (it == m_byId.end()) {
+        m_byId.insert(notification.id(), notification);
+        insertOrdered(notification.id(), notification.createdAt());
+        if (!notification.isRead()) ++m_unreadCount;
+        trim();
+        return Change::Inserted;
+    }
+
+    Notification &existing = it.value();
+    if (existing.isRead() == notification.isRead()
+        && existing.title() == notification.title()
+        && existing.content() == notification.content()) {
+        return Change::None;
+    }
+    if (existing.isRead() != notification.isRead()) {
+        m_unreadCount += notification.isRead() ? -1 : 1;
+    }
+    existing = notification;
+    return Change::Updated;
+}
+
+bool NotificationStore::markRead(const QString &id)
+{
+    auto it = m_byId.find(id);
+    if (it == m_byId.end() || it->isRead()) return false;
+    it->setIsRead(true);
+    --m_unreadCount;
+    return true;
+}
+
+QStringList NotificationStore::markAllRead()
+{
+    QStringList changed;
+    for (auto it = m_byId.begin(); it != m_byId.end(); ++it) {
+        if (!it->isRead()) {
+            it->setIsRead(true);
+            changed.append(it.key());
+        }
+    }
+    m_unreadCount = 0;
+    return changed;
+}
+
+bool NotificationStore::remove(const QString &id)
+{
+    auto it = m_byId.find(id);
+    if (it == m_byId.end()) return false;
+    if (!it->isRead()) --m_unreadCount;
+    m_byId.erase(it);
+    m_order.removeOne(id);
+    return true;
+}
+
+void NotificationStore::clear()
+{
+    m_byId.clear();
+    m_order.clear();
+    m_unreadCount = 0;
+    m_syncCursor.clear();
+    m_syncCursorTime = QDateTime();
+}
+
+void NotificationStore::insertOrdered(const QString &id, const QDateTime &createdAt)
+{
+    // 新通知几乎总是最新的，二分查找插入位置
+    auto pos = std::upper_bound(m_order.begin(), m_order.end(), createdAt,
+                                [this](const QDateTime &time, const QString &other) {
+        return time > m_byId.value(other).createdAt();
+    });
+    m_order.insert(pos, id);
+}
+
+void NotificationStore::trim()
+{
+    for (int i = m_order.size() - 1; i >= 0 && m_order.size() > MAX_STORED; --i) {
+        const Notification &n = m_byId[m_order[i]];
+        if (n.isRead()) {
+            m_byId.remove(m_order[i]);
+            m_order.removeAt(i);
+        }
+    }
+}
+
+// ===== 查询 =====
+
+QList<Notification> NotificationStore::list() const
+{
+    QList<Notification> result;
+    result.reserve(m_order.size());
+    for (const QString &id : m_order) {
+        result.append(m_byId.value(id));
+    }
+    return result;
+}
+
+int NotificationStore::indexOf(const QString &id) const
+{
+    return m_order.indexOf(id);
+}
+
+// ===== 持久化 =====
+
+bool NotificationStore::load(const QString &path)
+{
+    clear();
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    const QJsonArray items = root.value("notifications").toArray();
+    for (const QJsonValue &value : items) {
+        upsert(Notification::fromJson(value.toObject()));
+    }
+    m_syncCursor = root.value("cursor").toString();
+    m_syncCursorTime = QDateTime::fromString(m_syncCursor, Qt::ISODateWithMs);
+    return !m_byId.isEmpty();
+}
+
+void NotificationStore::save(const QString &path) const
+{
+    QJsonArray items;
+    for (const QString &id : m_order) {
+        const Notification &n = m_byId[id];
+        if (!n.isLocal()) items.append(n.toJson());
+    }
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[NotificationStore] 无法写入:" << path;
+        return;
+    }
+    file.write(QJsonDocument(QJsonObject{
+        {"version", 1},
+        {"cursor", m_syncCursor},
+        {"notifications", items}
+    }).toJson(QJsonDocument::Compact));
+    file.commit();
+}
@@ -0,0 +1,55 @@
+#ifndef NOTIFICATIONSTORE_H
+#define NOTIFICATIONSTORE_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "models/Notification.h"
+
+/**
+ * @brief 本地通知存储
+ *
+ * 按 ID 建索引，另维护一个按创建时间倒序的 ID 列表和未读计数，
+ * 插入、标记已读、删除都不需要扫描整个列表。
+ * 服务端通知持久化到本地文件（本地通知不落盘），并记录同步游标
+ * （已收到的最新 created_at 原始字符串），下次只增量拉取之后的通知。
+ */
+class NotificationStore
+{
+public:
+    enum class Change { None, Inserted, Updated };
+
+    static constexpr int MAX_STORED = 500;   // 超出后丢弃最旧的已读通知
+
+    Change upsert(const Notification &notification, const QString &rawCreatedAt = QString());
+    bool markRead(const QString &id);
+    QStringList markAllRead();               // 返回状态有变化的 ID
+    bool remove(const QString &id);
+    void clear();
+
+    bool contains(const QString &id) const { return m_byId.contains(id); }
+    Notification value(const QString &id) const { return m_byId.value(id); }
+    QList<Notification> list() const;        // 新的在前
+    int indexOf(const QString &id) const;    // 在 list() 中的位置
+    int size() const { return m_order.size(); }
+    int unreadCount() const { return m_unreadCount; }
+
+    QString syncCursor() const { return m_syncCursor; }
+
+    bool load(const QString &path);
+    void save(const QString &path) const;
+
+private:
+    void insertOrdered(const QString &id, const QDateTime &createdAt);
+    void trim();
+
+    QHash<QString, Notification> m_byId;
+    QVector<QString> m_order;                // 按 created_at 倒序
+    int m_unreadCount = 0;
+    QString m_syncCursor;
+    QDateTime m_syncCursorTime;
+};
+
+#endif // NOTIFICATIONSTORE_H
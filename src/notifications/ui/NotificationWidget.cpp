@@ -296,13 +296,14 @@ void NotificationWidget::setupConnections()
     if (m_service) {
         connect(m_service, &NotificationService::notificationsReceived,
                 this, &NotificationWidget::onNotificationsReceived);
-        connect(m_service, &NotificationService::localNotificationCreated,
-                this, [this]() {
-            // 本地通知创建后刷新显示
-            if (isVisible()) {
-                applyFilter();
-            }
-        });
+        connect(m_service, &NotificationService::notificationInserted,
+                this, &NotificationWidget::onNotificationInserted);
+        connect(m_service, &NotificationService::notificationUpdated,
+                this, &NotificationWidget::onNotificationUpdated);
+        connect(m_service, &NotificationService::notificationRemoved,
+                this, &NotificationWidget::onNotificationRemoved);
+        connect(m_service, &NotificationService::unreadCountChanged,
+                this, &NotificationWidget::onUnreadCountChanged);
         connect(m_service, &NotificationService::loadingStateChanged,
                 this, [this](bool loading) {
             Q_UNUSED(loading)
@@ -313,6 +314,9 @@ void NotificationWidget::setupConnections()
 void NotificationWidget::showPopup()
 {
     if (m_service) {
+        // 先用本地存储渲染，再增量同步，新通知逐条插入
+        applyFilter();
+        onUnreadCountChanged(m_service->unreadCount());
         m_service->fetchNotifications();
     }
     show();
@@ -366,19 +370,62 @@ bool NotificationWidget::eventFilter(QObject *watched, QEvent *event)
 
 void NotificationWidget::onNotificationsReceived(const QList<Notification> &notifications)
 {
-    m_notifications = notifications;
     updateNotificationList(notifications);
+    onUnreadCountChanged(m_service ? m_service->unreadCount() : 0);
+}
 
-    // 更新未读数量
-    int unreadCount = 0;
-    for (const auto &n : notifications) {
-        if (!n.isRead()) {
-            unreadCount++;
+void NotificationWidget::onNotificationInserted(const Notification &notification)
+{
+    if (!passesFilter(notification) || m_itemById.contains(notification.id())) return;
+
+    // 在当前显示的行里找到第一个比它旧的通知，插在它前面
+    int layoutIndex = m_listLayout->count() - 1;   // 默认放在末尾的 stretch 之前
+    const int storeIndex = m_service->indexOf(notification.id());
+    const QList<Notification> all = m_service->notifications();
+    for (int i = storeIndex + 1; i < all.size(); ++i) {
+        if (QWidget *next = m_itemById.value(all[i].id())) {
+            layoutIndex = m_listLayout->indexOf(next);
+            break;
         }
     }
 
-    if (unreadCount > 0) {
-        m_countLabel->setText(QString("(%1 条未读)").arg(unreadCount));
+    QWidget *item = createNotificationItem(notification);
+    m_listLayout->insertWidget(layoutIndex, item);
+    m_itemById.insert(notification.id(), item);
+    updateEmptyState();
+}
+
+void NotificationWidget::onNotificationUpdated(const Notification &notification)
+{
+    QWidget *old = m_itemById.value(notification.id());
+    if (!old) return;
+
+    // 只重建这一行
+    const int layoutIndex = m_listLayout->indexOf(old);
+    QWidget *item = createNotificationItem(notification);
+    m_listLayout->insertWidget(layoutIndex, item);
+    m_itemById.insert(notification.id(), item);
+
+    m_listLayout->removeWidget(old);
+    old->hide();
+    old->deleteLater();
+}
+
+void NotificationWidget::onNotificationRemoved(const QString &notificationId)
+{
+    QWidget *item = m_itemById.take(notificationId);
+    if (!item) return;
+    m_listLayout->removeWidget(item);
+    item->hide();
+    item->deleteLater();
+    m_selectedIds.removeAll(notificationId);
+    updateEmptyState();
+}
+
+void NotificationWidget::onUnreadCountChanged(int count)
+{
+    if (count > 0) {
+        m_countLabel->setText(QString("(%1 条未读)").arg(count));
         m_markAllReadButton->setEnabled(true);
     } else {
         m_countLabel->setText("");
@@ -395,17 +442,15 @@ void NotificationWidget::onMarkAllAsRead()
 
 void NotificationWidget::onNotificationItemClicked(const QString &notificationId)
 {
-    // 查找通知
-    for (const auto &n : m_notifications) {
-        if (n.id() == notificationId) {
-            // 标记为已读
-            if (!n.isRead() && m_service) {
-                m_service->markAsRead(notificationId);
-            }
-            emit notificationClicked(n);
-            break;
-        }
+    if (!m_service) return;
+    const Notification n = m_service->notification(notificationId);
+    if (n.id().isEmpty()) return;
+
+    // 标记为已读
+    if (!n.isRead()) {
+        m_service->markAsRead(notificationId);
     }
+    emit notificationClicked(n);
 }
 
 void NotificationWidget::onDeleteNotification(const QString &notificationId)
@@ -418,28 +463,32 @@ void NotificationWidget::onDeleteNotification(const QString &notificationId)
 void NotificationWidget::updateNotificationList(const QList<Notification> &notifications)
 {
     LayoutUtils::clearLayout(m_listLayout, true);
+    m_itemById.clear();
 
-    // 根据筛选条件过滤
-    QList<Notification> filteredList;
-    for (const auto &n : notifications) {
-        if (m_currentFilter == -1 || static_cast<int>(n.type()) == m_currentFilter) {
-            filteredList.append(n);
-        }
+    // 根据筛选条件过滤，添加通知项
+    for (const auto &notification : notifications) {
+        if (!passesFilter(notification)) continue;
+        QWidget *item = createNotificationItem(notification);
+        m_listLayout->insertWidget(m_listLayout->count() - 1, item);
+        m_itemById.insert(notification.id(), item);
     }
 
     // 显示空状态或列表
-    if (filteredList.isEmpty()) {
-        m_emptyLabel->show();
-        m_emptyLabel->raise();
-        return;
-    }
+    updateEmptyState();
+}
 
-    m_emptyLabel->hide();
+bool NotificationWidget::passesFilter(const Notification &notification) const
+{
+    return m_currentFilter == -1 || static_cast<int>(notification.type()) == m_currentFilter;
+}
 
-    // 添加通知项
-    for (const auto &notification : filteredList) {
-        QWidget *item = createNotificationItem(notification);
-        m_listLayout->insertWidget(m_listLayout->count() - 1, item);
+void NotificationWidget::updateEmptyState()
+{
+    if (m_itemById.isEmpty()) {
+        m_emptyLabel->show();
+        m_emptyLabel->raise();
+    } else {
+        m_emptyLabel->hide();
     }
 }
 
@@ -723,7 +772,7 @@ QWidget *NotificationWidget::buildFilterBar()
 
 void NotificationWidget::applyFilter()
 {
-    updateNotificationList(m_notifications);
+    updateNotificationList(m_service ? m_service->notifications() : QList<Notification>());
 }
 
 void NotificationWidget::enterSelectMode()
@@ -7,6 +7,7 @@
 #include <QVBoxLayout>
 #include <QScrollArea>
 #include <QCheckBox>
+#include <QHash>
 #include "../models/Notification.h"
 
 class NotificationService;
@@ -39,6 +40,10 @@ signals:
 
 private slots:
     void onNotificationsReceived(const QList<Notification> &notifications);
+    void onNotificationInserted(const Notification &notification);
+    void onNotificationUpdated(const Notification &notification);
+    void onNotificationRemoved(const QString &notificationId);
+    void onUnreadCountChanged(int count);
     void onMarkAllAsRead();
     void onNotificationItemClicked(const QString &notificationId);
     void onDeleteNotification(const QString &notificationId);
@@ -48,6 +53,8 @@ private:
     void setupConnections();
     QWidget *createNotificationItem(const Notification &notification);
     void updateNotificationList(const QList<Notification> &notifications);
+    bool passesFilter(const Notification &notification) const;
+    void updateEmptyState();
     QWidget *buildFilterBar();
     void applyFilter();
     void enterSelectMode();
@@ -68,8 +75,8 @@ private:
     // 服务
     NotificationService *m_service = nullptr;
 
-    // 缓存的通知列表
-    QList<Notification> m_notifications;
+    // 通知 ID -> 列表中的行（单条插入 / 更新 / 删除时直接定位）
+    QHash<QString, QWidget*> m_itemById;
 
     // 筛选与批量选择
     int m_currentFilter = -1;  // -1 表示全部
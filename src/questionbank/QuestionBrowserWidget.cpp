@@ -0,0 +1,243 @@
+#include "QuestionBrowserWidget.h"
+#include "QuestionBasket.h"
+#include "QuestionPager.h"
+
+#include <QColor>
+#include <QComboBox>
+#include <QDebug>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QMap>
+#include <QPushButton>
+#include <QTextDocumentFragment>
+#include <QTimer>
+#include <QVBoxLayout>
+
+QuestionBrowserWidget::QuestionBrowserWidget(PaperService *paperService, QWidget *parent)
+    : QWidget(parent)
+    , m_pager(new QuestionPager(paperService, this))
+{
+    initUI();
+
+    connect(m_pager, &QuestionPager::pageReady, this, &QuestionBrowserWidget::onPageReady);
+    connect(m_pager, &QuestionPager::totalCountReady, this, &QuestionBrowserWidget::onTotalCountReady);
+    connect(m_pager, &QuestionPager::loadingChanged, this, &QuestionBrowserWidget::onLoadingChanged);
+    connect(m_pager, &QuestionPager::errorOccurred, this, &QuestionBrowserWidget::onError);
+}
+
+void QuestionBrowserWidget::initUI()
+{
+    auto *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(24, 16, 24, 16);
+    mainLayout->setSpacing(12);
+
+    // ===== 筛选栏 =====
+    auto *filterLayout = new QHBoxLayout();
+    filterLayout->setSpacing(8);
+
+    m_keywordEdit = new QLineEdit();
+    m_keywordEdit->setPlaceholderText("搜索题干关键词");
+    m_keywordEdit->setClearButtonEnabled(true);
+    m_keywordEdit->setMinimumHeight(32);
+
+    m_typeCombo = new QComboBox();
+    m_typeCombo->addItem("全部题型", QString());
+    m_typeCombo->addItem("选择题", "single_choice");
+    m_typeCombo->addItem("多选题", "multi_choice");
+    m_typeCombo->addItem("判断题", "true_false");
+    m_typeCombo->addItem("填空题", "fill_blank");
+    m_typeCombo->addItem("简答题", "short_answer");
+    m_typeCombo->addItem("论述题", "essay");
+    m_typeCombo->addItem("材料论述题", "material_essay");
+    m_typeCombo->setMinimumHeight(32);
+
+    m_difficultyCombo = new QComboBox();
+    m_difficultyCombo->addItem("全部难度", QString());
+    m_difficultyCombo->addItem("简单", "easy");
+    m_difficultyCombo->addItem("中等", "medium");
+    m_difficultyCombo->addItem("困难", "hard");
+    m_difficultyCombo->setMinimumHeight(32);
+
+    filterLayout->addWidget(m_keywordEdit, 1);
+    filterLayout->addWidget(m_typeCombo);
+    filterLayout->addWidget(m_difficultyCombo);
+    mainLayout->addLayout(filterLayout);
+
+    // 关键词输入防抖，避免每个字符都发起查询和计数
+    m_keywordTimer = new QTimer(this);
+    m_keywordTimer->setSingleShot(true);
+    m_keywordTimer->setInterval(KEYWORD_DEBOUNCE_MS);
+    connect(m_keywordTimer, &QTimer::timeout, this, &QuestionBrowserWidget::applyFilters);
+    connect(m_keywordEdit, &QLineEdit::textChanged, m_keywordTimer, qOverload<>(&QTimer::start));
+    connect(m_typeCombo, &QComboBox::currentIndexChanged, this, &QuestionBrowserWidget::applyFilters);
+    connect(m_difficultyCombo, &QComboBox::currentIndexChanged, this, &QuestionBrowserWidget::applyFilters);
+
+    // ===== 总数 / 状态 =====
+    auto *infoLayout = new QHBoxLayout();
+    m_countLabel = new QLabel();
+    m_countLabel->setStyleSheet("QLabel { color: #555; font-size: 12px; }");
+    m_countLabel->setTextFormat(Qt::RichText);
+    // 精确计数失败时不发信号，所以刷新期间保留估算值
+    connect(m_countLabel, &QLabel::linkActivated, m_pager, &QuestionPager::refreshCount);
+    m_statusLabel = new QLabel();
+    m_statusLabel->setStyleSheet("QLabel { color: #888; font-size: 12px; }");
+    infoLayout->addWidget(m_countLabel);
+    infoLayout->addStretch();
+    infoLayout->addWidget(m_statusLabel);
+    mainLayout->addLayout(infoLayout);
+
+    // ===== 题目列表 =====
+    m_list = new QListWidget();
+    m_list->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_list->setWordWrap(true);
+    m_list->setStyleSheet(
+        "QListWidget { border: 1px solid #E0E0E0; border-radius: 8px; background: white; }"
+        "QListWidget::item { padding: 8px; border-bottom: 1px solid #F0F0F0; }"
+        "QListWidget::item:selected { background: #E8F5E9; color: #1B5E20; }"
+    );
+    connect(m_list, &QListWidget::itemSelectionChanged, this, [this]() {
+        m_addBtn->setEnabled(!m_list->selectedItems().isEmpty());
+    });
+    mainLayout->addWidget(m_list, 1);
+
+    // ===== 翻页 / 操作 =====
+    auto *bottomLayout = new QHBoxLayout();
+    m_addBtn = new QPushButton("加入试题篮");
+    m_addBtn->setCursor(Qt::PointingHandCursor);
+    m_addBtn->setEnabled(false);
+    m_addBtn->setStyleSheet(
+        "QPushButton { background: #2E7D32; color: white; border: none; "
+        "padding: 6px 16px; border-radius: 6px; font-weight: 600; }"
+        "QPushButton:hover { background: #1B5E20; }"
+        "QPushButton:disabled { background: #BDBDBD; }"
+    );
+    connect(m_addBtn, &QPushButton::clicked, this, &QuestionBrowserWidget::onAddToBasket);
+
+    m_prevBtn = new QPushButton("上一页");
+    m_nextBtn = new QPushButton("下一页");
+    m_prevBtn->setCursor(Qt::PointingHandCursor);
+    m_nextBtn->setCursor(Qt::PointingHandCursor);
+    connect(m_prevBtn, &QPushButton::clicked, m_pager, &QuestionPager::previousPage);
+    connect(m_nextBtn, &QPushButton::clicked, m_pager, &QuestionPager::nextPage);
+
+    m_pageLabel = new QLabel();
+    m_pageLabel->setStyleSheet("QLabel { color: #555; font-size: 12px; padding: 0 8px; }");
+
+    bottomLayout->addWidget(m_addBtn);
+    bottomLayout->addStretch();
+    bottomLayout->addWidget(m_prevBtn);
+    bottomLayout->addWidget(m_pageLabel);
+    bottomLayout->addWidget(m_nextBtn);
+    mainLayout->addLayout(bottomLayout);
+
+    updatePageControls();
+}
+
+void QuestionBrowserWidget::reload()
+{
+    applyFilters();
+}
+
+// ===== 筛选 / 翻页 =====
+
+void QuestionBrowserWidget::applyFilters()
+{
+    m_keywordTimer->stop();
+
+    QuestionSearchCriteria criteria;
+    criteria.keyword = m_keywordEdit->text().trimmed();
+    criteria.questionType = m_typeCombo->currentData().toString();
+    criteria.difficulty = m_difficultyCombo->currentData().toString();
+    criteria.limit = PAGE_SIZE;
+
+    m_countLabel->clear();
+    m_pager->setCriteria(criteria);
+}
+
+void QuestionBrowserWidget::updatePageControls()
+{
+    const bool loading = m_pager->isLoading();
+    m_prevBtn->setEnabled(!loading && m_pager->hasPreviousPage());
+    m_nextBtn->setEnabled(!loading && m_pager->hasNextPage());
+    m_pageLabel->setText(QString("第 %1 页").arg(m_pager->currentPage() + 1));
+}
+
+void QuestionBrowserWidget::onPageReady(int pageIndex, const QList<PaperQuestion> &questions, bool hasMore)
+{
+    Q_UNUSED(hasMore);
+    m_currentQuestions = questions;
+
+    static const QMap<QString, QString> typeNames = {
+        {"single_choice", "选择"},
+        {"multi_choice", "多选"},
+        {"true_false", "判断"},
+        {"fill_blank", "填空"},
+        {"short_answer", "简答"},
+        {"essay", "论述"},
+        {"material_essay", "材料"}
+    };
+
+    m_list->clear();
+    for (int i = 0; i < questions.size(); ++i) {
+        const PaperQuestion &q = questions.at(i);
+        // 题干可能含 HTML（材料题），列表里只显示纯文本摘要
+        QString stem = QTextDocumentFragment::fromHtml(q.stem).toPlainText().simplified();
+        if (stem.length() > STEM_PREVIEW_CHARS) {
+            stem = stem.left(STEM_PREVIEW_CHARS) + "…";
+        }
+        auto *item = new QListWidgetItem(
+            QString("[%1] %2").arg(typeNames.value(q.questionType, q.questionType), stem));
+        item->setData(Qt::UserRole, i);
+        if (QuestionBasket::instance()->contains(q.id)) {
+            item->setForeground(QColor("#9E9E9E"));
+        }
+        m_list->addItem(item);
+    }
+
+    m_statusLabel->setText(questions.isEmpty() && pageIndex == 0 ? "没有符合条件的题目" : QString());
+    updatePageControls();
+}
+
+void QuestionBrowserWidget::onTotalCountReady(int total, bool estimated)
+{
+    if (estimated) {
+        m_countLabel->setText(QString("共约 %1 题 <a href=\"exact\">精确统计</a>").arg(total));
+    } else {
+        m_countLabel->setText(QString("共 %1 题").arg(total));
+    }
+}
+
+void QuestionBrowserWidget::onLoadingChanged(bool loading)
+{
+    if (loading) {
+        m_statusLabel->setText("加载中…");
+    } else if (m_statusLabel->text() == "加载中…") {
+        m_statusLabel->clear();
+    }
+    updatePageControls();
+}
+
+void QuestionBrowserWidget::onError(const QString &error)
+{
+    qDebug() << "[QuestionBrowserWidget] 加载题目失败:" << error;
+    m_statusLabel->setText("加载失败：" + error);
+    updatePageControls();
+}
+
+void QuestionBrowserWidget::onAddToBasket()
+{
+    int added = 0;
+    for (QListWidgetItem *item : m_list->selectedItems()) {
+        const int index = item->data(Qt::UserRole).toInt();
+        if (index < 0 || index >= m_currentQuestions.size()) {
+            continue;
+        }
+        if (QuestionBasket::instance()->addQuestion(m_currentQuestions.at(index))) {
+            item->setForeground(QColor("#9E9E9E"));
+            ++added;
+        }
+    }
+    m_statusLabel->setText(added > 0 ? QString("已加入 %1 道题").arg(added) : "所选题目已在试题篮中");
+}
@@ -0,0 +1,65 @@
+#ifndef QUESTIONBROWSERWIDGET_H
+#define QUESTIONBROWSERWIDGET_H
+
+#include <QWidget>
+#include <QList>
+#include "../services/PaperService.h"
+
+class QComboBox;
+class QLabel;
+class QLineEdit;
+class QListWidget;
+class QPushButton;
+class QTimer;
+class QuestionPager;
+
+/**
+ * @brief 题库浏览页 - 按条件翻阅云端题库并加入试题篮
+ *
+ * 翻页、预取和页缓存由 QuestionPager 负责（游标分页，不依赖 OFFSET）；
+ * 总数单独显示：先给出估算值，点击后再刷新精确值，不拖慢列表加载。
+ */
+class QuestionBrowserWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit QuestionBrowserWidget(PaperService *paperService, QWidget *parent = nullptr);
+
+    // 按当前筛选条件从第一页重新加载
+    void reload();
+
+private slots:
+    void applyFilters();
+    void onPageReady(int pageIndex, const QList<PaperQuestion> &questions, bool hasMore);
+    void onTotalCountReady(int total, bool estimated);
+    void onLoadingChanged(bool loading);
+    void onError(const QString &error);
+    void onAddToBasket();
+
+private:
+    void initUI();
+    void updatePageControls();
+
+    QuestionPager *m_pager;
+    QList<PaperQuestion> m_currentQuestions;
+
+    QLineEdit *m_keywordEdit = nullptr;
+    QComboBox *m_typeCombo = nullptr;
+    QComboBox *m_difficultyCombo = nullptr;
+    QTimer *m_keywordTimer = nullptr;
+
+    QListWidget *m_list = nullptr;
+    QLabel *m_countLabel = nullptr;
+    QLabel *m_pageLabel = nullptr;
+    QLabel *m_statusLabel = nullptr;
+    QPushButton *m_prevBtn = nullptr;
+    QPushButton *m_nextBtn = nullptr;
+    QPushButton *m_addBtn = nullptr;
+
+    static constexpr int PAGE_SIZE = 20;
+    static constexpr int KEYWORD_DEBOUNCE_MS = 400;
+    static constexpr int STEM_PREVIEW_CHARS = 80;
+};
+
+#endif // QUESTIONBROWSERWIDGET_H
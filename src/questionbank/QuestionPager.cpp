@@ -0,0 +1,249 @@
+#include "QuestionPager.h"
+#include <QDebug>
+
+QuestionPager::QuestionPager(PaperService *paperService, QObject *parent)
+    : QObject(parent)
+    , m_paperService(paperService)
+{
+    connect(m_paperService, &PaperService::questionPageLoaded,
+            this, &QuestionPager::onPageLoaded);
+    connect(m_paperService, &PaperService::questionPageFailed,
+            this, &QuestionPager::onPageFailed);
+    connect(m_paperService, &PaperService::questionCountLoaded,
+            this, &QuestionPager::onCountLoaded);
+}
+
+void QuestionPager::setCriteria(const QuestionSearchCriteria &criteria)
+{
+    m_criteria = criteria;
+    m_criteria.after = QuestionPageCursor();
+    m_filterKey = m_paperService->searchFilterKey(m_criteria);
+
+    ++m_generation;
+    m_pageCursors.clear();
+    m_pageCursors.append(QuestionPageCursor());
+    m_pageCache.clear();
+    m_currentPage = 0;
+    m_prefetchingPage = -1;
+    if (m_loadingPage >= 0) {
+        m_loadingPage = -1;
+        emit loadingChanged(false);
+    }
+
+    m_paperService->countQuestions(m_criteria, m_estimatedCount);
+    showPage(0);
+}
+
+void QuestionPager::nextPage()
+{
+    if (!hasNextPage()) {
+        return;
+    }
+    showPage(m_currentPage + 1);
+}
+
+void QuestionPager::previousPage()
+{
+    if (!hasPreviousPage()) {
+        return;
+    }
+    showPage(m_currentPage - 1);
+}
+
+void QuestionPager::reload()
+{
+    setCriteria(m_criteria);
+}
+
+void QuestionPager::refreshCount()
+{
+    m_paperService->countQuestions(m_criteria, false);
+}
+
+bool QuestionPager::hasNextPage() const
+{
+    auto it = m_pageCache.constFind(m_currentPage);
+    if (it != m_pageCache.constEnd()) {
+        return it->hasMore;
+    }
+    return m_currentPage + 1 < m_pageCursors.size();
+}
+
+void QuestionPager::setCacheCapacity(int pages)
+{
+    m_cacheCapacity = qMax(2, pages);
+    evictPages();
+}
+
+// ===== 内部实现 =====
+
+void QuestionPager::showPage(int pageIndex)
+{
+    if (pageIndex < 0 || pageIndex >= m_pageCursors.size()) {
+        return;
+    }
+
+    m_currentPage = pageIndex;
+
+    auto it = m_pageCache.constFind(pageIndex);
+    if (it != m_pageCache.constEnd()) {
+        if (m_loadingPage >= 0) {
+            m_loadingPage = -1;
+            emit loadingChanged(false);
+        }
+        emit pageReady(pageIndex, it->questions, it->hasMore);
+        evictPages();
+        prefetchNext();
+        return;
+    }
+
+    // 目标页正在预取中：转为前台等待，不重复请求
+    if (m_prefetchingPage == pageIndex) {
+        m_prefetchingPage = -1;
+        m_loadingPage = pageIndex;
+        emit loadingChanged(true);
+        return;
+    }
+
+    requestPage(pageIndex, false);
+}
+
+void QuestionPager::requestPage(int pageIndex, bool prefetch)
+{
+    QuestionSearchCriteria criteria = m_criteria;
+    criteria.after = m_pageCursors.at(pageIndex);
+
+    if (prefetch) {
+        m_prefetchingPage = pageIndex;
+    } else {
+        const bool wasLoading = m_loadingPage >= 0;
+        m_loadingPage = pageIndex;
+        if (!wasLoading) {
+            emit loadingChanged(true);
+        }
+    }
+
+    m_paperService->searchQuestionsPage(criteria, makeTag(pageIndex));
+}
+
+void QuestionPager::prefetchNext()
+{
+    if (!m_prefetchEnabled || m_prefetchingPage >= 0) {
+        return;
+    }
+
+    const int next = m_currentPage + 1;
+    if (next >= m_pageCursors.size() || m_pageCache.contains(next) || m_loadingPage == next) {
+        return;
+    }
+    requestPage(next, true);
+}
+
+void QuestionPager::evictPages()
+{
+    // 淘汰距当前页最远的页，保证当前页和预取页始终在缓存里
+    while (m_pageCache.size() > m_cacheCapacity) {
+        int victim = -1;
+        int victimDistance = -1;
+        for (auto it = m_pageCache.constBegin(); it != m_pageCache.constEnd(); ++it) {
+            const int distance = qAbs(it.key() - m_currentPage);
+            if (distance > victimDistance) {
+                victimDistance = distance;
+                victim = it.key();
+            }
+        }
+        if (victim < 0 || victimDistance <= 1) {
+            break;
+        }
+        m_pageCache.remove(victim);
+    }
+}
+
+QString QuestionPager::makeTag(int pageIndex) const
+{
+    return QString("pager:%1:%2:%3")
+        .arg(reinterpret_cast<quintptr>(this))
+        .arg(m_generation)
+        .arg(pageIndex);
+}
+
+bool QuestionPager::parseTag(const QString &tag, int *pageIndex) const
+{
+    const QStringList parts = tag.split(':');
+    if (parts.size() != 4 || parts.at(0) != "pager") {
+        return false;
+    }
+    if (parts.at(1).toULongLong() != reinterpret_cast<quintptr>(this)
+        || parts.at(2).toInt() != m_generation) {
+        return false;  // 其他分页器或已过期的筛选条件
+    }
+    *pageIndex = parts.at(3).toInt();
+    return true;
+}
+
+// ===== PaperService 回调 =====
+
+void QuestionPager::onPageLoaded(const QString &requestTag, const QList<PaperQuestion> &results,
+                                 const QuestionPageCursor &nextCursor, bool hasMore)
+{
+    int pageIndex = -1;
+    if (!parseTag(requestTag, &pageIndex)) {
+        return;
+    }
+
+    if (m_prefetchingPage == pageIndex) {
+        m_prefetchingPage = -1;
+    }
+
+    CachedPage page;
+    page.questions = results;
+    page.hasMore = hasMore;
+    m_pageCache.insert(pageIndex, page);
+
+    // 记录下一页起始游标
+    if (hasMore && pageIndex + 1 == m_pageCursors.size()) {
+        m_pageCursors.append(nextCursor);
+    }
+
+    if (m_loadingPage == pageIndex) {
+        m_loadingPage = -1;
+        emit loadingChanged(false);
+    }
+
+    if (pageIndex == m_currentPage) {
+        emit pageReady(pageIndex, results, hasMore);
+        evictPages();
+        prefetchNext();
+    } else {
+        evictPages();
+    }
+}
+
+void QuestionPager::onPageFailed(const QString &requestTag, const QString &error)
+{
+    int pageIndex = -1;
+    if (!parseTag(requestTag, &pageIndex)) {
+        return;
+    }
+
+    if (m_prefetchingPage == pageIndex) {
+        // 预取失败静默处理，用户真正翻到该页时再请求
+        m_prefetchingPage = -1;
+        qDebug() << "[QuestionPager] 预取第" << pageIndex << "页失败:" << error;
+        return;
+    }
+
+    if (m_loadingPage == pageIndex) {
+        m_loadingPage = -1;
+        emit loadingChanged(false);
+        emit errorOccurred(error);
+    }
+}
+
+void QuestionPager::onCountLoaded(const QString &filterKey, int total, bool estimated)
+{
+    if (filterKey != m_filterKey) {
+        return;
+    }
+    emit totalCountReady(total, estimated);
+}
@@ -0,0 +1,89 @@
+#ifndef QUESTIONPAGER_H
+#define QUESTIONPAGER_H
+
+#include <QObject>
+#include <QList>
+#include <QMap>
+#include <QVector>
+#include "../services/PaperService.h"
+
+/**
+ * @brief 题库分页浏览器 - 基于游标分页的翻页、预取与页缓存
+ *
+ * 包装 PaperService::searchQuestionsPage：
+ * - 每页记录起始游标，前后翻页都不依赖 OFFSET
+ * - 当前页显示后在后台预取下一页
+ * - 最近访问的页以有界环形缓存保存已解析结果，回翻即时返回
+ * - 总数通过 countQuestions 单独查询（默认估算值，结果由 PaperService 缓存），
+ *   需要精确值时调用 refreshCount() 另行刷新，不阻塞翻页
+ */
+class QuestionPager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit QuestionPager(PaperService *paperService, QObject *parent = nullptr);
+
+    // 设置筛选条件并从第一页重新开始（会清空页缓存）
+    void setCriteria(const QuestionSearchCriteria &criteria);
+
+    void nextPage();
+    void previousPage();
+    void reload();
+
+    // 单独刷新总数（精确计数），结果经 totalCountReady 发出
+    void refreshCount();
+
+    int currentPage() const { return m_currentPage; }
+    bool hasNextPage() const;
+    bool hasPreviousPage() const { return m_currentPage > 0; }
+    bool isLoading() const { return m_loadingPage >= 0; }
+
+    // 缓存页数上限（至少 2 页：当前页 + 预取页）
+    void setCacheCapacity(int pages);
+    void setPrefetchEnabled(bool enabled) { m_prefetchEnabled = enabled; }
+    void setEstimatedCount(bool estimated) { m_estimatedCount = estimated; }
+
+signals:
+    void pageReady(int pageIndex, const QList<PaperQuestion> &questions, bool hasMore);
+    void totalCountReady(int total, bool estimated);
+    void loadingChanged(bool loading);
+    void errorOccurred(const QString &error);
+
+private slots:
+    void onPageLoaded(const QString &requestTag, const QList<PaperQuestion> &results,
+                      const QuestionPageCursor &nextCursor, bool hasMore);
+    void onPageFailed(const QString &requestTag, const QString &error);
+    void onCountLoaded(const QString &filterKey, int total, bool estimated);
+
+private:
+    struct CachedPage {
+        QList<PaperQuestion> questions;
+        bool hasMore = false;
+    };
+
+    void showPage(int pageIndex);
+    void requestPage(int pageIndex, bool prefetch);
+    void prefetchNext();
+    void evictPages();
+    QString makeTag(int pageIndex) const;
+    bool parseTag(const QString &tag, int *pageIndex) const;
+
+    PaperService *m_paperService;
+    QuestionSearchCriteria m_criteria;
+    QString m_filterKey;
+
+    // 第 i 页的起始游标（第 0 页为空游标）；页内容被淘汰后仍可据此重新拉取
+    QVector<QuestionPageCursor> m_pageCursors;
+    QMap<int, CachedPage> m_pageCache;
+    int m_cacheCapacity = 6;
+
+    int m_currentPage = 0;
+    int m_loadingPage = -1;    // 前台等待中的页，-1 表示空闲
+    int m_prefetchingPage = -1;
+    int m_generation = 0;      // 每次 setCriteria 递增，丢弃过期响应
+    bool m_prefetchEnabled = true;
+    bool m_estimatedCount = true;
+};
+
+#endif // QUESTIONPAGER_H
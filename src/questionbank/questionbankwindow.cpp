@@ -3,6 +3,7 @@
 #include "PaperComposerDialog.h"
 #include "QuestionBasket.h"
 #include "QuestionBasketWidget.h"
+#include "QuestionBrowserWidget.h"
 #include "QualityCheckDialog.h"
 #include "../config/AppConfig.h"
 #include "../shared/StyleConfig.h"
@@ -143,7 +144,7 @@ void QuestionBankWindow::setupLayout()
 
     pageLayout->addWidget(headerWrapper);
 
-    // ====== 内容区域：AI出题 / 智能组卷 ======
+    // ====== 内容区域：AI出题 / 智能组卷 / 题库浏览 ======
     m_modeStack = new QStackedWidget();
 
     // page 0: AI 出题（历史侧边栏已迁移到全局 m_sidebarStack）
@@ -169,6 +170,10 @@ void QuestionBankWindow::setupLayout()
     // page 1: 智能组卷
     m_modeStack->addWidget(m_smartPaperWidget);
 
+    // page 2: 题库浏览（与保存链路共用 PaperService，共享总数缓存；首次切换时才加载）
+    m_browserWidget = new QuestionBrowserWidget(m_paperService);
+    m_modeStack->addWidget(m_browserWidget);
+
     pageLayout->addWidget(m_modeStack, 1);
 
     rootLayout->addWidget(pageContainer);
@@ -259,10 +264,15 @@ QWidget *QuestionBankWindow::buildHeader()
 
     m_smartPaperTabBtn = new QPushButton("智能组卷");
     m_smartPaperTabBtn->setCursor(Qt::PointingHandCursor);
-    m_smartPaperTabBtn->setStyleSheet(TAB_NORMAL_STYLE.arg("0 10px 10px 0"));
+    m_smartPaperTabBtn->setStyleSheet(TAB_NORMAL_STYLE.arg("0"));
+
+    m_browserTabBtn = new QPushButton("题库浏览");
+    m_browserTabBtn->setCursor(Qt::PointingHandCursor);
+    m_browserTabBtn->setStyleSheet(TAB_NORMAL_STYLE.arg("0 10px 10px 0"));
 
     connect(m_aiGenTabBtn, &QPushButton::clicked, this, [this]() { switchMode(0); });
     connect(m_smartPaperTabBtn, &QPushButton::clicked, this, [this]() { switchMode(1); });
+    connect(m_browserTabBtn, &QPushButton::clicked, this, [this]() { switchMode(2); });
 
     // 质量检查按钮
     auto *qualityCheckBtn = new QPushButton("质量检查");
@@ -302,6 +312,7 @@ QWidget *QuestionBankWindow::buildHeader()
 
     layout->addWidget(m_aiGenTabBtn);
     layout->addWidget(m_smartPaperTabBtn);
+    layout->addWidget(m_browserTabBtn);
     layout->addWidget(qualityCheckBtn);
 
     return header;
@@ -381,14 +392,14 @@ void QuestionBankWindow::switchMode(int mode)
         "border-radius: %1; }"
         "QPushButton:hover { background: rgba(255,255,255,0.25); }";
 
-    if (mode == 0) {
-        if (m_aiGenTabBtn) m_aiGenTabBtn->setStyleSheet(TAB_ACTIVE.arg("10px 0 0 10px"));
-        if (m_smartPaperTabBtn) m_smartPaperTabBtn->setStyleSheet(TAB_NORMAL.arg("0 10px 10px 0"));
-        if (m_basketWidget) m_basketWidget->setVisible(false);
-    } else {
-        if (m_aiGenTabBtn) m_aiGenTabBtn->setStyleSheet(TAB_NORMAL.arg("10px 0 0 10px"));
-        if (m_smartPaperTabBtn) m_smartPaperTabBtn->setStyleSheet(TAB_ACTIVE.arg("0 10px 10px 0"));
-        if (m_basketWidget) m_basketWidget->setVisible(true);
+    if (m_aiGenTabBtn) m_aiGenTabBtn->setStyleSheet((mode == 0 ? TAB_ACTIVE : TAB_NORMAL).arg("10px 0 0 10px"));
+    if (m_smartPaperTabBtn) m_smartPaperTabBtn->setStyleSheet((mode == 1 ? TAB_ACTIVE : TAB_NORMAL).arg("0"));
+    if (m_browserTabBtn) m_browserTabBtn->setStyleSheet((mode == 2 ? TAB_ACTIVE : TAB_NORMAL).arg("0 10px 10px 0"));
+    if (m_basketWidget) m_basketWidget->setVisible(mode != 0);
+
+    if (mode == 2 && m_browserWidget && !m_browserLoaded) {
+        m_browserLoaded = true;
+        m_browserWidget->reload();
     }
 }
 
@@ -576,6 +587,9 @@ void QuestionBankWindow::onGeneratedQuestionsParsed(const QList<PaperQuestion> &
 
 void QuestionBankWindow::onGeneratedQuestionsSaved(int count)
 {
+    // 题库已变化（PaperService 已清空总数缓存），浏览页下次切换时重新加载
+    m_browserLoaded = false;
+
     if (!m_isSavingGeneratedQuestions || !m_aiQuestionGenWidget) return;
 
     m_isSavingGeneratedQuestions = false;
@@ -9,6 +9,7 @@ class QPushButton;
 class QResizeEvent;
 class QStackedWidget;
 class QuestionBasketWidget;
+class QuestionBrowserWidget;
 class SmartPaperWidget;
 class AIQuestionGenWidget;
 class ChatHistoryWidget;
@@ -36,7 +37,7 @@ protected:
 
 private slots:
     void onComposePaper();  // 打开组卷对话框
-    void switchMode(int mode);  // 切换 AI出题 / 智能组卷
+    void switchMode(int mode);  // 切换 AI出题 / 智能组卷 / 题库浏览
     void onSaveGeneratedQuestionsRequested(const QString &content);
     void onGeneratedQuestionsParsed(const QList<PaperQuestion> &questions);
     void onGeneratedQuestionsSaved(int count);
@@ -56,12 +57,15 @@ private:
     // 导出 DOCX（Markdown 直接转换）
     void onExportToDocx(const QString &content);
 
-    // 模式切换（AI出题 / 智能组卷）
+    // 模式切换（AI出题 / 智能组卷 / 题库浏览）
     QStackedWidget *m_modeStack = nullptr;
     AIQuestionGenWidget *m_aiQuestionGenWidget = nullptr;
     SmartPaperWidget *m_smartPaperWidget = nullptr;
+    QuestionBrowserWidget *m_browserWidget = nullptr;
+    bool m_browserLoaded = false;
     QPushButton *m_aiGenTabBtn = nullptr;
     QPushButton *m_smartPaperTabBtn = nullptr;
+    QPushButton *m_browserTabBtn = nullptr;
     QLabel *m_headerTitle = nullptr;
     QLabel *m_headerSubtitle = nullptr;
 
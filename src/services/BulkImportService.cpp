@@ -2,6 +2,7 @@
 #include "DocumentReaderService.h"
 #include "QuestionParserService.h"
 #include "QuestionQualityService.h"
+#include "../utils/Metrics.h"
 #include <QFile>
 #include <QDir>
 #include <QFileInfo>
@@ -189,6 +190,12 @@ void BulkImportService::importFromDirectory(const QString &dirPath,
 
 void BulkImportService::processNextFile()
 {
+    // 上一个文件（读取 + 解析 + 入库）的总耗时
+    if (m_fileStartNs > 0) {
+        Metrics::instance().recordSpan("bulk_import.file", m_fileStartNs);
+        m_fileStartNs = 0;
+    }
+
     if (m_stopRequested || m_pendingFiles.isEmpty()) {
         m_isImporting = false;
         emit importCompleted(m_totalQuestions, m_failedFiles);
@@ -196,6 +203,7 @@ void BulkImportService::processNextFile()
     }
 
     QString filePath = m_pendingFiles.takeFirst();
+    m_fileStartNs = Metrics::nowNs();
     QFileInfo fileInfo(filePath);
     m_currentFileName = fileInfo.fileName();
 
@@ -206,7 +214,11 @@ void BulkImportService::processNextFile()
 
     // 使用本地读取文档（含表格和图片转 HTML）
     // 这样可以保留表格和图片内容，而不是依赖 Dify 解析原始文件
-    QString documentText = m_documentReader->readDocxWithImages(filePath);
+    QString documentText;
+    {
+        METRICS_SCOPE("bulk_import.read_document");
+        documentText = m_documentReader->readDocxWithImages(filePath);
+    }
 
     if (documentText.isEmpty()) {
         qDebug() << "BulkImportService: 文档读取失败:" << m_documentReader->lastError();
@@ -231,6 +243,7 @@ void BulkImportService::processNextFile()
         qDebug() << "BulkImportService: 创建临时文件:" << tempFilePath;
 
         // 使用文件上传模式发送到 Dify（临时文件包含提取的表格内容）
+        m_parseStartNs = Metrics::nowNs();
         m_questionParser->parseFile(tempFilePath, m_currentSubject, m_currentGrade);
     } else {
         qDebug() << "BulkImportService: 创建临时文件失败";
@@ -244,6 +257,8 @@ void BulkImportService::processNextFile()
 void BulkImportService::onParseCompleted(const QList<PaperQuestion> &questions)
 {
     qDebug() << "BulkImportService: 解析完成，获得" << questions.size() << "道题目";
+    Metrics::instance().recordSpan("bulk_import.parse", m_parseStartNs);
+    METRICS_COUNT_N("bulk_import.questions_parsed", questions.size());
     emit documentParseCompleted(m_currentFileName, questions.size());
 
     if (questions.isEmpty()) {
@@ -274,6 +289,7 @@ void BulkImportService::onParseCompleted(const QList<PaperQuestion> &questions)
 
             // === 质量检查：标签规范化 + 去重快筛 ===
             if (m_qualityService && !bigQuestions.isEmpty()) {
+                METRICS_SCOPE("bulk_import.quality_check");
                 for (int i = 0; i < bigQuestions.size(); ++i) {
                     // 标签规范化
                     bigQuestions[i].tags = m_qualityService->normalizeTags(bigQuestions[i].tags);
@@ -294,6 +310,7 @@ void BulkImportService::onParseCompleted(const QList<PaperQuestion> &questions)
                 // 等待真实的数据库写入结果后，再推进导入状态。
                 m_waitingForSave = true;
                 m_pendingExpectedQuestionCount = bigQuestions.size();
+                m_saveStartNs = Metrics::nowNs();
                 m_paperService->addQuestions(bigQuestions);
                 return;
             }
@@ -314,6 +331,8 @@ void BulkImportService::onQuestionsSaved(int count)
     }
 
     m_waitingForSave = false;
+    Metrics::instance().recordSpan("bulk_import.save", m_saveStartNs);
+    METRICS_COUNT_N("bulk_import.questions_saved", count);
     qDebug() << "BulkImportService: 数据库写入成功" << count
              << "题，预期" << m_pendingExpectedQuestionCount << "题";
     m_totalQuestions += count;
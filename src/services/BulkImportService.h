@@ -102,6 +102,11 @@ private:
     int m_failedFiles;
     bool m_waitingForSave = false;
     int m_pendingExpectedQuestionCount = 0;
+
+    // 指标：各阶段开始时刻（Metrics::nowNs）
+    qint64 m_fileStartNs = 0;
+    qint64 m_parseStartNs = 0;
+    qint64 m_saveStartNs = 0;
     
     // 当前处理的元数据
     QString m_currentSubject;
@@ -1,6 +1,8 @@
 #include "DifyService.h"
 #include "../config/AppConfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/HotLog.h"
+#include "../utils/Metrics.h"
 #include <QNetworkRequest>
 #include <QJsonArray>
 #include <QUuid>
@@ -135,6 +137,10 @@ void DifyService::sendMessage(const QString &message, const QString &conversatio
 
     emit requestStarted();
 
+    m_requestStartNs = Metrics::nowNs();
+    m_firstTokenRecorded = false;
+    METRICS_COUNT("dify.requests");
+
     // 发送 POST 请求
     m_currentReply = m_networkManager->post(request, jsonData);
 
@@ -153,6 +159,7 @@ void DifyService::onReadyRead()
     // 立即读取所有可用数据
     QByteArray data = m_currentReply->readAll();
     if (!data.isEmpty()) {
+        METRICS_COUNT_N("dify.stream_bytes", data.size());
         parseStreamResponse(data);
     }
 }
@@ -182,6 +189,9 @@ void DifyService::onReplyFinished()
              << "HTTP status:" << httpStatus
              << "Response data length:" << responseData.length();
 
+    Metrics::instance().recordSpan("dify.request", m_requestStartNs);
+    METRICS_COUNT_N("dify.response_chars", m_fullResponse.size());
+
     if ((error != QNetworkReply::NoError && error != QNetworkReply::RemoteHostClosedError)
         || emptyRemoteClose) {
         if (!m_streamBuffer.isEmpty() || !m_sseEvent.isEmpty() || !m_sseDataLines.isEmpty()) {
@@ -211,6 +221,7 @@ void DifyService::onReplyFinished()
         }
 
         qDebug() << "[DifyService] Error:" << errorMsg;
+        METRICS_COUNT("dify.errors");
         emit errorOccurred(errorMsg);
     } else {
         // 发送完整响应
@@ -354,6 +365,11 @@ void DifyService::handleStreamText(const QString &text)
     }
 
     // 正常累加并发射信号
+    if (!m_firstTokenRecorded) {
+        m_firstTokenRecorded = true;
+        Metrics::instance().recordSpan("dify.first_token", m_requestStartNs);
+    }
+    METRICS_COUNT("dify.stream_chunks");
     m_fullResponse += filteredText;
     emit streamChunkReceived(filteredText);
 }
@@ -465,9 +481,9 @@ void DifyService::parseStreamResponse(const QByteArray &data)
         }
 
         if (event != "workflow_started" && event != "node_started" && event != "node_finished" && event != "workflow_finished") {
-            qDebug() << "[DifyService] Event:" << event;
+            HOT_DEBUG() << "[DifyService] Event:" << event;
         } else {
-            qDebug() << "[DifyService] Event:" << event;
+            HOT_DEBUG() << "[DifyService] Event:" << event;
         }
 
         if (event == "message") {
@@ -182,6 +182,8 @@ private:
     bool m_ignoreFurtherContent = false;
     bool m_hasTruncated = false;
     int m_maxResponseChars = 10000;
+    qint64 m_requestStartNs = 0;       // 当前请求发出时刻（Metrics::nowNs）
+    bool m_firstTokenRecorded = false;
 };
 
 #endif // DIFYSERVICE_H
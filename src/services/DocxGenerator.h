@@ -61,9 +61,8 @@ private:
     QString generateOptionsXml(const QStringList &options);
     QString escapeXml(const QString &text);
 
-    // Markdown → OOXML 段落
+    // Markdown → document.xml（转换见 MarkdownDocxConverter）
     bool createDocumentFromMarkdown(const QString &tempDir, const QString &title, const QString &markdownText);
-    QString markdownLineToXml(const QString &line);
 
     // 打包为 ZIP
     bool packToZip(const QString &tempDir, const QString &outputPath);
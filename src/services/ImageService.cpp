@@ -0,0 +1,281 @@
+#include "ImageService.h"
+#include "../utils/NetworkRequestFactory.h"
+#include <QBuffer>
+#include <QImageReader>
+#include <QNetworkAccessManager>
+#include <QNetworkDiskCache>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPixmapCache>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QDebug>
+
+ImageService *ImageService::s_instance = nullptr;
+
+namespace {
+// QPixmapCache 默认 10 MB，放不下登录页大图和新闻配图
+constexpr int kPixmapCacheLimitKb = 64 * 1024;
+// 网络图片解码结果 LRU 上限
+constexpr int kNetworkImageCacheKb = 64 * 1024;
+// 网络图片磁盘缓存上限
+constexpr qint64 kDiskCacheBytes = 100 * 1024 * 1024;
+constexpr int kImageTransferTimeoutMs = 15000;
+
+QByteArray buildImageReferer(const QUrl &url)
+{
+    if (!url.isValid()) {
+        return {};
+    }
+
+    QUrl referer(url);
+    referer.setPath(QStringLiteral("/"));
+    referer.setQuery(QString());
+    referer.setFragment(QString());
+    return referer.toString().toUtf8();
+}
+}
+
+ImageService *ImageService::instance()
+{
+    if (!s_instance) {
+        s_instance = new ImageService();
+    }
+    return s_instance;
+}
+
+ImageService::ImageService(QObject *parent)
+    : QObject(parent)
+{
+    if (QPixmapCache::cacheLimit() < kPixmapCacheLimitKb) {
+        QPixmapCache::setCacheLimit(kPixmapCacheLimitKb);
+    }
+    m_networkImages.setMaxCost(kNetworkImageCacheKb);
+}
+
+QString ImageService::cacheKey(const QString &path, const QSize &targetSize)
+{
+    if (!targetSize.isValid()) {
+        return QStringLiteral("img:%1").arg(path);
+    }
+    return QStringLiteral("img:%1@%2x%3").arg(path).arg(targetSize.width()).arg(targetSize.height());
+}
+
+QPixmap ImageService::cachedPixmap(const QString &path, const QSize &targetSize) const
+{
+    QPixmap pixmap;
+    QPixmapCache::find(cacheKey(path, targetSize), &pixmap);
+    return pixmap;
+}
+
+void ImageService::prefetch(const QString &path, const QSize &targetSize)
+{
+    loadPixmap(path, targetSize, this, [](const QPixmap &) {});
+}
+
+void ImageService::loadPixmap(const QString &path, const QSize &targetSize,
+                              QObject *context, PixmapCallback callback)
+{
+    const QString key = cacheKey(path, targetSize);
+
+    QPixmap cached;
+    if (QPixmapCache::find(key, &cached)) {
+        if (callback) {
+            callback(cached);
+        }
+        return;
+    }
+
+    // 已有同 key 的解码任务：只登记回调
+    const bool alreadyDecoding = m_pending.contains(key);
+    m_pending[key].append({QPointer<QObject>(context), std::move(callback)});
+    if (alreadyDecoding) {
+        return;
+    }
+
+    QRunnable *task = QRunnable::create([this, key, path, targetSize]() {
+        const QImage image = decodeImage(path, targetSize);
+        QMetaObject::invokeMethod(this, [this, key, image]() {
+            onImageDecoded(key, image);
+        }, Qt::QueuedConnection);
+    });
+    QThreadPool::globalInstance()->start(task);
+}
+
+void ImageService::applyScaledSize(QImageReader &reader, const QSize &targetSize)
+{
+    // 按目标尺寸解码：PNG/JPEG 解码器可直接输出缩放结果，避免先解出整张大图
+    if (!targetSize.isValid()) {
+        return;
+    }
+    const QSize sourceSize = reader.size();
+    if (!sourceSize.isValid()) {
+        return;
+    }
+    const QSize scaled = sourceSize.scaled(targetSize, Qt::KeepAspectRatioByExpanding);
+    if (scaled.width() < sourceSize.width() && scaled.height() < sourceSize.height()) {
+        reader.setScaledSize(scaled);
+    }
+}
+
+QImage ImageService::decodeImage(const QString &path, const QSize &targetSize)
+{
+    QImageReader reader(path);
+    reader.setAutoTransform(true);
+    applyScaledSize(reader, targetSize);
+
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "[ImageService] 解码失败:" << path << reader.errorString();
+    }
+    return image;
+}
+
+QImage ImageService::decodeImageData(const QByteArray &data, const QSize &targetSize)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+
+    QImageReader reader(&buffer);
+    reader.setAutoTransform(true);
+    applyScaledSize(reader, targetSize);
+    return reader.read();
+}
+
+void ImageService::onImageDecoded(const QString &key, const QImage &image)
+{
+    QPixmap pixmap;
+    if (!image.isNull()) {
+        pixmap = QPixmap::fromImage(image);
+        QPixmapCache::insert(key, pixmap);
+    }
+
+    const QList<PendingCallback> callbacks = m_pending.take(key);
+    for (const PendingCallback &pending : callbacks) {
+        if (pending.context && pending.callback) {
+            pending.callback(pixmap);
+        }
+    }
+
+    if (!pixmap.isNull()) {
+        emit pixmapReady(key);
+    }
+}
+
+// ===== 网络图片 =====
+
+QImage ImageService::cachedNetworkImage(const QUrl &url, const QSize &targetSize) const
+{
+    const QImage *image = m_networkImages.object(cacheKey(url.toString(), targetSize));
+    return image ? *image : QImage();
+}
+
+void ImageService::loadNetworkImage(const QUrl &url, const QSize &targetSize,
+                                    QObject *context, ImageCallback callback)
+{
+    const QString key = cacheKey(url.toString(), targetSize);
+
+    if (const QImage *cached = m_networkImages.object(key)) {
+        if (callback) {
+            callback(*cached);
+        }
+        return;
+    }
+
+    const bool alreadyLoading = m_networkPending.contains(key);
+    m_networkPending[key].append({QPointer<QObject>(context), std::move(callback)});
+    if (alreadyLoading) {
+        return;
+    }
+
+    // 图片请求发往第三方站点，且需要挂磁盘缓存和管理器级 finished 信号，
+    // 这两者 SessionNetworkManager 都不允许，因此单独持有一个管理器
+    if (!m_networkManager) {
+        m_networkManager = new QNetworkAccessManager(this);
+        m_diskCache = new QNetworkDiskCache(this);
+        m_diskCache->setCacheDirectory(
+            QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/image_cache");
+        m_diskCache->setMaximumCacheSize(kDiskCacheBytes);
+        m_networkManager->setCache(m_diskCache);
+        connect(m_networkManager, &QNetworkAccessManager::finished,
+                this, &ImageService::onNetworkReplyFinished);
+    }
+
+    QNetworkRequest request(url);
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, NetworkRequestFactory::http2Enabled());
+#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
+    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
+                         QNetworkRequest::NoLessSafeRedirectPolicy);
+#endif
+    // 磁盘缓存新鲜时直接命中，过期时由 QNAM 发起 If-None-Match/If-Modified-Since 条件请求
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute,
+                         QNetworkRequest::PreferNetwork);
+    request.setAttribute(QNetworkRequest::CacheSaveControlAttribute, true);
+    request.setTransferTimeout(kImageTransferTimeoutMs);
+    request.setRawHeader("User-Agent",
+                         "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) "
+                         "AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0 Safari/537.36");
+    request.setRawHeader("Accept",
+                         "image/avif,image/webp,image/apng,image/svg+xml,image/*,*/*;q=0.8");
+    const QByteArray referer = buildImageReferer(url);
+    if (!referer.isEmpty()) {
+        request.setRawHeader("Referer", referer);
+    }
+
+    QNetworkReply *reply = m_networkManager->get(request);
+    reply->setProperty("imageKey", key);
+    reply->setProperty("targetSize", targetSize);
+}
+
+void ImageService::onNetworkReplyFinished(QNetworkReply *reply)
+{
+    const QString key = reply->property("imageKey").toString();
+    const QSize targetSize = reply->property("targetSize").toSize();
+
+    if (reply->error() != QNetworkReply::NoError) {
+        qWarning() << "[ImageService] 图片下载失败:" << reply->errorString()
+                   << "url:" << reply->url().toString();
+        reply->deleteLater();
+        finishNetworkRequest(key, QImage());
+        return;
+    }
+
+    const bool fromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+    const QByteArray data = reply->readAll();
+    reply->deleteLater();
+
+    if (fromCache) {
+        qDebug() << "[ImageService] 磁盘缓存命中:" << key;
+    }
+
+    QRunnable *task = QRunnable::create([this, key, data, targetSize]() {
+        const QImage image = decodeImageData(data, targetSize);
+        QMetaObject::invokeMethod(this, [this, key, image]() {
+            onNetworkImageDecoded(key, image);
+        }, Qt::QueuedConnection);
+    });
+    QThreadPool::globalInstance()->start(task);
+}
+
+void ImageService::onNetworkImageDecoded(const QString &key, const QImage &image)
+{
+    if (image.isNull()) {
+        qWarning() << "[ImageService] 网络图片解码失败:" << key;
+    } else {
+        const int costKb = qMax(1, static_cast<int>(image.sizeInBytes() / 1024));
+        m_networkImages.insert(key, new QImage(image), costKb);
+    }
+    finishNetworkRequest(key, image);
+}
+
+void ImageService::finishNetworkRequest(const QString &key, const QImage &image)
+{
+    const QList<PendingImageCallback> callbacks = m_networkPending.take(key);
+    for (const PendingImageCallback &pending : callbacks) {
+        if (pending.context && pending.callback) {
+            pending.callback(image);
+        }
+    }
+}
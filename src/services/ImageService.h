@@ -0,0 +1,117 @@
+#ifndef IMAGESERVICE_H
+#define IMAGESERVICE_H
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QList>
+#include <QPixmap>
+#include <QPointer>
+#include <QSize>
+#include <QString>
+#include <QUrl>
+#include <functional>
+
+class QImageReader;
+class QNetworkAccessManager;
+class QNetworkDiskCache;
+class QNetworkReply;
+
+/**
+ * @brief 图片服务 - 共享的异步解码 + 缓存
+ *
+ * 单例模式。
+ * - 本地/资源图片：线程池中用 QImageReader 按目标尺寸解码，
+ *   回到主线程转为 QPixmap 后写入 QPixmapCache。
+ * - 网络图片：经带 QNetworkDiskCache 的共享 QNetworkAccessManager 下载
+ *   （遵循 Cache-Control/ETag，过期后条件请求），线程池解码，
+ *   解码结果进入按字节计费的 LRU（QCache<QString, QImage>）。
+ * 同一 (地址, 尺寸) 的并发请求只下载/解码一次。
+ *
+ * 用法：
+ *   ImageService::instance()->loadPixmap(":/images/天安门.png", QSize(), label,
+ *       [label](const QPixmap &pixmap) { label->setPixmap(pixmap); });
+ */
+class ImageService : public QObject
+{
+    Q_OBJECT
+
+public:
+    using PixmapCallback = std::function<void(const QPixmap &pixmap)>;
+
+    static ImageService *instance();
+
+    /**
+     * @brief 异步加载图片
+     * @param path 文件路径或 Qt 资源路径（":/..."）
+     * @param targetSize 解码尺寸（保持宽高比并覆盖该区域），为空则按原尺寸解码
+     * @param context 回调的生命周期对象，销毁后回调不再触发
+     * @param callback 主线程回调；解码失败时参数为空 QPixmap
+     *
+     * 命中缓存时同步回调。
+     */
+    void loadPixmap(const QString &path, const QSize &targetSize,
+                    QObject *context, PixmapCallback callback);
+
+    // 仅查询缓存，不触发解码
+    QPixmap cachedPixmap(const QString &path, const QSize &targetSize = QSize()) const;
+
+    // 预热：提前解码进缓存（例如登录成功后预解码主界面图片）
+    void prefetch(const QString &path, const QSize &targetSize = QSize());
+
+    // ===== 网络图片 =====
+
+    using ImageCallback = std::function<void(const QImage &image)>;
+
+    /**
+     * @brief 异步加载网络图片（磁盘缓存 + 解码 LRU）
+     * @param url 图片地址（http/https）
+     * @param targetSize 解码尺寸（保持宽高比并覆盖该区域），为空则按原尺寸
+     * @param context 回调的生命周期对象
+     * @param callback 主线程回调；下载或解码失败时参数为空 QImage
+     *
+     * 命中内存 LRU 时同步回调。
+     */
+    void loadNetworkImage(const QUrl &url, const QSize &targetSize,
+                          QObject *context, ImageCallback callback);
+
+    // 仅查询内存 LRU
+    QImage cachedNetworkImage(const QUrl &url, const QSize &targetSize = QSize()) const;
+
+signals:
+    void pixmapReady(const QString &cacheKey);
+
+private:
+    explicit ImageService(QObject *parent = nullptr);
+
+    struct PendingCallback {
+        QPointer<QObject> context;
+        PixmapCallback callback;
+    };
+
+    struct PendingImageCallback {
+        QPointer<QObject> context;
+        ImageCallback callback;
+    };
+
+    static QString cacheKey(const QString &path, const QSize &targetSize);
+    static QImage decodeImage(const QString &path, const QSize &targetSize);
+    static QImage decodeImageData(const QByteArray &data, const QSize &targetSize);
+    static void applyScaledSize(QImageReader &reader, const QSize &targetSize);
+    void onImageDecoded(const QString &key, const QImage &image);
+
+    void onNetworkReplyFinished(QNetworkReply *reply);
+    void onNetworkImageDecoded(const QString &key, const QImage &image);
+    void finishNetworkRequest(const QString &key, const QImage &image);
+
+    static ImageService *s_instance;
+    QHash<QString, QList<PendingCallback>> m_pending;
+
+    QNetworkAccessManager *m_networkManager = nullptr;
+    QNetworkDiskCache *m_diskCache = nullptr;
+    QCache<QString, QImage> m_networkImages;  // cost = KB
+    QHash<QString, QList<PendingImageCallback>> m_networkPending;
+};
+
+#endif // IMAGESERVICE_H
@@ -0,0 +1,746 @@
+#include "MarkdownDocxConverter.h"
+#include <QList>
+#include <QStringList>
+#include <QStringView>
+#include <utility>
+
+namespace {
+
+// ==================== 前缀扫描 ====================
+// 以下函数与原先的正则逐条等价：\s、\d 只匹配 ASCII（QRegularExpression 默认行为）
+
+inline bool isRegexSpace(QChar c)
+{
+    const char16_t u = c.unicode();
+    return u == u' ' || (u >= 0x09 && u <= 0x0D);
+}
+
+inline bool isAsciiDigit(QChar c)
+{
+    return c.unicode() >= u'0' && c.unicode() <= u'9';
+}
+
+inline bool isOpenParen(QChar c)
+{
+    return c == u'(' || c == u'（';
+}
+
+inline bool isCloseParen(QChar c)
+{
+    return c == u')' || c == u'）';
+}
+
+inline qsizetype skipChar(QStringView s, qsizetype i, QChar ch)
+{
+    while (i < s.size() && s.at(i) == ch) {
+        ++i;
+    }
+    return i;
+}
+
+inline qsizetype skipSpaces(QStringView s, qsizetype i)
+{
+    while (i < s.size() && isRegexSpace(s.at(i))) {
+        ++i;
+    }
+    return i;
+}
+
+inline qsizetype skipDigits(QStringView s, qsizetype i)
+{
+    while (i < s.size() && isAsciiDigit(s.at(i))) {
+        ++i;
+    }
+    return i;
+}
+
+// ^(#{1,4})\s+(.+) —— 返回标题正文起点，不匹配返回 -1
+qsizetype markdownHeaderBody(QStringView line)
+{
+    const qsizetype hashes = skipChar(line, 0, u'#');
+    if (hashes < 1 || hashes > 4 || line.size() - hashes < 2 || !isRegexSpace(line.at(hashes))) {
+        return -1;
+    }
+    return hashes;
+}
+
+// ^[\*]*【答案】[\*]*\s*[:：]?\s*(.*) 及【解析】/【解释】 —— 返回 (.*) 的起点
+qsizetype labeledLineBody(QStringView line, bool analysis)
+{
+    qsizetype i = skipChar(line, 0, u'*');
+    const QStringView rest = line.mid(i);
+    const bool hasLabel = analysis
+        ? (rest.startsWith(u"【解析】") || rest.startsWith(u"【解释】"))
+        : rest.startsWith(u"【答案】");
+    if (!hasLabel) {
+        return -1;
+    }
+    i = skipChar(line, i + 4, u'*');
+    i = skipSpaces(line, i);
+    if (i < line.size() && (line.at(i) == u':' || line.at(i) == u'：')) {
+        ++i;
+    }
+    return skipSpaces(line, i);
+}
+
+// 全局答案区里的带题号行
+//   ^[\*]*[（(]?(\d+)[）)]?\s*[.、:：]?\s*【答案】\s*(.*)     （label = Answer/Analysis）
+//   ^[\*]*[（(]?(\d+)[）)]?\s*[.、:：]\s*(.+)                  （label = None）
+enum class AnswerLabel {
+    None,
+    Answer,
+    Analysis
+};
+
+bool matchNumberedAnswerLine(QStringView line, AnswerLabel label, QStringView *number, QStringView *body)
+{
+    qsizetype i = skipChar(line, 0, u'*');
+    if (i < line.size() && isOpenParen(line.at(i))) {
+        ++i;
+    }
+    const qsizetype digitsStart = i;
+    i = skipDigits(line, i);
+    if (i == digitsStart) {
+        return false;
+    }
+    *number = line.mid(digitsStart, i - digitsStart);
+    if (i < line.size() && isCloseParen(line.at(i))) {
+        ++i;
+    }
+    i = skipSpaces(line, i);
+
+    const bool hasPunct = i < line.size()
+        && (line.at(i) == u'.' || line.at(i) == u'、' || line.at(i) == u':' || line.at(i) == u'：');
+
+    if (label == AnswerLabel::None) {
+        if (!hasPunct || i + 1 >= line.size()) {
+            return false;
+        }
+        *body = line.mid(skipSpaces(line, i + 1));
+        return true;
+    }
+
+    if (hasPunct) {
+        ++i;
+    }
+    i = skipSpaces(line, i);
+    const QStringView rest = line.mid(i);
+    const bool hasLabel = label == AnswerLabel::Analysis
+        ? (rest.startsWith(u"【解析】") || rest.startsWith(u"【解释】"))
+        : rest.startsWith(u"【答案】");
+    if (!hasLabel) {
+        return false;
+    }
+    *body = line.mid(skipSpaces(line, i + 4));
+    return true;
+}
+
+// ^[\*]*(\d+)\s*[.、\)）]\s*[\*]*\s*(.+) —— 返回题干起点，不匹配返回 -1
+qsizetype numberedQuestionStem(QStringView line, QStringView *number)
+{
+    qsizetype i = skipChar(line, 0, u'*');
+    const qsizetype digitsStart = i;
+    i = skipDigits(line, i);
+    if (i == digitsStart) {
+        return -1;
+    }
+    const qsizetype digitsEnd = i;
+    i = skipSpaces(line, i);
+    if (i >= line.size()) {
+        return -1;
+    }
+    const QChar punct = line.at(i);
+    if (punct != u'.' && punct != u'、' && !isCloseParen(punct)) {
+        return -1;
+    }
+    if (++i >= line.size()) {
+        return -1;
+    }
+    if (number) {
+        *number = line.mid(digitsStart, digitsEnd - digitsStart);
+    }
+    i = skipSpaces(line, i);
+    i = skipChar(line, i, u'*');
+    return skipSpaces(line, i);
+}
+
+// ^[\*]*[（(]\s*(\d+)\s*[）)]\s*[\*]*\s*(.+) —— 返回题干起点，不匹配返回 -1
+qsizetype bracketQuestionStem(QStringView line, QStringView *number)
+{
+    qsizetype i = skipChar(line, 0, u'*');
+    if (i >= line.size() || !isOpenParen(line.at(i))) {
+        return -1;
+    }
+    i = skipSpaces(line, i + 1);
+    const qsizetype digitsStart = i;
+    i = skipDigits(line, i);
+    if (i == digitsStart) {
+        return -1;
+    }
+    const qsizetype digitsEnd = i;
+    i = skipSpaces(line, i);
+    if (i >= line.size() || !isCloseParen(line.at(i))) {
+        return -1;
+    }
+    if (++i >= line.size()) {
+        return -1;
+    }
+    if (number) {
+        *number = line.mid(digitsStart, digitsEnd - digitsStart);
+    }
+    i = skipSpaces(line, i);
+    i = skipChar(line, i, u'*');
+    return skipSpaces(line, i);
+}
+
+// ^\s*([A-Ha-h])\s*[.、\)）:：]\s*(.+) —— 返回选项正文起点，不匹配返回 -1
+qsizetype optionBody(QStringView line, QChar *label)
+{
+    qsizetype i = skipSpaces(line, 0);
+    if (i >= line.size()) {
+        return -1;
+    }
+    const char16_t letter = line.at(i).unicode();
+    if (!((letter >= u'A' && letter <= u'H') || (letter >= u'a' && letter <= u'h'))) {
+        return -1;
+    }
+    i = skipSpaces(line, i + 1);
+    if (i >= line.size()) {
+        return -1;
+    }
+    const QChar punct = line.at(i);
+    if (punct != u'.' && punct != u'、' && punct != u':' && punct != u'：' && !isCloseParen(punct)) {
+        return -1;
+    }
+    if (++i >= line.size()) {
+        return -1;
+    }
+    *label = QChar(letter).toUpper();
+    return skipSpaces(line, i);
+}
+
+// ^\*{2}(.+)\*{2}\s*$ —— 返回两侧 ** 之间的内容
+bool boldLineBody(QStringView line, QStringView *body)
+{
+    qsizetype end = line.size();
+    while (end > 0 && isRegexSpace(line.at(end - 1))) {
+        --end;
+    }
+    const QStringView text = line.first(end);
+    if (text.size() < 5 || !text.startsWith(u"**") || !text.endsWith(u"**")) {
+        return false;
+    }
+    *body = text.mid(2, text.size() - 4);
+    return true;
+}
+
+QString withoutStars(QStringView text)
+{
+    QString result = text.toString();
+    result.remove(QLatin1Char('*'));
+    return result;
+}
+
+QString stripInlineMarkdown(QStringView text)
+{
+    if (!text.contains(u'*')) {
+        return text.trimmed().toString();
+    }
+    return withoutStars(text).trimmed();
+}
+
+bool isSectionTitleText(QStringView text)
+{
+    static const QStringView kChineseNumerals = u"一二三四五六七八九十";
+    qsizetype n = 0;
+    while (n < text.size() && kChineseNumerals.contains(text.at(n))) {
+        ++n;
+    }
+    if (n > 0 && n + 1 < text.size()) {
+        const QChar punct = text.at(n);
+        if (punct == u'、' || punct == u'.' || punct == u'．') {
+            return true;
+        }
+    }
+
+    static const QStringView kPlainSections[] = {
+        u"选择题", u"多选题", u"判断题", u"判断说理题", u"填空题",
+        u"简答题", u"论述题", u"材料分析题", u"材料论述题", u"综合题"
+    };
+    for (QStringView prefix : kPlainSections) {
+        if (text.startsWith(prefix)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 大题标题（“一、选择题”“## 判断题”等），不是则返回空串
+QString sectionTitleOf(QStringView line)
+{
+    const qsizetype headerBody = markdownHeaderBody(line);
+    QStringView text = (headerBody >= 0 ? line.mid(headerBody) : line).trimmed();
+
+    QString unstarred;
+    if (text.contains(u'*')) {
+        unstarred = withoutStars(text);
+        text = QStringView(unstarred).trimmed();
+    }
+
+    return isSectionTitleText(text) ? text.toString() : QString();
+}
+
+bool isGlobalAnswerSectionHeader(QStringView line)
+{
+    // 三个候选标题都含“答”“析”，去掉标记只会删字符，先用它过滤掉绝大多数行
+    if (!line.contains(u'答') || !line.contains(u'析')) {
+        return false;
+    }
+
+    QStringView text = line.trimmed();
+    const qsizetype hashes = qMin<qsizetype>(skipChar(text, 0, u'#'), 4);
+    if (hashes > 0) {
+        text = text.mid(skipSpaces(text, hashes));
+    }
+    QString normalized = stripInlineMarkdown(text);
+    if (normalized.startsWith(QStringLiteral("【")) && normalized.endsWith(QStringLiteral("】")) && normalized.size() >= 2) {
+        normalized = normalized.mid(1, normalized.size() - 2).trimmed();
+    }
+    return normalized == QStringLiteral("参考答案与解析")
+        || normalized == QStringLiteral("答案与解析")
+        || normalized == QStringLiteral("答案和解析");
+}
+
+// 斜体注释行（AI 的尾注，如 *祝学习愉快！...* ）
+bool isSkippableCommentLine(QStringView line)
+{
+    if (!(line.startsWith(u'*') && line.endsWith(u'*')) || line.startsWith(u"**") || line.size() <= 2) {
+        return false;
+    }
+
+    const QStringView inner = line.mid(1, line.size() - 2);
+    return !inner.contains(u"**") && inner.size() > 10;
+}
+
+struct MarkdownQuestionBlock {
+    QString sectionTitle;
+    QString number;
+    QStringList answerLines;
+    QStringList analysisLines;
+
+    bool hasAnswerContent() const
+    {
+        return !answerLines.isEmpty() || !analysisLines.isEmpty();
+    }
+};
+
+int findQuestionBlockIndexByNumber(const QList<MarkdownQuestionBlock> &blocks, QStringView number)
+{
+    for (int i = 0; i < blocks.size(); ++i) {
+        if (blocks.at(i).number == number) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void appendContinuation(QStringList &entries, QStringView line)
+{
+    const QString text = stripInlineMarkdown(line);
+    if (text.isEmpty()) {
+        return;
+    }
+
+    if (entries.isEmpty()) {
+        entries.append(text);
+        return;
+    }
+
+    entries.last().append(QLatin1Char(' ') + text);
+}
+
+// ==================== WordprocessingML 写出 ====================
+
+class OoxmlWriter
+{
+public:
+    explicit OoxmlWriter(qsizetype reserveChars)
+    {
+        m_out.reserve(reserveChars);
+    }
+
+    QString take() { return std::move(m_out); }
+
+    void raw(QStringView xml) { m_out.append(xml); }
+
+    // 转义 XML 特殊字符；dropStars 时顺带去掉 Markdown 的 * 标记
+    void text(QStringView text, bool dropStars = false)
+    {
+        qsizetype runStart = 0;
+        for (qsizetype i = 0; i < text.size(); ++i) {
+            QStringView entity;
+            switch (text.at(i).unicode()) {
+            case u'&': entity = u"&amp;"; break;
+            case u'<': entity = u"&lt;"; break;
+            case u'>': entity = u"&gt;"; break;
+            case u'"': entity = u"&quot;"; break;
+            case u'\'': entity = u"&apos;"; break;
+            case u'*':
+                if (!dropStars) {
+                    continue;
+                }
+                break;
+            default:
+                continue;
+            }
+            m_out.append(text.mid(runStart, i - runStart));
+            m_out.append(entity);
+            runStart = i + 1;
+        }
+        m_out.append(text.mid(runStart));
+    }
+
+    void titleParagraph(QStringView title)
+    {
+        raw(u"<w:p>\n<w:pPr><w:pStyle w:val=\"Title\"/></w:pPr>\n<w:r><w:t>");
+        text(title);
+        raw(u"</w:t></w:r>\n</w:p>\n");
+    }
+
+    void headingParagraph(QStringView heading, bool dropStars)
+    {
+        raw(u"<w:p>\n<w:pPr><w:pStyle w:val=\"Heading1\"/></w:pPr>\n<w:r><w:t>");
+        text(heading, dropStars);
+        raw(u"</w:t></w:r>\n</w:p>\n");
+    }
+
+    void answerHeading(QStringView number)
+    {
+        raw(u"<w:p>\n<w:pPr><w:pStyle w:val=\"Question\"/><w:spacing w:before=\"240\" w:after=\"80\"/></w:pPr>\n"
+            u"<w:r><w:rPr><w:b/></w:rPr><w:t>第");
+        text(number);
+        raw(u"题</w:t></w:r>\n</w:p>\n");
+    }
+
+    // 与原 markdownLineToXml 相同的判定顺序
+    void markdownLine(QStringView line)
+    {
+        // ---- Markdown 标题 → Heading1 ----
+        const qsizetype headerBody = markdownHeaderBody(line);
+        if (headerBody >= 0) {
+            headingParagraph(line.mid(headerBody).trimmed(), true);
+            return;
+        }
+
+        const QString sectionTitle = sectionTitleOf(line);
+        if (!sectionTitle.isEmpty()) {
+            headingParagraph(sectionTitle, false);
+            return;
+        }
+
+        // ---- 【答案】行 → 绿色加粗 ----
+        qsizetype body = labeledLineBody(line, false);
+        if (body >= 0) {
+            raw(u"<w:p>\n<w:pPr><w:spacing w:before=\"120\" w:after=\"60\"/></w:pPr>\n"
+                u"<w:r><w:rPr><w:b/><w:color w:val=\"2E7D32\"/></w:rPr><w:t>【答案】");
+            text(line.mid(body).trimmed(), true);
+            raw(u"</w:t></w:r>\n</w:p>\n");
+            return;
+        }
+
+        // ---- 【解析】行 → 灰色 ----
+        body = labeledLineBody(line, true);
+        if (body >= 0) {
+            raw(u"<w:p>\n<w:pPr><w:spacing w:before=\"60\" w:after=\"200\"/></w:pPr>\n"
+                u"<w:r><w:rPr><w:b/><w:color w:val=\"666666\"/></w:rPr><w:t>【解析】</w:t></w:r>\n"
+                u"<w:r><w:rPr><w:color w:val=\"666666\"/><w:sz w:val=\"22\"/></w:rPr><w:t>");
+            text(line.mid(body).trimmed(), true);
+            raw(u"</w:t></w:r>\n</w:p>\n");
+            return;
+        }
+
+        // ---- 选项行 A. B. C. D. → 缩进 ----
+        QChar optionLabel;
+        body = optionBody(line, &optionLabel);
+        if (body >= 0) {
+            raw(u"<w:p>\n<w:pPr><w:pStyle w:val=\"Option\"/></w:pPr>\n<w:r><w:t>");
+            text(QStringView(&optionLabel, 1));
+            raw(u". ");
+            text(line.mid(body).trimmed());
+            raw(u"</w:t></w:r>\n</w:p>\n");
+            return;
+        }
+
+        // ---- 带编号的题目行（**1.** 或 1. 等）→ 加粗 ----
+        QStringView number;
+        body = numberedQuestionStem(line, &number);
+        if (body >= 0) {
+            raw(u"<w:p>\n<w:pPr><w:pStyle w:val=\"Question\"/></w:pPr>\n<w:r><w:rPr><w:b/></w:rPr><w:t>");
+            text(number);
+            raw(u". </w:t></w:r>\n<w:r><w:t>");
+            text(line.mid(body).trimmed(), true);
+            raw(u"</w:t></w:r>\n</w:p>\n");
+            return;
+        }
+
+        body = bracketQuestionStem(line, &number);
+        if (body >= 0) {
+            raw(u"<w:p>\n<w:pPr><w:pStyle w:val=\"Question\"/></w:pPr>\n<w:r><w:rPr><w:b/></w:rPr><w:t>（");
+            text(number);
+            raw(u"）</w:t></w:r>\n<w:r><w:t>");
+            text(line.mid(body).trimmed(), true);
+            raw(u"</w:t></w:r>\n</w:p>\n");
+            return;
+        }
+
+        // ---- 纯加粗行 **text** → 加粗段落 ----
+        QStringView boldText;
+        if (boldLineBody(line, &boldText)) {
+            raw(u"<w:p>\n<w:pPr><w:spacing w:before=\"200\" w:after=\"100\"/></w:pPr>\n<w:r><w:rPr><w:b/></w:rPr><w:t>");
+            text(boldText.trimmed());
+            raw(u"</w:t></w:r>\n</w:p>\n");
+            return;
+        }
+
+        // ---- 普通文本段落（去掉行内 ** 标记）----
+        raw(u"<w:p>\n<w:r><w:t>");
+        text(line, true);
+        raw(u"</w:t></w:r>\n</w:p>\n");
+    }
+
+private:
+    QString m_out;
+};
+
+} // namespace
+
+QString MarkdownDocxConverter::toDocumentXml(const QString &title, const QString &markdownText)
+{
+    // 段落标签的膨胀大约是正文的 2~3 倍，一次预留到位避免反复扩容
+    OoxmlWriter writer(markdownText.size() * 3 + 4096);
+
+    writer.raw(u"<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+               u"<w:document xmlns:w=\"http://schemas.openxmlformats.org/wordprocessingml/2006/main\">\n"
+               u"<w:body>\n");
+
+    // 文档标题
+    writer.titleParagraph(title);
+
+    // 副标题（日期 + 提示）
+    writer.raw(u"<w:p>\n<w:pPr><w:jc w:val=\"center\"/><w:spacing w:after=\"400\"/></w:pPr>\n"
+               u"<w:r><w:rPr><w:color w:val=\"999999\"/><w:sz w:val=\"22\"/></w:rPr>\n"
+               u"<w:t>AI 智能出题  |  道德与法治</w:t></w:r>\n</w:p>\n");
+
+    // ---- 逐题扫描：题目正文直接写出，答案/解析按题暂存，避免内联答案把后续题目错误吞入答案区 ----
+    QList<MarkdownQuestionBlock> questionBlocks;
+    bool skipThinkBlock = false;
+    bool foundFirstContent = false;
+    QString currentSectionTitle;
+    int currentQuestionIndex = -1;
+    int currentAnswerQuestionIndex = -1;
+    bool inGlobalAnswerSection = false;
+    AnswerLabel answerState = AnswerLabel::None;
+
+    const QStringView source(markdownText);
+    qsizetype lineStart = 0;
+    while (lineStart <= source.size()) {
+        qsizetype lineEnd = source.indexOf(u'\n', lineStart);
+        if (lineEnd < 0) {
+            lineEnd = source.size();
+        }
+        const QStringView line = source.mid(lineStart, lineEnd - lineStart).trimmed();
+        lineStart = lineEnd + 1;
+
+        // 跳过 <think> 块
+        if (line.startsWith(u"<think>")) { skipThinkBlock = true; continue; }
+        if (line.startsWith(u"</think>")) { skipThinkBlock = false; continue; }
+        if (skipThinkBlock) continue;
+
+        // 跳过空行、分割线、斜体注释行
+        if (line.isEmpty()) continue;
+        if (line.startsWith(u"---")) continue;
+        if (isSkippableCommentLine(line)) continue;
+
+        if (isGlobalAnswerSectionHeader(line)) {
+            inGlobalAnswerSection = true;
+            answerState = AnswerLabel::None;
+            currentAnswerQuestionIndex = -1;
+            continue;
+        }
+
+        const QString sectionTitle = sectionTitleOf(line);
+
+        if (inGlobalAnswerSection) {
+            if (!sectionTitle.isEmpty()) {
+                continue;
+            }
+
+            QStringView number;
+            QStringView body;
+            if (matchNumberedAnswerLine(line, AnswerLabel::Answer, &number, &body)) {
+                currentAnswerQuestionIndex = findQuestionBlockIndexByNumber(questionBlocks, number);
+                if (currentAnswerQuestionIndex >= 0) {
+                    questionBlocks[currentAnswerQuestionIndex].answerLines.append(stripInlineMarkdown(body));
+                    answerState = AnswerLabel::Answer;
+                }
+                continue;
+            }
+
+            if (matchNumberedAnswerLine(line, AnswerLabel::Analysis, &number, &body)) {
+                currentAnswerQuestionIndex = findQuestionBlockIndexByNumber(questionBlocks, number);
+                if (currentAnswerQuestionIndex >= 0) {
+                    questionBlocks[currentAnswerQuestionIndex].analysisLines.append(stripInlineMarkdown(body));
+                    answerState = AnswerLabel::Analysis;
+                }
+                continue;
+            }
+
+            if (currentAnswerQuestionIndex >= 0) {
+                qsizetype labeled = labeledLineBody(line, false);
+                if (labeled >= 0) {
+                    questionBlocks[currentAnswerQuestionIndex].answerLines.append(
+                        stripInlineMarkdown(line.mid(labeled)));
+                    answerState = AnswerLabel::Answer;
+                    continue;
+                }
+
+                labeled = labeledLineBody(line, true);
+                if (labeled >= 0) {
+                    questionBlocks[currentAnswerQuestionIndex].analysisLines.append(
+                        stripInlineMarkdown(line.mid(labeled)));
+                    answerState = AnswerLabel::Analysis;
+                    continue;
+                }
+            }
+
+            if (matchNumberedAnswerLine(line, AnswerLabel::None, &number, &body)) {
+                currentAnswerQuestionIndex = findQuestionBlockIndexByNumber(questionBlocks, number);
+                if (currentAnswerQuestionIndex >= 0) {
+                    questionBlocks[currentAnswerQuestionIndex].answerLines.append(stripInlineMarkdown(body));
+                    answerState = AnswerLabel::Answer;
+                }
+                continue;
+            }
+
+            if (currentAnswerQuestionIndex >= 0 && answerState == AnswerLabel::Answer) {
+                appendContinuation(questionBlocks[currentAnswerQuestionIndex].answerLines, line);
+            } else if (currentAnswerQuestionIndex >= 0 && answerState == AnswerLabel::Analysis) {
+                appendContinuation(questionBlocks[currentAnswerQuestionIndex].analysisLines, line);
+            }
+            continue;
+        }
+
+        const bool allowBracketedQuestion = currentQuestionIndex < 0
+            || questionBlocks[currentQuestionIndex].hasAnswerContent();
+
+        QStringView questionNumber;
+        const bool isQuestionStart = numberedQuestionStem(line, &questionNumber) >= 0
+            || (allowBracketedQuestion && bracketQuestionStem(line, &questionNumber) >= 0);
+
+        if (!foundFirstContent) {
+            const bool anyQuestionStart = isQuestionStart || bracketQuestionStem(line, nullptr) >= 0;
+            if (!sectionTitle.isEmpty() || anyQuestionStart) {
+                foundFirstContent = true;
+            } else {
+                continue;
+            }
+        }
+
+        if (!sectionTitle.isEmpty()) {
+            currentSectionTitle = sectionTitle;
+            answerState = AnswerLabel::None;
+            writer.markdownLine(sectionTitle);
+            continue;
+        }
+
+        if (isQuestionStart) {
+            MarkdownQuestionBlock block;
+            block.sectionTitle = currentSectionTitle;
+            block.number = questionNumber.toString();
+            questionBlocks.append(block);
+            currentQuestionIndex = questionBlocks.size() - 1;
+            answerState = AnswerLabel::None;
+            writer.markdownLine(line);
+            continue;
+        }
+
+        if (currentQuestionIndex < 0) {
+            writer.markdownLine(line);
+            continue;
+        }
+
+        qsizetype labeled = labeledLineBody(line, false);
+        if (labeled >= 0) {
+            questionBlocks[currentQuestionIndex].answerLines.append(stripInlineMarkdown(line.mid(labeled)));
+            answerState = AnswerLabel::Answer;
+            continue;
+        }
+
+        labeled = labeledLineBody(line, true);
+        if (labeled >= 0) {
+            questionBlocks[currentQuestionIndex].analysisLines.append(stripInlineMarkdown(line.mid(labeled)));
+            answerState = AnswerLabel::Analysis;
+            continue;
+        }
+
+        if (answerState == AnswerLabel::Answer) {
+            appendContinuation(questionBlocks[currentQuestionIndex].answerLines, line);
+            continue;
+        }
+
+        if (answerState == AnswerLabel::Analysis) {
+            appendContinuation(questionBlocks[currentQuestionIndex].analysisLines, line);
+            continue;
+        }
+
+        writer.markdownLine(line);
+    }
+
+    // ---- 答案区：有答案/解析时分页后统一输出 ----
+    bool hasAnyAnswers = false;
+    for (const MarkdownQuestionBlock &block : questionBlocks) {
+        if (block.hasAnswerContent()) {
+            hasAnyAnswers = true;
+            break;
+        }
+    }
+
+    if (hasAnyAnswers) {
+        writer.raw(u"<w:p>\n<w:r><w:br w:type=\"page\"/></w:r>\n</w:p>\n");
+        writer.titleParagraph(u"参考答案与解析");
+
+        QString lastRenderedSectionTitle;
+        QString labeledLine;
+        for (int i = 0; i < questionBlocks.size(); ++i) {
+            const MarkdownQuestionBlock &block = questionBlocks.at(i);
+            if (!block.hasAnswerContent()) {
+                continue;
+            }
+
+            if (!block.sectionTitle.isEmpty() && block.sectionTitle != lastRenderedSectionTitle) {
+                writer.markdownLine(block.sectionTitle);
+                lastRenderedSectionTitle = block.sectionTitle;
+            }
+
+            writer.answerHeading(block.number.isEmpty() ? QString::number(i + 1) : block.number);
+
+            for (const QString &answerLine : block.answerLines) {
+                labeledLine = QStringLiteral("【答案】");
+                labeledLine += answerLine;
+                writer.markdownLine(labeledLine);
+            }
+            for (const QString &analysisLine : block.analysisLines) {
+                labeledLine = QStringLiteral("【解析】");
+                labeledLine += analysisLine;
+                writer.markdownLine(labeledLine);
+            }
+        }
+    }
+
+    writer.raw(u"\n<w:sectPr>\n<w:pgSz w:w=\"11906\" w:h=\"16838\"/>\n"
+               u"<w:pgMar w:top=\"1440\" w:right=\"1440\" w:bottom=\"1440\" w:left=\"1440\"/>\n"
+               u"</w:sectPr>\n</w:body>\n</w:document>");
+
+    return writer.take();
+}
@@ -0,0 +1,26 @@
+#ifndef MARKDOWNDOCXCONVERTER_H
+#define MARKDOWNDOCXCONVERTER_H
+
+#include <QString>
+
+/**
+ * @brief AI 试卷 Markdown → word/document.xml 转换器
+ *
+ * 逐行用手写的前缀扫描器分类（标题、大题、题目、选项、【答案】、【解析】……），
+ * 不再对每行依次跑一串正则；段落 XML 直接追加进一个预留好容量的缓冲区，
+ * 题目正文边扫描边写出，只有答案/解析需要暂存到文末统一输出。
+ *
+ * 只依赖 QtCore，DocxGenerator 和基准程序共用。
+ */
+class MarkdownDocxConverter
+{
+public:
+    /**
+     * @brief 生成完整的 document.xml 内容
+     * @param title 文档标题
+     * @param markdownText AI 输出的 Markdown 源文本
+     */
+    static QString toDocumentXml(const QString &title, const QString &markdownText);
+};
+
+#endif // MARKDOWNDOCXCONVERTER_H
@@ -1,8 +1,10 @@
 #include "PaperService.h"
 #include "../auth/supabase/supabaseconfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include "../utils/NetworkRetryHelper.h"
 #include "../utils/FailedTaskTracker.h"
+#include "../utils/Metrics.h"
 #include <QNetworkRequest>
 #include <QUrlQuery>
 #include <QDebug>
@@ -181,7 +183,7 @@ QJsonObject PaperQuestion::toJson() const
 // ===== PaperService 实现 =====
 PaperService::PaperService(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
     , m_failedTaskTracker(new FailedTaskTracker(this))
 {
 }
@@ -270,9 +272,8 @@ void PaperService::deleteQuestion(const QString &questionId)
 }
 
 // ===== 题目检索 =====
-void PaperService::searchQuestions(const QuestionSearchCriteria &criteria)
+QStringList PaperService::buildSearchFilters(const QuestionSearchCriteria &criteria) const
 {
-    QString endpoint = "/rest/v1/questions?";
     QStringList filters;
 
     // 可见性筛选（默认只查询公共题库）
@@ -325,6 +326,14 @@ void PaperService::searchQuestions(const QuestionSearchCriteria &criteria)
         filters.append(QString("stem=ilike.*%1*").arg(criteria.keyword));
     }
 
+    return filters;
+}
+
+void PaperService::searchQuestions(const QuestionSearchCriteria &criteria)
+{
+    QString endpoint = "/rest/v1/questions?";
+    const QStringList filters = buildSearchFilters(criteria);
+
     endpoint += filters.join("&");
 
     // 添加排序
@@ -343,6 +352,7 @@ void PaperService::searchQuestions(const QuestionSearchCriteria &criteria)
 
     QNetworkReply *reply = m_networkManager->get(request);
     if (reply) {
+        reply->setProperty("metricsStartNs", Metrics::nowNs());
         reply->setProperty("requestType", static_cast<int>(RequestType::SearchQuestions));
         connect(reply, &QNetworkReply::finished, this, [this, reply]() {
             onReplyFinished(reply);
@@ -350,6 +360,82 @@ void PaperService::searchQuestions(const QuestionSearchCriteria &criteria)
     }
 }
 
+void PaperService::searchQuestionsPage(const QuestionSearchCriteria &criteria,
+                                       const QString &requestTag)
+{
+    QStringList filters = buildSearchFilters(criteria);
+
+    // keyset 条件: (created_at, id) < (cursor.createdAt, cursor.id)
+    if (!criteria.after.isNull()) {
+        const QString createdAt = QString::fromUtf8(
+            QUrl::toPercentEncoding(criteria.after.createdAt));
+        const QString id = QString::fromUtf8(QUrl::toPercentEncoding(criteria.after.id));
+        filters.append(QString("or=(created_at.lt.\"%1\",and(created_at.eq.\"%1\",id.lt.\"%2\"))")
+                           .arg(createdAt, id));
+    }
+
+    // 多取一条用于判断是否还有下一页，无需 count
+    const int limit = qMax(1, criteria.limit);
+    filters.append("order=created_at.desc,id.desc");
+    filters.append(QString("limit=%1").arg(limit + 1));
+
+    const QString endpoint = "/rest/v1/questions?" + filters.join("&");
+    QNetworkRequest request = NetworkRequestFactory::createSupabaseRequest(endpoint, m_accessToken, false);
+
+    qDebug() << "PaperService 游标分页:" << (SupabaseConfig::supabaseUrl() + endpoint);
+
+    QNetworkReply *reply = m_networkManager->get(request);
+    if (reply) {
+        reply->setProperty("metricsStartNs", Metrics::nowNs());
+        reply->setProperty("requestType", static_cast<int>(RequestType::SearchQuestionsPage));
+        reply->setProperty("requestTag", requestTag);
+        reply->setProperty("pageLimit", limit);
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+            onReplyFinished(reply);
+        });
+    }
+}
+
+void PaperService::countQuestions(const QuestionSearchCriteria &criteria, bool estimated)
+{
+    const QString filterKey = searchFilterKey(criteria);
+
+    // 命中缓存直接返回（精确值可满足估算请求，反之不行）
+    auto it = m_countCache.constFind(filterKey);
+    if (it != m_countCache.constEnd()
+        && QDateTime::currentMSecsSinceEpoch() - it->fetchedAtMs < COUNT_CACHE_TTL_MS
+        && (estimated || !it->estimated)) {
+        emit questionCountLoaded(filterKey, it->total, it->estimated);
+        return;
+    }
+
+    const QString endpoint = "/rest/v1/questions?select=id&" + filterKey;
+    QNetworkRequest request = NetworkRequestFactory::createSupabaseRequest(endpoint, m_accessToken, false);
+    request.setRawHeader("Range", "0-0");
+    request.setRawHeader("Prefer", estimated ? "count=estimated" : "count=exact");
+
+    QNetworkReply *reply = m_networkManager->head(request);
+    if (reply) {
+        reply->setProperty("metricsStartNs", Metrics::nowNs());
+        reply->setProperty("requestType", static_cast<int>(RequestType::CountQuestions));
+        reply->setProperty("filterKey", filterKey);
+        reply->setProperty("estimated", estimated);
+        connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+            onReplyFinished(reply);
+        });
+    }
+}
+
+void PaperService::invalidateQuestionCount()
+{
+    m_countCache.clear();
+}
+
+QString PaperService::searchFilterKey(const QuestionSearchCriteria &criteria) const
+{
+    return buildSearchFilters(criteria).join("&");
+}
+
 // ===== 私有方法 =====
 void PaperService::sendRequest(const QString &endpoint, RequestType type,
                                const QJsonDocument &data, const QString &method)
@@ -365,7 +451,9 @@ void PaperService::sendRequest(const QString &endpoint, RequestType type,
         auto *retryHelper = new NetworkRetryHelper(m_networkManager, {}, this);
         connect(retryHelper, &NetworkRetryHelper::retrying,
                 this, &PaperService::requestRetrying);
-        connect(retryHelper, &NetworkRetryHelper::finished, this, [this, type, retryHelper, endpoint, method, data](QNetworkReply *reply) {
+        const qint64 startNs = Metrics::nowNs();  // 含重试等待
+        connect(retryHelper, &NetworkRetryHelper::finished, this, [this, type, retryHelper, endpoint, method, data, startNs](QNetworkReply *reply) {
+            reply->setProperty("metricsStartNs", startNs);
             reply->setProperty("requestType", static_cast<int>(type));
 
             // 如果重试后仍失败，记录到 FailedTaskTracker
@@ -389,6 +477,7 @@ void PaperService::sendRequest(const QString &endpoint, RequestType type,
     // GET 请求直接发送，不重试
     QNetworkReply *reply = m_networkManager->get(request);
     if (reply) {
+        reply->setProperty("metricsStartNs", Metrics::nowNs());
         reply->setProperty("requestType", static_cast<int>(type));
         connect(reply, &QNetworkReply::finished, this, [this, reply]() {
             onReplyFinished(reply);
@@ -401,8 +490,35 @@ void PaperService::onReplyFinished(QNetworkReply *reply)
     if (!reply) return;
 
     RequestType type = static_cast<RequestType>(reply->property("requestType").toInt());
-    
+
+    const QVariant startNs = reply->property("metricsStartNs");
+    if (startNs.isValid()) {
+        const char *spanName = "paper.read";
+        switch (type) {
+        case RequestType::SearchQuestions:
+        case RequestType::SearchQuestionsPage:
+            spanName = "paper.search";
+            break;
+        case RequestType::CountQuestions:
+            spanName = "paper.count";
+            break;
+        case RequestType::CreatePaper:
+        case RequestType::UpdatePaper:
+        case RequestType::DeletePaper:
+        case RequestType::AddQuestion:
+        case RequestType::AddQuestions:
+        case RequestType::UpdateQuestion:
+        case RequestType::DeleteQuestion:
+            spanName = "paper.write";
+            break;
+        default:
+            break;
+        }
+        Metrics::instance().recordSpan(spanName, startNs.toLongLong());
+    }
+
     if (reply->error() != QNetworkReply::NoError) {
+        METRICS_COUNT("paper.errors");
         QString errorMsg = reply->errorString();
         int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
         QByteArray errorData = reply->readAll();
@@ -420,6 +536,13 @@ void PaperService::onReplyFinished(QNetworkReply *reply)
         case RequestType::DeletePaper:
             emit paperError("network", QString("%1 (HTTP %2)").arg(errorMsg).arg(httpStatus));
             break;
+        case RequestType::SearchQuestionsPage:
+            emit questionPageFailed(reply->property("requestTag").toString(),
+                                    QString("%1 (HTTP %2)").arg(errorMsg).arg(httpStatus));
+            break;
+        case RequestType::CountQuestions:
+            // 总数只是辅助信息，失败不打扰用户
+            break;
         default:
             emit questionError("network", QString("%1 (HTTP %2)").arg(errorMsg).arg(httpStatus));
             break;
@@ -435,6 +558,28 @@ void PaperService::onReplyFinished(QNetworkReply *reply)
 
 void PaperService::handleResponse(QNetworkReply *reply, RequestType type)
 {
+    // HEAD 计数请求没有响应体，只解析 Content-Range: "0-0/150" 或 "*/150"
+    if (type == RequestType::CountQuestions) {
+        const QString filterKey = reply->property("filterKey").toString();
+        const bool estimated = reply->property("estimated").toBool();
+        const QString contentRange = QString::fromUtf8(reply->rawHeader("Content-Range"));
+        const int slashIdx = contentRange.indexOf('/');
+        bool ok = false;
+        const int total = slashIdx >= 0 ? contentRange.mid(slashIdx + 1).toInt(&ok) : 0;
+        if (!ok) {
+            qDebug() << "PaperService 计数响应缺少 Content-Range:" << contentRange;
+            return;
+        }
+
+        CachedCount cached;
+        cached.total = total;
+        cached.estimated = estimated;
+        cached.fetchedAtMs = QDateTime::currentMSecsSinceEpoch();
+        m_countCache.insert(filterKey, cached);
+        emit questionCountLoaded(filterKey, total, estimated);
+        return;
+    }
+
     QByteArray data = reply->readAll();
     int httpStatus = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
     
@@ -487,6 +632,7 @@ void PaperService::handleResponse(QNetworkReply *reply, RequestType type)
         break;
     }
     case RequestType::AddQuestion: {
+        m_countCache.clear();
         if (doc.isArray() && !doc.array().isEmpty()) {
             PaperQuestion question = PaperQuestion::fromJson(doc.array().first().toObject());
             emit questionAdded(question);
@@ -494,6 +640,7 @@ void PaperService::handleResponse(QNetworkReply *reply, RequestType type)
         break;
     }
     case RequestType::AddQuestions: {
+        m_countCache.clear();
         if (doc.isArray()) {
             emit questionsAdded(doc.array().size());
         }
@@ -527,6 +674,31 @@ void PaperService::handleResponse(QNetworkReply *reply, RequestType type)
         }
         break;
     }
+    case RequestType::SearchQuestionsPage: {
+        const QString requestTag = reply->property("requestTag").toString();
+        const int limit = reply->property("pageLimit").toInt();
+        const QJsonArray rows = doc.array();
+        const bool hasMore = rows.size() > limit;
+        const int pageSize = hasMore ? limit : rows.size();
+
+        QList<PaperQuestion> questions;
+        questions.reserve(pageSize);
+        for (int i = 0; i < pageSize; ++i) {
+            questions.append(PaperQuestion::fromJson(rows.at(i).toObject()));
+        }
+
+        // 游标取原始 JSON 字段，避免 QDateTime 截断微秒导致翻页重复/遗漏
+        QuestionPageCursor nextCursor;
+        if (hasMore && pageSize > 0) {
+            const QJsonObject last = rows.at(pageSize - 1).toObject();
+            nextCursor.createdAt = last["created_at"].toString();
+            nextCursor.id = last["id"].toString();
+        }
+        emit questionPageLoaded(requestTag, questions, nextCursor, hasMore);
+        break;
+    }
+    case RequestType::CountQuestions:
+        break;  // 已在函数开头处理
     case RequestType::GetQuestionById: {
         if (doc.isArray() && !doc.array().isEmpty()) {
             PaperQuestion question = PaperQuestion::fromJson(doc.array().first().toObject());
@@ -542,6 +714,7 @@ void PaperService::handleResponse(QNetworkReply *reply, RequestType type)
         break;
     }
     case RequestType::DeleteQuestion: {
+        m_countCache.clear();
         emit questionDeleted("");
         break;
     }
@@ -8,6 +8,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDateTime>
+#include <QHash>
 
 class FailedTaskTracker;
 
@@ -58,6 +59,14 @@ struct PaperQuestion {
     QJsonObject toJson() const;
 };
 
+// 游标分页位置：按 (created_at, id) 降序定位下一页的起点
+struct QuestionPageCursor {
+    QString createdAt;  // 原始 created_at 字符串（保留数据库微秒精度，不经 QDateTime 转换）
+    QString id;
+
+    bool isNull() const { return id.isEmpty(); }
+};
+
 // 题目检索条件
 struct QuestionSearchCriteria {
     QString questionType;
@@ -73,8 +82,11 @@ struct QuestionSearchCriteria {
     QStringList knowledgePoints;
 
     // 分页
-    int offset = 0;           // 分页偏移
+    int offset = 0;           // 分页偏移（searchQuestions 使用）
     int limit = 30;            // 每页数量
+
+    // 游标分页（searchQuestionsPage 使用，为空表示第一页）
+    QuestionPageCursor after;
 };
 
 class PaperService : public QObject
@@ -106,6 +118,26 @@ public:
     // ===== 题目检索 =====
     void searchQuestions(const QuestionSearchCriteria &criteria);
 
+    /**
+     * @brief 游标分页检索（keyset: created_at desc, id desc）
+     *
+     * 不请求总数，也不使用 OFFSET，深页与首页代价相同。
+     * 结果通过 questionPageLoaded 返回，requestTag 原样带回用于区分调用方。
+     */
+    void searchQuestionsPage(const QuestionSearchCriteria &criteria, const QString &requestTag);
+
+    /**
+     * @brief 查询筛选条件下的题目总数（独立 HEAD 请求，结果按筛选条件缓存）
+     * @param estimated true 使用 count=estimated（大表走统计信息），false 使用 count=exact
+     */
+    void countQuestions(const QuestionSearchCriteria &criteria, bool estimated = true);
+
+    // 清空总数缓存（题库增删后调用）
+    void invalidateQuestionCount();
+
+    // 筛选条件的规范化键（questionCountLoaded 的 filterKey）
+    QString searchFilterKey(const QuestionSearchCriteria &criteria) const;
+
 signals:
     // 试卷相关信号
     void paperCreated(const Paper &paper);
@@ -127,6 +159,10 @@ signals:
     // 检索结果
     void searchCompleted(const QList<PaperQuestion> &results);
     void searchCompletedWithTotal(const QList<PaperQuestion> &results, int total);
+    void questionPageLoaded(const QString &requestTag, const QList<PaperQuestion> &results,
+                            const QuestionPageCursor &nextCursor, bool hasMore);
+    void questionPageFailed(const QString &requestTag, const QString &error);
+    void questionCountLoaded(const QString &filterKey, int total, bool estimated);
 
     // 重试通知
     void requestRetrying(int attempt, int maxRetries);
@@ -152,9 +188,20 @@ private:
         GetQuestionById,
         UpdateQuestion,
         DeleteQuestion,
-        SearchQuestions
+        SearchQuestions,
+        SearchQuestionsPage,
+        CountQuestions
     };
 
+    // 总数缓存条目
+    struct CachedCount {
+        int total = 0;
+        bool estimated = true;
+        qint64 fetchedAtMs = 0;
+    };
+    static constexpr qint64 COUNT_CACHE_TTL_MS = 60 * 1000;
+    QHash<QString, CachedCount> m_countCache;
+
     // 发送请求
     void sendRequest(const QString &endpoint, RequestType type, 
                     const QJsonDocument &data = QJsonDocument(), 
@@ -163,6 +210,9 @@ private:
     // 处理响应
     void handleResponse(QNetworkReply *reply, RequestType type);
 
+    // 构建检索筛选条件（searchQuestions / searchQuestionsPage / countQuestions 共用）
+    QStringList buildSearchFilters(const QuestionSearchCriteria &criteria) const;
+
     // 解析数据
     Paper parsePaper(const QJsonObject &json);
     PaperQuestion parseQuestion(const QJsonObject &json);
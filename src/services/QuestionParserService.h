@@ -120,12 +120,12 @@ private:
      */
     void handleSseEvent(const QString &event, const QJsonObject &obj);
 
+public:
     /**
-     * @brief 解析 Dify 返回的 JSON 结果
+     * @brief 解析 Dify 返回的 JSON 结果（容忍 <think> 块、代码围栏和入库报告格式）
      */
     QList<PaperQuestion> parseJsonResponse(const QString &jsonText);
 
-public:
     /**
      * @brief 本地解析 Markdown 格式的试题文本为 PaperQuestion 列表
      * 
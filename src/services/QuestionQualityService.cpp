@@ -1,5 +1,6 @@
 #include "QuestionQualityService.h"
 #include "DifyService.h"
+#include "../utils/TextSimilarity.h"
 #include <QDebug>
 #include <QJsonDocument>
 #include <QJsonObject>
@@ -85,72 +86,6 @@ QuestionQualityService::QuestionQualityService(PaperService *paperService,
     });
 }
 
-// ==================== 文本相似度算法 ====================
-
-QSet<QString> QuestionQualityService::extractBigrams(const QString &text) const
-{
-    QSet<QString> bigrams;
-    QString cleaned = text.simplified().remove(' ');
-    for (int i = 0; i < cleaned.length() - 1; ++i) {
-        bigrams.insert(cleaned.mid(i, 2));
-    }
-    return bigrams;
-}
-
-double QuestionQualityService::jaccardBigram(const QString &textA, const QString &textB) const
-{
-    QSet<QString> bigramsA = extractBigrams(textA);
-    QSet<QString> bigramsB = extractBigrams(textB);
-
-    if (bigramsA.isEmpty() && bigramsB.isEmpty()) return 1.0;
-    if (bigramsA.isEmpty() || bigramsB.isEmpty()) return 0.0;
-
-    QSet<QString> intersection = bigramsA;
-    intersection.intersect(bigramsB);
-
-    QSet<QString> unionSet = bigramsA;
-    unionSet.unite(bigramsB);
-
-    return static_cast<double>(intersection.size()) / unionSet.size();
-}
-
-int QuestionQualityService::editDistance(const QString &a, const QString &b) const
-{
-    int m = a.length();
-    int n = b.length();
-
-    // 对超长文本截断，避免 O(m*n) 爆内存
-    const int MAX_LEN = 500;
-    QString sa = a.left(MAX_LEN);
-    QString sb = b.left(MAX_LEN);
-    m = sa.length();
-    n = sb.length();
-
-    QVector<int> prev(n + 1), curr(n + 1);
-    for (int j = 0; j <= n; ++j) prev[j] = j;
-
-    for (int i = 1; i <= m; ++i) {
-        curr[0] = i;
-        for (int j = 1; j <= n; ++j) {
-            int cost = (sa[i - 1] == sb[j - 1]) ? 0 : 1;
-            curr[j] = std::min({prev[j] + 1, curr[j - 1] + 1, prev[j - 1] + cost});
-        }
-        std::swap(prev, curr);
-    }
-    return prev[n];
-}
-
-double QuestionQualityService::computeSimilarity(const QString &textA, const QString &textB) const
-{
-    // 混合指标: 0.6 * Jaccard + 0.4 * (1 - 编辑距离/maxLen)
-    double jaccard = jaccardBigram(textA, textB);
-
-    int maxLen = qMax(textA.length(), textB.length());
-    double editSim = (maxLen == 0) ? 1.0 : (1.0 - static_cast<double>(editDistance(textA, textB)) / maxLen);
-
-    return 0.6 * jaccard + 0.4 * editSim;
-}
-
 // ==================== Level 1: 文本去重 ====================
 
 QList<QuestionQualityService::DuplicateCandidate>
@@ -163,7 +98,7 @@ QuestionQualityService::findSimilarQuestions(const PaperQuestion &question,
     for (const auto &q : pool) {
         if (q.id == question.id) continue;  // 跳过自己
 
-        double sim = computeSimilarity(question.stem, q.stem);
+        double sim = TextSimilarity::similarity(question.stem, q.stem);
         if (sim >= threshold) {
             candidates.append({q.id, q.stem, sim});
         }
@@ -268,7 +203,7 @@ void QuestionQualityService::processScanChunk()
         emit libraryScanProgress(i + 1, total);
 
         for (int j = i + 1; j < total; ++j) {
-            double sim = computeSimilarity(m_scanQuestions[i].stem, m_scanQuestions[j].stem);
+            double sim = TextSimilarity::similarity(m_scanQuestions[i].stem, m_scanQuestions[j].stem);
             if (sim >= 0.7) {
                 m_scanDuplicates.append({m_scanQuestions[i].id, m_scanQuestions[j].id});
             }
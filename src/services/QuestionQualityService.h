@@ -77,12 +77,6 @@ signals:
     void errorOccurred(const QString &operation, const QString &error);
 
 private:
-    // 文本相似度算法
-    double computeSimilarity(const QString &textA, const QString &textB) const;
-    double jaccardBigram(const QString &textA, const QString &textB) const;
-    int editDistance(const QString &a, const QString &b) const;
-    QSet<QString> extractBigrams(const QString &text) const;
-
     // AI 请求管理
     void sendAIRequest(const QString &prompt, const QString &operation,
                        const QString &questionId);
@@ -0,0 +1,573 @@
+#include "ResumableUploadService.h"
+#include "../auth/supabase/supabaseconfig.h"
+#include "../utils/Metrics.h"
+#include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QTimer>
+#include <QUuid>
+
+namespace {
+    // 文件中一段 [offset, offset + length) 的只读窗口，作为 PATCH 请求体直接从磁盘流式读取
+    class FileChunkDevice : public QIODevice
+    {
+    public:
+        FileChunkDevice(const QString &path, qint64 offset, qint64 length)
+            : m_file(path), m_offset(offset), m_length(length) {}
+
+        bool open(OpenMode mode) override {
+            if (!m_file.open(QIODevice::ReadOnly) || !m_file.seek(m_offset)) {
+                return false;
+            }
+            return QIODevice::open(mode);
+        }
+
+        void close() override {
+            m_file.close();
+            QIODevice::close();
+        }
+
+        qint64 size() const override { return m_length; }
+        bool isSequential() const override { return false; }
+
+        bool seek(qint64 pos) override {
+            if (pos < 0 || pos > m_length || !m_file.seek(m_offset + pos)) {
+                return false;
+            }
+            return QIODevice::seek(pos);
+        }
+
+    protected:
+        qint64 readData(char *data, qint64 maxSize) override {
+            const qint64 remaining = m_offset + m_length - m_file.pos();
+            if (remaining <= 0) {
+                return 0;
+            }
+            return m_file.read(data, qMin(maxSize, remaining));
+        }
+
+        qint64 writeData(const char *, qint64) override { return -1; }
+
+    private:
+        QFile m_file;
+        qint64 m_offset;
+        qint64 m_length;
+    };
+
+    QByteArray metadataPair(const char *key, const QString &value) {
+        return QByteArray(key) + ' ' + value.toUtf8().toBase64();
+    }
+}
+
+ResumableUploadService *ResumableUploadService::s_instance = nullptr;
+
+ResumableUploadService *ResumableUploadService::instance()
+{
+    if (!s_instance) s_instance = new ResumableUploadService();
+    return s_instance;
+}
+
+ResumableUploadService::ResumableUploadService(QObject *parent)
+    : QObject(parent)
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
+    , m_rateTimer(new QTimer(this))
+{
+    m_rateTimer->setInterval(1000);
+    connect(m_rateTimer, &QTimer::timeout, this, &ResumableUploadService::onRateTick);
+}
+
+// ===== 公共接口 =====
+
+QString ResumableUploadService::enqueue(const UploadRequest &request)
+{
+    QFileInfo info(request.localPath);
+    if (!info.isFile() || !info.isReadable()) {
+        qWarning() << "[ResumableUpload] 无法读取文件:" << request.localPath;
+        emit uploadFailed(QString(), "无法读取文件: " + info.fileName(), request.context);
+        return QString();
+    }
+
+    Task task;
+    task.id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    task.localPath = info.absoluteFilePath();
+    task.bucket = request.bucket;
+    task.objectPath = request.objectPath;
+    task.contentType = request.contentType.isEmpty() ? "application/octet-stream" : request.contentType;
+    task.context = request.context;
+    task.fileSize = info.size();
+    task.lastModifiedMs = info.lastModified().toMSecsSinceEpoch();
+
+    // 先把检查点里上次遗留的任务读进来，否则下面的保存会把它们覆盖掉
+    restoreCheckpoint();
+    m_tasks.insert(task.id, task);
+    m_queue.enqueue(task.id);
+    m_batchBytesTotal += task.fileSize;
+    saveCheckpoint();
+
+    qDebug() << "[ResumableUpload] 加入队列:" << info.fileName() << task.fileSize << "bytes";
+    startNext();
+    return task.id;
+}
+
+int ResumableUploadService::resumePending()
+{
+    // 上次运行遗留在检查点里的任务以 Failed 状态载入，和本次运行中重试用尽的任务一起重新排队
+    restoreCheckpoint();
+
+    int resumed = 0;
+    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+        if (it->state == State::Failed) {
+            it->state = State::Queued;
+            m_queue.enqueue(it->id);
+            m_batchBytesTotal += it->fileSize;
+            resumed++;
+        }
+    }
+
+    saveCheckpoint();
+    if (resumed > 0) {
+        qDebug() << "[ResumableUpload] 恢复上传任务:" << resumed;
+        startNext();
+    }
+    return resumed;
+}
+
+int ResumableUploadService::resumePendingOnce()
+{
+    if (m_pendingResumed) return 0;
+    m_pendingResumed = true;
+    return resumePending();
+}
+
+void ResumableUploadService::cancel(QString taskId)
+{
+    auto it = m_tasks.find(taskId);
+    if (it == m_tasks.end()) return;
+
+    Task task = it.value();
+    m_tasks.erase(it);
+    m_queue.removeAll(taskId);
+    if (task.state == State::Running || task.state == State::Waiting) {
+        m_activeCount--;
+    }
+    if (task.state != State::Failed) {
+        m_batchBytesTotal -= task.fileSize;
+    }
+    if (task.reply) {
+        task.reply->abort();
+    }
+
+    // 通知服务端释放未完成的上传（TUS termination），失败无妨
+    if (!task.uploadUrl.isEmpty()) {
+        QNetworkReply *reply = m_networkManager->deleteResource(tusRequest(QUrl(task.uploadUrl)));
+        connect(reply, &QNetworkReply::finished, reply, &QObject::deleteLater);
+    }
+
+    saveCheckpoint();
+    qDebug() << "[ResumableUpload] 已取消:" << task.localPath;
+    startNext();
+}
+
+void ResumableUploadService::setMaxParallel(int count)
+{
+    m_maxParallel = qMax(1, count);
+    startNext();
+}
+
+// ===== 调度 =====
+
+void ResumableUploadService::startNext()
+{
+    while (m_activeCount < m_maxParallel && !m_queue.isEmpty()) {
+        const QString id = m_queue.dequeue();
+        if (!m_tasks.contains(id)) continue;
+        m_activeCount++;
+        runTask(id);
+    }
+
+    if (m_activeCount > 0 && !m_rateTimer->isActive()) {
+        m_lastSampleMs = QDateTime::currentMSecsSinceEpoch();
+        m_lastSampleBytes = bytesDone();
+        m_smoothedRate = 0.0;
+        m_rateTimer->start();
+    }
+
+    // 本批次全部结束：补发最终统计，重置计数
+    if (m_activeCount == 0 && m_queue.isEmpty() && m_rateTimer->isActive()) {
+        m_rateTimer->stop();
+        onRateTick();
+        m_batchBytesTotal = 0;
+        m_batchBytesFinished = 0;
+        emit allUploadsFinished();
+    }
+}
+
+void ResumableUploadService::runTask(const QString &taskId)
+{
+    Task &task = m_tasks[taskId];
+    task.state = State::Running;
+
+    if (!fileUnchanged(task)) {
+        failTask(taskId, "本地文件已被修改", false);
+        return;
+    }
+    if (task.uploadUrl.isEmpty()) {
+        createUpload(task);
+    } else {
+        probeOffset(task);
+    }
+}
+
+void ResumableUploadService::createUpload(Task &task)
+{
+    QNetworkRequest request = tusRequest(QUrl(SupabaseConfig::supabaseUrl() + "/storage/v1/upload/resumable"));
+    request.setRawHeader("Upload-Length", QByteArray::number(task.fileSize));
+    request.setRawHeader("Upload-Metadata", QByteArrayList{
+        metadataPair("bucketName", task.bucket),
+        metadataPair("objectName", task.objectPath),
+        metadataPair("contentType", task.contentType),
+        metadataPair("cacheControl", "3600"),
+    }.join(','));
+    request.setRawHeader("x-upsert", "true");
+
+    QNetworkReply *reply = m_networkManager->post(request, QByteArray());
+    task.reply = reply;
+    const QString id = task.id;
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, id]() {
+        reply->deleteLater();
+        auto it = m_tasks.find(id);
+        if (it == m_tasks.end() || it->reply != reply) return;  // 已取消
+        it->reply = nullptr;
+
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        const QByteArray location = reply->rawHeader("Location");
+        if (reply->error() == QNetworkReply::NoError && status == 201 && !location.isEmpty()) {
+            it->uploadUrl = reply->url().resolved(QUrl(QString::fromUtf8(location))).toString();
+            it->offset = 0;
+            it->attempts = 0;
+            saveCheckpoint();
+            sendChunk(*it);
+            return;
+        }
+        failTask(id, QString("创建上传失败 (%1): %2").arg(status).arg(QString::fromUtf8(reply->readAll().left(200))),
+                 isRetryable(reply));
+    });
+}
+
+void ResumableUploadService::probeOffset(Task &task)
+{
+    QNetworkReply *reply = m_networkManager->head(tusRequest(QUrl(task.uploadUrl)));
+    task.reply = reply;
+    const QString id = task.id;
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, id]() {
+        reply->deleteLater();
+        auto it = m_tasks.find(id);
+        if (it == m_tasks.end() || it->reply != reply) return;
+        it->reply = nullptr;
+
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status == 404 || status == 410) {
+            // 上传地址已过期（Supabase 保留 24 小时），从头重新创建
+            qDebug() << "[ResumableUpload] 上传地址已失效，重新开始:" << it->localPath;
+            it->uploadUrl.clear();
+            it->offset = 0;
+            createUpload(*it);
+            return;
+        }
+        if (reply->error() == QNetworkReply::NoError && reply->hasRawHeader("Upload-Offset")) {
+            const qint64 offset = reply->rawHeader("Upload-Offset").toLongLong();
+            if (offset < 0 || offset > it->fileSize) {
+                it->uploadUrl.clear();
+                it->offset = 0;
+                createUpload(*it);
+                return;
+            }
+            it->offset = offset;
+            it->attempts = 0;
+            saveCheckpoint();
+            sendChunk(*it);
+            return;
+        }
+        failTask(id, QString("查询上传进度失败 (%1)").arg(status), isRetryable(reply));
+    });
+}
+
+void ResumableUploadService::sendChunk(Task &task)
+{
+    if (task.offset >= task.fileSize) {
+        completeTask(task.id);
+        return;
+    }
+
+    const qint64 length = qMin(CHUNK_SIZE, task.fileSize - task.offset);
+    auto *device = new FileChunkDevice(task.localPath, task.offset, length);
+    if (!device->open(QIODevice::ReadOnly)) {
+        delete device;
+        failTask(task.id, "无法读取文件", false);
+        return;
+    }
+
+    QNetworkRequest request = tusRequest(QUrl(task.uploadUrl));
+    request.setRawHeader("Upload-Offset", QByteArray::number(task.offset));
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/offset+octet-stream");
+    request.setHeader(QNetworkRequest::ContentLengthHeader, length);
+
+    QNetworkReply *reply = m_networkManager->sendCustomRequest(request, "PATCH", device);
+    device->setParent(reply);
+    task.reply = reply;
+    task.inFlight = 0;
+    const QString id = task.id;
+
+    connect(reply, &QNetworkReply::uploadProgress, this, [this, reply, id](qint64 sent, qint64) {
+        auto it = m_tasks.find(id);
+        if (it == m_tasks.end() || it->reply != reply) return;
+        it->inFlight = sent;
+        emit uploadProgress(id, it->offset + sent, it->fileSize);
+    });
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, id, length]() {
+        reply->deleteLater();
+        auto it = m_tasks.find(id);
+        if (it == m_tasks.end() || it->reply != reply) return;
+        it->reply = nullptr;
+        it->inFlight = 0;
+
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (reply->error() == QNetworkReply::NoError && (status == 204 || status == 200)) {
+            const qint64 offset = reply->hasRawHeader("Upload-Offset")
+                ? reply->rawHeader("Upload-Offset").toLongLong()
+                : it->offset + length;
+            METRICS_COUNT_N("upload.bytes", qMax<qint64>(0, offset - it->offset));
+            it->offset = offset;
+            it->attempts = 0;
+            saveCheckpoint();
+            emit uploadProgress(id, it->offset, it->fileSize);
+            sendChunk(*it);
+            return;
+        }
+        if (status == 409) {
+            // 偏移与服务端不一致（上次分块可能已部分落盘），重新查询
+            probeOffset(*it);
+            return;
+        }
+        if (status == 404 || status == 410) {
+            it->uploadUrl.clear();
+            it->offset = 0;
+            createUpload(*it);
+            return;
+        }
+        failTask(id, QString("分块上传失败 (%1): %2").arg(status).arg(reply->errorString()),
+                 isRetryable(reply));
+    });
+}
+
+void ResumableUploadService::completeTask(QString taskId)
+{
+    const Task task = m_tasks.take(taskId);
+    m_activeCount--;
+    m_batchBytesFinished += task.fileSize;
+    saveCheckpoint();
+
+    qDebug() << "[ResumableUpload] 上传完成:" << task.objectPath << task.fileSize << "bytes";
+    emit uploadFinished(task.id, task.bucket, task.objectPath, task.fileSize, task.context);
+    startNext();
+}
+
+void ResumableUploadService::failTask(QString taskId, const QString &error, bool retryable)
+{
+    auto it = m_tasks.find(taskId);
+    if (it == m_tasks.end()) return;
+    it->inFlight = 0;
+
+    if (retryable && it->attempts + 1 < MAX_ATTEMPTS) {
+        it->attempts++;
+        it->state = State::Waiting;
+        const int delayMs = qMin(30000, 1000 << (it->attempts - 1));
+        qWarning() << "[ResumableUpload]" << error << "，" << delayMs << "ms 后重试，第" << it->attempts << "次";
+        METRICS_COUNT("upload.retries");
+
+        QTimer::singleShot(delayMs, this, [this, taskId]() {
+            auto it = m_tasks.find(taskId);
+            if (it == m_tasks.end() || it->state != State::Waiting) return;
+            it->state = State::Running;
+            // 重试前先向服务端确认偏移，上一个分块可能已经部分写入
+            if (it->uploadUrl.isEmpty()) {
+                createUpload(*it);
+            } else {
+                probeOffset(*it);
+            }
+        });
+        return;
+    }
+
+    // 重试用尽：保留在检查点中，等待 resumePending()；本地文件已变化的任务无法续传，直接移除
+    m_activeCount--;
+    m_batchBytesTotal -= it->fileSize;
+    const QJsonObject context = it->context;
+    qWarning() << "[ResumableUpload] 上传失败:" << it->localPath << error;
+    if (fileUnchanged(*it)) {
+        it->state = State::Failed;
+        it->attempts = 0;
+    } else {
+        m_tasks.erase(it);
+    }
+    saveCheckpoint();
+
+    emit uploadFailed(taskId, error, context);
+    startNext();
+}
+
+QNetworkRequest ResumableUploadService::tusRequest(const QUrl &url) const
+{
+    QNetworkRequest request = NetworkRequestFactory::createGeneralRequest(
+        url, NetworkRequestFactory::TIMEOUT_FILE_UPLOAD);
+    request.setRawHeader("Tus-Resumable", "1.0.0");
+    NetworkRequestFactory::applySupabaseAuth(request);
+    return request;
+}
+
+bool ResumableUploadService::isRetryable(QNetworkReply *reply)
+{
+    const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status == 0) {
+        // 连接中断、超时（取消的任务在回调里已提前返回，到这里的 OperationCanceled 都是超时）
+        return true;
+    }
+    return status == 408 || status == 429 || status >= 500;
+}
+
+bool ResumableUploadService::fileUnchanged(const Task &task) const
+{
+    QFileInfo info(task.localPath);
+    return info.isFile()
+        && info.size() == task.fileSize
+        && info.lastModified().toMSecsSinceEpoch() == task.lastModifiedMs;
+}
+
+// ===== 检查点 =====
+
+QString ResumableUploadService::checkpointPath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/uploads/checkpoint.json";
+}
+
+void ResumableUploadService::saveCheckpoint() const
+{
+    QJsonArray tasks;
+    for (const Task &task : m_tasks) {
+        QJsonObject obj;
+        obj["id"] = task.id;
+        obj["local_path"] = task.localPath;
+        obj["bucket"] = task.bucket;
+        obj["object_path"] = task.objectPath;
+        obj["content_type"] = task.contentType;
+        obj["context"] = task.context;
+        obj["file_size"] = task.fileSize;
+        obj["last_modified_ms"] = task.lastModifiedMs;
+        obj["upload_url"] = task.uploadUrl;
+        obj["offset"] = task.offset;
+        tasks.append(obj);
+    }
+
+    const QString path = checkpointPath();
+    if (tasks.isEmpty()) {
+        QFile::remove(path);
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[ResumableUpload] 无法写入检查点:" << path;
+        return;
+    }
+    file.write(QJsonDocument(QJsonObject{{"version", 1}, {"tasks", tasks}}).toJson(QJsonDocument::Compact));
+    file.commit();
+}
+
+void ResumableUploadService::restoreCheckpoint()
+{
+    if (m_checkpointRestored) return;
+    m_checkpointRestored = true;
+
+    for (const Task &saved : loadCheckpoint()) {
+        if (m_tasks.contains(saved.id)) continue;
+        if (!fileUnchanged(saved)) {
+            qWarning() << "[ResumableUpload] 本地文件已变化，放弃续传:" << saved.localPath;
+            emit uploadFailed(saved.id, "本地文件已变化，无法续传", saved.context);
+            continue;
+        }
+        Task task = saved;
+        task.state = State::Failed;   // 等待 resumePending() 重新排队
+        m_tasks.insert(task.id, task);
+    }
+}
+
+QList<ResumableUploadService::Task> ResumableUploadService::loadCheckpoint() const
+{
+    QList<Task> result;
+    QFile file(checkpointPath());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return result;
+    }
+
+    const QJsonArray tasks = QJsonDocument::fromJson(file.readAll()).object().value("tasks").toArray();
+    for (const QJsonValue &value : tasks) {
+        const QJsonObject obj = value.toObject();
+        Task task;
+        task.id = obj["id"].toString();
+        task.localPath = obj["local_path"].toString();
+        task.bucket = obj["bucket"].toString();
+        task.objectPath = obj["object_path"].toString();
+        task.contentType = obj["content_type"].toString();
+        task.context = obj["context"].toObject();
+        task.fileSize = obj["file_size"].toVariant().toLongLong();
+        task.lastModifiedMs = obj["last_modified_ms"].toVariant().toLongLong();
+        task.uploadUrl = obj["upload_url"].toString();
+        task.offset = obj["offset"].toVariant().toLongLong();
+        if (!task.id.isEmpty() && !task.localPath.isEmpty()) {
+            result.append(task);
+        }
+    }
+    return result;
+}
+
+// ===== 吞吐统计 =====
+
+qint64 ResumableUploadService::bytesDone() const
+{
+    qint64 done = m_batchBytesFinished;
+    for (const Task &task : m_tasks) {
+        if (task.state != State::Failed) {
+            done += task.offset + task.inFlight;
+        }
+    }
+    return done;
+}
+
+void ResumableUploadService::onRateTick()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 done = bytesDone();
+    const qint64 elapsed = now - m_lastSampleMs;
+    if (elapsed > 0) {
+        const double rate = (done - m_lastSampleBytes) * 1000.0 / elapsed;
+        m_smoothedRate = m_smoothedRate <= 0.0 ? rate : 0.7 * m_smoothedRate + 0.3 * rate;
+    }
+    m_lastSampleMs = now;
+    m_lastSampleBytes = done;
+
+    emit throughputUpdated(static_cast<qint64>(qMax(0.0, m_smoothedRate)), done,
+                           qMax(done, m_batchBytesTotal), m_activeCount, m_queue.size());
+}
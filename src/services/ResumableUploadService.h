@@ -0,0 +1,144 @@
+#ifndef RESUMABLEUPLOADSERVICE_H
+#define RESUMABLEUPLOADSERVICE_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+
+class QNetworkReply;
+class QTimer;
+
+/**
+ * @brief 大文件分块、可断点续传的上传服务（Supabase Storage TUS 协议）
+ *
+ * - 流式：每个分块用只读窗口设备直接从磁盘读取，不把整个文件读进内存
+ * - 分块：固定 6MB（Supabase 的要求），每块确认后更新偏移
+ * - 并行：同时上传的文件数有上限，其余排队
+ * - 续传：上传地址和已确认偏移写入检查点文件，网络错误按指数退避重试，
+ *         重试用尽或应用重启后调用 resumePending() 先 HEAD 查询服务端偏移再继续
+ * - 吞吐：每秒汇总一次所有任务的已传字节和速率
+ *
+ * 调用方可在 context 中附带任意数据（如数据库记录字段），随检查点持久化，
+ * 完成时原样返回，重启续传后也能完成后续步骤。
+ */
+class ResumableUploadService : public QObject
+{
+    Q_OBJECT
+
+public:
+    static ResumableUploadService *instance();
+
+    struct UploadRequest {
+        QString localPath;
+        QString bucket;
+        QString objectPath;
+        QString contentType;
+        QJsonObject context;
+    };
+
+    static constexpr qint64 CHUNK_SIZE = 6 * 1024 * 1024;
+    static constexpr int DEFAULT_MAX_PARALLEL = 3;
+    static constexpr int MAX_ATTEMPTS = 5;              // 单个请求的重试上限
+
+    /**
+     * @brief 加入上传队列
+     * @return 任务 ID（文件无法读取时返回空串，并发出 uploadFailed）
+     */
+    QString enqueue(const UploadRequest &request);
+
+    /**
+     * @brief 从检查点恢复未完成和失败的任务（本地文件已改动的任务直接丢弃）
+     * @return 恢复的任务数
+     */
+    int resumePending();
+
+    /**
+     * @brief 同 resumePending()，但每个进程只执行一次（供页面初始化时调用）
+     * @return 恢复的任务数，已执行过时返回 0
+     */
+    int resumePendingOnce();
+
+    void cancel(QString taskId);
+
+    void setMaxParallel(int count);
+    int maxParallel() const { return m_maxParallel; }
+
+    int activeCount() const { return m_activeCount; }
+    int queuedCount() const { return m_queue.size(); }
+
+signals:
+    void uploadProgress(const QString &taskId, qint64 bytesSent, qint64 bytesTotal);
+    void uploadFinished(const QString &taskId, const QString &bucket, const QString &objectPath,
+                        qint64 fileSize, const QJsonObject &context);
+    void uploadFailed(const QString &taskId, const QString &error, const QJsonObject &context);
+    void throughputUpdated(qint64 bytesPerSecond, qint64 bytesDone, qint64 bytesTotal,
+                           int activeCount, int queuedCount);
+    void allUploadsFinished();
+
+private:
+    enum class State { Queued, Running, Waiting, Failed };
+
+    struct Task {
+        QString id;
+        QString localPath;
+        QString bucket;
+        QString objectPath;
+        QString contentType;
+        QJsonObject context;
+        qint64 fileSize = 0;
+        qint64 lastModifiedMs = 0;
+        QString uploadUrl;          // TUS 上传地址（创建后才有）
+        qint64 offset = 0;          // 服务端已确认的字节数
+        qint64 inFlight = 0;        // 当前分块已发送的字节数
+        State state = State::Queued;
+        int attempts = 0;
+        QNetworkReply *reply = nullptr;
+    };
+
+    explicit ResumableUploadService(QObject *parent = nullptr);
+    static ResumableUploadService *s_instance;
+
+    // 调度
+    void startNext();
+    void runTask(const QString &taskId);
+    void createUpload(Task &task);
+    void probeOffset(Task &task);
+    void sendChunk(Task &task);
+    // 任务 ID 按值传入：调用方常传 task.id，任务从 m_tasks 移除后引用会悬空
+    void completeTask(QString taskId);
+    void failTask(QString taskId, const QString &error, bool retryable);
+
+    QNetworkRequest tusRequest(const QUrl &url) const;
+    static bool isRetryable(QNetworkReply *reply);
+    bool fileUnchanged(const Task &task) const;
+
+    // 检查点
+    QString checkpointPath() const;
+    void saveCheckpoint() const;
+    QList<Task> loadCheckpoint() const;
+    void restoreCheckpoint();           // 首次调用时把检查点中的任务载入 m_tasks
+
+    // 吞吐统计
+    void onRateTick();
+    qint64 bytesDone() const;
+
+    QNetworkAccessManager *m_networkManager;
+    QHash<QString, Task> m_tasks;
+    QQueue<QString> m_queue;
+    int m_maxParallel = DEFAULT_MAX_PARALLEL;
+    int m_activeCount = 0;
+    bool m_checkpointRestored = false;
+    bool m_pendingResumed = false;
+
+    QTimer *m_rateTimer;
+    qint64 m_batchBytesTotal = 0;        // 本批次总字节
+    qint64 m_batchBytesFinished = 0;     // 本批次已完成任务的字节
+    qint64 m_lastSampleBytes = 0;
+    qint64 m_lastSampleMs = 0;
+    double m_smoothedRate = 0.0;
+};
+
+#endif // RESUMABLEUPLOADSERVICE_H
@@ -1,6 +1,7 @@
 #include "SupabaseStorageService.h"
 #include "../auth/supabase/supabaseconfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QNetworkRequest>
 #include <QHttpMultiPart>
 #include <QEventLoop>
@@ -11,7 +12,7 @@
 
 SupabaseStorageService::SupabaseStorageService(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
     , m_bucketName("question-images")
 {
 }
@@ -60,8 +61,7 @@ void SupabaseStorageService::uploadImageAsync(const QByteArray &imageData, const
     qDebug() << "[SupabaseStorageService] 异步上传图片到:" << uploadUrl;
 
     QNetworkRequest request = NetworkRequestFactory::createGeneralRequest(QUrl(uploadUrl), 30000);
-    request.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
-    request.setRawHeader("Authorization", QString("Bearer %1").arg(SupabaseConfig::supabaseAnonKey()).toUtf8());
+    NetworkRequestFactory::applySupabaseAuth(request);
     request.setRawHeader("Content-Type", mimeType.toUtf8());
     request.setRawHeader("x-upsert", "true");
 
@@ -189,8 +189,7 @@ QString SupabaseStorageService::uploadImage(const QByteArray &imageData,
     qDebug() << "[SupabaseStorageService] 上传图片到:" << uploadUrl;
 
     QNetworkRequest request = NetworkRequestFactory::createGeneralRequest(QUrl(uploadUrl), 30000);
-    request.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
-    request.setRawHeader("Authorization", QString("Bearer %1").arg(SupabaseConfig::supabaseAnonKey()).toUtf8());
+    NetworkRequestFactory::applySupabaseAuth(request);
     request.setRawHeader("Content-Type", mimeType.toUtf8());
     request.setRawHeader("x-upsert", "true");
 
@@ -1,4 +1,5 @@
 #include "XunfeiPPTService.h"
+#include "../utils/Metrics.h"
 #include <QJsonDocument>
 #include <QJsonArray>
 #include <QNetworkRequest>
@@ -80,6 +81,7 @@ void XunfeiPPTService::generatePPT(const QString &query, const QString &author,
     m_progressErrorCount = 0;
     m_progressMissingUrlCount = 0;
     m_progressTimer->stop();
+    m_generateStartNs = Metrics::nowNs();
     emit generationStarted();
     emit progressUpdated(0, "正在创建 PPT 生成任务...");
     
@@ -124,8 +126,11 @@ void XunfeiPPTService::onCreateReply()
     if (m_cancelled) {
         return;
     }
-    
+
+    Metrics::instance().recordSpan("ppt.xunfei.create", m_generateStartNs);
+
     if (reply->error() != QNetworkReply::NoError) {
+        METRICS_COUNT("ppt.xunfei.errors");
         emit errorOccurred(QString("网络错误: %1").arg(reply->errorString()));
         return;
     }
@@ -259,6 +264,7 @@ void XunfeiPPTService::onProgressReply()
         if (!pptUrl.isEmpty()) {
             m_progressTimer->stop();
             qDebug() << "[XunfeiPPTService] PPT generated:" << pptUrl;
+            Metrics::instance().recordSpan("ppt.xunfei.generate", m_generateStartNs);
             emit generationFinished(pptUrl, coverUrl);
         } else {
             m_progressMissingUrlCount++;
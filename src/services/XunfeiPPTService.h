@@ -109,6 +109,7 @@ private:
     int m_progressErrorCount = 0;
     int m_progressMissingUrlCount = 0;
     int m_maxProgressRetries = 3;
+    qint64 m_generateStartNs = 0;  // 指标：任务发起时刻
 };
 
 #endif // XUNFEIPPTSERVICE_H
@@ -1,5 +1,6 @@
 #include "ZhipuPPTAgentService.h"
 #include "../config/AiConfig.h"
+#include "../utils/Metrics.h"
 #include "../utils/NetworkRequestFactory.h"
 #include <QNetworkProxy>
 #include <QUrl>
@@ -242,6 +243,8 @@ QNetworkReply* ZhipuPPTAgentService::callZhipuApi(const QString &model,
              << "body size:" << data.size();
 
     QNetworkReply *reply = m_networkManager->post(request, data);
+    reply->setProperty("metricsStartNs", Metrics::nowNs());
+    METRICS_COUNT("ppt.zhipu.api_calls");
     
     // 无条件忽略 SSL 错误（已在 createRequest 中设置 VerifyNone）
     connect(reply, &QNetworkReply::sslErrors,
@@ -686,6 +689,7 @@ void ZhipuPPTAgentService::onSvgReplyFinished()
     const QByteArray responseData = reply->readAll();
     reply->deleteLater();
     m_currentReply = nullptr;
+    Metrics::instance().recordSpan("ppt.zhipu.svg_page", reply->property("metricsStartNs").toLongLong());
 
     if (m_cancelled) {
         qDebug() << "[PPTAgent] SVG请求已被用户取消，静默退出";
@@ -1395,6 +1399,24 @@ QString ZhipuPPTAgentService::buildEndSvg(const QJsonObject &layout) const
 void ZhipuPPTAgentService::setState(State newState)
 {
     if (m_state != newState) {
+        // 阶段切换时记录上一阶段耗时，进入终态时记录整次生成耗时
+        Metrics &metrics = Metrics::instance();
+        const qint64 now = Metrics::nowNs();
+        switch (m_state) {
+        case State::GeneratingOutline: metrics.recordSpan("ppt.zhipu.outline", m_stageStartNs, now); break;
+        case State::GeneratingPlan:    metrics.recordSpan("ppt.zhipu.plan", m_stageStartNs, now); break;
+        case State::GeneratingSVG:     metrics.recordSpan("ppt.zhipu.svg", m_stageStartNs, now); break;
+        default: break;
+        }
+        if (newState == State::GeneratingOutline) {
+            m_generateStartNs = now;
+        } else if (newState == State::Finished) {
+            metrics.recordSpan("ppt.zhipu.generate", m_generateStartNs, now);
+        } else if (newState == State::Failed) {
+            METRICS_COUNT("ppt.zhipu.errors");
+        }
+        m_stageStartNs = now;
+
         m_state = newState;
         emit stateChanged(newState);
     }
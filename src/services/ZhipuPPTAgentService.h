@@ -163,6 +163,8 @@ private:
     QString m_baseUrl;
     State m_state = State::Idle;
     bool m_cancelled = false;
+    qint64 m_generateStartNs = 0;   // Metrics::nowNs()
+    qint64 m_stageStartNs = 0;
 
     // 模型名称
     static constexpr const char* MODEL_TEXT = "glm-5.1";         // 文本生成
@@ -0,0 +1,199 @@
+#include "GreedyPaperSelector.h"
+#include <QPair>
+#include <QSet>
+#include <QVector>
+#include <algorithm>
+#include <numeric>
+
+void GreedyPaperSelector::select(const SmartPaperConfig &config,
+                                 const QMap<QString, QList<PaperQuestion>> &candidates,
+                                 SmartPaperResult &result,
+                                 QRandomGenerator *random)
+{
+    int totalRatio = config.easyRatio + config.mediumRatio + config.hardRatio;
+    if (totalRatio <= 0) totalRatio = 10;  // 防御性处理
+
+    QSet<QString> globalCoveredChapters;
+    QSet<QString> globalCoveredKnowledgePoints;
+
+    // 对每个题型独立执行贪心选题
+    for (const auto &spec : config.typeSpecs) {
+        if (spec.count <= 0) continue;
+
+        const QList<PaperQuestion> typeCandidates = candidates.value(spec.questionType);
+        if (typeCandidates.isEmpty()) continue;
+
+        // Step 1: 按难度比例计算各难度需要的数量
+        int easyCount = qRound(static_cast<double>(spec.count) * config.easyRatio / totalRatio);
+        int hardCount = qRound(static_cast<double>(spec.count) * config.hardRatio / totalRatio);
+        int mediumCount = spec.count - easyCount - hardCount;
+        // 确保不出现负数
+        if (mediumCount < 0) {
+            mediumCount = 0;
+            easyCount = qMin(easyCount, spec.count);
+            hardCount = spec.count - easyCount;
+        }
+
+        // Step 2: 候选题按难度分桶
+        QMap<QString, QList<PaperQuestion>> buckets;
+        for (const auto &q : typeCandidates) {
+            QString diff = q.difficulty.toLower();
+            if (diff != "easy" && diff != "medium" && diff != "hard") {
+                diff = "medium";  // 未知难度归入中等
+            }
+            buckets[diff].append(q);
+        }
+
+        QMap<QString, int> needed;
+        needed["easy"] = easyCount;
+        needed["medium"] = mediumCount;
+        needed["hard"] = hardCount;
+
+        QList<PaperQuestion> selected;
+        QList<QuestionSelectionReason> selectedReasons;
+        QList<PaperQuestion> remaining;
+
+        // Step 3: 每桶内打分排序，取 top-N
+        for (const QString &diff : {"easy", "medium", "hard"}) {
+            int need = needed[diff];
+            QList<PaperQuestion> &bucket = buckets[diff];
+
+            // 对桶内候选题打分，同时生成理由
+            QVector<QPair<int, int>> scores;  // (分数, 索引)
+            QVector<QuestionSelectionReason> reasons;
+            for (int i = 0; i < bucket.size(); ++i) {
+                QuestionSelectionReason reason;
+                int score = scoreCandidate(config, bucket[i], globalCoveredChapters,
+                                           globalCoveredKnowledgePoints, random, &reason);
+                reason.questionId = bucket[i].id;
+                scores.append({score, i});
+                reasons.append(reason);
+            }
+
+            // 按分数降序排序
+            QVector<int> sortedIndices(scores.size());
+            std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
+            std::sort(sortedIndices.begin(), sortedIndices.end(),
+                      [&scores](int a, int b) {
+                          return scores[a].first > scores[b].first;
+                      });
+
+            int taken = 0;
+            for (int idx : sortedIndices) {
+                int origIdx = scores[idx].second;
+                if (taken >= need) {
+                    remaining.append(bucket[origIdx]);
+                } else {
+                    const PaperQuestion &q = bucket[origIdx];
+                    selected.append(q);
+                    selectedReasons.append(reasons[idx]);
+                    // 更新全局覆盖集
+                    if (!q.chapter.isEmpty()) globalCoveredChapters.insert(q.chapter);
+                    for (const auto &kp : q.knowledgePoints) {
+                        globalCoveredKnowledgePoints.insert(kp);
+                    }
+                    taken++;
+                }
+            }
+
+            // Step 4: 题量不足时从相邻难度补充
+            if (taken < need) {
+                int shortfall = need - taken;
+                // 记录 warning（已在搜索阶段记录过总量不足，这里记录难度不足）
+                result.warnings.append(
+                    QString("%1的%2难度题不足：需要 %3 题，仅找到 %4 题，将从其他难度补充")
+                        .arg(questionTypeNameCN(spec.questionType), difficultyNameCN(diff))
+                        .arg(need)
+                        .arg(taken)
+                );
+                // 将不足的数量分配到其他难度
+                if (diff == "easy") {
+                    needed["medium"] += shortfall;
+                } else if (diff == "hard") {
+                    needed["medium"] += shortfall;
+                } else {
+                    // medium不足，先从easy补，不够再从hard补
+                    needed["easy"] += shortfall / 2;
+                    needed["hard"] += shortfall - shortfall / 2;
+                }
+            }
+        }
+
+        // 设置分值和排序号
+        for (int i = 0; i < selected.size(); ++i) {
+            selected[i].score = spec.scorePerQuestion;
+        }
+
+        result.selectedQuestions.append(selected);
+        result.selectionReasons.append(selectedReasons);
+
+        // Step 5: 构建候选替换池
+        result.candidatePool[spec.questionType] = remaining;
+    }
+}
+
+int GreedyPaperSelector::scoreCandidate(const SmartPaperConfig &config,
+                                        const PaperQuestion &question,
+                                        const QSet<QString> &coveredChapters,
+                                        const QSet<QString> &coveredKnowledgePoints,
+                                        QRandomGenerator *random,
+                                        QuestionSelectionReason *outReason)
+{
+    int coverageScore = 0;
+    int difficultyMatchScore = 0;
+    int diversityScore = 0;
+    QStringList reasonParts;
+
+    // 知识点新覆盖度: +40
+    for (const auto &kp : question.knowledgePoints) {
+        if (!coveredKnowledgePoints.contains(kp)) {
+            coverageScore += 40;
+            reasonParts.append(QString("覆盖新知识点「%1」").arg(kp));
+            break;  // 有一个新知识点就够了
+        }
+    }
+
+    // 章节新覆盖度: +30
+    if (!question.chapter.isEmpty() && !coveredChapters.contains(question.chapter)) {
+        coverageScore += 30;
+        reasonParts.append(QString("覆盖新章节「%1」").arg(question.chapter));
+    }
+
+    // 章节匹配度: +20（在用户指定章节列表中）
+    if (!config.chapters.isEmpty() && !question.chapter.isEmpty()) {
+        if (config.chapters.contains(question.chapter)) {
+            difficultyMatchScore += 20;
+            reasonParts.append("匹配目标章节");
+        }
+    }
+
+    // 目标知识点匹配度: +25
+    if (!config.knowledgePoints.isEmpty()) {
+        for (const auto &kp : question.knowledgePoints) {
+            if (config.knowledgePoints.contains(kp)) {
+                difficultyMatchScore += 25;
+                reasonParts.append(QString("命中目标考点「%1」").arg(kp));
+                break;
+            }
+        }
+    }
+
+    // 随机扰动: +0~10（避免每次结果相同）
+    diversityScore = random->bounded(11);
+
+    int totalScore = coverageScore + difficultyMatchScore + diversityScore;
+
+    // 输出理由
+    if (outReason) {
+        outReason->coverageScore = coverageScore;
+        outReason->difficultyMatchScore = difficultyMatchScore;
+        outReason->diversityScore = diversityScore;
+        if (reasonParts.isEmpty()) {
+            outReason->summary = "基础候选题";
+        } else {
+            outReason->summary = reasonParts.join("，");
+        }
+    }
+
+    return totalScore;
+}
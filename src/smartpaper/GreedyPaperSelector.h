@@ -0,0 +1,37 @@
+#ifndef GREEDYPAPERSELECTOR_H
+#define GREEDYPAPERSELECTOR_H
+
+#include <QList>
+#include <QMap>
+#include <QRandomGenerator>
+#include <QSet>
+#include <QString>
+#include "SmartPaperConfig.h"
+
+/**
+ * @brief 贪心组卷（默认模式）
+ *
+ * 对每个题型独立选题：按难度比例分配各档题数，桶内按知识点/章节新覆盖和目标匹配打分，
+ * 取前 N 道，某档不足时从相邻难度补。得分带 0~10 的随机扰动，避免每次结果相同。
+ *
+ * 只写入 result 的选中题、选题理由、候选替换池和警告；排序号和统计由调用方补齐。
+ */
+class GreedyPaperSelector
+{
+public:
+    static void select(const SmartPaperConfig &config,
+                       const QMap<QString, QList<PaperQuestion>> &candidates,
+                       SmartPaperResult &result,
+                       QRandomGenerator *random = QRandomGenerator::global());
+
+private:
+    // 对候选题打分（同时生成选题理由）
+    static int scoreCandidate(const SmartPaperConfig &config,
+                              const PaperQuestion &question,
+                              const QSet<QString> &coveredChapters,
+                              const QSet<QString> &coveredKnowledgePoints,
+                              QRandomGenerator *random,
+                              QuestionSelectionReason *outReason = nullptr);
+};
+
+#endif // GREEDYPAPERSELECTOR_H
@@ -0,0 +1,429 @@
+#include "PaperAssemblySolver.h"
+#include "../utils/SimHash.h"
+#include <QElapsedTimer>
+#include <QSet>
+#include <QtMath>
+#include <algorithm>
+
+namespace {
+    // 目标权重：去重 > 覆盖 > 难度配比（难度偏差每错放一题计 2）
+    constexpr int DUPLICATE_WEIGHT = 1000;
+    constexpr int UNCOVERED_WEIGHT = 100;
+    constexpr int DIFFICULTY_WEIGHT = 50;
+
+    // 退火温度：开始时允许接受变差 ~1 个考点的换题，结束时接近纯爬山
+    constexpr double START_TEMPERATURE = 120.0;
+    constexpr double END_TEMPERATURE = 2.0;
+
+    int difficultyIndex(const QString &difficulty) {
+        const QString d = difficulty.toLower();
+        if (d == "easy") return 0;
+        if (d == "hard") return 2;
+        return 1;  // 未知难度归入中等，与贪心算法一致
+    }
+}
+
+PaperAssemblySolver::PaperAssemblySolver(const SmartPaperConfig &config,
+                                         const QMap<QString, QList<PaperQuestion>> &candidates,
+                                         int duplicateStemDistance,
+                                         quint32 seed)
+    : m_duplicateDistance(duplicateStemDistance)
+    , m_random(seed)
+{
+    // Step 1: 驻留目标考点。未指定知识点和章节时，以候选题出现过的全部考点为目标（追求覆盖面）
+    for (const auto &kp : config.knowledgePoints) {
+        internTarget("kp:" + kp);
+    }
+    for (const auto &chapter : config.chapters) {
+        internTarget("ch:" + chapter);
+    }
+    const bool openTargets = m_targetIds.isEmpty();
+
+    // Step 2: 构建候选项（同一道题只出现一次，排除题目再校验一次）
+    QSet<QString> seenIds;
+    QSet<QString> excluded(config.excludeQuestionIds.begin(), config.excludeQuestionIds.end());
+    int position = 0;
+    for (const auto &spec : config.typeSpecs) {
+        if (spec.count <= 0) continue;
+
+        TypeSlots group;
+        group.questionType = spec.questionType;
+        for (const auto &q : candidates.value(spec.questionType)) {
+            if (excluded.contains(q.id) || seenIds.contains(q.id)) {
+                continue;
+            }
+            seenIds.insert(q.id);
+
+            Item item;
+            item.question = q;
+            item.typeIndex = m_types.size();
+            item.difficulty = difficultyIndex(q.difficulty);
+            for (const auto &kp : q.knowledgePoints) {
+                const QString key = "kp:" + kp;
+                const int id = openTargets ? internTarget(key) : m_targetIds.value(key, -1);
+                if (id >= 0 && !item.targetIds.contains(id)) item.targetIds.append(id);
+            }
+            if (!q.chapter.isEmpty()) {
+                const QString key = "ch:" + q.chapter;
+                const int id = openTargets ? internTarget(key) : m_targetIds.value(key, -1);
+                if (id >= 0) item.targetIds.append(id);
+            }
+            if (m_duplicateDistance >= 0) {
+                item.stemHash = SimHash::fingerprint(q.stem, QString());
+            }
+
+            group.items.append(m_items.size());
+            m_items.append(item);
+        }
+        group.begin = position;
+        group.count = qMin(spec.count, static_cast<int>(group.items.size()));
+        position += group.count;
+        if (group.items.size() > group.count) m_hasSpare = true;
+        m_types.append(group);
+    }
+
+    // Step 3: 位图与反向索引
+    const int targetCount = m_targetNames.size();
+    m_maskWords = (targetCount + 63) / 64;
+    m_itemsByTarget.resize(targetCount);
+    for (int i = 0; i < m_items.size(); ++i) {
+        Item &item = m_items[i];
+        item.targetMask.fill(0, m_maskWords);
+        for (int id : item.targetIds) {
+            item.targetMask[id / 64] |= quint64(1) << (id % 64);
+            m_itemsByTarget[id].append(i);
+        }
+    }
+    for (const auto &items : m_itemsByTarget) {
+        if (!items.isEmpty()) m_reachableTargets++;
+    }
+
+    // Step 4: 整卷难度配比（与贪心算法相同的取整方式，只是按总题数计算）
+    int totalRatio = config.easyRatio + config.mediumRatio + config.hardRatio;
+    if (totalRatio <= 0) totalRatio = 10;
+    const int total = position;
+    int easy = qRound(static_cast<double>(total) * config.easyRatio / totalRatio);
+    int hard = qRound(static_cast<double>(total) * config.hardRatio / totalRatio);
+    int medium = total - easy - hard;
+    if (medium < 0) {
+        medium = 0;
+        easy = qMin(easy, total);
+        hard = total - easy;
+    }
+    m_targetDiff[0] = easy;
+    m_targetDiff[1] = medium;
+    m_targetDiff[2] = hard;
+
+    m_solution.fill(-1, total);
+    m_inUse.fill(0, m_items.size());
+    m_coverCount.fill(0, targetCount);
+
+    buildInitialSolution();
+    recomputeCost();
+    saveBest();
+}
+
+int PaperAssemblySolver::internTarget(const QString &key)
+{
+    auto it = m_targetIds.constFind(key);
+    if (it != m_targetIds.constEnd()) {
+        return it.value();
+    }
+    const int id = m_targetNames.size();
+    m_targetIds.insert(key, id);
+    m_targetNames.append(key.startsWith("kp:")
+        ? QString("知识点「%1」").arg(key.mid(3))
+        : QString("章节「%1」").arg(key.mid(3)));
+    return id;
+}
+
+bool PaperAssemblySolver::hasTarget(const Item &item, int targetId) const
+{
+    return (item.targetMask[targetId / 64] >> (targetId % 64)) & 1;
+}
+
+bool PaperAssemblySolver::isDuplicate(int a, int b) const
+{
+    if (m_duplicateDistance < 0) return false;
+    const quint64 ha = m_items[a].stemHash;
+    const quint64 hb = m_items[b].stemHash;
+    if (ha == 0 || hb == 0) return false;  // 题干没有可用特征，不参与比较
+    return SimHash::hammingDistance(ha, hb) <= m_duplicateDistance;
+}
+
+void PaperAssemblySolver::buildInitialSolution()
+{
+    // 初始解：逐位置贪心，优先新覆盖、其次补难度缺口，避开近似重复
+    for (const auto &group : m_types) {
+        for (int k = 0; k < group.count; ++k) {
+            int bestItem = -1;
+            int bestScore = 0;
+            for (int i : group.items) {
+                if (m_inUse[i]) continue;
+                const Item &item = m_items[i];
+                int score = m_random.bounded(11);
+                for (int id : item.targetIds) {
+                    if (m_coverCount[id] == 0) score += UNCOVERED_WEIGHT;
+                }
+                if (m_diffCount[item.difficulty] < m_targetDiff[item.difficulty]) {
+                    score += 2 * DIFFICULTY_WEIGHT;
+                }
+                for (int pos = group.begin; pos < group.begin + k; ++pos) {
+                    if (isDuplicate(m_solution[pos], i)) score -= DUPLICATE_WEIGHT;
+                }
+                for (int pos = 0; pos < group.begin; ++pos) {
+                    if (isDuplicate(m_solution[pos], i)) score -= DUPLICATE_WEIGHT;
+                }
+                if (bestItem < 0 || score > bestScore) {
+                    bestItem = i;
+                    bestScore = score;
+                }
+            }
+
+            m_solution[group.begin + k] = bestItem;
+            m_inUse[bestItem] = 1;
+            m_diffCount[m_items[bestItem].difficulty]++;
+            for (int id : m_items[bestItem].targetIds) {
+                m_coverCount[id]++;
+            }
+        }
+    }
+}
+
+void PaperAssemblySolver::recomputeCost()
+{
+    int covered = 0;
+    for (int count : m_coverCount) {
+        if (count > 0) covered++;
+    }
+    m_uncovered = m_reachableTargets - covered;
+
+    m_duplicates = 0;
+    for (int a = 0; a < m_solution.size(); ++a) {
+        for (int b = a + 1; b < m_solution.size(); ++b) {
+            if (isDuplicate(m_solution[a], m_solution[b])) m_duplicates++;
+        }
+    }
+
+    m_cost = costOf(m_uncovered, difficultyDeviation(m_diffCount), m_duplicates);
+}
+
+int PaperAssemblySolver::costOf(int uncovered, int diffDeviation, int duplicates) const
+{
+    return duplicates * DUPLICATE_WEIGHT + uncovered * UNCOVERED_WEIGHT + diffDeviation * DIFFICULTY_WEIGHT;
+}
+
+int PaperAssemblySolver::difficultyDeviation(const int counts[3]) const
+{
+    return qAbs(counts[0] - m_targetDiff[0])
+         + qAbs(counts[1] - m_targetDiff[1])
+         + qAbs(counts[2] - m_targetDiff[2]);
+}
+
+int PaperAssemblySolver::moveDelta(int pos, int item, int *uncoveredDelta, int *duplicateDelta) const
+{
+    const int oldItem = m_solution[pos];
+    const Item &out = m_items[oldItem];
+    const Item &in = m_items[item];
+
+    // 覆盖增量：只有换下的题是某考点的唯一覆盖、且换上的题不含该考点时才丢失
+    int uncovered = 0;
+    for (int id : out.targetIds) {
+        if (m_coverCount[id] == 1 && !hasTarget(in, id)) uncovered++;
+    }
+    for (int id : in.targetIds) {
+        if (m_coverCount[id] == 0) uncovered--;
+    }
+
+    int counts[3] = {m_diffCount[0], m_diffCount[1], m_diffCount[2]};
+    counts[out.difficulty]--;
+    counts[in.difficulty]++;
+    const int diffDelta = difficultyDeviation(counts) - difficultyDeviation(m_diffCount);
+
+    int duplicates = 0;
+    for (int j = 0; j < m_solution.size(); ++j) {
+        if (j == pos) continue;
+        if (isDuplicate(m_solution[j], oldItem)) duplicates--;
+        if (isDuplicate(m_solution[j], item)) duplicates++;
+    }
+
+    *uncoveredDelta = uncovered;
+    *duplicateDelta = duplicates;
+    return duplicates * DUPLICATE_WEIGHT + uncovered * UNCOVERED_WEIGHT + diffDelta * DIFFICULTY_WEIGHT;
+}
+
+void PaperAssemblySolver::applyMove(int pos, int item, int uncoveredDelta, int duplicateDelta)
+{
+    const int oldItem = m_solution[pos];
+    for (int id : m_items[oldItem].targetIds) {
+        m_coverCount[id]--;
+    }
+    for (int id : m_items[item].targetIds) {
+        m_coverCount[id]++;
+    }
+    m_diffCount[m_items[oldItem].difficulty]--;
+    m_diffCount[m_items[item].difficulty]++;
+    m_inUse[oldItem] = 0;
+    m_inUse[item] = 1;
+    m_solution[pos] = item;
+
+    m_uncovered += uncoveredDelta;
+    m_duplicates += duplicateDelta;
+    m_cost = costOf(m_uncovered, difficultyDeviation(m_diffCount), m_duplicates);
+}
+
+void PaperAssemblySolver::saveBest()
+{
+    m_bestSolution = m_solution;
+    m_bestCost = m_cost;
+    m_best.coveredTargets = m_reachableTargets - m_uncovered;
+    m_best.reachableTargets = m_reachableTargets;
+    m_best.totalTargets = m_targetNames.size();
+    m_best.difficultyDeviation = difficultyDeviation(m_diffCount) / 2;  // 每错放一题两项各差 1
+    m_best.duplicatePairs = m_duplicates;
+    m_best.easy = m_diffCount[0];
+    m_best.medium = m_diffCount[1];
+    m_best.hard = m_diffCount[2];
+}
+
+bool PaperAssemblySolver::step(int budgetMs, double progress)
+{
+    if (m_solution.isEmpty() || !m_hasSpare || isOptimal()) {
+        return true;  // 没有可换的候选，初始解就是唯一解
+    }
+
+    const double t = qBound(0.0, progress, 1.0);
+    const double temperature = START_TEMPERATURE * qPow(END_TEMPERATURE / START_TEMPERATURE, t);
+
+    QVector<int> uncoveredIds;
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int iteration = 0; ; ++iteration) {
+        if ((iteration & 127) == 0 && (timer.elapsed() >= budgetMs || isOptimal())) {
+            break;
+        }
+
+        int pos = -1;
+        int item = -1;
+
+        if (m_uncovered > 0 && m_random.bounded(2) == 0) {
+            // 定向换题：挑一个未覆盖的考点，换上能覆盖它的题
+            uncoveredIds.clear();
+            for (int id = 0; id < m_coverCount.size(); ++id) {
+                if (m_coverCount[id] == 0 && !m_itemsByTarget[id].isEmpty()) uncoveredIds.append(id);
+            }
+            const QVector<int> &holders = m_itemsByTarget[uncoveredIds[m_random.bounded(uncoveredIds.size())]];
+            item = holders[m_random.bounded(holders.size())];
+            const TypeSlots &group = m_types[m_items[item].typeIndex];
+            if (group.count == 0) continue;
+            pos = group.begin + m_random.bounded(group.count);
+        } else {
+            // 随机换题：同题型内任选一个未选中的候选
+            pos = m_random.bounded(m_solution.size());
+            const TypeSlots &group = m_types[m_items[m_solution[pos]].typeIndex];
+            item = group.items[m_random.bounded(group.items.size())];
+        }
+
+        if (m_inUse[item]) continue;
+        m_moves++;
+
+        int uncoveredDelta = 0;
+        int duplicateDelta = 0;
+        const int delta = moveDelta(pos, item, &uncoveredDelta, &duplicateDelta);
+        if (delta > 0 && m_random.generateDouble() >= qExp(-delta / temperature)) {
+            continue;
+        }
+
+        applyMove(pos, item, uncoveredDelta, duplicateDelta);
+        if (m_cost < m_bestCost) {
+            saveBest();
+        }
+    }
+
+    return isOptimal();
+}
+
+bool PaperAssemblySolver::isOptimal() const
+{
+    return m_bestCost == 0;
+}
+
+PaperAssemblySolver::Snapshot PaperAssemblySolver::best() const
+{
+    Snapshot snapshot = m_best;
+    snapshot.moves = m_moves;
+    return snapshot;
+}
+
+QList<PaperQuestion> PaperAssemblySolver::selectedFor(const QString &questionType) const
+{
+    QList<int> picked;
+    for (const auto &group : m_types) {
+        if (group.questionType != questionType) continue;
+        for (int pos = group.begin; pos < group.begin + group.count; ++pos) {
+            picked.append(m_bestSolution[pos]);
+        }
+    }
+    // 同题型内按难度由易到难排列
+    std::stable_sort(picked.begin(), picked.end(), [this](int a, int b) {
+        return m_items[a].difficulty < m_items[b].difficulty;
+    });
+
+    QList<PaperQuestion> result;
+    for (int i : picked) {
+        result.append(m_items[i].question);
+    }
+    return result;
+}
+
+QList<PaperQuestion> PaperAssemblySolver::remainingFor(const QString &questionType) const
+{
+    QSet<int> picked(m_bestSolution.begin(), m_bestSolution.end());
+    QList<PaperQuestion> result;
+    for (const auto &group : m_types) {
+        if (group.questionType != questionType) continue;
+        for (int i : group.items) {
+            if (!picked.contains(i)) result.append(m_items[i].question);
+        }
+    }
+    return result;
+}
+
+QStringList PaperAssemblySolver::targetsCoveredBy(const QString &questionId) const
+{
+    QStringList names;
+    for (const auto &item : m_items) {
+        if (item.question.id == questionId) {
+            for (int id : item.targetIds) {
+                names.append(m_targetNames[id]);
+            }
+            break;
+        }
+    }
+    return names;
+}
+
+QStringList PaperAssemblySolver::uncoveredTargets() const
+{
+    QVector<int> coverCount(m_targetNames.size(), 0);
+    for (int i : m_bestSolution) {
+        for (int id : m_items[i].targetIds) {
+            coverCount[id]++;
+        }
+    }
+    QStringList names;
+    for (int id = 0; id < coverCount.size(); ++id) {
+        if (coverCount[id] == 0 && !m_itemsByTarget[id].isEmpty()) names.append(m_targetNames[id]);
+    }
+    return names;
+}
+
+QStringList PaperAssemblySolver::unreachableTargets() const
+{
+    QStringList names;
+    for (int id = 0; id < m_itemsByTarget.size(); ++id) {
+        if (m_itemsByTarget[id].isEmpty()) names.append(m_targetNames[id]);
+    }
+    return names;
+}
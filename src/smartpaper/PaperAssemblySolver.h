@@ -0,0 +1,127 @@
+#ifndef PAPERASSEMBLYSOLVER_H
+#define PAPERASSEMBLYSOLVER_H
+
+#include <QList>
+#include <QMap>
+#include <QRandomGenerator>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include "SmartPaperConfig.h"
+
+/**
+ * @brief 组卷约束求解器（优化模式）
+ *
+ * 贪心算法逐题型、逐难度独立选题，无法同时保证覆盖、难度比例和去重。
+ * 这里把整张卷子当成一个解，用模拟退火式局部搜索联合优化：
+ * - 硬约束：各题型题数（不超过候选数）、排除题目（候选阶段已过滤，这里再校验一次）
+ * - 目标（按权重从高到低）：题干近似重复对数、未覆盖的目标考点数、整卷难度比例偏差
+ *
+ * 目标知识点和章节先驻留为整数 id，每道候选题保存一个位图，
+ * 换题时只看被换下/换上两道题的位，覆盖增量是 O(考点数/64) 的。
+ * 题干用 SimHash 指纹比较，汉明距离不超过阈值视为近似重复。
+ *
+ * 求解过程可分段执行（step），调用方在两段之间刷新进度，
+ * 任何时候都可以取当前最优解。
+ */
+class PaperAssemblySolver
+{
+public:
+    struct Snapshot {
+        int coveredTargets = 0;      // 已覆盖的目标考点数
+        int reachableTargets = 0;    // 候选题能覆盖到的目标考点数（覆盖上界）
+        int totalTargets = 0;        // 目标考点总数（知识点 + 章节）
+        int difficultyDeviation = 0; // 与目标难度配比相差的题数
+        int duplicatePairs = 0;      // 题干近似重复的题对数
+        int easy = 0;
+        int medium = 0;
+        int hard = 0;
+        qint64 moves = 0;            // 已评估的换题次数
+    };
+
+    PaperAssemblySolver(const SmartPaperConfig &config,
+                        const QMap<QString, QList<PaperQuestion>> &candidates,
+                        int duplicateStemDistance,
+                        quint32 seed);
+
+    // 运行一段局部搜索，返回是否已达到下界（无需继续搜索）
+    bool step(int budgetMs, double progress);
+
+    bool isOptimal() const;
+    Snapshot best() const;
+
+    // 目标难度配比（整卷）
+    int targetEasy() const { return m_targetDiff[0]; }
+    int targetMedium() const { return m_targetDiff[1]; }
+    int targetHard() const { return m_targetDiff[2]; }
+
+    // 当前最优解：题型 -> 选中题 / 未选中题（保持候选原顺序）
+    QList<PaperQuestion> selectedFor(const QString &questionType) const;
+    QList<PaperQuestion> remainingFor(const QString &questionType) const;
+
+    // 题目覆盖到的目标考点名称（用于生成选题理由）
+    QStringList targetsCoveredBy(const QString &questionId) const;
+    QStringList uncoveredTargets() const;
+    QStringList unreachableTargets() const;
+
+private:
+    struct Item {
+        PaperQuestion question;
+        int typeIndex = 0;
+        int difficulty = 1;          // 0 简单 / 1 中等 / 2 困难
+        QVector<int> targetIds;      // 覆盖的目标考点 id
+        QVector<quint64> targetMask; // 同上，位图形式
+        quint64 stemHash = 0;
+    };
+
+    struct TypeSlots {
+        QString questionType;
+        QVector<int> items;          // 该题型全部候选（Item 下标）
+        int begin = 0;               // 在解向量中的起始位置
+        int count = 0;               // 实际选题数（不超过候选数）
+    };
+
+    int internTarget(const QString &key);
+    bool hasTarget(const Item &item, int targetId) const;
+    bool isDuplicate(int a, int b) const;
+
+    void buildInitialSolution();
+    void recomputeCost();
+    int costOf(int uncovered, int diffDeviation, int duplicates) const;
+    int difficultyDeviation(const int counts[3]) const;
+
+    // 计算把位置 pos 上的题换成 item 后的代价增量
+    int moveDelta(int pos, int item, int *uncoveredDelta, int *duplicateDelta) const;
+    void applyMove(int pos, int item, int uncoveredDelta, int duplicateDelta);
+    void saveBest();
+
+    QVector<Item> m_items;
+    QVector<TypeSlots> m_types;
+    QStringList m_targetNames;                  // id -> 显示名称
+    QMap<QString, int> m_targetIds;             // 驻留键 -> id
+    QVector<QVector<int>> m_itemsByTarget;      // id -> 覆盖它的候选
+    int m_maskWords = 0;
+    int m_reachableTargets = 0;
+    int m_duplicateDistance = 0;
+    bool m_hasSpare = false;                    // 是否有题型的候选多于题数
+    int m_targetDiff[3] = {0, 0, 0};
+
+    // 当前解
+    QVector<int> m_solution;                    // 位置 -> Item 下标
+    QVector<char> m_inUse;
+    QVector<int> m_coverCount;                  // 目标 id -> 被当前解覆盖的次数
+    int m_diffCount[3] = {0, 0, 0};
+    int m_uncovered = 0;
+    int m_duplicates = 0;
+    int m_cost = 0;
+
+    // 最优解
+    QVector<int> m_bestSolution;
+    Snapshot m_best;
+    int m_bestCost = 0;
+
+    QRandomGenerator m_random;
+    qint64 m_moves = 0;
+};
+
+#endif // PAPERASSEMBLYSOLVER_H
@@ -43,6 +43,11 @@ struct SmartPaperConfig {
     // 排除条件（不选这些题目ID）
     QStringList excludeQuestionIds;
 
+    // 优化模式：在时间预算内联合满足题数、难度比例、覆盖和题干去重（见 PaperAssemblySolver）
+    bool optimize = false;
+    int optimizeTimeBudgetMs = 2000;
+    int duplicateStemDistance = 3;   // 题干指纹汉明距离不超过该值视为近似重复，-1 不检查
+
     // 计算配置的实际总分
     int computedTotalScore() const {
         int total = 0;
@@ -93,4 +98,24 @@ struct SmartPaperResult {
     double knowledgePointCoverage = 0.0;              // 知识点覆盖率 (0.0~1.0)
 };
 
+// 题型/难度中文名 — 用于生成用户友好的警告消息和选题理由
+inline QString questionTypeNameCN(const QString &type)
+{
+    static const QMap<QString, QString> names = {
+        {"single_choice", "选择题"}, {"multi_choice", "多选题"},
+        {"true_false", "判断题"}, {"short_answer", "简答题"},
+        {"essay", "论述题"}, {"material_analysis", "材料分析题"},
+        {"material_essay", "材料分析题"}, {"analysis", "材料分析题"},
+        {"discussion", "论述题"}, {"comprehensive", "综合题"},
+    };
+    return names.value(type, type);
+}
+
+inline QString difficultyNameCN(const QString &difficulty)
+{
+    if (difficulty == "easy") return "简单";
+    if (difficulty == "hard") return "困难";
+    return "中等";
+}
+
 #endif // SMARTPAPERCONFIG_H
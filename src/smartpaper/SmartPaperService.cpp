@@ -1,23 +1,14 @@
 #include "SmartPaperService.h"
+#include "GreedyPaperSelector.h"
+#include "PaperAssemblySolver.h"
 #include "../services/PaperService.h"
+#include "../utils/Metrics.h"
 #include <QSet>
 #include <QDebug>
+#include <QTimer>
 #include <QtMath>
-#include <numeric>
 
 namespace {
-    // 题型/难度中文映射 — 用于生成用户友好的警告消息
-    QString typeNameCN(const QString &type) {
-        static const QMap<QString, QString> m = {
-            {"single_choice", "选择题"}, {"multi_choice", "多选题"},
-            {"true_false", "判断题"}, {"short_answer", "简答题"},
-            {"essay", "论述题"}, {"material_analysis", "材料分析题"},
-            {"material_essay", "材料分析题"}, {"analysis", "材料分析题"},
-            {"discussion", "论述题"}, {"comprehensive", "综合题"},
-        };
-        return m.value(type, type);
-    }
-
     QString canonicalQuestionType(const QString &type) {
         const QString t = type.trimmed().toLower();
         static const QMap<QString, QString> aliases = {
@@ -35,11 +26,9 @@ namespace {
     bool questionTypeMatches(const QString &actualType, const QString &targetType) {
         return canonicalQuestionType(actualType) == canonicalQuestionType(targetType);
     }
-    QString diffNameCN(const QString &d) {
-        if (d == "easy") return "简单";
-        if (d == "hard") return "困难";
-        return "中等";
-    }
+
+    // 优化模式每段求解时长：足够短以保持界面响应，又能摊薄进度刷新的开销
+    constexpr int SOLVER_SLICE_MS = 50;
 }
 
 SmartPaperService::SmartPaperService(PaperService *paperService, QObject *parent)
@@ -50,6 +39,11 @@ SmartPaperService::SmartPaperService(PaperService *paperService, QObject *parent
             this, &SmartPaperService::onSearchCompleted);
 }
 
+SmartPaperService::~SmartPaperService()
+{
+    delete m_solver;
+}
+
 void SmartPaperService::generate(const SmartPaperConfig &config)
 {
     if (m_isGenerating) {
@@ -63,6 +57,7 @@ void SmartPaperService::generate(const SmartPaperConfig &config)
     m_searchQueue.clear();
     m_isGenerating = true;
     m_completedSearches = 0;
+    m_generateStartNs = Metrics::nowNs();
 
     // 检查配置是否有效
     if (config.typeSpecs.isEmpty()) {
@@ -96,7 +91,11 @@ void SmartPaperService::startNextSearch()
     if (m_searchQueue.isEmpty()) {
         // 所有搜索完成，开始选题
         emit progressUpdated(60, "正在执行智能选题算法...");
-        runGreedySelection();
+        if (m_config.optimize) {
+            runOptimizedSelection();
+        } else {
+            runGreedySelection();
+        }
         return;
     }
 
@@ -114,6 +113,7 @@ void SmartPaperService::startNextSearch()
     criteria.visibility = "all";
     criteria.limit = 1000;
 
+    m_searchStartNs = Metrics::nowNs();
     m_paperService->searchQuestions(criteria);
 }
 
@@ -123,6 +123,8 @@ void SmartPaperService::onSearchCompleted(const QList<PaperQuestion> &results)
         return;  // 不是智能组卷发起的搜索，忽略
     }
 
+    Metrics::instance().recordSpan("smart_paper.search", m_searchStartNs);
+
     qDebug() << "[SmartPaperService] 搜索完成，题型:" << m_currentSearchType
              << "结果数:" << results.size();
 
@@ -169,7 +171,7 @@ void SmartPaperService::onSearchCompleted(const QList<PaperQuestion> &results)
         if (spec.questionType == m_currentSearchType && filtered.size() < spec.count) {
             m_result.warnings.append(
                 QString("%1题不足：需要 %2 题，仅找到 %3 题")
-                    .arg(typeNameCN(m_currentSearchType))
+                    .arg(questionTypeNameCN(m_currentSearchType))
                     .arg(spec.count)
                     .arg(filtered.size())
             );
@@ -182,126 +184,8 @@ void SmartPaperService::onSearchCompleted(const QList<PaperQuestion> &results)
 
 void SmartPaperService::runGreedySelection()
 {
-    int totalRatio = m_config.easyRatio + m_config.mediumRatio + m_config.hardRatio;
-    if (totalRatio <= 0) totalRatio = 10;  // 防御性处理
-
-    QSet<QString> globalCoveredChapters;
-    QSet<QString> globalCoveredKnowledgePoints;
-
-    // 对每个题型独立执行贪心选题
-    for (const auto &spec : m_config.typeSpecs) {
-        if (spec.count <= 0) continue;
-
-        QList<PaperQuestion> candidates = m_rawCandidates.value(spec.questionType);
-        if (candidates.isEmpty()) continue;
-
-        // Step 1: 按难度比例计算各难度需要的数量
-        int easyCount = qRound(static_cast<double>(spec.count) * m_config.easyRatio / totalRatio);
-        int hardCount = qRound(static_cast<double>(spec.count) * m_config.hardRatio / totalRatio);
-        int mediumCount = spec.count - easyCount - hardCount;
-        // 确保不出现负数
-        if (mediumCount < 0) {
-            mediumCount = 0;
-            easyCount = qMin(easyCount, spec.count);
-            hardCount = spec.count - easyCount;
-        }
-
-        // Step 2: 候选题按难度分桶
-        QMap<QString, QList<PaperQuestion>> buckets;
-        for (const auto &q : candidates) {
-            QString diff = q.difficulty.toLower();
-            if (diff != "easy" && diff != "medium" && diff != "hard") {
-                diff = "medium";  // 未知难度归入中等
-            }
-            buckets[diff].append(q);
-        }
-
-        QMap<QString, int> needed;
-        needed["easy"] = easyCount;
-        needed["medium"] = mediumCount;
-        needed["hard"] = hardCount;
-
-        QList<PaperQuestion> selected;
-        QList<QuestionSelectionReason> selectedReasons;
-        QList<PaperQuestion> remaining;
-
-        // Step 3: 每桶内打分排序，取 top-N
-        for (const QString &diff : {"easy", "medium", "hard"}) {
-            int need = needed[diff];
-            QList<PaperQuestion> &bucket = buckets[diff];
-
-            // 对桶内候选题打分，同时生成理由
-            QVector<QPair<int, int>> scores;  // (分数, 索引)
-            QVector<QuestionSelectionReason> reasons;
-            for (int i = 0; i < bucket.size(); ++i) {
-                QuestionSelectionReason reason;
-                int score = scoreCandidate(bucket[i], globalCoveredChapters,
-                                           globalCoveredKnowledgePoints, &reason);
-                reason.questionId = bucket[i].id;
-                scores.append({score, i});
-                reasons.append(reason);
-            }
-
-            // 按分数降序排序
-            QVector<int> sortedIndices(scores.size());
-            std::iota(sortedIndices.begin(), sortedIndices.end(), 0);
-            std::sort(sortedIndices.begin(), sortedIndices.end(),
-                      [&scores](int a, int b) {
-                          return scores[a].first > scores[b].first;
-                      });
-
-            int taken = 0;
-            for (int idx : sortedIndices) {
-                int origIdx = scores[idx].second;
-                if (taken >= need) {
-                    remaining.append(bucket[origIdx]);
-                } else {
-                    const PaperQuestion &q = bucket[origIdx];
-                    selected.append(q);
-                    selectedReasons.append(reasons[idx]);
-                    // 更新全局覆盖集
-                    if (!q.chapter.isEmpty()) globalCoveredChapters.insert(q.chapter);
-                    for (const auto &kp : q.knowledgePoints) {
-                        globalCoveredKnowledgePoints.insert(kp);
-                    }
-                    taken++;
-                }
-            }
-
-            // Step 4: 题量不足时从相邻难度补充
-            if (taken < need) {
-                int shortfall = need - taken;
-                // 记录 warning（已在搜索阶段记录过总量不足，这里记录难度不足）
-                m_result.warnings.append(
-                    QString("%1的%2难度题不足：需要 %3 题，仅找到 %4 题，将从其他难度补充")
-                        .arg(typeNameCN(spec.questionType), diffNameCN(diff))
-                        .arg(need)
-                        .arg(taken)
-                );
-                // 将不足的数量分配到其他难度
-                if (diff == "easy") {
-                    needed["medium"] += shortfall;
-                } else if (diff == "hard") {
-                    needed["medium"] += shortfall;
-                } else {
-                    // medium不足，先从easy补，不够再从hard补
-                    needed["easy"] += shortfall / 2;
-                    needed["hard"] += shortfall - shortfall / 2;
-                }
-            }
-        }
-
-        // 设置分值和排序号
-        for (int i = 0; i < selected.size(); ++i) {
-            selected[i].score = spec.scorePerQuestion;
-        }
-
-        m_result.selectedQuestions.append(selected);
-        m_result.selectionReasons.append(selectedReasons);
-
-        // Step 5: 构建候选替换池
-        m_result.candidatePool[spec.questionType] = remaining;
-    }
+    const qint64 selectStartNs = Metrics::nowNs();
+    GreedyPaperSelector::select(m_config, m_rawCandidates, m_result);
 
     // 设置排序号
     for (int i = 0; i < m_result.selectedQuestions.size(); ++i) {
@@ -316,72 +200,136 @@ void SmartPaperService::runGreedySelection()
     m_result.success = true;
     m_isGenerating = false;
 
+    Metrics::instance().recordSpan("smart_paper.select", selectStartNs);
+    Metrics::instance().recordSpan("smart_paper.generate", m_generateStartNs);
+
     emit progressUpdated(100, "组卷完成！");
     emit generationCompleted(m_result);
 }
 
-int SmartPaperService::scoreCandidate(const PaperQuestion &question,
-                                       const QSet<QString> &coveredChapters,
-                                       const QSet<QString> &coveredKnowledgePoints,
-                                       QuestionSelectionReason *outReason) const
+void SmartPaperService::runOptimizedSelection()
 {
-    int coverageScore = 0;
-    int difficultyMatchScore = 0;
-    int diversityScore = 0;
-    QStringList reasonParts;
-
-    // 知识点新覆盖度: +40
-    for (const auto &kp : question.knowledgePoints) {
-        if (!coveredKnowledgePoints.contains(kp)) {
-            coverageScore += 40;
-            reasonParts.append(QString("覆盖新知识点「%1」").arg(kp));
-            break;  // 有一个新知识点就够了
-        }
+    m_solverStartNs = Metrics::nowNs();
+    delete m_solver;
+    m_solver = new PaperAssemblySolver(m_config, m_rawCandidates, m_config.duplicateStemDistance,
+                                       QRandomGenerator::global()->generate());
+
+    // 分段求解，段与段之间回到事件循环，界面保持响应
+    QTimer::singleShot(0, this, &SmartPaperService::runSolverSlice);
+}
+
+void SmartPaperService::runSolverSlice()
+{
+    if (!m_solver) {
+        return;
     }
 
-    // 章节新覆盖度: +30
-    if (!question.chapter.isEmpty() && !coveredChapters.contains(question.chapter)) {
-        coverageScore += 30;
-        reasonParts.append(QString("覆盖新章节「%1」").arg(question.chapter));
+    const int budgetMs = qMax(0, m_config.optimizeTimeBudgetMs);
+    const qint64 elapsedMs = (Metrics::nowNs() - m_solverStartNs) / 1000000;
+    const qint64 remainingMs = budgetMs - elapsedMs;
+    const double progress = budgetMs > 0 ? static_cast<double>(elapsedMs) / budgetMs : 1.0;
+
+    bool done = remainingMs <= 0;
+    if (!done) {
+        done = m_solver->step(static_cast<int>(qMin<qint64>(SOLVER_SLICE_MS, remainingMs)), progress);
     }
 
-    // 章节匹配度: +20（在用户指定章节列表中）
-    if (!m_config.chapters.isEmpty() && !question.chapter.isEmpty()) {
-        if (m_config.chapters.contains(question.chapter)) {
-            difficultyMatchScore += 20;
-            reasonParts.append("匹配目标章节");
-        }
+    // 上报当前最优解
+    const PaperAssemblySolver::Snapshot best = m_solver->best();
+    emit progressUpdated(60 + static_cast<int>(qBound(0.0, progress, 1.0) * 30),
+        QString("正在优化选题：覆盖 %1/%2 个考点，难度 %3:%4:%5（目标 %6:%7:%8），相似题干 %9 对")
+            .arg(best.coveredTargets).arg(best.totalTargets)
+            .arg(best.easy).arg(best.medium).arg(best.hard)
+            .arg(m_solver->targetEasy()).arg(m_solver->targetMedium()).arg(m_solver->targetHard())
+            .arg(best.duplicatePairs));
+
+    if (done) {
+        finishOptimizedSelection();
+    } else {
+        QTimer::singleShot(0, this, &SmartPaperService::runSolverSlice);
     }
+}
 
-    // 目标知识点匹配度: +25
-    if (!m_config.knowledgePoints.isEmpty()) {
-        for (const auto &kp : question.knowledgePoints) {
-            if (m_config.knowledgePoints.contains(kp)) {
-                difficultyMatchScore += 25;
-                reasonParts.append(QString("命中目标考点「%1」").arg(kp));
-                break;
+void SmartPaperService::finishOptimizedSelection()
+{
+    const PaperAssemblySolver::Snapshot best = m_solver->best();
+
+    for (const auto &spec : m_config.typeSpecs) {
+        if (spec.count <= 0) continue;
+
+        QList<PaperQuestion> selected = m_solver->selectedFor(spec.questionType);
+        for (auto &q : selected) {
+            q.score = spec.scorePerQuestion;
+
+            QuestionSelectionReason reason;
+            reason.questionId = q.id;
+            QStringList reasonParts;
+            const QStringList targets = m_solver->targetsCoveredBy(q.id);
+            if (!targets.isEmpty()) {
+                reason.coverageScore = 40 * targets.size();
+                reasonParts.append(QString("覆盖%1").arg(targets.mid(0, 3).join("、")));
+            }
+            if (best.difficultyDeviation == 0) {
+                reason.difficultyMatchScore = 20;
+                reasonParts.append(QString("%1难度，符合整卷难度比例").arg(difficultyNameCN(q.difficulty)));
             }
+            reason.summary = reasonParts.isEmpty() ? "基础候选题" : reasonParts.join("，");
+            m_result.selectionReasons.append(reason);
+        }
+
+        m_result.selectedQuestions.append(selected);
+        m_result.candidatePool[spec.questionType] = m_solver->remainingFor(spec.questionType);
+    }
+
+    // 约束未能全部满足时说明原因（题量不足的警告已在搜索阶段记录）
+    if (!m_config.knowledgePoints.isEmpty() || !m_config.chapters.isEmpty()) {
+        const QStringList unreachable = m_solver->unreachableTargets();
+        if (!unreachable.isEmpty()) {
+            m_result.warnings.append(QString("题库中没有覆盖%1的题目").arg(unreachable.join("、")));
+        }
+        const QStringList uncovered = m_solver->uncoveredTargets();
+        if (!uncovered.isEmpty()) {
+            m_result.warnings.append(QString("题数有限，%1未能同时覆盖").arg(uncovered.join("、")));
         }
     }
+    if (best.difficultyDeviation > 0) {
+        m_result.warnings.append(
+            QString("难度比例未能完全满足：简单 %1/%2，中等 %3/%4，困难 %5/%6")
+                .arg(best.easy).arg(m_solver->targetEasy())
+                .arg(best.medium).arg(m_solver->targetMedium())
+                .arg(best.hard).arg(m_solver->targetHard()));
+    }
+    if (best.duplicatePairs > 0) {
+        m_result.warnings.append(
+            QString("候选题不足，仍有 %1 对题目题干相近").arg(best.duplicatePairs));
+    }
 
-    // 随机扰动: +0~10（避免每次结果相同）
-    diversityScore = QRandomGenerator::global()->bounded(11);
+    qDebug() << "[SmartPaperService] 优化选题完成，换题尝试:" << best.moves
+             << "覆盖:" << best.coveredTargets << "/" << best.totalTargets
+             << "难度偏差:" << best.difficultyDeviation
+             << "相似题干:" << best.duplicatePairs;
 
-    int totalScore = coverageScore + difficultyMatchScore + diversityScore;
+    delete m_solver;
+    m_solver = nullptr;
 
-    // 输出理由
-    if (outReason) {
-        outReason->coverageScore = coverageScore;
-        outReason->difficultyMatchScore = difficultyMatchScore;
-        outReason->diversityScore = diversityScore;
-        if (reasonParts.isEmpty()) {
-            outReason->summary = "基础候选题";
-        } else {
-            outReason->summary = reasonParts.join("，");
-        }
+    // 设置排序号
+    for (int i = 0; i < m_result.selectedQuestions.size(); ++i) {
+        m_result.selectedQuestions[i].orderNum = i + 1;
     }
 
-    return totalScore;
+    emit progressUpdated(90, "正在生成统计信息...");
+
+    buildStatistics();
+
+    m_result.success = true;
+    m_isGenerating = false;
+
+    METRICS_COUNT_N("smart_paper.optimize.moves", best.moves);
+    Metrics::instance().recordSpan("smart_paper.optimize", m_solverStartNs);
+    Metrics::instance().recordSpan("smart_paper.generate", m_generateStartNs);
+
+    emit progressUpdated(100, "组卷完成！");
+    emit generationCompleted(m_result);
 }
 
 void SmartPaperService::buildStatistics()
@@ -7,12 +7,14 @@
 #include "SmartPaperConfig.h"
 
 class PaperService;
+class PaperAssemblySolver;
 
 /**
  * @brief 智能组卷算法服务
  *
  * 从云端题库中按约束条件自动选题，支持换题和统计。
- * 核心算法：分阶段贪心 + 约束满足。
+ * 核心算法：分阶段贪心 + 约束满足；config.optimize 为真时改用局部搜索联合求解，
+ * 按时间预算分段运行，每段结束通过 progressUpdated 报告当前最优解。
  * 由于 PaperService::searchCompleted 信号无请求标识，必须串行搜索。
  */
 class SmartPaperService : public QObject
@@ -21,6 +23,7 @@ class SmartPaperService : public QObject
 
 public:
     explicit SmartPaperService(PaperService *paperService, QObject *parent = nullptr);
+    ~SmartPaperService() override;
 
     /**
      * @brief 根据配置生成试卷（异步，结果通过信号返回）
@@ -52,14 +55,13 @@ private:
     // 串行搜索管理
     void startNextSearch();
 
-    // 贪心选题算法
+    // 贪心选题（算法见 GreedyPaperSelector）
     void runGreedySelection();
 
-    // 对候选题打分（同时生成选题理由）
-    int scoreCandidate(const PaperQuestion &question,
-                       const QSet<QString> &coveredChapters,
-                       const QSet<QString> &coveredKnowledgePoints,
-                       QuestionSelectionReason *outReason = nullptr) const;
+    // 优化选题：分段运行约束求解器，时间用完或达到下界后输出结果
+    void runOptimizedSelection();
+    void runSolverSlice();
+    void finishOptimizedSelection();
 
     // 构建统计信息
     void buildStatistics();
@@ -75,6 +77,12 @@ private:
     bool m_isGenerating = false;
     int m_totalSearches = 0;                        // 总搜索数（用于进度计算）
     int m_completedSearches = 0;                    // 已完成搜索数
+    qint64 m_generateStartNs = 0;                   // 指标：组卷开始时刻
+    qint64 m_searchStartNs = 0;                     // 指标：当前搜索开始时刻
+
+    // 优化模式状态
+    PaperAssemblySolver *m_solver = nullptr;
+    qint64 m_solverStartNs = 0;
 };
 
 #endif // SMARTPAPERSERVICE_H
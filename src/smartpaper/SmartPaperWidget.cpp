@@ -512,6 +512,11 @@ void SmartPaperWidget::setupConfigCard(QVBoxLayout *mainLayout)
 
     cardLayout->addLayout(diffRow);
 
+    m_optimizeCheck = new QCheckBox("精确优化（约 2 秒，同时满足覆盖、难度比例并避开相似题）");
+    m_optimizeCheck->setStyleSheet("QCheckBox { font-size: 13px; color: #374151; }");
+    m_optimizeCheck->setCursor(Qt::PointingHandCursor);
+    cardLayout->addWidget(m_optimizeCheck);
+
     // ==================== 开始组卷按钮 ====================
     auto *btnRow = new QHBoxLayout();
     btnRow->addStretch();
@@ -916,6 +921,7 @@ void SmartPaperWidget::onGenerateClicked()
     m_config.easyRatio = m_easyRatioSpin->value();
     m_config.mediumRatio = m_mediumRatioSpin->value();
     m_config.hardRatio = m_hardRatioSpin->value();
+    m_config.optimize = m_optimizeCheck->isChecked();
     if (!selectedChapter().isEmpty()) {
         m_config.chapters = {selectedChapter()};
     }
@@ -14,6 +14,7 @@
 #include <QStackedWidget>
 #include <QProgressBar>
 #include <QListWidget>
+#include <QCheckBox>
 #include <QList>
 
 #include "SmartPaperConfig.h"
@@ -110,6 +111,7 @@ private:
     QSpinBox *m_easyRatioSpin = nullptr;
     QSpinBox *m_mediumRatioSpin = nullptr;
     QSpinBox *m_hardRatioSpin = nullptr;
+    QCheckBox *m_optimizeCheck = nullptr;
 
     // 状态区
     QStackedWidget *m_statusStack = nullptr;
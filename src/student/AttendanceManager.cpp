@@ -1,6 +1,7 @@
 #include "AttendanceManager.h"
 #include "../auth/supabase/supabaseconfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QJsonDocument>
 #include <QUrlQuery>
 #include <QDebug>
@@ -17,7 +18,7 @@ AttendanceManager* AttendanceManager::instance()
 
 AttendanceManager::AttendanceManager(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
 {
 }
 
@@ -218,72 +219,131 @@ void AttendanceManager::loadSessionsByClassAndDate(const QString &classId, const
 // ── 学生查看自己的考勤记录 ──
 void AttendanceManager::loadStudentAttendance(const QString &classId, const QString &studentEmail)
 {
-    // 两步查询：先获取该班级所有 session，再查该学生的 records
-    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/attendance_sessions");
-    QUrlQuery query;
-    query.addQueryItem("select", "id,class_id,code,status,name,created_at,ended_at");
-    query.addQueryItem("class_id", "eq." + classId);
-    query.addQueryItem("order", "created_at.desc");
-    query.addQueryItem("limit", "100");
-    url.setQuery(query);
+    const QString key = classId + "|" + studentEmail;
 
+    // 有缓存先直接出结果，再增量刷新
+    auto it = m_studentStores.constFind(key);
+    const bool cached = it != m_studentStores.constEnd() && !it->isEmpty();
+    if (cached) {
+        emitStudentAttendance(classId, studentEmail);
+    }
+    if (m_pendingStudentAttendance.contains(key)) return;
+    m_pendingStudentAttendance.insert(key);
+
+    // 一次 RPC 取回场次 + 本人状态（LEFT JOIN），不再拼接 session_id=in.(...)
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/rpc/student_attendance_history");
     QNetworkRequest request = NetworkRequestFactory::createAuthRequest(url);
-    QNetworkReply *reply = m_networkManager->get(request);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    QJsonObject body;
+    body["p_class_id"] = classId;
+    body["p_student_email"] = studentEmail;
+    const QDateTime lastFull = m_lastFullSync.value(key);
+    const bool fullDue = !lastFull.isValid()
+        || lastFull.msecsTo(QDateTime::currentDateTimeUtc()) > FULL_SYNC_INTERVAL_MS;
+    if (cached && !fullDue) {
+        const QDateTime since = it->latestCreatedAt().addMSecs(-HISTORY_OVERLAP_MS);
+        body["p_since"] = since.toString(Qt::ISODateWithMs);
+    } else {
+        body["p_since"] = QJsonValue();
+    }
+    const bool incremental = !body["p_since"].isNull();
 
-    connect(reply, &QNetworkReply::finished, this, [this, reply, classId, studentEmail]() {
+    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, classId, studentEmail, key, incremental]() {
         reply->deleteLater();
+        m_pendingStudentAttendance.remove(key);
         if (reply->error() != QNetworkReply::NoError) {
-            qWarning() << "[Attendance] load student sessions failed:" << reply->errorString();
+            qWarning() << "[Attendance] load student history failed:" << reply->errorString();
             return;
         }
-        QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
-        QList<SessionInfo> sessions;
+
+        QList<AttendanceStatsStore::SessionRow> rows;
+        const QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
+        rows.reserve(arr.size());
         for (const auto &val : arr) {
-            sessions.append(SessionInfo::fromJson(val.toObject()));
+            rows.append(AttendanceStatsStore::SessionRow::fromJson(val.toObject()));
         }
 
-        if (sessions.isEmpty()) {
-            emit studentAttendanceLoaded(classId, {});
-            return;
+        AttendanceStatsStore &store = m_studentStores[key];
+        if (!incremental) {
+            // 全量结果整体替换，服务端已删除的场次随之去掉
+            store.clear();
+            m_lastFullSync.insert(key, QDateTime::currentDateTimeUtc());
         }
+        store.upsert(rows);
+
+        qDebug() << "[Attendance] 学生考勤:" << rows.size() << (incremental ? "(增量)" : "(全量)")
+                 << "缓存场次:" << store.size();
+        emitStudentAttendance(classId, studentEmail);
+    });
+}
 
-        // 查该学生所有 records（按 session_id 列表过滤）
-        QStringList sessionIds;
-        for (const auto &s : sessions) sessionIds << s.id;
-
-        QUrl recUrl(SupabaseConfig::supabaseUrl() + "/rest/v1/attendance_records");
-        QUrlQuery recQuery;
-        recQuery.addQueryItem("select", "id,session_id,student_email,student_name,status,signed_at");
-        recQuery.addQueryItem("student_email", "eq." + studentEmail);
-        // 使用 in 过滤
-        recQuery.addQueryItem("session_id", "in.(" + sessionIds.join(",") + ")");
-        recUrl.setQuery(recQuery);
-
-        QNetworkRequest recRequest = NetworkRequestFactory::createAuthRequest(recUrl);
-        QNetworkReply *recReply = m_networkManager->get(recRequest);
-
-        connect(recReply, &QNetworkReply::finished, this, [this, recReply, classId, sessions]() {
-            recReply->deleteLater();
-            if (recReply->error() != QNetworkReply::NoError) {
-                qWarning() << "[Attendance] load student records failed:" << recReply->errorString();
-                return;
-            }
-
-            // 建立 sessionId → status 映射
-            QMap<QString, QString> sessionToStatus;
-            QJsonArray recArr = QJsonDocument::fromJson(recReply->readAll()).array();
-            for (const auto &val : recArr) {
-                QJsonObject obj = val.toObject();
-                sessionToStatus[obj["session_id"].toString()] = obj["status"].toString();
-            }
-
-            QList<QPair<SessionInfo, QString>> result;
-            for (const auto &s : sessions) {
-                result.append({s, sessionToStatus.value(s.id, "未记录")});
-            }
-
-            qDebug() << "[Attendance] 学生考勤:" << result.size();
-            emit studentAttendanceLoaded(classId, result);
-        });
+void AttendanceManager::emitStudentAttendance(const QString &classId, const QString &studentEmail)
+{
+    const AttendanceStatsStore store = m_studentStores.value(classId + "|" + studentEmail);
+
+    QList<QPair<SessionInfo, QString>> result;
+    const QList<AttendanceStatsStore::SessionRow> rows = store.rowsNewestFirst();
+    result.reserve(rows.size());
+    for (const auto &row : rows) {
+        SessionInfo s;
+        s.id = row.sessionId;
+        s.classId = classId;
+        s.code = row.code;
+        s.status = row.sessionStatus;
+        s.name = row.name;
+        s.createdAt = row.createdAt;
+        s.endedAt = row.endedAt;
+        result.append({s, row.recordStatus.isEmpty() ? QStringLiteral("未记录") : row.recordStatus});
+    }
+
+    emit studentAttendanceLoaded(classId, result);
+    emit studentAttendanceStatsLoaded(classId, studentEmail, store.rollup());
+}
+
+AttendanceStatsStore::Rollup AttendanceManager::studentAttendanceRollup(const QString &classId,
+                                                                       const QString &studentEmail,
+                                                                       const QDateTime &from,
+                                                                       const QDateTime &to) const
+{
+    auto it = m_studentStores.constFind(classId + "|" + studentEmail);
+    if (it == m_studentStores.constEnd()) return AttendanceStatsStore::Rollup();
+    AttendanceStatsStore::Rollup r = it->rollup(from, to);
+    r.studentEmail = studentEmail;
+    return r;
+}
+
+// ── 班级考勤统计（服务端聚合） ──
+void AttendanceManager::loadClassAttendanceStats(const QString &classId, const QDateTime &from,
+                                                 const QDateTime &to)
+{
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/rpc/class_attendance_rollup");
+    QNetworkRequest request = NetworkRequestFactory::createAuthRequest(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    QJsonObject body;
+    body["p_class_id"] = classId;
+    body["p_from"] = from.isValid() ? QJsonValue(from.toString(Qt::ISODateWithMs)) : QJsonValue();
+    body["p_to"] = to.isValid() ? QJsonValue(to.toString(Qt::ISODateWithMs)) : QJsonValue();
+
+    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, classId]() {
+        reply->deleteLater();
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "[Attendance] load class stats failed:" << reply->errorString();
+            emit error("加载考勤统计失败");
+            return;
+        }
+        QList<AttendanceStatsStore::Rollup> rollups;
+        const QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
+        rollups.reserve(arr.size());
+        for (const auto &val : arr) {
+            rollups.append(AttendanceStatsStore::Rollup::fromJson(val.toObject()));
+        }
+        qDebug() << "[Attendance] 班级考勤统计:" << rollups.size() << "名学生";
+        emit classAttendanceStatsLoaded(classId, rollups);
     });
 }
@@ -6,6 +6,9 @@
 #include <QDateTime>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
+#include <QSet>
+#include "../attendance/services/AttendanceStatsStore.h"
 
 class AttendanceManager : public QObject
 {
@@ -44,7 +47,18 @@ public:
 
     // 学生操作
     void signAttendance(const QString &code, const QString &studentEmail, const QString &studentName);
+    // 学生考勤明细：一次 RPC 取回场次及本人状态，合并进本地列式缓存。
+    // 距上次全量超过 FULL_SYNC_INTERVAL_MS 时重新全量拉取（去掉已删除的场次、带上较早的改动），
+    // 其余时候只增量拉取近期场次
     void loadStudentAttendance(const QString &classId, const QString &studentEmail);
+    // 基于本地缓存按日期范围汇总（需先 loadStudentAttendance），毫秒级，无网络
+    AttendanceStatsStore::Rollup studentAttendanceRollup(const QString &classId, const QString &studentEmail,
+                                                         const QDateTime &from = QDateTime(),
+                                                         const QDateTime &to = QDateTime()) const;
+
+    // 班级考勤统计：服务端按学生聚合（各状态人次、连续出勤），from / to 无效表示不限
+    void loadClassAttendanceStats(const QString &classId, const QDateTime &from = QDateTime(),
+                                  const QDateTime &to = QDateTime());
 
 signals:
     void attendanceStarted(const SessionInfo &session);
@@ -55,12 +69,27 @@ signals:
     void signResult(bool success, const QString &message);
     void studentAttendanceLoaded(const QString &classId,
         const QList<QPair<SessionInfo, QString>> &records);
+    void studentAttendanceStatsLoaded(const QString &classId, const QString &studentEmail,
+                                      const AttendanceStatsStore::Rollup &rollup);
+    void classAttendanceStatsLoaded(const QString &classId,
+                                    const QList<AttendanceStatsStore::Rollup> &rollups);
     void error(const QString &message);
 
 private:
     AttendanceManager(QObject *parent = nullptr);
     static AttendanceManager *s_instance;
     QNetworkAccessManager *m_networkManager;
+
+    void emitStudentAttendance(const QString &classId, const QString &studentEmail);
+
+    // 学生考勤缓存：键为 "班级ID|学生邮箱"
+    // 增量拉取时回看一段时间，覆盖教师事后修改的近期记录；
+    // 增量看不到删除和更早的修改，由定期全量兜底
+    static constexpr qint64 HISTORY_OVERLAP_MS = 7LL * 24 * 60 * 60 * 1000;
+    static constexpr qint64 FULL_SYNC_INTERVAL_MS = 10LL * 60 * 1000;
+    QHash<QString, AttendanceStatsStore> m_studentStores;
+    QHash<QString, QDateTime> m_lastFullSync;
+    QSet<QString> m_pendingStudentAttendance;
 };
 
 #endif
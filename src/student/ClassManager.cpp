@@ -1,6 +1,7 @@
 #include "ClassManager.h"
 #include "../auth/supabase/supabaseconfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QRandomGenerator>
@@ -20,7 +21,7 @@ ClassManager* ClassManager::instance()
 
 ClassManager::ClassManager(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
 {
 }
 
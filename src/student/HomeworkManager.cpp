@@ -1,9 +1,12 @@
 #include "HomeworkManager.h"
 #include "../auth/supabase/supabaseconfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QJsonDocument>
 #include <QUrlQuery>
 #include <QDebug>
+#include <QDateTime>
+#include <QTimer>
 
 HomeworkManager* HomeworkManager::s_instance = nullptr;
 
@@ -15,8 +18,12 @@ HomeworkManager* HomeworkManager::instance()
 
 HomeworkManager::HomeworkManager(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
+    , m_gradeFlushTimer(new QTimer(this))
 {
+    m_gradeFlushTimer->setSingleShot(true);
+    m_gradeFlushTimer->setInterval(GRADE_FLUSH_DEBOUNCE_MS);
+    connect(m_gradeFlushTimer, &QTimer::timeout, this, &HomeworkManager::flushGrades);
 }
 
 // ── AssignmentInfo ──
@@ -50,7 +57,8 @@ HomeworkManager::SubmissionInfo HomeworkManager::SubmissionInfo::fromJson(const
     s.status = json["status"].toInt(1);
     s.allowResubmit = json["allow_resubmit"].toBool(false);
     s.submitTime = QDateTime::fromString(json["submit_time"].toString(), Qt::ISODateWithMs);
-    s.gradeTime = QDateTime::fromString(json["grade_time"].toString(), Qt::ISODateWithMs);
+    s.gradeTimeRaw = json["grade_time"].toString();
+    s.gradeTime = QDateTime::fromString(s.gradeTimeRaw, Qt::ISODateWithMs);
     return s;
 }
 
@@ -86,6 +94,7 @@ void HomeworkManager::createAssignment(const QString &classId, const QString &te
         if (!arr.isEmpty()) {
             AssignmentInfo info = AssignmentInfo::fromJson(arr[0].toObject());
             qDebug() << "[Homework] 作业已创建:" << info.title;
+            invalidateStudentHomework();
             emit assignmentCreated(info);
         }
     });
@@ -142,8 +151,17 @@ void HomeworkManager::loadSubmissions(const QString &assignmentId)
         QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
         QList<SubmissionInfo> list;
         for (const auto &val : arr) {
-            list.append(SubmissionInfo::fromJson(val.toObject()));
+            SubmissionInfo info = SubmissionInfo::fromJson(val.toObject());
+            // 尚未确认的批改覆盖在服务端数据上，刷新不会冲掉本地修改
+            auto pending = m_pendingGrades.constFind(info.id);
+            if (pending != m_pendingGrades.constEnd()) {
+                applyPendingGrade(info, pending.value());
+            } else if (auto inFlight = m_inFlightGrades.constFind(info.id); inFlight != m_inFlightGrades.constEnd()) {
+                applyPendingGrade(info, inFlight.value());
+            }
+            list.append(info);
         }
+        m_submissions.insert(assignmentId, list);
         qDebug() << "[Homework] 提交列表:" << list.size();
         emit submissionsLoaded(assignmentId, list);
     });
@@ -168,6 +186,7 @@ void HomeworkManager::deleteAssignment(const QString &assignmentId)
             return;
         }
         qDebug() << "[Homework] 作业已删除:" << assignmentId;
+        invalidateStudentHomework();
         emit assignmentDeleted(assignmentId);
     });
 }
@@ -201,10 +220,228 @@ void HomeworkManager::gradeSubmission(const QString &submissionId, int score, co
             return;
         }
         qDebug() << "[Homework] 已批改:" << submissionId;
+        invalidateStudentHomework();
         emit submissionGraded(submissionId);
     });
 }
 
+// ── 批量批改 ──
+QList<HomeworkManager::SubmissionInfo> HomeworkManager::cachedSubmissions(const QString &assignmentId) const
+{
+    return m_submissions.value(assignmentId);
+}
+
+void HomeworkManager::applyPendingGrade(SubmissionInfo &info, const PendingGrade &grade) const
+{
+    info.score = grade.score;
+    info.feedback = grade.feedback;
+    info.allowResubmit = grade.allowResubmit;
+    info.status = 2;
+}
+
+void HomeworkManager::updateCachedSubmission(const SubmissionInfo &info)
+{
+    auto it = m_submissions.find(info.assignmentId);
+    if (it != m_submissions.end()) {
+        for (auto &s : it.value()) {
+            if (s.id == info.id) {
+                s = info;
+                break;
+            }
+        }
+    }
+    emit submissionUpdated(info);
+}
+
+void HomeworkManager::queueGrade(const SubmissionInfo &submission, int score, const QString &feedback,
+                                 bool allowResubmit)
+{
+    PendingGrade grade;
+    // 同一提交再次修改时沿用第一次入队时的基准版本
+    if (auto pending = m_pendingGrades.constFind(submission.id); pending != m_pendingGrades.constEnd()) {
+        grade.original = pending->original;
+        grade.expectedGradeTime = pending->expectedGradeTime;
+    } else if (auto inFlight = m_inFlightGrades.constFind(submission.id); inFlight != m_inFlightGrades.constEnd()) {
+        // 上一批还没返回，等结果回来再换成新版本号（见 handleGradeResults）
+        grade.original = inFlight->original;
+        grade.expectedGradeTime = inFlight->expectedGradeTime;
+    } else {
+        grade.original = submission;
+        grade.expectedGradeTime = submission.gradeTimeRaw;
+    }
+    grade.score = score;
+    grade.feedback = feedback;
+    grade.allowResubmit = allowResubmit;
+    m_pendingGrades.insert(submission.id, grade);
+
+    SubmissionInfo updated = submission;
+    applyPendingGrade(updated, grade);
+    updateCachedSubmission(updated);
+
+    // 退避期间不提前重试，新修改随下一次重试一起提交
+    if (m_gradeRetryDelayMs > 0) {
+        if (!m_gradeFlushTimer->isActive()) m_gradeFlushTimer->start(m_gradeRetryDelayMs);
+    } else {
+        m_gradeFlushTimer->start(GRADE_FLUSH_DEBOUNCE_MS);
+    }
+}
+
+void HomeworkManager::flushGrades()
+{
+    m_gradeFlushTimer->stop();
+    // 同一时间只有一批在途，上一批返回后再提交（保证版本号已更新）
+    if (m_pendingGrades.isEmpty() || !m_inFlightGrades.isEmpty()) return;
+
+    m_inFlightGrades = m_pendingGrades;
+    m_pendingGrades.clear();
+
+    QJsonArray grades;
+    for (auto it = m_inFlightGrades.cbegin(); it != m_inFlightGrades.cend(); ++it) {
+        const PendingGrade &g = it.value();
+        QJsonObject row;
+        row["id"] = it.key();
+        row["score"] = g.score;
+        row["feedback"] = g.feedback;
+        row["allow_resubmit"] = g.allowResubmit;
+        // 原样回传服务端的字符串：QDateTime 只有毫秒，往返会丢掉微秒
+        row["expected_grade_time"] = g.expectedGradeTime.isEmpty()
+            ? QJsonValue() : QJsonValue(g.expectedGradeTime);
+        grades.append(row);
+    }
+
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/rpc/grade_submissions");
+    QNetworkRequest request = NetworkRequestFactory::createAuthRequest(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+
+    QJsonObject body;
+    body["p_grades"] = grades;
+
+    qDebug() << "[Homework] 批量提交批改:" << grades.size();
+    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(body).toJson(QJsonDocument::Compact));
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply]() {
+        reply->deleteLater();
+        const QHash<QString, PendingGrade> batch = m_inFlightGrades;
+        m_inFlightGrades.clear();
+
+        if (reply->error() != QNetworkReply::NoError) {
+            const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+            qWarning() << "[Homework] batch grade failed:" << status << reply->errorString();
+            // 只有网络错误、5xx 和 429 值得重试；其余 4xx（请求体有误、函数不存在等）重试也不会成功
+            const bool retryable = status == 0 || status == 429 || status >= 500;
+            QString message = reply->errorString();
+            if (!retryable) {
+                const QString serverMessage = QJsonDocument::fromJson(reply->readAll()).object()["message"].toString();
+                if (!serverMessage.isEmpty()) message = serverMessage;
+            }
+            handleGradeFlushFailed(batch, message, retryable);
+            return;
+        }
+        handleGradeResults(batch, QJsonDocument::fromJson(reply->readAll()).array());
+    });
+}
+
+void HomeworkManager::handleGradeResults(const QHash<QString, PendingGrade> &batch, const QJsonArray &results)
+{
+    m_gradeRetryDelayMs = 0;
+
+    QHash<QString, QJsonObject> resultById;
+    for (const auto &val : results) {
+        const QJsonObject obj = val.toObject();
+        resultById.insert(obj["id"].toString(), obj);
+    }
+
+    QStringList savedIds;
+    QMap<QString, QString> errors;
+    QSet<QString> reloadAssignments;
+
+    for (auto it = batch.cbegin(); it != batch.cend(); ++it) {
+        const QString &id = it.key();
+        const PendingGrade &grade = it.value();
+        const QJsonObject result = resultById.value(id);
+        const QString status = result["status"].toString();
+
+        if (status == "ok") {
+            SubmissionInfo confirmed = grade.original;
+            applyPendingGrade(confirmed, grade);
+            confirmed.gradeTimeRaw = result["grade_time"].toString();
+            confirmed.gradeTime = QDateTime::fromString(confirmed.gradeTimeRaw, Qt::ISODateWithMs);
+
+            // 在途期间又改过的，换到刚确认的版本上，下一批不会误判为冲突
+            SubmissionInfo shown = confirmed;
+            auto pending = m_pendingGrades.find(id);
+            if (pending != m_pendingGrades.end()) {
+                pending->original = confirmed;
+                pending->expectedGradeTime = confirmed.gradeTimeRaw;
+                applyPendingGrade(shown, pending.value());
+            }
+            updateCachedSubmission(shown);
+            savedIds.append(id);
+            emit submissionGraded(id);
+            continue;
+        }
+
+        if (status == "conflict") {
+            errors.insert(id, "该提交已被他人修改，已重新加载");
+            reloadAssignments.insert(grade.original.assignmentId);
+        } else if (status == "missing") {
+            errors.insert(id, "提交记录不存在");
+            reloadAssignments.insert(grade.original.assignmentId);
+        } else {
+            errors.insert(id, "服务器未返回该行的结果");
+        }
+        // 基于过期版本的后续修改一并丢弃，回滚到服务端状态
+        m_pendingGrades.remove(id);
+        updateCachedSubmission(grade.original);
+    }
+
+    qDebug() << "[Homework] 批改已保存:" << savedIds.size() << "失败:" << errors.size();
+    if (!savedIds.isEmpty()) invalidateStudentHomework();
+    emit gradesFlushed(savedIds, errors);
+
+    for (const QString &assignmentId : reloadAssignments) {
+        loadSubmissions(assignmentId);
+    }
+    if (!m_pendingGrades.isEmpty()) m_gradeFlushTimer->start(GRADE_FLUSH_DEBOUNCE_MS);
+}
+
+void HomeworkManager::handleGradeFlushFailed(const QHash<QString, PendingGrade> &batch, const QString &message,
+                                             bool retryable)
+{
+    QMap<QString, QString> errors;
+    if (!retryable) {
+        // 服务端拒绝了整批：回滚到服务端状态并报给界面，不再重试，避免一条坏数据堵住后续批改
+        for (auto it = batch.cbegin(); it != batch.cend(); ++it) {
+            if (!m_pendingGrades.contains(it.key())) {
+                updateCachedSubmission(it.value().original);
+            }
+            errors.insert(it.key(), message);
+        }
+        m_gradeRetryDelayMs = 0;
+        if (!m_pendingGrades.isEmpty()) m_gradeFlushTimer->start(GRADE_FLUSH_DEBOUNCE_MS);
+        qWarning() << "[Homework] 批改被服务端拒绝，不再重试:" << message;
+
+        emit gradesFlushed(QStringList(), errors);
+        emit error(QString("批改保存失败：%1").arg(message));
+        return;
+    }
+
+    // 整批未送达：放回待提交队列（已有更新的修改则保留更新的），保持乐观显示，退避后自动重试
+    for (auto it = batch.cbegin(); it != batch.cend(); ++it) {
+        if (!m_pendingGrades.contains(it.key())) {
+            m_pendingGrades.insert(it.key(), it.value());
+        }
+        errors.insert(it.key(), message);
+    }
+    m_gradeRetryDelayMs = m_gradeRetryDelayMs > 0
+        ? qMin(m_gradeRetryDelayMs * 2, GRADE_RETRY_MAX_MS) : GRADE_RETRY_INITIAL_MS;
+    m_gradeFlushTimer->start(m_gradeRetryDelayMs);
+    qDebug() << "[Homework] 批改将在" << m_gradeRetryDelayMs << "ms 后重试";
+
+    emit gradesFlushed(QStringList(), errors);
+    emit error(QString("批改保存失败，%1 秒后自动重试").arg(m_gradeRetryDelayMs / 1000));
+}
+
 // ── 学生提交作业 ──
 void HomeworkManager::submitHomework(const QString &assignmentId, const QString &studentEmail,
                                       const QString &studentName, const QString &content,
@@ -235,6 +472,7 @@ void HomeworkManager::submitHomework(const QString &assignmentId, const QString
         }
         QByteArray respData = reply->readAll();
         qDebug() << "[Homework] submit response:" << respData.left(500);
+        invalidateStudentHomework();
         emit homeworkSubmitted(assignmentId);
     });
 }
@@ -307,9 +545,91 @@ void HomeworkManager::resubmitHomework(const QString &submissionId,
                 return;
             }
             qDebug() << "[Homework] 追加提交成功:" << submissionId;
+            invalidateStudentHomework();
             // 用 assignmentId 触发刷新 — 这里发 homeworkSubmitted 信号，assignmentId 通过 submissionId 查不到
             // 改为直接发一个通用刷新信号
             emit homeworkSubmitted(QString());
         });
     });
 }
+
+// ── 学生作业（作业 + 本人提交，一次往返） ──
+void HomeworkManager::loadStudentHomework(const QString &classId, const QString &studentEmail,
+                                          bool forceRefresh)
+{
+    const QString key = classId + "|" + studentEmail;
+
+    auto it = m_studentHomeworkCache.constFind(key);
+    if (!forceRefresh && it != m_studentHomeworkCache.constEnd()
+        && QDateTime::currentMSecsSinceEpoch() - it->fetchedAtMs < STUDENT_HOMEWORK_TTL_MS) {
+        emit studentHomeworkLoaded(classId, studentEmail, it->list);
+        return;
+    }
+    if (m_pendingStudentHomework.contains(key)) {
+        return;  // 同一请求已在途，结果到达时统一发出
+    }
+    m_pendingStudentHomework.insert(key);
+
+    // 嵌入 submissions（外键 submissions.assignment_id），并只保留本人的最新一条
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/assignments");
+    QUrlQuery query;
+    query.addQueryItem("select", "id,class_id,teacher_email,title,description,total_score,status,end_time,created_at,"
+                                 "submissions(id,assignment_id,student_email,student_name,content,score,feedback,"
+                                 "file_url,allow_resubmit,status,submit_time,grade_time)");
+    query.addQueryItem("class_id", "eq." + classId);
+    query.addQueryItem("submissions.student_email", "eq." + studentEmail);
+    query.addQueryItem("submissions.order", "submit_time.desc");
+    query.addQueryItem("submissions.limit", "1");
+    query.addQueryItem("order", "created_at.desc");
+    url.setQuery(query);
+
+    QNetworkRequest request = NetworkRequestFactory::createAuthRequest(url);
+    QNetworkReply *reply = m_networkManager->get(request);
+
+    const int generation = m_studentHomeworkGeneration;
+    connect(reply, &QNetworkReply::finished, this, [this, reply, key, classId, studentEmail, generation]() {
+        reply->deleteLater();
+        if (generation != m_studentHomeworkGeneration) {
+            // 期间有提交/批改，结果已过期：按当前代重新请求，等待方收到的是最新数据
+            // （失效后若已有同键请求在途，loadStudentHomework 会直接复用它）
+            loadStudentHomework(classId, studentEmail, true);
+            return;
+        }
+        m_pendingStudentHomework.remove(key);
+        if (reply->error() != QNetworkReply::NoError) {
+            qWarning() << "[Homework] load student homework failed:" << reply->errorString();
+            emit error("加载作业失败");
+            return;
+        }
+
+        QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
+        QList<StudentAssignment> list;
+        list.reserve(arr.size());
+        for (const auto &val : arr) {
+            const QJsonObject obj = val.toObject();
+            StudentAssignment item;
+            item.assignment = AssignmentInfo::fromJson(obj);
+            const QJsonArray subs = obj["submissions"].toArray();
+            if (!subs.isEmpty()) {
+                item.hasSubmission = true;
+                item.submission = SubmissionInfo::fromJson(subs[0].toObject());
+            }
+            list.append(item);
+        }
+
+        CachedStudentHomework cached;
+        cached.list = list;
+        cached.fetchedAtMs = QDateTime::currentMSecsSinceEpoch();
+        m_studentHomeworkCache.insert(key, cached);
+
+        qDebug() << "[Homework] 学生作业:" << list.size();
+        emit studentHomeworkLoaded(classId, studentEmail, list);
+    });
+}
+
+void HomeworkManager::invalidateStudentHomework()
+{
+    m_studentHomeworkCache.clear();
+    m_pendingStudentHomework.clear();
+    m_studentHomeworkGeneration++;
+}
@@ -6,6 +6,11 @@
 #include <QDateTime>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+
+class QTimer;
 
 class HomeworkManager : public QObject
 {
@@ -27,9 +32,17 @@ public:
         int score = -1, status = 1;
         bool allowResubmit = false;
         QDateTime submitTime, gradeTime;
+        QString gradeTimeRaw;                 // 服务端原样的 grade_time（微秒精度），批改的版本号
         static SubmissionInfo fromJson(const QJsonObject &json);
     };
 
+    // 学生视角：作业 + 本人的最新提交（没有提交时 hasSubmission 为 false）
+    struct StudentAssignment {
+        AssignmentInfo assignment;
+        bool hasSubmission = false;
+        SubmissionInfo submission;
+    };
+
     // 教师操作
     void createAssignment(const QString &classId, const QString &teacherEmail,
                           const QString &title, const QString &description,
@@ -39,25 +52,80 @@ public:
     void deleteAssignment(const QString &assignmentId);
     void gradeSubmission(const QString &submissionId, int score, const QString &feedback,
                          bool allowResubmit = false);
+    /**
+     * @brief 批量批改：先乐观更新本地提交列表，防抖后把累积的改动用一次 RPC 提交
+     *
+     * 以入队时看到的 grade_time 作为版本号，服务端发现已被他人批改时该行记为冲突，
+     * 本地撤回乐观修改并重新加载该作业的提交列表。
+     */
+    void queueGrade(const SubmissionInfo &submission, int score, const QString &feedback,
+                    bool allowResubmit = false);
+    void flushGrades();                       // 立即提交（离开批改页时调用）
+    int pendingGradeCount() const { return m_pendingGrades.size() + m_inFlightGrades.size(); }
+    QList<SubmissionInfo> cachedSubmissions(const QString &assignmentId) const;
     void submitHomework(const QString &assignmentId, const QString &studentEmail,
                         const QString &studentName, const QString &content,
                         const QString &fileUrl = QString());
     void resubmitHomework(const QString &submissionId, const QString &newContent,
                           const QString &newFileUrl);
 
+    // 学生作业页：一次请求取回班级作业及本人提交（PostgREST 资源嵌入），结果按 (班级, 学生) 缓存
+    void loadStudentHomework(const QString &classId, const QString &studentEmail,
+                             bool forceRefresh = false);
+    void invalidateStudentHomework();         // 清空缓存；在途请求回来后自动按最新数据重新加载
+
 signals:
     void assignmentCreated(const AssignmentInfo &info);
     void assignmentDeleted(const QString &assignmentId);
     void assignmentsLoaded(const QList<AssignmentInfo> &list);
     void submissionsLoaded(const QString &assignmentId, const QList<SubmissionInfo> &list);
     void submissionGraded(const QString &submissionId);
+    void submissionUpdated(const SubmissionInfo &info);      // 乐观修改、确认或撤回
+    // 一批批改的结果：errors 为 提交ID -> 失败原因
+    void gradesFlushed(const QStringList &savedIds, const QMap<QString, QString> &errors);
     void homeworkSubmitted(const QString &assignmentId);
+    void studentHomeworkLoaded(const QString &classId, const QString &studentEmail,
+                               const QList<StudentAssignment> &list);
     void error(const QString &msg);
 
 private:
     HomeworkManager(QObject *parent = nullptr);
     static HomeworkManager *s_instance;
     QNetworkAccessManager *m_networkManager;
+
+    // 学生作业缓存：键为 "班级ID|学生邮箱"
+    struct CachedStudentHomework {
+        QList<StudentAssignment> list;
+        qint64 fetchedAtMs = 0;
+    };
+    static constexpr qint64 STUDENT_HOMEWORK_TTL_MS = 30 * 1000;
+    QHash<QString, CachedStudentHomework> m_studentHomeworkCache;
+    QSet<QString> m_pendingStudentHomework;   // 请求中的键，避免重复发起
+    int m_studentHomeworkGeneration = 0;      // 失效后递增，丢弃失效前发出的请求结果
+
+    // 批量批改
+    struct PendingGrade {
+        SubmissionInfo original;              // 服务端最后确认的状态（冲突或失败时回滚用）
+        int score = 0;
+        QString feedback;
+        bool allowResubmit = false;
+        QString expectedGradeTime;            // 版本号：入队时看到的 grade_time 原始字符串
+    };
+    static constexpr int GRADE_FLUSH_DEBOUNCE_MS = 800;
+    static constexpr int GRADE_RETRY_INITIAL_MS = 2000;    // 整批发送失败后的重试间隔，逐次翻倍
+    static constexpr int GRADE_RETRY_MAX_MS = 60 * 1000;
+    void updateCachedSubmission(const SubmissionInfo &info);
+    void applyPendingGrade(SubmissionInfo &info, const PendingGrade &grade) const;
+    void handleGradeResults(const QHash<QString, PendingGrade> &batch, const QJsonArray &results);
+    // retryable 为 false（服务端 4xx）时整批回滚并报错，不再重试
+    void handleGradeFlushFailed(const QHash<QString, PendingGrade> &batch, const QString &message,
+                                bool retryable);
+
+    QHash<QString, QList<SubmissionInfo>> m_submissions;     // 作业ID -> 提交列表（含乐观修改）
+    QHash<QString, PendingGrade> m_pendingGrades;            // 提交ID -> 待提交的批改
+    QHash<QString, PendingGrade> m_inFlightGrades;           // 已发出、等待结果的批改
+    QTimer *m_gradeFlushTimer;
+    int m_gradeRetryDelayMs = 0;                             // 0 表示不在退避中
 };
 
 #endif
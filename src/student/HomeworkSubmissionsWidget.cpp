@@ -23,9 +23,37 @@ HomeworkSubmissionsWidget::HomeworkSubmissionsWidget(
     , m_members(members)
 {
     setupUI();
+
+    auto *manager = HomeworkManager::instance();
+    connect(manager, &HomeworkManager::submissionsLoaded, this,
+            [this](const QString &assignmentId, const QList<HomeworkManager::SubmissionInfo> &submissions) {
+        if (assignmentId != m_assignment.id) return;
+        renderSubmissions(submissions);
+    });
+    // 批改是乐观更新的：本地列表一变就重绘，不等网络
+    connect(manager, &HomeworkManager::submissionUpdated, this,
+            [this](const HomeworkManager::SubmissionInfo &info) {
+        if (info.assignmentId != m_assignment.id) return;
+        renderSubmissions(HomeworkManager::instance()->cachedSubmissions(m_assignment.id));
+        updateSaveStatus();
+    });
+    connect(manager, &HomeworkManager::gradesFlushed, this,
+            [this](const QStringList &savedIds, const QMap<QString, QString> &errors) {
+        for (const QString &id : savedIds) m_gradeErrors.remove(id);
+        for (auto it = errors.cbegin(); it != errors.cend(); ++it) m_gradeErrors.insert(it.key(), it.value());
+        renderSubmissions(HomeworkManager::instance()->cachedSubmissions(m_assignment.id));
+        updateSaveStatus();
+    });
+
     loadSubmissions();
 }
 
+HomeworkSubmissionsWidget::~HomeworkSubmissionsWidget()
+{
+    // 离开页面时把防抖中的批改立即提交
+    HomeworkManager::instance()->flushGrades();
+}
+
 void HomeworkSubmissionsWidget::setupUI()
 {
     auto *mainLayout = new QVBoxLayout(this);
@@ -49,6 +77,10 @@ void HomeworkSubmissionsWidget::setupUI()
     headerRow->addWidget(backBtn);
     headerRow->addWidget(title);
     headerRow->addStretch();
+
+    m_saveStatusLabel = new QLabel();
+    m_saveStatusLabel->setStyleSheet("font-size: 12px; color: #6B7280;");
+    headerRow->addWidget(m_saveStatusLabel);
     mainLayout->addLayout(headerRow);
 
     // 列表头
@@ -104,33 +136,49 @@ void HomeworkSubmissionsWidget::setupUI()
 
 void HomeworkSubmissionsWidget::loadSubmissions()
 {
-    connect(HomeworkManager::instance(), &HomeworkManager::submissionsLoaded, this,
-            [this](const QString &assignmentId, const QList<HomeworkManager::SubmissionInfo> &submissions) {
-        if (assignmentId != m_assignment.id) return;
+    HomeworkManager::instance()->loadSubmissions(m_assignment.id);
+}
 
-        // 清空
-        while (m_listLayout->count()) {
-            auto *item = m_listLayout->takeAt(0);
-            delete item->widget();
-            delete item;
+void HomeworkSubmissionsWidget::renderSubmissions(const QList<HomeworkManager::SubmissionInfo> &submissions)
+{
+    // 清空（延迟删除：批改对话框从行内按钮打开，重绘时按钮可能还在调用栈上）
+    while (m_listLayout->count()) {
+        auto *item = m_listLayout->takeAt(0);
+        if (auto *w = item->widget()) {
+            w->hide();
+            w->deleteLater();
         }
+        delete item;
+    }
 
-        // 建立邮箱→提交的映射
-        QMap<QString, HomeworkManager::SubmissionInfo> subMap;
-        for (const auto &s : submissions) {
-            subMap[s.studentEmail] = s;
-        }
+    // 建立邮箱→提交的映射
+    QMap<QString, HomeworkManager::SubmissionInfo> subMap;
+    for (const auto &s : submissions) {
+        subMap[s.studentEmail] = s;
+    }
 
-        // 遍历所有成员
-        for (const auto &m : m_members) {
-            const auto *sub = subMap.contains(m.email) ? &subMap[m.email] : nullptr;
-            m_listLayout->addWidget(createStudentRow(
-                m.name.isEmpty() ? m.email.split('@')[0] : m.name, m.email, sub));
-        }
-        m_listLayout->addStretch();
-    }, Qt::SingleShotConnection);
+    // 遍历所有成员
+    for (const auto &m : m_members) {
+        const auto *sub = subMap.contains(m.email) ? &subMap[m.email] : nullptr;
+        m_listLayout->addWidget(createStudentRow(
+            m.name.isEmpty() ? m.email.split('@')[0] : m.name, m.email, sub));
+    }
+    m_listLayout->addStretch();
+}
 
-    HomeworkManager::instance()->loadSubmissions(m_assignment.id);
+void HomeworkSubmissionsWidget::updateSaveStatus()
+{
+    const int pending = HomeworkManager::instance()->pendingGradeCount();
+    if (!m_gradeErrors.isEmpty()) {
+        m_saveStatusLabel->setText(QString("%1 条批改保存失败").arg(m_gradeErrors.size()));
+        m_saveStatusLabel->setStyleSheet("font-size: 12px; color: #DC2626;");
+    } else if (pending > 0) {
+        m_saveStatusLabel->setText(QString("%1 条批改保存中…").arg(pending));
+        m_saveStatusLabel->setStyleSheet("font-size: 12px; color: #6B7280;");
+    } else {
+        m_saveStatusLabel->setText("批改已保存");
+        m_saveStatusLabel->setStyleSheet("font-size: 12px; color: #059669;");
+    }
 }
 
 QWidget* HomeworkSubmissionsWidget::createStudentRow(const QString &name, const QString &email,
@@ -165,6 +213,11 @@ QWidget* HomeworkSubmissionsWidget::createStudentRow(const QString &name, const
         statusLabel->setText("已批改");
         statusLabel->setStyleSheet("font-size: 12px; color: #059669; background: #D1FAE5; border-radius: 4px; padding: 2px 8px;");
     }
+    if (submission && m_gradeErrors.contains(submission->id)) {
+        statusLabel->setText("保存失败");
+        statusLabel->setToolTip(m_gradeErrors.value(submission->id));
+        statusLabel->setStyleSheet("font-size: 12px; color: #DC2626; background: #FEE2E2; border-radius: 4px; padding: 2px 8px;");
+    }
 
     // 提交时间
     auto *timeLabel = new QLabel(submission ? submission->submitTime.toString("MM-dd HH:mm") : "-");
@@ -318,13 +371,10 @@ void HomeworkSubmissionsWidget::showGradeDialog(const HomeworkManager::Submissio
         "QPushButton:hover { background: #C62828; }"
     ).arg(StyleConfig::PATRIOTIC_RED));
     connect(submitBtn, &QPushButton::clicked, this, [this, dialog, submission, scoreSpin, feedbackEdit]() {
-        connect(HomeworkManager::instance(), &HomeworkManager::submissionGraded, this,
-            [this](const QString &submissionId) {
-            Q_UNUSED(submissionId)
-            loadSubmissions();
-        }, Qt::SingleShotConnection);
-        HomeworkManager::instance()->gradeSubmission(
-            submission.id, scoreSpin->value(), feedbackEdit->toPlainText().trimmed(), false);
+        // 本地立即生效，短暂防抖后与其他批改合并成一次请求
+        m_gradeErrors.remove(submission.id);
+        HomeworkManager::instance()->queueGrade(
+            submission, scoreSpin->value(), feedbackEdit->toPlainText().trimmed(), false);
         dialog->accept();
     });
 
@@ -3,6 +3,8 @@
 
 #include <QWidget>
 #include <QVBoxLayout>
+#include <QLabel>
+#include <QMap>
 #include "HomeworkManager.h"
 #include "ClassManager.h"
 
@@ -14,6 +16,7 @@ public:
     HomeworkSubmissionsWidget(const HomeworkManager::AssignmentInfo &assignment,
                                const QList<ClassManager::MemberInfo> &members,
                                QWidget *parent = nullptr);
+    ~HomeworkSubmissionsWidget() override;
 
 signals:
     void backRequested();
@@ -21,6 +24,8 @@ signals:
 private:
     void setupUI();
     void loadSubmissions();
+    void renderSubmissions(const QList<HomeworkManager::SubmissionInfo> &submissions);
+    void updateSaveStatus();
     QWidget* createStudentRow(const QString &name, const QString &email,
                                const HomeworkManager::SubmissionInfo *submission);
     void showGradeDialog(const HomeworkManager::SubmissionInfo &submission);
@@ -28,6 +33,8 @@ private:
     HomeworkManager::AssignmentInfo m_assignment;
     QList<ClassManager::MemberInfo> m_members;
     QVBoxLayout *m_listLayout = nullptr;
+    QLabel *m_saveStatusLabel = nullptr;
+    QMap<QString, QString> m_gradeErrors;     // 提交ID -> 保存失败原因
 };
 
 #endif
@@ -1,13 +1,20 @@
 #include "MaterialManager.h"
 #include "../auth/supabase/supabaseconfig.h"
+#include "../services/ResumableUploadService.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QJsonDocument>
 #include <QUrlQuery>
-#include <QFile>
 #include <QFileInfo>
-#include <QHttpMultiPart>
+#include <QNetworkReply>
+#include <QUuid>
 #include <QDebug>
 
+namespace {
+    // 上传任务 context 中的类型标记，用于认领 ResumableUploadService 的完成信号
+    const QString kMaterialUploadKind = QStringLiteral("material");
+}
+
 MaterialManager* MaterialManager::s_instance = nullptr;
 
 MaterialManager* MaterialManager::instance()
@@ -18,8 +25,24 @@ MaterialManager* MaterialManager::instance()
 
 MaterialManager::MaterialManager(QObject *parent)
     : QObject(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_networkManager(SessionNetworkManager::forCurrentThread())
 {
+    auto *uploader = ResumableUploadService::instance();
+    connect(uploader, &ResumableUploadService::uploadFinished, this,
+            [this](const QString &, const QString &, const QString &objectPath,
+                   qint64 fileSize, const QJsonObject &context) {
+        if (context["kind"].toString() != kMaterialUploadKind) return;
+        createFileRecord(context, objectPath, fileSize);
+    });
+    connect(uploader, &ResumableUploadService::uploadFailed, this,
+            [this](const QString &, const QString &message, const QJsonObject &context) {
+        if (context["kind"].toString() != kMaterialUploadKind) return;
+        emit error(QString("文件「%1」上传失败: %2").arg(context["name"].toString(), message));
+    });
+    connect(uploader, &ResumableUploadService::throughputUpdated,
+            this, &MaterialManager::uploadThroughput);
+    connect(uploader, &ResumableUploadService::allUploadsFinished,
+            this, &MaterialManager::uploadsIdle);
 }
 
 MaterialManager::MaterialInfo MaterialManager::MaterialInfo::fromJson(const QJsonObject &json)
@@ -72,91 +95,192 @@ void MaterialManager::createFolder(const QString &classId, const QString &parent
     });
 }
 
-// ── 上传文件 ──
-void MaterialManager::uploadFile(const QString &classId, const QString &parentId,
-                                  const QString &localPath, const QString &mimeType,
-                                  const QString &uploaderEmail)
+// ── 批量创建目录树 ──
+QString MaterialManager::createFolderTree(const QString &classId, const QString &parentId,
+                                          const QString &rootName, const QStringList &relativeDirs,
+                                          const QString &uploaderEmail)
+{
+    FolderTreeJob job;
+    job.classId = classId;
+    job.parentId = parentId;
+    job.rootName = rootName;
+    job.uploaderEmail = uploaderEmail;
+
+    // 按深度分层：第 0 层是根目录（空路径），"a" 在第 1 层，"a/b" 在第 2 层
+    job.levels.append(QStringList{QString()});
+    for (const QString &relPath : relativeDirs) {
+        if (relPath.isEmpty()) continue;
+        const int depth = relPath.count('/') + 1;
+        while (job.levels.size() <= depth) job.levels.append(QStringList());
+        job.levels[depth].append(relPath);
+    }
+
+    const QString treeId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    m_folderTrees.insert(treeId, job);
+    qDebug() << "[Material] 批量创建目录树:" << rootName
+             << "文件夹" << relativeDirs.size() + 1 << "层数" << job.levels.size();
+    createFolderLevel(treeId);
+    return treeId;
+}
+
+void MaterialManager::createFolderLevel(const QString &treeId)
 {
-    QFile file(localPath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        emit error("无法打开文件");
+    auto it = m_folderTrees.find(treeId);
+    if (it == m_folderTrees.end()) return;
+    FolderTreeJob &job = it.value();
+
+    // 跳过空层（中间层不会为空，保险起见）
+    while (job.nextLevel < job.levels.size() && job.levels[job.nextLevel].isEmpty()) {
+        ++job.nextLevel;
+    }
+    if (job.nextLevel >= job.levels.size()) {
+        const QMap<QString, QString> pathToId = job.pathToId;
+        m_folderTrees.erase(it);
+        qDebug() << "[Material] 目录树已创建:" << pathToId.size() << "个文件夹";
+        emit folderTreeCreated(treeId, pathToId);
         return;
     }
 
-    qint64 fileSize = file.size();
-    QByteArray fileData = file.readAll();
-    file.close();
+    // 用 "父ID/名称" 匹配返回行，不依赖返回顺序（同一父目录下不会重名）
+    QHash<QString, QString> keyToPath;
+    QJsonArray rows;
+    for (const QString &relPath : job.levels[job.nextLevel]) {
+        QString parentFolderId;
+        QString name;
+        if (relPath.isEmpty()) {
+            parentFolderId = job.parentId;
+            name = job.rootName;
+        } else {
+            const int slash = relPath.lastIndexOf('/');
+            parentFolderId = job.pathToId.value(slash < 0 ? QString() : relPath.left(slash));
+            name = relPath.mid(slash + 1);
+        }
+        keyToPath.insert(parentFolderId + "/" + name, relPath);
 
-    QString fileName = QFileInfo(localPath).fileName();
-    // 存储路径用 hash 避免中文/特殊字符导致 URL 编码问题
-    QString storageName = QDateTime::currentDateTime().toString("yyyyMMddHHmmss")
-                          + "_" + QString::number(qHash(fileName), 16);
-    QString storagePath = classId + "/" + storageName;
-
-    // 1. 上传到 Supabase Storage（multipart/form-data）
-    QUrl storageUrl(SupabaseConfig::supabaseUrl() + "/storage/v1/object/materials/" + storagePath);
-    QNetworkRequest request(storageUrl);
-    request.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
-    request.setRawHeader("Authorization",
-        QString("Bearer %1").arg(SupabaseConfig::supabaseAnonKey()).toUtf8());
-    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
-    // 不设 Content-Type，由 QHttpMultiPart 自动设置 multipart/form-data; boundary=...
-
-    auto *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
-
-    QHttpPart filePart;
-    filePart.setHeader(QNetworkRequest::ContentDispositionHeader,
-        QVariant(QString("form-data; name=\"file\"; filename=\"%1\"").arg(fileName)));
-    filePart.setHeader(QNetworkRequest::ContentTypeHeader, QVariant(mimeType));
-    filePart.setBody(fileData);
-    multiPart->append(filePart);
-
-    QNetworkReply *reply = m_networkManager->post(request, multiPart);
-    multiPart->setParent(reply);
-
-    connect(reply, &QNetworkReply::finished, this, [=]() {
-        QByteArray responseBody = reply->readAll();
+        QJsonObject row;
+        row["class_id"] = job.classId;
+        row["folder_id"] = parentFolderId.isEmpty() ? QJsonValue() : parentFolderId;
+        row["name"] = name;
+        row["type"] = "folder";
+        row["uploader_email"] = job.uploaderEmail;
+        rows.append(row);
+    }
+
+    QUrl url(SupabaseConfig::supabaseUrl() + "/rest/v1/materials");
+    QNetworkRequest request = NetworkRequestFactory::createAuthRequest(url);
+    request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    request.setRawHeader("Prefer", "return=representation");
+
+    QNetworkReply *reply = m_networkManager->post(request, QJsonDocument(rows).toJson(QJsonDocument::Compact));
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply, treeId, keyToPath]() {
         reply->deleteLater();
+        auto it = m_folderTrees.find(treeId);
+        if (it == m_folderTrees.end()) return;
+
         if (reply->error() != QNetworkReply::NoError) {
-            qWarning() << "[Material] upload failed:" << reply->errorString();
-            qWarning() << "[Material] response:" << responseBody;
-            emit error("文件上传失败: " + QString::fromUtf8(responseBody));
+            qWarning() << "[Material] create folder level failed:" << reply->errorString();
+            m_folderTrees.erase(it);
+            emit error("创建文件夹失败");
+            emit folderTreeFailed(treeId);
             return;
         }
 
-        QString fileUrl = SupabaseConfig::supabaseUrl() + "/storage/v1/object/public/materials/" + storagePath;
-
-        // 2. 创建 material 记录
-        QUrl dbUrl(SupabaseConfig::supabaseUrl() + "/rest/v1/materials");
-        QNetworkRequest dbRequest = NetworkRequestFactory::createAuthRequest(dbUrl);
-        dbRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-        dbRequest.setRawHeader("Prefer", "return=representation");
-
-        QJsonObject body;
-        body["class_id"] = classId;
-        body["folder_id"] = parentId.isEmpty() ? QJsonValue() : parentId;
-        body["name"] = fileName;
-        body["type"] = "file";
-        body["file_url"] = fileUrl;
-        body["file_size"] = fileSize;
-        body["mime_type"] = mimeType;
-        body["uploader_email"] = uploaderEmail;
-
-        QNetworkReply *dbReply = m_networkManager->post(dbRequest, QJsonDocument(body).toJson());
-        connect(dbReply, &QNetworkReply::finished, this, [this, dbReply]() {
-            dbReply->deleteLater();
-            if (dbReply->error() != QNetworkReply::NoError) {
-                qWarning() << "[Material] create record failed:" << dbReply->errorString();
-                emit error("创建文件记录失败");
-                return;
-            }
-            QJsonArray arr = QJsonDocument::fromJson(dbReply->readAll()).array();
-            if (!arr.isEmpty()) {
-                MaterialInfo info = MaterialInfo::fromJson(arr[0].toObject());
-                qDebug() << "[Material] 文件已上传:" << info.name;
-                emit fileUploaded(info);
+        QMap<QString, QString> levelPathToId;
+        const QJsonArray arr = QJsonDocument::fromJson(reply->readAll()).array();
+        for (const auto &val : arr) {
+            const MaterialInfo info = MaterialInfo::fromJson(val.toObject());
+            const auto match = keyToPath.constFind(info.folderId + "/" + info.name);
+            if (match != keyToPath.constEnd()) {
+                levelPathToId.insert(match.value(), info.id);
             }
-        });
+        }
+        if (levelPathToId.size() != keyToPath.size()) {
+            qWarning() << "[Material] folder level incomplete:" << levelPathToId.size() << "/" << keyToPath.size();
+            m_folderTrees.erase(it);
+            emit error("创建文件夹失败");
+            emit folderTreeFailed(treeId);
+            return;
+        }
+
+        FolderTreeJob &job = it.value();
+        for (auto p = levelPathToId.cbegin(); p != levelPathToId.cend(); ++p) {
+            job.pathToId.insert(p.key(), p.value());
+        }
+        ++job.nextLevel;
+
+        emit folderTreeLevelCreated(treeId, levelPathToId);
+        createFolderLevel(treeId);
+    });
+}
+
+// ── 上传文件 ──
+void MaterialManager::uploadFile(const QString &classId, const QString &parentId,
+                                  const QString &localPath, const QString &mimeType,
+                                  const QString &uploaderEmail)
+{
+    QString fileName = QFileInfo(localPath).fileName();
+    // 存储路径用 hash 避免中文/特殊字符导致 URL 编码问题
+    QString storageName = QDateTime::currentDateTime().toString("yyyyMMddHHmmss")
+                          + "_" + QString::number(qHash(fileName), 16);
+
+    // 记录字段随上传任务持久化，应用重启续传完成后仍能建记录
+    QJsonObject context;
+    context["kind"] = kMaterialUploadKind;
+    context["class_id"] = classId;
+    context["folder_id"] = parentId;
+    context["name"] = fileName;
+    context["mime_type"] = mimeType;
+    context["uploader_email"] = uploaderEmail;
+
+    ResumableUploadService::UploadRequest request;
+    request.localPath = localPath;
+    request.bucket = "materials";
+    request.objectPath = classId + "/" + storageName;
+    request.contentType = mimeType;
+    request.context = context;
+    ResumableUploadService::instance()->enqueue(request);
+}
+
+void MaterialManager::resumePendingUploads()
+{
+    ResumableUploadService::instance()->resumePendingOnce();
+}
+
+void MaterialManager::createFileRecord(const QJsonObject &context, const QString &storagePath, qint64 fileSize)
+{
+    QString fileUrl = SupabaseConfig::supabaseUrl() + "/storage/v1/object/public/materials/" + storagePath;
+    const QString parentId = context["folder_id"].toString();
+
+    QUrl dbUrl(SupabaseConfig::supabaseUrl() + "/rest/v1/materials");
+    QNetworkRequest dbRequest = NetworkRequestFactory::createAuthRequest(dbUrl);
+    dbRequest.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
+    dbRequest.setRawHeader("Prefer", "return=representation");
+
+    QJsonObject body;
+    body["class_id"] = context["class_id"].toString();
+    body["folder_id"] = parentId.isEmpty() ? QJsonValue() : parentId;
+    body["name"] = context["name"].toString();
+    body["type"] = "file";
+    body["file_url"] = fileUrl;
+    body["file_size"] = fileSize;
+    body["mime_type"] = context["mime_type"].toString();
+    body["uploader_email"] = context["uploader_email"].toString();
+
+    QNetworkReply *dbReply = m_networkManager->post(dbRequest, QJsonDocument(body).toJson());
+    connect(dbReply, &QNetworkReply::finished, this, [this, dbReply]() {
+        dbReply->deleteLater();
+        if (dbReply->error() != QNetworkReply::NoError) {
+            qWarning() << "[Material] create record failed:" << dbReply->errorString();
+            emit error("创建文件记录失败");
+            return;
+        }
+        QJsonArray arr = QJsonDocument::fromJson(dbReply->readAll()).array();
+        if (!arr.isEmpty()) {
+            MaterialInfo info = MaterialInfo::fromJson(arr[0].toObject());
+            qDebug() << "[Material] 文件已上传:" << info.name;
+            emit fileUploaded(info);
+        }
     });
 }
 
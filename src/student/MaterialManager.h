@@ -6,6 +6,8 @@
 #include <QDateTime>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QHash>
+#include <QMap>
 
 class MaterialManager : public QObject
 {
@@ -24,23 +26,58 @@ public:
 
     void createFolder(const QString &classId, const QString &parentId,
                       const QString &name, const QString &uploaderEmail);
+    /**
+     * @brief 批量创建整棵目录树
+     *
+     * 同一深度的文件夹一次批量插入，往返次数等于树的深度而不是文件夹数。
+     * 每层建好后发出 folderTreeLevelCreated，调用方可立即开始上传该层文件夹里的文件。
+     * @param relativeDirs 相对根目录的子目录路径（如 "a"、"a/b"），根目录本身对应空路径
+     * @return 树 ID，用于匹配后续信号
+     */
+    QString createFolderTree(const QString &classId, const QString &parentId,
+                             const QString &rootName, const QStringList &relativeDirs,
+                             const QString &uploaderEmail);
+    // 分块续传上传（ResumableUploadService），完成后自动创建资料记录
     void uploadFile(const QString &classId, const QString &parentId,
                     const QString &localPath, const QString &mimeType,
                     const QString &uploaderEmail);
+    // 恢复上次未完成的上传（每个进程只恢复一次，可重复调用）
+    void resumePendingUploads();
     void loadMaterials(const QString &classId, const QString &folderId);
     void deleteMaterial(const QString &materialId);
 
 signals:
     void folderCreated(const MaterialInfo &info);
     void fileUploaded(const MaterialInfo &info);
+    // pathToId: 相对路径 -> 文件夹 ID（level 信号只含本层，完成信号含整棵树）
+    void folderTreeLevelCreated(const QString &treeId, const QMap<QString, QString> &pathToId);
+    void folderTreeCreated(const QString &treeId, const QMap<QString, QString> &pathToId);
+    void folderTreeFailed(const QString &treeId);
+    void uploadThroughput(qint64 bytesPerSecond, qint64 bytesDone, qint64 bytesTotal,
+                          int activeCount, int queuedCount);
+    void uploadsIdle();
     void materialsLoaded(const QString &folderId, const QList<MaterialInfo> &list);
     void materialDeleted(const QString &materialId);
     void error(const QString &msg);
 
 private:
     MaterialManager(QObject *parent = nullptr);
+    void createFileRecord(const QJsonObject &context, const QString &storagePath, qint64 fileSize);
+
+    struct FolderTreeJob {
+        QString classId;
+        QString parentId;
+        QString rootName;
+        QString uploaderEmail;
+        QList<QStringList> levels;          // 深度 -> 该层的相对路径
+        int nextLevel = 0;
+        QMap<QString, QString> pathToId;
+    };
+    void createFolderLevel(const QString &treeId);
+
     static MaterialManager *s_instance;
     QNetworkAccessManager *m_networkManager;
+    QHash<QString, FolderTreeJob> m_folderTrees;
 };
 
 #endif
@@ -49,13 +49,45 @@ MaterialWidget::MaterialWidget(const QString &classId, const QString &uploaderEm
 
     connect(MaterialManager::instance(), &MaterialManager::folderCreated, this,
             [this](const MaterialManager::MaterialInfo &) { refreshCurrentFolder(); });
+    connect(MaterialManager::instance(), &MaterialManager::folderTreeLevelCreated, this,
+            [this](const QString &treeId, const QMap<QString, QString> &pathToId) {
+        auto it = m_pendingTreeFiles.constFind(treeId);
+        if (it == m_pendingTreeFiles.constEnd()) return;
+        QMimeDatabase mimeDb;
+        for (auto p = pathToId.cbegin(); p != pathToId.cend(); ++p) {
+            for (const auto &fp : it.value().value(p.key())) {
+                QString mt = mimeDb.mimeTypeForFile(fp).name();
+                MaterialManager::instance()->uploadFile(m_classId, p.value(), fp, mt, m_uploaderEmail);
+            }
+        }
+    });
+    connect(MaterialManager::instance(), &MaterialManager::folderTreeCreated, this,
+            [this](const QString &treeId, const QMap<QString, QString> &) {
+        if (m_pendingTreeFiles.remove(treeId)) refreshCurrentFolder();
+    });
+    connect(MaterialManager::instance(), &MaterialManager::folderTreeFailed, this,
+            [this](const QString &treeId) {
+        if (m_pendingTreeFiles.remove(treeId)) refreshCurrentFolder();
+    });
     connect(MaterialManager::instance(), &MaterialManager::fileUploaded, this,
             [this](const MaterialManager::MaterialInfo &) { refreshCurrentFolder(); });
+    connect(MaterialManager::instance(), &MaterialManager::uploadThroughput, this,
+            [this](qint64 bytesPerSecond, qint64 bytesDone, qint64 bytesTotal, int activeCount, int queuedCount) {
+        const int percent = bytesTotal > 0 ? static_cast<int>(bytesDone * 100 / bytesTotal) : 0;
+        m_uploadStatusLabel->setText(QString("正在上传 %1 个文件（排队 %2）· %3/s · %4%")
+            .arg(activeCount).arg(queuedCount).arg(formatFileSize(bytesPerSecond)).arg(percent));
+        m_uploadStatusLabel->show();
+    });
+    connect(MaterialManager::instance(), &MaterialManager::uploadsIdle, this,
+            [this]() { m_uploadStatusLabel->hide(); });
     connect(MaterialManager::instance(), &MaterialManager::materialDeleted, this,
             [this](const QString &) { refreshCurrentFolder(); });
     connect(MaterialManager::instance(), &MaterialManager::error, this,
             [this](const QString &msg) { ClassDetailWidget::showModernInfo(this, "操作失败", msg); });
 
+    // 续传上次退出时未完成的上传（服务内部保证每个进程只恢复一次）
+    MaterialManager::instance()->resumePendingUploads();
+
     // 加载根目录
     loadFolder(QString());
 }
@@ -101,9 +133,15 @@ void MaterialWidget::setupUI()
     ).arg(StyleConfig::TEXT_PRIMARY, StyleConfig::BORDER_LIGHT));
     connect(folderBtn, &QPushButton::clicked, this, &MaterialWidget::onCreateFolderClicked);
 
+    m_uploadStatusLabel = new QLabel();
+    m_uploadStatusLabel->setStyleSheet("font-size: 12px; color: #6B7280; background: transparent;");
+    m_uploadStatusLabel->hide();
+
     headerRow->addWidget(backBtn);
     headerRow->addWidget(title);
     headerRow->addStretch();
+    headerRow->addWidget(m_uploadStatusLabel);
+    headerRow->addSpacing(12);
     headerRow->addWidget(folderBtn);
     headerRow->addSpacing(8);
     headerRow->addWidget(uploadBtn);
@@ -392,16 +430,8 @@ void MaterialWidget::onUploadFileClicked()
     if (selected == fileAction) {
         QStringList files = QFileDialog::getOpenFileNames(this, "选择文件");
         if (files.isEmpty()) return;
+        // 大文件分块续传，同时上传的文件数由上传服务限流
         for (const auto &filePath : files) {
-            qint64 size = QFileInfo(filePath).size();
-            if (size > 50 * 1024 * 1024) {
-                ClassDetailWidget::showModernInfo(this, "文件过大",
-                    QString("文件 \"%1\" 大小为 %2MB，超过 50MB 上传限制。\n"
-                            "大文件建议压缩后上传或使用外部链接。")
-                    .arg(QFileInfo(filePath).fileName())
-                    .arg(size / (1024.0 * 1024.0), 0, 'f', 1));
-                continue;
-            }
             QString mimeType = mimeDb.mimeTypeForFile(filePath).name();
             MaterialManager::instance()->uploadFile(m_classId, m_currentFolderId, filePath, mimeType, m_uploaderEmail);
         }
@@ -424,77 +454,15 @@ void MaterialWidget::onUploadFileClicked()
                 allDirs.insert(rootDir.relativeFilePath(path));
             } else if (fi.isFile()) {
                 QString relDir = rootDir.relativeFilePath(fi.absolutePath());
+                if (relDir == ".") relDir.clear();   // 根目录本身对应空路径
                 dirToFiles[relDir].append(path);
             }
         }
 
-        // 按深度排序
-        QStringList sortedDirs = allDirs.values();
-        std::sort(sortedDirs.begin(), sortedDirs.end(), [](const QString &a, const QString &b) {
-            return a.count('/') < b.count('/');
-        });
-
-        // 2. 先创建用户选中的根文件夹，等成功后再逐级创建子目录
-        auto *pathToId = new QMap<QString, QString>();
-
-        connect(MaterialManager::instance(), &MaterialManager::folderCreated, this,
-            [this, sortedDirs, dirToFiles, pathToId](const MaterialManager::MaterialInfo &rootInfo) {
-            // 根文件夹创建成功，映射 "" → 根ID
-            pathToId->insert("", rootInfo.id);
-
-            // 上传根目录里的文件
-            QMimeDatabase mimeDb;
-            for (const auto &fp : dirToFiles.value("")) {
-                if (QFileInfo(fp).size() > 50 * 1024 * 1024) {
-                    qWarning() << "[Material] 跳过大文件:" << fp << QFileInfo(fp).size() / (1024*1024) << "MB";
-                    continue;
-                }
-                QString mt = mimeDb.mimeTypeForFile(fp).name();
-                MaterialManager::instance()->uploadFile(m_classId, rootInfo.id, fp, mt, m_uploaderEmail);
-            }
-
-            // 逐级创建子文件夹
-            auto *createNext = new std::function<void(int)>();
-            *createNext = [this, sortedDirs, dirToFiles, pathToId, createNext](int idx) mutable {
-                if (idx >= sortedDirs.size()) {
-                    delete createNext;
-                    delete pathToId;
-                    return;
-                }
-                QString relPath = sortedDirs[idx];
-                QString parentRel = relPath.contains('/') ? relPath.left(relPath.lastIndexOf('/')) : "";
-                QString parentFolderId = pathToId->value(parentRel);
-                QString folderName = relPath.contains('/') ? relPath.mid(relPath.lastIndexOf('/') + 1) : relPath;
-
-                connect(MaterialManager::instance(), &MaterialManager::folderCreated, this,
-                    [this, idx, relPath, dirToFiles, pathToId, createNext](const MaterialManager::MaterialInfo &info) {
-                    pathToId->insert(relPath, info.id);
-
-                    QMimeDatabase mimeDb;
-                    for (const auto &fp : dirToFiles.value(relPath)) {
-                        if (QFileInfo(fp).size() > 50 * 1024 * 1024) {
-                            qWarning() << "[Material] 跳过大文件:" << fp << QFileInfo(fp).size() / (1024*1024) << "MB";
-                            continue;
-                        }
-                        QString mt = mimeDb.mimeTypeForFile(fp).name();
-                        MaterialManager::instance()->uploadFile(m_classId, info.id, fp, mt, m_uploaderEmail);
-                    }
-
-                    (*createNext)(idx + 1);
-                }, Qt::SingleShotConnection);
-
-                MaterialManager::instance()->createFolder(m_classId, parentFolderId, folderName, m_uploaderEmail);
-            };
-
-            if (!sortedDirs.isEmpty()) {
-                (*createNext)(0);
-            } else {
-                delete pathToId;
-            }
-        }, Qt::SingleShotConnection);
-
-        // 创建根文件夹（选中的那个文件夹）
-        MaterialManager::instance()->createFolder(m_classId, m_currentFolderId, rootName, m_uploaderEmail);
+        // 2. 按深度批量创建整棵目录树，每层建好后立即上传该层文件夹里的文件
+        const QString treeId = MaterialManager::instance()->createFolderTree(
+            m_classId, m_currentFolderId, rootName, allDirs.values(), m_uploaderEmail);
+        m_pendingTreeFiles.insert(treeId, dirToFiles);
     }
 }
 
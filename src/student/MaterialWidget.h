@@ -90,12 +90,15 @@ private:
     QString m_uploaderEmail;
     QString m_currentFolderId;
     QList<QPair<QString, QString>> m_breadcrumb; // (folderId, folderName)
+    // 进行中的文件夹上传：树 ID -> (相对目录 -> 本地文件)
+    QHash<QString, QMap<QString, QStringList>> m_pendingTreeFiles;
 
     QFrame *m_breadcrumbBar = nullptr;
     QHBoxLayout *m_breadcrumbLayout = nullptr;
     QGridLayout *m_gridLayout = nullptr;
     QWidget *m_gridContainer = nullptr;
     QScrollArea *m_scrollArea = nullptr;
+    QLabel *m_uploadStatusLabel = nullptr;
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include "../settings/UserSettingsManager.h"
 #include "../auth/supabase/supabaseconfig.h"
 #include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
 #include <QHBoxLayout>
 #include <QFrame>
 #include <QScrollArea>
@@ -30,7 +31,7 @@ StudentClassDetailWidget::StudentClassDetailWidget(const ClassInfo &info, QWidge
     : QWidget(parent), m_classInfo(info)
     , m_studentEmail(UserSettingsManager::instance()->email())
     , m_studentName(UserSettingsManager::instance()->nickname())
-    , m_networkManagerForUpload(new QNetworkAccessManager(this))
+    , m_networkManagerForUpload(SessionNetworkManager::forCurrentThread())
 {
     setupUI();
 
@@ -143,9 +144,24 @@ StudentClassDetailWidget::StudentClassDetailWidget(const ClassInfo &info, QWidge
         m_attendanceLayout->addStretch();
     });
 
+    connect(AttendanceManager::instance(), &AttendanceManager::studentAttendanceStatsLoaded, this,
+        [this](const QString &classId, const QString &studentEmail, const AttendanceStatsStore::Rollup &rollup) {
+        if (classId != m_classInfo.id || studentEmail != m_studentEmail) return;
+        if (rollup.totalCount == 0) {
+            m_attendanceSummaryLabel->clear();
+            return;
+        }
+        m_attendanceSummaryLabel->setText(QString("出勤率 %1% · 迟到 %2 · 缺勤 %3 · 连续出勤 %4 次")
+            .arg(rollup.attendanceRate(), 0, 'f', 1).arg(rollup.lateCount)
+            .arg(rollup.absentCount).arg(rollup.currentStreak));
+    });
+
     // ── 作业加载 ──
-    connect(HomeworkManager::instance(), &HomeworkManager::assignmentsLoaded, this,
-        [this](const QList<HomeworkManager::AssignmentInfo> &list) {
+    connect(HomeworkManager::instance(), &HomeworkManager::studentHomeworkLoaded, this,
+        [this](const QString &classId, const QString &studentEmail,
+               const QList<HomeworkManager::StudentAssignment> &list) {
+        if (classId != m_classInfo.id || studentEmail != m_studentEmail) return;
+
         while (m_homeworkLayout->count() > 1) {
             auto *item = m_homeworkLayout->takeAt(m_homeworkLayout->count() - 1);
             delete item->widget(); delete item;
@@ -157,301 +173,284 @@ StudentClassDetailWidget::StudentClassDetailWidget(const ClassInfo &info, QWidge
             empty->setStyleSheet("font-size: 14px; color: #9CA3AF; padding: 40px; background: transparent; border: none;");
             m_homeworkLayout->addWidget(empty);
         } else {
-            for (const auto &a : list) {
-                connect(HomeworkManager::instance(), &HomeworkManager::submissionsLoaded, this,
-                    [this, a](const QString &assignmentId, const QList<HomeworkManager::SubmissionInfo> &subs) {
-                    if (assignmentId != a.id) return;
-
-                    const HomeworkManager::SubmissionInfo *mySub = nullptr;
-                    for (const auto &s : subs) {
-                        if (s.studentEmail == m_studentEmail) { mySub = &s; break; }
-                    }
+            // 作业与本人提交已在同一次查询中返回，逐项直接渲染
+            for (const auto &item : list) {
+                const HomeworkManager::AssignmentInfo &a = item.assignment;
+                const HomeworkManager::SubmissionInfo *mySub = item.hasSubmission ? &item.submission : nullptr;
 
-                    bool exists = false;
-                    for (int i = 0; i < m_homeworkLayout->count(); ++i) {
-                        auto *w = m_homeworkLayout->itemAt(i)->widget();
-                        if (w && w->property("hwId").toString() == a.id) { exists = true; break; }
-                    }
-                    if (exists) return;
-
-                    auto *card = new QFrame();
-                    card->setProperty("hwId", a.id);
-                    card->setObjectName("hwCard");
-                    card->setStyleSheet(
-                        "#hwCard { background: white; border: 1px solid #E5E7EB; border-radius: 10px; }"
-                        "#hwCard:hover { border-color: #E53935; }");
-                    auto *layout = new QVBoxLayout(card); layout->setContentsMargins(16, 12, 16, 12); layout->setSpacing(6);
-
-                    auto *titleRow = new QHBoxLayout();
-                    auto *title = new QLabel(a.title);
-                    title->setStyleSheet(QString("font-size: 15px; font-weight: 700; color: %1; background: transparent; border: none;").arg(StyleConfig::TEXT_PRIMARY));
-
-                    QString timeText = a.endTime.isValid() ? "截止: " + a.endTime.toString("MM-dd HH:mm") : "无截止时间";
-                    auto *timeL = new QLabel(timeText);
-                    timeL->setStyleSheet("font-size: 12px; color: #9CA3AF; background: transparent; border: none;");
-                    titleRow->addWidget(title); titleRow->addStretch(); titleRow->addWidget(timeL);
-                    layout->addLayout(titleRow);
-
-                    if (!a.description.isEmpty()) {
-                        auto *desc = new QLabel(a.description.length() > 60 ? a.description.left(60) + "..." : a.description);
-                        desc->setWordWrap(true);
-                        desc->setStyleSheet("font-size: 13px; color: #6B7280; background: transparent; border: none;");
-                        layout->addWidget(desc);
-                    }
+                auto *card = new QFrame();
+                card->setProperty("hwId", a.id);
+                card->setObjectName("hwCard");
+                card->setStyleSheet(
+                    "#hwCard { background: white; border: 1px solid #E5E7EB; border-radius: 10px; }"
+                    "#hwCard:hover { border-color: #E53935; }");
+                auto *layout = new QVBoxLayout(card); layout->setContentsMargins(16, 12, 16, 12); layout->setSpacing(6);
+
+                auto *titleRow = new QHBoxLayout();
+                auto *title = new QLabel(a.title);
+                title->setStyleSheet(QString("font-size: 15px; font-weight: 700; color: %1; background: transparent; border: none;").arg(StyleConfig::TEXT_PRIMARY));
+
+                QString timeText = a.endTime.isValid() ? "截止: " + a.endTime.toString("MM-dd HH:mm") : "无截止时间";
+                auto *timeL = new QLabel(timeText);
+                timeL->setStyleSheet("font-size: 12px; color: #9CA3AF; background: transparent; border: none;");
+                titleRow->addWidget(title); titleRow->addStretch(); titleRow->addWidget(timeL);
+                layout->addLayout(titleRow);
+
+                if (!a.description.isEmpty()) {
+                    auto *desc = new QLabel(a.description.length() > 60 ? a.description.left(60) + "..." : a.description);
+                    desc->setWordWrap(true);
+                    desc->setStyleSheet("font-size: 13px; color: #6B7280; background: transparent; border: none;");
+                    layout->addWidget(desc);
+                }
 
-                    auto *bottomRow = new QHBoxLayout();
-                    if (mySub) {
-                        // 已提交 — 显示状态
-                        if (mySub->status == 2) {
-                            auto *scoreL = new QLabel(QString("得分: %1 / %2").arg(mySub->score).arg(a.totalScore));
-                            scoreL->setStyleSheet("font-size: 13px; font-weight: 600; color: #059669; background: transparent; border: none;");
-                            bottomRow->addWidget(scoreL);
-                            if (!mySub->feedback.isEmpty()) {
-                                bottomRow->addSpacing(12);
-                                auto *fb = new QLabel("反馈: " + mySub->feedback.left(30));
-                                fb->setStyleSheet("font-size: 12px; color: #6B7280; background: transparent; border: none;");
-                                bottomRow->addWidget(fb);
-                            }
-                        } else {
-                            auto *tag = new QLabel("已提交 · 待批改");
-                            tag->setStyleSheet("font-size: 12px; font-weight: 600; color: #D97706; background: #FEF3C7; padding: 3px 10px; border-radius: 10px; border: none;");
-                            bottomRow->addWidget(tag);
+                auto *bottomRow = new QHBoxLayout();
+                if (mySub) {
+                    // 已提交 — 显示状态
+                    if (mySub->status == 2) {
+                        auto *scoreL = new QLabel(QString("得分: %1 / %2").arg(mySub->score).arg(a.totalScore));
+                        scoreL->setStyleSheet("font-size: 13px; font-weight: 600; color: #059669; background: transparent; border: none;");
+                        bottomRow->addWidget(scoreL);
+                        if (!mySub->feedback.isEmpty()) {
+                            bottomRow->addSpacing(12);
+                            auto *fb = new QLabel("反馈: " + mySub->feedback.left(30));
+                            fb->setStyleSheet("font-size: 12px; color: #6B7280; background: transparent; border: none;");
+                            bottomRow->addWidget(fb);
                         }
-                        bottomRow->addStretch();
-
-                        // 查看提交内容按钮
-                        auto *viewBtn = new QPushButton("查看");
-                        viewBtn->setCursor(Qt::PointingHandCursor);
-                        viewBtn->setFixedSize(50, 24);
-                        viewBtn->setStyleSheet(
-                            "QPushButton { background: transparent; border: 1px solid #E5E7EB; border-radius: 4px;"
-                            "  color: #6B7280; font-size: 11px; }"
+                    } else {
+                        auto *tag = new QLabel("已提交 · 待批改");
+                        tag->setStyleSheet("font-size: 12px; font-weight: 600; color: #D97706; background: #FEF3C7; padding: 3px 10px; border-radius: 10px; border: none;");
+                        bottomRow->addWidget(tag);
+                    }
+                    bottomRow->addStretch();
+
+                    // 查看提交内容按钮
+                    auto *viewBtn = new QPushButton("查看");
+                    viewBtn->setCursor(Qt::PointingHandCursor);
+                    viewBtn->setFixedSize(50, 24);
+                    viewBtn->setStyleSheet(
+                        "QPushButton { background: transparent; border: 1px solid #E5E7EB; border-radius: 4px;"
+                        "  color: #6B7280; font-size: 11px; }"
+                        "QPushButton:hover { border-color: #E53935; color: #E53935; }");
+                    HomeworkManager::SubmissionInfo viewSub = *mySub;
+                    connect(viewBtn, &QPushButton::clicked, this, [this, viewSub]() {
+                        showSubmissionDetailDialog(viewSub);
+                    });
+                    bottomRow->addWidget(viewBtn);
+                } else {
+                    bool expired = a.endTime.isValid() && a.endTime < QDateTime::currentDateTime();
+                    auto *submitBtn = new QPushButton(expired ? "已截止" : "提交作业");
+                    submitBtn->setCursor(Qt::PointingHandCursor);
+                    submitBtn->setFixedSize(90, 28);
+                    submitBtn->setEnabled(!expired);
+                    submitBtn->setStyleSheet(QString(
+                        "QPushButton { background: %1; color: white; border: none; border-radius: 6px; font-size: 12px; font-weight: 600; }"
+                        "QPushButton:hover { background: #C62828; }"
+                        "QPushButton:disabled { background: #D1D5DB; color: #9CA3AF; }"
+                    ).arg(StyleConfig::PATRIOTIC_RED));
+
+                    QString assignmentId = a.id;
+                    connect(submitBtn, &QPushButton::clicked, this, [this, assignmentId]() {
+                        QDialog dlg(this);
+                        dlg.setWindowTitle("提交作业");
+                        dlg.setMinimumSize(480, 420);
+                        dlg.setStyleSheet(QString("QDialog { background: %1; }").arg(StyleConfig::BG_APP));
+
+                        auto *dlgLayout = new QVBoxLayout(&dlg);
+                        dlgLayout->setSpacing(12);
+
+                        auto *edit = new QTextEdit();
+                        edit->setPlaceholderText("在此输入作业内容（可选）...");
+                        edit->setStyleSheet(
+                            "QTextEdit { border: 1px solid #E5E7EB; border-radius: 8px; padding: 8px; font-size: 14px; background: white; }"
+                            "QTextEdit:focus { border-color: #E53935; }");
+                        dlgLayout->addWidget(edit, 1);
+
+                        // 文件选择行
+                        auto *fileRow = new QHBoxLayout();
+                        auto *fileBtn = new QPushButton("选择文件");
+                        fileBtn->setCursor(Qt::PointingHandCursor);
+                        fileBtn->setStyleSheet(
+                            "QPushButton { background: white; border: 1px solid #E5E7EB; border-radius: 6px; padding: 6px 14px; font-size: 13px; color: #374151; }"
                             "QPushButton:hover { border-color: #E53935; color: #E53935; }");
-                        HomeworkManager::SubmissionInfo viewSub = *mySub;
-                        connect(viewBtn, &QPushButton::clicked, this, [this, viewSub]() {
-                            showSubmissionDetailDialog(viewSub);
+                        auto *fileCountLabel = new QLabel("未选择文件");
+                        fileCountLabel->setStyleSheet("font-size: 12px; color: #9CA3AF; background: transparent; border: none;");
+                        fileRow->addWidget(fileBtn);
+                        fileRow->addWidget(fileCountLabel, 1);
+                        dlgLayout->addLayout(fileRow);
+
+                        // 已选文件列表区
+                        auto *fileListWidget = new QWidget();
+                        fileListWidget->setStyleSheet("background: transparent; border: none;");
+                        auto *fileListLayout = new QVBoxLayout(fileListWidget);
+                        fileListLayout->setContentsMargins(0, 0, 0, 0);
+                        fileListLayout->setSpacing(4);
+                        dlgLayout->addWidget(fileListWidget);
+
+                        QStringList *selectedFiles = new QStringList();
+                        connect(fileBtn, &QPushButton::clicked, &dlg,
+                            [fileCountLabel, selectedFiles, fileListLayout]() {
+                            QStringList paths = QFileDialog::getOpenFileNames(nullptr, "选择文件");
+                            for (const auto &path : paths) {
+                                if (selectedFiles->contains(path)) continue;
+                                selectedFiles->append(path);
+                                QFileInfo fi(path);
+                                auto *row = new QHBoxLayout();
+                                auto *nameL = new QLabel(fi.fileName());
+                                nameL->setStyleSheet("font-size: 12px; color: #374151; background: transparent; border: none;");
+                                auto *removeBtn = new QPushButton("x");
+                                removeBtn->setFixedSize(20, 20);
+                                removeBtn->setCursor(Qt::PointingHandCursor);
+                                removeBtn->setStyleSheet(
+                                    "QPushButton { background: transparent; border: none; color: #9CA3AF; font-size: 14px; }"
+                                    "QPushButton:hover { color: #E53935; }");
+                                QString fp = path;
+                                connect(removeBtn, &QPushButton::clicked, nameL,
+                                    [selectedFiles, fp, fileCountLabel, nameL, removeBtn]() {
+                                    selectedFiles->removeOne(fp);
+                                    nameL->deleteLater();
+                                    removeBtn->deleteLater();
+                                    fileCountLabel->setText(selectedFiles->isEmpty()
+                                        ? "未选择文件" : QString("已选 %1 个文件").arg(selectedFiles->size()));
+                                    fileCountLabel->setStyleSheet(QString("font-size: 12px; color: %1; background: transparent; border: none;")
+                                        .arg(selectedFiles->isEmpty() ? "#9CA3AF" : "#374151"));
+                                });
+                                row->addWidget(nameL); row->addStretch(); row->addWidget(removeBtn);
+                                fileListLayout->addLayout(row);
+                            }
+                            fileCountLabel->setText(selectedFiles->isEmpty()
+                                ? "未选择文件" : QString("已选 %1 个文件").arg(selectedFiles->size()));
+                            fileCountLabel->setStyleSheet(QString("font-size: 12px; color: %1; background: transparent; border: none;")
+                                .arg(selectedFiles->isEmpty() ? "#9CA3AF" : "#374151"));
                         });
-                        bottomRow->addWidget(viewBtn);
-                    } else {
-                        bool expired = a.endTime.isValid() && a.endTime < QDateTime::currentDateTime();
-                        auto *submitBtn = new QPushButton(expired ? "已截止" : "提交作业");
-                        submitBtn->setCursor(Qt::PointingHandCursor);
-                        submitBtn->setFixedSize(90, 28);
-                        submitBtn->setEnabled(!expired);
-                        submitBtn->setStyleSheet(QString(
-                            "QPushButton { background: %1; color: white; border: none; border-radius: 6px; font-size: 12px; font-weight: 600; }"
+
+                        auto *btnRow = new QHBoxLayout();
+                        auto *cancelBtn = new QPushButton("取消");
+                        cancelBtn->setStyleSheet(
+                            "QPushButton { padding: 8px 24px; border: 1px solid #E5E7EB; border-radius: 8px;"
+                            "  background: white; color: #6B7280; font-size: 14px; }"
+                            "QPushButton:hover { background: #F9FAFB; }");
+                        connect(cancelBtn, &QPushButton::clicked, &dlg, &QDialog::reject);
+
+                        auto *okBtn = new QPushButton("提交");
+                        okBtn->setStyleSheet(QString(
+                            "QPushButton { padding: 8px 24px; border: none; border-radius: 8px;"
+                            "  background: %1; color: white; font-size: 14px; font-weight: 600; }"
                             "QPushButton:hover { background: #C62828; }"
-                            "QPushButton:disabled { background: #D1D5DB; color: #9CA3AF; }"
                         ).arg(StyleConfig::PATRIOTIC_RED));
+                        connect(okBtn, &QPushButton::clicked, &dlg, &QDialog::accept);
 
-                        QString assignmentId = a.id;
-                        connect(submitBtn, &QPushButton::clicked, this, [this, assignmentId]() {
-                            QDialog dlg(this);
-                            dlg.setWindowTitle("提交作业");
-                            dlg.setMinimumSize(480, 420);
-                            dlg.setStyleSheet(QString("QDialog { background: %1; }").arg(StyleConfig::BG_APP));
-
-                            auto *dlgLayout = new QVBoxLayout(&dlg);
-                            dlgLayout->setSpacing(12);
-
-                            auto *edit = new QTextEdit();
-                            edit->setPlaceholderText("在此输入作业内容（可选）...");
-                            edit->setStyleSheet(
-                                "QTextEdit { border: 1px solid #E5E7EB; border-radius: 8px; padding: 8px; font-size: 14px; background: white; }"
-                                "QTextEdit:focus { border-color: #E53935; }");
-                            dlgLayout->addWidget(edit, 1);
-
-                            // 文件选择行
-                            auto *fileRow = new QHBoxLayout();
-                            auto *fileBtn = new QPushButton("选择文件");
-                            fileBtn->setCursor(Qt::PointingHandCursor);
-                            fileBtn->setStyleSheet(
-                                "QPushButton { background: white; border: 1px solid #E5E7EB; border-radius: 6px; padding: 6px 14px; font-size: 13px; color: #374151; }"
-                                "QPushButton:hover { border-color: #E53935; color: #E53935; }");
-                            auto *fileCountLabel = new QLabel("未选择文件");
-                            fileCountLabel->setStyleSheet("font-size: 12px; color: #9CA3AF; background: transparent; border: none;");
-                            fileRow->addWidget(fileBtn);
-                            fileRow->addWidget(fileCountLabel, 1);
-                            dlgLayout->addLayout(fileRow);
-
-                            // 已选文件列表区
-                            auto *fileListWidget = new QWidget();
-                            fileListWidget->setStyleSheet("background: transparent; border: none;");
-                            auto *fileListLayout = new QVBoxLayout(fileListWidget);
-                            fileListLayout->setContentsMargins(0, 0, 0, 0);
-                            fileListLayout->setSpacing(4);
-                            dlgLayout->addWidget(fileListWidget);
-
-                            QStringList *selectedFiles = new QStringList();
-                            connect(fileBtn, &QPushButton::clicked, &dlg,
-                                [fileCountLabel, selectedFiles, fileListLayout]() {
-                                QStringList paths = QFileDialog::getOpenFileNames(nullptr, "选择文件");
-                                for (const auto &path : paths) {
-                                    if (selectedFiles->contains(path)) continue;
-                                    selectedFiles->append(path);
-                                    QFileInfo fi(path);
-                                    auto *row = new QHBoxLayout();
-                                    auto *nameL = new QLabel(fi.fileName());
-                                    nameL->setStyleSheet("font-size: 12px; color: #374151; background: transparent; border: none;");
-                                    auto *removeBtn = new QPushButton("x");
-                                    removeBtn->setFixedSize(20, 20);
-                                    removeBtn->setCursor(Qt::PointingHandCursor);
-                                    removeBtn->setStyleSheet(
-                                        "QPushButton { background: transparent; border: none; color: #9CA3AF; font-size: 14px; }"
-                                        "QPushButton:hover { color: #E53935; }");
-                                    QString fp = path;
-                                    connect(removeBtn, &QPushButton::clicked, nameL,
-                                        [selectedFiles, fp, fileCountLabel, nameL, removeBtn]() {
-                                        selectedFiles->removeOne(fp);
-                                        nameL->deleteLater();
-                                        removeBtn->deleteLater();
-                                        fileCountLabel->setText(selectedFiles->isEmpty()
-                                            ? "未选择文件" : QString("已选 %1 个文件").arg(selectedFiles->size()));
-                                        fileCountLabel->setStyleSheet(QString("font-size: 12px; color: %1; background: transparent; border: none;")
-                                            .arg(selectedFiles->isEmpty() ? "#9CA3AF" : "#374151"));
-                                    });
-                                    row->addWidget(nameL); row->addStretch(); row->addWidget(removeBtn);
-                                    fileListLayout->addLayout(row);
-                                }
-                                fileCountLabel->setText(selectedFiles->isEmpty()
-                                    ? "未选择文件" : QString("已选 %1 个文件").arg(selectedFiles->size()));
-                                fileCountLabel->setStyleSheet(QString("font-size: 12px; color: %1; background: transparent; border: none;")
-                                    .arg(selectedFiles->isEmpty() ? "#9CA3AF" : "#374151"));
-                            });
-
-                            auto *btnRow = new QHBoxLayout();
-                            auto *cancelBtn = new QPushButton("取消");
-                            cancelBtn->setStyleSheet(
-                                "QPushButton { padding: 8px 24px; border: 1px solid #E5E7EB; border-radius: 8px;"
-                                "  background: white; color: #6B7280; font-size: 14px; }"
-                                "QPushButton:hover { background: #F9FAFB; }");
-                            connect(cancelBtn, &QPushButton::clicked, &dlg, &QDialog::reject);
-
-                            auto *okBtn = new QPushButton("提交");
-                            okBtn->setStyleSheet(QString(
-                                "QPushButton { padding: 8px 24px; border: none; border-radius: 8px;"
-                                "  background: %1; color: white; font-size: 14px; font-weight: 600; }"
-                                "QPushButton:hover { background: #C62828; }"
-                            ).arg(StyleConfig::PATRIOTIC_RED));
-                            connect(okBtn, &QPushButton::clicked, &dlg, &QDialog::accept);
-
-                            btnRow->addStretch(); btnRow->addWidget(cancelBtn); btnRow->addWidget(okBtn);
-                            dlgLayout->addLayout(btnRow);
-
-                            if (dlg.exec() == QDialog::Accepted) {
-                                QString text = edit->toPlainText().trimmed();
-                                if (text.isEmpty() && selectedFiles->isEmpty()) { delete selectedFiles; return; }
-
-                                if (!selectedFiles->isEmpty()) {
-                                    // 多文件逐个上传，全部完成后提交
-                                    QStringList filesToUpload = *selectedFiles;
-                                    delete selectedFiles;
-                                    auto *uploadedUrls = new QStringList();
-                                    auto *remaining = new int(filesToUpload.size());
-
-                                    for (const QString &filePath : filesToUpload) {
-                                        QFile file(filePath);
-                                        if (!file.open(QIODevice::ReadOnly)) {
-                                            (*remaining)--;
-                                            if (*remaining == 0) {
-                                                QString urls = uploadedUrls->join(",");
-                                                delete uploadedUrls; delete remaining;
-                                                {
-                                                    QFile lf(QDir::homePath() + "/homework_upload.log");
-                                                    if (lf.open(QIODevice::Append | QIODevice::Text)) {
-                                                        QTextStream ts(&lf);
-                                                        ts << QDateTime::currentDateTime().toString("HH:mm:ss")
-                                                           << " SUBMIT urls=[" << urls << "] textLen=" << text.size() << "\n";
-                                                    }
-                                                }
-                                                HomeworkManager::instance()->submitHomework(
-                                                    assignmentId, m_studentEmail, m_studentName, text, urls);
-                                            }
-                                            continue;
-                                        }
-                                        QByteArray fileData = file.readAll();
-                                        file.close();
-
-                                        QFileInfo fi(filePath);
-                                        QString storageName = QDateTime::currentDateTime().toString("yyyyMMddHHmmss_")
-                                            + QString::number(qHash(fi.fileName()
-                                                + QString::number(QRandomGenerator::global()->generate())), 16);
-                                        QString ext = fi.suffix().isEmpty() ? "" : "." + fi.suffix();
-                                        storageName += ext;
-
-                                        QUrl storageUrl(SupabaseConfig::supabaseUrl()
-                                            + "/storage/v1/object/homework/" + storageName);
-                                        QNetworkRequest storageReq(storageUrl);
-                                        storageReq.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
-                                        storageReq.setRawHeader("Authorization",
-                                            ("Bearer " + SupabaseConfig::supabaseAnonKey()).toUtf8());
-
-                                        QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
-                                        QHttpPart filePart;
-                                        filePart.setHeader(QNetworkRequest::ContentDispositionHeader,
-                                            QVariant("form-data; name=\"file\"; filename=\"" + storageName + "\""));
-                                        filePart.setHeader(QNetworkRequest::ContentTypeHeader,
-                                            QVariant("application/octet-stream"));
-                                        filePart.setBody(fileData);
-                                        multiPart->append(filePart);
-
-                                        QNetworkReply *storageReply = m_networkManagerForUpload->post(storageReq, multiPart);
-                                        multiPart->setParent(storageReply);
-
-                                        connect(storageReply, &QNetworkReply::finished, this,
-                                            [this, assignmentId, text, storageName, storageReply, uploadedUrls, remaining]() {
-                                            storageReply->deleteLater();
-                                            // 写日志
+                        btnRow->addStretch(); btnRow->addWidget(cancelBtn); btnRow->addWidget(okBtn);
+                        dlgLayout->addLayout(btnRow);
+
+                        if (dlg.exec() == QDialog::Accepted) {
+                            QString text = edit->toPlainText().trimmed();
+                            if (text.isEmpty() && selectedFiles->isEmpty()) { delete selectedFiles; return; }
+
+                            if (!selectedFiles->isEmpty()) {
+                                // 多文件逐个上传，全部完成后提交
+                                QStringList filesToUpload = *selectedFiles;
+                                delete selectedFiles;
+                                auto *uploadedUrls = new QStringList();
+                                auto *remaining = new int(filesToUpload.size());
+
+                                for (const QString &filePath : filesToUpload) {
+                                    QFile file(filePath);
+                                    if (!file.open(QIODevice::ReadOnly)) {
+                                        (*remaining)--;
+                                        if (*remaining == 0) {
+                                            QString urls = uploadedUrls->join(",");
+                                            delete uploadedUrls; delete remaining;
                                             {
-                                                QFile logFile(QDir::homePath() + "/homework_upload.log");
-                                                if (logFile.open(QIODevice::Append | QIODevice::Text)) {
-                                                    QTextStream ts(&logFile);
+                                                QFile lf(QDir::homePath() + "/homework_upload.log");
+                                                if (lf.open(QIODevice::Append | QIODevice::Text)) {
+                                                    QTextStream ts(&lf);
                                                     ts << QDateTime::currentDateTime().toString("HH:mm:ss")
-                                                       << " file:" << storageName
-                                                       << " error:" << storageReply->error()
-                                                       << " msg:" << storageReply->errorString()
-                                                       << " status:" << storageReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()
-                                                       << " body:" << storageReply->readAll().left(200)
-                                                       << "\n";
+                                                       << " SUBMIT urls=[" << urls << "] textLen=" << text.size() << "\n";
                                                 }
                                             }
-                                            if (storageReply->error() == QNetworkReply::NoError) {
-                                                uploadedUrls->append(SupabaseConfig::supabaseUrl()
-                                                    + "/storage/v1/object/public/homework/" + storageName);
+                                            HomeworkManager::instance()->submitHomework(
+                                                assignmentId, m_studentEmail, m_studentName, text, urls);
+                                        }
+                                        continue;
+                                    }
+                                    QByteArray fileData = file.readAll();
+                                    file.close();
+
+                                    QFileInfo fi(filePath);
+                                    QString storageName = QDateTime::currentDateTime().toString("yyyyMMddHHmmss_")
+                                        + QString::number(qHash(fi.fileName()
+                                            + QString::number(QRandomGenerator::global()->generate())), 16);
+                                    QString ext = fi.suffix().isEmpty() ? "" : "." + fi.suffix();
+                                    storageName += ext;
+
+                                    QUrl storageUrl(SupabaseConfig::supabaseUrl()
+                                        + "/storage/v1/object/homework/" + storageName);
+                                    QNetworkRequest storageReq(storageUrl);
+                                    NetworkRequestFactory::applySupabaseAuth(storageReq);
+
+                                    QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+                                    QHttpPart filePart;
+                                    filePart.setHeader(QNetworkRequest::ContentDispositionHeader,
+                                        QVariant("form-data; name=\"file\"; filename=\"" + storageName + "\""));
+                                    filePart.setHeader(QNetworkRequest::ContentTypeHeader,
+                                        QVariant("application/octet-stream"));
+                                    filePart.setBody(fileData);
+                                    multiPart->append(filePart);
+
+                                    QNetworkReply *storageReply = m_networkManagerForUpload->post(storageReq, multiPart);
+                                    multiPart->setParent(storageReply);
+
+                                    connect(storageReply, &QNetworkReply::finished, this,
+                                        [this, assignmentId, text, storageName, storageReply, uploadedUrls, remaining]() {
+                                        storageReply->deleteLater();
+                                        // 写日志
+                                        {
+                                            QFile logFile(QDir::homePath() + "/homework_upload.log");
+                                            if (logFile.open(QIODevice::Append | QIODevice::Text)) {
+                                                QTextStream ts(&logFile);
+                                                ts << QDateTime::currentDateTime().toString("HH:mm:ss")
+                                                   << " file:" << storageName
+                                                   << " error:" << storageReply->error()
+                                                   << " msg:" << storageReply->errorString()
+                                                   << " status:" << storageReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt()
+                                                   << " body:" << storageReply->readAll().left(200)
+                                                   << "\n";
                                             }
-                                            (*remaining)--;
-                                            if (*remaining == 0) {
-                                                QString urls = uploadedUrls->join(",");
-                                                delete uploadedUrls; delete remaining;
-                                                {
-                                                    QFile lf(QDir::homePath() + "/homework_upload.log");
-                                                    if (lf.open(QIODevice::Append | QIODevice::Text)) {
-                                                        QTextStream ts(&lf);
-                                                        ts << QDateTime::currentDateTime().toString("HH:mm:ss")
-                                                           << " SUBMIT urls=[" << urls << "] textLen=" << text.size() << "\n";
-                                                    }
+                                        }
+                                        if (storageReply->error() == QNetworkReply::NoError) {
+                                            uploadedUrls->append(SupabaseConfig::supabaseUrl()
+                                                + "/storage/v1/object/public/homework/" + storageName);
+                                        }
+                                        (*remaining)--;
+                                        if (*remaining == 0) {
+                                            QString urls = uploadedUrls->join(",");
+                                            delete uploadedUrls; delete remaining;
+                                            {
+                                                QFile lf(QDir::homePath() + "/homework_upload.log");
+                                                if (lf.open(QIODevice::Append | QIODevice::Text)) {
+                                                    QTextStream ts(&lf);
+                                                    ts << QDateTime::currentDateTime().toString("HH:mm:ss")
+                                                       << " SUBMIT urls=[" << urls << "] textLen=" << text.size() << "\n";
                                                 }
-                                                HomeworkManager::instance()->submitHomework(
-                                                    assignmentId, m_studentEmail, m_studentName, text, urls);
                                             }
-                                        });
-                                    }
-                                } else {
-                                    delete selectedFiles;
-                                    HomeworkManager::instance()->submitHomework(
-                                        assignmentId, m_studentEmail, m_studentName, text);
+                                            HomeworkManager::instance()->submitHomework(
+                                                assignmentId, m_studentEmail, m_studentName, text, urls);
+                                        }
+                                    });
                                 }
                             } else {
                                 delete selectedFiles;
+                                HomeworkManager::instance()->submitHomework(
+                                    assignmentId, m_studentEmail, m_studentName, text);
                             }
-                        });
-                        bottomRow->addStretch(); bottomRow->addWidget(submitBtn);
-                    }
-                    layout->addLayout(bottomRow);
-                    m_homeworkLayout->addWidget(card);
-                });
-
-                HomeworkManager::instance()->loadSubmissions(a.id);
+                        } else {
+                            delete selectedFiles;
+                        }
+                    });
+                    bottomRow->addStretch(); bottomRow->addWidget(submitBtn);
+                }
+                layout->addLayout(bottomRow);
+                m_homeworkLayout->addWidget(card);
             }
         }
     });
@@ -637,7 +636,9 @@ QWidget* StudentClassDetailWidget::createAttendancePanel()
     auto *titleRow = new QHBoxLayout();
     auto *title = new QLabel("考勤明细");
     title->setStyleSheet(QString("font-size: 16px; font-weight: 700; color: %1; background: transparent; border: none;").arg(StyleConfig::TEXT_PRIMARY));
-    titleRow->addWidget(title); titleRow->addStretch();
+    m_attendanceSummaryLabel = new QLabel();
+    m_attendanceSummaryLabel->setStyleSheet("font-size: 12px; color: #6B7280; background: transparent; border: none;");
+    titleRow->addWidget(title); titleRow->addStretch(); titleRow->addWidget(m_attendanceSummaryLabel);
     m_attendanceLayout->addLayout(titleRow);
 
     auto *placeholder = new QLabel("加载中...");
@@ -702,7 +703,7 @@ void StudentClassDetailWidget::loadAttendance()
 
 void StudentClassDetailWidget::loadHomework()
 {
-    HomeworkManager::instance()->loadAssignments(m_classInfo.id);
+    HomeworkManager::instance()->loadStudentHomework(m_classInfo.id, m_studentEmail);
 }
 
 void StudentClassDetailWidget::showSubmissionDetailDialog(const HomeworkManager::SubmissionInfo &sub)
@@ -928,9 +929,7 @@ void StudentClassDetailWidget::showResubmitDialog(const QString &submissionId)
                 QUrl storageUrl(SupabaseConfig::supabaseUrl()
                     + "/storage/v1/object/homework/" + storageName);
                 QNetworkRequest storageReq(storageUrl);
-                storageReq.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
-                storageReq.setRawHeader("Authorization",
-                    ("Bearer " + SupabaseConfig::supabaseAnonKey()).toUtf8());
+                NetworkRequestFactory::applySupabaseAuth(storageReq);
 
                 QHttpMultiPart *multiPart = new QHttpMultiPart(QHttpMultiPart::FormDataType);
                 QHttpPart filePart;
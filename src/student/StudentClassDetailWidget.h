@@ -42,6 +42,7 @@ private:
     QStackedWidget *m_rightStack;
     QVBoxLayout *m_memberLayout;
     QVBoxLayout *m_attendanceLayout;
+    QLabel *m_attendanceSummaryLabel = nullptr;
     QVBoxLayout *m_homeworkLayout;
     QNetworkAccessManager *m_networkManagerForUpload;
 };
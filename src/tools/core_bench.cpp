@@ -0,0 +1,626 @@
+/**
+ * @file core_bench.cpp
+ * @brief 核心服务基准与回归检查
+ *
+ * 用录制好的样例数据（src/tools/bench_fixtures）驱动系统中的纯计算部分，
+ * 不访问网络。每个用例先预热一轮，再测量若干轮，记录中位数/最小值/p90。
+ *
+ * 用法:
+ *   ./CoreBench                                  # 结果输出到 stdout（JSON）
+ *   ./CoreBench --output bench_results.json      # 写入文件，便于提交后对比 diff
+ *   ./CoreBench --filter docx --iterations 50    # 只跑名称包含 docx 的用例
+ *   ./CoreBench --baseline old.json --max-regression 20
+ *                                                # 中位数比基线慢 20% 以上时返回 2
+ *
+ * 也可以通过构建目标运行：cmake --build build --target bench
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QThread>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+#include <functional>
+
+#include "../analytics/models/KnowledgeGraph.h"
+#include "../hotspot/NewsKeywordClassifier.h"
+#include "../services/DocumentReaderService.h"
+#include "../services/DocxGenerator.h"
+#include "../services/MarkdownDocxConverter.h"
+#include "../services/QuestionParserService.h"
+#include "../smartpaper/GreedyPaperSelector.h"
+#include "../utils/MarkdownRenderer.h"
+#include "../utils/SimpleZipWriter.h"
+#include "../utils/TextSimilarity.h"
+
+#ifndef AI_BENCH_FIXTURE_DIR
+#define AI_BENCH_FIXTURE_DIR "src/tools/bench_fixtures"
+#endif
+
+namespace {
+
+bool s_verbose = false;
+
+// 服务内部的调试日志会淹没结果，也会计入耗时，默认丢弃
+void benchMessageHandler(QtMsgType type, const QMessageLogContext &, const QString &msg)
+{
+    if (!s_verbose && type == QtDebugMsg) {
+        return;
+    }
+    QTextStream(stderr) << msg << Qt::endl;
+}
+
+QString readTextFile(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[CoreBench] 无法读取样例:" << path << file.errorString();
+        return QString();
+    }
+    return QString::fromUtf8(file.readAll());
+}
+
+QString repeated(const QString &text, int times)
+{
+    QString result;
+    result.reserve(text.size() * times);
+    for (int i = 0; i < times; ++i) {
+        result += text;
+    }
+    return result;
+}
+
+qint64 percentileOf(const QVector<qint64> &sorted, double quantile)
+{
+    const int index = qBound(0, int(quantile * (sorted.size() - 1) + 0.5), int(sorted.size() - 1));
+    return sorted.at(index);
+}
+
+// 返回超出阈值的用例数，基线读取失败返回 -1
+int compareWithBaseline(const QJsonArray &results, const QString &baselinePath, double maxRegressionPct);
+
+} // namespace
+
+/**
+ * @brief 基准用例集合
+ *
+ * 用例直接调用各服务拆出来的纯计算部分
+ * （TextSimilarity、parseJsonResponse、GreedyPaperSelector、时政新闻筛选），不经过网络和信号。
+ */
+class CoreBench
+{
+public:
+    struct Options {
+        QString fixtureDir;
+        QString filter;
+        int iterations = 20;
+        int scale = 1;
+    };
+
+    explicit CoreBench(const Options &options);
+
+    // 运行全部用例，返回结果数组
+    QJsonArray run();
+
+private:
+    // 测量一个用例；fn 返回本轮处理的条目数，返回 -1 表示用例不可用（跳过）
+    void measure(const char *name, const std::function<qint64()> &fn, qint64 bytes = 0);
+
+    void benchMarkdownRenderer();
+    void benchQuestionSimilarity();
+    void benchParseJsonResponse();
+    void benchDocxGenerator();
+    void benchSimpleZipWriter();
+    void benchDocumentReader();
+    void benchGreedySelection();
+    void benchKnowledgeGraphPath();
+    void benchFilterPoliticalNews();
+
+    QList<PaperQuestion> fixtureQuestions();
+    QList<NewsItem> fixtureNews();
+
+    Options m_options;
+    QTemporaryDir m_workDir;
+    QJsonArray m_results;
+};
+
+CoreBench::CoreBench(const Options &options)
+    : m_options(options)
+{
+}
+
+QJsonArray CoreBench::run()
+{
+    benchMarkdownRenderer();
+    benchQuestionSimilarity();
+    benchParseJsonResponse();
+    benchDocxGenerator();
+    benchSimpleZipWriter();
+    benchDocumentReader();
+    benchGreedySelection();
+    benchKnowledgeGraphPath();
+    benchFilterPoliticalNews();
+    return m_results;
+}
+
+void CoreBench::measure(const char *name, const std::function<qint64()> &fn, qint64 bytes)
+{
+    if (!m_options.filter.isEmpty() && !QString::fromLatin1(name).contains(m_options.filter)) {
+        return;
+    }
+
+    // 预热一轮，排除首次分配和静态表初始化
+    const qint64 items = fn();
+    if (items < 0) {
+        qWarning() << "[CoreBench] 跳过用例:" << name;
+        return;
+    }
+
+    QVector<qint64> samplesNs;
+    samplesNs.reserve(m_options.iterations);
+    QElapsedTimer timer;
+    for (int i = 0; i < m_options.iterations; ++i) {
+        timer.start();
+        fn();
+        samplesNs.append(timer.nsecsElapsed());
+    }
+    std::sort(samplesNs.begin(), samplesNs.end());
+
+    const qint64 medianNs = percentileOf(samplesNs, 0.5);
+    QJsonObject result;
+    result["name"] = QString::fromLatin1(name);
+    result["iterations"] = m_options.iterations;
+    result["items"] = items;
+    result["median_ns"] = medianNs;
+    result["min_ns"] = samplesNs.first();
+    result["p90_ns"] = percentileOf(samplesNs, 0.9);
+    if (items > 0) {
+        result["ns_per_item"] = medianNs / items;
+    }
+    if (bytes > 0 && medianNs > 0) {
+        result["bytes"] = bytes;
+        result["mb_per_s"] = qRound((bytes / (1024.0 * 1024.0)) / (medianNs / 1e9) * 10) / 10.0;
+    }
+    m_results.append(result);
+
+    qInfo().noquote() << QString("%1  median=%2ms  min=%3ms  items=%4")
+                             .arg(QString::fromLatin1(name), -36)
+                             .arg(medianNs / 1e6, 0, 'f', 3)
+                             .arg(samplesNs.first() / 1e6, 0, 'f', 3)
+                             .arg(items);
+}
+
+// ===== 样例数据 =====
+
+QList<PaperQuestion> CoreBench::fixtureQuestions()
+{
+    QuestionParserService parser;
+    return parser.parseJsonResponse(readTextFile(m_options.fixtureDir + "/dify_questions_response.txt"));
+}
+
+QList<NewsItem> CoreBench::fixtureNews()
+{
+    const QJsonArray array = QJsonDocument::fromJson(
+        readTextFile(m_options.fixtureDir + "/news_items.json").toUtf8()).array();
+
+    QList<NewsItem> items;
+    for (int copy = 0; copy < 10 * m_options.scale; ++copy) {
+        for (const QJsonValue &value : array) {
+            const QJsonObject obj = value.toObject();
+            NewsItem item;
+            item.id = obj["id"].toString() + QString("-%1").arg(copy);
+            item.title = obj["title"].toString();
+            item.summary = obj["summary"].toString();
+            item.source = obj["source"].toString();
+            item.category = obj["category"].toString();
+            item.hotScore = obj["hotScore"].toInt();
+            items.append(item);
+        }
+    }
+    return items;
+}
+
+// ===== 用例 =====
+
+void CoreBench::benchMarkdownRenderer()
+{
+    const QString markdown = repeated(readTextFile(m_options.fixtureDir + "/chat_answer.md"), 8 * m_options.scale);
+    if (markdown.isEmpty()) {
+        return;
+    }
+    MarkdownRenderer renderer;
+    measure("markdown_renderer.render_html", [&]() -> qint64 {
+        return renderer.renderToHtml(markdown).isEmpty() ? -1 : 1;
+    }, markdown.toUtf8().size());
+}
+
+void CoreBench::benchQuestionSimilarity()
+{
+    const QList<PaperQuestion> questions = fixtureQuestions();
+    if (questions.size() < 2) {
+        return;
+    }
+    // 题干 + 选项拼成查重时比较的文本，两两比较
+    QStringList texts;
+    for (const PaperQuestion &q : questions) {
+        texts.append(q.stem + q.options.join(QString()) + q.material);
+    }
+    measure("question_quality.compute_similarity", [&]() -> qint64 {
+        qint64 pairs = 0;
+        double checksum = 0;
+        for (int i = 0; i < texts.size(); ++i) {
+            for (int j = i + 1; j < texts.size(); ++j) {
+                checksum += TextSimilarity::similarity(texts.at(i), texts.at(j));
+                ++pairs;
+            }
+        }
+        return checksum >= 0 ? pairs : -1;
+    });
+}
+
+void CoreBench::benchParseJsonResponse()
+{
+    const QString response = readTextFile(m_options.fixtureDir + "/dify_questions_response.txt");
+    if (response.isEmpty()) {
+        return;
+    }
+    QuestionParserService parser;
+    measure("question_parser.parse_json_response", [&]() -> qint64 {
+        const int count = parser.parseJsonResponse(response).size();
+        return count > 0 ? count : -1;
+    }, response.toUtf8().size());
+}
+
+void CoreBench::benchDocxGenerator()
+{
+    const QString markdown = repeated(readTextFile(m_options.fixtureDir + "/exam_paper.md"), 10 * m_options.scale);
+    const QList<PaperQuestion> questions = fixtureQuestions();
+    DocxGenerator generator;
+
+    if (!markdown.isEmpty()) {
+        measure("markdown_docx.document_xml", [&]() -> qint64 {
+            return MarkdownDocxConverter::toDocumentXml("单元测试卷", markdown).isEmpty() ? -1 : 1;
+        }, markdown.toUtf8().size());
+
+        const QString outputPath = m_workDir.filePath("markdown.docx");
+        measure("docx_generator.from_markdown", [&]() -> qint64 {
+            return generator.generateFromMarkdown(outputPath, "单元测试卷", markdown) ? 1 : -1;
+        }, markdown.toUtf8().size());
+    }
+
+    if (!questions.isEmpty()) {
+        const QString outputPath = m_workDir.filePath("paper.docx");
+        measure("docx_generator.generate_paper", [&]() -> qint64 {
+            return generator.generatePaper(outputPath, "单元测试卷", questions) ? questions.size() : -1;
+        });
+    }
+}
+
+void CoreBench::benchSimpleZipWriter()
+{
+    const QString markdown = repeated(readTextFile(m_options.fixtureDir + "/exam_paper.md"), 10 * m_options.scale);
+    if (markdown.isEmpty()) {
+        return;
+    }
+
+    // 与 DOCX 包结构相同的目录：一个大的 document.xml 加若干小文件
+    const QString sourceDir = m_workDir.filePath("zip_source");
+    QDir().mkpath(sourceDir + "/word/_rels");
+    QDir().mkpath(sourceDir + "/_rels");
+    qint64 bytes = 0;
+    const QList<QPair<QString, QByteArray>> files = {
+        {"word/document.xml", MarkdownDocxConverter::toDocumentXml("单元测试卷", markdown).toUtf8()},
+        {"word/_rels/document.xml.rels", QByteArray(2048, 'r')},
+        {"_rels/.rels", QByteArray(512, 'r')},
+        {"[Content_Types].xml", QByteArray(1024, 'c')},
+    };
+    for (const auto &file : files) {
+        QFile out(sourceDir + "/" + file.first);
+        if (!out.open(QIODevice::WriteOnly)) {
+            return;
+        }
+        out.write(file.second);
+        bytes += file.second.size();
+    }
+
+    const QString outputPath = m_workDir.filePath("pack.zip");
+    measure("simple_zip_writer.pack_directory", [&]() -> qint64 {
+        return SimpleZipWriter::packDirectory(sourceDir, outputPath) ? files.size() : -1;
+    }, bytes);
+}
+
+void CoreBench::benchDocumentReader()
+{
+    // 样例目录中的 .docx，加上用 DocxGenerator 现生成的一份
+    QStringList docxFiles;
+    const QFileInfoList fixtures = QDir(m_options.fixtureDir).entryInfoList({"*.docx"}, QDir::Files, QDir::Name);
+    for (const QFileInfo &info : fixtures) {
+        docxFiles.append(info.absoluteFilePath());
+    }
+    const QString generatedPath = m_workDir.filePath("reader_input.docx");
+    DocxGenerator generator;
+    if (generator.generateFromMarkdown(generatedPath, "单元测试卷",
+                                       readTextFile(m_options.fixtureDir + "/exam_paper.md"))) {
+        docxFiles.append(generatedPath);
+    }
+    if (docxFiles.isEmpty()) {
+        return;
+    }
+
+    DocumentReaderService reader;
+    measure("document_reader.read_docx", [&]() -> qint64 {
+        for (const QString &path : docxFiles) {
+            if (reader.readDocxWithTables(path).isEmpty()) {
+                return -1;  // 多半是缺少 unzip 命令
+            }
+        }
+        return docxFiles.size();
+    });
+}
+
+void CoreBench::benchGreedySelection()
+{
+    static const char *const kTypes[] = {"single_choice", "multi_choice", "true_false", "short_answer", "essay"};
+    static const char *const kDifficulties[] = {"easy", "medium", "hard"};
+
+    SmartPaperConfig config;
+    config.title = "单元测试卷";
+    config.typeSpecs = {
+        {"single_choice", 12, 2}, {"multi_choice", 6, 3}, {"true_false", 5, 2},
+        {"short_answer", 3, 8}, {"essay", 2, 12}
+    };
+    for (int c = 1; c <= 8; ++c) {
+        config.chapters.append(QString("第%1课").arg(c));
+    }
+    for (int k = 1; k <= 24; ++k) {
+        config.knowledgePoints.append(QString("知识点%1").arg(k));
+    }
+
+    // 固定种子的候选池，保证每次运行输入一致
+    QRandomGenerator random(20240601);
+    QMap<QString, QList<PaperQuestion>> pool;
+    const int perType = 400 * m_options.scale;
+    for (const char *type : kTypes) {
+        QList<PaperQuestion> &candidates = pool[type];
+        for (int i = 0; i < perType; ++i) {
+            PaperQuestion q;
+            q.id = QString("%1-%2").arg(type).arg(i);
+            q.questionType = type;
+            q.difficulty = kDifficulties[random.bounded(3)];
+            q.chapter = config.chapters.at(random.bounded(config.chapters.size()));
+            const int kpCount = 1 + random.bounded(3);
+            for (int k = 0; k < kpCount; ++k) {
+                q.knowledgePoints.append(config.knowledgePoints.at(random.bounded(config.knowledgePoints.size())));
+            }
+            candidates.append(q);
+        }
+    }
+
+    measure("smart_paper.greedy_selection", [&]() -> qint64 {
+        QRandomGenerator perturbation(20240601);
+        SmartPaperResult result;
+        GreedyPaperSelector::select(config, pool, result, &perturbation);
+        return result.selectedQuestions.isEmpty() ? -1 : perType * 5;
+    });
+}
+
+void CoreBench::benchKnowledgeGraphPath()
+{
+    const KnowledgeGraph &graph = KnowledgeGraph::instance();
+    const QList<KnowledgeNode> &nodes = graph.nodes();
+    if (nodes.size() < 2) {
+        return;
+    }
+
+    // 固定步长取点对，覆盖同章节、跨章节和不可达的情况
+    QList<QPair<QString, QString>> pairs;
+    for (int i = 0; i < 200; ++i) {
+        pairs.append({nodes.at(i % nodes.size()).id, nodes.at((i * 7 + 3) % nodes.size()).id});
+    }
+    measure("knowledge_graph.find_path", [&]() -> qint64 {
+        qint64 hops = 0;
+        for (const auto &pair : pairs) {
+            hops += graph.findPath(pair.first, pair.second).size();
+        }
+        return hops >= 0 ? pairs.size() : -1;
+    });
+}
+
+void CoreBench::benchFilterPoliticalNews()
+{
+    const QList<NewsItem> items = fixtureNews();
+    if (items.isEmpty()) {
+        return;
+    }
+    const NewsKeywordClassifier &classifier = NewsKeywordClassifier::instance();
+    measure("real_news.filter_political_news", [&]() -> qint64 {
+        return classifier.filterPolitical(items).isEmpty() ? -1 : items.size();
+    });
+}
+
+// ===== 基线对比 =====
+
+namespace {
+
+int compareWithBaseline(const QJsonArray &results, const QString &baselinePath, double maxRegressionPct)
+{
+    QFile file(baselinePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "错误：无法读取基线" << baselinePath << file.errorString();
+        return -1;
+    }
+
+    QHash<QString, qint64> baseline;
+    const QJsonArray baselineResults = QJsonDocument::fromJson(file.readAll()).object()["results"].toArray();
+    for (const QJsonValue &value : baselineResults) {
+        const QJsonObject obj = value.toObject();
+        baseline.insert(obj["name"].toString(), obj["median_ns"].toInteger());
+    }
+
+    int regressions = 0;
+    for (const QJsonValue &value : results) {
+        const QJsonObject obj = value.toObject();
+        const QString name = obj["name"].toString();
+        const qint64 before = baseline.value(name);
+        if (before <= 0) {
+            continue;
+        }
+        const double changePct = (obj["median_ns"].toInteger() - before) * 100.0 / before;
+        if (changePct > maxRegressionPct) {
+            qCritical().noquote() << QString("回归：%1 中位数变慢 %2%（基线 %3ms → %4ms）")
+                                         .arg(name)
+                                         .arg(changePct, 0, 'f', 1)
+                                         .arg(before / 1e6, 0, 'f', 3)
+                                         .arg(obj["median_ns"].toInteger() / 1e6, 0, 'f', 3);
+            ++regressions;
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("CoreBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("核心服务基准（JSON 输出，可与基线对比）");
+    parser.addHelpOption();
+
+    QCommandLineOption outputOption(
+        QStringList() << "o" << "output",
+        "结果 JSON 文件（缺省输出到 stdout）",
+        "file"
+    );
+    parser.addOption(outputOption);
+
+    QCommandLineOption fixturesOption(
+        QStringList() << "fixtures",
+        "样例数据目录",
+        "dir",
+        QString::fromUtf8(AI_BENCH_FIXTURE_DIR)
+    );
+    parser.addOption(fixturesOption);
+
+    QCommandLineOption filterOption(
+        QStringList() << "filter",
+        "只运行名称包含该字符串的用例",
+        "text"
+    );
+    parser.addOption(filterOption);
+
+    QCommandLineOption iterationsOption(
+        QStringList() << "n" << "iterations",
+        "每个用例的测量轮数",
+        "count",
+        "20"
+    );
+    parser.addOption(iterationsOption);
+
+    QCommandLineOption scaleOption(
+        QStringList() << "scale",
+        "样例数据放大倍数",
+        "factor",
+        "1"
+    );
+    parser.addOption(scaleOption);
+
+    QCommandLineOption baselineOption(
+        QStringList() << "baseline",
+        "基线结果 JSON，用于回归检查",
+        "file"
+    );
+    parser.addOption(baselineOption);
+
+    QCommandLineOption maxRegressionOption(
+        QStringList() << "max-regression",
+        "相对基线允许变慢的百分比，超过时以 2 退出",
+        "percent",
+        "25"
+    );
+    parser.addOption(maxRegressionOption);
+
+    QCommandLineOption verboseOption(
+        QStringList() << "verbose",
+        "保留各服务的调试日志"
+    );
+    parser.addOption(verboseOption);
+
+    parser.process(app);
+
+    s_verbose = parser.isSet(verboseOption);
+    qInstallMessageHandler(benchMessageHandler);
+
+    CoreBench::Options options;
+    options.fixtureDir = parser.value(fixturesOption);
+    options.filter = parser.value(filterOption);
+    options.iterations = qMax(1, parser.value(iterationsOption).toInt());
+    options.scale = qMax(1, parser.value(scaleOption).toInt());
+
+    if (!QFileInfo(options.fixtureDir).isDir()) {
+        qCritical() << "错误：样例目录不存在" << options.fixtureDir;
+        return 1;
+    }
+
+    CoreBench bench(options);
+    const QJsonArray results = bench.run();
+
+    // 不写时间戳，两次结果之间的 diff 只反映耗时变化
+    QJsonObject environment;
+    environment["qt_version"] = QString::fromLatin1(qVersion());
+    environment["os"] = QSysInfo::prettyProductName();
+    environment["cpu_architecture"] = QSysInfo::currentCpuArchitecture();
+    environment["logical_cpus"] = QThread::idealThreadCount();
+#ifdef QT_NO_DEBUG
+    environment["build"] = "release";
+#else
+    environment["build"] = "debug";
+#endif
+
+    QJsonObject root;
+    root["environment"] = environment;
+    root["iterations"] = options.iterations;
+    root["scale"] = options.scale;
+    root["results"] = results;
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QSaveFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size() || !file.commit()) {
+            qCritical() << "错误：无法写入" << parser.value(outputOption) << file.errorString();
+            return 1;
+        }
+        qInfo() << "结果已写入" << parser.value(outputOption);
+    } else {
+        QTextStream(stdout) << json;
+    }
+
+    if (parser.isSet(baselineOption)) {
+        const int regressions = compareWithBaseline(results, parser.value(baselineOption),
+                                                    parser.value(maxRegressionOption).toDouble());
+        if (regressions < 0) {
+            return 1;
+        }
+        if (regressions > 0) {
+            return 2;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file docx_bench.cpp
+ * @brief Markdown → DOCX document.xml 转换耗时基准
+ *
+ * 用法:
+ *   ./DocxBench                          # 内置语料（模拟约 50 页的 AI 生成试卷）
+ *   ./DocxBench --file paper.md          # 使用指定的 Markdown 文件
+ *   ./DocxBench --questions 800 --iterations 50
+ *   ./DocxBench --max-ms 20              # 中位数超过 20ms 时返回非 0，用于回归检查
+ *
+ * 输出每轮耗时的中位数和按输入 UTF-8 字节计算的 MB/s。
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+
+#include "../services/MarkdownDocxConverter.h"
+
+namespace {
+
+// 按 AI 出题的常见格式拼装试卷：大题标题、选择题、材料题、内联答案、文末答案区
+QString buildPaper(int questionCount)
+{
+    static const char *const kSections[] = {
+        "## 一、单项选择题", "## 二、判断说理题", "## 三、材料分析题"
+    };
+
+    QString paper;
+    paper.reserve(questionCount * 400);
+    paper += QStringLiteral("<think>\n先确定考查范围和难度梯度。\n</think>\n\n");
+    paper += QStringLiteral("# 道德与法治 期末测试卷\n\n");
+
+    const int perSection = qMax(1, questionCount / 3);
+    for (int q = 1; q <= questionCount; ++q) {
+        if ((q - 1) % perSection == 0 && (q - 1) / perSection < 3) {
+            paper += QString::fromUtf8(kSections[(q - 1) / perSection]) + "\n\n";
+        }
+        paper += QStringLiteral("**%1.** 某中学开展“青春心向党·建功新时代”主题活动，"
+                                "同学们通过 <调研> & 访谈了解家乡变化。这说明（　　）\n").arg(q);
+        paper += QStringLiteral("A. 青少年要树立远大理想\nB. 个人发展与国家发展紧密相连\n"
+                                "C. 参与社会实践是成长的唯一途径\nD. 只有成年人才能服务社会\n");
+        if (q % 2 == 0) {
+            paper += QStringLiteral("【答案】**B**\n【解析】本题考查个人与国家的关系。"
+                                    "材料体现了青少年在社会实践中认识国家发展，C 项“唯一”说法绝对，D 项错误。\n");
+        }
+        paper += "\n";
+    }
+
+    paper += QStringLiteral("---\n\n## 参考答案与解析\n\n");
+    for (int q = 1; q <= questionCount; q += 2) {
+        paper += QStringLiteral("%1. 【答案】A\n【解析】理想是人生的航标，结合材料分析即可。\n").arg(q);
+    }
+    paper += QStringLiteral("\n*祝同学们考试顺利，取得理想成绩！*\n");
+    return paper;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("DocxBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Markdown → DOCX 转换耗时基准");
+    parser.addHelpOption();
+
+    QCommandLineOption fileOption(
+        QStringList() << "f" << "file",
+        "输入的 Markdown 文件（缺省使用内置语料）",
+        "file"
+    );
+    parser.addOption(fileOption);
+
+    QCommandLineOption questionsOption(
+        QStringList() << "q" << "questions",
+        "内置语料的题目数量",
+        "count",
+        "600"
+    );
+    parser.addOption(questionsOption);
+
+    QCommandLineOption iterationsOption(
+        QStringList() << "n" << "iterations",
+        "测量轮数",
+        "count",
+        "20"
+    );
+    parser.addOption(iterationsOption);
+
+    QCommandLineOption maxMsOption(
+        QStringList() << "max-ms",
+        "中位数耗时上限（毫秒），超过时以非 0 退出",
+        "ms"
+    );
+    parser.addOption(maxMsOption);
+
+    parser.process(app);
+
+    QString markdown;
+    if (parser.isSet(fileOption)) {
+        QFile file(parser.value(fileOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "错误：无法读取" << file.fileName() << file.errorString();
+            return 1;
+        }
+        markdown = QString::fromUtf8(file.readAll());
+    } else {
+        markdown = buildPaper(qMax(1, parser.value(questionsOption).toInt()));
+    }
+
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+    const qint64 inputBytes = markdown.toUtf8().size();
+    const QString title = QStringLiteral("期末测试卷");
+
+    // 预热一轮，排除首次分配的影响
+    qint64 outputChars = MarkdownDocxConverter::toDocumentXml(title, markdown).size();
+
+    QVector<qint64> samplesNs;
+    samplesNs.reserve(iterations);
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+        timer.start();
+        outputChars = MarkdownDocxConverter::toDocumentXml(title, markdown).size();
+        samplesNs.append(timer.nsecsElapsed());
+    }
+
+    std::sort(samplesNs.begin(), samplesNs.end());
+    const qint64 medianNs = samplesNs.at(samplesNs.size() / 2);
+    const double seconds = medianNs / 1e9;
+    const double mbPerSec = seconds > 0 ? (inputBytes / (1024.0 * 1024.0)) / seconds : 0.0;
+    const double medianMs = medianNs / 1e6;
+
+    QTextStream out(stdout);
+    out << "input_bytes=" << inputBytes
+        << " output_chars=" << outputChars
+        << " iterations=" << iterations
+        << " median_ms=" << QString::number(medianMs, 'f', 3)
+        << " min_ms=" << QString::number(samplesNs.first() / 1e6, 'f', 3)
+        << " throughput_mb_s=" << QString::number(mbPerSec, 'f', 1)
+        << Qt::endl;
+
+    if (parser.isSet(maxMsOption) && medianMs > parser.value(maxMsOption).toDouble()) {
+        qCritical() << "错误：中位数耗时" << medianMs << "ms 超过上限" << parser.value(maxMsOption) << "ms";
+        return 2;
+    }
+
+    return 0;
+}
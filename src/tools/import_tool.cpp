@@ -18,12 +18,14 @@
 #include "../services/BulkImportService.h"
 #include "../services/PaperService.h"
 #include "../auth/supabase/supabaseconfig.h"
+#include "../utils/Metrics.h"
 
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
     QCoreApplication::setApplicationName("ImportTool");
     QCoreApplication::setApplicationVersion("1.0");
+    new MetricsExporter(&app);
     
     // 命令行参数解析
     QCommandLineParser parser;
@@ -0,0 +1,149 @@
+/**
+ * @file markdown_bench.cpp
+ * @brief Markdown 渲染吞吐量基准
+ *
+ * 用法:
+ *   ./MarkdownBench                       # 使用内置语料（模拟 AI 长回答）
+ *   ./MarkdownBench --file answer.md      # 使用指定的 Markdown 文件
+ *   ./MarkdownBench --size 4096 --iterations 50
+ *
+ * 输出每轮耗时的中位数和按输入 UTF-8 字节计算的 MB/s。
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+
+#include "../utils/MarkdownRenderer.h"
+
+namespace {
+
+// 覆盖常用语法的语料片段：标题、列表、表格、代码、公式、长段落
+const char *const kCorpusChunk =
+    "## 教学目标\n"
+    "1. 理解**社会主义核心价值观**的基本内涵，能够结合*生活实例*进行阐释。\n"
+    "2. 掌握 `爱国` 与 `敬业` 的关系，参考[课程标准](https://example.com/standard)。\n"
+    "   - 结合新闻材料分析 ~~片面~~ 全面的观点\n"
+    "   - 小组讨论后形成书面结论\n"
+    "\n"
+    "> 青年兴则国家兴，青年强则国家强。\n"
+    "> 这句话出自教学材料的导入部分。\n"
+    "\n"
+    "| 环节 | 时长 | 活动 |\n"
+    "|:---|:---:|---:|\n"
+    "| 导入 | 5 分钟 | 视频观看 |\n"
+    "| 新授 | 20 分钟 | **案例分析** 与讨论 |\n"
+    "| 小结 | 5 分钟 | 思维导图 |\n"
+    "\n"
+    "教学过程中可以引入简单的量化分析，例如得分率 $p = \\frac{x}{n}$，"
+    "并用 $$\\bar{x} = \\frac{1}{n}\\sum x_i$$ 说明平均分的含义。"
+    "课堂提问应当层层递进，由浅入深，引导学生从*感性认识*上升到**理性认识**，"
+    "最终落实到行动上。\n"
+    "\n"
+    "```text\n"
+    "板书设计：\n"
+    "  一、价值观 -> 二、践行 -> 三、升华\n"
+    "```\n"
+    "\n"
+    "---\n"
+    "\n";
+
+QString buildCorpus(int targetBytes)
+{
+    const QString chunk = QString::fromUtf8(kCorpusChunk);
+    const int chunkBytes = chunk.toUtf8().size();
+    QString corpus;
+    corpus.reserve((targetBytes / chunkBytes + 1) * chunk.size());
+    for (int bytes = 0; bytes < targetBytes; bytes += chunkBytes) {
+        corpus += chunk;
+    }
+    return corpus;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("MarkdownBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Markdown 渲染吞吐量基准（MB/s）");
+    parser.addHelpOption();
+
+    QCommandLineOption fileOption(
+        QStringList() << "f" << "file",
+        "输入的 Markdown 文件（缺省使用内置语料）",
+        "file"
+    );
+    parser.addOption(fileOption);
+
+    QCommandLineOption sizeOption(
+        QStringList() << "s" << "size",
+        "内置语料大小（KB）",
+        "kb",
+        "1024"
+    );
+    parser.addOption(sizeOption);
+
+    QCommandLineOption iterationsOption(
+        QStringList() << "n" << "iterations",
+        "测量轮数",
+        "count",
+        "20"
+    );
+    parser.addOption(iterationsOption);
+
+    parser.process(app);
+
+    QString markdown;
+    if (parser.isSet(fileOption)) {
+        QFile file(parser.value(fileOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "错误：无法读取" << file.fileName() << file.errorString();
+            return 1;
+        }
+        markdown = QString::fromUtf8(file.readAll());
+    } else {
+        markdown = buildCorpus(qMax(1, parser.value(sizeOption).toInt()) * 1024);
+    }
+
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+    const qint64 inputBytes = markdown.toUtf8().size();
+
+    MarkdownRenderer renderer;
+
+    // 预热一轮，排除首次分配的影响
+    qint64 outputChars = renderer.renderToHtml(markdown).size();
+
+    QVector<qint64> samplesNs;
+    samplesNs.reserve(iterations);
+    QElapsedTimer timer;
+    for (int i = 0; i < iterations; ++i) {
+        timer.start();
+        outputChars = renderer.renderToHtml(markdown).size();
+        samplesNs.append(timer.nsecsElapsed());
+    }
+
+    std::sort(samplesNs.begin(), samplesNs.end());
+    const qint64 medianNs = samplesNs.at(samplesNs.size() / 2);
+    const double seconds = medianNs / 1e9;
+    const double mbPerSec = seconds > 0 ? (inputBytes / (1024.0 * 1024.0)) / seconds : 0.0;
+
+    QTextStream out(stdout);
+    out << "input_bytes=" << inputBytes
+        << " output_chars=" << outputChars
+        << " iterations=" << iterations
+        << " median_ms=" << QString::number(medianNs / 1e6, 'f', 3)
+        << " min_ms=" << QString::number(samplesNs.first() / 1e6, 'f', 3)
+        << " throughput_mb_s=" << QString::number(mbPerSec, 'f', 1)
+        << Qt::endl;
+
+    return 0;
+}
@@ -0,0 +1,863 @@
+#include "MockBackendServer.h"
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QPointer>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUrl>
+#include <QUrlQuery>
+#include <QUuid>
+#include <memory>
+
+namespace {
+
+// 单个请求体上限，防止异常客户端撑爆内存
+constexpr int kMaxRequestBytes = 256 * 1024 * 1024;
+
+const char *const kDefaultReply =
+    "## 教学建议\n\n"
+    "本节课围绕**社会主义核心价值观**展开，建议按“情境导入—合作探究—总结提升”三个环节组织：\n\n"
+    "1. **情境导入**：播放社区志愿服务短片，引导学生说出身边践行价值观的例子。\n"
+    "2. **合作探究**：分组讨论“诚信”与“友善”在校园生活中的体现，每组形成一条行动建议。\n"
+    "3. **总结提升**：结合教材观点归纳个人、社会、国家三个层面的要求。\n\n"
+    "> 核心价值观是一个民族赖以维系的精神纽带，是一个国家共同的思想道德基础。\n\n"
+    "| 环节 | 时长 | 评价方式 |\n|---|---|---|\n"
+    "| 导入 | 5 分钟 | 课堂观察 |\n| 探究 | 25 分钟 | 小组互评 |\n| 总结 | 10 分钟 | 随堂练习 |\n\n"
+    "课后可布置实践作业：记录一周内自己或家人践行核心价值观的三件小事，下节课交流分享。\n";
+
+QJsonObject parseJsonObject(const QByteArray &body)
+{
+    return QJsonDocument::fromJson(body).object();
+}
+
+} // namespace
+
+MockBackendServer::MockBackendServer(const Options &options, QObject *parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_server(new QTcpServer(this))
+    , m_random(options.seed)
+{
+    if (m_options.replyText.isEmpty()) {
+        m_options.replyText = QString::fromUtf8(kDefaultReply);
+    }
+    if (m_options.workflowReplyText.isEmpty()) {
+        m_options.workflowReplyText = m_options.replyText;
+    }
+    m_options.tokensPerSecond = qMax(1, m_options.tokensPerSecond);
+    m_options.tokenChars = qMax(1, m_options.tokenChars);
+
+    connect(m_server, &QTcpServer::newConnection, this, &MockBackendServer::onNewConnection);
+}
+
+bool MockBackendServer::listen(const QHostAddress &address, quint16 port)
+{
+    return m_server->listen(address, port);
+}
+
+quint16 MockBackendServer::port() const
+{
+    return m_server->serverPort();
+}
+
+QString MockBackendServer::baseUrl() const
+{
+    const QHostAddress address = m_server->serverAddress();
+    const QString host = (address.isNull() || address == QHostAddress::Any || address == QHostAddress::AnyIPv4)
+        ? QStringLiteral("127.0.0.1")
+        : address.toString();
+    return QString("http://%1:%2").arg(host).arg(port());
+}
+
+QString MockBackendServer::errorString() const
+{
+    return m_server->errorString();
+}
+
+// ===== 连接与解析 =====
+
+void MockBackendServer::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server->nextPendingConnection()) {
+        m_connections.insert(socket, Connection());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            onReadyRead(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_connections.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockBackendServer::onReadyRead(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end()) {
+        return;
+    }
+    it->buffer += socket->readAll();
+    if (it->buffer.size() > kMaxRequestBytes) {
+        socket->abort();
+        return;
+    }
+    processNextRequest(socket);
+}
+
+void MockBackendServer::processNextRequest(QTcpSocket *socket)
+{
+    auto it = m_connections.find(socket);
+    if (it == m_connections.end() || it->busy) {
+        return;
+    }
+
+    HttpRequest request;
+    const int consumed = parseRequest(it->buffer, &request);
+    if (consumed == 0) {
+        return;  // 数据还没收全
+    }
+    if (consumed < 0) {
+        socket->write("HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+        socket->disconnectFromHost();
+        return;
+    }
+    it->buffer.remove(0, consumed);
+    it->busy = true;
+    request.receivedMs = QDateTime::currentMSecsSinceEpoch();
+
+    // 控制接口不受延迟和错误注入影响
+    if (request.path.startsWith(QLatin1String("/__mock/"))) {
+        dispatch(socket, request);
+        return;
+    }
+
+    const int delayMs = injectedDelayMs();
+    if (delayMs <= 0) {
+        dispatch(socket, request);
+        return;
+    }
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(delayMs, this, [this, guard, request]() {
+        if (guard) {
+            dispatch(guard, request);
+        }
+    });
+}
+
+int MockBackendServer::parseRequest(const QByteArray &buffer, HttpRequest *request)
+{
+    const int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return buffer.size() > 64 * 1024 ? -1 : 0;
+    }
+
+    const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+    const QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+    if (requestLine.size() < 3) {
+        return -1;
+    }
+    request->method = requestLine.at(0).toUpper();
+    request->target = requestLine.at(1);
+
+    for (int i = 1; i < lines.size(); ++i) {
+        const QByteArray line = lines.at(i).trimmed();
+        const int colon = line.indexOf(':');
+        if (colon > 0) {
+            request->headers.insert(line.left(colon).trimmed().toLower(), line.mid(colon + 1).trimmed());
+        }
+    }
+
+    int consumed = headerEnd + 4;
+    if (request->headers.value("transfer-encoding").toLower().contains("chunked")) {
+        // 分块请求体：<十六进制长度>\r\n<数据>\r\n ... 0\r\n\r\n
+        int pos = consumed;
+        while (true) {
+            const int lineEnd = buffer.indexOf("\r\n", pos);
+            if (lineEnd < 0) {
+                return 0;
+            }
+            bool ok = false;
+            const int chunkSize = buffer.mid(pos, lineEnd - pos).split(';').first().trimmed().toInt(&ok, 16);
+            if (!ok || chunkSize < 0) {
+                return -1;
+            }
+            pos = lineEnd + 2;
+            if (chunkSize == 0) {
+                const int trailerEnd = buffer.indexOf("\r\n", pos);
+                if (trailerEnd < 0) {
+                    return 0;
+                }
+                consumed = trailerEnd + 2;
+                break;
+            }
+            if (buffer.size() < pos + chunkSize + 2) {
+                return 0;
+            }
+            request->body += buffer.mid(pos, chunkSize);
+            pos += chunkSize + 2;
+        }
+    } else {
+        const int contentLength = request->headers.value("content-length").toInt();
+        if (buffer.size() < consumed + contentLength) {
+            return 0;
+        }
+        request->body = buffer.mid(consumed, contentLength);
+        consumed += contentLength;
+    }
+
+    const QUrl url = QUrl::fromEncoded(request->target);
+    request->path = url.path(QUrl::FullyDecoded);
+    const QUrlQuery query(url);
+    for (const auto &item : query.queryItems(QUrl::FullyDecoded)) {
+        request->query.append(item);
+    }
+    return consumed;
+}
+
+// ===== 路由 =====
+
+void MockBackendServer::dispatch(QTcpSocket *socket, const HttpRequest &request)
+{
+    const QString &path = request.path;
+
+    if (path.startsWith(QLatin1String("/__mock/"))) {
+        handleMockControl(socket, request);
+        return;
+    }
+
+    QString route;
+    if (path.startsWith(QLatin1String("/rest/v1/"))) {
+        route = QStringLiteral("rest");
+    } else if (path.startsWith(QLatin1String("/storage/v1/"))) {
+        route = QStringLiteral("storage");
+    } else if (path.startsWith(QLatin1String("/auth/v1/"))) {
+        route = QStringLiteral("auth");
+    } else if (path.endsWith(QLatin1String("/chat-messages"))) {
+        route = QStringLiteral("dify.chat");
+    } else if (path.endsWith(QLatin1String("/workflows/run"))) {
+        route = QStringLiteral("dify.workflow");
+    } else if (path.endsWith(QLatin1String("/files/upload"))) {
+        route = QStringLiteral("dify.upload");
+    } else if (path.endsWith(QLatin1String("/chat/completions"))) {
+        route = QStringLiteral("chat_completions");
+    } else if (path.endsWith(QLatin1String("/conversations")) || path.endsWith(QLatin1String("/messages"))
+               || path.endsWith(QLatin1String("/meta"))) {
+        route = QStringLiteral("dify.meta");
+    } else {
+        route = QStringLiteral("unknown");
+    }
+    m_requestsByRoute[route] += 1;
+
+    if (route == QLatin1String("unknown")) {
+        sendJson(socket, request, 404, QJsonObject{{"message", "mock: no route for " + path}});
+        return;
+    }
+
+    if (shouldInject(m_options.errorRate)) {
+        ++m_injectedErrors;
+        sendJson(socket, request, m_options.errorStatus, QJsonObject{
+            {"code", "MOCK_INJECTED"},
+            {"message", QString("mock injected error (%1)").arg(m_options.errorStatus)}
+        });
+        return;
+    }
+
+    if (route == QLatin1String("rest")) {
+        handleRest(socket, request);
+    } else if (route == QLatin1String("storage")) {
+        handleStorage(socket, request);
+    } else if (route == QLatin1String("auth")) {
+        handleAuth(socket, request);
+    } else if (route == QLatin1String("dify.chat")) {
+        handleDifyChat(socket, request);
+    } else if (route == QLatin1String("dify.workflow")) {
+        handleDifyWorkflow(socket, request);
+    } else if (route == QLatin1String("chat_completions")) {
+        handleChatCompletions(socket, request);
+    } else if (route == QLatin1String("dify.upload")) {
+        sendJson(socket, request, 201, QJsonObject{
+            {"id", QUuid::createUuid().toString(QUuid::WithoutBraces)},
+            {"name", "upload"},
+            {"size", qint64(request.body.size())},
+            {"extension", "docx"},
+            {"mime_type", "application/vnd.openxmlformats-officedocument.wordprocessingml.document"},
+            {"created_at", QDateTime::currentSecsSinceEpoch()}
+        });
+    } else {
+        sendJson(socket, request, 200, QJsonObject{{"data", QJsonArray()}, {"has_more", false}, {"limit", 20}});
+    }
+}
+
+void MockBackendServer::handleRest(QTcpSocket *socket, const HttpRequest &request)
+{
+    MockPostgrest::Request restRequest;
+    restRequest.method = request.method;
+    restRequest.table = request.path.mid(int(qstrlen("/rest/v1/")));
+    restRequest.query = request.query;
+    restRequest.headers = request.headers;
+    restRequest.body = request.body;
+
+    const MockPostgrest::Response response = m_postgrest.handle(restRequest);
+    const QByteArray contentType = request.headers.value("accept").contains("vnd.pgrst.object")
+        ? QByteArray("application/vnd.pgrst.object+json; charset=utf-8")
+        : QByteArray("application/json; charset=utf-8");
+    sendResponse(socket, request, response.status, response.body, contentType, response.headers);
+}
+
+void MockBackendServer::handleStorage(QTcpSocket *socket, const HttpRequest &request)
+{
+    if (request.path.startsWith(QLatin1String("/storage/v1/upload/resumable"))) {
+        handleResumableUpload(socket, request);
+        return;
+    }
+
+    // /storage/v1/object/[public/|authenticated/]<bucket>/<path>
+    const QString prefix = QStringLiteral("/storage/v1/object/");
+    if (!request.path.startsWith(prefix)) {
+        sendJson(socket, request, 404, QJsonObject{{"statusCode", "404"}, {"error", "not_found"},
+                                                   {"message", "mock: unsupported storage endpoint"}});
+        return;
+    }
+    QString key = request.path.mid(prefix.size());
+    for (const char *scope : {"public/", "authenticated/"}) {
+        if (key.startsWith(QLatin1String(scope))) {
+            key = key.mid(int(qstrlen(scope)));
+        }
+    }
+
+    if (request.method == "POST" || request.method == "PUT") {
+        const bool upsert = request.method == "PUT" || request.headers.value("x-upsert") == "true";
+        if (m_storage.contains(key) && !upsert) {
+            sendJson(socket, request, 400, QJsonObject{{"statusCode", "409"}, {"error", "Duplicate"},
+                                                       {"message", "The resource already exists"}});
+            return;
+        }
+        const QByteArray contentType = request.headers.value("content-type", "application/octet-stream");
+        m_storage.insert(key, {request.body, contentType});
+        sendJson(socket, request, 200, QJsonObject{
+            {"Key", key},
+            {"Id", QUuid::createUuid().toString(QUuid::WithoutBraces)}
+        });
+    } else if (request.method == "GET" || request.method == "HEAD") {
+        const auto it = m_storage.constFind(key);
+        if (it == m_storage.constEnd()) {
+            sendJson(socket, request, 404, QJsonObject{{"statusCode", "404"}, {"error", "not_found"},
+                                                       {"message", "Object not found"}});
+            return;
+        }
+        sendResponse(socket, request, 200, it->first, it->second);
+    } else if (request.method == "DELETE") {
+        // 单个对象路径，或 bucket + {"prefixes": [...]}
+        QStringList keys;
+        const QJsonArray prefixes = parseJsonObject(request.body).value("prefixes").toArray();
+        for (const QJsonValue &prefixValue : prefixes) {
+            keys.append(key + "/" + prefixValue.toString());
+        }
+        if (keys.isEmpty()) {
+            keys.append(key);
+        }
+        QJsonArray removed;
+        for (const QString &target : keys) {
+            if (m_storage.remove(target) > 0) {
+                removed.append(QJsonObject{{"name", target}});
+            }
+        }
+        sendJson(socket, request, 200, removed);
+    } else {
+        sendJson(socket, request, 405, QJsonObject{{"message", "method not allowed"}});
+    }
+}
+
+void MockBackendServer::handleResumableUpload(QTcpSocket *socket, const HttpRequest &request)
+{
+    // TUS 1.0.0：POST 创建 -> PATCH 按偏移追加 -> 长度到齐后落到对象存储
+    const QString base = QStringLiteral("/storage/v1/upload/resumable");
+    const QString id = request.path.mid(base.size()).section('/', 1, 1);
+    const QList<QPair<QByteArray, QByteArray>> tusHeaders = {{"Tus-Resumable", "1.0.0"}};
+
+    auto finalize = [this](const QString &uploadId) {
+        const ResumableUpload upload = m_resumableUploads.take(uploadId);
+        m_storage.insert(upload.key, {upload.data, upload.contentType});
+    };
+
+    if (request.method == "POST" && id.isEmpty()) {
+        QHash<QString, QString> metadata;
+        for (const QByteArray &pair : request.headers.value("upload-metadata").split(',')) {
+            const QByteArray trimmed = pair.trimmed();
+            const int space = trimmed.indexOf(' ');
+            const QByteArray name = space < 0 ? trimmed : trimmed.left(space);
+            const QByteArray value = space < 0 ? QByteArray() : QByteArray::fromBase64(trimmed.mid(space + 1));
+            metadata.insert(QString::fromLatin1(name), QString::fromUtf8(value));
+        }
+        bool ok = false;
+        const qint64 length = request.headers.value("upload-length").toLongLong(&ok);
+        if (!ok || length < 0 || metadata.value("bucketName").isEmpty() || metadata.value("objectName").isEmpty()) {
+            sendJson(socket, request, 400, QJsonObject{{"message", "mock: Upload-Length and bucketName/objectName required"}});
+            return;
+        }
+
+        ResumableUpload upload;
+        upload.key = metadata.value("bucketName") + "/" + metadata.value("objectName");
+        upload.contentType = metadata.value("contentType", "application/octet-stream").toUtf8();
+        upload.length = length;
+        if (m_storage.contains(upload.key) && request.headers.value("x-upsert") != "true") {
+            sendJson(socket, request, 409, QJsonObject{{"error", "Duplicate"}, {"message", "The resource already exists"}});
+            return;
+        }
+
+        const QString uploadId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+        m_resumableUploads.insert(uploadId, upload);
+        if (length == 0) {
+            finalize(uploadId);
+        }
+        auto headers = tusHeaders;
+        headers.append({"Location", (baseUrl() + base + "/" + uploadId).toUtf8()});
+        headers.append({"Upload-Offset", "0"});
+        sendResponse(socket, request, 201, QByteArray(), QByteArray(), headers);
+        return;
+    }
+
+    const auto it = m_resumableUploads.find(id);
+    if (it == m_resumableUploads.end()) {
+        sendResponse(socket, request, 404, QByteArray(), QByteArray(), tusHeaders);
+        return;
+    }
+
+    if (request.method == "HEAD") {
+        auto headers = tusHeaders;
+        headers.append({"Upload-Offset", QByteArray::number(it->data.size())});
+        headers.append({"Upload-Length", QByteArray::number(it->length)});
+        headers.append({"Cache-Control", "no-store"});
+        sendResponse(socket, request, 200, QByteArray(), QByteArray(), headers);
+    } else if (request.method == "PATCH") {
+        bool ok = false;
+        const qint64 offset = request.headers.value("upload-offset").toLongLong(&ok);
+        if (!ok || offset != it->data.size()) {
+            sendResponse(socket, request, 409, QByteArray(), QByteArray(), tusHeaders);
+            return;
+        }
+        if (offset + request.body.size() > it->length) {
+            sendJson(socket, request, 400, QJsonObject{{"message", "mock: upload exceeds Upload-Length"}});
+            return;
+        }
+        it->data.append(request.body);
+        const qint64 newOffset = it->data.size();
+        if (newOffset == it->length) {
+            finalize(id);
+        }
+        auto headers = tusHeaders;
+        headers.append({"Upload-Offset", QByteArray::number(newOffset)});
+        sendResponse(socket, request, 204, QByteArray(), QByteArray(), headers);
+    } else if (request.method == "DELETE") {
+        m_resumableUploads.erase(it);
+        sendResponse(socket, request, 204, QByteArray(), QByteArray(), tusHeaders);
+    } else {
+        sendJson(socket, request, 405, QJsonObject{{"message", "method not allowed"}});
+    }
+}
+
+QJsonObject MockBackendServer::sessionFor(const QString &email)
+{
+    ++m_sessionCounter;
+    const QString userId = QUuid::createUuidV5(QUuid(), email).toString(QUuid::WithoutBraces);
+    return QJsonObject{
+        {"access_token", QString("mock-access-%1").arg(m_sessionCounter)},
+        {"refresh_token", QString("mock-refresh-%1").arg(m_sessionCounter)},
+        {"token_type", "bearer"},
+        {"expires_in", m_options.tokenTtlSec},
+        {"expires_at", QDateTime::currentSecsSinceEpoch() + m_options.tokenTtlSec},
+        {"user", QJsonObject{
+            {"id", userId},
+            {"email", email},
+            {"role", "authenticated"},
+            {"user_metadata", QJsonObject()}
+        }}
+    };
+}
+
+void MockBackendServer::handleAuth(QTcpSocket *socket, const HttpRequest &request)
+{
+    const QString endpoint = request.path.mid(int(qstrlen("/auth/v1/")));
+    const QJsonObject body = parseJsonObject(request.body);
+    const QString email = body.value("email").toString(QStringLiteral("teacher@example.com"));
+
+    if (endpoint == QLatin1String("token")) {
+        QString grantType;
+        for (const auto &item : request.query) {
+            if (item.first == QLatin1String("grant_type")) {
+                grantType = item.second;
+            }
+        }
+        if (grantType == QLatin1String("refresh_token") && body.value("refresh_token").toString().isEmpty()) {
+            sendJson(socket, request, 400, QJsonObject{{"error", "invalid_grant"},
+                                                       {"error_description", "Refresh Token Not Found"}});
+            return;
+        }
+        sendJson(socket, request, 200, sessionFor(email));
+    } else if (endpoint == QLatin1String("signup")) {
+        sendJson(socket, request, 200, sessionFor(email));
+    } else if (endpoint == QLatin1String("user")) {
+        sendJson(socket, request, 200, sessionFor(email).value("user"));
+    } else if (endpoint == QLatin1String("logout")) {
+        sendResponse(socket, request, 204, QByteArray(), QByteArray());
+    } else if (endpoint.startsWith(QLatin1String("admin/users"))) {
+        sendJson(socket, request, 200, QJsonObject{{"users", QJsonArray()}, {"aud", "authenticated"}});
+    } else {
+        sendJson(socket, request, 200, QJsonObject());
+    }
+}
+
+void MockBackendServer::handleDifyChat(QTcpSocket *socket, const HttpRequest &request)
+{
+    const QJsonObject body = parseJsonObject(request.body);
+    const QString conversationId = body.value("conversation_id").toString(
+        QUuid::createUuid().toString(QUuid::WithoutBraces));
+    const QString messageId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    const qint64 createdAt = QDateTime::currentSecsSinceEpoch();
+
+    if (body.value("response_mode").toString() == QLatin1String("blocking")) {
+        sendJson(socket, request, 200, QJsonObject{
+            {"event", "message"},
+            {"message_id", messageId},
+            {"conversation_id", conversationId},
+            {"mode", "chat"},
+            {"answer", m_options.replyText},
+            {"created_at", createdAt}
+        });
+        return;
+    }
+
+    StreamPlan plan;
+    plan.formatToken = [=](const QString &token) {
+        return "data: " + QJsonDocument(QJsonObject{
+            {"event", "message"},
+            {"message_id", messageId},
+            {"conversation_id", conversationId},
+            {"answer", token},
+            {"created_at", createdAt}
+        }).toJson(QJsonDocument::Compact) + "\n\n";
+    };
+    plan.tail = "data: " + QJsonDocument(QJsonObject{
+        {"event", "message_end"},
+        {"message_id", messageId},
+        {"conversation_id", conversationId},
+        {"metadata", QJsonObject{{"usage", QJsonObject{
+            {"completion_tokens", int(tokenize(m_options.replyText).size())}
+        }}}}
+    }).toJson(QJsonDocument::Compact) + "\n\n";
+    startStream(socket, request, m_options.replyText, plan);
+}
+
+void MockBackendServer::handleDifyWorkflow(QTcpSocket *socket, const HttpRequest &request)
+{
+    const QJsonObject body = parseJsonObject(request.body);
+    const QString runId = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    const QJsonObject outputs{
+        {"result", m_options.workflowReplyText},
+        {"text", m_options.workflowReplyText}
+    };
+
+    if (body.value("response_mode").toString() == QLatin1String("blocking")) {
+        sendJson(socket, request, 200, QJsonObject{
+            {"workflow_run_id", runId},
+            {"data", QJsonObject{{"id", runId}, {"status", "succeeded"}, {"outputs", outputs}}}
+        });
+        return;
+    }
+
+    StreamPlan plan;
+    plan.head = "data: " + QJsonDocument(QJsonObject{
+        {"event", "workflow_started"},
+        {"workflow_run_id", runId},
+        {"data", QJsonObject{{"id", runId}, {"created_at", QDateTime::currentSecsSinceEpoch()}}}
+    }).toJson(QJsonDocument::Compact) + "\n\n";
+    plan.formatToken = [](const QString &token) {
+        return "data: " + QJsonDocument(QJsonObject{
+            {"event", "text_chunk"},
+            {"data", QJsonObject{{"text", token}}}
+        }).toJson(QJsonDocument::Compact) + "\n\n";
+    };
+    plan.tail = "data: " + QJsonDocument(QJsonObject{
+        {"event", "workflow_finished"},
+        {"workflow_run_id", runId},
+        {"data", QJsonObject{{"id", runId}, {"status", "succeeded"}, {"outputs", outputs}}}
+    }).toJson(QJsonDocument::Compact) + "\n\n";
+    startStream(socket, request, m_options.workflowReplyText, plan);
+}
+
+void MockBackendServer::handleChatCompletions(QTcpSocket *socket, const HttpRequest &request)
+{
+    const QJsonObject body = parseJsonObject(request.body);
+    const QString id = "chatcmpl-" + QUuid::createUuid().toString(QUuid::Id128);
+    const QString model = body.value("model").toString(QStringLiteral("mock-model"));
+    const int completionTokens = int(tokenize(m_options.replyText).size());
+
+    if (!body.value("stream").toBool()) {
+        sendJson(socket, request, 200, QJsonObject{
+            {"id", id},
+            {"object", "chat.completion"},
+            {"model", model},
+            {"choices", QJsonArray{QJsonObject{
+                {"index", 0},
+                {"message", QJsonObject{{"role", "assistant"}, {"content", m_options.replyText}}},
+                {"finish_reason", "stop"}
+            }}},
+            {"usage", QJsonObject{{"completion_tokens", completionTokens}}}
+        });
+        return;
+    }
+
+    StreamPlan plan;
+    plan.formatToken = [=](const QString &token) {
+        return "data: " + QJsonDocument(QJsonObject{
+            {"id", id},
+            {"object", "chat.completion.chunk"},
+            {"model", model},
+            {"choices", QJsonArray{QJsonObject{{"index", 0}, {"delta", QJsonObject{{"content", token}}}}}}
+        }).toJson(QJsonDocument::Compact) + "\n\n";
+    };
+    plan.tail = "data: " + QJsonDocument(QJsonObject{
+        {"id", id},
+        {"object", "chat.completion.chunk"},
+        {"model", model},
+        {"choices", QJsonArray{QJsonObject{{"index", 0}, {"delta", QJsonObject()}, {"finish_reason", "stop"}}}}
+    }).toJson(QJsonDocument::Compact) + "\n\ndata: [DONE]\n\n";
+    startStream(socket, request, m_options.replyText, plan);
+}
+
+void MockBackendServer::handleMockControl(QTcpSocket *socket, const HttpRequest &request)
+{
+    if (request.path == QLatin1String("/__mock/stats")) {
+        sendJson(socket, request, 200, stats());
+    } else if (request.path == QLatin1String("/__mock/reset") && request.method == "POST") {
+        resetStats();
+        sendJson(socket, request, 200, stats());
+    } else {
+        sendJson(socket, request, 404, QJsonObject{{"message", "mock: unknown control endpoint"}});
+    }
+}
+
+// ===== 响应 =====
+
+void MockBackendServer::sendJson(QTcpSocket *socket, const HttpRequest &request, int status, const QJsonValue &json,
+                                 const QList<QPair<QByteArray, QByteArray>> &headers)
+{
+    const QByteArray body = json.isArray()
+        ? QJsonDocument(json.toArray()).toJson(QJsonDocument::Compact)
+        : QJsonDocument(json.toObject()).toJson(QJsonDocument::Compact);
+    sendResponse(socket, request, status, body, "application/json; charset=utf-8", headers);
+}
+
+void MockBackendServer::sendResponse(QTcpSocket *socket, const HttpRequest &request, int status,
+                                     const QByteArray &body, const QByteArray &contentType,
+                                     const QList<QPair<QByteArray, QByteArray>> &headers)
+{
+    const bool keepAlive = request.headers.value("connection").toLower() != "close";
+
+    QByteArray response;
+    response.reserve(body.size() + 256);
+    response += "HTTP/1.1 " + QByteArray::number(status) + ' ' + statusText(status) + "\r\n";
+    if (!contentType.isEmpty()) {
+        response += "Content-Type: " + contentType + "\r\n";
+    }
+    for (const auto &header : headers) {
+        response += header.first + ": " + header.second + "\r\n";
+    }
+    // HEAD 保留实体长度，不带实体
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n";
+    if (request.method != "HEAD") {
+        response += body;
+    }
+    socket->write(response);
+
+    finishRequest(socket, request, status);
+    if (!keepAlive) {
+        socket->disconnectFromHost();
+    }
+}
+
+void MockBackendServer::startStream(QTcpSocket *socket, const HttpRequest &request, const QString &text,
+                                    const StreamPlan &plan)
+{
+    struct StreamState {
+        QStringList tokens;
+        int next = 0;
+        int abortAt = -1;
+        QElapsedTimer clock;
+    };
+    auto state = std::make_shared<StreamState>();
+    state->tokens = tokenize(text);
+    if (shouldInject(m_options.streamAbortRate)) {
+        state->abortAt = state->tokens.size() / 2;
+    }
+    state->clock.start();
+
+    // 流式响应不带长度，以关闭连接表示结束
+    socket->write("HTTP/1.1 200 OK\r\n"
+                  "Content-Type: text/event-stream; charset=utf-8\r\n"
+                  "Cache-Control: no-cache\r\n"
+                  "Connection: close\r\n\r\n");
+    socket->write(plan.head);
+    ++m_activeStreams;
+
+    const double msPerToken = 1000.0 / m_options.tokensPerSecond;
+    const int firstTokenMs = m_options.firstTokenMs;
+    QTimer *timer = new QTimer(socket);
+    timer->setTimerType(Qt::PreciseTimer);
+    timer->setInterval(qBound(1, int(msPerToken), 50));
+
+    QPointer<QTcpSocket> guard(socket);
+    connect(timer, &QTimer::timeout, this, [this, guard, timer, state, plan, request, msPerToken, firstTokenMs]() {
+        if (!guard) {
+            return;
+        }
+        // 按墙钟时间补齐本应发出的 token，速率不受定时器精度影响
+        const double elapsed = state->clock.nsecsElapsed() / 1e6 - firstTokenMs;
+        QByteArray chunk;
+        while (state->next < state->tokens.size() && elapsed >= state->next * msPerToken) {
+            if (state->next == state->abortAt) {
+                guard->write(chunk);
+                timer->stop();
+                --m_activeStreams;
+                ++m_abortedStreams;
+                guard->flush();
+                guard->abort();
+                return;
+            }
+            chunk += plan.formatToken(state->tokens.at(state->next++));
+            ++m_streamedTokens;
+        }
+        if (!chunk.isEmpty()) {
+            guard->write(chunk);
+        }
+        if (state->next >= state->tokens.size()) {
+            timer->stop();
+            --m_activeStreams;
+            guard->write(plan.tail);
+            finishRequest(guard, request, 200);
+            guard->disconnectFromHost();
+        }
+    });
+    // 客户端提前断开
+    connect(socket, &QTcpSocket::disconnected, timer, [this, timer]() {
+        if (timer->isActive()) {
+            timer->stop();
+            --m_activeStreams;
+            ++m_abortedStreams;
+        }
+    });
+    timer->start();
+}
+
+void MockBackendServer::finishRequest(QTcpSocket *socket, const HttpRequest &request, int status)
+{
+    m_responsesByStatus[status] += 1;
+    emit requestHandled(QString::fromLatin1(request.method), request.path, status,
+                        QDateTime::currentMSecsSinceEpoch() - request.receivedMs);
+
+    auto it = m_connections.find(socket);
+    if (it != m_connections.end()) {
+        it->busy = false;
+        if (!it->buffer.isEmpty()) {
+            // 同一连接上已到达的下一个请求
+            QPointer<QTcpSocket> guard(socket);
+            QTimer::singleShot(0, this, [this, guard]() {
+                if (guard) {
+                    processNextRequest(guard);
+                }
+            });
+        }
+    }
+}
+
+// ===== 工具 =====
+
+QStringList MockBackendServer::tokenize(const QString &text) const
+{
+    QStringList tokens;
+    tokens.reserve(text.size() / m_options.tokenChars + 1);
+    int pos = 0;
+    while (pos < text.size()) {
+        int length = qMin(m_options.tokenChars, int(text.size()) - pos);
+        // 不拆开代理对
+        if (pos + length < text.size() && text.at(pos + length - 1).isHighSurrogate()) {
+            ++length;
+        }
+        tokens.append(text.mid(pos, length));
+        pos += length;
+    }
+    return tokens;
+}
+
+int MockBackendServer::injectedDelayMs()
+{
+    int delay = m_options.latencyMs;
+    if (m_options.jitterMs > 0) {
+        delay += int(m_random.bounded(m_options.jitterMs + 1));
+    }
+    return delay;
+}
+
+bool MockBackendServer::shouldInject(double rate)
+{
+    return rate > 0.0 && m_random.generateDouble() < rate;
+}
+
+QByteArray MockBackendServer::statusText(int status)
+{
+    switch (status) {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 204: return "No Content";
+    case 206: return "Partial Content";
+    case 400: return "Bad Request";
+    case 401: return "Unauthorized";
+    case 404: return "Not Found";
+    case 405: return "Method Not Allowed";
+    case 406: return "Not Acceptable";
+    case 409: return "Conflict";
+    case 416: return "Range Not Satisfiable";
+    case 429: return "Too Many Requests";
+    case 500: return "Internal Server Error";
+    case 502: return "Bad Gateway";
+    case 503: return "Service Unavailable";
+    case 504: return "Gateway Timeout";
+    default: return "Status";
+    }
+}
+
+QJsonObject MockBackendServer::stats() const
+{
+    QJsonObject routes;
+    for (auto it = m_requestsByRoute.constBegin(); it != m_requestsByRoute.constEnd(); ++it) {
+        routes.insert(it.key(), it.value());
+    }
+    QJsonObject statuses;
+    for (auto it = m_responsesByStatus.constBegin(); it != m_responsesByStatus.constEnd(); ++it) {
+        statuses.insert(QString::number(it.key()), it.value());
+    }
+    return QJsonObject{
+        {"requests_by_route", routes},
+        {"responses_by_status", statuses},
+        {"injected_errors", m_injectedErrors},
+        {"aborted_streams", m_abortedStreams},
+        {"streamed_tokens", m_streamedTokens},
+        {"active_streams", m_activeStreams},
+        {"storage_objects", int(m_storage.size())},
+        {"resumable_uploads", int(m_resumableUploads.size())},
+        {"tables", m_postgrest.tableSizes()}
+    };
+}
+
+void MockBackendServer::resetStats()
+{
+    m_requestsByRoute.clear();
+    m_responsesByStatus.clear();
+    m_injectedErrors = 0;
+    m_abortedStreams = 0;
+    m_streamedTokens = 0;
+}
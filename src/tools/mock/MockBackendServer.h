@@ -0,0 +1,150 @@
+#ifndef MOCKBACKENDSERVER_H
+#define MOCKBACKENDSERVER_H
+
+#include "MockPostgrest.h"
+#include <QByteArray>
+#include <QHash>
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QRandomGenerator>
+#include <QString>
+#include <functional>
+
+class QTcpServer;
+class QTcpSocket;
+
+/**
+ * @brief 本地 Supabase / Dify 替身服务器
+ *
+ * 基于 QTcpServer 的最小 HTTP/1.1 实现（支持 keep-alive 和分块请求体），
+ * 把客户端用到的远端接口搬到本机，离线也能做可重复的吞吐和延迟测试：
+ * - /rest/v1/<表>            内存版 PostgREST（见 MockPostgrest）
+ * - /storage/v1/object/...   上传、下载、删除，对象保存在内存
+ * - /storage/v1/upload/resumable  TUS 分块续传（创建/HEAD 查询偏移/PATCH 追加/DELETE 终止）
+ * - /auth/v1/...             固定会话，令牌有效期可配置
+ * - .../chat-messages        Dify 对话，SSE 按设定速率逐 token 回放
+ * - .../workflows/run        Dify 工作流（text_chunk + workflow_finished）
+ * - .../files/upload         Dify 文件上传
+ * - .../chat/completions     OpenAI 兼容接口（智谱/MiniMax），支持流式与非流式
+ * - /__mock/stats            请求统计；POST /__mock/reset 清零统计
+ *
+ * 所有业务接口都可以注入固定延迟 + 抖动、按比例返回错误，流式回复可按比例中途断开。
+ * 客户端通过 SUPABASE_URL / DIFY_API_BASE_URL / ZHIPU_BASE_URL 等配置指向本服务即可。
+ */
+class MockBackendServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Options {
+        int latencyMs = 0;              // 每个请求的固定延迟
+        int jitterMs = 0;               // 额外的均匀随机延迟上限
+        double errorRate = 0.0;         // 返回错误的概率（0~1）
+        int errorStatus = 503;          // 注入错误的状态码
+        double streamAbortRate = 0.0;   // 流式回复中途断开的概率
+        int firstTokenMs = 300;         // 流式回复首个 token 之前的等待
+        int tokensPerSecond = 40;       // 流式回放速率
+        int tokenChars = 2;             // 每个 token 的字符数
+        int tokenTtlSec = 3600;         // 模拟会话令牌有效期
+        QString replyText;              // 对话/补全的回复内容
+        QString workflowReplyText;      // 工作流输出（为空时使用 replyText）
+        quint32 seed = 1;               // 延迟与错误注入的随机种子
+    };
+
+    explicit MockBackendServer(const Options &options, QObject *parent = nullptr);
+
+    bool listen(const QHostAddress &address = QHostAddress::LocalHost, quint16 port = 0);
+    quint16 port() const;
+    QString baseUrl() const;
+    QString errorString() const;
+
+    MockPostgrest &postgrest() { return m_postgrest; }
+
+    QJsonObject stats() const;
+    void resetStats();
+
+signals:
+    void requestHandled(const QString &method, const QString &path, int status, qint64 elapsedMs);
+
+private:
+    struct HttpRequest {
+        QByteArray method;
+        QByteArray target;      // 原始请求目标（路径 + 查询）
+        QString path;           // 已解码路径
+        QList<QPair<QString, QString>> query;
+        QHash<QByteArray, QByteArray> headers;
+        QByteArray body;
+        qint64 receivedMs = 0;
+    };
+
+    struct Connection {
+        QByteArray buffer;
+        bool busy = false;      // 正在等待延迟或流式回放
+    };
+
+    // 流式回放：逐 token 生成一条 SSE 事件，结束时追加尾部事件
+    struct StreamPlan {
+        QByteArray head;
+        std::function<QByteArray(const QString &token)> formatToken;
+        QByteArray tail;
+    };
+
+    void onNewConnection();
+    void onReadyRead(QTcpSocket *socket);
+    void processNextRequest(QTcpSocket *socket);
+    static int parseRequest(const QByteArray &buffer, HttpRequest *request);
+
+    void dispatch(QTcpSocket *socket, const HttpRequest &request);
+    void handleRest(QTcpSocket *socket, const HttpRequest &request);
+    void handleStorage(QTcpSocket *socket, const HttpRequest &request);
+    void handleResumableUpload(QTcpSocket *socket, const HttpRequest &request);
+    void handleAuth(QTcpSocket *socket, const HttpRequest &request);
+    void handleDifyChat(QTcpSocket *socket, const HttpRequest &request);
+    void handleDifyWorkflow(QTcpSocket *socket, const HttpRequest &request);
+    void handleChatCompletions(QTcpSocket *socket, const HttpRequest &request);
+    void handleMockControl(QTcpSocket *socket, const HttpRequest &request);
+
+    void sendJson(QTcpSocket *socket, const HttpRequest &request, int status, const QJsonValue &json,
+                  const QList<QPair<QByteArray, QByteArray>> &headers = {});
+    void sendResponse(QTcpSocket *socket, const HttpRequest &request, int status, const QByteArray &body,
+                      const QByteArray &contentType,
+                      const QList<QPair<QByteArray, QByteArray>> &headers = {});
+    void startStream(QTcpSocket *socket, const HttpRequest &request, const QString &text, const StreamPlan &plan);
+    void finishRequest(QTcpSocket *socket, const HttpRequest &request, int status);
+
+    QStringList tokenize(const QString &text) const;
+    QJsonObject sessionFor(const QString &email);
+    int injectedDelayMs();
+    bool shouldInject(double rate);
+    static QByteArray statusText(int status);
+
+    Options m_options;
+    QTcpServer *m_server;
+    QHash<QTcpSocket *, Connection> m_connections;
+    QRandomGenerator m_random;
+
+    MockPostgrest m_postgrest;
+    QHash<QString, QPair<QByteArray, QByteArray>> m_storage;  // bucket/path -> (内容, Content-Type)
+
+    // 进行中的 TUS 上传
+    struct ResumableUpload {
+        QString key;            // bucket/path
+        QByteArray contentType;
+        qint64 length = 0;
+        QByteArray data;
+    };
+    QHash<QString, ResumableUpload> m_resumableUploads;
+    int m_sessionCounter = 0;
+
+    // 统计
+    QMap<QString, int> m_requestsByRoute;
+    QMap<int, int> m_responsesByStatus;
+    int m_injectedErrors = 0;
+    int m_abortedStreams = 0;
+    qint64 m_streamedTokens = 0;
+    int m_activeStreams = 0;
+};
+
+#endif // MOCKBACKENDSERVER_H
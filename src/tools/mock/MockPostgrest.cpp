@@ -0,0 +1,846 @@
+#include "MockPostgrest.h"
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QRandomGenerator>
+#include <QRegularExpression>
+#include <QUuid>
+#include <algorithm>
+
+namespace {
+
+const QStringList kSupportedOps = {
+    "eq", "neq", "gt", "gte", "lt", "lte", "like", "ilike", "in", "is", "cs", "cd", "ov"
+};
+
+// 过滤/排序时统一把标量转成字符串比较
+QString scalarText(const QJsonValue &value)
+{
+    switch (value.type()) {
+    case QJsonValue::String:
+        return value.toString();
+    case QJsonValue::Double: {
+        const double d = value.toDouble();
+        return d == qint64(d) ? QString::number(qint64(d)) : QString::number(d, 'g', 17);
+    }
+    case QJsonValue::Bool:
+        return value.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    case QJsonValue::Array:
+        return QString::fromUtf8(QJsonDocument(value.toArray()).toJson(QJsonDocument::Compact));
+    case QJsonValue::Object:
+        return QString::fromUtf8(QJsonDocument(value.toObject()).toJson(QJsonDocument::Compact));
+    default:
+        return QString();
+    }
+}
+
+int compareToLiteral(const QJsonValue &value, const QString &literal)
+{
+    if (value.isDouble()) {
+        bool ok = false;
+        const double rhs = literal.toDouble(&ok);
+        if (ok) {
+            const double lhs = value.toDouble();
+            return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+        }
+    }
+    return QString::compare(scalarText(value), literal);
+}
+
+int compareValues(const QJsonValue &a, const QJsonValue &b)
+{
+    if (a.isDouble() && b.isDouble()) {
+        return a.toDouble() < b.toDouble() ? -1 : (a.toDouble() > b.toDouble() ? 1 : 0);
+    }
+    return QString::compare(scalarText(a), scalarText(b));
+}
+
+QString unquote(const QString &text)
+{
+    if (text.size() >= 2 && text.startsWith('"') && text.endsWith('"')) {
+        QString inner = text.mid(1, text.size() - 2);
+        inner.replace(QStringLiteral("\\\""), QStringLiteral("\""));
+        inner.replace(QStringLiteral("\\\\"), QStringLiteral("\\"));
+        return inner;
+    }
+    return text;
+}
+
+// 按顶层逗号切分，跳过引号和括号内部
+QStringList splitTopLevel(const QString &text)
+{
+    QStringList parts;
+    int depth = 0;
+    bool quoted = false;
+    int start = 0;
+    for (int i = 0; i < text.size(); ++i) {
+        const QChar c = text.at(i);
+        if (c == '\\' && quoted) {
+            ++i;
+        } else if (c == '"') {
+            quoted = !quoted;
+        } else if (!quoted && (c == '(' || c == '{')) {
+            ++depth;
+        } else if (!quoted && (c == ')' || c == '}')) {
+            --depth;
+        } else if (!quoted && depth == 0 && c == ',') {
+            parts.append(text.mid(start, i - start).trimmed());
+            start = i + 1;
+        }
+    }
+    const QString last = text.mid(start).trimmed();
+    if (!last.isEmpty()) {
+        parts.append(last);
+    }
+    return parts;
+}
+
+// "(a,b)" / "{a,b}" / "[\"a\",\"b\"]" → 元素列表
+QStringList parseList(const QString &literal)
+{
+    if (literal.startsWith('[')) {
+        QStringList items;
+        const QJsonArray array = QJsonDocument::fromJson(literal.toUtf8()).array();
+        for (const QJsonValue &value : array) {
+            items.append(scalarText(value));
+        }
+        return items;
+    }
+    QString inner = literal;
+    if (inner.size() >= 2 && (inner.startsWith('(') || inner.startsWith('{'))) {
+        inner = inner.mid(1, inner.size() - 2);
+    }
+    QStringList items;
+    for (const QString &part : splitTopLevel(inner)) {
+        items.append(unquote(part));
+    }
+    return items;
+}
+
+QStringList arrayTexts(const QJsonValue &value)
+{
+    QStringList items;
+    for (const QJsonValue &element : value.toArray()) {
+        items.append(scalarText(element));
+    }
+    return items;
+}
+
+QRegularExpression likePattern(const QString &pattern, bool caseInsensitive)
+{
+    QString regex;
+    regex.reserve(pattern.size() * 2 + 4);
+    regex += QLatin1String("\\A");
+    for (const QChar c : pattern) {
+        if (c == '*' || c == '%') {
+            regex += QLatin1String(".*");
+        } else if (c == '_') {
+            regex += '.';
+        } else {
+            regex += QRegularExpression::escape(QString(c));
+        }
+    }
+    regex += QLatin1String("\\z");
+    QRegularExpression::PatternOptions options = QRegularExpression::DotMatchesEverythingOption;
+    if (caseInsensitive) {
+        options |= QRegularExpression::CaseInsensitiveOption;
+    }
+    return QRegularExpression(regex, options);
+}
+
+QString timestampAt(const QDateTime &time)
+{
+    // 与 Supabase 返回格式一致：微秒精度 + 时区偏移
+    return time.toUTC().toString(QStringLiteral("yyyy-MM-ddTHH:mm:ss.zzz")) + QStringLiteral("000+00:00");
+}
+
+QString stableUuid(const QString &name)
+{
+    static const QUuid kNamespace = QUuid::fromString(QStringLiteral("{6ba7b811-9dad-11d1-80b4-00c04fd430c8}"));
+    return QUuid::createUuidV5(kNamespace, name).toString(QUuid::WithoutBraces);
+}
+
+} // namespace
+
+// ===== 请求分发 =====
+
+MockPostgrest::Response MockPostgrest::handle(const Request &request)
+{
+    if (request.table == QLatin1String("rpc/grade_submissions") && request.method == "POST") {
+        return rpcGradeSubmissions(request);
+    }
+    if (request.table.startsWith(QLatin1String("rpc/"))) {
+        return errorResponse(404, "PGRST202", QString("Could not find the function %1 in the mock").arg(request.table.mid(4)));
+    }
+
+    Query query;
+    QString error;
+    if (!parseQuery(request, &query, &error)) {
+        return errorResponse(400, "PGRST100", error);
+    }
+
+    if (request.method == "GET" || request.method == "HEAD") {
+        return handleSelect(request, query, request.method == "HEAD");
+    }
+    if (request.method == "POST") {
+        return handleInsert(request, query);
+    }
+    if (request.method == "PATCH") {
+        return handleUpdate(request, query);
+    }
+    if (request.method == "DELETE") {
+        return handleDelete(request, query);
+    }
+    return errorResponse(405, "PGRST117", QString("Unsupported HTTP method: %1").arg(QString::fromLatin1(request.method)));
+}
+
+// ===== 查询解析 =====
+
+bool MockPostgrest::parseQuery(const Request &request, Query *query, QString *error)
+{
+    for (const auto &item : request.query) {
+        const QString &key = item.first;
+        const QString &value = item.second;
+
+        if (key == QLatin1String("select")) {
+            query->select = splitTopLevel(value);
+        } else if (key == QLatin1String("order")) {
+            for (const QString &term : splitTopLevel(value)) {
+                const QStringList pieces = term.split('.');
+                OrderTerm order;
+                order.column = pieces.value(0);
+                order.descending = pieces.contains(QStringLiteral("desc"));
+                order.nullsFirst = pieces.contains(QStringLiteral("nullsfirst"))
+                                   || (order.descending && !pieces.contains(QStringLiteral("nullslast")));
+                query->order.append(order);
+            }
+        } else if (key == QLatin1String("limit")) {
+            query->limit = value.toInt();
+        } else if (key == QLatin1String("offset")) {
+            query->offset = value.toInt();
+        } else if (key == QLatin1String("on_conflict")) {
+            query->onConflict = value;
+        } else if (key == QLatin1String("columns")) {
+            // 批量插入的列声明，内存表不需要
+        } else if (key.contains('.')) {
+            // 嵌入资源上的过滤/排序/分页（如 submissions.student_email），嵌入本身不支持，一并忽略
+        } else if (key == QLatin1String("or") || key == QLatin1String("and")
+                   || key == QLatin1String("not.or") || key == QLatin1String("not.and")) {
+            Condition condition;
+            const bool negate = key.startsWith(QLatin1String("not."));
+            const Condition::Kind kind = key.endsWith(QLatin1String("or")) ? Condition::Or : Condition::And;
+            if (!parseLogicList(value, kind, negate, &condition, error)) {
+                return false;
+            }
+            query->conditions.append(condition);
+        } else {
+            Condition condition;
+            if (!parseLeaf(key, value, &condition, error)) {
+                return false;
+            }
+            query->conditions.append(condition);
+        }
+    }
+    return true;
+}
+
+bool MockPostgrest::parseLogicList(const QString &text, Condition::Kind kind, bool negate,
+                                   Condition *out, QString *error)
+{
+    if (!text.startsWith('(') || !text.endsWith(')')) {
+        *error = QString("logic tree must be wrapped in parentheses: %1").arg(text);
+        return false;
+    }
+
+    out->kind = kind;
+    out->negate = negate;
+    for (const QString &item : splitTopLevel(text.mid(1, text.size() - 2))) {
+        QString rest = item;
+        bool childNegate = false;
+        if (rest.startsWith(QLatin1String("not.and(")) || rest.startsWith(QLatin1String("not.or("))) {
+            childNegate = true;
+            rest = rest.mid(4);
+        }
+
+        Condition child;
+        if (rest.startsWith(QLatin1String("and("))) {
+            if (!parseLogicList(rest.mid(3), Condition::And, childNegate, &child, error)) {
+                return false;
+            }
+        } else if (rest.startsWith(QLatin1String("or("))) {
+            if (!parseLogicList(rest.mid(2), Condition::Or, childNegate, &child, error)) {
+                return false;
+            }
+        } else {
+            const int dot = rest.indexOf('.');
+            if (dot <= 0 || !parseLeaf(rest.left(dot), rest.mid(dot + 1), &child, error)) {
+                if (error->isEmpty()) {
+                    *error = QString("malformed logic condition: %1").arg(item);
+                }
+                return false;
+            }
+        }
+        out->children.append(child);
+    }
+    return true;
+}
+
+bool MockPostgrest::parseLeaf(const QString &column, const QString &opAndValue, Condition *out, QString *error)
+{
+    QString rest = opAndValue;
+    out->kind = Condition::Leaf;
+    out->column = column;
+    if (rest.startsWith(QLatin1String("not."))) {
+        out->negate = true;
+        rest = rest.mid(4);
+    }
+
+    const int dot = rest.indexOf('.');
+    out->op = dot < 0 ? rest : rest.left(dot);
+    out->value = dot < 0 ? QString() : unquote(rest.mid(dot + 1));
+    if (!kSupportedOps.contains(out->op)) {
+        *error = QString("unsupported operator \"%1\" on column %2").arg(out->op, column);
+        return false;
+    }
+    return true;
+}
+
+// ===== 过滤 =====
+
+bool MockPostgrest::matches(const QJsonObject &row, const ConditionList &conditions)
+{
+    for (const Condition &condition : conditions) {
+        if (!matches(row, condition)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MockPostgrest::matches(const QJsonObject &row, const Condition &condition)
+{
+    bool result = false;
+    switch (condition.kind) {
+    case Condition::Leaf:
+        result = matchesLeaf(row.value(condition.column), condition);
+        break;
+    case Condition::And:
+        result = true;
+        for (const Condition &child : condition.children) {
+            if (!matches(row, child)) {
+                result = false;
+                break;
+            }
+        }
+        break;
+    case Condition::Or:
+        for (const Condition &child : condition.children) {
+            if (matches(row, child)) {
+                result = true;
+                break;
+            }
+        }
+        break;
+    }
+    return condition.negate ? !result : result;
+}
+
+bool MockPostgrest::matchesLeaf(const QJsonValue &value, const Condition &condition)
+{
+    const QString &op = condition.op;
+    const QString &literal = condition.value;
+
+    if (op == QLatin1String("is")) {
+        if (literal == QLatin1String("null") || literal == QLatin1String("unknown")) {
+            return value.isNull() || value.isUndefined();
+        }
+        return value.isBool() && value.toBool() == (literal == QLatin1String("true"));
+    }
+
+    // SQL 语义：与 NULL 比较一律不成立
+    if (value.isNull() || value.isUndefined()) {
+        return false;
+    }
+
+    if (op == QLatin1String("eq")) return compareToLiteral(value, literal) == 0;
+    if (op == QLatin1String("neq")) return compareToLiteral(value, literal) != 0;
+    if (op == QLatin1String("gt")) return compareToLiteral(value, literal) > 0;
+    if (op == QLatin1String("gte")) return compareToLiteral(value, literal) >= 0;
+    if (op == QLatin1String("lt")) return compareToLiteral(value, literal) < 0;
+    if (op == QLatin1String("lte")) return compareToLiteral(value, literal) <= 0;
+    if (op == QLatin1String("like") || op == QLatin1String("ilike")) {
+        return likePattern(literal, op == QLatin1String("ilike")).match(scalarText(value)).hasMatch();
+    }
+    if (op == QLatin1String("in")) {
+        return parseList(literal).contains(scalarText(value));
+    }
+
+    // 数组运算
+    const QStringList items = arrayTexts(value);
+    const QStringList wanted = parseList(literal);
+    if (op == QLatin1String("cs")) {
+        for (const QString &item : wanted) {
+            if (!items.contains(item)) return false;
+        }
+        return true;
+    }
+    if (op == QLatin1String("cd")) {
+        for (const QString &item : items) {
+            if (!wanted.contains(item)) return false;
+        }
+        return true;
+    }
+    if (op == QLatin1String("ov")) {
+        for (const QString &item : wanted) {
+            if (items.contains(item)) return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+QJsonObject MockPostgrest::project(const QJsonObject &row, const QStringList &columns)
+{
+    if (columns.isEmpty() || columns.contains(QStringLiteral("*"))) {
+        return row;
+    }
+    QJsonObject projected;
+    for (QString column : columns) {
+        if (column.contains('(')) {
+            continue;  // 嵌入资源（如 classes(*)）不模拟
+        }
+        QString alias;
+        const int colon = column.indexOf(':');
+        if (colon > 0 && column.mid(colon, 2) != QLatin1String("::")) {
+            alias = column.left(colon);
+            column = column.mid(colon + 1);
+        }
+        const int cast = column.indexOf(QLatin1String("::"));
+        if (cast > 0) {
+            column = column.left(cast);
+        }
+        projected.insert(alias.isEmpty() ? column : alias, row.value(column));
+    }
+    return projected;
+}
+
+// ===== 读 =====
+
+MockPostgrest::Response MockPostgrest::handleSelect(const Request &request, const Query &query, bool headOnly)
+{
+    const QVector<QJsonObject> &table = m_tables[request.table];
+
+    QVector<const QJsonObject *> rows;
+    rows.reserve(table.size());
+    for (const QJsonObject &row : table) {
+        if (matches(row, query.conditions)) {
+            rows.append(&row);
+        }
+    }
+
+    if (!query.order.isEmpty()) {
+        std::stable_sort(rows.begin(), rows.end(), [&query](const QJsonObject *a, const QJsonObject *b) {
+            for (const OrderTerm &term : query.order) {
+                const QJsonValue va = a->value(term.column);
+                const QJsonValue vb = b->value(term.column);
+                const bool nullA = va.isNull() || va.isUndefined();
+                const bool nullB = vb.isNull() || vb.isUndefined();
+                if (nullA != nullB) {
+                    return term.nullsFirst ? nullA : nullB;
+                }
+                const int cmp = nullA ? 0 : compareValues(va, vb);
+                if (cmp != 0) {
+                    return term.descending ? cmp > 0 : cmp < 0;
+                }
+            }
+            return false;
+        });
+    }
+
+    // 分页：limit/offset 参数优先，其次 Range 请求头
+    const int total = rows.size();
+    int start = qMax(0, query.offset);
+    int end = query.limit >= 0 ? start + query.limit - 1 : total - 1;
+    const QByteArray range = request.headers.value("range");
+    const bool hasRange = !range.isEmpty() && query.limit < 0 && query.offset == 0;
+    if (hasRange) {
+        const QList<QByteArray> bounds = range.split('-');
+        start = qMax(0, bounds.value(0).toInt());
+        if (bounds.size() > 1 && !bounds.at(1).isEmpty()) {
+            end = bounds.at(1).toInt();
+        }
+    }
+    end = qMin(end, total - 1);
+
+    const QString countMode = preferValue(request, "count");
+    const QString totalText = countMode.isEmpty() ? QStringLiteral("*") : QString::number(total);
+
+    if (hasRange && start > 0 && start >= total) {
+        Response response = errorResponse(416, "PGRST103", "Requested range not satisfiable");
+        response.headers.append({"Content-Range", QString("*/%1").arg(totalText).toUtf8()});
+        return response;
+    }
+
+    QJsonArray result;
+    for (int i = start; i <= end; ++i) {
+        result.append(project(*rows.at(i), query.select));
+    }
+
+    Response response;
+    const QString contentRange = result.isEmpty()
+        ? QString("*/%1").arg(totalText)
+        : QString("%1-%2/%3").arg(start).arg(end).arg(totalText);
+    response.headers.append({"Content-Range", contentRange.toUtf8()});
+    if (!countMode.isEmpty() && (start > 0 || end < total - 1)) {
+        response.status = 206;
+    }
+
+    if (request.headers.value("accept").contains("vnd.pgrst.object")) {
+        if (result.size() != 1) {
+            return errorResponse(406, "PGRST116", QString("JSON object requested, multiple (or no) rows returned (%1)").arg(result.size()));
+        }
+        response.body = QJsonDocument(result.first().toObject()).toJson(QJsonDocument::Compact);
+    } else {
+        response.body = QJsonDocument(result).toJson(QJsonDocument::Compact);
+    }
+    if (headOnly) {
+        response.body.clear();
+    }
+    return response;
+}
+
+// ===== 写 =====
+
+MockPostgrest::Response MockPostgrest::handleInsert(const Request &request, const Query &query)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(request.body, &parseError);
+    if (parseError.error != QJsonParseError::NoError || (!doc.isArray() && !doc.isObject())) {
+        return errorResponse(400, "PGRST102", "Empty or invalid json");
+    }
+    const QJsonArray input = doc.isArray() ? doc.array() : QJsonArray{doc.object()};
+
+    const QString resolution = preferValue(request, "resolution");
+    const QStringList conflictColumns = query.onConflict.isEmpty()
+        ? QStringList{QStringLiteral("id")}
+        : query.onConflict.split(',');
+
+    QVector<QJsonObject> &table = m_tables[request.table];
+    QJsonArray written;
+    for (const QJsonValue &value : input) {
+        const QJsonObject row = completeRow(value.toObject());
+
+        int existing = -1;
+        for (int i = 0; i < table.size() && existing < 0; ++i) {
+            bool same = true;
+            for (const QString &column : conflictColumns) {
+                if (!row.contains(column) || table.at(i).value(column) != row.value(column)) {
+                    same = false;
+                    break;
+                }
+            }
+            if (same) {
+                existing = i;
+            }
+        }
+
+        if (existing >= 0) {
+            if (resolution == QLatin1String("ignore-duplicates")) {
+                continue;
+            }
+            if (resolution != QLatin1String("merge-duplicates")) {
+                return errorResponse(409, "23505", QString("duplicate key value violates unique constraint on (%1)")
+                                                       .arg(conflictColumns.join(',')));
+            }
+            QJsonObject merged = table.at(existing);
+            for (auto it = row.begin(); it != row.end(); ++it) {
+                merged.insert(it.key(), it.value());
+            }
+            table[existing] = merged;
+            written.append(project(merged, query.select));
+        } else {
+            table.append(row);
+            written.append(project(row, query.select));
+        }
+    }
+
+    Response response;
+    response.status = 201;
+    if (preferValue(request, "return") == QLatin1String("representation")) {
+        response.body = QJsonDocument(written).toJson(QJsonDocument::Compact);
+    }
+    return response;
+}
+
+MockPostgrest::Response MockPostgrest::handleUpdate(const Request &request, const Query &query)
+{
+    const QJsonDocument doc = QJsonDocument::fromJson(request.body);
+    if (!doc.isObject()) {
+        return errorResponse(400, "PGRST102", "Empty or invalid json");
+    }
+    const QJsonObject patch = doc.object();
+
+    QJsonArray updated;
+    for (QJsonObject &row : m_tables[request.table]) {
+        if (!matches(row, query.conditions)) {
+            continue;
+        }
+        for (auto it = patch.begin(); it != patch.end(); ++it) {
+            row.insert(it.key(), it.value());
+        }
+        updated.append(project(row, query.select));
+    }
+
+    Response response;
+    if (preferValue(request, "return") == QLatin1String("representation")) {
+        response.body = QJsonDocument(updated).toJson(QJsonDocument::Compact);
+    } else {
+        response.status = 204;
+    }
+    return response;
+}
+
+MockPostgrest::Response MockPostgrest::handleDelete(const Request &request, const Query &query)
+{
+    QVector<QJsonObject> &table = m_tables[request.table];
+    QJsonArray removed;
+    QVector<QJsonObject> kept;
+    kept.reserve(table.size());
+    for (const QJsonObject &row : table) {
+        if (matches(row, query.conditions)) {
+            removed.append(project(row, query.select));
+        } else {
+            kept.append(row);
+        }
+    }
+    table = kept;
+
+    Response response;
+    if (preferValue(request, "return") == QLatin1String("representation")) {
+        response.body = QJsonDocument(removed).toJson(QJsonDocument::Compact);
+    } else {
+        response.status = 204;
+    }
+    return response;
+}
+
+// ===== RPC =====
+
+MockPostgrest::Response MockPostgrest::rpcGradeSubmissions(const Request &request)
+{
+    // 与 supabase/migrations 中的 grade_submissions 一致：grade_time 精确到毫秒比较
+    const QJsonArray grades = QJsonDocument::fromJson(request.body).object().value("p_grades").toArray();
+    const auto toMs = [](const QJsonValue &value) -> qint64 {
+        const QDateTime time = QDateTime::fromString(value.toString(), Qt::ISODateWithMs);
+        return time.isValid() ? time.toMSecsSinceEpoch() : -1;
+    };
+
+    const QString now = timestampAt(QDateTime::currentDateTimeUtc());
+    QVector<QJsonObject> &table = m_tables[QStringLiteral("submissions")];
+    QJsonArray results;
+    for (const auto &value : grades) {
+        const QJsonObject grade = value.toObject();
+        const QString id = grade.value("id").toString();
+        QJsonObject result{{"id", id}};
+
+        auto row = std::find_if(table.begin(), table.end(),
+                                [&id](const QJsonObject &r) { return r.value("id").toString() == id; });
+        if (row == table.end()) {
+            result.insert("status", "missing");
+            result.insert("grade_time", QJsonValue::Null);
+        } else if (toMs(row->value("grade_time")) != toMs(grade.value("expected_grade_time"))) {
+            result.insert("status", "conflict");
+            result.insert("grade_time", row->value("grade_time"));
+        } else {
+            row->insert("score", grade.value("score"));
+            row->insert("feedback", grade.value("feedback"));
+            row->insert("allow_resubmit", grade.value("allow_resubmit"));
+            row->insert("status", 2);
+            row->insert("grade_time", now);
+            result.insert("status", "ok");
+            result.insert("grade_time", now);
+        }
+        results.append(result);
+    }
+
+    Response response;
+    response.body = QJsonDocument(results).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+// ===== 工具 =====
+
+MockPostgrest::Response MockPostgrest::errorResponse(int status, const QString &code, const QString &message)
+{
+    Response response;
+    response.status = status;
+    response.body = QJsonDocument(QJsonObject{
+        {"code", code},
+        {"message", message},
+        {"details", QJsonValue::Null},
+        {"hint", QJsonValue::Null}
+    }).toJson(QJsonDocument::Compact);
+    return response;
+}
+
+QString MockPostgrest::preferValue(const Request &request, const QByteArray &key)
+{
+    // Prefer: return=representation, count=exact
+    const QList<QByteArray> entries = request.headers.value("prefer").split(',');
+    for (const QByteArray &entry : entries) {
+        const QByteArray trimmed = entry.trimmed();
+        if (trimmed.startsWith(key + '=')) {
+            return QString::fromUtf8(trimmed.mid(key.size() + 1));
+        }
+    }
+    return QString();
+}
+
+QJsonObject MockPostgrest::completeRow(QJsonObject row)
+{
+    // 模拟数据库默认值
+    if (!row.contains(QStringLiteral("id"))) {
+        row.insert(QStringLiteral("id"), QUuid::createUuid().toString(QUuid::WithoutBraces));
+    }
+    if (!row.contains(QStringLiteral("created_at"))) {
+        row.insert(QStringLiteral("created_at"), timestampAt(QDateTime::currentDateTimeUtc()));
+    }
+    return row;
+}
+
+// ===== 数据装载 =====
+
+void MockPostgrest::insertRows(const QString &table, const QJsonArray &rows)
+{
+    QVector<QJsonObject> &target = m_tables[table];
+    target.reserve(target.size() + rows.size());
+    for (const QJsonValue &row : rows) {
+        target.append(completeRow(row.toObject()));
+    }
+}
+
+bool MockPostgrest::loadFromJson(const QByteArray &json, QString *error)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(json, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        if (error) {
+            *error = parseError.error != QJsonParseError::NoError
+                ? parseError.errorString()
+                : QStringLiteral("顶层必须是 {\"表名\": [行, ...]}");
+        }
+        return false;
+    }
+    const QJsonObject root = doc.object();
+    for (auto it = root.begin(); it != root.end(); ++it) {
+        insertRows(it.key(), it.value().toArray());
+    }
+    return true;
+}
+
+void MockPostgrest::seedQuestions(int count)
+{
+    static const char *const kTypes[] = {
+        "single_choice", "multi_choice", "true_false", "short_answer", "essay", "material_essay"
+    };
+    static const char *const kDifficulties[] = {"easy", "medium", "hard"};
+    static const char *const kGrades[] = {"七年级", "八年级", "九年级"};
+    static const char *const kKnowledgePoints[] = {
+        "社会主义核心价值观", "宪法至上", "人民当家作主", "依法治国", "责任与角色",
+        "走进社会生活", "维护国家利益", "建设美好祖国", "青春时光", "友谊的天空"
+    };
+
+    // 固定种子，保证每次启动的数据一致
+    QRandomGenerator random(20240601);
+    const QDateTime base = QDateTime::fromString(QStringLiteral("2025-01-01T08:00:00Z"), Qt::ISODate);
+
+    QVector<QJsonObject> &table = m_tables[QStringLiteral("questions")];
+    table.reserve(table.size() + count);
+    for (int i = 0; i < count; ++i) {
+        const QString type = QString::fromLatin1(kTypes[random.bounded(6)]);
+        const bool choice = type.endsWith(QLatin1String("choice"));
+
+        QJsonArray knowledgePoints;
+        const int kpCount = 1 + random.bounded(2);
+        for (int k = 0; k < kpCount; ++k) {
+            knowledgePoints.append(QString::fromUtf8(kKnowledgePoints[random.bounded(10)]));
+        }
+
+        QJsonObject row;
+        row["id"] = stableUuid(QString("question-%1").arg(i));
+        row["paper_id"] = QJsonValue::Null;
+        row["question_type"] = type;
+        row["difficulty"] = QString::fromLatin1(kDifficulties[random.bounded(3)]);
+        row["stem"] = QString("第%1题：结合材料，分析青少年如何在社会生活中践行%2。")
+                          .arg(i + 1).arg(knowledgePoints.first().toString());
+        row["options"] = choice
+            ? QJsonArray{"A. 树立远大理想", "B. 积极参与社会实践", "C. 只关注个人发展", "D. 远离社会生活"}
+            : QJsonArray();
+        row["answer"] = choice ? QStringLiteral("B") : QStringLiteral("言之有理即可。");
+        row["explanation"] = QStringLiteral("本题考查教材核心观点，结合材料分析即可。");
+        row["score"] = choice ? 2 : 10;
+        row["order_num"] = 0;
+        row["tags"] = QJsonArray{type == QLatin1String("material_essay") ? "材料题" : "基础题"};
+        row["visibility"] = random.bounded(4) == 0 ? QStringLiteral("private") : QStringLiteral("public");
+        row["subject"] = QStringLiteral("道德与法治");
+        row["grade"] = QString::fromUtf8(kGrades[random.bounded(3)]);
+        row["chapter"] = QString("第%1课").arg(1 + random.bounded(10));
+        row["knowledge_points"] = knowledgePoints;
+        row["created_at"] = timestampAt(base.addSecs(-60LL * i));
+        table.append(row);
+    }
+}
+
+void MockPostgrest::seedPapers(int count)
+{
+    const QDateTime base = QDateTime::fromString(QStringLiteral("2025-01-01T08:00:00Z"), Qt::ISODate);
+    QVector<QJsonObject> &table = m_tables[QStringLiteral("papers")];
+    for (int i = 0; i < count; ++i) {
+        QJsonObject row;
+        row["id"] = stableUuid(QString("paper-%1").arg(i));
+        row["title"] = QString("道德与法治 单元测试卷 %1").arg(i + 1);
+        row["subject"] = QStringLiteral("道德与法治");
+        row["grade"] = QStringLiteral("八年级");
+        row["total_score"] = 100;
+        row["duration"] = 90;
+        row["paper_type"] = QStringLiteral("unit_test");
+        row["description"] = QString();
+        row["created_by"] = stableUuid(QStringLiteral("teacher-0"));
+        row["created_at"] = timestampAt(base.addSecs(-3600LL * i));
+        row["updated_at"] = row["created_at"];
+        table.append(row);
+    }
+}
+
+void MockPostgrest::seedClassMembers(int classCount, int studentsPerClass)
+{
+    const QDateTime base = QDateTime::fromString(QStringLiteral("2025-02-17T08:00:00Z"), Qt::ISODate);
+    QVector<QJsonObject> &table = m_tables[QStringLiteral("class_members")];
+    for (int c = 0; c < classCount; ++c) {
+        const QString classId = stableUuid(QString("class-%1").arg(c));
+        for (int s = 0; s < studentsPerClass; ++s) {
+            QJsonObject row;
+            row["id"] = stableUuid(QString("member-%1-%2").arg(c).arg(s));
+            row["class_id"] = classId;
+            row["student_email"] = QString("student%1_%2@example.com").arg(c).arg(s);
+            row["student_name"] = QString("学生%1-%2").arg(c + 1).arg(s + 1);
+            row["role"] = QStringLiteral("student");
+            row["joined_at"] = timestampAt(base.addSecs(60LL * s));
+            row["created_at"] = row["joined_at"];
+            table.append(row);
+        }
+    }
+}
+
+void MockPostgrest::clear()
+{
+    m_tables.clear();
+}
+
+QJsonObject MockPostgrest::tableSizes() const
+{
+    QJsonObject sizes;
+    for (auto it = m_tables.constBegin(); it != m_tables.constEnd(); ++it) {
+        sizes.insert(it.key(), int(it.value().size()));
+    }
+    return sizes;
+}
@@ -0,0 +1,108 @@
+#ifndef MOCKPOSTGREST_H
+#define MOCKPOSTGREST_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief 内存版 PostgREST（/rest/v1/<表>）
+ *
+ * 只实现客户端实际用到的语义：
+ * - 过滤：eq/neq/gt/gte/lt/lte/like/ilike/in/is/cs/cd/ov，支持 not. 前缀和 or=(...)/and=(...) 嵌套
+ * - select 列投影（不支持嵌入资源，嵌入部分忽略）、order、limit/offset
+ * - Range 请求头与 Prefer: count=exact|planned|estimated，返回 Content-Range
+ * - Prefer: return=representation、resolution=merge-duplicates（按 on_conflict 或 id 合并）
+ * - Accept: application/vnd.pgrst.object+json 返回单个对象
+ * - RPC：只实现 grade_submissions（批量批改，按 grade_time 检测冲突），其余返回 404
+ *
+ * 数据全部保存在内存里，不做类型校验，行的字段原样保存。
+ */
+class MockPostgrest
+{
+public:
+    struct Request {
+        QByteArray method;
+        QString table;
+        QList<QPair<QString, QString>> query;   // 已解码的查询参数
+        QHash<QByteArray, QByteArray> headers;  // 小写键
+        QByteArray body;
+    };
+
+    struct Response {
+        int status = 200;
+        QByteArray body;
+        QList<QPair<QByteArray, QByteArray>> headers;
+    };
+
+    Response handle(const Request &request);
+
+    // 数据装载
+    void insertRows(const QString &table, const QJsonArray &rows);
+    bool loadFromJson(const QByteArray &json, QString *error = nullptr);  // {"表名": [行, ...]}
+    void seedQuestions(int count);
+    void seedPapers(int count);
+    void seedClassMembers(int classCount, int studentsPerClass);
+    void clear();
+
+    int rowCount(const QString &table) const { return m_tables.value(table).size(); }
+    QJsonObject tableSizes() const;
+
+private:
+    struct Condition;
+    using ConditionList = QVector<Condition>;
+
+    struct Condition {
+        enum Kind { Leaf, And, Or };
+        Kind kind = Leaf;
+        bool negate = false;
+        QString column;
+        QString op;
+        QString value;
+        ConditionList children;
+    };
+
+    struct OrderTerm {
+        QString column;
+        bool descending = false;
+        bool nullsFirst = false;
+    };
+
+    struct Query {
+        ConditionList conditions;
+        QVector<OrderTerm> order;
+        QStringList select;
+        int offset = 0;
+        int limit = -1;
+        QString onConflict;
+    };
+
+    static bool parseQuery(const Request &request, Query *query, QString *error);
+    static bool parseLogicList(const QString &text, Condition::Kind kind, bool negate,
+                               Condition *out, QString *error);
+    static bool parseLeaf(const QString &column, const QString &opAndValue, Condition *out, QString *error);
+    static bool matches(const QJsonObject &row, const ConditionList &conditions);
+    static bool matches(const QJsonObject &row, const Condition &condition);
+    static bool matchesLeaf(const QJsonValue &value, const Condition &condition);
+    static QJsonObject project(const QJsonObject &row, const QStringList &columns);
+
+    Response handleSelect(const Request &request, const Query &query, bool headOnly);
+    Response handleInsert(const Request &request, const Query &query);
+    Response handleUpdate(const Request &request, const Query &query);
+    Response handleDelete(const Request &request, const Query &query);
+    Response rpcGradeSubmissions(const Request &request);
+
+    static Response errorResponse(int status, const QString &code, const QString &message);
+    static QString preferValue(const Request &request, const QByteArray &key);
+    static QJsonObject completeRow(QJsonObject row);
+
+    QHash<QString, QVector<QJsonObject>> m_tables;
+};
+
+#endif // MOCKPOSTGREST_H
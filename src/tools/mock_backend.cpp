@@ -0,0 +1,139 @@
+/**
+ * @file mock_backend.cpp
+ * @brief 本地 Supabase / Dify 替身服务器
+ *
+ * 用法:
+ *   ./MockBackend                                   # 127.0.0.1:54321，预置 2000 道题
+ *   ./MockBackend --port 0 --seed-questions 20000   # 随机端口，首行输出实际地址
+ *   ./MockBackend --latency-ms 80 --jitter-ms 40 --error-rate 0.02
+ *   ./MockBackend --tokens-per-sec 25 --first-token-ms 800 --reply-file answer.md
+ *
+ * 启动后把客户端指向它（环境变量优先于 .env.local）:
+ *   SUPABASE_URL=http://127.0.0.1:54321 SUPABASE_ANON_KEY=mock \
+ *   DIFY_API_BASE_URL=http://127.0.0.1:54321/v1 ./ImportTool --dir 试卷目录 ...
+ *
+ * 统计信息：GET /__mock/stats，清零：POST /__mock/reset
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QFile>
+#include <QHostAddress>
+#include <QTextStream>
+#include <QtGlobal>
+
+#include "mock/MockBackendServer.h"
+
+namespace {
+
+bool readFile(const QString &path, QByteArray *data)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "错误：无法读取" << path << file.errorString();
+        return false;
+    }
+    *data = file.readAll();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("MockBackend");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("本地 Supabase / Dify 替身服务器（离线压测与延迟测试）");
+    parser.addHelpOption();
+
+    const QList<QCommandLineOption> options = {
+        {"host", "监听地址", "address", "127.0.0.1"},
+        {"port", "监听端口（0 表示随机）", "port", "54321"},
+        {"latency-ms", "每个请求的固定延迟（毫秒）", "ms", "0"},
+        {"jitter-ms", "额外的随机延迟上限（毫秒）", "ms", "0"},
+        {"error-rate", "返回错误的概率（0~1）", "rate", "0"},
+        {"error-status", "注入错误的 HTTP 状态码", "status", "503"},
+        {"stream-abort-rate", "流式回复中途断开的概率（0~1）", "rate", "0"},
+        {"first-token-ms", "流式回复首个 token 前的等待（毫秒）", "ms", "300"},
+        {"tokens-per-sec", "流式回放速率", "count", "40"},
+        {"token-chars", "每个 token 的字符数", "count", "2"},
+        {"token-ttl-sec", "模拟会话令牌有效期（秒）", "seconds", "3600"},
+        {"reply-file", "对话/补全回复内容（Markdown 文本）", "file"},
+        {"workflow-reply-file", "工作流输出内容（缺省同 reply-file）", "file"},
+        {"data", "初始数据 JSON：{\"表名\": [行, ...]}", "file"},
+        {"seed-questions", "预置题目数量", "count", "2000"},
+        {"seed-papers", "预置试卷数量", "count", "50"},
+        {"seed-classes", "预置班级数量", "count", "4"},
+        {"class-size", "每个班级的学生数", "count", "45"},
+        {"seed", "延迟与错误注入的随机种子", "seed", "1"},
+        {"quiet", "不逐条打印请求日志"},
+    };
+    parser.addOptions(options);
+    parser.process(app);
+
+    MockBackendServer::Options serverOptions;
+    serverOptions.latencyMs = qMax(0, parser.value("latency-ms").toInt());
+    serverOptions.jitterMs = qMax(0, parser.value("jitter-ms").toInt());
+    serverOptions.errorRate = qBound(0.0, parser.value("error-rate").toDouble(), 1.0);
+    serverOptions.errorStatus = parser.value("error-status").toInt();
+    serverOptions.streamAbortRate = qBound(0.0, parser.value("stream-abort-rate").toDouble(), 1.0);
+    serverOptions.firstTokenMs = qMax(0, parser.value("first-token-ms").toInt());
+    serverOptions.tokensPerSecond = parser.value("tokens-per-sec").toInt();
+    serverOptions.tokenChars = parser.value("token-chars").toInt();
+    serverOptions.tokenTtlSec = parser.value("token-ttl-sec").toInt();
+    serverOptions.seed = parser.value("seed").toUInt();
+
+    QByteArray content;
+    if (parser.isSet("reply-file")) {
+        if (!readFile(parser.value("reply-file"), &content)) {
+            return 1;
+        }
+        serverOptions.replyText = QString::fromUtf8(content);
+    }
+    if (parser.isSet("workflow-reply-file")) {
+        if (!readFile(parser.value("workflow-reply-file"), &content)) {
+            return 1;
+        }
+        serverOptions.workflowReplyText = QString::fromUtf8(content);
+    }
+
+    MockBackendServer server(serverOptions);
+    MockPostgrest &postgrest = server.postgrest();
+    postgrest.seedQuestions(qMax(0, parser.value("seed-questions").toInt()));
+    postgrest.seedPapers(qMax(0, parser.value("seed-papers").toInt()));
+    postgrest.seedClassMembers(qMax(0, parser.value("seed-classes").toInt()),
+                               qMax(0, parser.value("class-size").toInt()));
+    if (parser.isSet("data")) {
+        QString error;
+        if (!readFile(parser.value("data"), &content) || !postgrest.loadFromJson(content, &error)) {
+            qCritical() << "错误：初始数据无效" << error;
+            return 1;
+        }
+    }
+
+    const QHostAddress address(parser.value("host"));
+    if (!server.listen(address, quint16(parser.value("port").toUInt()))) {
+        qCritical() << "错误：无法监听" << parser.value("host") << parser.value("port") << server.errorString();
+        return 1;
+    }
+
+    // 首行只输出地址，便于脚本解析随机端口
+    QTextStream out(stdout);
+    out << server.baseUrl() << Qt::endl;
+    out << "# SUPABASE_URL=" << server.baseUrl() << Qt::endl
+        << "# DIFY_API_BASE_URL=" << server.baseUrl() << "/v1" << Qt::endl
+        << "# ZHIPU_BASE_URL=" << server.baseUrl() << "/v1" << Qt::endl
+        << "# MINIMAX_API_BASE_URL=" << server.baseUrl() << "/v1" << Qt::endl;
+
+    if (!parser.isSet("quiet")) {
+        QObject::connect(&server, &MockBackendServer::requestHandled,
+                         [](const QString &method, const QString &path, int status, qint64 elapsedMs) {
+            qInfo().noquote() << QString("%1 %2 -> %3 (%4 ms)").arg(method, path).arg(status).arg(elapsedMs);
+        });
+    }
+
+    return app.exec();
+}
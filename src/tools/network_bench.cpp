@@ -0,0 +1,259 @@
+/**
+ * @file network_bench.cpp
+ * @brief Supabase 请求延迟基准：冷连接 vs 复用连接，HTTP/1.1 vs HTTP/2
+ *
+ * 用例:
+ *   cold.sequential      每次请求新建 QNetworkAccessManager（DNS + TCP + TLS 全部重来）
+ *   warm.sequential      共享 SessionNetworkManager，预热后顺序请求
+ *   warm.burst4.http1    共享连接上并发 4 个请求（对应 AdminManager 概览的 4 个计数查询）
+ *   warm.burst4.http2    同上，允许 HTTP/2 多路复用
+ *
+ * 用法:
+ *   ./NetworkBench                                         # 请求 SUPABASE_URL/rest/v1/
+ *   ./NetworkBench --url http://127.0.0.1:54321/rest/v1/questions?select=id&limit=1
+ *   ./NetworkBench -n 30 --output network_results.json
+ *
+ * 对本地 MockBackend（http）测量时没有 TLS，也不会协商 HTTP/2，
+ * 冷/热差距只体现 TCP 建连；对真实 Supabase 项目测量才能看到握手和多路复用的收益。
+ */
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QTextStream>
+#include <QTimer>
+#include <QVector>
+#include <algorithm>
+#include <functional>
+
+#include "../auth/supabase/supabaseconfig.h"
+#include "../utils/NetworkRequestFactory.h"
+#include "../utils/SessionNetworkManager.h"
+
+namespace {
+
+constexpr int REQUEST_TIMEOUT_MS = 30000;
+
+qint64 percentileOf(const QVector<qint64> &sorted, double p)
+{
+    if (sorted.isEmpty()) return 0;
+    const int index = qBound(0, static_cast<int>(p * (sorted.size() - 1) + 0.5), static_cast<int>(sorted.size() - 1));
+    return sorted.at(index);
+}
+
+/**
+ * 发出 count 个并发请求并等待全部完成，返回耗时（纳秒），任一请求失败返回 -1。
+ */
+qint64 timeRequests(QNetworkAccessManager *manager, const QUrl &url, int count, bool http2, bool *usedHttp2)
+{
+    QEventLoop loop;
+    QTimer timeout;
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, &QTimer::timeout, &loop, &QEventLoop::quit);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    int remaining = count;
+    bool failed = false;
+    QList<QNetworkReply *> replies;
+    for (int i = 0; i < count; ++i) {
+        QNetworkRequest request = NetworkRequestFactory::createAuthRequest(url);
+        request.setAttribute(QNetworkRequest::Http2AllowedAttribute, http2);
+        QNetworkReply *reply = manager->get(request);
+        replies.append(reply);
+        QObject::connect(reply, &QNetworkReply::finished, &loop, [&, reply]() {
+            if (reply->error() != QNetworkReply::NoError) {
+                qWarning() << "[NetworkBench] 请求失败:" << reply->errorString();
+                failed = true;
+            }
+            if (usedHttp2 && reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool()) {
+                *usedHttp2 = true;
+            }
+            if (--remaining == 0) loop.quit();
+        });
+    }
+
+    timeout.start(REQUEST_TIMEOUT_MS);
+    loop.exec();
+    const qint64 elapsed = timer.nsecsElapsed();
+
+    for (QNetworkReply *reply : replies) {
+        if (!reply->isFinished()) {
+            reply->abort();
+            failed = true;
+        }
+        reply->deleteLater();
+    }
+    return failed ? -1 : elapsed;
+}
+
+class NetworkBench
+{
+public:
+    NetworkBench(const QUrl &url, int iterations)
+        : m_url(url), m_iterations(iterations) {}
+
+    QJsonArray run()
+    {
+        benchCold();
+        benchWarm();
+        benchBurst("warm.burst4.http1", false);
+        benchBurst("warm.burst4.http2", true);
+        return m_results;
+    }
+
+private:
+    // fn 返回本轮耗时（纳秒），-1 表示失败
+    void measure(const char *name, const std::function<qint64()> &fn)
+    {
+        QVector<qint64> samplesNs;
+        samplesNs.reserve(m_iterations);
+        for (int i = 0; i < m_iterations; ++i) {
+            const qint64 ns = fn();
+            if (ns < 0) {
+                qWarning() << "[NetworkBench] 跳过用例:" << name;
+                return;
+            }
+            samplesNs.append(ns);
+        }
+        std::sort(samplesNs.begin(), samplesNs.end());
+
+        QJsonObject result;
+        result["name"] = QString::fromLatin1(name);
+        result["iterations"] = m_iterations;
+        result["median_ns"] = percentileOf(samplesNs, 0.5);
+        result["min_ns"] = samplesNs.first();
+        result["p90_ns"] = percentileOf(samplesNs, 0.9);
+        result["http2_used"] = m_usedHttp2;
+        m_results.append(result);
+
+        qInfo().noquote() << QString("%1  median=%2ms  min=%3ms  p90=%4ms%5")
+                                 .arg(QString::fromLatin1(name), -24)
+                                 .arg(percentileOf(samplesNs, 0.5) / 1e6, 0, 'f', 2)
+                                 .arg(samplesNs.first() / 1e6, 0, 'f', 2)
+                                 .arg(percentileOf(samplesNs, 0.9) / 1e6, 0, 'f', 2)
+                                 .arg(m_usedHttp2 ? "  (h2)" : "");
+        m_usedHttp2 = false;
+    }
+
+    void benchCold()
+    {
+        measure("cold.sequential", [this]() -> qint64 {
+            QNetworkAccessManager manager;
+            return timeRequests(&manager, m_url, 1, NetworkRequestFactory::http2Enabled(), &m_usedHttp2);
+        });
+    }
+
+    void benchWarm()
+    {
+        SessionNetworkManager *manager = SessionNetworkManager::forCurrentThread();
+        // 预热：第一次请求建好连接，之后每轮都复用
+        if (timeRequests(manager, m_url, 1, NetworkRequestFactory::http2Enabled(), nullptr) < 0) {
+            return;
+        }
+        measure("warm.sequential", [this, manager]() -> qint64 {
+            return timeRequests(manager, m_url, 1, NetworkRequestFactory::http2Enabled(), &m_usedHttp2);
+        });
+    }
+
+    void benchBurst(const char *name, bool http2)
+    {
+        // 单独的管理器，避免 HTTP/1.1 与 HTTP/2 用例共用连接互相影响
+        QNetworkAccessManager manager;
+        if (timeRequests(&manager, m_url, 4, http2, nullptr) < 0) {
+            return;
+        }
+        measure(name, [this, &manager, http2]() -> qint64 {
+            return timeRequests(&manager, m_url, 4, http2, &m_usedHttp2);
+        });
+    }
+
+    QUrl m_url;
+    int m_iterations;
+    bool m_usedHttp2 = false;
+    QJsonArray m_results;
+};
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("NetworkBench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Supabase 请求延迟基准（冷/热连接，HTTP/1.1 / HTTP/2）");
+    parser.addHelpOption();
+
+    QCommandLineOption urlOption(
+        QStringList() << "url",
+        "请求地址（缺省为 SUPABASE_URL/rest/v1/）",
+        "url"
+    );
+    parser.addOption(urlOption);
+
+    QCommandLineOption iterationsOption(
+        QStringList() << "n" << "iterations",
+        "每个用例的测量轮数",
+        "count",
+        "20"
+    );
+    parser.addOption(iterationsOption);
+
+    QCommandLineOption outputOption(
+        QStringList() << "o" << "output",
+        "结果 JSON 文件（缺省输出到 stdout）",
+        "file"
+    );
+    parser.addOption(outputOption);
+
+    parser.process(app);
+
+    const QUrl url(parser.isSet(urlOption)
+                       ? parser.value(urlOption)
+                       : SupabaseConfig::supabaseUrl() + "/rest/v1/");
+    if (!url.isValid() || url.host().isEmpty()) {
+        qCritical() << "错误：无效的请求地址" << url;
+        return 1;
+    }
+    const int iterations = qMax(1, parser.value(iterationsOption).toInt());
+
+    qInfo().noquote() << "目标:" << url.toString() << " 轮数:" << iterations;
+    NetworkBench bench(url, iterations);
+    const QJsonArray results = bench.run();
+
+    QJsonObject environment;
+    environment["qt_version"] = QString::fromLatin1(qVersion());
+    environment["os"] = QSysInfo::prettyProductName();
+    environment["host"] = url.host();
+    environment["scheme"] = url.scheme();
+
+    QJsonObject root;
+    root["environment"] = environment;
+    root["iterations"] = iterations;
+    root["results"] = results;
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QSaveFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly) || file.write(json) != json.size() || !file.commit()) {
+            qCritical() << "错误：无法写入" << parser.value(outputOption) << file.errorString();
+            return 1;
+        }
+        qInfo() << "结果已写入" << parser.value(outputOption);
+    } else {
+        QTextStream(stdout) << json;
+    }
+
+    return results.isEmpty() ? 1 : 0;
+}
@@ -1,6 +1,8 @@
 #include "ChatWidget.h"
 #include "../shared/StyleConfig.h"
 #include "../utils/MarkdownRenderer.h"
+#include "../utils/HotLog.h"
+#include "../utils/Metrics.h"
 #include <QScrollBar>
 #include <QTimer>
 #include <QGraphicsDropShadowEffect>
@@ -478,21 +480,19 @@ void ChatWidget::addMessage(const QString &text, bool isUser)
 
 void ChatWidget::updateLastAIMessage(const QString &text)
 {
-    qDebug() << "[ChatWidget] updateLastAIMessage called with text length:" << text.length();
-    qDebug() << "[ChatWidget] m_lastAIMessageLabel is null?" << (m_lastAIMessageLabel == nullptr);
+    // 流式输出时每个 chunk 都会调用，日志只在 AI_HOT_PATH_LOGGING 构建中保留
+    METRICS_SCOPE("chat.update_ai_message");
+    HOT_DEBUG() << "[ChatWidget] updateLastAIMessage called with text length:" << text.length();
 
     if (m_lastAIMessageLabel) {
         m_lastAIMessageLabel->setTextFormat(m_markdownEnabled ? Qt::RichText : Qt::PlainText);
-        QString currentText = m_lastAIMessageLabel->text();
-        qDebug() << "[ChatWidget] Current label text length:" << currentText.length();
 
         // 渲染Markdown内容
         QString renderedText = renderMessage(text, false); // AI消息，isUser=false
         m_lastAIMessageLabel->setText(renderedText);
-        qDebug() << "[ChatWidget] Text updated, new length:" << m_lastAIMessageLabel->text().length();
+        HOT_DEBUG() << "[ChatWidget] Text updated, new length:" << renderedText.length();
 
         scrollToBottom();
-        qDebug() << "[ChatWidget] Scroll to bottom completed";
     } else {
         qDebug() << "[ChatWidget] Error: m_lastAIMessageLabel is null, cannot update!";
     }
@@ -631,7 +631,7 @@ void ChatWidget::finishPPTPreviewProgress()
 
 void ChatWidget::updateLastAIThinking(const QString &thought)
 {
-    qDebug() << "[ChatWidget] updateLastAIThinking called with thought length:" << thought.length();
+    HOT_DEBUG() << "[ChatWidget] updateLastAIThinking called with thought length:" << thought.length();
     
     if (m_lastAIThinkingLabel && m_lastAIThinkingWidget) {
         // 显示思考过程区域
@@ -651,7 +651,7 @@ void ChatWidget::updateLastAIThinking(const QString &thought)
         currentThought += thought;
         m_lastAIThinkingLabel->setText(currentThought);
         
-        qDebug() << "[ChatWidget] Thinking content updated, total length:" << currentThought.length();
+        HOT_DEBUG() << "[ChatWidget] Thinking content updated, total length:" << currentThought.length();
         
         scrollToBottom();
     } else {
@@ -957,8 +957,9 @@ QString ChatWidget::renderMessage(const QString &text, bool isUser)
     }
 
     try {
+        METRICS_SCOPE("chat.render_markdown");
         QString html = m_markdownRenderer->renderToHtml(text);
-        qDebug() << "[ChatWidget] Markdown rendered successfully, input length:"
+        HOT_DEBUG() << "[ChatWidget] Markdown rendered successfully, input length:"
                  << text.length() << "output length:" << html.length();
         return html;
     } catch (const std::exception& e) {
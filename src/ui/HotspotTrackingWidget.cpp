@@ -1,13 +1,13 @@
 #include "HotspotTrackingWidget.h"
 #include "../services/HotspotService.h"
 #include "../services/DifyService.h"
+#include "NewsFeedView.h"
+#include "../hotspot/NewsKeywordClassifier.h"
 #include "../shared/StyleConfig.h"
-#include "../utils/LayoutUtils.h"
 #include <QDebug>
 #include <QScrollBar>
 #include <QGraphicsDropShadowEffect>
 #include <QPainter>
-#include <QNetworkRequest>
 #include <QDesktopServices>
 #include <QMessageBox>
 #include "../shared/ModernDialogHelper.h"
@@ -19,16 +19,6 @@
 
 namespace {
 
-bool containsKeyword(const QString &text, const QStringList &keywords)
-{
-    for (const QString &keyword : keywords) {
-        if (text.contains(keyword, Qt::CaseInsensitive)) {
-            return true;
-        }
-    }
-    return false;
-}
-
 // 仅用于头条卡片筛选，不影响列表数据本身
 bool isDomesticPoliticalHeadline(const NewsItem &news)
 {
@@ -36,154 +26,9 @@ bool isDomesticPoliticalHeadline(const NewsItem &news)
         return false;
     }
 
-    const QString text = news.title + " " + news.summary + " " + news.source;
-
-    // 社会/娱乐等排除关键词 - 先排除再判断
-    static const QStringList excludeKeywords = {
-        // 事故灾难类
-        "车祸", "事故", "坠楼", "跳楼", "自杀", "凶杀", "命案", "火灾",
-        "爆炸", "塌方", "坍塌", "伤亡", "遇难", "死亡", "身亡", "溺水",
-        "触电", "中毒", "煤气", "意外", "惨剧",
-        // 犯罪类
-        "骗子", "诈骗", "盗窃", "抢劫", "绑架", "失踪", "贩毒", "贪污",
-        "偷窃", "强奸", "猥亵", "杀人", "杀害", "谋杀", "行凶", "砍人",
-        "报警", "逮捕", "抓捕", "犯罪", "嫌疑人", "作案", "案件", "刑事",
-        // 娱乐八卦类
-        "出轨", "离婚", "小三", "婆媳", "家暴", "吵架", "恋情", "分手",
-        "网红", "明星", "八卦", "绯闻", "整容", "炫富", "豪宅", "豪车",
-        "结婚", "订婚", "热恋", "复合", "前夫", "前妻", "恋爱",
-        // 博彩赌博类
-        "彩票", "赌博", "酒驾", "醉驾", "超速", "违章", "中奖", "博彩",
-        // 生活娱乐类
-        "宠物", "萌宠", "吃播", "减肥", "健身", "美食", "旅游",
-        "直播", "带货", "网购", "团购", "探店", "打卡", "测评",
-        // 社会琐事类
-        "吵架", "口角", "纠纷", "邻居", "停车", "物业", "业主",
-        "打架", "斗殴", "聚众", "闹事", "争执", "争吵", "冲突",
-        // 奇闻异事类
-        "路人", "围观", "现场", "目击", "爆料", "曝光", "揭秘",
-        "惊现", "惊人", "震惊", "吓人", "离奇", "诡异", "诡异",
-        "奇葩", "奇怪", "罕见", "罕见", "匪夷所思", "不可思议",
-        // 医疗健康类（个人案例）
-        "患者", "病人", "手术", "肿瘤", "癌症", "确诊", "治疗", "医院",
-        // 消费维权类（个案）
-        "投诉", "维权", "退款", "赔偿", "索赔", "质量问题", "假冒",
-        // 家庭矛盾类
-        "继母", "继父", "婆婆", "儿媳", "女婿", "岳父", "岳母",
-        // 情感故事类
-        "表白", "求婚", "情侣", "夫妻", "相亲", "约会", "男友", "女友",
-        // 校园社会类（非教育政策）
-        "学生打架", "校园霸凌", "师生冲突", "早恋",
-        // 其他社会八卦
-        "网友热议", "引发热议", "网传", "有人", "某男", "某女",
-        "一男子", "一女子", "男童", "女童", "老人", "老太",
-        // 标题党关键词
-        "太", "竟然", "居然", "竟", "万万没想到", "没想到"
-    };
-
-    if (containsKeyword(text, excludeKeywords)) {
-        return false;
-    }
-
-    // 时政关键词/官方媒体来源
-    static const QStringList politicalKeywords = {
-        // 领导人
-        "习近平", "李强", "赵乐际", "王沪宁", "蔡奇", "丁薛祥", "李希",
-        "总书记", "国家主席", "总理", "委员长", "政协主席", "国家副主席",
-        // 机构
-        "中央", "国务院", "全国人大", "全国政协", "中纪委", "中组部",
-        "外交部", "国防部", "发改委", "教育部", "科技部", "工信部",
-        "公安部", "民政部", "司法部", "财政部", "人社部", "自然资源部",
-        "生态环境部", "住建部", "交通运输部", "水利部", "农业农村部",
-        "商务部", "文旅部", "卫健委", "退役军人部", "应急管理部",
-        "中国人民银行", "审计署", "国资委", "海关总署", "税务总局",
-        "市场监管", "广电总局", "体育总局", "统计局", "医保局",
-        // 会议活动
-        "两会", "党代会", "中央全会", "政治局", "常委会", "座谈会",
-        "工作会议", "中央经济", "深改委", "国家安全", "中央财经",
-        // 政策理论
-        "改革", "政策", "法治", "依法治国", "从严治党", "党建",
-        "思想政治", "意识形态", "马克思", "社会主义", "新时代",
-        "中国特色", "现代化", "高质量发展", "共同富裕", "乡村振兴",
-        "一带一路", "双循环", "碳达峰", "碳中和", "数字中国",
-        // 外交国防
-        "外交", "国防", "军队", "解放军", "武警", "国际关系",
-        "中美", "中俄", "中欧", "台湾", "港澳", "统一",
-        // 其他时政
-        "省委", "市委", "党委", "人大代表", "政协委员",
-        "纪检", "巡视", "反腐", "廉政", "作风建设",
-        // 补充：经济、科技政策相关
-        "经济工作", "金融监管", "科技创新", "产业政策", "区域发展"
-    };
-
-    static const QStringList officialSources = {
-        "人民日报", "新华社", "新华网", "央视", "CCTV", "中国日报",
-        "光明日报", "经济日报", "解放军报", "中国青年报", "中国纪检监察报",
-        "求是", "半月谈", "环球时报", "参考消息", "中国政府网",
-        "人民网", "央广网", "中国网", "中国新闻网", "学习强国",
-        "央视新闻", "新华社", "人民政协网", "法制日报", "科技日报"
-    };
-
-    const bool isPolitical = containsKeyword(text, politicalKeywords);
-    const bool isOfficialSource = containsKeyword(news.source, officialSources);
-    return isPolitical || isOfficialSource;
-}
-
-QString normalizeImageCacheKey(const QString &rawUrl)
-{
-    QString candidate = rawUrl.trimmed();
-    if (candidate.startsWith(QStringLiteral("//"))) {
-        candidate.prepend(QStringLiteral("https:"));
-    }
-
-    const QUrl url = QUrl::fromUserInput(candidate);
-    return url.isValid() ? url.toString() : candidate;
-}
-
-QUrl buildImageUrl(const QString &rawUrl)
-{
-    QString candidate = rawUrl.trimmed();
-    if (candidate.startsWith(QStringLiteral("//"))) {
-        candidate.prepend(QStringLiteral("https:"));
-    }
-
-    const QUrl url = QUrl::fromUserInput(candidate);
-    if (!url.isValid() || url.scheme().isEmpty()) {
-        return {};
-    }
-
-    return url;
-}
-
-QByteArray buildImageReferer(const QUrl &url)
-{
-    if (!url.isValid()) {
-        return {};
-    }
-
-    QUrl referer(url);
-    referer.setPath(QStringLiteral("/"));
-    referer.setQuery(QString());
-    referer.setFragment(QString());
-    return referer.toString().toUtf8();
-}
-
-void applyPixmapToLabel(const QPixmap &pixmap, QLabel *label)
-{
-    if (!label) {
-        return;
-    }
-
-    if (label->width() <= 0 || label->height() <= 0) {
-        label->setPixmap(pixmap);
-        return;
-    }
-
-    QPixmap scaled = pixmap.scaled(
-        label->size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
-    const int x = qMax(0, (scaled.width() - label->width()) / 2);
-    const int y = qMax(0, (scaled.height() - label->height()) / 2);
-    label->setPixmap(scaled.copy(x, y, label->width(), label->height()));
+    // 与 RealNewsProvider 的时政筛选共用同一套词表：先排除，再判断时政词/官方媒体
+    const NewsClassification result = NewsKeywordClassifier::instance().classify(news);
+    return !result.isExcluded() && (result.isPolitical() || result.officialSource);
 }
 
 } // namespace
@@ -192,15 +37,7 @@ HotspotTrackingWidget::HotspotTrackingWidget(QWidget *parent)
     : QWidget(parent)
     , m_hotspotService(nullptr)
     , m_difyService(nullptr)
-    , m_networkManager(new QNetworkAccessManager(this))
 {
-    // 图片缓存配置：最多缓存50张图片
-    static constexpr int MAX_IMAGE_CACHE_SIZE = 50;
-    m_imageCache.setMaxCost(MAX_IMAGE_CACHE_SIZE);
-
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &HotspotTrackingWidget::onImageDownloaded);
-
     setupUI();
     setupStyles();
 }
@@ -211,80 +48,7 @@ HotspotTrackingWidget::~HotspotTrackingWidget()
 
 void HotspotTrackingWidget::loadImage(const QString &url, QLabel *label)
 {
-    if (!label || url.trimmed().isEmpty()) {
-        return;
-    }
-
-    const QUrl imageUrl = buildImageUrl(url);
-    if (!imageUrl.isValid()) {
-        qWarning() << "[HotspotTrackingWidget] 图片 URL 无效:" << url;
-        return;
-    }
-
-    const QString cacheKey = normalizeImageCacheKey(imageUrl.toString());
-
-    // 在 label 上存储关联的 URL，用于调试和验证
-    label->setProperty("imageUrl", cacheKey);
-
-    // 缓存命中，直接使用
-    if (m_imageCache.contains(cacheKey)) {
-        applyPixmapToLabel(*m_imageCache[cacheKey], label);
-        return;
-    }
-
-    // 发起网络请求
-    QNetworkRequest request(imageUrl);
-    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
-#if QT_VERSION >= QT_VERSION_CHECK(5, 9, 0)
-    request.setAttribute(QNetworkRequest::RedirectPolicyAttribute,
-                         QNetworkRequest::NoLessSafeRedirectPolicy);
-#endif
-    request.setTransferTimeout(15000);
-    request.setRawHeader("User-Agent",
-                         "Mozilla/5.0 (Macintosh; Intel Mac OS X 10_15_7) "
-                         "AppleWebKit/537.36 (KHTML, like Gecko) Chrome/124.0 Safari/537.36");
-    request.setRawHeader("Accept",
-                         "image/avif,image/webp,image/apng,image/svg+xml,image/*,*/*;q=0.8");
-    const QByteArray referer = buildImageReferer(imageUrl);
-    if (!referer.isEmpty()) {
-        request.setRawHeader("Referer", referer);
-    }
-
-    QNetworkReply *reply = m_networkManager->get(request);
-    reply->setProperty("cacheKey", cacheKey);
-    m_pendingImages[reply] = label;
-}
-
-void HotspotTrackingWidget::onImageDownloaded(QNetworkReply *reply)
-{
-    if (m_pendingImages.contains(reply)) {
-        QLabel *label = m_pendingImages.take(reply);
-        const QString cacheKey = reply->property("cacheKey").toString();
-        if (reply->error() == QNetworkReply::NoError) {
-            QByteArray data = reply->readAll();
-            QPixmap pixmap;
-            if (pixmap.loadFromData(data)) {
-                const QString finalUrl = normalizeImageCacheKey(reply->url().toString());
-                if (!cacheKey.isEmpty()) {
-                    m_imageCache.insert(cacheKey, new QPixmap(pixmap));
-                }
-                if (!finalUrl.isEmpty() && finalUrl != cacheKey) {
-                    m_imageCache.insert(finalUrl, new QPixmap(pixmap));
-                }
-                if (label && label->property("imageUrl").toString() == cacheKey) {
-                    applyPixmapToLabel(pixmap, label);
-                }
-            } else {
-                qWarning() << "[HotspotTrackingWidget] 图片解码失败:" << reply->url().toString()
-                           << "content-type:" << reply->header(QNetworkRequest::ContentTypeHeader).toString()
-                           << "bytes:" << data.size();
-            }
-        } else {
-            qWarning() << "[HotspotTrackingWidget] 图片下载失败:" << reply->errorString()
-                       << "url:" << reply->url().toString();
-        }
-    }
-    reply->deleteLater();
+    NewsCardWidget::loadNetworkImage(url, label);
 }
 
 void HotspotTrackingWidget::setHotspotService(HotspotService *service)
@@ -302,13 +66,8 @@ void HotspotTrackingWidget::setHotspotService(HotspotService *service)
                 this, &HotspotTrackingWidget::onLoadingStateChanged);
         connect(m_hotspotService, &HotspotService::teachingContentGenerated,
                 this, [this]() {
-                    // 当 AI 生成完成时，尝试刷新所有按钮状态（简易方案）
-                    for (auto* btn : findChildren<QPushButton*>()) {
-                        if (btn->text().contains("生成中")) {
-                            btn->setText("生成案例");
-                            btn->setEnabled(true);
-                        }
-                    }
+                    // 当 AI 生成完成时，恢复所有卡片的按钮状态
+                    m_newsFeed->clearGenerating();
                 });
         connect(m_hotspotService, &HotspotService::errorOccurred,
                 this, [this](const QString &error) {
@@ -696,11 +455,8 @@ void HotspotTrackingWidget::createCategoryFilter()
 
 void HotspotTrackingWidget::createNewsGrid()
 {
-    m_scrollArea = new QScrollArea();
-    m_scrollArea->setWidgetResizable(true);
-    m_scrollArea->setFrameShape(QFrame::NoFrame);
-    m_scrollArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
-    m_scrollArea->setStyleSheet(
+    m_newsFeed = new NewsFeedView();
+    m_newsFeed->setStyleSheet(
         "QScrollArea { background: transparent; border: none; }"
         "QScrollBar:vertical {"
         "    border: none;"
@@ -724,16 +480,12 @@ void HotspotTrackingWidget::createNewsGrid()
         "}"
     );
 
-    m_newsContainer = new QWidget();
-    m_newsContainer->setStyleSheet("background: transparent;");
+    connect(m_newsFeed, &NewsFeedView::newsActivated,
+            this, &HotspotTrackingWidget::activateNews);
+    connect(m_newsFeed, &NewsFeedView::generateRequested,
+            this, &HotspotTrackingWidget::onGenerateTeachingClicked);
 
-    m_newsGridLayout = new QGridLayout(m_newsContainer);
-    m_newsGridLayout->setContentsMargins(0, 0, 12, 0);
-    m_newsGridLayout->setSpacing(20);
-    m_newsGridLayout->setAlignment(Qt::AlignTop);
-
-    m_scrollArea->setWidget(m_newsContainer);
-    m_mainLayout->addWidget(m_scrollArea, 1);
+    m_mainLayout->addWidget(m_newsFeed, 1);
 }
 
 // 创建头条新闻卡片 - 大气横幅样式，玻璃拟态效果
@@ -909,164 +661,6 @@ QWidget* HotspotTrackingWidget::createHeadlineCard(const NewsItem &news)
     return card;
 }
 
-// 创建新闻卡片 - 列表式横排：左缩略图 + 右标题/摘要/来源
-QWidget* HotspotTrackingWidget::createNewsCard(const NewsItem &news)
-{
-    QFrame *card = new QFrame();
-    card->setObjectName("newsCard");
-    card->setFixedHeight(155);
-    card->setCursor(Qt::PointingHandCursor);
-
-    card->setStyleSheet(QString(
-        "QFrame#newsCard {"
-        "    background-color: %1;"
-        "    border-radius: 10px;"
-        "    border: 1px solid %2;"
-        "}"
-        "QFrame#newsCard:hover {"
-        "    border-color: %3;"
-        "    background-color: #FFFBFB;"
-        "}"
-    ).arg(StyleConfig::BG_CARD, StyleConfig::BORDER_LIGHT, StyleConfig::PATRIOTIC_RED_LIGHT));
-
-    QHBoxLayout *cardLayout = new QHBoxLayout(card);
-    cardLayout->setContentsMargins(0, 0, 0, 0);
-    cardLayout->setSpacing(0);
-
-    // 左侧：缩略图（仅在有图片时显示）
-    if (!news.imageUrl.isEmpty()) {
-        QLabel *imageLabel = new QLabel();
-        imageLabel->setFixedSize(200, 155);
-        imageLabel->setAlignment(Qt::AlignCenter);
-        imageLabel->setStyleSheet(
-            "background-color: #F0F2F5;"
-            "border-top-left-radius: 10px;"
-            "border-bottom-left-radius: 10px;"
-        );
-        loadImage(news.imageUrl, imageLabel);
-        cardLayout->addWidget(imageLabel);
-    }
-
-    // 右侧：文字区域
-    QWidget *textArea = new QWidget();
-    textArea->setStyleSheet("background: transparent;");
-    QVBoxLayout *textLayout = new QVBoxLayout(textArea);
-    textLayout->setContentsMargins(20, 16, 16, 16);
-    textLayout->setSpacing(8);
-
-    // 标题（最多两行）
-    QLabel *titleLabel = new QLabel(news.title);
-    titleLabel->setWordWrap(true);
-    titleLabel->setMaximumHeight(56);
-    titleLabel->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-    titleLabel->setStyleSheet(QString(
-        "font-size: 16px; font-weight: 700; color: %1; "
-        "line-height: 1.5; background: transparent;"
-    ).arg(StyleConfig::TEXT_PRIMARY));
-    textLayout->addWidget(titleLabel);
-
-    // 摘要（最多两行，灰色小字）
-    QString summaryText = news.summary.left(120);
-    if (news.summary.length() > 120) summaryText += "...";
-    QLabel *summaryLabel = new QLabel(summaryText);
-    summaryLabel->setWordWrap(true);
-    summaryLabel->setMaximumHeight(42);
-    summaryLabel->setStyleSheet(QString(
-        "font-size: 13px; color: %1; line-height: 1.5; background: transparent;"
-    ).arg(StyleConfig::TEXT_SECONDARY));
-    textLayout->addWidget(summaryLabel);
-
-    textLayout->addStretch();
-
-    // 底部：来源 · 时间 + 操作图标
-    QWidget *bottomWidget = new QWidget();
-    bottomWidget->setStyleSheet("background: transparent;");
-    QHBoxLayout *bottomRow = new QHBoxLayout(bottomWidget);
-    bottomRow->setContentsMargins(0, 0, 0, 0);
-    bottomRow->setSpacing(6);
-
-    QLabel *sourceLabel = new QLabel(news.source);
-    sourceLabel->setStyleSheet(QString("color: %1; font-size: 12px; background: transparent;").arg(StyleConfig::TEXT_LIGHT));
-
-    QLabel *dotLabel = new QLabel("·");
-    dotLabel->setStyleSheet(QString("color: %1; font-size: 12px; background: transparent;").arg(StyleConfig::TEXT_LIGHT));
-
-    QLabel *timeLabel = new QLabel(formatTimeAgo(news.publishTime));
-    timeLabel->setStyleSheet(QString("color: %1; font-size: 12px; background: transparent;").arg(StyleConfig::TEXT_LIGHT));
-
-    // 生成案例按钮
-    QPushButton *generateBtn = new QPushButton("生成案例");
-    generateBtn->setIcon(QIcon(":/icons/resources/icons/sparkle.svg"));
-    generateBtn->setIconSize(QSize(12, 12));
-    generateBtn->setStyleSheet(QString(
-        "QPushButton {"
-        "    background-color: transparent;"
-        "    color: %1;"
-        "    border: 1.5px solid %2;"
-        "    padding: 5px 14px;"
-        "    font-size: 12px;"
-        "    font-weight: 600;"
-        "    border-radius: 13px;"
-        "}"
-        "QPushButton:hover {"
-        "    color: white;"
-        "    background: qlineargradient(x1:0, y1:0, x2:1, y2:0,"
-        "        stop:0 %3, stop:1 #FF5722);"
-        "    border: none;"
-        "}"
-    ).arg(StyleConfig::TEXT_SECONDARY, StyleConfig::BORDER_LIGHT, StyleConfig::PATRIOTIC_RED));
-    generateBtn->setCursor(Qt::PointingHandCursor);
-
-    connect(generateBtn, &QPushButton::clicked, this, [this, news]() {
-        onGenerateTeachingClicked(news);
-    });
-
-    bottomRow->addWidget(sourceLabel);
-    bottomRow->addWidget(dotLabel);
-    bottomRow->addWidget(timeLabel);
-    bottomRow->addStretch();
-    bottomRow->addWidget(generateBtn);
-    textLayout->addWidget(bottomWidget);
-
-    cardLayout->addWidget(textArea, 1);
-
-    card->setProperty("newsId", news.id);
-    card->installEventFilter(this);
-
-    return card;
-}
-
-QString HotspotTrackingWidget::formatTimeAgo(const QDateTime &time)
-{
-    if (!time.isValid()) return "刚刚";
-
-    qint64 secs = time.secsTo(QDateTime::currentDateTime());
-    if (secs < 60) return "刚刚";
-    if (secs < 3600) return QString("%1分钟前").arg(secs / 60);
-    if (secs < 86400) return QString("%1小时前").arg(secs / 3600);
-
-    qint64 days = secs / 86400;
-    if (days == 1) return "昨天";
-    if (days < 7) return QString("%1天前").arg(days);
-
-    return time.toString("MM-dd");
-}
-
-void HotspotTrackingWidget::clearNewsGrid()
-{
-    // 取消所有待处理的图片请求，避免悬空指针导致图片错位
-    // 先复制 keys 再遍历，避免迭代器失效导致崩溃
-    QList<QNetworkReply*> replies = m_pendingImages.keys();
-    m_pendingImages.clear();  // 先清空，防止回调时访问已删除的 label
-
-    for (QNetworkReply *reply : replies) {
-        reply->abort();
-        reply->deleteLater();
-    }
-
-    LayoutUtils::clearLayout(m_newsGridLayout);
-}
-
 void HotspotTrackingWidget::onRefreshClicked()
 {
     qDebug() << "[HotspotTrackingWidget] Refresh clicked";
@@ -1108,40 +702,13 @@ void HotspotTrackingWidget::onNewsListUpdated(const QList<NewsItem> &newsList)
     qDebug() << "[HotspotTrackingWidget] Received" << newsList.size() << "news items";
 
     m_currentNews = newsList;
-    clearNewsGrid();
-
-    // 重置旧的列拉伸，避免列数变化时残留
-    for (int c = 0; c < m_newsGridLayout->columnCount(); ++c) {
-        m_newsGridLayout->setColumnStretch(c, 0);
-    }
 
     m_loadingLabel->setVisible(false);
     m_emptyLabel->setVisible(newsList.isEmpty());
-    m_scrollArea->setVisible(!newsList.isEmpty());
-
-    if (newsList.isEmpty()) {
-        return;
-    }
-
-    // 单列列表布局 — 所有新闻统一横排卡片
-    m_newsGridLayout->setSpacing(12);
-
-    for (int i = 0; i < newsList.size(); ++i) {
-        QWidget *card = createNewsCard(newsList[i]);
-        m_newsGridLayout->addWidget(card, i, 0);
-    }
+    m_newsFeed->setVisible(!newsList.isEmpty());
 
-    m_newsGridLayout->setColumnStretch(0, 1);
-    m_lastColumnCount = 1;
-
-    if (m_scrollArea->verticalScrollBar()) {
-        m_scrollArea->verticalScrollBar()->setValue(0);
-    }
-}
-
-int HotspotTrackingWidget::computeGridColumns() const
-{
-    return 1;  // 固定单列列表
+    // 按新闻 id 增量更新，只实例化可见行
+    m_newsFeed->setNews(newsList);
 }
 
 void HotspotTrackingWidget::resizeEvent(QResizeEvent *event)
@@ -1163,12 +730,8 @@ void HotspotTrackingWidget::onGenerateTeachingClicked(const NewsItem &news)
         return;
     }
 
-    // 查找点击的按钮并显示状态
-    QPushButton *btn = qobject_cast<QPushButton*>(sender());
-    if (btn) {
-        btn->setText(" 生成中...");
-        btn->setEnabled(false);
-    }
+    // 卡片按钮显示生成状态（按新闻 id 记录，卡片复用后保持）
+    m_newsFeed->setGenerating(news.id, true);
 
     // 发出信号，让主窗口处理页面切换和消息发送
     emit teachingContentRequested(news);
@@ -1180,7 +743,7 @@ void HotspotTrackingWidget::onLoadingStateChanged(bool isLoading)
     m_refreshBtn->setEnabled(!isLoading);
 
     if (isLoading) {
-        m_scrollArea->setVisible(false);
+        m_newsFeed->setVisible(false);
         m_emptyLabel->setVisible(false);
     }
 }
@@ -1365,6 +928,15 @@ void HotspotTrackingWidget::showNewsDetail(const NewsItem &news)
     delete dialog;
 }
 
+void HotspotTrackingWidget::activateNews(const NewsItem &news)
+{
+    if (!news.url.isEmpty()) {
+        QDesktopServices::openUrl(QUrl(news.url));
+    } else {
+        showNewsDetail(news);
+    }
+}
+
 bool HotspotTrackingWidget::eventFilter(QObject *watched, QEvent *event)
 {
     if (event->type() == QEvent::MouseButtonRelease) {
@@ -1373,11 +945,7 @@ bool HotspotTrackingWidget::eventFilter(QObject *watched, QEvent *event)
             QString newsId = card->property("newsId").toString();
             for (const auto &news : m_currentNews) {
                 if (news.id == newsId) {
-                    if (!news.url.isEmpty()) {
-                        QDesktopServices::openUrl(QUrl(news.url));
-                    } else {
-                        showNewsDetail(news);
-                    }
+                    activateNews(news);
                     return true;
                 }
             }
@@ -12,15 +12,13 @@
 #include <QButtonGroup>
 #include <QFrame>
 #include <QTimer>
-#include <QNetworkAccessManager>
-#include <QNetworkReply>
 #include <QPixmap>
-#include <QCache>
 #include "../hotspot/NewsItem.h"
 
 // 前向声明
 class HotspotService;
 class DifyService;
+class NewsFeedView;
 
 /**
  * @brief 政治热点追踪界面
@@ -65,7 +63,6 @@ private slots:
     void onNewsCardClicked(const NewsItem &news);
     void onGenerateTeachingClicked(const NewsItem &news);
     void onLoadingStateChanged(bool isLoading);
-    void onImageDownloaded(QNetworkReply *reply);
 
 protected:
     bool eventFilter(QObject *watched, QEvent *event) override;
@@ -78,12 +75,8 @@ private:
     void createCategoryFilter();
     void createNewsGrid();
     QWidget* createHeadlineCard(const NewsItem &news);
-    QWidget* createNewsCard(const NewsItem &news);
-    QString formatTimeAgo(const QDateTime &time);
-    void clearNewsGrid();
+    void activateNews(const NewsItem &news);
     void showNewsDetail(const NewsItem &news);
-    int computeGridColumns() const;
-    void scheduleRelayout();
     void loadImage(const QString &url, QLabel *label);
     
     // UI 组件
@@ -100,10 +93,8 @@ private:
     QButtonGroup *m_categoryGroup;
     QList<QPushButton*> m_categoryButtons;
     
-    // 新闻列表区域
-    QScrollArea *m_scrollArea;
-    QWidget *m_newsContainer;
-    QGridLayout *m_newsGridLayout;
+    // 新闻列表区域（虚拟化，卡片复用）
+    NewsFeedView *m_newsFeed;
     
     // 加载状态
     QLabel *m_loadingLabel;
@@ -113,11 +104,6 @@ private:
     HotspotService *m_hotspotService;
     DifyService *m_difyService;
     
-    // 网络与缓存
-    QNetworkAccessManager *m_networkManager;
-    QCache<QString, QPixmap> m_imageCache;
-    QMap<QNetworkReply*, QLabel*> m_pendingImages;
-    
     // 状态
     QString m_currentCategory;
     QList<NewsItem> m_currentNews;
@@ -125,10 +111,6 @@ private:
     // 搜索去抖
     QTimer *m_searchDebounceTimer;
     QString m_pendingSearchText;
-
-    // 自适应网格
-    QTimer *m_relayoutTimer;
-    int m_lastColumnCount;
 };
 
 #endif // HOTSPOTTRACKINGWIDGET_H
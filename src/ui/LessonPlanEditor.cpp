@@ -53,6 +53,9 @@ namespace {
     // 功能色
     const QString SUCCESS_COLOR = "#2E7D32";           // 成功绿
     const QString WARNING_COLOR = "#F57C00";           // 警告橙
+
+    // 草稿日志超过该大小时改写为单个快照
+    constexpr qint64 DRAFT_JOURNAL_COMPACT_BYTES = 256 * 1024;
 }
 
 LessonPlanEditor::LessonPlanEditor(QWidget *parent)
@@ -71,8 +74,12 @@ LessonPlanEditor::LessonPlanEditor(QWidget *parent)
     , m_markdownRenderer(nullptr)
     , m_isGenerating(false)
     , m_isModified(false)
+    , m_streamTailPos(0)
+    , m_characterCount(0)
     , m_autoSaveTimer(nullptr)
     , m_streamRenderTimer(nullptr)
+    , m_journalSuspended(false)
+    , m_draftNeedsSnapshot(true)
 {
     initUI();
     connectSignals();
@@ -622,6 +629,8 @@ void LessonPlanEditor::connectSignals()
 
     // 编辑器内容变化信号
     connect(m_editor, &QTextEdit::textChanged, this, &LessonPlanEditor::onTextChanged);
+    connect(m_editor->document(), &QTextDocument::contentsChange,
+            this, &LessonPlanEditor::onDocumentContentsChange);
 
     // 内容变化时重启自动保存倒计时
     connect(m_editor, &QTextEdit::textChanged, this, [this]() {
@@ -774,10 +783,16 @@ void LessonPlanEditor::onAIGenerateClicked()
     m_isGenerating = true;
     m_accumulatedMarkdown.clear();
     m_pendingMarkdown.clear();
+    m_streamSplitter.reset();
     if (m_streamRenderTimer) {
         m_streamRenderTimer->stop();
     }
-    m_editor->clear();
+    // 生成期间不记录撤销栈和草稿日志，完成后整体写一次快照
+    m_journalSuspended = true;
+    m_editor->setUndoRedoEnabled(false);
+    replaceDocumentHtml(QString());
+    m_journalSuspended = true;
+    m_streamTailPos = 0;
     m_aiGenerateBtn->setEnabled(false);
     m_aiGenerateBtn->setIcon(QIcon(":/icons/resources/icons/loading-spinner.svg"));
     m_aiGenerateBtn->setText(" 生成中...");
@@ -787,6 +802,8 @@ void LessonPlanEditor::onAIGenerateClicked()
     if (!m_difyService) {
         ModernDialogHelper::warning(this, "提示", "AI 服务未就绪，请稍后重试");
         m_isGenerating = false;
+        m_journalSuspended = false;
+        m_editor->setUndoRedoEnabled(true);
         m_aiGenerateBtn->setEnabled(true);
         m_aiGenerateBtn->setIcon(QIcon(":/icons/resources/icons/ai-sparkle.svg"));
         m_aiGenerateBtn->setText(" AI生成教案");
@@ -889,14 +906,54 @@ void LessonPlanEditor::flushPendingAIText(bool flushAll)
     m_pendingMarkdown.remove(0, takeCount);
     m_accumulatedMarkdown += nextText;
 
-    QTextCursor cursor = m_editor->textCursor();
+    // 原始文本先追加到末尾（不带格式，避免继承上一块的样式）
+    QTextCursor cursor(m_editor->document());
     cursor.movePosition(QTextCursor::End);
-    cursor.insertText(nextText);
-    m_editor->setTextCursor(cursor);
+    cursor.insertText(nextText, QTextCharFormat());
+
+    // 有块写完整了就只渲染这一块，已渲染部分不再重做
+    m_streamSplitter.append(nextText);
+    const QString completed = m_streamSplitter.takeCompleted();
+    if (!completed.isEmpty()) {
+        commitStreamedMarkdown(completed, false);
+    }
+
+    QTextCursor viewCursor = m_editor->textCursor();
+    viewCursor.movePosition(QTextCursor::End);
+    m_editor->setTextCursor(viewCursor);
 
     updateWordCount();
 }
 
+void LessonPlanEditor::commitStreamedMarkdown(const QString &markdown, bool finalBlock)
+{
+    QTextCursor cursor(m_editor->document());
+    cursor.beginEditBlock();
+
+    // [m_streamTailPos, End) 是尚未渲染的原始文本：completed 块 + 未完成部分
+    cursor.setPosition(qMin(m_streamTailPos, m_editor->document()->characterCount() - 1));
+    cursor.movePosition(QTextCursor::End, QTextCursor::KeepAnchor);
+    cursor.removeSelectedText();
+
+    const int insertStart = cursor.position();
+    if (!markdown.trimmed().isEmpty()) {
+        cursor.insertHtml(m_markdownRenderer->renderToHtml(markdown));
+    }
+
+    if (!finalBlock) {
+        // 未完成部分以纯文本放回新的段落，等它完整后再渲染
+        if (cursor.position() > insertStart) {
+            cursor.insertBlock(QTextBlockFormat(), QTextCharFormat());
+        }
+        m_streamTailPos = cursor.position();
+        cursor.insertText(m_streamSplitter.pendingText(), QTextCharFormat());
+    } else {
+        m_streamTailPos = cursor.position();
+    }
+
+    cursor.endEditBlock();
+}
+
 void LessonPlanEditor::onAIFinished()
 {
     if (!m_isGenerating) {
@@ -908,13 +965,20 @@ void LessonPlanEditor::onAIFinished()
         m_streamRenderTimer->stop();
     }
 
-    const QString html = m_markdownRenderer->renderToHtml(m_accumulatedMarkdown);
-    m_editor->setHtml(html);
+    // 只渲染最后一个未完成的块，前面的块在流式过程中已经渲染好
+    commitStreamedMarkdown(m_streamSplitter.takeRemaining(), true);
     QTextCursor cursor = m_editor->textCursor();
     cursor.movePosition(QTextCursor::End);
     m_editor->setTextCursor(cursor);
     updateWordCount();
 
+    m_editor->setUndoRedoEnabled(true);
+    m_journalSuspended = false;
+    m_draftNeedsSnapshot = true;
+    if (m_autoSaveTimer) {
+        m_autoSaveTimer->start();
+    }
+
     m_isGenerating = false;
     m_aiGenerateBtn->setEnabled(true);
     m_aiGenerateBtn->setIcon(QIcon(":/icons/resources/icons/ai-sparkle.svg"));
@@ -937,6 +1001,11 @@ void LessonPlanEditor::onAIError(const QString &error)
         m_streamRenderTimer->stop();
     }
     m_pendingMarkdown.clear();
+    // 已收到的部分照常渲染保留
+    commitStreamedMarkdown(m_streamSplitter.takeRemaining(), true);
+    m_editor->setUndoRedoEnabled(true);
+    m_journalSuspended = false;
+    m_draftNeedsSnapshot = true;
     m_isGenerating = false;
     m_aiGenerateBtn->setEnabled(true);
     m_aiGenerateBtn->setIcon(QIcon(":/icons/resources/icons/ai-sparkle.svg"));
@@ -1254,11 +1323,59 @@ void LessonPlanEditor::onTextChanged()
     emit contentChanged();
 }
 
+void LessonPlanEditor::onDocumentContentsChange(int position, int charsRemoved, int charsAdded)
+{
+    // 字数按增量维护，不再每次 toPlainText() 整篇
+    m_characterCount = qMax(0, m_characterCount + charsAdded - charsRemoved);
+
+    if (m_journalSuspended) {
+        return;
+    }
+
+    // 文档末尾隐含的段落符不可选中，整体替换时两边都会计入，这里对称扣掉
+    QTextDocument *doc = m_editor->document();
+    const int overflow = position + charsAdded - (doc->characterCount() - 1);
+    if (overflow > 0) {
+        charsAdded -= overflow;
+        charsRemoved = qMax(0, charsRemoved - overflow);
+    }
+
+    if (charsAdded > 0 && charsAdded == charsRemoved) {
+        // 长度不变的改动多为格式变化，文本日志无法表达，下次保存写快照
+        m_draftNeedsSnapshot = true;
+        return;
+    }
+
+    QString inserted;
+    if (charsAdded > 0) {
+        QTextCursor cursor(doc);
+        cursor.setPosition(position);
+        cursor.setPosition(position + charsAdded, QTextCursor::KeepAnchor);
+        inserted = cursor.selectedText();
+        inserted.replace(QChar::ParagraphSeparator, QLatin1Char('\n'));
+    }
+    m_draftJournal.recordSplice(position, charsRemoved, inserted);
+}
+
 void LessonPlanEditor::updateWordCount()
 {
-    QString text = m_editor->toPlainText();
-    int count = text.length();
-    m_wordCountLabel->setText(QString("字数：%1").arg(count));
+    m_wordCountLabel->setText(QString("字数：%1").arg(m_characterCount));
+}
+
+void LessonPlanEditor::replaceDocumentHtml(const QString &html)
+{
+    m_journalSuspended = true;
+    if (html.isEmpty()) {
+        m_editor->clear();
+    } else {
+        m_editor->setHtml(html);
+    }
+    m_journalSuspended = false;
+
+    // 整体替换时 contentsChange 的增量可能带上末尾段落符，这里按文档长度校准
+    m_characterCount = qMax(0, m_editor->document()->characterCount() - 1);
+    m_draftNeedsSnapshot = true;
+    updateWordCount();
 }
 
 QString LessonPlanEditor::getContent() const
@@ -1268,7 +1385,7 @@ QString LessonPlanEditor::getContent() const
 
 void LessonPlanEditor::setContent(const QString &html)
 {
-    m_editor->setHtml(html);
+    replaceDocumentHtml(html);
     m_isModified = false;
 }
 
@@ -1288,7 +1405,7 @@ QString LessonPlanEditor::getCurrentLessonTitle() const
 
 void LessonPlanEditor::clear()
 {
-    m_editor->clear();
+    replaceDocumentHtml(QString());
     m_gradeCombo->setCurrentIndex(0);
     m_semesterCombo->clear();
     m_unitCombo->clear();
@@ -1300,19 +1417,38 @@ void LessonPlanEditor::clear()
 
 // ================== 自动保存 ==================
 
+QString LessonPlanEditor::draftKey() const
+{
+    const QString lessonTitle = getCurrentLessonTitle();
+    return QString("lesson_plan_%1").arg(lessonTitle.isEmpty() ? "untitled" : lessonTitle);
+}
+
 void LessonPlanEditor::autoSave()
 {
-    if (!m_editor || m_editor->toPlainText().trimmed().isEmpty()) return;
+    if (!m_editor || m_editor->document()->isEmpty()) return;
 
-    QSettings settings;
-    QString lessonTitle = getCurrentLessonTitle();
-    QString key = QString("autoSave/lessonPlan/%1").arg(
-        lessonTitle.isEmpty() ? "untitled" : lessonTitle);
-    settings.setValue(key, m_editor->toHtml());
-    settings.setValue(key + "_time", QDateTime::currentDateTime());
+    // 课时切换后换一个日志文件，从快照重新开始
+    const QString journalPath = DraftJournal::pathForKey(draftKey());
+    if (m_draftJournal.filePath() != journalPath) {
+        m_draftJournal.setFilePath(journalPath);
+        m_draftNeedsSnapshot = true;
+    }
+
+    // 平时只追加自上次保存以来的改动；格式变化、首次保存或日志过大时才序列化整篇 HTML
+    bool saved = false;
+    if (m_draftNeedsSnapshot || !m_draftJournal.exists() ||
+        m_draftJournal.fileSize() > DRAFT_JOURNAL_COMPACT_BYTES) {
+        saved = m_draftJournal.writeSnapshot(m_editor->toHtml());
+        m_draftNeedsSnapshot = !saved;
+    } else {
+        saved = m_draftJournal.flush();
+        m_draftNeedsSnapshot = !saved;
+    }
 
-    m_statusLabel->setText("草稿已自动保存");
-    qDebug() << "[LessonPlanEditor] 自动保存草稿，课时:" << (lessonTitle.isEmpty() ? "untitled" : lessonTitle);
+    if (saved) {
+        m_statusLabel->setText("草稿已自动保存");
+    }
+    qDebug() << "[LessonPlanEditor] 自动保存草稿:" << journalPath << (saved ? "成功" : "失败");
 }
 
 void LessonPlanEditor::checkAndRestoreDraft()
@@ -1320,11 +1456,21 @@ void LessonPlanEditor::checkAndRestoreDraft()
     // 只在控件可见时才弹窗，避免隐藏页面时弹出对话框
     if (!isVisible()) return;
 
-    QSettings settings;
     // 检查未命名草稿
-    QString key = "autoSave/lessonPlan/untitled";
-    QString savedContent = settings.value(key).toString();
-    QDateTime savedTime = settings.value(key + "_time").toDateTime();
+    QString savedContent;
+    QList<DraftJournal::Splice> splices;
+    QDateTime savedTime;
+
+    DraftJournal journal(DraftJournal::pathForKey("lesson_plan_untitled"));
+    if (journal.read(&savedContent, &splices)) {
+        savedTime = journal.lastModified();
+    } else {
+        // 兼容旧版本存在 QSettings 里的 HTML 草稿
+        QSettings settings;
+        QString key = "autoSave/lessonPlan/untitled";
+        savedContent = settings.value(key).toString();
+        savedTime = settings.value(key + "_time").toDateTime();
+    }
 
     if (savedContent.isEmpty() || !savedTime.isValid()) return;
 
@@ -1332,9 +1478,25 @@ void LessonPlanEditor::checkAndRestoreDraft()
     if (ModernDialogHelper::confirm(this, "恢复草稿",
             QString("发现 %1 的未保存草稿，是否恢复？")
                 .arg(savedTime.toString("yyyy-MM-dd HH:mm:ss")))) {
-        m_editor->setHtml(savedContent);
+        replaceDocumentHtml(savedContent);
+
+        // 快照之后的改动按顺序重放
+        m_journalSuspended = true;
+        QTextDocument *doc = m_editor->document();
+        for (const DraftJournal::Splice &splice : splices) {
+            const int maxPos = doc->characterCount() - 1;
+            const int start = qBound(0, splice.position, maxPos);
+            QTextCursor cursor(doc);
+            cursor.setPosition(start);
+            cursor.setPosition(qMin(start + splice.removed, maxPos), QTextCursor::KeepAnchor);
+            cursor.insertText(splice.text);
+        }
+        m_journalSuspended = false;
+        m_characterCount = qMax(0, doc->characterCount() - 1);
+        updateWordCount();
+
         m_statusLabel->setText("已恢复草稿");
-        qDebug() << "[LessonPlanEditor] 已恢复自动保存草稿";
+        qDebug() << "[LessonPlanEditor] 已恢复自动保存草稿，重放改动" << splices.size() << "条";
     }
     // 无论用户选择恢复还是丢弃，都清除草稿数据，防止下次重复弹窗
     clearAutoSaveDraft();
@@ -1342,6 +1504,15 @@ void LessonPlanEditor::checkAndRestoreDraft()
 
 void LessonPlanEditor::clearAutoSaveDraft()
 {
+    const QString journalPath = DraftJournal::pathForKey(draftKey());
+    if (m_draftJournal.filePath() == journalPath) {
+        m_draftJournal.remove();
+    } else {
+        DraftJournal(journalPath).remove();
+    }
+    m_draftNeedsSnapshot = true;
+
+    // 旧版本的 QSettings 草稿
     QSettings settings;
     QString lessonTitle = getCurrentLessonTitle();
     QString key = QString("autoSave/lessonPlan/%1").arg(
@@ -15,6 +15,9 @@
 #include <QTimer>
 #include <QSettings>
 
+#include "../utils/DraftJournal.h"
+#include "../utils/MarkdownStreamSplitter.h"
+
 class DifyService;
 class MarkdownRenderer;
 
@@ -90,6 +93,7 @@ private slots:
 
     // 内容变化
     void onTextChanged();
+    void onDocumentContentsChange(int position, int charsRemoved, int charsAdded);
 
 private:
     void initUI();
@@ -102,6 +106,10 @@ private:
     void updateWordCount();
     QString buildAIPrompt() const;
     void flushPendingAIText(bool flushAll = false);
+    // 把已完整的 Markdown 块渲染后替换编辑器末尾的原始文本
+    void commitStreamedMarkdown(const QString &markdown, bool finalBlock);
+    // 整体替换文档（不记入草稿日志），并重新同步字数
+    void replaceDocumentHtml(const QString &html);
 
     // 教案结构化章节
     struct LessonPlanSections {
@@ -168,13 +176,20 @@ private:
     QString m_accumulatedMarkdown;  // AI生成时累积的Markdown内容
     QString m_pendingMarkdown;      // 等待平滑显示的AI文本
     QString m_currentConversationId;
+    MarkdownStreamSplitter m_streamSplitter;  // 流式输出按块切分
+    int m_streamTailPos;            // 编辑器中未渲染的原始文本起点
+    int m_characterCount;           // 按 contentsChange 增量维护的字数
 
-    // 自动保存
+    // 自动保存（增量日志）
     QTimer *m_autoSaveTimer;
     QTimer *m_streamRenderTimer;
+    DraftJournal m_draftJournal;
+    bool m_journalSuspended;        // 整体替换/AI 生成期间不记录改动
+    bool m_draftNeedsSnapshot;      // 下次自动保存需写完整快照
     void autoSave();
     void checkAndRestoreDraft();
     void clearAutoSaveDraft();
+    QString draftKey() const;
 };
 
 #endif // LESSONPLANEDITOR_H
@@ -1,110 +1,82 @@
 #include "NetworkImageTextBrowser.h"
-#include <QNetworkRequest>
+#include "../services/ImageService.h"
 #include <QImage>
 #include <QTextDocument>
-#include <QRegularExpression>
-#include <QStandardPaths>
 #include <QDebug>
 
+namespace {
+// 图片集中到达时的合并窗口
+constexpr int kRelayoutDelayMs = 30;
+}
+
 NetworkImageTextBrowser::NetworkImageTextBrowser(QWidget *parent)
     : QTextBrowser(parent)
-    , m_networkManager(new QNetworkAccessManager(this))
+    , m_relayoutTimer(new QTimer(this))
 {
-    // 初始化 L2 磁盘缓存
-    m_diskCache = new QNetworkDiskCache(this);
-    QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
-                        + "/image_cache";
-    m_diskCache->setCacheDirectory(cachePath);
-    m_diskCache->setMaximumCacheSize(50 * 1024 * 1024); // 50MB
-    m_networkManager->setCache(m_diskCache);
-
-    connect(m_networkManager, &QNetworkAccessManager::finished,
-            this, &NetworkImageTextBrowser::onImageDownloaded);
+    m_relayoutTimer->setSingleShot(true);
+    m_relayoutTimer->setInterval(kRelayoutDelayMs);
+    connect(m_relayoutTimer, &QTimer::timeout,
+            this, &NetworkImageTextBrowser::relayoutDocument);
 }
 
 void NetworkImageTextBrowser::setHtml(const QString &html)
 {
-    // 先设置 HTML
+    // 图片在布局时经 loadResource 按需请求，已缓存的图片同步返回
+    m_pendingDownloads.clear();
     QTextBrowser::setHtml(html);
-
-    // 扫描 HTML 中的图片 URL 并预下载
-    QRegularExpression imgRe(R"(<img[^>]+src\s*=\s*[\"']([^\"']+)[\"'])");
-    QRegularExpressionMatchIterator it = imgRe.globalMatch(html);
-
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString src = match.captured(1);
-        QUrl url(src);
-
-        if (url.scheme() == "http" || url.scheme() == "https") {
-            if (!m_imageCache.contains(url) && !m_pendingDownloads.contains(url)) {
-                downloadImage(url);
-            }
-        }
-    }
 }
 
-void NetworkImageTextBrowser::downloadImage(const QUrl &url)
+void NetworkImageTextBrowser::requestImage(const QUrl &url)
 {
     m_pendingDownloads.insert(url);
-
-    QNetworkRequest request(url);
-    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
-    request.setRawHeader("User-Agent", "Mozilla/5.0 (compatible; Qt NetworkImageTextBrowser)");
-
-    m_networkManager->get(request);
-    qDebug() << "[NetworkImageTextBrowser] 开始下载图片:" << url.toString();
+    ImageService::instance()->loadNetworkImage(url, QSize(), this,
+        [this, url](const QImage &image) {
+        onImageArrived(url, image);
+    });
 }
 
-void NetworkImageTextBrowser::onImageDownloaded(QNetworkReply *reply)
+void NetworkImageTextBrowser::onImageArrived(const QUrl &url, const QImage &image)
 {
-    QUrl url = reply->url();
-    m_pendingDownloads.remove(url);
-
-    if (reply->error() == QNetworkReply::NoError) {
-        QByteArray data = reply->readAll();
-        m_imageCache[url] = data;
+    if (!m_pendingDownloads.remove(url)) {
+        return;  // 文档已被 setHtml 替换
+    }
 
-        qDebug() << "[NetworkImageTextBrowser] 图片下载成功:" << url.toString()
-                 << "大小:" << data.size() << "bytes";
+    if (image.isNull()) {
+        qDebug() << "[NetworkImageTextBrowser] 图片加载失败:" << url.toString();
+        return;
+    }
 
-        // 重新加载文档以显示图片
-        QString html = toHtml();
-        QTextBrowser::setHtml(html);
+    // 注册为文档资源，重新布局时直接取用，无需重新序列化 HTML
+    document()->addResource(QTextDocument::ImageResource, url, image);
+    m_relayoutTimer->start();
+}
 
-        // 调整高度
-        document()->setDocumentMargin(0);
-        QSize docSize = document()->size().toSize();
-        setMinimumHeight(docSize.height() + 20);
-    } else {
-        qDebug() << "[NetworkImageTextBrowser] 图片下载失败:" << url.toString()
-                 << "错误:" << reply->errorString();
-    }
+void NetworkImageTextBrowser::relayoutDocument()
+{
+    QTextDocument *doc = document();
+    doc->markContentsDirty(0, doc->characterCount());
 
-    reply->deleteLater();
+    // 调整高度
+    doc->setDocumentMargin(0);
+    QSize docSize = doc->size().toSize();
+    setMinimumHeight(docSize.height() + 20);
 }
 
 QVariant NetworkImageTextBrowser::loadResource(int type, const QUrl &name)
 {
-    if (type == QTextDocument::ImageResource) {
-        // 检查是否是网络 URL
-        if (name.scheme() == "http" || name.scheme() == "https") {
-            // 检查缓存
-            if (m_imageCache.contains(name)) {
-                QImage image;
-                if (image.loadFromData(m_imageCache[name])) {
-                    return image;
-                }
-            }
-
-            // 如果还没下载，开始下载
-            if (!m_pendingDownloads.contains(name)) {
-                const_cast<NetworkImageTextBrowser*>(this)->downloadImage(name);
-            }
+    if (type == QTextDocument::ImageResource
+        && (name.scheme() == "http" || name.scheme() == "https")) {
+        const QImage cached = ImageService::instance()->cachedNetworkImage(name);
+        if (!cached.isNull()) {
+            return cached;
+        }
 
-            // 返回空，等待下载完成后刷新
-            return QVariant();
+        if (!m_pendingDownloads.contains(name)) {
+            requestImage(name);
         }
+
+        // 返回空，等待图片到达后统一刷新
+        return QVariant();
     }
 
     // 其他资源使用默认处理
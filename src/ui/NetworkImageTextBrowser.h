@@ -2,16 +2,16 @@
 #define NETWORKIMAGETEXTBROWSER_H
 
 #include <QTextBrowser>
-#include <QNetworkAccessManager>
-#include <QNetworkDiskCache>
-#include <QNetworkReply>
-#include <QMap>
+#include <QSet>
+#include <QTimer>
 #include <QUrl>
 
 /**
  * @brief 支持网络图片加载的 QTextBrowser
  *
- * 继承 QTextBrowser，重写 loadResource 方法以支持从网络 URL 加载图片
+ * 继承 QTextBrowser，重写 loadResource 方法以支持从网络 URL 加载图片。
+ * 下载、磁盘缓存与解码交给共享的 ImageService；图片到达后通过
+ * QTextDocument::addResource 注册，同一批到达的图片只触发一次重新布局。
  */
 class NetworkImageTextBrowser : public QTextBrowser
 {
@@ -25,16 +25,13 @@ public:
 protected:
     QVariant loadResource(int type, const QUrl &name) override;
 
-private slots:
-    void onImageDownloaded(QNetworkReply *reply);
-
 private:
-    void downloadImage(const QUrl &url);
+    void requestImage(const QUrl &url);
+    void onImageArrived(const QUrl &url, const QImage &image);
+    void relayoutDocument();
 
-    QNetworkAccessManager *m_networkManager;
-    QNetworkDiskCache *m_diskCache = nullptr;   // L2 磁盘缓存
-    QMap<QUrl, QByteArray> m_imageCache;         // L1 内存缓存
     QSet<QUrl> m_pendingDownloads;
+    QTimer *m_relayoutTimer;   // 合并同一批图片到达后的重新布局
 };
 
 #endif // NETWORKIMAGETEXTBROWSER_H
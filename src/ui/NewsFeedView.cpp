@@ -0,0 +1,430 @@
+#include "NewsFeedView.h"
+#include "../services/ImageService.h"
+#include "../shared/StyleConfig.h"
+#include <QHBoxLayout>
+#include <QVBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QMouseEvent>
+#include <QScrollBar>
+#include <QUrl>
+#include <QDebug>
+#include <utility>
+
+namespace {
+
+// 卡片右侧给滚动条留出的空白（与原网格布局的右边距一致）
+constexpr int kCanvasRightMargin = 12;
+constexpr int kThumbnailWidth = 200;
+
+QUrl buildImageUrl(const QString &rawUrl)
+{
+    QString candidate = rawUrl.trimmed();
+    if (candidate.startsWith(QStringLiteral("//"))) {
+        candidate.prepend(QStringLiteral("https:"));
+    }
+
+    const QUrl url = QUrl::fromUserInput(candidate);
+    if (!url.isValid() || url.scheme().isEmpty()) {
+        return {};
+    }
+
+    return url;
+}
+
+void applyPixmapToLabel(const QPixmap &pixmap, QLabel *label)
+{
+    if (!label) {
+        return;
+    }
+
+    if (label->width() <= 0 || label->height() <= 0) {
+        label->setPixmap(pixmap);
+        return;
+    }
+
+    QPixmap scaled = pixmap.scaled(
+        label->size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
+    const int x = qMax(0, (scaled.width() - label->width()) / 2);
+    const int y = qMax(0, (scaled.height() - label->height()) / 2);
+    label->setPixmap(scaled.copy(x, y, label->width(), label->height()));
+}
+
+} // namespace
+
+// ===== NewsCardWidget =====
+
+NewsCardWidget::NewsCardWidget(QWidget *parent)
+    : QFrame(parent)
+{
+    setObjectName("newsCard");
+    setFixedHeight(NewsFeedView::CARD_HEIGHT);
+    setCursor(Qt::PointingHandCursor);
+
+    setStyleSheet(QString(
+        "QFrame#newsCard {"
+        "    background-color: %1;"
+        "    border-radius: 10px;"
+        "    border: 1px solid %2;"
+        "}"
+        "QFrame#newsCard:hover {"
+        "    border-color: %3;"
+        "    background-color: #FFFBFB;"
+        "}"
+    ).arg(StyleConfig::BG_CARD, StyleConfig::BORDER_LIGHT, StyleConfig::PATRIOTIC_RED_LIGHT));
+
+    QHBoxLayout *cardLayout = new QHBoxLayout(this);
+    cardLayout->setContentsMargins(0, 0, 0, 0);
+    cardLayout->setSpacing(0);
+
+    // 左侧：缩略图（仅在有图片时显示）
+    m_imageLabel = new QLabel();
+    m_imageLabel->setFixedSize(kThumbnailWidth, NewsFeedView::CARD_HEIGHT);
+    m_imageLabel->setAlignment(Qt::AlignCenter);
+    m_imageLabel->setStyleSheet(
+        "background-color: #F0F2F5;"
+        "border-top-left-radius: 10px;"
+        "border-bottom-left-radius: 10px;"
+    );
+    cardLayout->addWidget(m_imageLabel);
+
+    // 右侧：文字区域
+    QWidget *textArea = new QWidget();
+    textArea->setStyleSheet("background: transparent;");
+    QVBoxLayout *textLayout = new QVBoxLayout(textArea);
+    textLayout->setContentsMargins(20, 16, 16, 16);
+    textLayout->setSpacing(8);
+
+    // 标题（最多两行）
+    m_titleLabel = new QLabel();
+    m_titleLabel->setWordWrap(true);
+    m_titleLabel->setMaximumHeight(56);
+    m_titleLabel->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+    m_titleLabel->setStyleSheet(QString(
+        "font-size: 16px; font-weight: 700; color: %1; "
+        "line-height: 1.5; background: transparent;"
+    ).arg(StyleConfig::TEXT_PRIMARY));
+    textLayout->addWidget(m_titleLabel);
+
+    // 摘要（最多两行，灰色小字）
+    m_summaryLabel = new QLabel();
+    m_summaryLabel->setWordWrap(true);
+    m_summaryLabel->setMaximumHeight(42);
+    m_summaryLabel->setStyleSheet(QString(
+        "font-size: 13px; color: %1; line-height: 1.5; background: transparent;"
+    ).arg(StyleConfig::TEXT_SECONDARY));
+    textLayout->addWidget(m_summaryLabel);
+
+    textLayout->addStretch();
+
+    // 底部：来源 · 时间 + 操作图标
+    QWidget *bottomWidget = new QWidget();
+    bottomWidget->setStyleSheet("background: transparent;");
+    QHBoxLayout *bottomRow = new QHBoxLayout(bottomWidget);
+    bottomRow->setContentsMargins(0, 0, 0, 0);
+    bottomRow->setSpacing(6);
+
+    const QString metaStyle = QString("color: %1; font-size: 12px; background: transparent;")
+                                  .arg(StyleConfig::TEXT_LIGHT);
+    m_sourceLabel = new QLabel();
+    m_sourceLabel->setStyleSheet(metaStyle);
+
+    QLabel *dotLabel = new QLabel("·");
+    dotLabel->setStyleSheet(metaStyle);
+
+    m_timeLabel = new QLabel();
+    m_timeLabel->setStyleSheet(metaStyle);
+
+    // 生成案例按钮
+    m_generateBtn = new QPushButton("生成案例");
+    m_generateBtn->setIcon(QIcon(":/icons/resources/icons/sparkle.svg"));
+    m_generateBtn->setIconSize(QSize(12, 12));
+    m_generateBtn->setStyleSheet(QString(
+        "QPushButton {"
+        "    background-color: transparent;"
+        "    color: %1;"
+        "    border: 1.5px solid %2;"
+        "    padding: 5px 14px;"
+        "    font-size: 12px;"
+        "    font-weight: 600;"
+        "    border-radius: 13px;"
+        "}"
+        "QPushButton:hover {"
+        "    color: white;"
+        "    background: qlineargradient(x1:0, y1:0, x2:1, y2:0,"
+        "        stop:0 %3, stop:1 #FF5722);"
+        "    border: none;"
+        "}"
+    ).arg(StyleConfig::TEXT_SECONDARY, StyleConfig::BORDER_LIGHT, StyleConfig::PATRIOTIC_RED));
+    m_generateBtn->setCursor(Qt::PointingHandCursor);
+
+    connect(m_generateBtn, &QPushButton::clicked, this, [this]() {
+        emit generateClicked(m_news);
+    });
+
+    bottomRow->addWidget(m_sourceLabel);
+    bottomRow->addWidget(dotLabel);
+    bottomRow->addWidget(m_timeLabel);
+    bottomRow->addStretch();
+    bottomRow->addWidget(m_generateBtn);
+    textLayout->addWidget(bottomWidget);
+
+    cardLayout->addWidget(textArea, 1);
+}
+
+void NewsCardWidget::bind(const NewsItem &news, bool generating)
+{
+    const bool imageChanged = news.imageUrl != m_news.imageUrl;
+    m_news = news;
+
+    m_titleLabel->setText(news.title);
+
+    QString summaryText = news.summary.left(120);
+    if (news.summary.length() > 120) summaryText += "...";
+    m_summaryLabel->setText(summaryText);
+
+    m_sourceLabel->setText(news.clusterSize > 1
+        ? QString("%1 · %2家报道").arg(news.source).arg(news.clusterSize)
+        : news.source);
+    m_timeLabel->setText(formatTimeAgo(news.publishTime));
+    setGenerating(generating);
+
+    m_imageLabel->setVisible(!news.imageUrl.isEmpty());
+    if (imageChanged) {
+        m_imageLabel->clear();
+        m_imageLabel->setProperty("imageUrl", QVariant());
+        if (!news.imageUrl.isEmpty()) {
+            loadNetworkImage(news.imageUrl, m_imageLabel);
+        }
+    }
+}
+
+void NewsCardWidget::setGenerating(bool generating)
+{
+    m_generateBtn->setText(generating ? " 生成中..." : "生成案例");
+    m_generateBtn->setEnabled(!generating);
+}
+
+void NewsCardWidget::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton && rect().contains(event->pos())) {
+        emit clicked(m_news);
+        return;
+    }
+    QFrame::mouseReleaseEvent(event);
+}
+
+QString NewsCardWidget::formatTimeAgo(const QDateTime &time)
+{
+    if (!time.isValid()) return "刚刚";
+
+    qint64 secs = time.secsTo(QDateTime::currentDateTime());
+    if (secs < 60) return "刚刚";
+    if (secs < 3600) return QString("%1分钟前").arg(secs / 60);
+    if (secs < 86400) return QString("%1小时前").arg(secs / 3600);
+
+    qint64 days = secs / 86400;
+    if (days == 1) return "昨天";
+    if (days < 7) return QString("%1天前").arg(days);
+
+    return time.toString("MM-dd");
+}
+
+void NewsCardWidget::loadNetworkImage(const QString &url, QLabel *label)
+{
+    if (!label || url.trimmed().isEmpty()) {
+        return;
+    }
+
+    const QUrl imageUrl = buildImageUrl(url);
+    if (!imageUrl.isValid()) {
+        qWarning() << "[NewsFeedView] 图片 URL 无效:" << url;
+        return;
+    }
+
+    const QString cacheKey = imageUrl.toString();
+
+    // 在 label 上存储关联的 URL，回调时校验，避免卡片复用后图片错位
+    label->setProperty("imageUrl", cacheKey);
+
+    // 固定尺寸的卡片按显示尺寸解码，其余按原图
+    QSize targetSize;
+    if (label->minimumSize() == label->maximumSize()) {
+        targetSize = label->maximumSize() * label->devicePixelRatioF();
+    }
+
+    // 下载、磁盘缓存与解码由共享 ImageService 负责；label 销毁后回调自动失效
+    ImageService::instance()->loadNetworkImage(imageUrl, targetSize, label,
+        [label, cacheKey](const QImage &image) {
+        if (image.isNull() || label->property("imageUrl").toString() != cacheKey) {
+            return;
+        }
+        applyPixmapToLabel(QPixmap::fromImage(image), label);
+    });
+}
+
+// ===== NewsFeedView =====
+
+NewsFeedView::NewsFeedView(QWidget *parent)
+    : QScrollArea(parent)
+    , m_canvas(new QWidget())
+{
+    setWidgetResizable(true);
+    setFrameShape(QFrame::NoFrame);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+
+    m_canvas->setStyleSheet("background: transparent;");
+    setWidget(m_canvas);
+
+    connect(verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &NewsFeedView::updateVisibleCards);
+}
+
+bool NewsFeedView::sameCardContent(const NewsItem &a, const NewsItem &b)
+{
+    return a.title == b.title
+        && a.summary == b.summary
+        && a.source == b.source
+        && a.imageUrl == b.imageUrl
+        && a.url == b.url
+        && a.publishTime == b.publishTime
+        && a.clusterSize == b.clusterSize;
+}
+
+void NewsFeedView::setNews(const QList<NewsItem> &newsList)
+{
+    const QString previousFirstKey = m_keys.isEmpty() ? QString() : m_keys.first();
+
+    m_news = newsList;
+    m_keys.clear();
+    m_keys.reserve(newsList.size());
+    m_indexByKey.clear();
+    m_indexByKey.reserve(newsList.size());
+
+    for (int i = 0; i < newsList.size(); ++i) {
+        QString key = newsList.at(i).id;
+        if (key.isEmpty() || m_indexByKey.contains(key)) {
+            key = QString("%1#%2").arg(key).arg(i);
+        }
+        m_keys.append(key);
+        m_indexByKey.insert(key, i);
+    }
+
+    // 已显示的卡片：新闻仍在列表中则保留（内容变化才换绑），否则回收
+    int rebound = 0;
+    for (auto it = m_activeCards.begin(); it != m_activeCards.end();) {
+        auto indexIt = m_indexByKey.constFind(it.key());
+        if (indexIt == m_indexByKey.constEnd()) {
+            releaseCard(it.value());
+            it = m_activeCards.erase(it);
+            continue;
+        }
+        const NewsItem &news = m_news.at(indexIt.value());
+        if (!sameCardContent(it.value()->news(), news)) {
+            it.value()->bind(news, m_generatingIds.contains(news.id));
+            ++rebound;
+        }
+        ++it;
+    }
+
+    const int stride = CARD_HEIGHT + ROW_SPACING;
+    m_canvas->setMinimumHeight(m_news.isEmpty() ? 0 : m_news.size() * stride - ROW_SPACING);
+
+    // 换了一批新闻（分类/搜索）才回到顶部，同一列表刷新保持阅读位置
+    const QString firstKey = m_keys.isEmpty() ? QString() : m_keys.first();
+    if (firstKey != previousFirstKey) {
+        verticalScrollBar()->setValue(0);
+    }
+
+    updateVisibleCards();
+
+    qDebug() << "[NewsFeedView] 更新" << m_news.size() << "条，换绑" << rebound
+             << "张，已实例化" << materializedCardCount() << "张卡片";
+}
+
+void NewsFeedView::setGenerating(const QString &newsId, bool generating)
+{
+    if (generating) {
+        m_generatingIds.insert(newsId);
+    } else {
+        m_generatingIds.remove(newsId);
+    }
+
+    for (NewsCardWidget *card : std::as_const(m_activeCards)) {
+        if (card->news().id == newsId) {
+            card->setGenerating(generating);
+        }
+    }
+}
+
+void NewsFeedView::clearGenerating()
+{
+    m_generatingIds.clear();
+    for (NewsCardWidget *card : std::as_const(m_activeCards)) {
+        card->setGenerating(false);
+    }
+}
+
+void NewsFeedView::resizeEvent(QResizeEvent *event)
+{
+    QScrollArea::resizeEvent(event);
+    updateVisibleCards();
+}
+
+void NewsFeedView::updateVisibleCards()
+{
+    const int stride = CARD_HEIGHT + ROW_SPACING;
+    const int cardWidth = qMax(0, viewport()->width() - kCanvasRightMargin);
+
+    int first = 0;
+    int last = -1;
+    if (!m_news.isEmpty()) {
+        const int top = verticalScrollBar()->value();
+        const int bottom = top + viewport()->height();
+        first = qMax(0, top / stride - OVERSCAN_ROWS);
+        last = qMin(m_news.size() - 1, bottom / stride + OVERSCAN_ROWS);
+    }
+
+    // 回收滚出可见区间的卡片
+    for (auto it = m_activeCards.begin(); it != m_activeCards.end();) {
+        const int index = m_indexByKey.value(it.key(), -1);
+        if (index < first || index > last) {
+            releaseCard(it.value());
+            it = m_activeCards.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // 只为可见区间内的行实例化/摆放卡片
+    for (int i = first; i <= last; ++i) {
+        const QString &key = m_keys.at(i);
+        NewsCardWidget *card = m_activeCards.value(key, nullptr);
+        if (!card) {
+            card = acquireCard();
+            const NewsItem &news = m_news.at(i);
+            card->bind(news, m_generatingIds.contains(news.id));
+            m_activeCards.insert(key, card);
+        }
+        card->setGeometry(0, i * stride, cardWidth, CARD_HEIGHT);
+        card->show();
+    }
+}
+
+NewsCardWidget *NewsFeedView::acquireCard()
+{
+    if (!m_cardPool.isEmpty()) {
+        return m_cardPool.takeLast();
+    }
+
+    NewsCardWidget *card = new NewsCardWidget(m_canvas);
+    connect(card, &NewsCardWidget::clicked, this, &NewsFeedView::newsActivated);
+    connect(card, &NewsCardWidget::generateClicked, this, &NewsFeedView::generateRequested);
+    return card;
+}
+
+void NewsFeedView::releaseCard(NewsCardWidget *card)
+{
+    card->hide();
+    m_cardPool.append(card);
+}
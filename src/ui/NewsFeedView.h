@@ -0,0 +1,106 @@
+#ifndef NEWSFEEDVIEW_H
+#define NEWSFEEDVIEW_H
+
+#include <QFrame>
+#include <QHash>
+#include <QScrollArea>
+#include <QSet>
+#include <QVector>
+#include "../hotspot/NewsItem.h"
+
+class QLabel;
+class QPushButton;
+
+/**
+ * @brief 新闻列表卡片（可复用）
+ *
+ * 控件树只在创建时搭建一次，之后通过 bind() 换绑新闻数据，
+ * 由 NewsFeedView 的对象池回收复用。
+ */
+class NewsCardWidget : public QFrame
+{
+    Q_OBJECT
+
+public:
+    explicit NewsCardWidget(QWidget *parent = nullptr);
+
+    void bind(const NewsItem &news, bool generating);
+    void setGenerating(bool generating);
+
+    const NewsItem &news() const { return m_news; }
+
+    static QString formatTimeAgo(const QDateTime &time);
+
+    // 异步加载网络图片到 label（经 ImageService），label 复用时自动丢弃过期结果
+    static void loadNetworkImage(const QString &url, QLabel *label);
+
+signals:
+    void clicked(const NewsItem &news);
+    void generateClicked(const NewsItem &news);
+
+protected:
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+private:
+    NewsItem m_news;
+    QLabel *m_imageLabel;
+    QLabel *m_titleLabel;
+    QLabel *m_summaryLabel;
+    QLabel *m_sourceLabel;
+    QLabel *m_timeLabel;
+    QPushButton *m_generateBtn;
+};
+
+/**
+ * @brief 虚拟化新闻列表
+ *
+ * 单列定高卡片列表，只为视口内（加上下各几行预留）的新闻实例化卡片，
+ * 滚出视口的卡片回收到对象池供后续行复用。
+ * setNews() 按新闻 id 做增量更新：内容未变的卡片只移动位置，不重新绑定。
+ */
+class NewsFeedView : public QScrollArea
+{
+    Q_OBJECT
+
+public:
+    static constexpr int CARD_HEIGHT = 155;
+    static constexpr int ROW_SPACING = 12;
+    static constexpr int OVERSCAN_ROWS = 3;
+
+    explicit NewsFeedView(QWidget *parent = nullptr);
+
+    void setNews(const QList<NewsItem> &newsList);
+    const QList<NewsItem> &news() const { return m_news; }
+
+    // “生成中”状态按新闻 id 记录，卡片复用后仍能正确恢复
+    void setGenerating(const QString &newsId, bool generating);
+    void clearGenerating();
+
+    // 已实例化的卡片数（含对象池中空闲的）
+    int materializedCardCount() const { return m_activeCards.size() + m_cardPool.size(); }
+
+signals:
+    void newsActivated(const NewsItem &news);
+    void generateRequested(const NewsItem &news);
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    static bool sameCardContent(const NewsItem &a, const NewsItem &b);
+
+    void updateVisibleCards();
+    NewsCardWidget *acquireCard();
+    void releaseCard(NewsCardWidget *card);
+
+    QWidget *m_canvas;
+    QList<NewsItem> m_news;
+    QVector<QString> m_keys;             // 每行的复用键（新闻 id，重复/缺失时附加行号）
+    QHash<QString, int> m_indexByKey;
+
+    QHash<QString, NewsCardWidget*> m_activeCards;  // 复用键 -> 正在显示的卡片
+    QVector<NewsCardWidget*> m_cardPool;            // 空闲卡片
+    QSet<QString> m_generatingIds;
+};
+
+#endif // NEWSFEEDVIEW_H
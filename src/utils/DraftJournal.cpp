@@ -0,0 +1,190 @@
+#include "DraftJournal.h"
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace {
+
+constexpr quint32 kJournalMagic = 0x444A524E;  // "DJRN"
+constexpr quint16 kJournalVersion = 1;
+constexpr quint8 kRecordSnapshot = 'S';
+constexpr quint8 kRecordSplice = 'D';
+
+void writeHeader(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_5_15);
+    stream << kJournalMagic << kJournalVersion;
+}
+
+} // namespace
+
+DraftJournal::DraftJournal(const QString &filePath)
+    : m_filePath(filePath)
+{
+}
+
+void DraftJournal::setFilePath(const QString &filePath)
+{
+    if (m_filePath != filePath) {
+        m_filePath = filePath;
+        m_pending.clear();
+    }
+}
+
+bool DraftJournal::exists() const
+{
+    return !m_filePath.isEmpty() && QFileInfo::exists(m_filePath);
+}
+
+QDateTime DraftJournal::lastModified() const
+{
+    return QFileInfo(m_filePath).lastModified();
+}
+
+qint64 DraftJournal::fileSize() const
+{
+    return QFileInfo(m_filePath).size();
+}
+
+void DraftJournal::recordSplice(int position, int removed, const QString &text)
+{
+    // 连续输入/连续退格合并成一条记录，避免逐字一条
+    if (!m_pending.isEmpty()) {
+        Splice &last = m_pending.last();
+        if (removed == 0 && position == last.position + last.text.size()) {
+            last.text += text;
+            return;
+        }
+        if (text.isEmpty() && last.text.isEmpty() && position + removed == last.position) {
+            last.position = position;
+            last.removed += removed;
+            return;
+        }
+    }
+    m_pending.append({position, removed, text});
+}
+
+bool DraftJournal::writeSnapshot(const QString &html)
+{
+    if (m_filePath.isEmpty()) {
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[DraftJournal] 无法写入草稿:" << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    writeHeader(stream);
+    stream << kRecordSnapshot << qCompress(html.toUtf8());
+
+    m_pending.clear();
+    return file.commit();
+}
+
+bool DraftJournal::flush()
+{
+    if (m_pending.isEmpty()) {
+        return true;
+    }
+    if (!exists()) {
+        // 没有快照的改动无法重放
+        return false;
+    }
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "[DraftJournal] 无法追加草稿:" << file.errorString();
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+    for (const Splice &splice : m_pending) {
+        stream << kRecordSplice << qint32(splice.position) << qint32(splice.removed) << splice.text;
+    }
+    m_pending.clear();
+    return stream.status() == QDataStream::Ok;
+}
+
+bool DraftJournal::read(QString *html, QList<Splice> *splices) const
+{
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint16 version = 0;
+    stream >> magic >> version;
+    if (magic != kJournalMagic || version != kJournalVersion) {
+        return false;
+    }
+
+    bool hasSnapshot = false;
+    QString snapshot;
+    QList<Splice> replay;
+
+    while (!stream.atEnd()) {
+        quint8 type = 0;
+        stream >> type;
+        if (type == kRecordSnapshot) {
+            QByteArray compressed;
+            stream >> compressed;
+            if (stream.status() != QDataStream::Ok) {
+                break;
+            }
+            snapshot = QString::fromUtf8(qUncompress(compressed));
+            replay.clear();
+            hasSnapshot = true;
+        } else if (type == kRecordSplice) {
+            qint32 position = 0;
+            qint32 removed = 0;
+            QString text;
+            stream >> position >> removed >> text;
+            if (stream.status() != QDataStream::Ok) {
+                break;  // 残缺的尾记录
+            }
+            replay.append({position, removed, text});
+        } else {
+            break;
+        }
+    }
+
+    if (!hasSnapshot) {
+        return false;
+    }
+    if (html) {
+        *html = snapshot;
+    }
+    if (splices) {
+        *splices = replay;
+    }
+    return true;
+}
+
+void DraftJournal::remove()
+{
+    m_pending.clear();
+    if (!m_filePath.isEmpty()) {
+        QFile::remove(m_filePath);
+    }
+}
+
+QString DraftJournal::pathForKey(const QString &key)
+{
+    QString fileName = key;
+    fileName.replace(QRegularExpression(QStringLiteral("[\\\\/:*?\"<>|\\s]+")), QStringLiteral("_"));
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+        + "/drafts/" + fileName + ".journal";
+}
@@ -0,0 +1,63 @@
+#ifndef DRAFTJOURNAL_H
+#define DRAFTJOURNAL_H
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QList>
+#include <QString>
+
+/**
+ * @brief 草稿增量日志
+ *
+ * 自动保存不再每次序列化整篇 HTML，而是把两次保存之间的文本改动
+ * （位置、删除长度、插入文本）追加到磁盘日志里；只在检查点写一次压缩的 HTML 快照。
+ * 恢复时读取最后一个快照，再依次重放其后的改动。
+ *
+ * 文件格式（QDataStream）：文件头，之后是若干记录
+ *   'S' 快照：qCompress 后的 HTML（之前的记录全部作废）
+ *   'D' 改动：qint32 位置、qint32 删除长度、QString 插入文本
+ * 进程异常退出导致的残缺尾记录在读取时直接忽略。
+ */
+class DraftJournal
+{
+public:
+    struct Splice {
+        int position = 0;
+        int removed = 0;
+        QString text;
+    };
+
+    explicit DraftJournal(const QString &filePath = QString());
+
+    void setFilePath(const QString &filePath);
+    const QString &filePath() const { return m_filePath; }
+
+    bool exists() const;
+    QDateTime lastModified() const;
+    qint64 fileSize() const;
+
+    // 记录一次改动（先缓存在内存，flush 时追加到文件）
+    void recordSplice(int position, int removed, const QString &text);
+    bool hasPendingSplices() const { return !m_pending.isEmpty(); }
+
+    // 重写日志：只包含一个快照，清空缓存的改动
+    bool writeSnapshot(const QString &html);
+
+    // 把缓存的改动追加到日志
+    bool flush();
+
+    // 读取最后一个快照及其后的改动
+    bool read(QString *html, QList<Splice> *splices) const;
+
+    // 删除日志文件并清空缓存
+    void remove();
+
+    // 默认草稿目录下的日志路径
+    static QString pathForKey(const QString &key);
+
+private:
+    QString m_filePath;
+    QList<Splice> m_pending;
+};
+
+#endif // DRAFTJOURNAL_H
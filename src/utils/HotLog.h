@@ -0,0 +1,22 @@
+#ifndef HOTLOG_H
+#define HOTLOG_H
+
+#include <QDebug>
+
+/**
+ * @brief 热路径日志的编译期开关
+ *
+ * 流式回调、逐块渲染等每秒触发几十次的位置用 HOT_DEBUG() 代替 qDebug()。
+ * 默认展开为永不执行的语句，参数不会求值（日志文件处理器也不会被调用）；
+ * 排查问题时用 cmake -DAI_HOT_PATH_LOGGING=ON 重新配置即可恢复输出。
+ *
+ * 用法与 qDebug() 相同：
+ *   HOT_DEBUG() << "[ChatWidget] chunk length:" << text.length();
+ */
+#if defined(AI_HOT_PATH_LOGGING) && AI_HOT_PATH_LOGGING
+#define HOT_DEBUG() qDebug()
+#else
+#define HOT_DEBUG() while (false) qDebug()
+#endif
+
+#endif // HOTLOG_H
@@ -1,8 +1,296 @@
 #include "MarkdownRenderer.h"
-#include <QRegularExpression>
 #include <QTextDocument>
 #include <QDebug>
 
+namespace {
+
+const QLatin1String kWrapperOpen(
+    "<div style=\"line-height: 1.75; font-size: 15px; color: #2d3748; letter-spacing: 0.2px;\">");
+const QLatin1String kParagraphOpen("<p style=\"margin: 14px 0; line-height: 1.75;\">");
+const QLatin1String kOrderedListOpen("<ol style=\"margin: 8px 0; padding-left: 20px;\">");
+const QLatin1String kUnorderedListOpen("<ul style=\"margin: 8px 0; padding-left: 20px;\">");
+const QLatin1String kQuoteOpen(
+    "<blockquote style=\"border-left: 4px solid #dfe2e5; padding-left: 16px; margin: 8px 0; color: #6a737d;\">");
+const QLatin1String kHorizontalRule(
+    "<hr style=\"border: none; border-top: 1px solid #e1e4e8; margin: 16px 0;\">");
+const QLatin1String kTableOpen(
+    "<table style=\"border-collapse: collapse; margin: 12px 0; width: 100%;\"><thead><tr>");
+const QLatin1String kHeaderCellOpen(
+    "<th style=\"border: 1px solid #dfe2e5; padding: 8px 12px; background-color: #f6f8fa; font-weight: 600;");
+const QLatin1String kCellOpen("<td style=\"border: 1px solid #dfe2e5; padding: 8px 12px;");
+// 公式原样输出 TeX 源码，只给出区分于正文的字体
+const QLatin1String kMathBlockOpen(
+    "<p style=\"margin: 12px 0; text-align: center; white-space: pre-wrap; "
+    "font-family: 'Times New Roman', serif;\">");
+const QLatin1String kMathInlineOpen(
+    "<span style=\"font-family: 'Times New Roman', serif; font-style: italic;\">");
+
+inline bool isBlankChar(QChar c)
+{
+    return c == QLatin1Char(' ') || c == QLatin1Char('\t');
+}
+
+inline bool isAsciiPunct(QChar c)
+{
+    const ushort u = c.unicode();
+    return (u >= '!' && u <= '/') || (u >= ':' && u <= '@')
+        || (u >= '[' && u <= '`') || (u >= '{' && u <= '~');
+}
+
+// 读取 pos 起的一行，[begin, end) 不含换行符与行尾 \r，返回下一行行首
+inline int readLine(const QChar *s, int pos, int n, int &begin, int &end)
+{
+    int i = pos;
+    while (i < n && s[i] != QLatin1Char('\n')) {
+        ++i;
+    }
+    begin = pos;
+    end = i;
+    if (end > begin && s[end - 1] == QLatin1Char('\r')) {
+        --end;
+    }
+    return i < n ? i + 1 : n;
+}
+
+inline void trimRange(const QChar *s, int &begin, int &end)
+{
+    while (begin < end && s[begin].isSpace()) {
+        ++begin;
+    }
+    while (end > begin && s[end - 1].isSpace()) {
+        --end;
+    }
+}
+
+inline int leadingSpaces(const QChar *s, int begin, int end)
+{
+    int width = 0;
+    for (int i = begin; i < end && isBlankChar(s[i]); ++i) {
+        width += s[i] == QLatin1Char('\t') ? 4 : 1;
+    }
+    return width;
+}
+
+inline bool startsWith(const QChar *s, int begin, int end, const char *prefix)
+{
+    for (int i = 0; prefix[i]; ++i) {
+        if (begin + i >= end || s[begin + i] != QLatin1Char(prefix[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// HTML 转义后追加；按不需转义的连续片段整段拷贝
+void appendEscaped(QString &out, const QChar *s, int begin, int end)
+{
+    int run = begin;
+    for (int i = begin; i < end; ++i) {
+        const char *entity;
+        switch (s[i].unicode()) {
+        case '&': entity = "&amp;"; break;
+        case '<': entity = "&lt;"; break;
+        case '>': entity = "&gt;"; break;
+        case '"': entity = "&quot;"; break;
+        case '\r': entity = ""; break;
+        default: continue;
+        }
+        out.append(s + run, i - run);
+        out += QLatin1String(entity);
+        run = i + 1;
+    }
+    out.append(s + run, end - run);
+}
+
+/**
+ * 某个字符“下一次出现位置”的缓存。
+ * 行内扫描的查找起点单调递增，缓存命中时不再重复扫描，
+ * 未闭合的分隔符（如一长串没有 ] 的 [）也只会让该行被扫描一遍。
+ */
+struct NextCharCache
+{
+    int from = -1;
+    int pos = -1;
+
+    int find(const QChar *s, int start, int end, QChar c)
+    {
+        if (from >= 0 && from <= start && (pos < 0 || pos >= start)) {
+            return pos;
+        }
+        from = start;
+        pos = -1;
+        for (int i = start; i < end; ++i) {
+            if (s[i] == c) {
+                pos = i;
+                break;
+            }
+        }
+        return pos;
+    }
+};
+
+// 查找长度恰为 ticks 的反引号串
+int findBacktickRun(const QChar *s, int from, int end, int ticks, NextCharCache &cache)
+{
+    while (from < end) {
+        const int p = cache.find(s, from, end, QLatin1Char('`'));
+        if (p < 0) {
+            return -1;
+        }
+        int run = 1;
+        while (p + run < end && s[p + run] == QLatin1Char('`')) {
+            ++run;
+        }
+        if (run == ticks) {
+            return p;
+        }
+        from = p + run;
+    }
+    return -1;
+}
+
+int findDoubleChar(const QChar *s, int from, int end, QChar c, NextCharCache &cache)
+{
+    while (from < end) {
+        const int p = cache.find(s, from, end, c);
+        if (p < 0 || p + 1 >= end) {
+            return -1;
+        }
+        if (s[p + 1] == c) {
+            return p;
+        }
+        from = p + 1;
+    }
+    return -1;
+}
+
+bool matchHeading(const QChar *s, int begin, int end, int &level, int &contentBegin)
+{
+    int count = 0;
+    while (begin + count < end && s[begin + count] == QLatin1Char('#')) {
+        ++count;
+    }
+    if (count == 0 || count > 6 || begin + count >= end || s[begin + count] != QLatin1Char(' ')) {
+        return false;
+    }
+    level = count;
+    contentBegin = begin + count + 1;
+    return true;
+}
+
+bool isThematicBreak(const QChar *s, int begin, int end)
+{
+    const QChar marker = s[begin];
+    if (marker != QLatin1Char('-') && marker != QLatin1Char('*') && marker != QLatin1Char('_')) {
+        return false;
+    }
+    int count = 0;
+    for (int i = begin; i < end; ++i) {
+        if (s[i] == marker) {
+            ++count;
+        } else if (!isBlankChar(s[i])) {
+            return false;
+        }
+    }
+    return count >= 3;
+}
+
+bool matchListMarker(const QChar *s, int begin, int end, bool &ordered, int &contentBegin)
+{
+    int i = begin;
+    while (i < end && isBlankChar(s[i])) {
+        ++i;
+    }
+    if (i + 1 < end && (s[i] == QLatin1Char('-') || s[i] == QLatin1Char('*') || s[i] == QLatin1Char('+'))
+        && s[i + 1] == QLatin1Char(' ')) {
+        ordered = false;
+        contentBegin = i + 2;
+    } else {
+        int digits = 0;
+        while (i + digits < end && digits < 10 && s[i + digits].isDigit()) {
+            ++digits;
+        }
+        const int marker = i + digits;
+        if (digits == 0 || marker + 1 >= end
+            || (s[marker] != QLatin1Char('.') && s[marker] != QLatin1Char(')'))
+            || !isBlankChar(s[marker + 1])) {
+            return false;
+        }
+        ordered = true;
+        contentBegin = marker + 2;
+    }
+    while (contentBegin < end && isBlankChar(s[contentBegin])) {
+        ++contentBegin;
+    }
+    return true;
+}
+
+bool matchFence(const QChar *s, int begin, int end, QChar &fenceChar, int &fenceLength)
+{
+    if (begin >= end || (s[begin] != QLatin1Char('`') && s[begin] != QLatin1Char('~'))) {
+        return false;
+    }
+    int count = 0;
+    while (begin + count < end && s[begin + count] == s[begin]) {
+        ++count;
+    }
+    if (count < 3) {
+        return false;
+    }
+    fenceChar = s[begin];
+    fenceLength = count;
+    return true;
+}
+
+bool parseTableDelimiter(const QChar *s, int begin, int end, QVector<Qt::Alignment> &alignments)
+{
+    trimRange(s, begin, end);
+    if (begin >= end) {
+        return false;
+    }
+    bool hasDash = false;
+    for (int i = begin; i < end; ++i) {
+        const QChar c = s[i];
+        if (c == QLatin1Char('-')) {
+            hasDash = true;
+        } else if (c != QLatin1Char('|') && c != QLatin1Char(':') && !isBlankChar(c)) {
+            return false;
+        }
+    }
+    if (!hasDash) {
+        return false;
+    }
+
+    if (s[begin] == QLatin1Char('|')) {
+        ++begin;
+    }
+    if (end > begin && s[end - 1] == QLatin1Char('|')) {
+        --end;
+    }
+    int cellBegin = begin;
+    for (int i = begin; i <= end; ++i) {
+        if (i < end && s[i] != QLatin1Char('|')) {
+            continue;
+        }
+        int cb = cellBegin;
+        int ce = i;
+        trimRange(s, cb, ce);
+        const bool left = cb < ce && s[cb] == QLatin1Char(':');
+        const bool right = cb < ce && s[ce - 1] == QLatin1Char(':');
+        if (left && right) {
+            alignments.append(Qt::AlignHCenter);
+        } else if (right) {
+            alignments.append(Qt::AlignRight);
+        } else {
+            alignments.append(Qt::AlignLeft);
+        }
+        cellBegin = i + 1;
+    }
+    return true;
+}
+
+} // namespace
+
 MarkdownRenderer::MarkdownRenderer()
     : m_codeBackgroundColor("#f8f5f0")   // 暖色调代码背景
     , m_codeTextColor("#B71C1C")          // 思政红代码文字
@@ -15,6 +303,8 @@ MarkdownRenderer::MarkdownRenderer()
     m_headingColors[4] = QColor("#4a5568"); // H4
     m_headingColors[5] = QColor("#718096"); // H5
     m_headingColors[6] = QColor("#718096"); // H6 - 最浅
+
+    updateStyleCache();
 }
 
 MarkdownRenderer::~MarkdownRenderer()
@@ -27,23 +317,18 @@ QString MarkdownRenderer::renderToHtml(const QString &markdown)
         return QString();
     }
 
-    RenderData data;
-    processMarkdown(markdown, data);
-
     // 用 div 包裹，优化行高和段落间距以提升阅读体验
-    QString wrappedHtml = QString(
-        "<div style=\"line-height: 1.75; font-size: 15px; color: #2d3748; letter-spacing: 0.2px;\">"
-        "%1"
-        "</div>"
-    ).arg(data.html);
-
-    return wrappedHtml;
+    QString html;
+    html.reserve(markdown.size() * 2 + 256);
+    html += kWrapperOpen;
+    renderBlocks(markdown, html);
+    html += QLatin1String("</div>");
+    return html;
 }
 
 QTextDocument* MarkdownRenderer::renderToDocument(const QString &markdown)
 {
     QTextDocument *doc = new QTextDocument();
-    QString html = renderToHtml(markdown);
 
     // 设置基础样式
     QString fullHtml = QString("<!DOCTYPE html>"
@@ -61,12 +346,19 @@ QTextDocument* MarkdownRenderer::renderToDocument(const QString &markdown)
                              "blockquote { border-left: 4px solid #dfe2e5; padding-left: 16px; margin: 8px 0; color: #6a737d; }"
                              "</style>"
                              "</head>"
-                             "<body>%4</body>"
-                             "</html>")
+                             "<body>")
                              .arg(m_codeBackgroundColor.name())
                              .arg(m_codeTextColor.name())
-                             .arg(m_linkColor.name())
-                             .arg(html);
+                             .arg(m_linkColor.name());
+
+    // 正文直接追加到同一缓冲区
+    fullHtml.reserve(fullHtml.size() + markdown.size() * 2 + 256);
+    if (!markdown.isEmpty()) {
+        fullHtml += kWrapperOpen;
+        renderBlocks(markdown, fullHtml);
+        fullHtml += QLatin1String("</div>");
+    }
+    fullHtml += QLatin1String("</body></html>");
 
     doc->setHtml(fullHtml);
     return doc;
@@ -76,409 +368,558 @@ void MarkdownRenderer::setCodeTheme(const QColor &backgroundColor, const QColor
 {
     m_codeBackgroundColor = backgroundColor;
     m_codeTextColor = textColor;
+    updateStyleCache();
 }
 
 void MarkdownRenderer::setLinkColor(const QColor &color)
 {
     m_linkColor = color;
+    updateStyleCache();
 }
 
 void MarkdownRenderer::setHeadingColor(int level, const QColor &color)
 {
     if (level >= 1 && level <= 6) {
         m_headingColors[level] = color;
+        updateStyleCache();
     }
 }
 
-void MarkdownRenderer::processMarkdown(const QString &markdown, RenderData &data)
+void MarkdownRenderer::updateStyleCache()
 {
-    QStringList lines = markdown.split('\n');
-    QString codeBlockLanguage;
-    bool inParagraph = false;
-    bool inList = false;
-    bool listIsOrdered = false;
+    const QString monoFont =
+        "font-family: 'SFMono-Regular', Consolas, 'Liberation Mono', Menlo, monospace;";
 
-    auto closeParagraph = [&]() {
-        if (inParagraph) {
-            data.html += "</p>";
-            inParagraph = false;
-        }
-    };
+    m_inlineCodeOpen = QString("<code style=\"background-color: %1; color: %2; padding: 2px 4px; border-radius: 3px; %3\">")
+                           .arg(m_codeBackgroundColor.name(), m_codeTextColor.name(), monoFont);
+    m_codeBlockOpen = QString("<pre style=\"background-color: %1; color: %2; padding: 12px; border-radius: 6px; %3 white-space: pre-wrap; margin: 8px 0;\">")
+                          .arg(m_codeBackgroundColor.name(), m_codeTextColor.name(), monoFont);
+    // 紧跟在 href 值之后
+    m_linkStyleAttr = QString("\" style=\"color: %1; text-decoration: none;\" target=\"_blank\">")
+                          .arg(m_linkColor.name());
 
-    auto closeList = [&]() {
-        if (inList) {
-            data.html += listIsOrdered ? "</ol>" : "</ul>";
-            inList = false;
-        }
+    // 增强标题层级差异，提升视觉区分度
+    static const char *const headingMetrics[7] = {
+        "",
+        "font-size: 22px; font-weight: 700; margin: 24px 0 14px 0;",
+        "font-size: 19px; font-weight: 600; margin: 20px 0 12px 0;",
+        "font-size: 17px; font-weight: 600; margin: 18px 0 10px 0;",
+        "font-size: 15px; font-weight: 600; margin: 16px 0 8px 0;",
+        "font-size: 14px; font-weight: 600; margin: 14px 0 6px 0;",
+        "font-size: 13px; font-weight: 600; margin: 12px 0 6px 0;"
     };
+    for (int level = 1; level <= 6; ++level) {
+        const QColor color = m_headingColors.value(level, QColor("#2d3748"));
+        m_headingOpen[level] = QString("<h%1 style=\"color: %2; %3\">")
+                                   .arg(level)
+                                   .arg(color.name(), QLatin1String(headingMetrics[level]));
+    }
+}
 
-    for (int i = 0; i < lines.size(); ++i) {
-        QString line = lines[i];
-        bool lineProcessed = false;
-
-        // 处理代码块
-        if (data.inCodeBlock) {
-            if (isCodeBlockEnd(line)) {
-                data.html += generateHtmlForCodeBlock(data.currentText);
-                data.currentText.clear();
-                data.inCodeBlock = false;
-                codeBlockLanguage.clear();
-                lineProcessed = true;
-            } else {
-                data.currentText += line + "\n";
-                lineProcessed = true;
-            }
-        } else if (isCodeBlockStart(line, codeBlockLanguage)) {
-            closeParagraph();
-            closeList();
-            data.inCodeBlock = true;
-            data.currentText.clear();
-            lineProcessed = true;
-        }
-
-        // 如果不是代码块内的内容，继续其他处理
-        if (!lineProcessed && !data.inCodeBlock) {
-            // 处理空行
-            if (line.trimmed().isEmpty()) {
-                closeParagraph();
-                closeList();
-                continue;
-            }
+void MarkdownRenderer::appendListItemOpen(bool isOrdered, int level, QString &out) const
+{
+    // 增加列表项间距，提升阅读舒适度；缩进层级只体现在左边距上
+    out += isOrdered ? QLatin1String("<li style=\"")
+                     : QLatin1String("<li style=\"list-style-type: disc; ");
+    out += QLatin1String("margin: 6px 0; padding-left: ");
+    out += QString::number(level * 20);
+    out += QLatin1String("px; line-height: 1.65;\">");
+}
 
-            // 处理标题
-            int headingLevel;
-            if (isHeaderLine(line, headingLevel)) {
-                closeParagraph();
-                closeList();
-                QString headingText = stripMarkdownMarkers(line);
-                data.html += generateHtmlForHeading(headingText, headingLevel);
-                continue;
-            }
+// ===== 块级扫描 =====
 
-            // 处理列表
-            QString listContent;
-            bool isOrdered = isOrderedListLine(line, listContent);
-            bool isUnordered = !isOrdered && isUnorderedListLine(line, listContent);
+void MarkdownRenderer::renderBlocks(const QString &markdown, QString &out) const
+{
+    const QChar *s = markdown.constData();
+    const int n = markdown.size();
+
+    enum class OpenBlock { None, Paragraph, List, Quote };
+    OpenBlock open = OpenBlock::None;
+    bool listOrdered = false;
+
+    auto closeBlock = [&]() {
+        switch (open) {
+        case OpenBlock::Paragraph:
+            out += QLatin1String("</p>");
+            break;
+        case OpenBlock::List:
+            out += listOrdered ? QLatin1String("</li></ol>") : QLatin1String("</li></ul>");
+            break;
+        case OpenBlock::Quote:
+            out += QLatin1String("</blockquote>");
+            break;
+        case OpenBlock::None:
+            break;
+        }
+        open = OpenBlock::None;
+    };
 
-            if (isOrdered || isUnordered) {
-                closeParagraph();
+    int pos = 0;
+    while (pos < n) {
+        int begin = 0;
+        int end = 0;
+        const int next = readLine(s, pos, n, begin, end);
+        int tb = begin;
+        int te = end;
+        trimRange(s, tb, te);
+
+        // 空行：结束段落/列表/引用
+        if (tb == te) {
+            closeBlock();
+            pos = next;
+            continue;
+        }
 
-                if (!inList || listIsOrdered != isOrdered) {
-                    closeList();
-                    listIsOrdered = isOrdered;
-                    data.html += listIsOrdered ? "<ol style=\"margin: 8px 0; padding-left: 20px;\">" : "<ul style=\"margin: 8px 0; padding-left: 20px;\">";
-                    inList = true;
+        const int indent = leadingSpaces(s, begin, end);
+
+        // 围栏代码块：内容原样转义输出
+        QChar fenceChar;
+        int fenceLength = 0;
+        if (indent < 4 && matchFence(s, tb, te, fenceChar, fenceLength)) {
+            closeBlock();
+            int codeBegin = next;
+            int codeEnd = n;
+            pos = n;
+            for (int p = next; p < n;) {
+                int lb = 0;
+                int le = 0;
+                const int lineNext = readLine(s, p, n, lb, le);
+                int fb = lb;
+                int fe = le;
+                trimRange(s, fb, fe);
+                QChar closeChar;
+                int closeLength = 0;
+                if (matchFence(s, fb, fe, closeChar, closeLength)
+                    && closeChar == fenceChar && closeLength >= fenceLength) {
+                    codeEnd = lb;
+                    pos = lineNext;
+                    break;
                 }
-                data.html += generateHtmlForListItem(listContent, isOrdered, 1);
-                continue;
+                p = lineNext;
             }
-
-            // 处理水平分割线 (---, ***, ___)
-            QString trimmedLine = line.trimmed();
-            if ((trimmedLine.startsWith("---") && trimmedLine.count('-') >= 3 && trimmedLine.count(QRegularExpression("[^-\\s]")) == 0) ||
-                (trimmedLine.startsWith("***") && trimmedLine.count('*') >= 3 && trimmedLine.count(QRegularExpression("[^*\\s]")) == 0) ||
-                (trimmedLine.startsWith("___") && trimmedLine.count('_') >= 3 && trimmedLine.count(QRegularExpression("[^_\\s]")) == 0)) {
-                closeParagraph();
-                closeList();
-                data.html += "<hr style=\"border: none; border-top: 1px solid #e1e4e8; margin: 16px 0;\">";
-                continue;
+            // 去掉首尾空行，保留首行缩进
+            while (codeBegin < codeEnd && (s[codeBegin] == QLatin1Char('\n') || s[codeBegin] == QLatin1Char('\r'))) {
+                ++codeBegin;
+            }
+            while (codeEnd > codeBegin && s[codeEnd - 1].isSpace()) {
+                --codeEnd;
             }
+            out += m_codeBlockOpen;
+            appendEscaped(out, s, codeBegin, codeEnd);
+            out += QLatin1String("</pre>");
+            continue;
+        }
 
-            // 处理表格
-            if (line.contains('|') && line.trimmed().startsWith('|')) {
-                closeParagraph();
-                closeList();
-                
-                // 开始表格
-                data.html += "<table style=\"border-collapse: collapse; margin: 12px 0; width: 100%;\">";
-                
-                // 解析表头
-                QStringList cells = line.split('|', Qt::SkipEmptyParts);
-                data.html += "<thead><tr>";
-                for (const QString &cell : cells) {
-                    QString cellContent = cell.trimmed();
-                    processInlineFormatting(cellContent, data);
-                    data.html += QString("<th style=\"border: 1px solid #dfe2e5; padding: 8px 12px; background-color: #f6f8fa; font-weight: 600;\">%1</th>").arg(cellContent);
-                }
-                data.html += "</tr></thead><tbody>";
-                
-                // 跳过分隔行 (|---|---|)
-                if (i + 1 < lines.size() && lines[i + 1].contains("---")) {
-                    i++;
-                }
-                
-                // 解析表格内容行
-                while (i + 1 < lines.size()) {
-                    QString nextLine = lines[i + 1];
-                    if (!nextLine.contains('|') || nextLine.trimmed().isEmpty()) {
-                        break;
+        // 公式块 $$ ... $$：原样透传
+        if (startsWith(s, tb, te, "$$")) {
+            closeBlock();
+            int mathEnd = te;
+            pos = next;
+            const bool singleLine = te - tb >= 4
+                && s[te - 1] == QLatin1Char('$') && s[te - 2] == QLatin1Char('$');
+            if (!singleLine) {
+                for (int p = next; p < n;) {
+                    int lb = 0;
+                    int le = 0;
+                    pos = readLine(s, p, n, lb, le);
+                    trimRange(s, lb, le);
+                    if (lb < le) {
+                        mathEnd = le;
                     }
-                    i++;
-                    
-                    QStringList rowCells = nextLine.split('|', Qt::SkipEmptyParts);
-                    data.html += "<tr>";
-                    for (const QString &cell : rowCells) {
-                        QString cellContent = cell.trimmed();
-                        processInlineFormatting(cellContent, data);
-                        data.html += QString("<td style=\"border: 1px solid #dfe2e5; padding: 8px 12px;\">%1</td>").arg(cellContent);
+                    if (le - lb >= 2 && s[le - 1] == QLatin1Char('$') && s[le - 2] == QLatin1Char('$')) {
+                        break;
                     }
-                    data.html += "</tr>";
+                    p = pos;
                 }
-                
-                data.html += "</tbody></table>";
-                continue;
             }
+            out += kMathBlockOpen;
+            appendEscaped(out, s, tb, mathEnd);
+            out += QLatin1String("</p>");
+            continue;
+        }
 
-            // 处理引用块
-            if (line.startsWith("> ")) {
-                closeParagraph();
-                closeList();
-                QString quoteText = line.mid(2);
-                processInlineFormatting(quoteText, data);
-                data.html += "<blockquote style=\"border-left: 4px solid #dfe2e5; padding-left: 16px; margin: 8px 0; color: #6a737d;\">" + quoteText + "</blockquote>";
-                continue;
+        // 标题
+        int level = 0;
+        int headingBegin = 0;
+        if (matchHeading(s, begin, end, level, headingBegin)) {
+            closeBlock();
+            int headingEnd = te;
+            // 去掉可选的结尾 #（前面须有空格，避免误伤 "C#"）
+            int k = headingEnd;
+            while (k > headingBegin && s[k - 1] == QLatin1Char('#')) {
+                --k;
+            }
+            if (k < headingEnd && (k == headingBegin || isBlankChar(s[k - 1]))) {
+                headingEnd = k;
             }
+            trimRange(s, headingBegin, headingEnd);
+            out += m_headingOpen[level];
+            renderInline(s, headingBegin, headingEnd, out);
+            out += QLatin1String("</h");
+            out += QLatin1Char(char('0' + level));
+            out += QLatin1Char('>');
+            pos = next;
+            continue;
+        }
+
+        // 水平分割线 (---, ***, ___)
+        if (indent < 4 && isThematicBreak(s, tb, te)) {
+            closeBlock();
+            out += kHorizontalRule;
+            pos = next;
+            continue;
+        }
 
-            // 处理普通文本段落
-            closeList();
-            if (!inParagraph) {
-                data.html += "<p style=\"margin: 14px 0; line-height: 1.75;\">";
-                inParagraph = true;
+        // 列表
+        bool ordered = false;
+        int itemBegin = 0;
+        if (matchListMarker(s, begin, end, ordered, itemBegin)) {
+            if (open == OpenBlock::List && listOrdered == ordered) {
+                out += QLatin1String("</li>");
             } else {
-                // 段落内的换行使用 <br>
-                data.html += "<br>";
+                closeBlock();
+                listOrdered = ordered;
+                out += ordered ? kOrderedListOpen : kUnorderedListOpen;
+                open = OpenBlock::List;
             }
+            appendListItemOpen(ordered, qMin(1 + indent / 2, 4), out);
+            renderInline(s, itemBegin, te, out);
+            pos = next;
+            continue;
+        }
 
-            QString processedLine = line;
-            processInlineFormatting(processedLine, data);
-            data.html += processedLine;
+        // 列表项的缩进续行
+        if (open == OpenBlock::List && indent >= 2) {
+            out += QLatin1String("<br>");
+            renderInline(s, tb, te, out);
+            pos = next;
+            continue;
         }
-    }
 
-    // 结束未关闭的段落
-    if (inParagraph) {
-        data.html += "</p>";
-    }
+        // 表格
+        if (s[tb] == QLatin1Char('|')) {
+            closeBlock();
+            pos = renderTable(s, pos, n, out);
+            continue;
+        }
 
-    // 结束未关闭的列表
-    if (inList) {
-        data.html += listIsOrdered ? "</ol>" : "</ul>";
-    }
+        // 引用块：连续的引用行合并为一个 blockquote
+        if (s[tb] == QLatin1Char('>') && indent < 4) {
+            int quoteBegin = tb + 1;
+            if (quoteBegin < te && s[quoteBegin] == QLatin1Char(' ')) {
+                ++quoteBegin;
+            }
+            if (open == OpenBlock::Quote) {
+                out += QLatin1String("<br>");
+            } else {
+                closeBlock();
+                out += kQuoteOpen;
+                open = OpenBlock::Quote;
+            }
+            renderInline(s, quoteBegin, te, out);
+            pos = next;
+            continue;
+        }
 
-    // 结束未关闭的代码块
-    if (data.inCodeBlock) {
-        data.html += generateHtmlForCodeBlock(data.currentText);
+        // 普通文本段落
+        if (open == OpenBlock::Paragraph) {
+            // 段落内的换行使用 <br>
+            out += QLatin1String("<br>");
+        } else {
+            closeBlock();
+            out += kParagraphOpen;
+            open = OpenBlock::Paragraph;
+        }
+        renderInline(s, tb, te, out);
+        pos = next;
     }
-}
 
-void MarkdownRenderer::processInlineFormatting(QString &text, RenderData &data)
-{
-    text = escapeHtml(text);
-
-    // 处理行内代码
-    static const QRegularExpression inlineCodeRegex("`([^`]+)`");
-    QRegularExpressionMatchIterator it = inlineCodeRegex.globalMatch(text);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString codeText = match.captured(1);
-        text.replace(match.captured(0), generateHtmlForInlineCode(codeText));
-    }
-
-    // 处理粗体
-    static const QRegularExpression boldRegex("\\*\\*([^\\*]+)\\*\\*");
-    it = boldRegex.globalMatch(text);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString boldText = match.captured(1);
-        text.replace(match.captured(0), "<strong>" + boldText + "</strong>");
-    }
-
-    // 处理斜体
-    static const QRegularExpression italicRegex("\\*([^\\*]+)\\*");
-    it = italicRegex.globalMatch(text);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString italicText = match.captured(1);
-        text.replace(match.captured(0), "<em>" + italicText + "</em>");
-    }
-
-    // 处理删除线
-    static const QRegularExpression strikethroughRegex("~~([^~]+)~~");
-    it = strikethroughRegex.globalMatch(text);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString strikeText = match.captured(1);
-        text.replace(match.captured(0), "<del>" + strikeText + "</del>");
-    }
-
-    // 处理链接
-    processLinks(text, data);
+    closeBlock();
 }
 
-void MarkdownRenderer::processLinks(QString &text, RenderData &/*data*/)
+int MarkdownRenderer::renderTable(const QChar *s, int pos, int n, QString &out) const
 {
-    static const QRegularExpression linkRegex("\\[([^\\]]+)\\]\\(([^\\)]+)\\)");
-    QRegularExpressionMatchIterator it = linkRegex.globalMatch(text);
-    while (it.hasNext()) {
-        QRegularExpressionMatch match = it.next();
-        QString linkText = match.captured(1);
-        QString linkUrl = match.captured(2);
-        text.replace(match.captured(0), generateHtmlForLink(linkText, linkUrl));
+    int headerBegin = 0;
+    int headerEnd = 0;
+    int next = readLine(s, pos, n, headerBegin, headerEnd);
+
+    // 分隔行 (|---|:---:|) 决定列对齐
+    QVector<Qt::Alignment> alignments;
+    if (next < n) {
+        int db = 0;
+        int de = 0;
+        const int afterDelimiter = readLine(s, next, n, db, de);
+        if (parseTableDelimiter(s, db, de, alignments)) {
+            next = afterDelimiter;
+        }
     }
-}
 
-QString MarkdownRenderer::escapeHtml(const QString &text) const
-{
-    QString escaped = text;
-    escaped.replace("&", "&amp;");
-    escaped.replace("<", "&lt;");
-    escaped.replace(">", "&gt;");
-    escaped.replace("\"", "&quot;");
-    return escaped;
-}
-
-QString MarkdownRenderer::generateHtmlForHeading(const QString &text, int level) const
-{
-    QColor color = m_headingColors.value(level, QColor("#2d3748"));
-    QString colorStyle = QString("color: %1;").arg(color.name());
-    QString fontSize;
-    QString marginStyle;
-
-    // 增强标题层级差异，提升视觉区分度
-    switch (level) {
-    case 1:
-        fontSize = "22px; font-weight: 700;";
-        marginStyle = "margin: 24px 0 14px 0;";
-        break;
-    case 2:
-        fontSize = "19px; font-weight: 600;";
-        marginStyle = "margin: 20px 0 12px 0;";
-        break;
-    case 3:
-        fontSize = "17px; font-weight: 600;";
-        marginStyle = "margin: 18px 0 10px 0;";
-        break;
-    case 4:
-        fontSize = "15px; font-weight: 600;";
-        marginStyle = "margin: 16px 0 8px 0;";
-        break;
-    case 5:
-        fontSize = "14px; font-weight: 600;";
-        marginStyle = "margin: 14px 0 6px 0;";
-        break;
-    case 6:
-        fontSize = "13px; font-weight: 600;";
-        marginStyle = "margin: 12px 0 6px 0;";
-        break;
-    default:
-        fontSize = "15px; font-weight: 600;";
-        marginStyle = "margin: 16px 0 8px 0;";
-        break;
-    }
-
-    QString style = colorStyle + " font-size: " + fontSize + " " + marginStyle;
-    return QString("<h%1 style=\"%2\">%3</h%1>").arg(level).arg(style).arg(text);
-}
+    out += kTableOpen;
+    renderTableRow(s, headerBegin, headerEnd, true, alignments, out);
+    out += QLatin1String("</tr></thead><tbody>");
+
+    pos = next;
+    while (pos < n) {
+        int begin = 0;
+        int end = 0;
+        const int rowNext = readLine(s, pos, n, begin, end);
+        int tb = begin;
+        int te = end;
+        trimRange(s, tb, te);
+        bool hasPipe = false;
+        for (int i = tb; i < te && !hasPipe; ++i) {
+            hasPipe = s[i] == QLatin1Char('|');
+        }
+        if (!hasPipe) {
+            break;
+        }
+        out += QLatin1String("<tr>");
+        renderTableRow(s, tb, te, false, alignments, out);
+        out += QLatin1String("</tr>");
+        pos = rowNext;
+    }
 
-QString MarkdownRenderer::generateHtmlForCodeBlock(const QString &text) const
-{
-    QString escapedText = escapeHtml(text.trimmed());
-    QString style = QString("background-color: %1; color: %2; padding: 12px; border-radius: 6px; font-family: 'SFMono-Regular', Consolas, 'Liberation Mono', Menlo, monospace; white-space: pre-wrap; margin: 8px 0;")
-                     .arg(m_codeBackgroundColor.name())
-                     .arg(m_codeTextColor.name());
-    return QString("<pre style=\"%1\">%2</pre>").arg(style).arg(escapedText);
+    out += QLatin1String("</tbody></table>");
+    return pos;
 }
 
-QString MarkdownRenderer::generateHtmlForInlineCode(const QString &text) const
+void MarkdownRenderer::renderTableRow(const QChar *s, int begin, int end, bool header,
+                                      const QVector<Qt::Alignment> &alignments, QString &out) const
 {
-    QString style = QString("background-color: %1; color: %2; padding: 2px 4px; border-radius: 3px; font-family: 'SFMono-Regular', Consolas, 'Liberation Mono', Menlo, monospace;")
-                     .arg(m_codeBackgroundColor.name())
-                     .arg(m_codeTextColor.name());
-    return QString("<code style=\"%1\">%2</code>").arg(style).arg(text);
-}
+    trimRange(s, begin, end);
+    if (begin < end && s[begin] == QLatin1Char('|')) {
+        ++begin;
+    }
+    if (end > begin && s[end - 1] == QLatin1Char('|')
+        && !(end - 2 >= begin && s[end - 2] == QLatin1Char('\\'))) {
+        --end;
+    }
 
-QString MarkdownRenderer::generateHtmlForLink(const QString &text, const QString &url) const
-{
-    QString style = QString("color: %1; text-decoration: none;").arg(m_linkColor.name());
-    return QString("<a href=\"%1\" style=\"%2\" target=\"_blank\">%3</a>").arg(url).arg(style).arg(text);
-}
+    // 按未转义、不在行内代码中的 | 切分单元格
+    int cellBegin = begin;
+    int column = 0;
+    bool inCode = false;
+    for (int i = begin; i <= end; ++i) {
+        if (i < end) {
+            const QChar c = s[i];
+            if (c == QLatin1Char('\\') && i + 1 < end) {
+                ++i;
+                continue;
+            }
+            if (c == QLatin1Char('`')) {
+                inCode = !inCode;
+                continue;
+            }
+            if (c != QLatin1Char('|') || inCode) {
+                continue;
+            }
+        }
 
-QString MarkdownRenderer::generateHtmlForListItem(const QString &text, bool isOrdered, int level) const
-{
-    // 增加列表项间距，提升阅读舒适度
-    QString style = QString("margin: 6px 0; padding-left: %1px; line-height: 1.65;").arg(level * 20);
-    QString processedText = text;
+        int cb = cellBegin;
+        int ce = i;
+        trimRange(s, cb, ce);
 
-    // 处理行内格式
-    RenderData tempData;
-    MarkdownRenderer* tempRenderer = const_cast<MarkdownRenderer*>(this);
-    tempRenderer->processInlineFormatting(processedText, tempData);
+        out += header ? kHeaderCellOpen : kCellOpen;
+        const Qt::Alignment align = column < alignments.size() ? alignments.at(column) : Qt::AlignLeft;
+        if (align == Qt::AlignHCenter) {
+            out += QLatin1String(" text-align: center;");
+        } else if (align == Qt::AlignRight) {
+            out += QLatin1String(" text-align: right;");
+        }
+        out += QLatin1String("\">");
+        renderInline(s, cb, ce, out);
+        out += header ? QLatin1String("</th>") : QLatin1String("</td>");
 
-    if (isOrdered) {
-        return QString("<li style=\"%1\">%2</li>").arg(style).arg(processedText);
-    } else {
-        return QString("<li style=\"list-style-type: disc; %1\">%2</li>").arg(style).arg(processedText);
+        ++column;
+        cellBegin = i + 1;
     }
 }
 
-bool MarkdownRenderer::isHeaderLine(const QString &line, int &level) const
-{
-    int count = 0;
-    for (int i = 0; i < line.length() && line[i] == '#'; ++i) {
-        count++;
-    }
-    if (count > 0 && count <= 6 && count < line.length() && line[count] == ' ') {
-        level = count;
-        return true;
-    }
-    return false;
-}
+// ===== 行内扫描 =====
 
-bool MarkdownRenderer::isOrderedListLine(const QString &line, QString &content) const
+void MarkdownRenderer::renderInline(const QChar *s, int begin, int end, QString &out) const
 {
-    static const QRegularExpression regex(R"(^\s*(\d+)\.\s+(.*))");
-    QRegularExpressionMatch match = regex.match(line);
-    if (match.hasMatch()) {
-        content = match.captured(2);
-        return true;
-    }
-    return false;
-}
+    NextCharCache nextStar;
+    NextCharCache nextTilde;
+    NextCharCache nextTick;
+    NextCharCache nextBracket;
+    NextCharCache nextParen;
+    NextCharCache nextDollar;
+
+    // [text](url)：lb 为 [ 的位置，成功时给出 ] 位置、URL 区间和 ) 之后的位置
+    auto parseLink = [&](int lb, int &rb, int &urlBegin, int &urlEnd, int &after) -> bool {
+        rb = nextBracket.find(s, lb + 1, end, QLatin1Char(']'));
+        if (rb < 0 || rb + 1 >= end || s[rb + 1] != QLatin1Char('(')) {
+            return false;
+        }
+        const int rp = nextParen.find(s, rb + 2, end, QLatin1Char(')'));
+        if (rp < 0) {
+            return false;
+        }
+        urlBegin = rb + 2;
+        urlEnd = rp;
+        trimRange(s, urlBegin, urlEnd);
+        after = rp + 1;
+        return urlBegin < urlEnd;
+    };
 
-bool MarkdownRenderer::isUnorderedListLine(const QString &line, QString &content) const
-{
-    if (line.startsWith("- ") || line.startsWith("* ") || line.startsWith("+ ")) {
-        content = line.mid(2);
-        return true;
-    }
-    return false;
-}
+    int run = begin;  // 尚未输出的普通文本起点
+    int i = begin;
+    while (i < end) {
+        switch (s[i].unicode()) {
+        case '\\':
+            // 反斜杠转义 ASCII 标点
+            if (i + 1 < end && isAsciiPunct(s[i + 1])) {
+                appendEscaped(out, s, run, i);
+                appendEscaped(out, s, i + 1, i + 2);
+                i += 2;
+                run = i;
+                continue;
+            }
+            break;
 
-bool MarkdownRenderer::isCodeBlockStart(const QString &line, QString &language) const
-{
-    if (line.startsWith("```")) {
-        language = line.mid(3).trimmed();
-        return true;
-    }
-    return false;
-}
+        case '`': {
+            // 行内代码：由等长反引号串闭合，内容不做格式处理
+            int ticks = 1;
+            while (i + ticks < end && s[i + ticks] == QLatin1Char('`')) {
+                ++ticks;
+            }
+            const int close = findBacktickRun(s, i + ticks, end, ticks, nextTick);
+            if (close < 0) {
+                i += ticks;
+                continue;
+            }
+            appendEscaped(out, s, run, i);
+            out += m_inlineCodeOpen;
+            appendEscaped(out, s, i + ticks, close);
+            out += QLatin1String("</code>");
+            i = close + ticks;
+            run = i;
+            continue;
+        }
 
-bool MarkdownRenderer::isCodeBlockEnd(const QString &line) const
-{
-    return line.startsWith("```");
-}
+        case '*': {
+            if (i + 1 < end && s[i + 1] == QLatin1Char('*')) {
+                // 粗体：**内容** （内容不含 *）
+                const int close = nextStar.find(s, i + 2, end, QLatin1Char('*'));
+                if (close > i + 2 && close + 1 < end && s[close + 1] == QLatin1Char('*')) {
+                    appendEscaped(out, s, run, i);
+                    out += QLatin1String("<strong>");
+                    renderInline(s, i + 2, close, out);
+                    out += QLatin1String("</strong>");
+                    i = close + 2;
+                    run = i;
+                    continue;
+                }
+                i += 2;
+                continue;
+            }
+            // 斜体：*内容*，两侧紧贴非空白，避免 "a * b * c" 被误判
+            const int close = nextStar.find(s, i + 1, end, QLatin1Char('*'));
+            if (close > i + 1 && !s[i + 1].isSpace() && !s[close - 1].isSpace()) {
+                appendEscaped(out, s, run, i);
+                out += QLatin1String("<em>");
+                renderInline(s, i + 1, close, out);
+                out += QLatin1String("</em>");
+                i = close + 1;
+                run = i;
+                continue;
+            }
+            break;
+        }
 
-QString MarkdownRenderer::stripMarkdownMarkers(const QString &text) const
-{
-    QString result = text;
+        case '~':
+            // 删除线：~~内容~~
+            if (i + 1 < end && s[i + 1] == QLatin1Char('~')) {
+                const int close = findDoubleChar(s, i + 2, end, QLatin1Char('~'), nextTilde);
+                if (close > i + 2) {
+                    appendEscaped(out, s, run, i);
+                    out += QLatin1String("<del>");
+                    renderInline(s, i + 2, close, out);
+                    out += QLatin1String("</del>");
+                    i = close + 2;
+                    run = i;
+                    continue;
+                }
+                i += 2;
+                continue;
+            }
+            break;
+
+        case '!': {
+            // 图片：![alt](url)
+            int rb = 0;
+            int urlBegin = 0;
+            int urlEnd = 0;
+            int after = 0;
+            if (i + 1 < end && s[i + 1] == QLatin1Char('[')
+                && parseLink(i + 1, rb, urlBegin, urlEnd, after)) {
+                appendEscaped(out, s, run, i);
+                out += QLatin1String("<img src=\"");
+                appendEscaped(out, s, urlBegin, urlEnd);
+                out += QLatin1String("\" alt=\"");
+                appendEscaped(out, s, i + 2, rb);
+                out += QLatin1String("\">");
+                i = after;
+                run = i;
+                continue;
+            }
+            break;
+        }
+
+        case '[': {
+            // 链接：[文字](url)
+            int rb = 0;
+            int urlBegin = 0;
+            int urlEnd = 0;
+            int after = 0;
+            if (parseLink(i, rb, urlBegin, urlEnd, after) && rb > i + 1) {
+                appendEscaped(out, s, run, i);
+                out += QLatin1String("<a href=\"");
+                appendEscaped(out, s, urlBegin, urlEnd);
+                out += m_linkStyleAttr;
+                renderInline(s, i + 1, rb, out);
+                out += QLatin1String("</a>");
+                i = after;
+                run = i;
+                continue;
+            }
+            break;
+        }
+
+        case '$': {
+            // 公式：$...$ / $$...$$ 原样透传，内部的 * _ 等不做格式处理
+            const bool display = i + 1 < end && s[i + 1] == QLatin1Char('$');
+            const int width = display ? 2 : 1;
+            int close = -1;
+            if (display) {
+                close = findDoubleChar(s, i + 2, end, QLatin1Char('$'), nextDollar);
+            } else {
+                close = nextDollar.find(s, i + 1, end, QLatin1Char('$'));
+                // 排除金额写法（"$5 和 $6"）：两侧须紧贴内容，闭合符后不能跟数字
+                if (close > i + 1 && (s[i + 1].isSpace() || s[close - 1].isSpace()
+                                      || (close + 1 < end && s[close + 1].isDigit()))) {
+                    close = -1;
+                }
+            }
+            if (close <= i + width) {
+                i += width;
+                continue;
+            }
+            appendEscaped(out, s, run, i);
+            out += kMathInlineOpen;
+            appendEscaped(out, s, i, close + width);
+            out += QLatin1String("</span>");
+            i = close + width;
+            run = i;
+            continue;
+        }
 
-    // 移除标题标记
-    if (result.startsWith("#")) {
-        int spaceIndex = result.indexOf(' ');
-        if (spaceIndex > 0) {
-            result = result.mid(spaceIndex + 1);
+        default:
+            break;
         }
+        ++i;
     }
 
-    return result.trimmed();
+    appendEscaped(out, s, run, end);
 }
@@ -8,14 +8,20 @@
 #include <QColor>
 #include <QFont>
 #include <QMap>
+#include <QVector>
 
 /**
- * @brief 基于MD4C的Markdown渲染器
+ * @brief 单遍扫描的 Markdown 渲染器
  *
  * 将Markdown文本转换为Qt富文本格式，支持：
- * - 粗体、斜体、删除线
- * - 标题、列表、代码块
- * - 链接、表格、引用
+ * - 粗体、斜体、删除线、行内代码、链接、图片
+ * - 标题、列表、代码块、分割线
+ * - 表格（含对齐）、引用
+ * - 数学公式原样透传（$...$ / $$...$$，内部不做任何格式处理）
+ *
+ * 实现为一遍扫描的分词器：按行游标识别块结构（不预先拆分成 QStringList），
+ * 行内内容从左到右扫描一次，所有 HTML 直接追加到同一个预留容量的缓冲区。
+ * 样式片段在设置颜色时预先拼好，渲染过程中不再格式化字符串。
  */
 class MarkdownRenderer
 {
@@ -58,34 +64,17 @@ public:
     void setHeadingColor(int level, const QColor &color);
 
 private:
-    // 内部渲染数据结构
-    struct RenderData {
-        QString html;
-        QString currentText;
-        bool inCodeBlock;
-        bool inInlineCode;
-        int listLevel;
-        QMap<QString, QString> linkUrls;
-
-        RenderData() : inCodeBlock(false), inInlineCode(false), listLevel(0) {}
-    };
-
-    // 渲染方法
-    void processMarkdown(const QString &markdown, RenderData &data);
-    void processTextBlock(const QString &text, RenderData &data);
-    void processInlineFormatting(QString &text, RenderData &data);
-    void processHeaders(const QString &line, RenderData &data);
-    void processLists(const QString &line, RenderData &data);
-    void processCodeBlocks(const QString &line, RenderData &data);
-    void processLinks(QString &text, RenderData &data);
+    // 块级扫描：逐行识别段落/标题/列表/代码块/表格/引用/公式
+    void renderBlocks(const QString &markdown, QString &out) const;
+    // 表格：从 pos 所在行开始消费连续的表格行，返回表格之后的行首位置
+    int renderTable(const QChar *s, int pos, int end, QString &out) const;
+    void renderTableRow(const QChar *s, int begin, int end, bool header,
+                        const QVector<Qt::Alignment> &alignments, QString &out) const;
+    // 行内扫描：[begin, end) 区间单遍输出
+    void renderInline(const QChar *s, int begin, int end, QString &out) const;
 
-    // HTML生成方法
-    QString escapeHtml(const QString &text) const;
-    QString generateHtmlForHeading(const QString &text, int level) const;
-    QString generateHtmlForCodeBlock(const QString &text) const;
-    QString generateHtmlForInlineCode(const QString &text) const;
-    QString generateHtmlForLink(const QString &text, const QString &url) const;
-    QString generateHtmlForListItem(const QString &text, bool isOrdered, int level) const;
+    void appendListItemOpen(bool isOrdered, int level, QString &out) const;
+    void updateStyleCache();
 
     // 样式配置
     QColor m_codeBackgroundColor;
@@ -93,13 +82,11 @@ private:
     QColor m_linkColor;
     QMap<int, QColor> m_headingColors;
 
-    // 工具方法
-    bool isHeaderLine(const QString &line, int &level) const;
-    bool isOrderedListLine(const QString &line, QString &content) const;
-    bool isUnorderedListLine(const QString &line, QString &content) const;
-    bool isCodeBlockStart(const QString &line, QString &language) const;
-    bool isCodeBlockEnd(const QString &line) const;
-    QString stripMarkdownMarkers(const QString &text) const;
+    // 预先拼好的开标签
+    QString m_inlineCodeOpen;
+    QString m_codeBlockOpen;
+    QString m_linkStyleAttr;
+    QString m_headingOpen[7];
 };
 
 #endif // MARKDOWNRENDERER_H
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "MarkdownStreamSplitter.h"
+
+MarkdownStreamSplitter::MarkdownStreamSplitter()
+{
+    reset();
+}
+
+void MarkdownStreamSplitter::reset()
+{
+    m_buffer.clear();
+    m_completedLength = 0;
+    m_scanPos = 0;
+    m_pendingBreak = -1;
+    m_blockHasContent = false;
+    m_lastLineIsList = false;
+    m_fenceMarker.clear();
+}
+
+void MarkdownStreamSplitter::append(const QString &text)
+{
+    if (text.isEmpty()) {
+        return;
+    }
+    m_buffer += text;
+    scanLines();
+}
+
+QString MarkdownStreamSplitter::takeCompleted()
+{
+    if (m_completedLength == 0) {
+        return QString();
+    }
+
+    const QString completed = m_buffer.left(m_completedLength);
+    m_buffer.remove(0, m_completedLength);
+    m_scanPos -= m_completedLength;
+    if (m_pendingBreak >= 0) {
+        m_pendingBreak -= m_completedLength;
+    }
+    m_completedLength = 0;
+    return completed;
+}
+
+QString MarkdownStreamSplitter::takeRemaining()
+{
+    const QString remaining = m_buffer;
+    reset();
+    return remaining;
+}
+
+bool MarkdownStreamSplitter::isListLine(const QString &line)
+{
+    if (line.isEmpty()) {
+        return false;
+    }
+    // 缩进续行
+    if (line.at(0) == QLatin1Char(' ') || line.at(0) == QLatin1Char('\t')) {
+        return true;
+    }
+    // 无序列表
+    if (line.size() >= 2 && line.at(1) == QLatin1Char(' ') &&
+        (line.at(0) == QLatin1Char('-') || line.at(0) == QLatin1Char('*') || line.at(0) == QLatin1Char('+'))) {
+        return true;
+    }
+    // 有序列表：数字 + "." 或 ")"
+    int i = 0;
+    while (i < line.size() && line.at(i).isDigit()) {
+        ++i;
+    }
+    return i > 0 && i < line.size() &&
+           (line.at(i) == QLatin1Char('.') || line.at(i) == QLatin1Char(')'));
+}
+
+void MarkdownStreamSplitter::scanLines()
+{
+    while (true) {
+        const int lineEnd = m_buffer.indexOf(QLatin1Char('\n'), m_scanPos);
+        if (lineEnd < 0) {
+            return;  // 最后一行还没写完
+        }
+
+        const QString line = m_buffer.mid(m_scanPos, lineEnd - m_scanPos);
+        const QString trimmed = line.trimmed();
+        m_scanPos = lineEnd + 1;
+
+        // 代码块/公式块内部：只等结束标记
+        if (!m_fenceMarker.isEmpty()) {
+            if (trimmed.startsWith(m_fenceMarker)) {
+                m_fenceMarker.clear();
+            }
+            m_lastLineIsList = false;
+            continue;
+        }
+
+        if (trimmed.isEmpty()) {
+            if (m_blockHasContent) {
+                m_pendingBreak = m_scanPos;
+            } else if (m_pendingBreak < 0) {
+                // 块首的空行直接归入已完成部分，不单独渲染
+                m_completedLength = m_scanPos;
+            }
+            continue;
+        }
+
+        const bool listLine = isListLine(line);
+        if (m_pendingBreak >= 0) {
+            if (!(m_lastLineIsList && listLine)) {
+                // 上一块在空行处结束，当前行开始新块
+                m_completedLength = m_pendingBreak;
+                m_blockHasContent = false;
+            }
+            m_pendingBreak = -1;
+        }
+
+        if (trimmed.startsWith(QLatin1String("```"))) {
+            m_fenceMarker = QStringLiteral("```");
+        } else if (trimmed == QLatin1String("$$")) {
+            m_fenceMarker = QStringLiteral("$$");
+        }
+
+        m_blockHasContent = true;
+        m_lastLineIsList = listLine;
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef MARKDOWNSTREAMSPLITTER_H
+#define MARKDOWNSTREAMSPLITTER_H
+
+#include <QString>
+
+/**
+ * @brief 流式 Markdown 分块器
+ *
+ * AI 流式输出时逐段追加文本，按空行切出已完整的块（段落、标题、表格、列表……），
+ * 供调用方逐块渲染，不必每次重渲染整篇文档。
+ * - 代码块（```）和公式块（$$）内部的空行不切分
+ * - 空行两侧都是列表项/缩进续行时视为同一个松散列表，不切分（避免有序列表重新编号）
+ * 只扫描新到达的完整行，缓冲区里只保留尚未完成的块。
+ */
+class MarkdownStreamSplitter
+{
+public:
+    MarkdownStreamSplitter();
+
+    void reset();
+
+    // 追加流式文本
+    void append(const QString &text);
+
+    // 取出已完整的块（可能包含多个块及其后的空行），没有则返回空串
+    QString takeCompleted();
+
+    // 尚未完成的部分
+    const QString &pendingText() const { return m_buffer; }
+
+    // 流结束：取出剩余全部文本并重置状态
+    QString takeRemaining();
+
+private:
+    void scanLines();
+    static bool isListLine(const QString &line);
+
+    QString m_buffer;        // 尚未取走的文本，下标 0 为当前块起点
+    int m_completedLength;   // [0, m_completedLength) 为已完成的块
+    int m_scanPos;           // 下一个待扫描的行首
+    int m_pendingBreak;      // 块后空行结束的位置，等下一行到达后再决定是否切分
+    bool m_blockHasContent;
+    bool m_lastLineIsList;
+    QString m_fenceMarker;   // 非空表示处于 ``` 或 $$ 块内
+};
+
+#endif // MARKDOWNSTREAMSPLITTER_H
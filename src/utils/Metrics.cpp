@@ -0,0 +1,334 @@
+#include "Metrics.h"
+#include "../config/AppConfig.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+#include <QTimer>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+QString configValue(const char *key)
+{
+    QString value = qEnvironmentVariable(key).trimmed();
+    if (value.isEmpty()) {
+        value = AppConfig::get(QString::fromLatin1(key)).trimmed();
+    }
+    return value;
+}
+
+bool writeFileAtomically(const QString &path, const QByteArray &data)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[Metrics] 无法写入:" << path << file.errorString();
+        return false;
+    }
+    file.write(data);
+    return file.commit();
+}
+
+double microsToMs(qint64 micros)
+{
+    return micros / 1000.0;
+}
+
+} // namespace
+
+// ==================== Histogram ====================
+
+int Metrics::Histogram::bucketIndex(quint64 micros)
+{
+    if (micros < quint64(SUB_BUCKETS)) {
+        return int(micros);
+    }
+    const int msb = 63 - qCountLeadingZeroBits(micros);
+    if (msb > MAX_MSB) {
+        return BUCKET_COUNT - 1;
+    }
+    const int octave = msb - SUB_BUCKET_BITS;
+    const int sub = int((micros >> octave) & (SUB_BUCKETS - 1));
+    return SUB_BUCKETS + octave * SUB_BUCKETS + sub;
+}
+
+quint64 Metrics::Histogram::bucketUpperBound(int index)
+{
+    if (index < SUB_BUCKETS) {
+        return quint64(index);
+    }
+    const int octave = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    const int sub = (index - SUB_BUCKETS) % SUB_BUCKETS;
+    const quint64 lower = quint64(SUB_BUCKETS + sub) << octave;
+    return lower + (quint64(1) << octave) - 1;
+}
+
+void Metrics::Histogram::record(qint64 micros)
+{
+    const quint64 value = micros > 0 ? quint64(micros) : 0;
+    m_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_sum.fetch_add(value, std::memory_order_relaxed);
+
+    quint64 currentMax = m_max.load(std::memory_order_relaxed);
+    while (value > currentMax &&
+           !m_max.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {
+    }
+}
+
+qint64 Metrics::Histogram::percentile(double quantile) const
+{
+    // 各档计数是并发读取的快照，总数以档内合计为准
+    std::array<quint64, BUCKET_COUNT> snapshot;
+    quint64 total = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        snapshot[i] = m_buckets[i].load(std::memory_order_relaxed);
+        total += snapshot[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    const quint64 rank = std::max<quint64>(1, quint64(std::ceil(qBound(0.0, quantile, 1.0) * total)));
+    quint64 cumulative = 0;
+    for (int i = 0; i < BUCKET_COUNT; ++i) {
+        cumulative += snapshot[i];
+        if (cumulative >= rank) {
+            return qint64(std::min(bucketUpperBound(i), quint64(maxMicros())));
+        }
+    }
+    return maxMicros();
+}
+
+// ==================== ScopedSpan ====================
+
+Metrics::ScopedSpan::ScopedSpan(const char *name)
+    : ScopedSpan(name, Metrics::instance().histogram(name))
+{
+}
+
+Metrics::ScopedSpan::ScopedSpan(const char *name, Histogram &histogram)
+    : m_name(name)
+    , m_histogram(histogram)
+    , m_startNs(Metrics::nowNs())
+{
+}
+
+Metrics::ScopedSpan::~ScopedSpan()
+{
+    Metrics::instance().recordSpan(m_name, m_histogram, m_startNs);
+}
+
+// ==================== Metrics ====================
+
+Metrics &Metrics::instance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+qint64 Metrics::nowNs()
+{
+    static const QElapsedTimer clock = []() {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return clock.nsecsElapsed();
+}
+
+Metrics::Counter &Metrics::counter(const char *name)
+{
+    QMutexLocker locker(&m_registryMutex);
+    std::shared_ptr<Counter> &slot = m_counters[QByteArray(name)];
+    if (!slot) {
+        slot = std::make_shared<Counter>();
+    }
+    return *slot;
+}
+
+Metrics::Histogram &Metrics::histogram(const char *name)
+{
+    QMutexLocker locker(&m_registryMutex);
+    std::shared_ptr<Histogram> &slot = m_histograms[QByteArray(name)];
+    if (!slot) {
+        slot = std::make_shared<Histogram>();
+    }
+    return *slot;
+}
+
+void Metrics::recordSpan(const char *name, qint64 startNs, qint64 endNs)
+{
+    recordSpan(name, histogram(name), startNs, endNs);
+}
+
+void Metrics::recordSpan(const char *name, Histogram &histogram, qint64 startNs, qint64 endNs)
+{
+    if (endNs < 0) {
+        endNs = nowNs();
+    }
+    const qint64 durationNs = qMax<qint64>(0, endNs - startNs);
+    histogram.record(durationNs / 1000);
+
+    if (!isTracingEnabled()) {
+        return;
+    }
+
+    TraceEvent event;
+    event.name = name;
+    event.startNs = startNs;
+    event.durationNs = durationNs;
+    event.threadId = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+    QMutexLocker locker(&m_traceMutex);
+    if (m_traceEvents.size() >= MAX_TRACE_EVENTS) {
+        m_droppedTraceEvents.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    m_traceEvents.append(event);
+}
+
+void Metrics::setTracingEnabled(bool enabled)
+{
+    m_tracingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+QJsonObject Metrics::summaryJson() const
+{
+    QJsonObject counters;
+    QJsonObject histograms;
+    {
+        QMutexLocker locker(&m_registryMutex);
+        for (auto it = m_counters.constBegin(); it != m_counters.constEnd(); ++it) {
+            counters[QString::fromUtf8(it.key())] = qint64(it.value()->value());
+        }
+        for (auto it = m_histograms.constBegin(); it != m_histograms.constEnd(); ++it) {
+            const Histogram &h = *it.value();
+            const quint64 count = h.count();
+            if (count == 0) {
+                continue;
+            }
+            QJsonObject obj;
+            obj["count"] = qint64(count);
+            obj["mean_ms"] = microsToMs(h.sumMicros()) / count;
+            obj["p50_ms"] = microsToMs(h.percentile(0.50));
+            obj["p90_ms"] = microsToMs(h.percentile(0.90));
+            obj["p99_ms"] = microsToMs(h.percentile(0.99));
+            obj["max_ms"] = microsToMs(h.maxMicros());
+            obj["total_ms"] = microsToMs(h.sumMicros());
+            histograms[QString::fromUtf8(it.key())] = obj;
+        }
+    }
+
+    QJsonObject root;
+    root["app_version"] = QCoreApplication::applicationVersion();
+    root["recorded_at"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["uptime_ms"] = nowNs() / 1000000;
+    root["counters"] = counters;
+    root["histograms"] = histograms;
+    root["dropped_trace_events"] = qint64(m_droppedTraceEvents.load(std::memory_order_relaxed));
+    return root;
+}
+
+bool Metrics::writeSummary(const QString &path) const
+{
+    return writeFileAtomically(path, QJsonDocument(summaryJson()).toJson(QJsonDocument::Indented));
+}
+
+bool Metrics::writeChromeTrace(const QString &path) const
+{
+    QVector<TraceEvent> events;
+    {
+        QMutexLocker locker(&m_traceMutex);
+        events = m_traceEvents;
+    }
+
+    // 事件可能有几十万条，直接拼 JSON 文本，不经过 QJsonArray
+    QHash<quintptr, int> threadIndex;
+    QByteArray json;
+    json.reserve(events.size() * 96 + 64);
+    json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    for (int i = 0; i < events.size(); ++i) {
+        const TraceEvent &event = events.at(i);
+        const int tid = threadIndex.value(event.threadId, threadIndex.size() + 1);
+        threadIndex.insert(event.threadId, tid);
+
+        // 名称前缀（第一个 '.' 之前）作为分类，便于在查看器里按服务过滤
+        const QByteArray name(event.name);
+        const int dot = name.indexOf('.');
+
+        if (i > 0) {
+            json += ',';
+        }
+        json += "{\"name\":\"";
+        json += name;
+        json += "\",\"cat\":\"";
+        json += dot > 0 ? name.left(dot) : name;
+        json += "\",\"ph\":\"X\",\"pid\":1,\"tid\":";
+        json += QByteArray::number(tid);
+        json += ",\"ts\":";
+        json += QByteArray::number(event.startNs / 1000.0, 'f', 3);
+        json += ",\"dur\":";
+        json += QByteArray::number(event.durationNs / 1000.0, 'f', 3);
+        json += '}';
+    }
+    json += "]}";
+
+    if (!writeFileAtomically(path, json)) {
+        return false;
+    }
+    qDebug() << "[Metrics] 追踪已写入:" << path << "事件数:" << events.size();
+    return true;
+}
+
+// ==================== MetricsExporter ====================
+
+MetricsExporter::MetricsExporter(QObject *parent)
+    : QObject(parent)
+    , m_summaryPath(configValue("METRICS_SUMMARY"))
+    , m_tracePath(configValue("METRICS_TRACE"))
+{
+    if (!m_tracePath.isEmpty()) {
+        Metrics::instance().setTracingEnabled(true);
+        qDebug() << "[Metrics] 已开启追踪，退出时写出:" << m_tracePath;
+    }
+
+    if (!m_summaryPath.isEmpty()) {
+        bool ok = false;
+        int intervalSec = configValue("METRICS_SUMMARY_INTERVAL_SEC").toInt(&ok);
+        if (!ok || intervalSec <= 0) {
+            intervalSec = 60;
+        }
+        m_summaryTimer = new QTimer(this);
+        m_summaryTimer->setInterval(intervalSec * 1000);
+        connect(m_summaryTimer, &QTimer::timeout, this, [this]() {
+            Metrics::instance().writeSummary(m_summaryPath);
+        });
+        m_summaryTimer->start();
+        qDebug() << "[Metrics] 指标摘要每" << intervalSec << "秒写出:" << m_summaryPath;
+    }
+
+    if (!m_summaryPath.isEmpty() || !m_tracePath.isEmpty()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                this, &MetricsExporter::flush);
+    }
+}
+
+void MetricsExporter::flush()
+{
+    if (!m_summaryPath.isEmpty()) {
+        Metrics::instance().writeSummary(m_summaryPath);
+    }
+    if (!m_tracePath.isEmpty()) {
+        Metrics::instance().writeChromeTrace(m_tracePath);
+    }
+}
@@ -0,0 +1,184 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QJsonObject>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <memory>
+
+class QTimer;
+
+/**
+ * @brief 进程内指标与追踪
+ *
+ * 进程级单例，提供三类数据：
+ * - 计数器：原子累加，无锁
+ * - 延迟直方图：对数-线性分桶（每个 2 的幂区间 16 档，相对误差约 6%），记录/读取均无锁
+ * - 追踪区间：记录到同名直方图；开启追踪时另存一条事件，可导出为 Chrome trace JSON
+ *   （chrome://tracing 或 Perfetto 打开）
+ *
+ * 名称必须是字符串字面量（追踪事件只保存指针）。注册表查找需要加锁，
+ * 热路径请用 METRICS_COUNT / METRICS_SCOPE 宏，首次查找后缓存引用。
+ *
+ * 用法：
+ *   METRICS_COUNT("dify.stream_chunks");
+ *   { METRICS_SCOPE("smart_paper.select"); runGreedySelection(); }
+ *
+ *   // 跨回调的异步区间
+ *   const qint64 startNs = Metrics::nowNs();
+ *   ...
+ *   Metrics::instance().recordSpan("dify.request", startNs);
+ */
+class Metrics
+{
+public:
+    class Counter
+    {
+    public:
+        void add(quint64 n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+        quint64 value() const { return m_value.load(std::memory_order_relaxed); }
+
+    private:
+        std::atomic<quint64> m_value{0};
+    };
+
+    /**
+     * @brief 延迟直方图（单位：微秒）
+     *
+     * 小于 16 的值逐个计数；更大的值按最高位所在的 2 的幂区间分组，
+     * 区间内再按接下来的 4 位细分为 16 档。上限约 2^40 微秒（12 天），超出的值计入最后一档。
+     */
+    class Histogram
+    {
+    public:
+        static constexpr int SUB_BUCKET_BITS = 4;
+        static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        static constexpr int MAX_MSB = 39;
+        static constexpr int BUCKET_COUNT = SUB_BUCKETS + (MAX_MSB - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+        void record(qint64 micros);
+
+        quint64 count() const { return m_count.load(std::memory_order_relaxed); }
+        qint64 sumMicros() const { return qint64(m_sum.load(std::memory_order_relaxed)); }
+        qint64 maxMicros() const { return qint64(m_max.load(std::memory_order_relaxed)); }
+
+        // 分位值（0~1），返回所在档的上界；没有样本返回 0
+        qint64 percentile(double quantile) const;
+
+    private:
+        static int bucketIndex(quint64 micros);
+        static quint64 bucketUpperBound(int index);
+
+        std::array<std::atomic<quint64>, BUCKET_COUNT> m_buckets{};
+        std::atomic<quint64> m_count{0};
+        std::atomic<quint64> m_sum{0};
+        std::atomic<quint64> m_max{0};
+    };
+
+    // RAII 区间：析构时记录耗时
+    class ScopedSpan
+    {
+    public:
+        explicit ScopedSpan(const char *name);
+        ScopedSpan(const char *name, Histogram &histogram);
+        ~ScopedSpan();
+        ScopedSpan(const ScopedSpan &) = delete;
+        ScopedSpan &operator=(const ScopedSpan &) = delete;
+
+    private:
+        const char *m_name;
+        Histogram &m_histogram;
+        qint64 m_startNs;
+    };
+
+    struct TraceEvent {
+        const char *name = nullptr;
+        qint64 startNs = 0;
+        qint64 durationNs = 0;
+        quintptr threadId = 0;
+    };
+
+    static Metrics &instance();
+
+    // 进程内统一的单调时钟（纳秒），区间起止都用它
+    static qint64 nowNs();
+
+    Counter &counter(const char *name);
+    Histogram &histogram(const char *name);
+
+    // 记录 [startNs, endNs) 区间；endNs < 0 表示到现在为止
+    void recordSpan(const char *name, qint64 startNs, qint64 endNs = -1);
+    void recordSpan(const char *name, Histogram &histogram, qint64 startNs, qint64 endNs = -1);
+
+    // 追踪事件默认不采集，只更新直方图
+    void setTracingEnabled(bool enabled);
+    bool isTracingEnabled() const { return m_tracingEnabled.load(std::memory_order_relaxed); }
+
+    QJsonObject summaryJson() const;
+    bool writeSummary(const QString &path) const;
+    bool writeChromeTrace(const QString &path) const;
+
+private:
+    Metrics() = default;
+
+    // 追踪缓冲上限，超出后丢弃新事件并计数
+    static constexpr int MAX_TRACE_EVENTS = 200000;
+
+    mutable QMutex m_registryMutex;
+    QHash<QByteArray, std::shared_ptr<Counter>> m_counters;
+    QHash<QByteArray, std::shared_ptr<Histogram>> m_histograms;
+
+    std::atomic<bool> m_tracingEnabled{false};
+    mutable QMutex m_traceMutex;
+    QVector<TraceEvent> m_traceEvents;
+    std::atomic<quint64> m_droppedTraceEvents{0};
+};
+
+/**
+ * @brief 指标导出器
+ *
+ * 读取配置（环境变量优先，其次 .env.local 同名配置）：
+ *   METRICS_SUMMARY=<路径>              定期写出各计数器和直方图的摘要 JSON
+ *   METRICS_SUMMARY_INTERVAL_SEC=<秒>   摘要间隔，默认 60
+ *   METRICS_TRACE=<路径>                开启追踪，退出时写出 Chrome trace JSON
+ * 都未配置时不创建定时器，也不采集追踪事件。
+ */
+class MetricsExporter : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MetricsExporter(QObject *parent = nullptr);
+
+    // 写出摘要和追踪文件（退出时自动调用一次）
+    void flush();
+
+private:
+    QString m_summaryPath;
+    QString m_tracePath;
+    QTimer *m_summaryTimer = nullptr;
+};
+
+#define METRICS_CONCAT_INNER(a, b) a##b
+#define METRICS_CONCAT(a, b) METRICS_CONCAT_INNER(a, b)
+
+// 计数器 +1 / +n，首次调用后缓存引用，之后无锁
+#define METRICS_COUNT_N(name, n) \
+    do { \
+        static Metrics::Counter &metricsCounter_ = Metrics::instance().counter(name); \
+        metricsCounter_.add(quint64(n)); \
+    } while (false)
+#define METRICS_COUNT(name) METRICS_COUNT_N(name, 1)
+
+// 当前作用域计时
+#define METRICS_SCOPE(name) \
+    static Metrics::Histogram &METRICS_CONCAT(metricsHistogram_, __LINE__) = Metrics::instance().histogram(name); \
+    Metrics::ScopedSpan METRICS_CONCAT(metricsSpan_, __LINE__)(name, METRICS_CONCAT(metricsHistogram_, __LINE__))
+
+#endif // METRICS_H
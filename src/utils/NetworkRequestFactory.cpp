@@ -4,6 +4,27 @@
 #include <QDebug>
 #include <QHostAddress>
 
+namespace {
+NetworkRequestFactory::AccessTokenProvider &tokenProvider()
+{
+    static NetworkRequestFactory::AccessTokenProvider provider;
+    return provider;
+}
+}
+
+// ===== 令牌注入 =====
+
+void NetworkRequestFactory::setAccessTokenProvider(AccessTokenProvider provider)
+{
+    tokenProvider() = std::move(provider);
+}
+
+QString NetworkRequestFactory::currentAccessToken()
+{
+    const AccessTokenProvider &provider = tokenProvider();
+    return provider ? provider() : SupabaseConfig::accessToken();
+}
+
 // ===== 公共辅助方法 =====
 
 bool NetworkRequestFactory::allowInsecureSslForDebug()
@@ -16,6 +37,19 @@ bool NetworkRequestFactory::allowInsecureSslForDebug()
     return value == "1" || value == "true" || value == "yes";
 }
 
+bool NetworkRequestFactory::http2Enabled()
+{
+    static const bool enabled = []() {
+        QString value = qEnvironmentVariable("DISABLE_HTTP2").trimmed();
+        if (value.isEmpty()) {
+            value = AppConfig::get(QStringLiteral("DISABLE_HTTP2")).trimmed();
+        }
+        value = value.toLower();
+        return !(value == "1" || value == "true" || value == "yes");
+    }();
+    return enabled;
+}
+
 bool NetworkRequestFactory::handleSslErrors(QNetworkReply *reply,
                                              const QList<QSslError> &errors,
                                              const QString &tag)
@@ -37,12 +71,24 @@ bool NetworkRequestFactory::handleSslErrors(QNetworkReply *reply,
     return false;
 }
 
+void NetworkRequestFactory::applySupabaseAuth(QNetworkRequest &request)
+{
+    request.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
+
+    // 优先使用用户 JWT token，否则用 anon key
+    const QString token = currentAccessToken();
+    request.setRawHeader("Authorization",
+                         QString("Bearer %1")
+                             .arg(token.isEmpty() ? SupabaseConfig::supabaseAnonKey() : token)
+                             .toUtf8());
+}
+
 // ===== 内部辅助 =====
 
 void NetworkRequestFactory::applyBaseConfig(QNetworkRequest &request)
 {
-    // 全局禁用 HTTP/2，避免 macOS 上的协议错误
-    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, false);
+    // 默认启用 HTTP/2 多路复用；DISABLE_HTTP2 用于规避个别平台上的协议错误
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, http2Enabled());
 }
 
 void NetworkRequestFactory::applySslConfig(QNetworkRequest &request)
@@ -132,14 +178,11 @@ QNetworkRequest NetworkRequestFactory::createSupabaseRequest(const QString &endp
 
     // 请求头
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
 
-    // 认证: 优先使用用户令牌，否则使用 anon key
+    // 认证: 优先使用显式传入的令牌，其次当前会话令牌，否则使用 anon key
+    applySupabaseAuth(request);
     if (!accessToken.isEmpty()) {
         request.setRawHeader("Authorization", QString("Bearer %1").arg(accessToken).toUtf8());
-    } else {
-        request.setRawHeader("Authorization",
-                             QString("Bearer %1").arg(SupabaseConfig::supabaseAnonKey()).toUtf8());
     }
 
     if (preferRepresentation) {
@@ -176,16 +219,7 @@ QNetworkRequest NetworkRequestFactory::createAuthRequest(const QUrl &url, int ti
 
     // 请求头
     request.setHeader(QNetworkRequest::ContentTypeHeader, "application/json");
-    request.setRawHeader("apikey", SupabaseConfig::supabaseAnonKey().toUtf8());
-
-    // 优先使用用户 JWT token，否则用 anon key
-    QString token = SupabaseConfig::accessToken();
-    if (!token.isEmpty()) {
-        request.setRawHeader("Authorization", QString("Bearer %1").arg(token).toUtf8());
-    } else {
-        request.setRawHeader("Authorization",
-                             QString("Bearer %1").arg(SupabaseConfig::supabaseAnonKey()).toUtf8());
-    }
+    applySupabaseAuth(request);
 
     // 基础配置
     applyBaseConfig(request);
@@ -8,16 +8,23 @@
 #include <QSslError>
 #include <QString>
 #include <QUrl>
+#include <functional>
 
 /**
  * @brief 网络请求工厂类 - 统一创建已配置的 QNetworkRequest
  *
- * 纯静态工具类，与 SupabaseConfig 风格一致，不持有状态。
- * 各服务继续自己管理 QNetworkAccessManager，本类只负责创建请求对象。
+ * 纯静态工具类，与 SupabaseConfig 风格一致，除注入的令牌来源外不持有状态。
+ * 本类只负责创建请求对象。Supabase 数据服务的请求经 SessionNetworkManager::forCurrentThread()
+ * 返回的每线程共享管理器发出（共用连接池，发出前换上最新令牌）；
+ * Dify 等 AI 服务和认证流程仍各自持有 QNetworkAccessManager。
+ *
+ * 用户令牌由 setAccessTokenProvider() 注入（应用内为 SessionManager，
+ * 未注入时回退到 SupabaseConfig::accessToken()），各服务不再自行拼接认证头。
  *
  * 统一配置项：
  * - SSL: 默认严格校验，ALLOW_INSECURE_SSL=1 时降级为 VerifyNone（仅开发调试）
- * - HTTP/2: 全局禁用（避免 macOS 上的协议错误）
+ * - HTTP/2: 默认启用，同一主机的并发请求复用一条连接；
+ *           DISABLE_HTTP2=1 时关闭（曾在 macOS 上遇到协议错误，保留为开关）
  * - 超时: 各方法提供合理默认值，调用方可覆盖
  * - 重定向: Dify 请求启用 NoLessSafeRedirectPolicy
  */
@@ -30,6 +37,16 @@ public:
     static constexpr int TIMEOUT_AI_CHAT = 120000;     // AI 对话: 120s
     static constexpr int TIMEOUT_FILE_UPLOAD = 300000; // 文件上传: 300s
 
+    // ===== 令牌注入 =====
+
+    using AccessTokenProvider = std::function<QString()>;
+
+    /** 注入当前用户访问令牌的来源 */
+    static void setAccessTokenProvider(AccessTokenProvider provider);
+
+    /** 当前用户访问令牌（未登录时为空） */
+    static QString currentAccessToken();
+
     // ===== 工厂方法 =====
 
     /**
@@ -55,7 +72,7 @@ public:
     /**
      * @brief 创建 Supabase REST 请求（内部拼接 SupabaseConfig::SUPABASE_URL）
      * @param endpoint REST 端点路径（如 "/rest/v1/notifications?..."）
-     * @param accessToken 可选的用户访问令牌（为空则使用 anon key）
+     * @param accessToken 可选的用户访问令牌（为空则使用当前会话令牌，未登录时用 anon key）
      * @param preferRepresentation 是否设置 Prefer: return=representation
      */
     static QNetworkRequest createSupabaseRequest(const QString &endpoint,
@@ -72,7 +89,7 @@ public:
                                              int timeout = TIMEOUT_AUTH);
 
     /**
-     * @brief 创建通用请求（HTTP/2 禁用 + 超时）
+     * @brief 创建通用请求（HTTP/2 + 超时）
      * @param url 完整请求 URL
      * @param timeout 超时毫秒数，默认 30s
      */
@@ -105,13 +122,23 @@ public:
 
     static bool allowInsecureSslForDebug();
 
+    /** 是否允许 HTTP/2（读取 DISABLE_HTTP2 环境变量 / 配置，默认允许） */
+    static bool http2Enabled();
+
+    /**
+     * @brief 设置 Supabase 认证头（apikey + 当前用户令牌，未登录时用 anon key）
+     *
+     * 供 Storage、TUS 等不经过 createSupabaseRequest 的请求使用。
+     */
+    static void applySupabaseAuth(QNetworkRequest &request);
+
 private:
     // 禁止实例化
     NetworkRequestFactory() = default;
 
     // ===== 内部辅助 =====
 
-    /** 禁用 HTTP/2 */
+    /** 按 http2Enabled() 设置 HTTP/2 */
     static void applyBaseConfig(QNetworkRequest &request);
 
     /** 如果调试开关开启，配置不安全 SSL */
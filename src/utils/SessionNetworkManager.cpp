@@ -0,0 +1,250 @@
+#include "SessionNetworkManager.h"
+#include "NetworkRequestFactory.h"
+#include "../auth/supabase/sessionmanager.h"
+#include "../config/AppConfig.h"
+#include <QCoreApplication>
+#include <QDebug>
+#include <QNetworkReply>
+#include <QSslConfiguration>
+#include <QThread>
+#include <memory>
+
+/**
+ * 等待令牌刷新或排队等待主机空位时返回给调用方的占位 reply。
+ * attach() 之后把真实 reply 的元数据、数据和信号原样转发出去。
+ */
+class DeferredReply : public QNetworkReply
+{
+public:
+    DeferredReply(QNetworkAccessManager::Operation op, const QNetworkRequest &request, QObject *parent)
+        : QNetworkReply(parent)
+    {
+        setOperation(op);
+        setRequest(request);
+        setUrl(request.url());
+        open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+    }
+
+    void attach(QNetworkReply *inner)
+    {
+        m_inner = inner;
+        inner->setParent(this);
+
+        connect(inner, &QNetworkReply::metaDataChanged, this, [this]() {
+            copyMetaData();
+            emit metaDataChanged();
+        });
+        connect(inner, &QIODevice::readyRead, this, &QIODevice::readyRead);
+        connect(inner, &QNetworkReply::downloadProgress, this, &QNetworkReply::downloadProgress);
+        connect(inner, &QNetworkReply::uploadProgress, this, &QNetworkReply::uploadProgress);
+        connect(inner, &QNetworkReply::sslErrors, this, &QNetworkReply::sslErrors);
+        connect(inner, &QNetworkReply::errorOccurred, this, [this](QNetworkReply::NetworkError code) {
+            setError(code, m_inner->errorString());
+            emit errorOccurred(code);
+        });
+        connect(inner, &QNetworkReply::finished, this, [this]() {
+            copyMetaData();
+            setError(m_inner->error(), m_inner->errorString());
+            setFinished(true);
+            emit finished();
+        });
+    }
+
+    void abort() override
+    {
+        if (m_inner) {
+            m_inner->abort();
+            return;
+        }
+        if (isFinished()) return;
+        setError(OperationCanceledError, QStringLiteral("Operation canceled"));
+        setFinished(true);
+        emit errorOccurred(OperationCanceledError);
+        emit finished();
+    }
+
+    void ignoreSslErrors() override
+    {
+        if (m_inner) m_inner->ignoreSslErrors();
+    }
+
+    qint64 bytesAvailable() const override
+    {
+        return (m_inner ? m_inner->bytesAvailable() : 0) + QNetworkReply::bytesAvailable();
+    }
+
+    bool isSequential() const override { return true; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override
+    {
+        return m_inner ? m_inner->read(data, maxSize) : 0;
+    }
+
+    void ignoreSslErrorsImplementation(const QList<QSslError> &errors) override
+    {
+        if (m_inner) m_inner->ignoreSslErrors(errors);
+    }
+
+private:
+    void copyMetaData()
+    {
+        static const QNetworkRequest::Attribute attributes[] = {
+            QNetworkRequest::HttpStatusCodeAttribute,
+            QNetworkRequest::HttpReasonPhraseAttribute,
+            QNetworkRequest::RedirectionTargetAttribute,
+            QNetworkRequest::Http2WasUsedAttribute,
+            QNetworkRequest::SourceIsFromCacheAttribute,
+        };
+        for (QNetworkRequest::Attribute attribute : attributes) {
+            setAttribute(attribute, m_inner->attribute(attribute));
+        }
+        for (const RawHeaderPair &header : m_inner->rawHeaderPairs()) {
+            setRawHeader(header.first, header.second);
+        }
+    }
+
+    QPointer<QNetworkReply> m_inner;
+};
+
+// ===== 共享实例 =====
+
+SessionNetworkManager* SessionNetworkManager::forCurrentThread()
+{
+    static thread_local QPointer<SessionNetworkManager> manager;
+    if (!manager) {
+        manager = new SessionNetworkManager();
+        QThread *thread = QThread::currentThread();
+        QCoreApplication *app = QCoreApplication::instance();
+        if (app && thread == app->thread()) {
+            manager->setParent(app);
+        } else {
+            connect(thread, &QThread::finished, manager.data(), &QObject::deleteLater);
+        }
+    }
+    return manager;
+}
+
+SessionNetworkManager::SessionNetworkManager(QObject *parent)
+    : QNetworkAccessManager(parent)
+{
+    bool ok = false;
+    const int limit = AppConfig::get(QStringLiteral("NETWORK_MAX_REQUESTS_PER_HOST")).toInt(&ok);
+    m_maxRequestsPerHost = ok && limit > 0 ? limit : DEFAULT_MAX_REQUESTS_PER_HOST;
+}
+
+void SessionNetworkManager::setMaxRequestsPerHost(int limit)
+{
+    m_maxRequestsPerHost = qMax(1, limit);
+    const QStringList hosts = m_queuedByHost.keys();
+    for (const QString &host : hosts) {
+        pump(host);
+    }
+}
+
+void SessionNetworkManager::prewarm(const QUrl &url)
+{
+    if (!url.isValid() || url.host().isEmpty()) return;
+
+    qDebug() << "[SessionNetworkManager] 预热连接:" << url.host();
+    if (url.scheme() == QLatin1String("https")) {
+        // 与 NetworkRequestFactory 创建的请求保持一致的 SSL 配置，才能命中同一个连接
+        QSslConfiguration config = QSslConfiguration::defaultConfiguration();
+        if (NetworkRequestFactory::http2Enabled()) {
+            config.setAllowedNextProtocols({QSslConfiguration::ALPNProtocolHTTP2,
+                                            QSslConfiguration::NextProtocolHttp1_1});
+        }
+        if (NetworkRequestFactory::allowInsecureSslForDebug()) {
+            config.setPeerVerifyMode(QSslSocket::VerifyNone);
+        }
+        connectToHostEncrypted(url.host(), static_cast<quint16>(url.port(443)), config);
+    } else {
+        connectToHost(url.host(), static_cast<quint16>(url.port(80)));
+    }
+}
+
+// ===== 请求调度 =====
+
+QNetworkReply *SessionNetworkManager::createRequest(Operation op, const QNetworkRequest &request,
+                                                    QIODevice *outgoingData)
+{
+    SessionManager *session = SessionManager::instance();
+    const bool userRequest = session->hasSession() && SessionManager::isUserRequest(request);
+    const bool tokenReady = !userRequest || (session->isTokenUsable() && !session->isRefreshing());
+    const QString host = request.url().host();
+
+    if (tokenReady
+        && m_activeByHost.value(host) < m_maxRequestsPerHost
+        && m_queuedByHost.value(host).isEmpty()) {
+        return dispatch(op, request, outgoingData);
+    }
+
+    // 令牌过期 / 正在刷新，或主机并发已满：先返回占位 reply
+    // （post(QByteArray) 生成的 QBuffer 挂在返回的 reply 下，等待期间不会被释放）
+    auto *deferred = new DeferredReply(op, request, this);
+    const QueuedRequest queued{deferred, op, request, outgoingData};
+    if (tokenReady) {
+        enqueue(queued);
+    } else {
+        session->whenReady(deferred, [this, queued]() { enqueue(queued); });
+    }
+    return deferred;
+}
+
+QNetworkReply *SessionNetworkManager::dispatch(Operation op, const QNetworkRequest &request,
+                                               QIODevice *outgoingData)
+{
+    SessionManager *session = SessionManager::instance();
+    const bool userRequest = session->hasSession() && SessionManager::isUserRequest(request);
+    QNetworkReply *reply = QNetworkAccessManager::createRequest(
+        op, userRequest ? session->authorize(request) : request, outgoingData);
+
+    const QString host = request.url().host();
+    ++m_activeByHost[host];
+
+    // finished 和 destroyed 都可能先到（调用方直接删除未完成的 reply），只释放一次
+    auto released = std::make_shared<bool>(false);
+    auto release = [this, host, released]() {
+        if (*released) return;
+        *released = true;
+        releaseSlot(host);
+    };
+    connect(reply, &QNetworkReply::finished, this, release);
+    connect(reply, &QObject::destroyed, this, release);
+    return reply;
+}
+
+void SessionNetworkManager::enqueue(const QueuedRequest &queued)
+{
+    const QString host = queued.request.url().host();
+    m_queuedByHost[host].enqueue(queued);
+    pump(host);
+}
+
+void SessionNetworkManager::pump(const QString &host)
+{
+    auto it = m_queuedByHost.find(host);
+    while (it != m_queuedByHost.end() && !it->isEmpty()
+           && m_activeByHost.value(host) < m_maxRequestsPerHost) {
+        const QueuedRequest queued = it->dequeue();
+        if (!queued.reply || queued.reply->isFinished()) {
+            continue;   // 排队期间已被 abort 或删除
+        }
+        QNetworkReply *inner = dispatch(queued.op, queued.request, queued.outgoingData);
+        queued.reply->attach(inner);
+        it = m_queuedByHost.find(host);
+    }
+    if (it != m_queuedByHost.end() && it->isEmpty()) {
+        m_queuedByHost.erase(it);
+    }
+}
+
+void SessionNetworkManager::releaseSlot(const QString &host)
+{
+    auto it = m_activeByHost.find(host);
+    if (it == m_activeByHost.end()) return;
+    if (--it.value() <= 0) {
+        m_activeByHost.erase(it);
+    }
+    pump(host);
+}
@@ -0,0 +1,67 @@
+#ifndef SESSIONNETWORKMANAGER_H
+#define SESSIONNETWORKMANAGER_H
+
+#include <QHash>
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QQueue>
+#include <QString>
+
+class DeferredReply;
+
+/**
+ * @brief 共享的、感知登录会话的 QNetworkAccessManager
+ *
+ * 每个线程一个实例（forCurrentThread()），所有 Supabase 服务共用同一个连接池：
+ * 同一主机只做一次 TLS 握手，启用 HTTP/2 后并发请求复用同一条连接。
+ *
+ * - 发往 Supabase 的用户请求在真正发出时换上 SessionManager 的最新令牌；
+ *   令牌已过期或正在刷新时先返回占位 reply，刷新完成后再发出真实请求并转发结果。
+ * - 每个主机同时在途的请求数不超过 maxRequestsPerHost()，超出的请求排队，
+ *   避免批量上传等突发流量占满连接、拖慢交互请求。
+ *
+ * 调用方照常 get()/post() 并连接 reply 的 finished。实例由线程共享，
+ * 不要连接管理器级别的 finished 信号，也不要修改代理、缓存等全局设置。
+ */
+class SessionNetworkManager : public QNetworkAccessManager
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_MAX_REQUESTS_PER_HOST = 12;
+
+    // 当前线程的共享实例（主线程挂在 qApp 下，工作线程结束时释放）
+    static SessionNetworkManager* forCurrentThread();
+
+    explicit SessionNetworkManager(QObject *parent = nullptr);
+
+    // 提前建立到 url 所在主机的连接（DNS + TCP + TLS），登录后调用
+    void prewarm(const QUrl &url);
+
+    int maxRequestsPerHost() const { return m_maxRequestsPerHost; }
+    void setMaxRequestsPerHost(int limit);
+
+protected:
+    QNetworkReply *createRequest(Operation op, const QNetworkRequest &request,
+                                 QIODevice *outgoingData = nullptr) override;
+
+private:
+    struct QueuedRequest {
+        QPointer<DeferredReply> reply;
+        Operation op;
+        QNetworkRequest request;
+        QIODevice *outgoingData;
+    };
+
+    QNetworkReply *dispatch(Operation op, const QNetworkRequest &request, QIODevice *outgoingData);
+    void enqueue(const QueuedRequest &queued);
+    void pump(const QString &host);
+    void releaseSlot(const QString &host);
+
+    int m_maxRequestsPerHost;
+    QHash<QString, int> m_activeByHost;
+    QHash<QString, QQueue<QueuedRequest>> m_queuedByHost;
+};
+
+#endif // SESSIONNETWORKMANAGER_H
@@ -0,0 +1,144 @@
+#include "SimHash.h"
+
+namespace {
+
+constexpr int kTitleWeight = 2;
+constexpr int kSummaryWeight = 1;
+constexpr int kSummaryPrefixLength = 120;  // 摘要只取开头，尾部多为各家不同的补充信息
+
+// 64 位 FNV-1a，结果跨进程稳定
+quint64 hashBigram(char16_t a, char16_t b)
+{
+    quint64 h = 14695981039346656037ULL;
+    const char16_t units[2] = {a, b};
+    for (char16_t unit : units) {
+        h ^= quint64(unit & 0xFF);
+        h *= 1099511628211ULL;
+        h ^= quint64(unit >> 8);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+void accumulate(const QString &text, int weight, int *bitWeights)
+{
+    char16_t previous = 0;
+    for (const QChar ch : text) {
+        if (!ch.isLetterOrNumber()) {
+            continue;
+        }
+        const char16_t current = ch.toCaseFolded().unicode();
+        if (previous != 0) {
+            const quint64 h = hashBigram(previous, current);
+            for (int bit = 0; bit < 64; ++bit) {
+                bitWeights[bit] += ((h >> bit) & 1) ? weight : -weight;
+            }
+        }
+        previous = current;
+    }
+}
+
+} // namespace
+
+namespace SimHash {
+
+quint64 fingerprint(const QString &title, const QString &summary)
+{
+    int bitWeights[64] = {};
+    accumulate(title, kTitleWeight, bitWeights);
+    accumulate(summary.left(kSummaryPrefixLength), kSummaryWeight, bitWeights);
+
+    quint64 result = 0;
+    for (int bit = 0; bit < 64; ++bit) {
+        if (bitWeights[bit] > 0) {
+            result |= quint64(1) << bit;
+        }
+    }
+    return result;
+}
+
+} // namespace SimHash
+
+namespace {
+
+// 第 block 块的起始位和宽度：前 64 % BLOCK_COUNT 块多 1 位
+int blockWidth(int block)
+{
+    const int base = 64 / SimHashIndex::BLOCK_COUNT;
+    return block < 64 % SimHashIndex::BLOCK_COUNT ? base + 1 : base;
+}
+
+int blockShift(int block)
+{
+    int shift = 0;
+    for (int i = 0; i < block; ++i) {
+        shift += blockWidth(i);
+    }
+    return shift;
+}
+
+} // namespace
+
+const QVector<SimHashIndex::Table> &SimHashIndex::tables()
+{
+    static const QVector<Table> result = []() {
+        static_assert(KEY_BLOCKS == 3, "tables() 按三重循环枚举组合");
+        QVector<Table> combos;
+        for (int a = 0; a < BLOCK_COUNT; ++a) {
+            for (int b = a + 1; b < BLOCK_COUNT; ++b) {
+                for (int c = b + 1; c < BLOCK_COUNT; ++c) {
+                    combos.append(Table{{a, b, c}});
+                }
+            }
+        }
+        return combos;
+    }();
+    return result;
+}
+
+quint64 SimHashIndex::tableKey(quint64 fingerprint, int tableIndex, const Table &table)
+{
+    quint64 key = 0;
+    for (int block : table.blocks) {
+        const int width = blockWidth(block);
+        const quint64 bits = (fingerprint >> blockShift(block)) & ((quint64(1) << width) - 1);
+        key = (key << width) | bits;
+    }
+    return (quint64(tableIndex) << 32) | key;
+}
+
+int SimHashIndex::findNearest(quint64 fingerprint) const
+{
+    int bestValue = -1;
+    int bestDistance = MAX_DISTANCE + 1;
+
+    const QVector<Table> &all = tables();
+    for (int t = 0; t < all.size(); ++t) {
+        const auto it = m_buckets.constFind(tableKey(fingerprint, t, all.at(t)));
+        if (it == m_buckets.constEnd()) {
+            continue;
+        }
+        for (int entry : it.value()) {
+            const int distance = SimHash::hammingDistance(fingerprint, m_fingerprints.at(entry));
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                bestValue = m_values.at(entry);
+                if (distance == 0) {
+                    return bestValue;
+                }
+            }
+        }
+    }
+    return bestValue;
+}
+
+void SimHashIndex::insert(quint64 fingerprint, int value)
+{
+    const int entry = m_fingerprints.size();
+    m_fingerprints.append(fingerprint);
+    m_values.append(value);
+    const QVector<Table> &all = tables();
+    for (int t = 0; t < all.size(); ++t) {
+        m_buckets[tableKey(fingerprint, t, all.at(t))].append(entry);
+    }
+}
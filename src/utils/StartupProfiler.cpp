@@ -0,0 +1,122 @@
+#include "StartupProfiler.h"
+#include "../config/AppConfig.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QDebug>
+
+StartupProfiler &StartupProfiler::instance()
+{
+    static StartupProfiler profiler;
+    return profiler;
+}
+
+StartupProfiler::StartupProfiler()
+{
+    m_timer.start();
+}
+
+void StartupProfiler::start()
+{
+    m_spans.clear();
+    m_openSpans.clear();
+    m_timer.restart();
+}
+
+qint64 StartupProfiler::elapsedMs() const
+{
+    return m_timer.elapsed();
+}
+
+void StartupProfiler::begin(const QString &name)
+{
+    Span span;
+    span.name = name;
+    span.startMs = m_timer.elapsed();
+    m_openSpans.insert(name, m_spans.size());
+    m_spans.append(span);
+}
+
+void StartupProfiler::end(const QString &name)
+{
+    auto it = m_openSpans.find(name);
+    if (it == m_openSpans.end()) {
+        qWarning() << "[StartupProfiler] 结束未开始的阶段:" << name;
+        return;
+    }
+    Span &span = m_spans[it.value()];
+    span.durationMs = m_timer.elapsed() - span.startMs;
+    m_openSpans.erase(it);
+}
+
+void StartupProfiler::mark(const QString &name)
+{
+    Span span;
+    span.name = name;
+    span.startMs = m_timer.elapsed();
+    span.durationMs = 0;
+    span.isMark = true;
+    m_spans.append(span);
+    qDebug() << "[StartupProfiler]" << name << "@" << span.startMs << "ms";
+}
+
+qint64 StartupProfiler::markTime(const QString &name) const
+{
+    for (const Span &span : m_spans) {
+        if (span.isMark && span.name == name) {
+            return span.startMs;
+        }
+    }
+    return -1;
+}
+
+QJsonObject StartupProfiler::toJson() const
+{
+    QJsonArray spans;
+    QJsonArray marks;
+    for (const Span &span : m_spans) {
+        QJsonObject obj;
+        obj["name"] = span.name;
+        obj["start_ms"] = span.startMs;
+        if (span.isMark) {
+            marks.append(obj);
+        } else {
+            obj["duration_ms"] = span.durationMs;
+            spans.append(obj);
+        }
+    }
+
+    QJsonObject root;
+    root["app_version"] = QCoreApplication::applicationVersion();
+    root["platform"] = QSysInfo::prettyProductName();
+    root["recorded_at"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["spans"] = spans;
+    root["marks"] = marks;
+    return root;
+}
+
+bool StartupProfiler::dumpToFile(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "[StartupProfiler] 无法写入:" << path << file.errorString();
+        return false;
+    }
+    file.write(QJsonDocument(toJson()).toJson(QJsonDocument::Indented));
+    qDebug() << "[StartupProfiler] 启动时间线已写入:" << path;
+    return true;
+}
+
+void StartupProfiler::dumpIfConfigured() const
+{
+    QString path = qEnvironmentVariable("STARTUP_PROFILE").trimmed();
+    if (path.isEmpty()) {
+        path = AppConfig::get(QStringLiteral("STARTUP_PROFILE")).trimmed();
+    }
+    if (!path.isEmpty()) {
+        dumpToFile(path);
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef STARTUPPROFILER_H
+#define STARTUPPROFILER_H
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+/**
+ * @brief 启动时间线记录器
+ *
+ * 进程级单例，以 main() 开始为零点，记录各启动阶段的耗时区间（span）
+ * 和关键时间点（mark，如首帧、可交互），可导出为 JSON 便于跨版本对比。
+ * 只在主线程使用。
+ *
+ * 用法：
+ *   { StartupProfiler::Scope scope("main_window.setup_ui"); setupCentralWidget(); }
+ *   StartupProfiler::instance().mark("main_window.interactive");
+ *   StartupProfiler::instance().dumpToFile(path);
+ *
+ * 设置环境变量 STARTUP_PROFILE=<路径>（或 .env.local 同名配置）时，
+ * 到达可交互时间点后自动写出 JSON。
+ */
+class StartupProfiler
+{
+public:
+    struct Span {
+        QString name;
+        qint64 startMs = 0;
+        qint64 durationMs = -1;  // -1 表示尚未结束；mark 为 0
+        bool isMark = false;
+    };
+
+    // RAII 区间
+    class Scope
+    {
+    public:
+        explicit Scope(const QString &name) : m_name(name) { StartupProfiler::instance().begin(m_name); }
+        ~Scope() { StartupProfiler::instance().end(m_name); }
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        QString m_name;
+    };
+
+    static StartupProfiler &instance();
+
+    // 重置零点（main() 第一行调用）
+    void start();
+    qint64 elapsedMs() const;
+
+    void begin(const QString &name);
+    void end(const QString &name);
+    void mark(const QString &name);
+
+    // 已记录的 mark 时间（毫秒），未记录返回 -1
+    qint64 markTime(const QString &name) const;
+
+    QVector<Span> spans() const { return m_spans; }
+    QJsonObject toJson() const;
+    bool dumpToFile(const QString &path) const;
+
+    // 按 STARTUP_PROFILE 配置自动导出，未配置时不做任何事
+    void dumpIfConfigured() const;
+
+private:
+    StartupProfiler();
+
+    QElapsedTimer m_timer;
+    QVector<Span> m_spans;
+    QHash<QString, int> m_openSpans;  // name -> m_spans 下标
+};
+
+#endif // STARTUPPROFILER_H
@@ -0,0 +1,67 @@
+#include "TextSimilarity.h"
+#include <QVector>
+#include <algorithm>
+
+QSet<QString> TextSimilarity::extractBigrams(const QString &text)
+{
+    QSet<QString> bigrams;
+    QString cleaned = text.simplified().remove(' ');
+    for (int i = 0; i < cleaned.length() - 1; ++i) {
+        bigrams.insert(cleaned.mid(i, 2));
+    }
+    return bigrams;
+}
+
+double TextSimilarity::jaccardBigram(const QString &textA, const QString &textB)
+{
+    QSet<QString> bigramsA = extractBigrams(textA);
+    QSet<QString> bigramsB = extractBigrams(textB);
+
+    if (bigramsA.isEmpty() && bigramsB.isEmpty()) return 1.0;
+    if (bigramsA.isEmpty() || bigramsB.isEmpty()) return 0.0;
+
+    QSet<QString> intersection = bigramsA;
+    intersection.intersect(bigramsB);
+
+    QSet<QString> unionSet = bigramsA;
+    unionSet.unite(bigramsB);
+
+    return static_cast<double>(intersection.size()) / unionSet.size();
+}
+
+int TextSimilarity::editDistance(const QString &a, const QString &b)
+{
+    int m = a.length();
+    int n = b.length();
+
+    // 对超长文本截断，避免 O(m*n) 爆内存
+    const int MAX_LEN = 500;
+    QString sa = a.left(MAX_LEN);
+    QString sb = b.left(MAX_LEN);
+    m = sa.length();
+    n = sb.length();
+
+    QVector<int> prev(n + 1), curr(n + 1);
+    for (int j = 0; j <= n; ++j) prev[j] = j;
+
+    for (int i = 1; i <= m; ++i) {
+        curr[0] = i;
+        for (int j = 1; j <= n; ++j) {
+            int cost = (sa[i - 1] == sb[j - 1]) ? 0 : 1;
+            curr[j] = std::min({prev[j] + 1, curr[j - 1] + 1, prev[j - 1] + cost});
+        }
+        std::swap(prev, curr);
+    }
+    return prev[n];
+}
+
+double TextSimilarity::similarity(const QString &textA, const QString &textB)
+{
+    // 混合指标: 0.6 * Jaccard + 0.4 * (1 - 编辑距离/maxLen)
+    double jaccard = jaccardBigram(textA, textB);
+
+    int maxLen = qMax(textA.length(), textB.length());
+    double editSim = (maxLen == 0) ? 1.0 : (1.0 - static_cast<double>(editDistance(textA, textB)) / maxLen);
+
+    return 0.6 * jaccard + 0.4 * editSim;
+}
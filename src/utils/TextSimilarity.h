@@ -0,0 +1,24 @@
+#ifndef TEXTSIMILARITY_H
+#define TEXTSIMILARITY_H
+
+#include <QSet>
+#include <QString>
+
+/**
+ * @brief 题干文本相似度（题库查重用）
+ *
+ * 混合指标：0.6 * 字符二元组 Jaccard + 0.4 * (1 - 编辑距离 / 较长文本长度)，取值 0~1。
+ * 编辑距离只比较前 500 个字符，超长文本不会 O(m*n) 爆内存。
+ */
+class TextSimilarity
+{
+public:
+    static double similarity(const QString &textA, const QString &textB);
+    static double jaccardBigram(const QString &textA, const QString &textB);
+    static int editDistance(const QString &a, const QString &b);
+
+private:
+    static QSet<QString> extractBigrams(const QString &text);
+};
+
+#endif // TEXTSIMILARITY_H
@@ -0,0 +1,53 @@
+-- 批量批改 RPC：HomeworkManager::flushGrades 把防抖期间累积的批改一次提交
+--
+-- 参数 p_grades 为数组，每项：
+--   { "id": 提交ID, "score": 分数, "feedback": 反馈, "allow_resubmit": 是否允许重交,
+--     "expected_grade_time": 客户端看到的 grade_time（未批改过为 null） }
+--
+-- 以 grade_time 作版本号做乐观并发控制：与 expected_grade_time 不一致说明已被他人批改，
+-- 该行不写入，返回 conflict。客户端原样回传读到的 grade_time 字符串，按完整精度（微秒）比较。
+-- 每行返回 (id, status, grade_time)，status 为 ok / conflict / missing。
+
+create or replace function public.grade_submissions(p_grades jsonb)
+returns table (id uuid, status text, grade_time timestamp with time zone)
+language plpgsql
+as $$
+declare
+  g jsonb;
+  v_id uuid;
+  v_expected timestamp with time zone;
+  v_current timestamp with time zone;
+  v_now timestamp with time zone := now();
+begin
+  for g in select * from jsonb_array_elements(p_grades)
+  loop
+    v_id := (g->>'id')::uuid;
+    v_expected := nullif(g->>'expected_grade_time', '')::timestamp with time zone;
+
+    select s.grade_time into v_current
+      from public.submissions s
+     where s.id = v_id
+       for update;
+
+    if not found then
+      id := v_id; status := 'missing'; grade_time := null;
+    elsif v_current is distinct from v_expected then
+      id := v_id; status := 'conflict'; grade_time := v_current;
+    else
+      update public.submissions s
+         set score = (g->>'score')::integer,
+             feedback = coalesce(g->>'feedback', ''),
+             allow_resubmit = coalesce((g->>'allow_resubmit')::boolean, false),
+             status = 2,
+             grade_time = v_now
+       where s.id = v_id;
+      id := v_id; status := 'ok'; grade_time := v_now;
+    end if;
+    return next;
+  end loop;
+end;
+$$;
+
+grant execute on function public.grade_submissions(jsonb) to anon, authenticated;
+
+notify pgrst, 'reload schema';
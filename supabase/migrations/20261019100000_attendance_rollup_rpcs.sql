@@ -0,0 +1,134 @@
+-- 考勤统计 RPC：AttendanceManager 的学生考勤明细与班级考勤统计
+--
+-- student_attendance_history：班级全部场次 LEFT JOIN 该学生的记录，一次往返，
+--   不再由客户端拼接 session_id=in.(...)。p_since 非空时只返回此后创建的场次（增量同步）。
+-- class_attendance_rollup：按学生聚合 [p_from, p_to) 内的考勤，
+--   返回各状态人次、最近连续出勤和最长连续出勤（出勤 / 迟到算到场，excused 算请假，
+--   没有记录或状态不认识算 unrecorded）。
+
+create index if not exists idx_attendance_sessions_class_created
+  on public.attendance_sessions (class_id, created_at);
+create index if not exists idx_attendance_records_session_student
+  on public.attendance_records (session_id, student_email);
+
+create or replace function public.student_attendance_history(
+  p_class_id uuid,
+  p_student_email text,
+  p_since timestamp with time zone default null
+)
+returns table (
+  session_id uuid,
+  name text,
+  code character varying,
+  session_status text,
+  created_at timestamp with time zone,
+  ended_at timestamp with time zone,
+  record_status text
+)
+language sql
+stable
+as $$
+  select s.id, s.name, s.code, s.status, s.created_at, s.ended_at, r.status
+    from public.attendance_sessions s
+    left join lateral (
+      select ar.status
+        from public.attendance_records ar
+       where ar.session_id = s.id
+         and ar.student_email = p_student_email
+       order by ar.signed_at desc nulls last
+       limit 1
+    ) r on true
+   where s.class_id = p_class_id
+     and (p_since is null or s.created_at >= p_since)
+   order by s.created_at desc;
+$$;
+
+create or replace function public.class_attendance_rollup(
+  p_class_id uuid,
+  p_from timestamp with time zone default null,
+  p_to timestamp with time zone default null
+)
+returns table (
+  student_email text,
+  student_name text,
+  total_count integer,
+  present_count integer,
+  late_count integer,
+  absent_count integer,
+  leave_count integer,
+  early_leave_count integer,
+  unrecorded_count integer,
+  current_streak integer,
+  longest_streak integer,
+  last_attended_at timestamp with time zone
+)
+language sql
+stable
+as $$
+  with sessions as (
+    select s.id, s.created_at
+      from public.attendance_sessions s
+     where s.class_id = p_class_id
+       and (p_from is null or s.created_at >= p_from)
+       and (p_to is null or s.created_at < p_to)
+  ),
+  grid as (
+    select m.student_email,
+           coalesce(nullif(m.student_name, ''), m.student_email) as student_name,
+           s.created_at,
+           -- excused（教师端的请假）归入 leave，其他不认识的状态算未记录，与客户端 AttendanceStatsStore 一致
+           case
+             when r.status = 'excused' then 'leave'
+             when r.status in ('present', 'late', 'absent', 'leave', 'early_leave') then r.status
+             else 'unrecorded'
+           end as status
+      from public.class_members m
+      cross join sessions s
+      left join lateral (
+        select ar.status
+          from public.attendance_records ar
+         where ar.session_id = s.id
+           and ar.student_email = m.student_email
+         order by ar.signed_at desc nulls last
+         limit 1
+      ) r on true
+     where m.class_id = p_class_id
+  ),
+  -- 连续出勤：按时间累计"未到场"次数，相同累计值的到场记录属于同一段
+  marked as (
+    select g.*,
+           g.status in ('present', 'late') as attended,
+           count(*) filter (where g.status not in ('present', 'late'))
+             over (partition by g.student_email order by g.created_at
+                   rows between unbounded preceding and current row) as breaks
+      from grid g
+  ),
+  streaks as (
+    select mk.student_email, mk.breaks, count(*) filter (where mk.attended) as len
+      from marked mk
+     group by mk.student_email, mk.breaks
+  )
+  select mk.student_email,
+         max(mk.student_name),
+         count(*)::integer,
+         count(*) filter (where mk.status = 'present')::integer,
+         count(*) filter (where mk.status = 'late')::integer,
+         count(*) filter (where mk.status = 'absent')::integer,
+         count(*) filter (where mk.status = 'leave')::integer,
+         count(*) filter (where mk.status = 'early_leave')::integer,
+         count(*) filter (where mk.status = 'unrecorded')::integer,
+         coalesce((select st.len from streaks st
+                    where st.student_email = mk.student_email
+                    order by st.breaks desc limit 1), 0)::integer,
+         coalesce((select max(st.len) from streaks st
+                    where st.student_email = mk.student_email), 0)::integer,
+         max(mk.created_at) filter (where mk.attended)
+    from marked mk
+   group by mk.student_email
+   order by mk.student_email;
+$$;
+
+grant execute on function public.student_attendance_history(uuid, text, timestamp with time zone) to anon, authenticated;
+grant execute on function public.class_attendance_rollup(uuid, timestamp with time zone, timestamp with time zone) to authenticated;
+
+notify pgrst, 'reload schema';
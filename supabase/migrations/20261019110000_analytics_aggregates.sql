@@ -0,0 +1,308 @@
+-- 学情分析：服务端物化汇总 + 成绩增量同步
+--
+-- analytics_exam_stats         每次作业（按班级）的成绩分布：人数、平均 / 最高 / 最低得分率、四档人数
+-- analytics_knowledge_mastery  每个班级每个知识点的平均得分率（作业未标注知识点时按作业标题归类）
+-- analytics_class_activity     每个班级每天的考勤到场人次 / 应到人次、作业提交数 / 应交数
+--
+-- 物化视图不随写入实时刷新：submissions / assignments / attendance_records / class_members
+-- 的语句级触发器只把 analytics_refresh_state 标记为脏，由 pg_cron 每分钟调用
+-- refresh_analytics_aggregates()，已脏才 refresh concurrently。刷新不在请求路径上，
+-- 查询 RPC 只读快照。没有 pg_cron 的环境需要由外部定时任务调用该函数。
+--
+-- 物化视图没有 RLS，不对 anon / authenticated 开放；只能经由两个 RPC 读取，
+-- RPC 只返回调用者（auth.jwt() 中的 email）任课班级的数据。
+--
+-- analytics_score_changes 按 (updated_at, id) 键集分页返回已批改的成绩，
+-- 客户端记住最后一行作为水位，下次从水位前 5 分钟开始拉取（updated_at 取事务开始时间，
+-- 慢事务可能晚于水位才提交），并定期全量重拉以清掉删除或撤销分数的提交。
+
+-- ===== 增量同步所需的列 =====
+
+alter table public.submissions
+  add column if not exists updated_at timestamp with time zone;
+update public.submissions
+   set updated_at = coalesce(grade_time, submit_time, now())
+ where updated_at is null;
+alter table public.submissions
+  alter column updated_at set default now(),
+  alter column updated_at set not null;
+
+alter table public.assignments
+  add column if not exists knowledge_point text;
+
+create or replace function public.touch_submission_updated_at()
+returns trigger
+language plpgsql
+as $$
+begin
+  new.updated_at := now();
+  return new;
+end;
+$$;
+
+drop trigger if exists trg_submissions_touch_updated_at on public.submissions;
+create trigger trg_submissions_touch_updated_at
+  before update on public.submissions
+  for each row execute function public.touch_submission_updated_at();
+
+create index if not exists idx_submissions_updated_at_id
+  on public.submissions (updated_at, id);
+create index if not exists idx_assignments_class
+  on public.assignments (class_id);
+
+-- ===== 物化汇总 =====
+
+create materialized view if not exists public.analytics_exam_stats as
+  select a.class_id,
+         a.id as assignment_id,
+         a.title,
+         coalesce(a.end_time, a.created_at) as exam_date,
+         count(*)::integer as graded_count,
+         avg(r.rate)::double precision as average_rate,
+         max(r.rate)::double precision as highest_rate,
+         min(r.rate)::double precision as lowest_rate,
+         count(*) filter (where r.rate >= 90)::integer as excellent_count,
+         count(*) filter (where r.rate >= 80 and r.rate < 90)::integer as good_count,
+         count(*) filter (where r.rate >= 60 and r.rate < 80)::integer as pass_count,
+         count(*) filter (where r.rate < 60)::integer as fail_count
+    from public.assignments a
+    join lateral (
+      select s.score * 100.0 / nullif(coalesce(a.total_score, 100), 0) as rate
+        from public.submissions s
+       where s.assignment_id = a.id
+         and s.score is not null
+    ) r on true
+   group by a.class_id, a.id, a.title, a.end_time, a.created_at;
+
+create unique index if not exists idx_analytics_exam_stats_pk
+  on public.analytics_exam_stats (assignment_id);
+create index if not exists idx_analytics_exam_stats_class
+  on public.analytics_exam_stats (class_id, exam_date);
+
+create materialized view if not exists public.analytics_knowledge_mastery as
+  select a.class_id,
+         coalesce(nullif(a.knowledge_point, ''), a.title) as knowledge_point,
+         avg(s.score * 100.0 / nullif(coalesce(a.total_score, 100), 0))::double precision as mastery_rate,
+         count(*)::integer as question_count
+    from public.assignments a
+    join public.submissions s on s.assignment_id = a.id
+   where s.score is not null
+   group by a.class_id, coalesce(nullif(a.knowledge_point, ''), a.title);
+
+create unique index if not exists idx_analytics_knowledge_mastery_pk
+  on public.analytics_knowledge_mastery (class_id, knowledge_point);
+
+create materialized view if not exists public.analytics_class_activity as
+  with members as (
+    select m.class_id, count(*)::integer as member_count
+      from public.class_members m
+     group by m.class_id
+  ),
+  attendance as (
+    select s.class_id,
+           s.created_at::date as day,
+           count(distinct s.id)::integer as session_count,
+           count(r.id) filter (where r.status in ('present', 'late'))::integer as present_count
+      from public.attendance_sessions s
+      left join public.attendance_records r on r.session_id = s.id
+     group by s.class_id, s.created_at::date
+  ),
+  homework as (
+    select a.class_id,
+           coalesce(a.end_time, a.created_at)::date as day,
+           count(distinct a.id)::integer as assignment_count,
+           count(s.id)::integer as submitted_count
+      from public.assignments a
+      left join public.submissions s on s.assignment_id = a.id
+     group by a.class_id, coalesce(a.end_time, a.created_at)::date
+  )
+  select coalesce(at.class_id, hw.class_id) as class_id,
+         coalesce(at.day, hw.day) as day,
+         coalesce(at.present_count, 0) as attendance_present,
+         coalesce(at.session_count, 0) * coalesce(m.member_count, 0) as attendance_expected,
+         coalesce(hw.submitted_count, 0) as homework_submitted,
+         coalesce(hw.assignment_count, 0) * coalesce(m.member_count, 0) as homework_expected
+    from attendance at
+    full join homework hw on hw.class_id = at.class_id and hw.day = at.day
+    left join members m on m.class_id = coalesce(at.class_id, hw.class_id);
+
+create unique index if not exists idx_analytics_class_activity_pk
+  on public.analytics_class_activity (class_id, day);
+
+-- 物化视图只能经由下面的 RPC 读取
+revoke all on public.analytics_exam_stats from anon, authenticated;
+revoke all on public.analytics_knowledge_mastery from anon, authenticated;
+revoke all on public.analytics_class_activity from anon, authenticated;
+
+-- ===== 刷新调度 =====
+
+create table if not exists public.analytics_refresh_state (
+  id integer primary key default 1 check (id = 1),
+  dirty boolean not null default true,
+  refreshed_at timestamp with time zone
+);
+insert into public.analytics_refresh_state (id) values (1) on conflict (id) do nothing;
+revoke all on public.analytics_refresh_state from anon, authenticated;
+
+create or replace function public.mark_analytics_dirty()
+returns trigger
+language plpgsql
+security definer
+set search_path = public
+as $$
+begin
+  update public.analytics_refresh_state set dirty = true where id = 1 and not dirty;
+  return null;
+end;
+$$;
+
+drop trigger if exists trg_submissions_analytics_dirty on public.submissions;
+create trigger trg_submissions_analytics_dirty
+  after insert or update or delete on public.submissions
+  for each statement execute function public.mark_analytics_dirty();
+drop trigger if exists trg_assignments_analytics_dirty on public.assignments;
+create trigger trg_assignments_analytics_dirty
+  after insert or update or delete on public.assignments
+  for each statement execute function public.mark_analytics_dirty();
+drop trigger if exists trg_attendance_records_analytics_dirty on public.attendance_records;
+create trigger trg_attendance_records_analytics_dirty
+  after insert or update or delete on public.attendance_records
+  for each statement execute function public.mark_analytics_dirty();
+drop trigger if exists trg_class_members_analytics_dirty on public.class_members;
+create trigger trg_class_members_analytics_dirty
+  after insert or update or delete on public.class_members
+  for each statement execute function public.mark_analytics_dirty();
+
+-- 只由定时任务调用，返回本次是否刷新
+create or replace function public.refresh_analytics_aggregates()
+returns boolean
+language plpgsql
+security definer
+set search_path = public
+as $$
+begin
+  if not exists (select 1 from public.analytics_refresh_state where id = 1 and dirty) then
+    return false;
+  end if;
+  -- 上一次刷新还没结束时跳过，下一轮再来
+  if not pg_try_advisory_xact_lock(hashtext('refresh_analytics_aggregates')) then
+    return false;
+  end if;
+
+  -- 先清标记：刷新期间的新写入会重新置脏，下一轮补上
+  update public.analytics_refresh_state set dirty = false where id = 1;
+  refresh materialized view concurrently public.analytics_exam_stats;
+  refresh materialized view concurrently public.analytics_knowledge_mastery;
+  refresh materialized view concurrently public.analytics_class_activity;
+  update public.analytics_refresh_state set refreshed_at = now() where id = 1;
+  return true;
+end;
+$$;
+
+revoke all on function public.refresh_analytics_aggregates() from public, anon, authenticated;
+
+do $$
+begin
+  if exists (select 1 from pg_extension where extname = 'pg_cron') then
+    perform cron.schedule('refresh-analytics-aggregates', '* * * * *',
+                          'select public.refresh_analytics_aggregates()');
+  else
+    raise notice 'pg_cron 未安装：请由外部定时任务调用 public.refresh_analytics_aggregates()';
+  end if;
+end;
+$$;
+
+-- ===== 查询 RPC =====
+
+-- 调用者任课的班级（与 p_class_ids 取交集），越权的班级 ID 直接忽略
+create or replace function public.analytics_teacher_classes(p_class_ids uuid[])
+returns uuid[]
+language sql
+stable
+security definer
+set search_path = public
+as $$
+  select coalesce(array_agg(c.id), '{}'::uuid[])
+    from public.classes c
+   where c.id = any(p_class_ids)
+     and c.teacher_email = auth.jwt() ->> 'email';
+$$;
+
+revoke all on function public.analytics_teacher_classes(uuid[]) from public, anon, authenticated;
+
+create or replace function public.analytics_class_overview(
+  p_class_ids uuid[],
+  p_activity_days integer default 60
+)
+returns jsonb
+language plpgsql
+stable
+security definer
+set search_path = public
+as $$
+declare
+  v_class_ids uuid[] := public.analytics_teacher_classes(p_class_ids);
+begin
+  return jsonb_build_object(
+    'refreshed_at', (select refreshed_at from public.analytics_refresh_state where id = 1),
+    'exams', coalesce((
+      select jsonb_agg(to_jsonb(e) order by e.class_id, e.exam_date)
+        from public.analytics_exam_stats e
+       where e.class_id = any(v_class_ids)), '[]'::jsonb),
+    'knowledge', coalesce((
+      select jsonb_agg(to_jsonb(k) order by k.class_id, k.mastery_rate)
+        from public.analytics_knowledge_mastery k
+       where k.class_id = any(v_class_ids)), '[]'::jsonb),
+    'activity', coalesce((
+      select jsonb_agg(to_jsonb(d) order by d.day)
+        from public.analytics_class_activity d
+       where d.class_id = any(v_class_ids)
+         and d.day >= current_date - p_activity_days), '[]'::jsonb)
+  );
+end;
+$$;
+
+create or replace function public.analytics_score_changes(
+  p_class_ids uuid[],
+  p_since timestamp with time zone default null,
+  p_after_id uuid default null,
+  p_limit integer default 2000
+)
+returns table (
+  id uuid,
+  class_id uuid,
+  student_email text,
+  assignment_id uuid,
+  title text,
+  knowledge_point text,
+  score integer,
+  total_score integer,
+  exam_date timestamp with time zone,
+  updated_at timestamp with time zone
+)
+language sql
+stable
+security definer
+set search_path = public
+as $$
+  select s.id, a.class_id, s.student_email, a.id, a.title,
+         coalesce(nullif(a.knowledge_point, ''), a.title),
+         s.score, coalesce(a.total_score, 100),
+         coalesce(a.end_time, a.created_at), s.updated_at
+    from public.submissions s
+    join public.assignments a on a.id = s.assignment_id
+   where a.class_id = any(public.analytics_teacher_classes(p_class_ids))
+     and s.score is not null
+     and (p_since is null
+          or s.updated_at > p_since
+          or (s.updated_at = p_since and s.id > coalesce(p_after_id, '00000000-0000-0000-0000-000000000000'::uuid)))
+   order by s.updated_at, s.id
+   limit greatest(1, least(p_limit, 5000));
+$$;
+
+revoke all on function public.analytics_class_overview(uuid[], integer) from public, anon;
+revoke all on function public.analytics_score_changes(uuid[], timestamp with time zone, uuid, integer) from public, anon;
+grant execute on function public.analytics_class_overview(uuid[], integer) to authenticated;
+grant execute on function public.analytics_score_changes(uuid[], timestamp with time zone, uuid, integer) to authenticated;
+
+notify pgrst, 'reload schema';